@@ -0,0 +1,79 @@
+#define BOOST_TEST_MODULE Algorithms_ApproximateKernelExpansion
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/ApproximateKernelExpansion.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Data/DataDistribution.h>
+#include <shark/Rng/GlobalRng.h>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Algorithms_ApproximateKernelExpansion)
+
+//an approximation with as many basis vectors as the expansion has support
+//vectors must recover the expansion up to a small optimization error
+BOOST_AUTO_TEST_CASE( ApproximateKernelExpansion_Exact )
+{
+	Chessboard problem;
+	LabeledData<RealVector, unsigned int> dataset = problem.generateDataset(30,10);
+	GaussianRbfKernel<> kernel(0.5);
+	KernelExpansion<RealVector> expansion(&kernel,dataset.inputs(),true,2);
+	for(std::size_t i = 0; i != 30; ++i){
+		expansion.alpha()(i,0) = Rng::gauss(0,1);
+		expansion.alpha()(i,1) = Rng::gauss(0,1);
+	}
+	expansion.offset()(0) = Rng::gauss(0,1);
+	expansion.offset()(1) = Rng::gauss(0,1);
+
+	KernelExpansion<RealVector> approximation = approximateKernelExpansion(expansion,30,200);
+	BOOST_REQUIRE_EQUAL(approximation.basis().numberOfElements(), 30u);
+	BOOST_REQUIRE_EQUAL(approximation.outputSize(), 2u);
+	BOOST_REQUIRE(approximation.hasOffset());
+	BOOST_CHECK_SMALL(norm_inf(approximation.offset()-expansion.offset()), 1.e-14);
+
+	//the mean squared prediction error on fresh points must be tiny
+	//relative to the scale of the predictions
+	LabeledData<RealVector, unsigned int> test = problem.generateDataset(100,100);
+	double errorApprox = 0;
+	double scale = 0;
+	for(std::size_t i = 0; i != 100; ++i){
+		RealVector truth = expansion(test.element(i).input);
+		RealVector approx = approximation(test.element(i).input);
+		errorApprox += norm_sqr(truth-approx);
+		scale += norm_sqr(truth);
+	}
+	BOOST_CHECK(errorApprox < 1.e-3*scale);
+}
+
+//a compressed approximation must be better than the best linear combination
+//of a random subset of the same size
+BOOST_AUTO_TEST_CASE( ApproximateKernelExpansion_Compression )
+{
+	Chessboard problem;
+	LabeledData<RealVector, unsigned int> dataset = problem.generateDataset(100,10);
+	GaussianRbfKernel<> kernel(0.5);
+	KernelExpansion<RealVector> expansion(&kernel,dataset.inputs(),false,1);
+	for(std::size_t i = 0; i != 100; ++i){
+		expansion.alpha()(i,0) = Rng::gauss(0,1);
+	}
+
+	KernelExpansion<RealVector> approximation = approximateKernelExpansion(expansion,10,200);
+	BOOST_REQUIRE_EQUAL(approximation.basis().numberOfElements(), 10u);
+	BOOST_REQUIRE_EQUAL(approximation.outputSize(), 1u);
+	BOOST_REQUIRE(!approximation.hasOffset());
+
+	//compare the mean squared prediction error against unoptimized baselines
+	LabeledData<RealVector, unsigned int> test = problem.generateDataset(200,200);
+	double errorApprox = 0;
+	double errorZero = 0;
+	for(std::size_t i = 0; i != 200; ++i){
+		RealVector truth = expansion(test.element(i).input);
+		RealVector approx = approximation(test.element(i).input);
+		errorApprox += norm_sqr(truth-approx);
+		errorZero += norm_sqr(truth);
+	}
+	BOOST_CHECK(errorApprox < errorZero);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -12,6 +12,8 @@
 
 #include "../testFunction.h"
 
+#include <sstream>
+
 using namespace shark;
 
 BOOST_AUTO_TEST_SUITE (Algorithms_DirectSearch_CMA)
@@ -93,4 +95,60 @@ BOOST_AUTO_TEST_CASE( CMA_Sphere_Niko )
 	BOOST_CHECK(!condHigh);
 }
 
+BOOST_AUTO_TEST_CASE( CMA_LazyUpdate )
+{
+	//sampling from an eigendecomposition that is a few generations old
+	//must not break the adaptation of the covariance matrix
+	Ellipsoid function(5);
+	CMA optimizer;
+	optimizer.setUpdateFrequency(5);
+	BOOST_REQUIRE_EQUAL(optimizer.updateFrequency(), 5u);
+
+	std::cout << "\nTesting: " << optimizer.name() << " with " << function.name() << " and lazy decomposition updates" << std::endl;
+	test_function( optimizer, function, _trials = 10, _iterations = 1500, _epsilon = 1E-10 );
+}
+
+//sphere flagged as thread safe, so the offspring are evaluated in parallel
+struct ThreadSafeSphere : public Sphere{
+	ThreadSafeSphere(std::size_t n) : Sphere(n){
+		m_features |= IS_THREAD_SAFE;
+	}
+};
+
+BOOST_AUTO_TEST_CASE( CMA_ParallelEvaluation )
+{
+	ThreadSafeSphere function(5);
+	CMA optimizer;
+
+	std::cout << "\nTesting: " << optimizer.name() << " with " << function.name() << " evaluated in parallel" << std::endl;
+	test_function( optimizer, function, _trials = 10, _iterations = 1000, _epsilon = 1E-10 );
+}
+
+BOOST_AUTO_TEST_CASE( CMA_Checkpoint )
+{
+	Rng::seed(42);
+	Sphere sphere(3);
+	sphere.init();
+	CMA cma;
+	cma.init(sphere);
+	for(unsigned i=0; i<10; i++) cma.step( sphere );
+
+	//checkpoint the run mid-way and restore it into a fresh optimizer
+	std::stringstream checkpoint;
+	cma.saveState(checkpoint);
+	CMA restored;
+	restored.loadState(checkpoint);
+	BOOST_REQUIRE_EQUAL(cma.sigma(), restored.sigma());
+
+	//given the same random sequence, both runs must continue bit-exactly
+	Rng::seed(43);
+	for(unsigned i=0; i<5; i++) cma.step( sphere );
+	Rng::seed(43);
+	for(unsigned i=0; i<5; i++) restored.step( sphere );
+	BOOST_REQUIRE_EQUAL(cma.solution().value, restored.solution().value);
+	BOOST_CHECK_EQUAL(cma.sigma(), restored.sigma());
+	for(std::size_t j = 0; j != 3; ++j)
+		BOOST_CHECK_EQUAL(cma.solution().point(j), restored.solution().point(j));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
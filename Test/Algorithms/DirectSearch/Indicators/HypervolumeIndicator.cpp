@@ -49,4 +49,47 @@ BOOST_AUTO_TEST_CASE( HypervolumeIndicator_Consistency ) {
 		BOOST_CHECK_CLOSE(maxVolume,volumes[indicated],1.e-10);
 	}
 }
+
+//checks the incremental computation used for more than 3 objectives by feeding the
+//same indicator a steady state sequence of fronts which change by one point per step
+BOOST_AUTO_TEST_CASE( HypervolumeIndicator_Incremental_Consistency ) {
+	std::size_t numPoints = 10;
+	std::size_t numSteps = 30;
+	std::size_t numDims = 4;
+	RealVector ref(numDims,11);
+
+	//create initial points
+	std::vector<RealVector> population(numPoints);
+	for(std::size_t i = 0; i != numPoints; ++i){
+		population[i].resize(numDims);
+		for(std::size_t j = 0; j != numDims; ++j){
+			population[i][j]= Rng::uni(-1,10);
+		}
+	}
+
+	HypervolumeIndicator indicator;
+	indicator.setReference(ref);
+	for(std::size_t t = 0; t != numSteps; ++t){
+		//compute all contributions by brute force
+		RealVector volumes(numPoints);
+		double maxVolume = -std::numeric_limits<double>::max();
+		for(std::size_t i = 0; i != numPoints; ++i){
+			HypervolumeCalculator hv;
+			std::vector<RealVector> copy = population;
+			copy.erase(copy.begin()+i);
+			volumes[i] = hv(copy,ref);
+			maxVolume = std::max(maxVolume,volumes[i]);
+		}
+		std::size_t indicated = indicator.leastContributor(population);
+		BOOST_CHECK_CLOSE(maxVolume,volumes[indicated],1.e-10);
+
+		//remove the least contributor and insert a new random point
+		population.erase(population.begin()+indicated);
+		RealVector point(numDims);
+		for(std::size_t j = 0; j != numDims; ++j){
+			point[j]= Rng::uni(-1,10);
+		}
+		population.push_back(point);
+	}
+}
 BOOST_AUTO_TEST_SUITE_END()
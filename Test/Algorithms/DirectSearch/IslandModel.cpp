@@ -0,0 +1,60 @@
+#define BOOST_TEST_MODULE DirectSearch_IslandModel
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/DirectSearch/IslandModel.h>
+#include <shark/Algorithms/DirectSearch/CMA.h>
+#include <shark/Algorithms/DirectSearch/CrossEntropyMethod.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Rosenbrock.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Cigar.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Sphere.h>
+
+#include "../testFunction.h"
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Algorithms_DirectSearch_IslandModel)
+
+BOOST_AUTO_TEST_CASE( IslandModel_CMA_Sphere )
+{
+	Sphere function(3);
+	IslandModel<CMA> optimizer(4,5);
+
+	std::cout<<"Testing: "<<optimizer.name()<<" with "<<function.name()<<std::endl;
+	test_function( optimizer, function, _trials = 10, _iterations = 500, _epsilon = 1E-10 );
+}
+
+BOOST_AUTO_TEST_CASE( IslandModel_CMA_Rosenbrock )
+{
+	Rosenbrock function( 3 );
+	IslandModel<CMA> optimizer(4,5);
+
+	std::cout<<"\nTesting: "<<optimizer.name()<<" with "<<function.name()<<std::endl;
+	test_function( optimizer, function, _trials = 10, _iterations = 1000, _epsilon = 1E-10 );
+}
+
+BOOST_AUTO_TEST_CASE( IslandModel_CrossEntropyMethod_Cigar )
+{
+	Cigar function(3);
+	IslandModel<CrossEntropyMethod> optimizer(4,10);
+
+	std::cout<<"\nTesting: "<<optimizer.name()<<" with "<<function.name()<<std::endl;
+	test_function( optimizer, function, _trials = 10, _iterations = 1000, _epsilon = 1E-10 );
+}
+
+//the solution of the model is the best solution any island has found so far
+BOOST_AUTO_TEST_CASE( IslandModel_Best_Solution )
+{
+	Sphere function(3);
+	IslandModel<CMA> optimizer(4,5);
+	function.init();
+	optimizer.init(function);
+	for(std::size_t iteration = 0; iteration != 100; ++iteration){
+		optimizer.step(function);
+		for(std::size_t i = 0; i != optimizer.numberOfIslands(); ++i){
+			BOOST_CHECK(optimizer.solution().value <= optimizer.island(i).solution().value);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -81,5 +81,31 @@ BOOST_AUTO_TEST_CASE( RealCodedNSGAII_HYPERVOLUME_Functions ) {
 	testObjectiveFunctionMOO(zdt6,10,zdt6Volume,1000,reference);
 }
 
+BOOST_AUTO_TEST_CASE( RealCodedNSGAII_CROWDING_Functions ) {
+	//the crowding distance spreads the front slightly differently than the
+	//hypervolume indicator, so only check that the volume comes close
+	RealVector reference(2);
+	reference(0) = 11;
+	reference(1) = 11;
+	ZDT1 zdt1(5);
+	double zdt1Volume = 120.613761;
+
+	double best = 0;
+	for(std::size_t trial = 0; trial != 10; ++trial){
+		CrowdingRealCodedNSGAII nsga2;
+		nsga2.mu() = 10;
+		zdt1.init();
+		nsga2.init(zdt1);
+		for(std::size_t i = 0; i != 1000; ++i){
+			nsga2.step(zdt1);
+		}
+		HypervolumeCalculator hyp;
+		double volume = hyp(boost::adaptors::transform(nsga2.solution(),PointExtractor()),reference);
+		best = std::max(best,volume);
+	}
+	std::cout<<"\rZDT1 crowding: "<<best<<std::endl;
+	BOOST_CHECK_GT(best, zdt1Volume - 0.1);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
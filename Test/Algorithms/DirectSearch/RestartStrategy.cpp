@@ -0,0 +1,68 @@
+#define BOOST_TEST_MODULE DirectSearch_RestartStrategy
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/DirectSearch/RestartStrategy.h>
+#include <shark/Algorithms/DirectSearch/CMA.h>
+#include <shark/Algorithms/DirectSearch/ElitistCMA.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Rosenbrock.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Sphere.h>
+
+#include "../testFunction.h"
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Algorithms_DirectSearch_RestartStrategy)
+
+BOOST_AUTO_TEST_CASE( RestartStrategy_CMA_Sphere )
+{
+	Sphere function(3);
+	RestartStrategy<CMA> optimizer;
+
+	std::cout<<"Testing: "<<optimizer.name()<<" with "<<function.name()<<std::endl;
+	test_function( optimizer, function, _trials = 10, _iterations = 500, _epsilon = 1E-10 );
+}
+
+BOOST_AUTO_TEST_CASE( RestartStrategy_CMA_Rosenbrock )
+{
+	Rosenbrock function( 3 );
+	RestartStrategy<CMA> optimizer;
+
+	std::cout<<"\nTesting: "<<optimizer.name()<<" with "<<function.name()<<std::endl;
+	test_function( optimizer, function, _trials = 10, _iterations = 1000, _epsilon = 1E-10 );
+}
+
+BOOST_AUTO_TEST_CASE( RestartStrategy_ElitistCMA_Sphere )
+{
+	Sphere function(3);
+	RestartStrategy<ElitistCMA> optimizer;
+
+	std::cout<<"\nTesting: "<<optimizer.name()<<" with "<<function.name()<<std::endl;
+	test_function( optimizer, function, _trials = 10, _iterations = 1000, _epsilon = 1E-10 );
+}
+
+//restarts escalate the population size and must not lose the best solution
+BOOST_AUTO_TEST_CASE( RestartStrategy_Escalation )
+{
+	Sphere function(3);
+	RestartStrategy<CMA> optimizer(2, 10, 25);//frequent restarts
+	function.init();
+	optimizer.init(function);
+
+	std::size_t suggested = CMA::suggestLambda(3);
+	double best = optimizer.solution().value;
+	for(std::size_t iteration = 0; iteration != 200; ++iteration){
+		optimizer.step(function);
+		//the solution is monotone over restarts
+		BOOST_CHECK(optimizer.solution().value <= best);
+		best = optimizer.solution().value;
+	}
+	//after 200 generations with a budget of 25 every instance has been
+	//restarted and must run an escalated population
+	for(std::size_t i = 0; i != optimizer.numberOfConfigurations(); ++i){
+		BOOST_CHECK(optimizer.instance(i).lambda() > suggested);
+		BOOST_CHECK(optimizer.instance(i).lambda() % suggested == 0);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,188 @@
+#define BOOST_TEST_MODULE ML_Adam
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/GradientDescent/Adam.h>
+#include <shark/Algorithms/GradientDescent/AdaGrad.h>
+
+using namespace shark;
+
+struct TestFunction : public SingleObjectiveFunction
+{
+	typedef SingleObjectiveFunction Base;
+
+	RealMatrix A;
+	TestFunction():A(3,3,0.0)
+	{
+
+		A(0,0)=10;
+		A(1,1)=5;
+		A(2,2)=1;
+		A(1,0)=1;
+		A(0,1)=1;
+		A(2,0)=1;
+		A(0,2)=1;
+
+		m_features|=Base::HAS_FIRST_DERIVATIVE;
+	}
+
+	std::string name() const
+	{ return "TestFunction"; }
+
+	std::size_t numberOfVariables()const{
+		return 3;
+	}
+
+	virtual double eval(RealVector const& pattern)const
+	{
+		return inner_prod(prod(A,pattern),pattern);
+	}
+	virtual double evalDerivative(RealVector const& pattern, FirstOrderDerivative& derivative)const
+	{
+		derivative = 2*prod(A,pattern);
+		return eval(pattern);
+	}
+};
+
+
+//quadratic in the even coordinates only; the gradient has structural zeros
+//on the odd coordinates and can be emitted in sparse index/value form
+struct SparseTestFunction : public SingleObjectiveFunction
+{
+	typedef SingleObjectiveFunction Base;
+
+	RealVector a;
+	SparseTestFunction(bool sparse):a(6,0.0)
+	{
+		a(0)=10;
+		a(2)=5;
+		a(4)=1;
+
+		m_features|=Base::HAS_FIRST_DERIVATIVE;
+		if(sparse)
+			m_features|=Base::HAS_SPARSE_FIRST_DERIVATIVE;
+	}
+
+	std::string name() const
+	{ return "SparseTestFunction"; }
+
+	std::size_t numberOfVariables()const{
+		return a.size();
+	}
+
+	virtual double eval(RealVector const& pattern)const
+	{
+		return inner_prod(a, sqr(pattern));
+	}
+	virtual double evalDerivative(RealVector const& pattern, FirstOrderDerivative& derivative)const
+	{
+		derivative = 2 * a * pattern;
+		return eval(pattern);
+	}
+	virtual double evalSparseDerivative(RealVector const& pattern, SparseFirstOrderDerivative& derivative)const
+	{
+		derivative.indices.clear();
+		derivative.values.clear();
+		for(std::size_t i = 0; i != a.size(); i += 2){
+			derivative.indices.push_back(i);
+			derivative.values.push_back(2 * a(i) * pattern(i));
+		}
+		return eval(pattern);
+	}
+};
+
+BOOST_AUTO_TEST_SUITE (Algorithms_GradientDescent_Adam)
+
+BOOST_AUTO_TEST_CASE( Adam_Test )
+{
+	TestFunction function;
+	RealVector start(3);//startingPoint
+	start(0)=1;
+	start(1)=1;
+	start(2)=1;
+	Adam optimizer;
+	optimizer.setLearningRate(0.1);
+	optimizer.init(function,start);
+
+	// train the model
+	std::cout<<"Testing: "<<optimizer.name()<<" with "<<function.name()<<std::endl;
+	double error=0;
+	for(size_t iteration=0;iteration<1000;++iteration)
+	{
+		optimizer.step(function);
+		error=optimizer.solution().value;
+	}
+	std::cout<<"error:"<<error<<" parameter:"<<optimizer.solution().point<<std::endl;
+	BOOST_CHECK_SMALL(error,1.e-10);
+}
+
+BOOST_AUTO_TEST_CASE( AdaGrad_Test )
+{
+	TestFunction function;
+	RealVector start(3);//startingPoint
+	start(0)=1;
+	start(1)=1;
+	start(2)=1;
+	AdaGrad optimizer;
+	optimizer.setLearningRate(1.0);
+	optimizer.init(function,start);
+
+	// train the model
+	std::cout<<"Testing: "<<optimizer.name()<<" with "<<function.name()<<std::endl;
+	double error=0;
+	for(size_t iteration=0;iteration<1000;++iteration)
+	{
+		optimizer.step(function);
+		error=optimizer.solution().value;
+	}
+	std::cout<<"error:"<<error<<" parameter:"<<optimizer.solution().point<<std::endl;
+	BOOST_CHECK_SMALL(error,1.e-10);
+}
+
+//with a fixed sparsity pattern the sparse update paths must follow the dense
+//paths exactly: coordinates with zero gradient do not change any state
+BOOST_AUTO_TEST_CASE( Adam_Sparse_Test )
+{
+	SparseTestFunction sparseFunction(true);
+	SparseTestFunction denseFunction(false);
+	RealVector start(6,1.0);
+
+	Adam sparseOptimizer;
+	Adam denseOptimizer;
+	sparseOptimizer.setLearningRate(0.1);
+	denseOptimizer.setLearningRate(0.1);
+	sparseOptimizer.init(sparseFunction,start);
+	denseOptimizer.init(denseFunction,start);
+
+	for(size_t iteration=0;iteration<1000;++iteration)
+	{
+		sparseOptimizer.step(sparseFunction);
+		denseOptimizer.step(denseFunction);
+		BOOST_CHECK_EQUAL(norm_inf(sparseOptimizer.solution().point - denseOptimizer.solution().point), 0.0);
+	}
+	BOOST_CHECK_SMALL(sparseOptimizer.solution().value,1.e-10);
+}
+
+BOOST_AUTO_TEST_CASE( AdaGrad_Sparse_Test )
+{
+	SparseTestFunction sparseFunction(true);
+	SparseTestFunction denseFunction(false);
+	RealVector start(6,1.0);
+
+	AdaGrad sparseOptimizer;
+	AdaGrad denseOptimizer;
+	sparseOptimizer.setLearningRate(1.0);
+	denseOptimizer.setLearningRate(1.0);
+	sparseOptimizer.init(sparseFunction,start);
+	denseOptimizer.init(denseFunction,start);
+
+	for(size_t iteration=0;iteration<1000;++iteration)
+	{
+		sparseOptimizer.step(sparseFunction);
+		denseOptimizer.step(denseFunction);
+		BOOST_CHECK_EQUAL(norm_inf(sparseOptimizer.solution().point - denseOptimizer.solution().point), 0.0);
+	}
+	BOOST_CHECK_SMALL(sparseOptimizer.solution().value,1.e-10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
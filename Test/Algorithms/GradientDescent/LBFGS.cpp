@@ -8,6 +8,8 @@
 
 #include "../testFunction.h"
 
+#include <sstream>
+
 using namespace shark;
 
 BOOST_AUTO_TEST_SUITE (Algorithms_GradientDescent_LBFGS)
@@ -41,6 +43,54 @@ BOOST_AUTO_TEST_CASE( LBFGS_Dlinmin_Rosenbrock )
 	std::cout<<"Testing: "<<optimizer.name()<<" with "<<function.name()<<" and dlinmin"<<std::endl;
 	testFunction(optimizer,function,100,100);
 }
+BOOST_AUTO_TEST_CASE( LBFGS_HessianScaling )
+{
+	Rosenbrock function(3);
+	{
+		LBFGS optimizer;
+		optimizer.setHistCount(3);
+		optimizer.setHessianScaling(LBFGS::SCALING_IDENTITY);
+
+		std::cout<<"Testing: "<<optimizer.name()<<" with "<<function.name()<<" and identity scaling"<<std::endl;
+		testFunction(optimizer,function,100,200);
+	}
+	{
+		LBFGS optimizer;
+		optimizer.setHistCount(3);
+		optimizer.setHessianScaling(LBFGS::SCALING_FIXED);
+		optimizer.setInitialHessianScale(0.01);
+		BOOST_CHECK_EQUAL(optimizer.hessianScaling(), LBFGS::SCALING_FIXED);
+		BOOST_CHECK_CLOSE(optimizer.initialHessianScale(), 0.01, 1.e-10);
+
+		std::cout<<"Testing: "<<optimizer.name()<<" with "<<function.name()<<" and fixed scaling"<<std::endl;
+		testFunction(optimizer,function,100,200);
+	}
+}
+BOOST_AUTO_TEST_CASE( LBFGS_Checkpoint )
+{
+	Rosenbrock function(3);
+	function.init();
+	LBFGS optimizer;
+	optimizer.setHistCount(3);
+	optimizer.init(function,function.proposeStartingPoint());
+	for(std::size_t i = 0; i != 5; ++i)
+		optimizer.step(function);
+
+	//checkpoint the run mid-way and restore it into a fresh optimizer
+	std::stringstream checkpoint;
+	optimizer.saveState(checkpoint);
+	LBFGS restored;
+	restored.loadState(checkpoint);
+
+	//both runs must continue bit-exactly on the same trajectory
+	for(std::size_t i = 0; i != 10; ++i){
+		optimizer.step(function);
+		restored.step(function);
+		BOOST_REQUIRE_EQUAL(optimizer.solution().value, restored.solution().value);
+		for(std::size_t j = 0; j != 3; ++j)
+			BOOST_CHECK_EQUAL(optimizer.solution().point(j), restored.solution().point(j));
+	}
+}
 BOOST_AUTO_TEST_CASE( BFGS_wolfe_Rosenbrock )
 {
 	Rosenbrock function(3);
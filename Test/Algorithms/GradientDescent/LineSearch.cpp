@@ -7,14 +7,14 @@ using namespace shark;
 // The testfunction:
 struct Testfunction
 {
-	double eval(const RealVector& x)
+	double eval(const RealVector& x)const
 	{
 		return x(0) * x(0) + 2;
 	}
 
 
 	// The derivation of the testfunction:
-	double evalDerivative(const RealVector& x, RealVector& y)
+	double evalDerivative(const RealVector& x, RealVector& y)const
 	{
 		y(0) = 2 * x(0);
 		return eval(x);
@@ -40,4 +40,29 @@ BOOST_AUTO_TEST_CASE( LineSearch_DLinmin )
 	BOOST_CHECK_SMALL(fret-2,1.e-14);
 }
 
+BOOST_AUTO_TEST_CASE( LineSearch_SpeculativeWolfe )
+{
+	Testfunction function;
+	//sequential and concurrent evaluation must give the same result,
+	//as the function is stateless
+	for(int parallel = 0; parallel != 2; ++parallel){
+		RealVector p(1);     // initial search starting point
+		RealVector xi(1);    // direction of search
+		RealVector g(1);     // gradient at the starting point
+		p(0) = -3.;
+		xi(0) = 3.;
+		double fret = function.evalDerivative(p, g);
+		// Minimize function:
+		detail::speculativeWolfe(p, xi, fret, function, g, 1.0, 4, parallel != 0);
+
+		//the accepted step must decrease the function substantially; the loose
+		//curvature constant c2 = 0.9 does not force it all the way to the minimum
+		BOOST_CHECK(fret < 11.);
+		BOOST_CHECK_SMALL(fret-2, 1.0);
+		//value and gradient must belong to the accepted point
+		BOOST_CHECK_SMALL(fret - (p(0)*p(0) + 2), 1.e-14);
+		BOOST_CHECK_SMALL(g(0) - 2*p(0), 1.e-14);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
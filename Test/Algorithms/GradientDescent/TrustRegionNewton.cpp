@@ -29,6 +29,27 @@ BOOST_AUTO_TEST_CASE( TrustRegionNewton_Rosenbrock )
 	std::cout<<"Testing: "<<optimizer.name()<<" with "<<function.name()<<std::endl;
 	testFunction(optimizer,function,100,1000,1.e-14);
 }
+//the matrix-free mode only uses gradients, so the finite-difference error
+//limits the reachable accuracy
+BOOST_AUTO_TEST_CASE( TrustRegionNewton_HessianFree_Ellipsoid )
+{
+	Ellipsoid function(5);
+	TrustRegionNewton optimizer;
+	optimizer.setHessianFree(true);
+	BOOST_CHECK(optimizer.hessianFree());
+
+	std::cout<<"Testing: "<<optimizer.name()<<" with "<<function.name()<<" matrix-free"<<std::endl;
+	testFunction(optimizer,function,100,100,1.e-10);
+}
+BOOST_AUTO_TEST_CASE( TrustRegionNewton_HessianFree_Rosenbrock )
+{
+	Rosenbrock function(3);
+	TrustRegionNewton optimizer;
+	optimizer.setHessianFree(true);
+
+	std::cout<<"Testing: "<<optimizer.name()<<" with "<<function.name()<<" matrix-free"<<std::endl;
+	testFunction(optimizer,function,100,1000,1.e-10);
+}
 
 
 BOOST_AUTO_TEST_SUITE_END()
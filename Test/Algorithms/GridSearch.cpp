@@ -4,6 +4,8 @@
 
 #include <shark/Algorithms/DirectSearch/GridSearch.h>
 
+#include <algorithm>
+
 using namespace shark;
 
 struct TestFunction : public SingleObjectiveFunction
@@ -38,6 +40,15 @@ struct TestFunction : public SingleObjectiveFunction
 	}
 };
 
+//same function, but flagged thread safe so the sweep is evaluated in parallel
+struct ThreadSafeTestFunction : public TestFunction
+{
+	ThreadSafeTestFunction()
+	{
+		m_features|=Base::IS_THREAD_SAFE;
+	}
+};
+
 BOOST_AUTO_TEST_SUITE (Algorithms_GridSearch)
 
 BOOST_AUTO_TEST_CASE( NestedGridSearch_initialized )
@@ -171,6 +182,77 @@ BOOST_AUTO_TEST_CASE( GridSearch_init_Model_Linear )
 	std::cout<<"GridSearch_init_individual_param done. Error:"<<error<<std::endl;
 	BOOST_CHECK_SMALL(error,1.e-15);
 }
+BOOST_AUTO_TEST_CASE( GridSearch_Archive )
+{
+	TestFunction function;
+	GridSearch optimizer;
+	optimizer.configure(2,-1,1,5);
+	optimizer.setArchiveSize(5);
+	optimizer.init(function);
+	optimizer.step(function);
+
+	//compute all grid values by hand and pick the five best
+	std::vector<double> values;
+	for(size_t i=0;i!=5;++i)
+	{
+		for(size_t j=0;j!=5;++j)
+		{
+			RealVector point(2);
+			point(0)=-1+i*0.5;
+			point(1)=-1+j*0.5;
+			values.push_back(function.eval(point));
+		}
+	}
+	std::sort(values.begin(),values.end());
+
+	BOOST_REQUIRE_EQUAL(optimizer.archive().size(),5u);
+	BOOST_CHECK_EQUAL(optimizer.archive()[0].value,optimizer.solution().value);
+	for(size_t i=0;i!=5;++i)
+	{
+		BOOST_CHECK_EQUAL(optimizer.archive()[i].value,values[i]);
+	}
+}
+BOOST_AUTO_TEST_CASE( GridSearch_Callback )
+{
+	TestFunction function;
+	GridSearch optimizer;
+	optimizer.configure(2,-1,1,5);
+	optimizer.init(function);
+
+	//the callback sees every evaluated grid point
+	std::size_t numResults=0;
+	optimizer.setResultCallback([&](GridSearch::SolutionType const&){
+		++numResults;
+		return true;
+	});
+	optimizer.step(function);
+	BOOST_CHECK_EQUAL(numResults,25u);
+	BOOST_CHECK_SMALL(optimizer.solution().value,1.e-15);
+
+	//returning false aborts the sweep
+	numResults=0;
+	optimizer.setResultCallback([&](GridSearch::SolutionType const&){
+		++numResults;
+		return numResults<10;
+	});
+	optimizer.step(function);
+	BOOST_CHECK_EQUAL(numResults,10u);
+}
+BOOST_AUTO_TEST_CASE( GridSearch_Parallel )
+{
+	ThreadSafeTestFunction function;
+	GridSearch optimizer;
+	optimizer.configure(2,-1,1,5);
+	optimizer.setArchiveSize(3);
+	optimizer.init(function);
+	// train the model
+	optimizer.step(function);
+	double error=optimizer.solution().value;
+	std::cout<<"GridSearch_Parallel done. Error:"<<error<<std::endl;
+	BOOST_CHECK_SMALL(error,1.e-15);
+	BOOST_REQUIRE_EQUAL(optimizer.archive().size(),3u);
+	BOOST_CHECK_EQUAL(optimizer.archive()[0].value,error);
+}
 BOOST_AUTO_TEST_CASE( PointSearch_initialized )
 {
 	std::vector<RealVector> points;
@@ -207,5 +289,21 @@ BOOST_AUTO_TEST_CASE( PointSearch_random )
 	std::cout<<"PointSearch_random done. Error:"<<error<<std::endl;
 	BOOST_CHECK_SMALL(error,1.e-5);
 }
+BOOST_AUTO_TEST_CASE( PointSearch_Archive_Parallel )
+{
+	ThreadSafeTestFunction function;
+	PointSearch optimizer;
+	optimizer.configure(2,1000,-1,1);
+	optimizer.setArchiveSize(10);
+	optimizer.init(function);
+	// train the model
+	optimizer.step(function);
+	BOOST_REQUIRE_EQUAL(optimizer.archive().size(),10u);
+	BOOST_CHECK_EQUAL(optimizer.archive()[0].value,optimizer.solution().value);
+	for(size_t i=1;i!=10;++i)
+	{
+		BOOST_CHECK(optimizer.archive()[i-1].value<=optimizer.archive()[i].value);
+	}
+}
 
 BOOST_AUTO_TEST_SUITE_END()
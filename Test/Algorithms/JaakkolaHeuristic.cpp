@@ -91,4 +91,28 @@ BOOST_AUTO_TEST_CASE( Algorithms_JaakkolaHeuristic )
 	BOOST_CHECK_SMALL(std::abs(sigma - 2.0), 1e-14);
 }
 
+BOOST_AUTO_TEST_CASE( Algorithms_JaakkolaHeuristic_Sampled )
+{
+	// same dataset as above
+	std::vector<RealVector> inputs(6, RealVector(1));
+	for (std::size_t i=0; i<6; i++) inputs[i](0) = (double)i;
+	std::vector<unsigned int> targets(6);
+	for (std::size_t i=0; i<6; i++) targets[i] = (i < 3) ? 0 : 1;
+	ClassificationDataset dataset = createLabeledDataFromRange(inputs, targets);
+
+	Rng::seed(42);
+
+	// with this many samples all nine distinct pairs appear, so the
+	// extreme quantiles are exact and the median lands on the mode
+	JaakkolaHeuristic jh(dataset, false, 2000);
+	BOOST_CHECK_SMALL(std::abs(jh.sigma(0.0) - 1.0), 1e-14);
+	BOOST_CHECK_SMALL(std::abs(jh.sigma(0.5) - 3.0), 1e-14);
+	BOOST_CHECK_SMALL(std::abs(jh.sigma(1.0) - 5.0), 1e-14);
+
+	// sampled nearest false neighbor distances lie in {1,2,3}
+	JaakkolaHeuristic jhNearest(dataset, true, 2000);
+	BOOST_CHECK_SMALL(std::abs(jhNearest.sigma(0.0) - 1.0), 1e-14);
+	BOOST_CHECK_SMALL(std::abs(jhNearest.sigma(1.0) - 3.0), 1e-14);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -88,6 +88,44 @@ BOOST_AUTO_TEST_CASE(KMeans_simple)
 	BOOST_CHECK_LE(iterations, 3u);
 }
 
+BOOST_AUTO_TEST_CASE(KMeans_minibatch_simple)
+{
+	RealVector v(1);
+
+	// prepare data set
+	std::vector<RealVector> data(300);
+	for (std::size_t i=0; i<100; i++)
+	{
+		v(0) = Rng::uni();
+		data[i] = v;
+		v(0) = Rng::uni() + 10.0;
+		data[100+i] = v;
+		v(0) = Rng::uni() + 20.0;
+		data[200+i] = v;
+	}
+	Data<RealVector> dataset = createDataFromRange(data);
+
+	// prepare initial centroids
+	std::vector<RealVector> start(3);
+	v(0) =  2.0; start[0] = v;
+	v(0) =  7.0; start[1] = v;
+	v(0) = 25.0; start[2] = v;
+	Centroids centroids( createDataFromRange(start));
+
+	// invoke minibatch k-means
+	kMeansMinibatch(dataset, 3, centroids, 100, 100);
+
+	// check result; the stochastic updates only approximate the cluster means
+	Data<RealVector> const& c = centroids.centroids();
+	BOOST_CHECK_EQUAL(c.numberOfElements(), 3u);
+	BOOST_CHECK(c.element(0)(0) > -0.5);
+	BOOST_CHECK(c.element(0)(0) <  1.5);
+	BOOST_CHECK(c.element(1)(0) >  9.5);
+	BOOST_CHECK(c.element(1)(0) < 11.5);
+	BOOST_CHECK(c.element(2)(0) > 19.5);
+	BOOST_CHECK(c.element(2)(0) < 21.5);
+}
+
 // tests whether the algorithm leads to clusters which are constant (i.e. the algorithm converged to
 // a stationary solution).
 BOOST_AUTO_TEST_CASE(KMeans_multiple_gauss)
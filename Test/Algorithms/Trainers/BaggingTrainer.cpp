@@ -0,0 +1,73 @@
+#define BOOST_TEST_MODULE ALGORITHMS_TRAINERS_BAGGINGTRAINER
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/Trainers/BaggingTrainer.h>
+#include <shark/Algorithms/Trainers/LinearSAGTrainer.h>
+#include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
+#include <shark/Rng/GlobalRng.h>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Algorithms_Trainers_BaggingTrainer)
+
+BOOST_AUTO_TEST_CASE( BaggingTrainer_Regression )
+{
+	Rng::seed(42);
+	std::size_t n = 500;
+	std::size_t dim = 5;
+	RealVector wTrue(dim);
+	for(std::size_t j = 0; j != dim; ++j) wTrue(j) = Rng::gauss(0,1);
+
+	std::vector<RealVector> inputs(n, RealVector(dim));
+	std::vector<RealVector> labels(n, RealVector(1));
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != dim; ++j) inputs[i](j) = Rng::gauss(0,1);
+		labels[i](0) = inner_prod(wTrue, inputs[i]) + 0.1*Rng::gauss(0,1);
+	}
+	RegressionDataset dataset = createLabeledDataFromRange(inputs, labels);
+
+	SquaredLoss<RealVector> loss;
+	LinearSAGTrainer<RealVector, RealVector> sag(&loss, 1.e-4);
+	BaggingTrainer<LinearSAGTrainer<RealVector, RealVector> > trainer(&sag, 20);
+	trainer.setOOBLoss(&loss);
+
+	MeanModel<LinearModel<RealVector> > model;
+	trainer.train(model, dataset);
+	BOOST_REQUIRE_EQUAL(model.numberOfModels(), 20u);
+
+	//the ensemble mean must fit the linear target
+	double error = loss.eval(dataset.labels(), model(dataset.inputs()));
+	BOOST_CHECK_SMALL(error, 0.05);
+
+	//the out-of-bag error is an estimate of the test error, which is
+	//bounded from below by the noise variance
+	BOOST_CHECK(trainer.OOBerror() > 0.0);
+	BOOST_CHECK_SMALL(trainer.OOBerror(), 0.05);
+}
+
+BOOST_AUTO_TEST_CASE( BaggingTrainer_No_OOB_Loss )
+{
+	Rng::seed(43);
+	std::size_t n = 100;
+	std::vector<RealVector> inputs(n, RealVector(2));
+	std::vector<RealVector> labels(n, RealVector(1));
+	for(std::size_t i = 0; i != n; ++i){
+		inputs[i](0) = Rng::gauss(0,1);
+		inputs[i](1) = Rng::gauss(0,1);
+		labels[i](0) = inputs[i](0) - inputs[i](1);
+	}
+	RegressionDataset dataset = createLabeledDataFromRange(inputs, labels);
+
+	SquaredLoss<RealVector> loss;
+	LinearSAGTrainer<RealVector, RealVector> sag(&loss, 1.e-4);
+	BaggingTrainer<LinearSAGTrainer<RealVector, RealVector> > trainer(&sag, 5);
+
+	MeanModel<LinearModel<RealVector> > model;
+	trainer.train(model, dataset);
+	BOOST_CHECK_EQUAL(model.numberOfModels(), 5u);
+	//without a loss no out-of-bag error is computed
+	BOOST_CHECK_EQUAL(trainer.OOBerror(), 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,140 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       ProjectBudgetMaintenanceStrategy Test
+ *
+ *
+ *
+ * \author      -
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#define BOOST_TEST_MODULE PROJECTBUDGETMAINTENANCESTRATEGY
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/Trainers/Budgeted/AbstractBudgetMaintenanceStrategy.h>
+#include <shark/Algorithms/Trainers/Budgeted/ProjectBudgetMaintenanceStrategy.h>
+#include <shark/LinAlg/solveSystem.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+#include <shark/Models/Kernels/KernelExpansion.h>
+#include <shark/Rng/GlobalRng.h>
+
+
+using namespace shark;
+
+
+
+
+BOOST_AUTO_TEST_SUITE (Algorithms_Trainers_Budgeted_ProjectBudgetMaintenanceStrategy_Test)
+
+BOOST_AUTO_TEST_CASE( ProjectBudgetMaintenanceStrategy_addToModel)
+{
+	// several consecutive projections must match a reference computation of
+	// the projection system solved from scratch each time; this covers both
+	// the initial factorization and the incremental factor maintenance.
+	const size_t budget = 8;
+	const size_t dim = 3;
+	const size_t classes = 2;
+	const size_t iterations = 5;
+
+	GaussianRbfKernel<> kernel(0.5);
+	std::vector<RealVector> points(budget, RealVector(dim));
+	std::vector<unsigned int> labels(budget, 0);
+	for(size_t i = 0; i < budget; i++)
+		for(size_t j = 0; j < dim; j++)
+			points[i](j) = Rng::gauss();
+	ClassificationDataset basisData = createLabeledDataFromRange(points, labels);
+	KernelExpansion<RealVector> model(&kernel, basisData.inputs(), false, classes);
+
+	// fill the budget; the last slot is the free buffer entry
+	for(size_t i = 0; i + 1 < budget; i++)
+		for(size_t c = 0; c < classes; c++)
+			model.alpha(i, c) = Rng::gauss();
+
+	ProjectBudgetMaintenanceStrategy<RealVector> strategy;
+	for(size_t iteration = 0; iteration < iterations; iteration++)
+	{
+		RealVector newPoint(dim);
+		for(size_t j = 0; j < dim; j++)
+			newPoint(j) = Rng::gauss();
+		RealVector newAlpha(classes);
+		for(size_t c = 0; c < classes; c++)
+			newAlpha(c) = Rng::gauss();
+
+		// reference: simulate the bookkeeping of addToModel and solve the
+		// projection system with a dense solver
+		std::vector<RealVector> refBasis(budget);
+		for(size_t i = 0; i < budget; i++)
+			refBasis[i] = model.basis().element(i);
+		RealMatrix refAlpha = model.alpha();
+		refBasis[budget - 1] = newPoint;
+		noalias(row(refAlpha, budget - 1)) = newAlpha;
+
+		size_t firstIndex = 0;
+		double firstAlpha = norm_2(row(refAlpha, 0));
+		for(size_t i = 1; i < budget; i++){
+			if(norm_2(row(refAlpha, i)) < firstAlpha){
+				firstAlpha = norm_2(row(refAlpha, i));
+				firstIndex = i;
+			}
+		}
+		BOOST_REQUIRE(firstAlpha > 0.0);
+
+		std::vector<size_t> others;
+		for(size_t i = 0; i < budget; i++)
+			if(i != firstIndex)
+				others.push_back(i);
+		RealMatrix gram(others.size(), others.size());
+		RealVector rhs(others.size());
+		for(size_t i = 0; i < others.size(); i++){
+			for(size_t j = 0; j < others.size(); j++)
+				gram(i, j) = kernel.eval(refBasis[others[i]], refBasis[others[j]]);
+			rhs(i) = kernel.eval(refBasis[others[i]], refBasis[firstIndex]);
+		}
+		RealMatrix linear = outer_prod(rhs, row(refAlpha, firstIndex));
+		RealMatrix beta;
+		blas::solveSymmPosDefSystem<blas::SolveAXB>(gram, beta, linear);
+		for(size_t i = 0; i < others.size(); i++)
+			noalias(row(refAlpha, others[i])) += row(beta, i);
+		refBasis[firstIndex] = newPoint;
+		noalias(row(refAlpha, firstIndex)) = row(refAlpha, budget - 1);
+		row(refAlpha, budget - 1).clear();
+
+		// the strategy must produce the same budget
+		strategy.addToModel(model, newAlpha, DataPair<RealVector, unsigned int>(newPoint, 0u));
+		for(size_t i = 0; i < budget; i++){
+			RealVector budgetVector = model.basis().element(i);
+			BOOST_CHECK_SMALL(norm_2(budgetVector - refBasis[i]), 1e-10);
+			BOOST_CHECK_SMALL(norm_2(row(model.alpha(), i) - row(refAlpha, i)), 1e-8);
+		}
+	}
+}
+
+
+
+BOOST_AUTO_TEST_SUITE_END()
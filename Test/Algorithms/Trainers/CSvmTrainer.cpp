@@ -243,6 +243,47 @@ BOOST_AUTO_TEST_CASE( CSVM_TRAINER_WARM_START )
 	BOOST_CHECK_LE(trainer.solutionProperties().iterations, iter);
 }
 
+BOOST_AUTO_TEST_CASE( CSVM_TRAINER_REGULARIZATION_PATH )
+{
+	std::size_t n = 250;
+	std::vector<RealVector> input(n);
+	std::vector<unsigned int> target(n);
+	for (std::size_t i=0; i<n; i++)
+	{
+		input[i].resize(2);
+		input[i](0) = 0.01 * i;
+		input[i](1) = 0.1 * (i % 37);
+		target[i] = (double)(i / (n/2));   // 0-1-labels
+	}
+	ClassificationDataset dataset = createLabeledDataFromRange(input, target);
+
+	RealVector path(4);
+	path(0) = 0.01; path(1) = 0.1; path(2) = 1.0; path(3) = 10.0;
+
+	// with and without offset: every machine of the path must agree with
+	// a machine trained from scratch at the same value of C
+	for (int offset = 0; offset < 2; offset++)
+	{
+		GaussianRbfKernel<> kernel(0.5);
+		CSvmTrainer<RealVector> trainer(&kernel, 1.0, offset != 0);
+		std::vector<KernelClassifier<RealVector> > svms;
+		trainer.trainPath(svms, dataset, path);
+		BOOST_REQUIRE_EQUAL(svms.size(), path.size());
+
+		for (std::size_t k=0; k<path.size(); k++)
+		{
+			CSvmTrainer<RealVector> single(&kernel, path(k), offset != 0);
+			KernelClassifier<RealVector> svm;
+			single.train(svm, dataset);
+
+			Data<RealVector> fPath = svms[k].decisionFunction()(dataset.inputs());
+			Data<RealVector> fSingle = svm.decisionFunction()(dataset.inputs());
+			for (std::size_t i=0; i<n; i++)
+				BOOST_CHECK_SMALL(fPath.element(i)(0) - fSingle.element(i)(0), 1e-2);
+		}
+	}
+}
+
 template<class Model1, class Model2, class Dataset>
 void checkSVMSolutionsEqual(
 	Model1 const& model1, Model2 const& model2, 
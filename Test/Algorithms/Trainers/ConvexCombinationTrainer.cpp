@@ -0,0 +1,94 @@
+#define BOOST_TEST_MODULE TRAINERS_CONVEXCOMBINATIONTRAINER
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/Trainers/ConvexCombinationTrainer.h>
+#include <shark/Models/LinearModel.h>
+#include <shark/Rng/GlobalRng.h>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Trainers_ConvexCombinationTrainer)
+
+BOOST_AUTO_TEST_CASE( ConvexCombinationTrainer_Predictions ){
+	// training directly on a prediction matrix whose labels are a known
+	// convex combination must recover the generating weights
+	std::size_t numPoints = 1000;
+	std::size_t numMembers = 3;
+	RealVector trueWeights(numMembers);
+	trueWeights(0) = 0.5;
+	trueWeights(1) = 0.3;
+	trueWeights(2) = 0.2;
+
+	std::vector<RealVector> predictions(numPoints, RealVector(numMembers));
+	std::vector<RealVector> labels(numPoints, RealVector(1));
+	for(std::size_t i = 0; i != numPoints; ++i){
+		for(std::size_t j = 0; j != numMembers; ++j)
+			predictions[i](j) = Rng::gauss();
+		labels[i](0) = inner_prod(trueWeights, predictions[i]);
+	}
+	LabeledData<RealVector,RealVector> dataset(
+		createDataFromRange(predictions,100),
+		createDataFromRange(labels,100)
+	);
+
+	ConvexCombination model;
+	ConvexCombinationTrainer trainer(NULL,10000,0.5);
+	trainer.train(model,dataset);
+
+	BOOST_REQUIRE_EQUAL(model.inputSize(), numMembers);
+	BOOST_REQUIRE_EQUAL(model.outputSize(), 1u);
+	// the weights are a point on the simplex...
+	BOOST_CHECK_CLOSE(sum(row(model.weights(),0)), 1.0, 1.e-10);
+	BOOST_CHECK(min(row(model.weights(),0)) > 0);
+	// ...close to the generating one
+	for(std::size_t j = 0; j != numMembers; ++j)
+		BOOST_CHECK_SMALL(model.weights()(0,j) - trueWeights(j), 1.e-3);
+}
+
+BOOST_AUTO_TEST_CASE( ConvexCombinationTrainer_Members ){
+	// the member overload must assemble the prediction matrix itself and
+	// find the weights of the member generating the labels
+	std::size_t numPoints = 500;
+	std::size_t dims = 2;
+
+	std::vector<LinearModel<> > members(3);
+	for(std::size_t j = 0; j != members.size(); ++j){
+		members[j].setStructure(dims,1,false);
+		RealVector parameters(members[j].numberOfParameters());
+		for(std::size_t i = 0; i != parameters.size(); ++i)
+			parameters(i) = Rng::uni(-1,1);
+		members[j].setParameterVector(parameters);
+	}
+	std::vector<AbstractModel<RealVector,RealVector>*> memberPointers;
+	for(std::size_t j = 0; j != members.size(); ++j)
+		memberPointers.push_back(&members[j]);
+
+	std::vector<RealVector> inputs(numPoints, RealVector(dims));
+	for(std::size_t i = 0; i != numPoints; ++i){
+		for(std::size_t j = 0; j != dims; ++j)
+			inputs[i](j) = Rng::uni(-1,1);
+	}
+	Data<RealVector> inputData = createDataFromRange(inputs,64);
+	// labels: 0.7 times member 0 plus 0.3 times member 1
+	Data<RealVector> member0 = members[0](inputData);
+	Data<RealVector> member1 = members[1](inputData);
+	Data<RealVector> labelData(inputData.numberOfBatches());
+	for(std::size_t b = 0; b != inputData.numberOfBatches(); ++b)
+		labelData.batch(b) = 0.7*member0.batch(b) + 0.3*member1.batch(b);
+	LabeledData<RealVector,RealVector> dataset(inputData,labelData);
+
+	ConvexCombination model;
+	ConvexCombinationTrainer trainer(NULL,10000,0.5);
+	trainer.train(model,memberPointers,dataset);
+
+	BOOST_REQUIRE_EQUAL(model.inputSize(), memberPointers.size());
+	BOOST_CHECK_CLOSE(sum(row(model.weights(),0)), 1.0, 1.e-10);
+	// convergence towards the simplex boundary is sublinear, so the
+	// tolerance is looser than in the interior case above
+	BOOST_CHECK_SMALL(model.weights()(0,0) - 0.7, 1.e-2);
+	BOOST_CHECK_SMALL(model.weights()(0,1) - 0.3, 1.e-2);
+	BOOST_CHECK_SMALL(model.weights()(0,2), 1.e-2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
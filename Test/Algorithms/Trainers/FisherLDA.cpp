@@ -68,4 +68,31 @@ BOOST_AUTO_TEST_CASE( FISHER_LDA_TEST ){
 	}
 }
 
+BOOST_AUTO_TEST_CASE( FISHER_LDA_WIDE_DATA_TEST ){
+	// two spherical classes in a wide input space; the discriminant
+	// direction is the axis separating the class means
+	const size_t trainExamples = 20000;
+	const size_t dims = 60;
+	FisherLDA trainer(false, 1);
+	LinearModel<> model(dims, 1, true);
+
+	std::vector<RealVector> input(trainExamples, RealVector(dims));
+	std::vector<unsigned int> target(trainExamples);
+	for(size_t i=0;i!=trainExamples;++i) {
+		target[i] = i % 2;
+		for(size_t j=0;j!=dims;++j)
+			input[i](j) = Rng::gauss();
+		input[i](0) += target[i]? 10.0 : -10.0;
+	}
+	ClassificationDataset dataset = createLabeledDataFromRange(input,target);
+
+	trainer.train(model, dataset);
+
+	RealVector result(dims,0.0);
+	result(0) = 1;
+	RealVector direction = row(model.matrix(), 0);
+	double error = std::min(norm_sqr(direction - result), norm_sqr(direction + result));
+	BOOST_CHECK_SMALL(error, 1e-2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,100 @@
+#define BOOST_TEST_MODULE ALGORITHMS_TRAINERS_GRADIENTBOOSTINGTRAINER
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/Trainers/GradientBoostingTrainer.h>
+#include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <sstream>
+
+using namespace shark;
+
+namespace {
+
+// noisy nonlinear target on which a linear model fails
+void createProblem(
+	std::vector<RealVector>& x,
+	std::vector<unsigned int>& y,
+	std::vector<RealVector>& yr,
+	std::size_t n, std::size_t dim
+){
+	x.assign(n, RealVector(dim));
+	y.resize(n);
+	yr.assign(n, RealVector(1));
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t d = 0; d != dim; ++d) x[i](d) = Rng::gauss(0,1);
+		double f = x[i](0) + 2*x[i](1)*x[i](1) - x[i](2);
+		y[i] = f > 0 ? 1u : 0u;
+		yr[i](0) = f + 0.1*Rng::gauss(0,1);
+	}
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE (Algorithms_Trainers_GradientBoostingTrainer)
+
+BOOST_AUTO_TEST_CASE( GradientBoostingTrainer_Regression )
+{
+	Rng::seed(42);
+	std::vector<RealVector> x;
+	std::vector<unsigned int> y;
+	std::vector<RealVector> yr;
+	createProblem(x, y, yr, 1500, 6);
+	RegressionDataset dataset = createLabeledDataFromRange(
+		std::vector<RealVector>(x.begin(), x.begin()+1000),
+		std::vector<RealVector>(yr.begin(), yr.begin()+1000));
+
+	GradientBoostingTrainer trainer;
+	trainer.setNumberOfTrees(200);
+	GradientBoostingModel model;
+	trainer.train(model, dataset);
+	BOOST_REQUIRE_EQUAL(model.numberOfModels(), 200u);
+
+	// the ensemble must fit the nonlinear target well out of sample
+	double testError = 0.0;
+	for(std::size_t i = 1000; i != x.size(); ++i){
+		testError += sqr(model(x[i])(0) - yr[i](0));
+	}
+	testError /= (x.size() - 1000);
+	BOOST_CHECK_SMALL(testError, 0.5);
+
+	// serialization round trip reproduces the predictions exactly
+	std::ostringstream oss;
+	TextOutArchive oa(oss);
+	model.write(oa);
+	std::istringstream iss(oss.str());
+	TextInArchive ia(iss);
+	GradientBoostingModel modelCopy;
+	modelCopy.read(ia);
+	for(std::size_t i = 1000; i != x.size(); ++i){
+		BOOST_CHECK_EQUAL(model(x[i])(0), modelCopy(x[i])(0));
+	}
+}
+
+BOOST_AUTO_TEST_CASE( GradientBoostingTrainer_Classification )
+{
+	Rng::seed(42);
+	std::vector<RealVector> x;
+	std::vector<unsigned int> y;
+	std::vector<RealVector> yr;
+	createProblem(x, y, yr, 1500, 6);
+	ClassificationDataset dataset = createLabeledDataFromRange(
+		std::vector<RealVector>(x.begin(), x.begin()+1000),
+		std::vector<unsigned int>(y.begin(), y.begin()+1000));
+
+	GradientBoostingTrainer trainer;
+	trainer.setNumberOfTrees(200);
+	trainer.setSubsamplingFraction(0.5);
+	GradientBoostingModel model;
+	trainer.train(model, dataset);
+
+	// log-odds output thresholded at zero
+	std::size_t errors = 0;
+	for(std::size_t i = 1000; i != x.size(); ++i){
+		if((model(x[i])(0) > 0) != (y[i] == 1)) ++errors;
+	}
+	BOOST_CHECK_SMALL(double(errors)/(x.size() - 1000), 0.15);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -130,6 +130,42 @@ BOOST_AUTO_TEST_CASE( Normalize_Kernel_Unit_Variance_InFeatureSpace_GaussianKern
 	control /= num_points;
 	BOOST_CHECK_SMALL( control - 1.0, 1e-12 );
 }
+BOOST_AUTO_TEST_CASE( Normalize_Kernel_Unit_Variance_InFeatureSpace_Update )
+{
+	// extending a normalization incrementally must match training on the full data
+	std::size_t num_dims = 5;
+	std::size_t num_points = 100;
+	std::size_t num_old_points = 70;
+	std::vector<RealVector> input(num_points);
+	RealVector v(num_dims);
+	for ( std::size_t i=0; i<num_points; i++ ) {
+		for ( std::size_t j=0; j<num_dims; j++ ) {
+			v(j) = Rng::uni(-1,1);
+		}
+		input[i] = v;
+	}
+	UnlabeledData<RealVector> data = createDataFromRange(input);
+	UnlabeledData<RealVector> oldData = createDataFromRange(
+		std::vector<RealVector>(input.begin(), input.begin()+num_old_points));
+	UnlabeledData<RealVector> newData = createDataFromRange(
+		std::vector<RealVector>(input.begin()+num_old_points, input.end()));
+
+	DenseRbfKernel kernel(0.5);
+	DenseScaledKernel scale( &kernel );
+	NormalizeKernelUnitVariance<> normalizer;
+	normalizer.train( scale, data );
+
+	DenseRbfKernel incrementalKernel(0.5);
+	DenseScaledKernel incrementalScale( &incrementalKernel );
+	NormalizeKernelUnitVariance<> incrementalNormalizer;
+	incrementalNormalizer.train( incrementalScale, oldData );
+	incrementalNormalizer.update( incrementalScale, oldData, newData );
+
+	BOOST_CHECK_SMALL( incrementalScale.factor() - scale.factor(), 1e-12 );
+	BOOST_CHECK_SMALL( incrementalNormalizer.mean() - normalizer.mean(), 1e-8 );
+	BOOST_CHECK_SMALL( incrementalNormalizer.trace() - normalizer.trace(), 1e-10 );
+}
+
 //BOOST_AUTO_TEST_CASE( Normalize_Kernel_Unit_Variance_InFeatureSpace_MklKernel )
 //{
 //	std::size_t num_dims = 9;
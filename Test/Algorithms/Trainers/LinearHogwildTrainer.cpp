@@ -0,0 +1,107 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       test case for the Linear Hogwild-Trainer
+ *
+ *
+ *
+ *
+ * \author      O.Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#define BOOST_TEST_MODULE ALGORITHMS_TRAINERS_Linear_Hogwild_Trainer
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Algorithms/Trainers/LinearHogwildTrainer.h>
+#include <shark/ObjectiveFunctions/Loss/CrossEntropy.h>
+#include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
+#include <shark/ObjectiveFunctions/Loss/ZeroOneLoss.h>
+#include <shark/Rng/GlobalRng.h>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Algorithms_Trainers_Linear_Hogwild_Trainer)
+
+BOOST_AUTO_TEST_CASE( LinearHogwildTrainer_Regression )
+{
+	Rng::seed(42);
+	std::size_t n = 1000;
+	std::size_t dim = 5;
+	RealVector wTrue(dim);
+	for(std::size_t j = 0; j != dim; ++j) wTrue(j) = Rng::gauss(0,1);
+
+	std::vector<RealVector> inputs(n, RealVector(dim));
+	std::vector<RealVector> labels(n, RealVector(1));
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != dim; ++j) inputs[i](j) = Rng::gauss(0,1);
+		labels[i](0) = inner_prod(wTrue, inputs[i]) + 0.1*Rng::gauss(0,1);
+	}
+	RegressionDataset dataset = createLabeledDataFromRange(inputs, labels);
+
+	SquaredLoss<> loss;
+	LinearHogwildTrainer<RealVector,RealVector> trainer(&loss, 0.0, 0.01);
+	BOOST_CHECK_EQUAL(trainer.lambda(),0.0);
+	BOOST_CHECK_CLOSE(trainer.learningRate(),0.01,1.e-10);
+	BOOST_CHECK_EQUAL(trainer.trainOffset(),true);
+	trainer.setEpochs(50);
+
+	LinearModel<RealVector> model;
+	trainer.train(model, dataset);
+	BOOST_REQUIRE_EQUAL(model.parameterVector().size(), dim + 1);
+
+	//the model must fit the linear target down to the noise floor
+	double error = loss.eval(dataset.labels(), model(dataset.inputs()));
+	BOOST_CHECK_SMALL(error, 0.02);
+}
+
+BOOST_AUTO_TEST_CASE( LinearHogwildTrainer_Classification )
+{
+	Rng::seed(43);
+	std::size_t n = 1000;
+	std::vector<RealVector> inputs(n, RealVector(2));
+	std::vector<unsigned int> labels(n);
+	for(std::size_t i = 0; i != n; ++i){
+		labels[i] = (unsigned int)(i % 2);
+		double mean = labels[i]? 2.0: -2.0;
+		inputs[i](0) = Rng::gauss(mean,1);
+		inputs[i](1) = Rng::gauss(-mean,1);
+	}
+	ClassificationDataset dataset = createLabeledDataFromRange(inputs, labels);
+
+	CrossEntropy loss;
+	LinearHogwildTrainer<RealVector,unsigned int> trainer(&loss, 1.e-4, 0.1);
+	trainer.setEpochs(20);
+
+	LinearClassifier<RealVector> model;
+	trainer.train(model, dataset);
+
+	ZeroOneLoss<unsigned int> zol;
+	double error = zol.eval(dataset.labels(), model(dataset.inputs()));
+	BOOST_CHECK_SMALL(error, 0.05);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
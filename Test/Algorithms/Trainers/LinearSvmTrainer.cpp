@@ -155,6 +155,76 @@ BOOST_AUTO_TEST_CASE( Binary_CSVM_TRAINER_TEST )
 	}
 }
 
+BOOST_AUTO_TEST_CASE( Binary_CSVM_DCD_TRAINER_TEST )
+{
+	size_t dim = 5;
+	size_t ell = 200;
+
+	double C = 1.0;
+
+	LinearCSvmTrainer<CompressedRealVector> defNoBias(C,false);
+	LinearCSvmTrainer<CompressedRealVector> defBias(C,true);
+	LinearCSvmTrainer<CompressedRealVector> dcdNoBias(C,false);
+	LinearCSvmTrainer<CompressedRealVector> dcdBias(C,true);
+	dcdNoBias.dualCoordinateDescent() = true;
+	dcdBias.dualCoordinateDescent() = true;
+
+	defNoBias.stoppingCondition().minAccuracy = MAX_KKT_VIOLATION;
+	dcdNoBias.stoppingCondition().minAccuracy = MAX_KKT_VIOLATION;
+
+	for (unsigned int run=0; run<10; run++)
+	{
+		// generate random training set
+		Rng::seed(run);
+		cout << endl << "generating test problem " << (run+1) << " out of 10" << endl;
+		vector<CompressedRealVector> input(ell, CompressedRealVector(dim));
+		vector<unsigned int> target(ell);
+		for (size_t i=0; i<ell; i++)
+		{
+			unsigned int label = Rng::coinToss();
+			for (unsigned int d=0; d<dim; d++)
+			{
+				input[i](d) = 0.3 * Rng::gauss() + 2*label-1;
+			}
+			target[i] = label;
+		}
+		LabeledData<CompressedRealVector, unsigned int> dataset = createLabeledDataFromRange(input, target);
+
+		// train machines with both solvers
+		LinearClassifier<CompressedRealVector> defaultNoBias;
+		LinearClassifier<CompressedRealVector> defaultBias;
+		defNoBias.train(defaultNoBias,dataset);
+		defBias.train(defaultBias,dataset);
+
+		LinearClassifier<CompressedRealVector> descentNoBias;
+		LinearClassifier<CompressedRealVector> descentBias;
+		dcdNoBias.train(descentNoBias,dataset);
+		dcdBias.train(descentBias,dataset);
+
+		// extract weight matrices
+		RealMatrix default_w_noBias = defaultNoBias.decisionFunction().matrix();
+		RealMatrix default_w_Bias = defaultBias.decisionFunction().matrix();
+		RealMatrix descent_w_noBias = descentNoBias.decisionFunction().matrix();
+		RealMatrix descent_w_Bias = descentBias.decisionFunction().matrix();
+
+		// output weight vectors for manual inspection
+		cout << "      default solver weight vectors: " << endl;
+		cout << "        " << row(default_w_noBias, 0) << endl;
+		cout << "        " << row(default_w_Bias, 0) << endl;
+		cout << "      dual coordinate descent solver weight vectors: " << endl;
+		cout << "        " << row(descent_w_noBias, 0) << endl;
+		cout << "        " << row(descent_w_Bias, 0) << endl;
+
+		// compare weight vectors
+		double n_noBias = norm_2(row(default_w_noBias, 0));
+		double n_Bias = norm_2(row(default_w_Bias, 0));
+		double d_noBias = norm_2(row(default_w_noBias, 0) - row(descent_w_noBias, 0));
+		double d_Bias = norm_2(row(default_w_Bias, 0) - row(descent_w_Bias, 0));
+		BOOST_CHECK_SMALL(d_noBias, RELATIVE_ACCURACY * n_noBias);
+		BOOST_CHECK_SMALL(d_Bias, RELATIVE_ACCURACY * n_Bias);
+	}
+}
+
 BOOST_AUTO_TEST_CASE( MCSVM_TRAINER_TEST )
 {
 	size_t classes = 5;
@@ -201,6 +201,36 @@ BOOST_AUTO_TEST_CASE( MCSVM_TRAINER_TEST )
 		CHECK_ALPHAS(input,svm.parameterVector(), alpha);
 	}
 
+	// WW-SVM with block working set
+	{
+		double alpha[15] = {0.4375, -0.25, -0.1875, -0.25, 0.4375, -0.1875, -0.25, -0.25, 0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+		KernelClassifier<RealVector> svm;
+		CSvmTrainer<RealVector> trainer(&kernel, 0.5, false);
+		trainer.setMcSvmType(McSvm::WW);
+		trainer.setMcBlockSize(8);
+		std::cout << "testing WW with block working set" << std::endl;
+		trainer.sparsify() = false;
+		trainer.stoppingCondition().minAccuracy = 1e-8;
+		trainer.train(svm, dataset);
+		std::cout << "kernel computations: " << trainer.accessCount() << std::endl;
+		CHECK_ALPHAS(input,svm.parameterVector(), alpha);
+	}
+
+	// CS-SVM with block working set
+	{
+		double alpha[15] = {0.25, -0.25, 0.0, -0.25, 0.25, 0.0, -0.000163, -0.25, 0.250163, -0.1666, -0.04166, 0.2083, 0.0, 0.0, 0.0};
+		KernelClassifier<RealVector> svm;
+		CSvmTrainer<RealVector> trainer(&kernel, 0.5, false);
+		trainer.setMcSvmType(McSvm::CS);
+		trainer.setMcBlockSize(8);
+		std::cout << "testing CS with block working set" << std::endl;
+		trainer.sparsify() = false;
+		trainer.stoppingCondition().minAccuracy = 1e-8;
+		trainer.train(svm, dataset);
+		std::cout << "kernel computations: " << trainer.accessCount() << std::endl;
+		CHECK_ALPHAS(input,svm.parameterVector(), alpha);
+	}
+
 	// Reinforced-SVM
 	{
 		double alpha[15] = {0.5, -0.5, 0.0, -0.5, 0.5, 0.0, -0.5, -0.5, 0.5, 0.0, 0.0, 0.25, 0.0, 0.0, 0.0};
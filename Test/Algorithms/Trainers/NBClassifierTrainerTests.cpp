@@ -166,6 +166,19 @@ BOOST_AUTO_TEST_CASE(TestNormal)
 	verifyNormalDistribution(myNbClassifier);
 }
 
+BOOST_AUTO_TEST_CASE(TestNormalSmallBatches)
+{
+	// The trained distributions must not depend on how the dataset is split into batches
+
+	LabeledData<RealVector, unsigned int> smallBatchData;
+	csvStringToData(smallBatchData, m_dataInString, LAST_COLUMN, ',', '#', 3);
+	BOOST_REQUIRE(smallBatchData.numberOfBatches() > 1u);
+
+	DummyNBClassifier myNbClassifier(2u, 3u); // all distributions are normal
+	m_NbTrainer.train(myNbClassifier, smallBatchData);
+	verifyNormalDistribution(myNbClassifier);
+}
+
 BOOST_AUTO_TEST_CASE(AccessInvidualDistTrainer)
 {
 	// Test that we are able to access individual distribution trainer
@@ -178,6 +191,39 @@ BOOST_AUTO_TEST_CASE(AccessInvidualDistTrainer)
 	BOOST_CHECK_NO_THROW(trainerContainer.setNormalTrainer(NormalTrainer()));
 }
 
+BOOST_AUTO_TEST_CASE(BulkTrainNormals)
+{
+	// Fitting many groups in one pass must give the same distributions as
+	// fitting each group individually
+
+	const std::size_t groupCount = 3u;
+	std::vector<double> input;
+	std::vector<std::size_t> groups;
+	std::vector<std::vector<double> > groupedInput(groupCount);
+	Uniform<> uniform(Rng::globalRng, 0.0, 5.0);
+	for (std::size_t i = 0; i < 60u; ++i)
+	{
+		const std::size_t group = i % groupCount;
+		const double value = uniform() + group;
+		input.push_back(value);
+		groups.push_back(group);
+		groupedInput[group].push_back(value);
+	}
+
+	DistTrainerContainer trainerContainer;
+	std::vector<Normal<> > bulkNormals(groupCount, Normal<>(Rng::globalRng));
+	trainerContainer.trainNormals(bulkNormals, input, groups);
+
+	NormalTrainer normalTrainer;
+	for (std::size_t group = 0; group < groupCount; ++group)
+	{
+		Normal<> expected(Rng::globalRng);
+		normalTrainer.train(expected, groupedInput[group]);
+		BOOST_CHECK_CLOSE(bulkNormals[group].mean(), expected.mean(), 1e-10);
+		BOOST_CHECK_CLOSE(bulkNormals[group].variance(), expected.variance(), 1e-10);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace shark {
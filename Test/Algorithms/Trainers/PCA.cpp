@@ -226,6 +226,78 @@ BOOST_AUTO_TEST_CASE( PCA_TEST_MORE_DATA_THAN_DIMENSIONS ){
 }
 
 
+BOOST_AUTO_TEST_CASE( PCA_TEST_INCREMENTAL ){
+	// feeding the data in chunks, partly through a merged second object,
+	// must give the same decomposition as training on all data at once
+	UnlabeledData<RealVector> data = createData3D();
+	std::size_t n = data.numberOfElements();
+	std::vector<RealVector> chunk1, chunk2, chunk3;
+	for(std::size_t i = 0; i != n; ++i){
+		if(i < n/3) chunk1.push_back(data.element(i));
+		else if(i < 2*(n/3)) chunk2.push_back(data.element(i));
+		else chunk3.push_back(data.element(i));
+	}
+
+	PCA pcaRef(data);
+
+	PCA pca;
+	pca.update(createDataFromRange(chunk1));
+	pca.update(createDataFromRange(chunk2));
+	PCA pcaShard;
+	pcaShard.update(createDataFromRange(chunk3));
+	pca.merge(pcaShard);
+	pca.finalize();
+
+	BOOST_REQUIRE_EQUAL(pca.eigenvalues().size(), pcaRef.eigenvalues().size());
+	for(std::size_t i = 0; i != 3; ++i){
+		BOOST_CHECK_SMALL(pca.eigenvalues()(i) - pcaRef.eigenvalues()(i), 1.e-8);
+		BOOST_CHECK_SMALL(pca.mean()(i) - pcaRef.mean()(i), 1.e-10);
+		// eigenvectors must agree up to sign
+		double cosine = inner_prod(
+			column(pca.eigenvectors(),i),
+			column(pcaRef.eigenvectors(),i)
+		);
+		BOOST_CHECK_SMALL(std::abs(cosine) - 1., 1.e-8);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( PCA_TEST_REFIT ){
+	// a warm-started refit over updated statistics must track the full
+	// decomposition of all data within a few subspace iteration sweeps
+	UnlabeledData<RealVector> day1 = createData3D();
+	UnlabeledData<RealVector> day2 = createData3D();
+
+	PCA pca;
+	pca.update(day1);
+	pca.finalize();//yesterday's basis
+	pca.update(day2);//today's data drifts the statistics
+
+	PCA pcaRef = pca;
+	pcaRef.finalize();//full eigendecomposition as reference
+
+	PCA pcaTruncated = pca;
+	pca.refit();
+	BOOST_REQUIRE_EQUAL(pca.eigenvalues().size(), 3u);
+	for(std::size_t i = 0; i != 3; ++i){
+		BOOST_CHECK_SMALL(pca.eigenvalues()(i) - pcaRef.eigenvalues()(i), 1.e-5);
+		BOOST_CHECK_SMALL(pca.mean()(i) - pcaRef.mean()(i), 1.e-10);
+		// eigenvectors must agree up to sign
+		double cosine = inner_prod(
+			column(pca.eigenvectors(),i),
+			column(pcaRef.eigenvectors(),i)
+		);
+		BOOST_CHECK_SMALL(std::abs(cosine) - 1., 1.e-6);
+	}
+
+	// refitting only the leading components truncates the basis
+	pcaTruncated.refit(2);
+	BOOST_REQUIRE_EQUAL(pcaTruncated.eigenvalues().size(), 2u);
+	BOOST_REQUIRE_EQUAL(pcaTruncated.eigenvectors().size2(), 2u);
+	for(std::size_t i = 0; i != 2; ++i){
+		BOOST_CHECK_SMALL(pcaTruncated.eigenvalues()(i) - pcaRef.eigenvalues()(i), 1.e-5);
+	}
+}
+
 BOOST_AUTO_TEST_CASE( PCA_TEST_LESS_DATA_THAN_DIMENSIONS ){
 
 	UnlabeledData<RealVector> data = createDataNotFullRank();
@@ -44,6 +44,15 @@ BOOST_AUTO_TEST_CASE( PERCEPTRON ){
 		BOOST_CHECK_EQUAL(target[i],model(input[i]));
 	}
 
+	//the batch update rule must also separate the data
+	KernelClassifier<RealVector> batchModel;
+	trainer.setBatchTraining(true);
+	BOOST_CHECK(trainer.batchTraining());
+	trainer.train(batchModel, dataset);
+	for(size_t i = 0; i != 6; ++i){
+		BOOST_CHECK_EQUAL(target[i],batchModel(input[i]));
+	}
+
 }
 
 
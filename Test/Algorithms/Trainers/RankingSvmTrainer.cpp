@@ -78,6 +78,24 @@ BOOST_AUTO_TEST_CASE( RANKINGSVM_TRAINER_SIMPLE_TEST )
 		BOOST_CHECK_SMALL(output.element(3)(0) + 1.0, 1e-6);
 		BOOST_CHECK_SMALL(output.element(4)(0) - 2.0, 1e-6);
 	}
+
+	// soft-margin training with implicitly represented pairs
+	{
+		std::cout << "Ranking-SVM implicit pairs" << std::endl;
+		LinearKernel<> kernel;
+		KernelExpansion<RealVector> svm;
+		RankingSvmTrainer<RealVector> trainer(&kernel, 10.0);
+		trainer.setImplicitPairs(true);
+		trainer.setImplicitIterations(500);
+		trainer.train(svm, dataset);
+
+		// check that the predictions are ordered according to the labels
+		Data<RealVector> output = svm(dataset.inputs());
+		BOOST_CHECK_LT(output.element(2)(0), output.element(0)(0));
+		BOOST_CHECK_LT(output.element(3)(0), output.element(0)(0));
+		BOOST_CHECK_LT(output.element(0)(0), output.element(1)(0));
+		BOOST_CHECK_LT(output.element(1)(0), output.element(4)(0));
+	}
 }
 
 
@@ -73,4 +73,46 @@ BOOST_AUTO_TEST_CASE( REGULARIZATION_NETWORK_TEST )
 	}
 }
 
+BOOST_AUTO_TEST_CASE( NYSTROM_REGULARIZATION_NETWORK_TEST )
+{
+	const std::size_t ell = 200;
+	const double lambda = 1e-6;
+
+	Wave prob(0.0, 5.0);
+	RegressionDataset training = prob.generateDataset(ell);
+
+	GaussianRbfKernel<> kernel(0.1);
+
+	//with as many landmarks as data points the exact solution is recovered
+	//up to the span of the duplicate-free landmark set
+	KernelExpansion<RealVector> svm;
+	NystromRegularizationNetworkTrainer<RealVector> trainer(&kernel, lambda, ell);
+	trainer.train(svm, training);
+
+	Data<RealVector> output = svm(training.inputs());
+	for (std::size_t i=0; i<training.numberOfElements(); i++)
+	{
+		double y = training.labels().element(i)(0);
+		double f = output.element(i)(0);
+		BOOST_CHECK_SMALL((f - y) * (f - y), 1e-6);
+	}
+
+	//a modest number of landmarks still gives a usable fit
+	KernelExpansion<RealVector> approximateSvm;
+	trainer.setNumberOfLandmarks(50);
+	BOOST_CHECK_EQUAL(trainer.numberOfLandmarks(), 50u);
+	trainer.train(approximateSvm, training);
+
+	output = approximateSvm(training.inputs());
+	double error = 0.0;
+	for (std::size_t i=0; i<training.numberOfElements(); i++)
+	{
+		double y = training.labels().element(i)(0);
+		double f = output.element(i)(0);
+		error += (f - y) * (f - y);
+	}
+	error /= training.numberOfElements();
+	BOOST_CHECK_SMALL(error, 1e-2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -201,4 +201,90 @@ BOOST_AUTO_TEST_CASE(IterativeNearestNeighborQueries)
 	}
 }
 
+// Queries on a tree with leaf buckets must return exactly the same
+// distances as brute force search, in increasing order.
+BOOST_AUTO_TEST_CASE(IterativeNearestNeighborQueries_BucketedTree)
+{
+	Rng::seed(43);
+	std::vector<RealVector> data(2000, RealVector(3));
+	for (std::size_t i=0; i<data.size(); i++)
+	{
+		data[i][0] = Rng::gauss();
+		data[i][1] = Rng::gauss();
+		data[i][2] = Rng::gauss();
+	}
+	UnlabeledData<RealVector> dataset = createDataFromRange(data);
+	KDTree<RealVector> tree(dataset, TreeConstruction(0, 16));
+
+	for (std::size_t k=0; k<5; k++)
+	{
+		RealVector point(3);
+		point(0) = Rng::gauss();
+		point(1) = Rng::gauss();
+		point(2) = Rng::gauss();
+
+		// brute force sorting (for comparison)
+		std::vector<std::size_t> index(data.size());
+		for (std::size_t i=0; i<data.size(); i++)
+			index[i] = i;
+		Comparator comparator(data, point);
+		std::sort(index.begin(), index.end(), comparator);
+
+		IterativeNNQuery<std::vector<RealVector> > query(&tree, data, point);
+		double previous = 0.0;
+		for (std::size_t i=0; i<100; i++)
+		{
+			std::pair<double,std::size_t> ret = query.next();
+			BOOST_CHECK_SMALL(ret.first - distance(data[index[i]], point), 1e-12);
+			BOOST_CHECK_SMALL(ret.first - distance(data[ret.second], point), 1e-12);
+			BOOST_CHECK_LE(previous, ret.first);
+			previous = ret.first;
+		}
+	}
+}
+
+// The batched matrix query must return the same neighborhoods
+// as the pair-based query, in the same linearized order.
+BOOST_AUTO_TEST_CASE(TreeNearestNeighborsBatchedQuery)
+{
+	Rng::seed(44);
+	std::size_t numPoints = 500;
+	std::vector<RealVector> inputs(numPoints, RealVector(3));
+	std::vector<RealVector> labels(numPoints, RealVector(2));
+	for (std::size_t i=0; i<numPoints; i++)
+	{
+		for (std::size_t j=0; j<3; j++)
+			inputs[i][j] = Rng::gauss();
+		for (std::size_t j=0; j<2; j++)
+			labels[i][j] = Rng::gauss();
+	}
+	RegressionDataset dataset = createLabeledDataFromRange(inputs, labels, 100);
+	KDTree<RealVector> tree(dataset.inputs());
+	TreeNearestNeighbors<RealVector, RealVector> algorithm(dataset, &tree);
+
+	std::size_t k = 7;
+	RealMatrix queries(20, 3);
+	for (std::size_t p=0; p<queries.size1(); p++)
+		for (std::size_t j=0; j<3; j++)
+			queries(p,j) = Rng::gauss();
+
+	std::vector<KeyValuePair<double, RealVector> > pairs = algorithm.getNeighbors(queries, k);
+	RealMatrix distances;
+	RealMatrix neighborLabels;
+	algorithm.getNeighbors(queries, k, distances, neighborLabels);
+
+	BOOST_REQUIRE_EQUAL(distances.size1(), queries.size1());
+	BOOST_REQUIRE_EQUAL(distances.size2(), k);
+	BOOST_REQUIRE_EQUAL(neighborLabels.size1(), k*queries.size1());
+	BOOST_REQUIRE_EQUAL(neighborLabels.size2(), 2u);
+	for (std::size_t p=0; p<queries.size1(); p++)
+	{
+		for (std::size_t i=0; i<k; i++)
+		{
+			BOOST_CHECK_EQUAL(distances(p,i), pairs[i+p*k].key);
+			BOOST_CHECK_EQUAL(max(abs(row(neighborLabels,i+p*k) - pairs[i+p*k].value)), 0.0);
+		}
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,131 @@
+#define BOOST_TEST_MODULE Core_BinarySnapshot
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Core/BinarySnapshot.h>
+#include <shark/Models/LinearModel.h>
+#include <shark/Models/Kernels/KernelExpansion.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+
+#include <sstream>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Core_BinarySnapshot)
+
+BOOST_AUTO_TEST_CASE( BinarySnapshot_Parameters )
+{
+	LinearModel<> model(5, 3, true);
+	RealVector parameters(model.numberOfParameters());
+	for(std::size_t i = 0; i != parameters.size(); ++i)
+		parameters(i) = 0.25 * i - 1;
+	model.setParameterVector(parameters);
+
+	std::stringstream stream;
+	saveBinarySnapshot(model, stream);
+
+	LinearModel<> loaded(5, 3, true);
+	loadBinarySnapshot(loaded, stream);
+	BOOST_CHECK_SMALL(norm_inf(loaded.parameterVector() - parameters), 1.e-15);
+
+	//a model with a different structure must be rejected
+	std::stringstream stream2;
+	saveBinarySnapshot(model, stream2);
+	LinearModel<> wrongStructure(4, 3, true);
+	BOOST_CHECK_THROW(loadBinarySnapshot(wrongStructure, stream2), shark::Exception);
+}
+
+BOOST_AUTO_TEST_CASE( BinarySnapshot_Data )
+{
+	std::vector<RealVector> points;
+	for(std::size_t i = 0; i != 23; ++i){
+		RealVector point(3);
+		point(0) = (double)i;
+		point(1) = 2.0 * i;
+		point(2) = -1.0 * i;
+		points.push_back(point);
+	}
+	Data<RealVector> data = createDataFromRange(points, 7);
+
+	std::stringstream stream;
+	saveBinarySnapshot(data, stream);
+
+	Data<RealVector> loaded;
+	loadBinarySnapshot(loaded, stream);
+
+	//the batch structure is preserved exactly
+	BOOST_REQUIRE_EQUAL(loaded.numberOfBatches(), data.numberOfBatches());
+	for(std::size_t b = 0; b != data.numberOfBatches(); ++b){
+		BOOST_REQUIRE_EQUAL(loaded.batch(b).size1(), data.batch(b).size1());
+		BOOST_CHECK_SMALL(norm_inf(loaded.batch(b) - data.batch(b)), 1.e-15);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( BinarySnapshot_KernelExpansion )
+{
+	std::vector<RealVector> points;
+	for(std::size_t i = 0; i != 10; ++i){
+		RealVector point(2);
+		point(0) = 0.1 * i;
+		point(1) = 1.0 - 0.05 * i;
+		points.push_back(point);
+	}
+	Data<RealVector> basis = createDataFromRange(points, 4);
+	GaussianRbfKernel<> kernel(0.7);
+	KernelExpansion<RealVector> model(&kernel, basis, true, 3);
+	for(std::size_t i = 0; i != 10; ++i)
+		for(std::size_t j = 0; j != 3; ++j)
+			model.alpha(i, j) = 0.01 * i - 0.2 * j;
+	model.offset()(0) = 1.5;
+	model.offset()(1) = -0.25;
+	model.offset()(2) = 0.0;
+
+	std::stringstream stream;
+	saveBinarySnapshot(model, stream);
+
+	//the kernel parameter is part of the snapshot and gets restored
+	GaussianRbfKernel<> loadedKernel(3.0);
+	KernelExpansion<RealVector> loaded(&loadedKernel);
+	loadBinarySnapshot(loaded, stream);
+	BOOST_CHECK_SMALL(loadedKernel.gamma() - 0.7, 1.e-15);
+	BOOST_REQUIRE(loaded.hasOffset());
+	BOOST_CHECK_SMALL(norm_inf(loaded.alpha() - model.alpha()), 1.e-15);
+	BOOST_CHECK_SMALL(norm_inf(loaded.offset() - model.offset()), 1.e-15);
+
+	//both models compute the same function
+	RealMatrix testPoints(5, 2);
+	for(std::size_t i = 0; i != 5; ++i){
+		testPoints(i, 0) = 0.3 * i;
+		testPoints(i, 1) = 1.0 - 0.3 * i;
+	}
+	RealMatrix output;
+	RealMatrix outputLoaded;
+	model.eval(testPoints, output);
+	loaded.eval(testPoints, outputLoaded);
+	BOOST_CHECK_SMALL(norm_inf(output - outputLoaded), 1.e-15);
+}
+
+BOOST_AUTO_TEST_CASE( BinarySnapshot_Errors )
+{
+	LinearModel<> model(5, 3, true);
+
+	//not a snapshot at all
+	std::stringstream garbage("certainly not a binary snapshot of anything");
+	BOOST_CHECK_THROW(loadBinarySnapshot(model, garbage), shark::Exception);
+
+	//a snapshot of a different kind of object
+	std::stringstream stream;
+	saveBinarySnapshot(model, stream);
+	GaussianRbfKernel<> kernel(1.0);
+	KernelExpansion<RealVector> expansion(&kernel);
+	BOOST_CHECK_THROW(loadBinarySnapshot(expansion, stream), shark::Exception);
+
+	//a truncated snapshot
+	std::stringstream stream2;
+	saveBinarySnapshot(model, stream2);
+	std::string contents = stream2.str();
+	std::stringstream truncated(contents.substr(0, contents.size() - 8));
+	BOOST_CHECK_THROW(loadBinarySnapshot(model, truncated), shark::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,72 @@
+#define BOOST_TEST_MODULE Core_HalfPrecision
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Core/HalfPrecision.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <cmath>
+#include <limits>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Core_HalfPrecision)
+
+BOOST_AUTO_TEST_CASE( HalfPrecision_Exact_Values ) {
+	//values with short mantissas are represented exactly
+	double exact[] = {0.0, 1.0, -1.0, 0.5, 2.0, -0.25, 1024.0, 0.125, -6.5};
+	for(std::size_t i = 0; i != sizeof(exact)/sizeof(exact[0]); ++i){
+		HalfFloat h(exact[i]);
+		BOOST_CHECK_EQUAL((float)h, (float)exact[i]);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( HalfPrecision_Rounding_Error ) {
+	//random values in the normalized range must round-trip with
+	//relative error bounded by half a unit in the last place, 2^-11
+	for(std::size_t i = 0; i != 10000; ++i){
+		double value = Rng::uni(-100.0,100.0);
+		HalfFloat h(value);
+		double back = (float)h;
+		BOOST_CHECK_SMALL(std::abs(back - value), std::abs(value) * std::pow(2.0,-11.0) + 1.e-7);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( HalfPrecision_Special_Values ) {
+	//overflow saturates to infinity
+	HalfFloat overflow(1.e30);
+	BOOST_CHECK((boost::math::isinf)((float)overflow));
+	HalfFloat negOverflow(-1.e30);
+	BOOST_CHECK((boost::math::isinf)((float)negOverflow));
+	BOOST_CHECK_LT((float)negOverflow, 0.0f);
+	//NaN stays NaN
+	HalfFloat nan(std::numeric_limits<float>::quiet_NaN());
+	BOOST_CHECK((boost::math::isnan)((float)nan));
+	//tiny values are flushed towards zero without leaving the subnormal range
+	HalfFloat tiny(1.e-10);
+	BOOST_CHECK_SMALL((float)tiny, 1.e-7f);
+	//the largest representable half value survives
+	HalfFloat max(65504.0f);
+	BOOST_CHECK_EQUAL((float)max, 65504.0f);
+}
+
+BOOST_AUTO_TEST_CASE( HalfPrecision_Arithmetic ) {
+	//arithmetic is carried out in float after implicit conversion
+	HalfFloat a(2.0f);
+	HalfFloat b(0.5f);
+	BOOST_CHECK_EQUAL(a + b, 2.5f);
+	BOOST_CHECK_EQUAL(a * b, 1.0f);
+	BOOST_CHECK(a > b);
+	a += 1.5f;
+	BOOST_CHECK_EQUAL((float)a, 3.5f);
+	a *= 2.0f;
+	BOOST_CHECK_EQUAL((float)a, 7.0f);
+	//accumulation in double does not suffer from the 16 bit storage
+	double sum = 0;
+	HalfFloat increment(0.125f);
+	for(std::size_t i = 0; i != 100000; ++i)
+		sum += increment;
+	BOOST_CHECK_CLOSE(sum, 12500.0, 1.e-10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
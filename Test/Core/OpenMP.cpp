@@ -0,0 +1,61 @@
+#define BOOST_TEST_MODULE Core_OpenMP
+#include <shark/Core/OpenMP.h>
+#include <shark/LinAlg/Base.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Core_OpenMP)
+
+BOOST_AUTO_TEST_CASE(OpenMP_DeterministicSum)
+{
+	// the reduction must consume all partials for every size, including sizes
+	// which are not powers of two, and must be bit-identical over repetitions
+	for(std::size_t size = 1; size <= 67; ++size){
+		std::vector<double> values(size);
+		for(std::size_t i = 0; i != size; ++i)
+			values[i] = Rng::gauss();
+
+		std::vector<double> partials = values;
+		double result = deterministicSum(partials);
+
+		double naive = 0.0;
+		for(std::size_t i = 0; i != size; ++i)
+			naive += values[i];
+		BOOST_CHECK_CLOSE(result, naive, 1.e-10);
+
+		std::vector<double> repeated = values;
+		BOOST_CHECK_EQUAL(deterministicSum(repeated), result);
+	}
+
+	// vector valued partials are reduced elementwise
+	std::vector<RealVector> vectorPartials(13, RealVector(3));
+	RealVector naive(3, 0.0);
+	for(std::size_t i = 0; i != vectorPartials.size(); ++i){
+		for(std::size_t j = 0; j != 3; ++j)
+			vectorPartials[i](j) = Rng::gauss();
+		naive += vectorPartials[i];
+	}
+	RealVector result = deterministicSum(vectorPartials);
+	BOOST_CHECK_SMALL(norm_2(result - naive), 1.e-10);
+}
+
+BOOST_AUTO_TEST_CASE(OpenMP_CompensatedSum)
+{
+	// summing many small values onto a large one loses the small contributions
+	// in plain double precision; the compensated sum must recover them
+	std::vector<double> values(1000001, 1.e-16);
+	values[0] = 1.0;
+	double result = compensatedSum(values);
+	BOOST_CHECK_CLOSE(result, 1.0 + 1.e-10, 1.e-10);
+
+	// empty and single element sequences
+	std::vector<double> empty;
+	BOOST_CHECK_EQUAL(compensatedSum(empty), 0.0);
+	std::vector<double> single(1, 42.0);
+	BOOST_CHECK_EQUAL(compensatedSum(single), 42.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,115 @@
+#define BOOST_TEST_MODULE Core_PrefetchingRange
+#include <boost/test/unit_test.hpp>
+
+#include <shark/Core/utility/PrefetchingRange.h>
+#include <shark/Data/Dataset.h>
+
+using namespace shark;
+
+namespace {
+
+//source loading batches on demand, counting how often each one was requested
+struct CountingSource{
+	mutable std::vector<std::size_t> loads;
+	CountingSource(): loads(13, 0){}
+
+	std::size_t numberOfBatches()const{
+		return loads.size();
+	}
+	RealMatrix batch(std::size_t i)const{
+		++loads[i];
+		RealMatrix batch(4, 3);
+		for(std::size_t r = 0; r != batch.size1(); ++r)
+			for(std::size_t c = 0; c != batch.size2(); ++c)
+				batch(r, c) = 100.0 * i + 10.0 * r + c;
+		return batch;
+	}
+};
+
+struct ThrowingSource{
+	std::size_t numberOfBatches()const{
+		return 6;
+	}
+	RealMatrix batch(std::size_t i)const{
+		if(i == 4)
+			throw SHARKEXCEPTION("[ThrowingSource] broken batch");
+		return RealMatrix(2, 2, double(i));
+	}
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE (Core_PrefetchingRange)
+
+BOOST_AUTO_TEST_CASE( Core_PrefetchingRange_Order_And_Values ){
+	CountingSource source;
+	PrefetchingRange<CountingSource> range(source, 3);
+	BOOST_REQUIRE_EQUAL(range.numberOfBatches(), source.numberOfBatches());
+
+	std::size_t visited = 0;
+	for(RealMatrix const& batch: range){
+		BOOST_REQUIRE_EQUAL(batch.size1(), 4u);
+		BOOST_REQUIRE_EQUAL(batch.size2(), 3u);
+		for(std::size_t r = 0; r != batch.size1(); ++r)
+			for(std::size_t c = 0; c != batch.size2(); ++c)
+				BOOST_CHECK_EQUAL(batch(r, c), 100.0 * visited + 10.0 * r + c);
+		++visited;
+	}
+	BOOST_CHECK_EQUAL(visited, source.numberOfBatches());
+	//every batch is loaded exactly once
+	for(std::size_t i = 0; i != source.loads.size(); ++i)
+		BOOST_CHECK_EQUAL(source.loads[i], 1u);
+}
+
+BOOST_AUTO_TEST_CASE( Core_PrefetchingRange_Over_Data ){
+	std::vector<RealVector> points;
+	for(std::size_t i = 0; i != 100; ++i)
+		points.push_back(RealVector(5, double(i)));
+	Data<RealVector> data = createDataFromRange(points, 16);
+
+	PrefetchingRange<Data<RealVector> > range(data, 2);
+	std::size_t element = 0;
+	for(RealMatrix const& batch: range){
+		for(std::size_t i = 0; i != batch.size1(); ++i, ++element)
+			BOOST_CHECK_EQUAL(batch(i, 0), double(element));
+	}
+	BOOST_CHECK_EQUAL(element, points.size());
+}
+
+BOOST_AUTO_TEST_CASE( Core_PrefetchingRange_Abandoned_Traversal ){
+	//destroying the range mid-pass must stop the background thread cleanly
+	CountingSource source;
+	{
+		PrefetchingRange<CountingSource> range(source, 2);
+		PrefetchingRange<CountingSource>::iterator pos = range.begin();
+		++pos;
+	}
+	{
+		//never starting the traversal must work as well
+		PrefetchingRange<CountingSource> range(source, 2);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( Core_PrefetchingRange_Errors ){
+	//exceptions of the loader surface at the consumer, after the
+	//successfully prefetched batches were delivered
+	ThrowingSource source;
+	PrefetchingRange<ThrowingSource> range(source, 2);
+	std::size_t delivered = 0;
+	try{
+		for(RealMatrix const& batch: range){
+			BOOST_CHECK_EQUAL(batch(0, 0), double(delivered));
+			++delivered;
+		}
+		BOOST_ERROR("expected an exception from the loader");
+	}catch(shark::Exception const&){}
+	BOOST_CHECK_EQUAL(delivered, 4u);
+
+	//a second traversal of a single-pass range is an error
+	CountingSource counting;
+	PrefetchingRange<CountingSource> second(counting, 1);
+	second.begin();
+	BOOST_CHECK_THROW(second.begin(), shark::Exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,60 @@
+//enable the instrumentation, which is compiled away by default
+#define SHARK_PROFILE
+
+#define BOOST_TEST_MODULE Core_Profiler
+#include <boost/test/unit_test.hpp>
+
+#include <shark/Core/Profiler.h>
+#include <shark/Core/OpenMP.h>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Core_Profiler)
+
+BOOST_AUTO_TEST_CASE( Profiler_Counters ){
+	Profiler::clear();
+	SHARK_PROFILE_COUNT("test.events");
+	SHARK_PROFILE_COUNT("test.events");
+	SHARK_PROFILE_COUNT_N("test.elements",40);
+	SHARK_PROFILE_COUNT_N("test.elements",2);
+
+	Profiler::Report report = Profiler::report();
+	BOOST_CHECK_EQUAL(report["test.events"].count, 2u);
+	BOOST_CHECK_EQUAL(report["test.elements"].count, 42u);
+
+	Profiler::clear();
+	report = Profiler::report();
+	BOOST_CHECK_EQUAL(report.count("test.events"), 0u);
+}
+
+BOOST_AUTO_TEST_CASE( Profiler_ScopedTimer ){
+	Profiler::clear();
+	for(std::size_t i = 0; i != 10; ++i){
+		SHARK_PROFILE_SCOPE("test.scope");
+	}
+	Profiler::Report report = Profiler::report();
+	BOOST_CHECK_EQUAL(report["test.scope"].count, 10u);
+	BOOST_CHECK_GE(report["test.scope"].seconds, 0.0);
+}
+
+BOOST_AUTO_TEST_CASE( Profiler_PerThreadAggregation ){
+	Profiler::clear();
+	std::size_t iterations = 10000;
+	SHARK_PARALLEL_FOR(int i = 0; i < (int)iterations; ++i){
+		SHARK_PROFILE_COUNT("test.parallel");
+	}
+	//the counts of all threads are merged in the report
+	Profiler::Report report = Profiler::report();
+	BOOST_CHECK_EQUAL(report["test.parallel"].count, iterations);
+}
+
+BOOST_AUTO_TEST_CASE( Profiler_ReportString ){
+	Profiler::clear();
+	SHARK_PROFILE_COUNT("test.formatted");
+	std::string report = Profiler::reportString();
+	BOOST_CHECK(report.find("test.formatted") != std::string::npos);
+	BOOST_CHECK(report.find("count") != std::string::npos);
+	BOOST_CHECK(report.find("seconds") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
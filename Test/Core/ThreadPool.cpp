@@ -0,0 +1,72 @@
+#define BOOST_TEST_MODULE Core_ThreadPool
+#include <boost/test/unit_test.hpp>
+
+#include <shark/Core/ThreadPool.h>
+
+#include <vector>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Core_ThreadPool)
+
+BOOST_AUTO_TEST_CASE( ThreadPool_NumThreads ){
+	BOOST_CHECK_GE(ThreadPool::numThreads(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE( ThreadPool_TaskGroup ){
+	std::size_t tasks = 100;
+	std::vector<int> results(tasks,0);
+	ThreadPool::run([&]{
+		TaskGroup group;
+		for(std::size_t i = 0; i != tasks; ++i){
+			group.spawn([&results,i]{
+				results[i] = int(i)+1;
+			});
+		}
+		group.wait();
+		//after wait all tasks of the group are finished
+		for(std::size_t i = 0; i != tasks; ++i){
+			BOOST_CHECK_EQUAL(results[i], int(i)+1);
+		}
+	});
+}
+
+BOOST_AUTO_TEST_CASE( ThreadPool_ForEach ){
+	std::size_t elements = 10000;
+	std::vector<std::size_t> results(elements,0);
+	ThreadPool::forEach(0,elements,[&](std::size_t i){
+		results[i] = i*i;
+	});
+	for(std::size_t i = 0; i != elements; ++i){
+		BOOST_CHECK_EQUAL(results[i], i*i);
+	}
+	//empty ranges are no-ops
+	ThreadPool::forEach(5,5,[&](std::size_t){
+		BOOST_ERROR("function called on empty range");
+	});
+}
+
+BOOST_AUTO_TEST_CASE( ThreadPool_Nested ){
+	//parallel regions compose: every outer task runs an inner forEach;
+	//this must neither deadlock nor create more threads than the team has
+	std::size_t outer = 8;
+	std::size_t inner = 1000;
+	std::vector<std::vector<std::size_t> > results(outer,std::vector<std::size_t>(inner,0));
+	ThreadPool::run([&]{
+		TaskGroup group;
+		for(std::size_t i = 0; i != outer; ++i){
+			group.spawn([&results,i,inner]{
+				ThreadPool::forEach(0,inner,[&results,i](std::size_t j){
+					results[i][j] = i+j;
+				});
+			});
+		}
+	});
+	for(std::size_t i = 0; i != outer; ++i){
+		for(std::size_t j = 0; j != inner; ++j){
+			BOOST_CHECK_EQUAL(results[i][j], i+j);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,94 @@
+#define BOOST_TEST_MODULE Data_BinaryData
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Data/BinaryData.h>
+
+#include <random>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Data_BinaryData)
+
+BOOST_AUTO_TEST_CASE( Data_BinaryData_Roundtrip ){
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<double> dist(-10.0, 10.0);
+	std::vector<RealVector> points;
+	for(std::size_t i = 0; i != 250; ++i){
+		RealVector point(13);
+		for(std::size_t j = 0; j != point.size(); ++j)
+			point(j) = dist(rng);
+		points.push_back(point);
+	}
+	Data<RealVector> data = createDataFromRange(points, 32);
+	exportBinaryData(data, "./test_output/dataset.sbd");
+
+	//importing must reproduce the values exactly
+	Data<RealVector> loaded;
+	importBinaryData(loaded, "./test_output/dataset.sbd", 50);
+	BOOST_REQUIRE_EQUAL(loaded.numberOfElements(), points.size());
+	BOOST_REQUIRE_EQUAL(dataDimension(loaded), 13u);
+	for(std::size_t i = 0; i != points.size(); ++i){
+		RealVector element = loaded.element(i);
+		BOOST_CHECK_EQUAL(norm_inf(element - points[i]), 0.0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( Data_BinaryData_Mapped_View ){
+	std::vector<RealVector> points;
+	for(std::size_t i = 0; i != 100; ++i){
+		RealVector point(5);
+		for(std::size_t j = 0; j != point.size(); ++j)
+			point(j) = 10.0 * i + j;
+		points.push_back(point);
+	}
+	Data<RealVector> data = createDataFromRange(points, 16);
+	exportBinaryData(data, "./test_output/dataset_view.sbd");
+
+	//the mapped view must expose the stored batches without copying
+	MappedBinaryData<double> view("./test_output/dataset_view.sbd", 16);
+	BOOST_REQUIRE_EQUAL(view.numberOfElements(), 100u);
+	BOOST_REQUIRE_EQUAL(view.dimension(), 5u);
+	std::size_t element = 0;
+	for(std::size_t b = 0; b != view.numberOfBatches(); ++b){
+		MappedBinaryData<double>::const_batch_reference batch = view.batch(b);
+		BOOST_REQUIRE_EQUAL(batch.size2(), 5u);
+		for(std::size_t i = 0; i != batch.size1(); ++i, ++element){
+			for(std::size_t j = 0; j != 5; ++j){
+				BOOST_CHECK_EQUAL(batch(i,j), points[element](j));
+			}
+		}
+	}
+	BOOST_CHECK_EQUAL(element, 100u);
+
+	//the views are full matrix expressions
+	RealVector weights(5, 1.0);
+	RealVector products = prod(view.batch(0), weights);
+	BOOST_CHECK_CLOSE(products(1), 10.0 + 11 + 12 + 13 + 14, 1.e-12);
+}
+
+BOOST_AUTO_TEST_CASE( Data_BinaryData_Errors ){
+	//a file holding floats must not open as a double dataset
+	Data<FloatVector> data(1);
+	data.batch(0).resize(2, 3);
+	data.batch(0).clear();
+	exportBinaryData(data, "./test_output/dataset_float.sbd");
+	BOOST_CHECK_THROW(MappedBinaryData<double> view("./test_output/dataset_float.sbd"), shark::Exception);
+
+	//files not in the format are rejected by the magic number
+	{
+		std::ofstream out("./test_output/not_a_dataset.sbd");
+		out << "0,1,2\n3,4,5\n";
+	}
+	Data<RealVector> loaded;
+	BOOST_CHECK_THROW(importBinaryData(loaded, "./test_output/not_a_dataset.sbd"), shark::Exception);
+
+	//empty datasets roundtrip to empty datasets
+	Data<RealVector> empty;
+	exportBinaryData(empty, "./test_output/dataset_empty.sbd");
+	importBinaryData(loaded, "./test_output/dataset_empty.sbd");
+	BOOST_CHECK_EQUAL(loaded.numberOfElements(), 0u);
+	BOOST_CHECK_EQUAL(loaded.numberOfBatches(), 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
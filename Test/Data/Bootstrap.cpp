@@ -70,4 +70,35 @@ BOOST_AUTO_TEST_CASE( Bootstrap_UnlabeledData ){
 		BOOST_CHECK_CLOSE(weightSums[i],1.0,5);
 	}
 }
+
+BOOST_AUTO_TEST_CASE( Bootstrap_CompactWeights ){
+	//create a toy dataset
+	std::vector<unsigned int> inputs;
+	std::vector<unsigned int> labels;
+
+	for(unsigned int i=0;i != 20;++i){
+		inputs.push_back(i);
+		labels.push_back(20+i);
+	}
+	LabeledData<unsigned int, unsigned int> set=createLabeledDataFromRange(inputs,labels,8);
+
+	for(std::size_t iteration = 0; iteration != 100; ++iteration){
+		WeightedLabeledData<unsigned int,unsigned int> bootstrapSet = bootstrap(set);
+		WeightedLabeledData<unsigned int,unsigned int> compacted = compactWeights(bootstrapSet, 8);
+
+		//the compacted set holds exactly the elements with nonzero weight, in order
+		std::size_t pos = 0;
+		for(std::size_t i = 0; i != 20; ++i){
+			double weight = bootstrapSet.element(i).weight;
+			if(weight == 0.0) continue;
+			BOOST_REQUIRE_LT(pos, compacted.numberOfElements());
+			BOOST_CHECK_EQUAL(compacted.element(pos).data.input, set.element(i).input);
+			BOOST_CHECK_EQUAL(compacted.element(pos).data.label, set.element(i).label);
+			BOOST_CHECK_EQUAL(compacted.element(pos).weight, weight);
+			++pos;
+		}
+		BOOST_CHECK_EQUAL(pos, compacted.numberOfElements());
+		BOOST_CHECK_CLOSE(sumOfWeights(compacted), sumOfWeights(bootstrapSet), 1.e-10);
+	}
+}
 BOOST_AUTO_TEST_SUITE_END()
@@ -173,4 +173,180 @@ BOOST_AUTO_TEST_CASE( CVDatasetTools_CreateSameSizeBalancedUnsigned )
 
 
 }
+BOOST_AUTO_TEST_CASE( CVDatasetTools_CreateViewIndexed ){
+	//same setup as CVDatasetTools_CreateIndexed, but the dataset must stay untouched
+	std::vector<double> inputs;
+	std::vector<double> labels;
+	std::vector<size_t> indizes;
+	std::vector<double> testInputPartitions[numPartitions];
+	for(size_t i=0;i!=20;++i){
+		inputs.push_back(double(i) );
+		labels.push_back(20.0+i);
+		indizes.push_back(i%numPartitions);
+		for(size_t j=0;j!=numPartitions;++j){
+			if(j!=i%numPartitions){
+				testInputPartitions[j].push_back(double(i));
+			}
+		}
+	}
+	LabeledData<double,double> set=createLabeledDataFromRange(inputs,labels,8);
+	CVViewFolds<LabeledData<double,double> > folds = createCVViewIndexed(set, numPartitions, indizes);
+
+	BOOST_REQUIRE_EQUAL(folds.size(), numPartitions);
+	//the folds are views into the unchanged dataset
+	for(size_t i=0;i!=20;++i){
+		BOOST_CHECK_EQUAL(set.element(i).input, double(i));
+		BOOST_CHECK_EQUAL(set.element(i).label, 20.0+i);
+	}
+	for(size_t i=0;i!=numPartitions;++i){
+		DataView<LabeledData<double,double> const> training = folds.training(i);
+		DataView<LabeledData<double,double> const> validation = folds.validation(i);
+		BOOST_REQUIRE_EQUAL(training.size(), testInputPartitions[i].size());
+		BOOST_REQUIRE_EQUAL(validation.size(), 20 - testInputPartitions[i].size());
+		for(size_t j=0;j!=training.size();++j){
+			BOOST_CHECK_EQUAL(training[j].input, testInputPartitions[i][j]);
+			BOOST_CHECK_EQUAL(training[j].label, 20.0+testInputPartitions[i][j]);
+		}
+		//validation fold i holds exactly the elements assigned to partition i
+		for(size_t j=0;j!=validation.size();++j){
+			BOOST_CHECK_EQUAL(std::size_t(validation[j].input)%numPartitions, i);
+		}
+		//folds can be gathered into a dataset on demand
+		LabeledData<double,double> materialized = toDataset(training);
+		BOOST_CHECK_EQUAL(materialized.numberOfElements(), training.size());
+	}
+}
+
+BOOST_AUTO_TEST_CASE( CVDatasetTools_CreateViewSameSizeBalanced )
+{
+	const size_t numExamples=102;
+
+	//two thirds class 1, one third class 0
+	std::vector<RealVector> inputs(numExamples,RealVector(1));
+	std::vector<unsigned int> labels(numExamples);
+	for(size_t i=0;i!=numExamples;++i){
+		inputs[i](0) = double(i);
+		labels[i] = (i%3 == 0)? 0: 1;
+	}
+	LabeledData<RealVector,unsigned int> set = createLabeledDataFromRange(inputs,labels,8);
+	LabeledData<RealVector,unsigned int> const backup = set;
+
+	CVViewFolds<LabeledData<RealVector,unsigned int> > folds = createCVViewSameSizeBalanced(set,numPartitions);
+	BOOST_REQUIRE_EQUAL(folds.size(), numPartitions);
+
+	//the dataset is left in its original order
+	for(size_t i=0;i!=numExamples;++i){
+		BOOST_CHECK_EQUAL(set.element(i).input(0), backup.element(i).input(0));
+		BOOST_CHECK_EQUAL(set.element(i).label, backup.element(i).label);
+	}
+
+	//the validation folds are of nearly equal size and class proportion
+	//and together cover every element exactly once
+	std::vector<double> validationInputs;
+	for(size_t i=0;i!=numPartitions;++i){
+		DataView<LabeledData<RealVector,unsigned int> const> validation = folds.validation(i);
+		BOOST_CHECK(validation.size() >= numExamples/numPartitions);
+		BOOST_CHECK(validation.size() <= numExamples/numPartitions + 1);
+		size_t zeros = 0;
+		for(size_t j=0;j!=validation.size();++j){
+			validationInputs.push_back(validation[j].input(0));
+			if(validation[j].label == 0) ++zeros;
+		}
+		BOOST_CHECK(zeros >= 34/numPartitions);
+		BOOST_CHECK(zeros <= 34/numPartitions + 1);
+		BOOST_CHECK_EQUAL(folds.training(i).size(), numExamples - validation.size());
+	}
+	std::sort(validationInputs.begin(),validationInputs.end());
+	for(size_t i=0;i!=numExamples;++i){
+		BOOST_CHECK_EQUAL(validationInputs[i],double(i));
+	}
+}
+
+BOOST_AUTO_TEST_CASE( CVDatasetTools_CreateViewSameSizeBalancedIndexed )
+{
+	const size_t numExamples=102;
+
+	//two thirds class 1, one third class 0
+	std::vector<RealVector> inputs(numExamples,RealVector(1));
+	std::vector<unsigned int> labels(numExamples);
+	for(size_t i=0;i!=numExamples;++i){
+		inputs[i](0) = double(i);
+		labels[i] = (i%3 == 0)? 0: 1;
+	}
+	LabeledData<RealVector,unsigned int> set = createLabeledDataFromRange(inputs,labels,8);
+	repartitionByClass(set);
+	ClassBatchIndex<RealVector> index(set);
+
+	CVViewFolds<LabeledData<RealVector,unsigned int> > folds = createCVViewSameSizeBalanced(index,numPartitions);
+	BOOST_REQUIRE_EQUAL(folds.size(), numPartitions);
+
+	//the validation folds are of nearly equal size and class proportion
+	//and together cover every element exactly once
+	std::vector<double> validationInputs;
+	for(size_t i=0;i!=numPartitions;++i){
+		DataView<LabeledData<RealVector,unsigned int> const> validation = folds.validation(i);
+		BOOST_CHECK(validation.size() >= numExamples/numPartitions);
+		BOOST_CHECK(validation.size() <= numExamples/numPartitions + 1);
+		size_t zeros = 0;
+		for(size_t j=0;j!=validation.size();++j){
+			validationInputs.push_back(validation[j].input(0));
+			if(validation[j].label == 0) ++zeros;
+		}
+		BOOST_CHECK(zeros >= 34/numPartitions);
+		BOOST_CHECK(zeros <= 34/numPartitions + 1);
+		BOOST_CHECK_EQUAL(folds.training(i).size(), numExamples - validation.size());
+	}
+	std::sort(validationInputs.begin(),validationInputs.end());
+	for(size_t i=0;i!=numExamples;++i){
+		BOOST_CHECK_EQUAL(validationInputs[i],double(i));
+	}
+}
+
+BOOST_AUTO_TEST_CASE( CVDatasetTools_SplitViewStratified )
+{
+	const size_t numExamples=100;
+
+	//one quarter class 0, three quarters class 1
+	std::vector<RealVector> inputs(numExamples,RealVector(1));
+	std::vector<unsigned int> labels(numExamples);
+	for(size_t i=0;i!=numExamples;++i){
+		inputs[i](0) = double(i);
+		labels[i] = (i%4 == 0)? 0: 1;
+	}
+	LabeledData<RealVector,unsigned int> set = createLabeledDataFromRange(inputs,labels,8);
+	LabeledData<RealVector,unsigned int> const backup = set;
+
+	typedef DataView<LabeledData<RealVector,unsigned int> const> View;
+	std::pair<View,View> split = splitViewStratified(set, 0.2);
+	View training = split.first;
+	View validation = split.second;
+
+	//the dataset is left in its original order
+	for(size_t i=0;i!=numExamples;++i){
+		BOOST_CHECK_EQUAL(set.element(i).input(0), backup.element(i).input(0));
+		BOOST_CHECK_EQUAL(set.element(i).label, backup.element(i).label);
+	}
+
+	//both parts preserve the class proportions and cover the set exactly once
+	BOOST_REQUIRE_EQUAL(training.size(), 80u);
+	BOOST_REQUIRE_EQUAL(validation.size(), 20u);
+	size_t trainingZeros = 0;
+	size_t validationZeros = 0;
+	std::vector<double> covered;
+	for(size_t i=0;i!=training.size();++i){
+		if(training[i].label == 0) ++trainingZeros;
+		covered.push_back(training[i].input(0));
+	}
+	for(size_t i=0;i!=validation.size();++i){
+		if(validation[i].label == 0) ++validationZeros;
+		covered.push_back(validation[i].input(0));
+	}
+	BOOST_CHECK_EQUAL(trainingZeros, 20u);
+	BOOST_CHECK_EQUAL(validationZeros, 5u);
+	std::sort(covered.begin(),covered.end());
+	for(size_t i=0;i!=numExamples;++i){
+		BOOST_CHECK_EQUAL(covered[i],double(i));
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
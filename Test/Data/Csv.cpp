@@ -3,6 +3,7 @@
 #include <boost/test/floating_point_comparison.hpp>
 
 #include <shark/Data/Csv.h>
+#include <shark/Models/Normalizer.h>
 #include <shark/LinAlg/Base.h>
 
 #include <boost/math/special_functions/fpclassify.hpp>
@@ -223,6 +224,65 @@ BOOST_AUTO_TEST_CASE( Data_Csv_Data_Import)
 	}
 }
 
+BOOST_AUTO_TEST_CASE( Data_Csv_File_Import)
+{
+	//import through the parallel file reader must give the same result as
+	//parsing the string; the test data contains lone-\r line endings which
+	//additionally exercises the fallback to the general grammar
+	{
+		std::ofstream out("./test_output/fast_import.csv");
+		out << test_separator;
+	}
+	Data<RealVector> test;
+	importCSV(test, "./test_output/fast_import.csv", ',','#',3);
+	BOOST_CHECK_EQUAL(test.numberOfElements(), 16u);
+	BOOST_CHECK_EQUAL(test.numberOfBatches(), 6);
+	checkDataEquality(test_values,test);
+
+	//clean numeric file taking the fast path, with title lines to skip
+	{
+		std::ofstream out("./test_output/fast_import_clean.csv");
+		out << "column1,column2\n0.5,-2e2\n?,3.25\n";
+	}
+	Data<RealVector> clean;
+	importCSV(clean, "./test_output/fast_import_clean.csv", ',','#', Data<RealVector>::DefaultBatchSize, 1);
+	BOOST_REQUIRE_EQUAL(clean.numberOfElements(), 2u);
+	BOOST_CHECK_EQUAL(clean.element(0)(0), 0.5);
+	BOOST_CHECK_EQUAL(clean.element(0)(1), -200.0);
+	BOOST_CHECK(boost::math::isnan(clean.element(1)(0)));
+	BOOST_CHECK_EQUAL(clean.element(1)(1), 3.25);
+}
+
+BOOST_AUTO_TEST_CASE( Data_Csv_File_Import_Preprocessed)
+{
+	//importing with a preprocessing model must give the same result as
+	//importing and transforming afterwards
+	{
+		std::ofstream out("./test_output/fast_import_preprocessed.csv");
+		for(std::size_t i = 0; i != 10; ++i)
+			out << 0.5*i << ',' << 3.25-i << '\n';
+	}
+	Data<RealVector> plain;
+	importCSV(plain, "./test_output/fast_import_preprocessed.csv", ',','#',3);
+
+	Normalizer<RealVector> normalizer;
+	RealVector diagonal(2);
+	diagonal(0) = 0.5;
+	diagonal(1) = -2.0;
+	RealVector offset(2);
+	offset(0) = 1.0;
+	offset(1) = 0.25;
+	normalizer.setStructure(diagonal,offset);
+
+	Data<RealVector> preprocessed;
+	importCSV(preprocessed, "./test_output/fast_import_preprocessed.csv", normalizer, ',','#',3);
+	BOOST_REQUIRE_EQUAL(preprocessed.numberOfElements(), plain.numberOfElements());
+	BOOST_CHECK_EQUAL(preprocessed.numberOfBatches(), plain.numberOfBatches());
+	for(std::size_t i = 0; i != plain.numberOfElements(); ++i){
+		BOOST_CHECK_SMALL(norm_inf(preprocessed.element(i) - normalizer(plain.element(i))),1.e-12);
+	}
+}
+
 BOOST_AUTO_TEST_CASE( Data_Csv_Data_Import_Single_Integer)
 {
 	Data<unsigned int> test;
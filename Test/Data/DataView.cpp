@@ -88,6 +88,32 @@ BOOST_AUTO_TEST_CASE( DataView_Data_Test )
 	}
 }
 
+BOOST_AUTO_TEST_CASE( DataView_Shuffle_Test )
+{
+	std::vector<int> inputs;
+	for (int i=0;i!=50;++i) {
+		inputs.push_back(i);
+	}
+	Data<int> set = createDataFromRange(inputs,7);
+	DataView<Data<int> > view(set);
+
+	//shuffling the view only permutes its index table,
+	//the dataset stays in its original order
+	view.shuffle();
+	for(std::size_t i = 0; i != 50;++i){
+		BOOST_CHECK_EQUAL(set.element(i),int(i));
+	}
+	std::vector<int> seen;
+	for(std::size_t i = 0; i != 50;++i){
+		seen.push_back(view[i]);
+		BOOST_CHECK_EQUAL(std::size_t(view[i]),view.index(i));
+	}
+	std::sort(seen.begin(),seen.end());
+	for(std::size_t i = 0; i != 50;++i){
+		BOOST_CHECK_EQUAL(seen[i],int(i));
+	}
+}
+
 //Same again, just throwing in some consts...
 BOOST_AUTO_TEST_CASE( DataView_Data_Const_Test )
 {
@@ -351,4 +377,43 @@ BOOST_AUTO_TEST_CASE( DataView_Dataset_Const_Test )
 		BOOST_CHECK_EQUAL(copy2.batch(i).size(),2u);
 	}
 }
+
+BOOST_AUTO_TEST_CASE( DataView_GatherBatch_Test )
+{
+	//define initial dataset
+	std::vector<RealVector> inputs;
+	for (int i=0;i!=100;++i) {
+		RealVector v(3);
+		v(0) = i; v(1) = 100+i; v(2) = 200+i;
+		inputs.push_back(v);
+	}
+	std::vector<unsigned int> labels;
+	for (unsigned int i=0;i!=100;++i) {
+		labels.push_back(300+i);
+	}
+	LabeledData<RealVector,unsigned int> set = createLabeledDataFromRange(inputs,labels,10);
+	DataView<LabeledData<RealVector,unsigned int> > view(set);
+
+	//indices crossing batches in scrambled order, with repetitions
+	std::size_t indexArray[] = {73, 5, 5, 42, 99, 0, 17, 68, 23, 23, 91, 3};
+	std::vector<std::size_t> indices(indexArray, indexArray + 12);
+
+	//the gathered batch holds the elements in the requested order
+	typedef DataView<LabeledData<RealVector,unsigned int> >::batch_type batch_type;
+	batch_type gathered = gatherBatch(view,indices);
+	BOOST_REQUIRE_EQUAL(boost::size(gathered),12u);
+	for(std::size_t i = 0; i != 12; ++i){
+		BOOST_CHECK_EQUAL(get(gathered,i).label, 300+indices[i]);
+		for(std::size_t j = 0; j != 3; ++j){
+			BOOST_CHECK_EQUAL(get(gathered,i).input(j), 100*j+indices[i]);
+		}
+	}
+
+	//subBatch uses the same gather and must agree
+	batch_type sub = subBatch(view,indices);
+	BOOST_REQUIRE_EQUAL(boost::size(sub),12u);
+	for(std::size_t i = 0; i != 12; ++i){
+		BOOST_CHECK_EQUAL(get(sub,i).label, get(gathered,i).label);
+	}
+}
 BOOST_AUTO_TEST_SUITE_END()
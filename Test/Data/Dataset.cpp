@@ -226,6 +226,66 @@ BOOST_AUTO_TEST_CASE( Set_Merge_Test )
 	}
 }
 
+BOOST_AUTO_TEST_CASE( Set_PermuteInPlace_Test )
+{
+	//reversing 23 elements in batches of 7 must neither change the
+	//batch structure nor lose an element
+	std::vector<int> inputs;
+	for (int i=0;i!=23;++i) {
+		inputs.push_back(i);
+	}
+	Data<int> set = createDataFromRange(inputs,7);
+	std::vector<std::size_t> permutation(23);
+	for(std::size_t i = 0; i != 23; ++i)
+		permutation[i] = 22 - i;
+	permuteElementsInPlace(set,permutation);
+
+	BOOST_REQUIRE_EQUAL(set.numberOfBatches(),4);
+	BOOST_REQUIRE_EQUAL(set.numberOfElements(),23);
+	BOOST_CHECK_EQUAL(set.batch(0).size(),6);
+	BOOST_CHECK_EQUAL(set.batch(3).size(),5);
+	for(std::size_t i = 0; i != 23;++i){
+		BOOST_CHECK_EQUAL(set.element(i),int(22 - i));
+	}
+
+	//vector valued data: rows are swapped inside the batch matrices
+	std::vector<RealVector> points(10,RealVector(3));
+	std::vector<unsigned int> labels(10);
+	for(std::size_t i = 0; i != 10; ++i){
+		for(std::size_t j = 0; j != 3; ++j)
+			points[i](j) = 10.0*i+j;
+		labels[i] = (unsigned int)i;
+	}
+	LabeledData<RealVector,unsigned int> labeledSet = createLabeledDataFromRange(points,labels,4);
+	std::vector<std::size_t> rotation(10);
+	for(std::size_t i = 0; i != 10; ++i)
+		rotation[i] = (i+3)%10;//element i moves to position i+3
+	permuteElementsInPlace(labeledSet,rotation);
+
+	for(std::size_t i = 0; i != 10;++i){
+		unsigned int original = labeledSet.element(i).label;
+		BOOST_CHECK_EQUAL(rotation[original],i);
+		for(std::size_t j = 0; j != 3; ++j)
+			BOOST_CHECK_EQUAL(labeledSet.element(i).input(j), 10.0*original+j);
+	}
+
+	//shuffle keeps the batch structure and the set of elements
+	labeledSet.shuffle();
+	BOOST_REQUIRE_EQUAL(labeledSet.numberOfElements(),10);
+	BOOST_CHECK_EQUAL(labeledSet.inputs().batch(0).size1(),4);
+	std::vector<unsigned int> shuffledLabels;
+	for(std::size_t i = 0; i != 10;++i){
+		unsigned int label = labeledSet.element(i).label;
+		shuffledLabels.push_back(label);
+		for(std::size_t j = 0; j != 3; ++j)
+			BOOST_CHECK_EQUAL(labeledSet.element(i).input(j), 10.0*label+j);
+	}
+	std::sort(shuffledLabels.begin(),shuffledLabels.end());
+	for(std::size_t i = 0; i != 10;++i){
+		BOOST_CHECK_EQUAL(shuffledLabels[i],(unsigned int)i);
+	}
+}
+
 BOOST_AUTO_TEST_CASE( Data_ColumnAccess )
 {
 	std::vector<RealVector> inputs;
@@ -416,8 +476,59 @@ BOOST_AUTO_TEST_CASE( BinarySubproblem_Test )
 			BOOST_CHECK_EQUAL(classes[1], sizes[cj]);
 		}
 	}
-	
-	
+
+
+}
+
+BOOST_AUTO_TEST_CASE( ClassBatchIndex_Test )
+{
+	unsigned int labels[] ={0,0,1,1,1,2,2,3,4,4,4};
+	unsigned int sizes[] ={21,39,31,17,57};
+	LabeledData<UIntVector,unsigned int> data(11);
+	for(std::size_t i = 0; i != 11; ++i){
+		data.batch(i).input.resize(i+10,1);
+		data.batch(i).label.resize(i+10);
+		for(std::size_t j = 0; j != i+10; ++j){
+			data.batch(i).input(j,0) = (unsigned int)j;
+			data.batch(i).label(j) = labels[i];
+		}
+	}
+
+	//the index is built once over the class-pure batches
+	ClassBatchIndex<UIntVector> index(data);
+	BOOST_REQUIRE_EQUAL(index.numberOfClasses(),5);
+	for(unsigned int c = 0; c != 5; ++c){
+		BOOST_CHECK_EQUAL(index.classSize(c), sizes[c]);
+		//every indexed batch holds the right class
+		for(std::size_t b: index.batchesOfClass(c)){
+			BOOST_CHECK_EQUAL(labels[b], c);
+		}
+	}
+
+	//class subsets share the batches of the dataset
+	for(unsigned int c = 0; c != 5; ++c){
+		LabeledData<UIntVector,unsigned int> subset = index.classSubset(c);
+		BOOST_CHECK_EQUAL(subset.numberOfElements(), sizes[c]);
+		BOOST_CHECK_EQUAL(subset.numberOfBatches(), index.batchesOfClass(c).size());
+	}
+
+	//binary subproblems agree with the scanning version
+	for(unsigned int ci = 0; ci != 5; ++ci){
+		for(unsigned int cj = 0; cj != 5; ++cj){
+			if(ci == cj) continue;
+			LabeledData<UIntVector,unsigned int> testset = index.binarySubProblem(ci,cj);
+			LabeledData<UIntVector,unsigned int> expected = binarySubProblem(data,ci,cj);
+			BOOST_REQUIRE_EQUAL(numberOfClasses(testset),2);
+			std::vector<std::size_t> classes = classSizes(testset);
+			BOOST_CHECK_EQUAL(classes[0], sizes[ci]);
+			BOOST_CHECK_EQUAL(classes[1], sizes[cj]);
+			BOOST_REQUIRE_EQUAL(testset.numberOfElements(), expected.numberOfElements());
+			for(std::size_t i = 0; i != testset.numberOfElements(); ++i){
+				BOOST_CHECK_EQUAL(testset.element(i).label, expected.element(i).label);
+				BOOST_CHECK_EQUAL(testset.element(i).input(0), expected.element(i).input(0));
+			}
+		}
+	}
 }
 
 
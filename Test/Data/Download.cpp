@@ -32,6 +32,22 @@ BOOST_AUTO_TEST_CASE(Data_Download_URL)
 	BOOST_CHECK_EQUAL(numberOfClasses(dataset), 3);
 }
 
+BOOST_AUTO_TEST_CASE(Data_Download_Ranged)
+{
+	if (! verifyConnection())
+	{
+		std::cout << "cannot reach mldata.org server; skipping data download test" << std::endl;
+		return;
+	}
+
+	// the parallel ranged download must deliver the same document as the
+	// single connection download, with or without range support on the server
+	std::string url = "http://mldata.org/repository/data/download/libsvm/iris/";
+	std::string single = download(url);
+	std::string ranged = downloadRanged(url, 80, 4);
+	BOOST_CHECK(single == ranged);
+}
+
 BOOST_AUTO_TEST_CASE(Data_Download_MLData)
 {
 	if (! verifyConnection())
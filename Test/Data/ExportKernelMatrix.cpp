@@ -5,6 +5,7 @@
 #include <shark/Data/ExportKernelMatrix.h>
 #include <shark/Data/Libsvm.h>
 #include <shark/Models/Kernels/AbstractKernelFunction.h>
+#include <shark/Models/Kernels/KernelHelpers.h>
 #include <shark/Models/Kernels/LinearKernel.h>
 
 #include <iostream>
@@ -77,7 +78,48 @@ BOOST_AUTO_TEST_CASE( Set_ExportKernelMatrix )
 	exportKernelMatrix( test_ds_sc, skernel, "test_output/check_kernelmatrix_sparse_c_none.libsvm", NONE, false, 15 );
 	
 	// mt: todo: add tests here once read-in is supported
-	
+
+}
+
+BOOST_AUTO_TEST_CASE( Set_ExportKernelMatrixBinary )
+{
+	// load data and set up vars
+	std::stringstream ssc(test_classification);
+	LabeledData<RealVector, unsigned int> test_ds_c;
+	importSparseData(test_ds_c, ssc);
+	DenseLinearKernel kernel;
+	std::size_t size = test_ds_c.numberOfElements();
+
+	// reference matrix
+	RealMatrix K = calculateRegularizedKernelMatrix(kernel, test_ds_c.inputs());
+
+	// double precision export
+	std::ostringstream oss(std::ios::binary);
+	exportKernelMatrixBinary(test_ds_c.inputs(), kernel, oss, NONE, false);
+	std::string buf = oss.str();
+	BOOST_REQUIRE_EQUAL(buf.size(), size * size * sizeof(double));
+	double const* values = reinterpret_cast<double const*>(buf.data());
+	for(std::size_t i = 0; i != size; i++)
+	{
+		for(std::size_t j = 0; j != size; j++)
+		{
+			BOOST_CHECK_SMALL(values[i * size + j] - K(i, j), 1e-12);
+		}
+	}
+
+	// single precision export
+	std::ostringstream ossf(std::ios::binary);
+	exportKernelMatrixBinary(test_ds_c.inputs(), kernel, ossf, NONE, true);
+	std::string buff = ossf.str();
+	BOOST_REQUIRE_EQUAL(buff.size(), size * size * sizeof(float));
+	float const* fvalues = reinterpret_cast<float const*>(buff.data());
+	for(std::size_t i = 0; i != size; i++)
+	{
+		for(std::size_t j = 0; j != size; j++)
+		{
+			BOOST_CHECK_SMALL(fvalues[i * size + j] - (float)K(i, j), 1e-5f);
+		}
+	}
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -293,6 +293,90 @@ BOOST_AUTO_TEST_CASE(NegativeTests)
 	}
 }
 
+BOOST_AUTO_TEST_CASE(ChunkedProjectionTests)
+{
+	// Write a chunked and compressed feature matrix plus a label vector,
+	// then stream it back with column projection.
+	const std::string fileName = "./test_output/import_chunked.h5";
+	const hsize_t rows = 103;
+	const hsize_t cols = 20;
+	{
+		hid_t file = H5Fcreate(fileName.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+		BOOST_REQUIRE(file >= 0);
+
+		hsize_t dims[2] = {rows, cols};
+		hid_t space = H5Screate_simple(2, dims, NULL);
+		hid_t props = H5Pcreate(H5P_DATASET_CREATE);
+		hsize_t chunk[2] = {16, cols};
+		H5Pset_chunk(props, 2, chunk);
+		H5Pset_deflate(props, 6);
+		hid_t dataSet = H5Dcreate2(file, "features", H5T_NATIVE_DOUBLE, space, H5P_DEFAULT, props, H5P_DEFAULT);
+		std::vector<double> values(rows * cols);
+		for (hsize_t r = 0; r != rows; ++r)
+			for (hsize_t c = 0; c != cols; ++c)
+				values[r * cols + c] = 100.0 * r + c;
+		H5Dwrite(dataSet, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT, &values[0]);
+		H5Dclose(dataSet);
+		H5Pclose(props);
+		H5Sclose(space);
+
+		hsize_t labelDims[1] = {rows};
+		hid_t labelSpace = H5Screate_simple(1, labelDims, NULL);
+		hid_t labelSet = H5Dcreate2(file, "labels", H5T_NATIVE_INT, labelSpace, H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+		std::vector<boost::int32_t> labels(rows);
+		for (hsize_t r = 0; r != rows; ++r)
+			labels[r] = boost::int32_t(r % 7);
+		H5Dwrite(labelSet, H5T_NATIVE_INT, H5S_ALL, H5S_ALL, H5P_DEFAULT, &labels[0]);
+		H5Dclose(labelSet);
+		H5Sclose(labelSpace);
+		H5Fclose(file);
+	}
+
+	// projection with unordered and repeated columns keeps the requested order
+	{
+		std::vector<std::size_t> columns = {17, 3, 3, 5};
+		Data<RealVector> data;
+		importHDF5Chunked(data, fileName, "features", columns, 10);
+		BOOST_REQUIRE_EQUAL(data.numberOfElements(), rows);
+		for (std::size_t i = 0; i != rows; ++i) {
+			BOOST_REQUIRE_EQUAL(data.element(i).size(), columns.size());
+			for (std::size_t j = 0; j != columns.size(); ++j)
+				BOOST_CHECK_EQUAL(data.element(i)(j), 100.0 * i + columns[j]);
+		}
+		for (std::size_t b = 0; b != data.numberOfBatches(); ++b)
+			BOOST_CHECK_LE(boost::size(data.batch(b)), 10u);
+	}
+
+	// an empty projection list keeps all columns
+	{
+		Data<RealVector> data;
+		importHDF5Chunked(data, fileName, "features", std::vector<std::size_t>());
+		BOOST_REQUIRE_EQUAL(data.numberOfElements(), rows);
+		BOOST_REQUIRE_EQUAL(dataDimension(data), cols);
+		BOOST_CHECK_EQUAL(data.element(42)(13), 4213.0);
+	}
+
+	// labeled import pairs the streamed inputs with the label vector
+	{
+		std::vector<std::size_t> columns = {0, 19};
+		LabeledData<RealVector, boost::int32_t> data;
+		importHDF5Chunked(data, fileName, "features", "labels", columns, 25);
+		BOOST_REQUIRE_EQUAL(data.numberOfElements(), rows);
+		for (std::size_t i = 0; i != rows; ++i) {
+			BOOST_CHECK_EQUAL(data.labels().element(i), boost::int32_t(i % 7));
+			BOOST_CHECK_EQUAL(data.inputs().element(i)(1), 100.0 * i + 19);
+		}
+	}
+
+	// a column beyond the width of the dataset is rejected
+	{
+		Data<RealVector> data;
+		BOOST_CHECK_THROW(
+			importHDF5Chunked(data, fileName, "features", std::vector<std::size_t>(1, cols)),
+			shark::Exception);
+	}
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace shark
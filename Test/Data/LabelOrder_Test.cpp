@@ -106,4 +106,71 @@ BOOST_AUTO_TEST_CASE(LabelOrder_General)
 
 
 
+BOOST_AUTO_TEST_CASE(LabelOrder_Mapping)
+{
+	// create a dataset with distorted labels as in the general test
+	size_t datasetSize = 64;
+	Chessboard problem(2, 0);
+	LabeledData<RealVector, unsigned int> dataset = problem.generateDataset(datasetSize);
+	for(std::size_t i = 0; i < dataset.numberOfElements(); ++i)
+		dataset.labels().element(i) = (unsigned int)(2 * (dataset.numberOfElements() - 1) - 2 * i);
+
+	// the reference is the in-place rewrite, on its own copy of the batches
+	LabeledData<RealVector, unsigned int> reference = dataset;
+	reference.makeIndependent();
+	LabelOrder referenceOrder;
+	referenceOrder.normalizeLabels(reference);
+
+	// building the ordering must not change the dataset
+	LabelOrder labelOrder;
+	labelOrder.buildLabelOrder(dataset);
+	for(std::size_t i = 0; i < dataset.numberOfElements(); ++i)
+		BOOST_REQUIRE_EQUAL(dataset.labels().element(i), (unsigned int)(2 * (dataset.numberOfElements() - 1) - 2 * i));
+
+	// both orderings agree
+	std::vector<unsigned int> internalOrder, referenceInternalOrder;
+	labelOrder.getLabelOrder(internalOrder);
+	referenceOrder.getLabelOrder(referenceInternalOrder);
+	BOOST_REQUIRE_EQUAL(internalOrder.size(), referenceInternalOrder.size());
+	for(std::size_t i = 0; i < internalOrder.size(); ++i)
+		BOOST_REQUIRE_EQUAL(internalOrder[i], referenceInternalOrder[i]);
+
+	// the materialized dataset matches the rewrite and shares the inputs
+	LabelOrder fusedOrder;
+	LabeledData<RealVector, unsigned int> normalized = fusedOrder.normalizedLabels(dataset);
+	for(std::size_t i = 0; i < dataset.numberOfElements(); ++i)
+	{
+		BOOST_REQUIRE_EQUAL(normalized.labels().element(i), reference.labels().element(i));
+		BOOST_REQUIRE_EQUAL(normalized.inputs().element(i)(0), dataset.inputs().element(i)(0));
+	}
+
+	// the lazy layer maps label batches on access
+	LazyTransformedData<unsigned int, LabelOrder::Mapping> lazyLabels = labelOrder.mapLabelsLazily(dataset);
+	BOOST_REQUIRE_EQUAL(lazyLabels.numberOfBatches(), dataset.labels().numberOfBatches());
+	std::size_t element = 0;
+	for(std::size_t b = 0; b < lazyLabels.numberOfBatches(); ++b)
+	{
+		Batch<unsigned int>::type const& batch = lazyLabels.batch(b);
+		for(std::size_t e = 0; e < boost::size(batch); ++e, ++element)
+			BOOST_REQUIRE_EQUAL(shark::get(batch, e), reference.labels().element(element));
+	}
+
+	// labels outside the stored ordering are rejected by the mapping
+	try
+	{
+		labelOrder.mapping()((unsigned int)(4 * dataset.numberOfElements()));
+
+		// this should have thrown an error.
+		BOOST_REQUIRE_EQUAL(1, 0);
+	}
+	catch(...)
+	{
+		// everything is fine.
+		BOOST_REQUIRE_EQUAL(0, 0);
+	}
+}
+
+
+
+
 BOOST_AUTO_TEST_SUITE_END()
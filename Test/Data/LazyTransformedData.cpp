@@ -0,0 +1,104 @@
+#define BOOST_TEST_MODULE Data_LazyTransformedData
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Data/LazyTransformedData.h>
+
+using namespace shark;
+
+namespace {
+
+//batch-wise functor counting how often it is applied
+struct CountingScale{
+	typedef RealVector result_type;
+	std::size_t* applications;
+	RealMatrix operator()(RealMatrix const& batch)const{
+		++*applications;
+		return 2.0 * batch;
+	}
+};
+
+//element-wise functor
+struct ShiftElement{
+	typedef RealVector result_type;
+	RealVector operator()(RealVector const& x)const{
+		return x + blas::repeat(1.0, x.size());
+	}
+};
+
+Data<RealVector> createTestData(){
+	std::vector<RealVector> points;
+	for(std::size_t i = 0; i != 23; ++i){
+		RealVector point(3);
+		point(0) = (double)i;
+		point(1) = 2.0 * i;
+		point(2) = -1.0 * i;
+		points.push_back(point);
+	}
+	return createDataFromRange(points, 7);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE (Data_LazyTransformedData)
+
+BOOST_AUTO_TEST_CASE( LazyTransformedData_Matches_Transform )
+{
+	Data<RealVector> data = createTestData();
+	std::size_t applications = 0;
+	CountingScale functor = {&applications};
+	Data<RealVector> eager = transform(data, functor);
+
+	applications = 0;
+	LazyTransformedData<RealVector, CountingScale> lazy(data, functor, 1 << 20);
+	BOOST_REQUIRE_EQUAL(lazy.numberOfBatches(), data.numberOfBatches());
+	BOOST_REQUIRE_EQUAL(lazy.numberOfElements(), data.numberOfElements());
+
+	//with a generous budget every batch is computed exactly once over several passes
+	for(std::size_t pass = 0; pass != 3; ++pass)
+		for(std::size_t b = 0; b != lazy.numberOfBatches(); ++b)
+			BOOST_CHECK_SMALL(norm_inf(lazy.batch(b) - eager.batch(b)), 1.e-15);
+	BOOST_CHECK_EQUAL(applications, data.numberOfBatches());
+	BOOST_CHECK_LE(lazy.usedBytes(), lazy.cacheBytes());
+}
+
+BOOST_AUTO_TEST_CASE( LazyTransformedData_Budget )
+{
+	Data<RealVector> data = createTestData();
+	std::size_t applications = 0;
+	CountingScale functor = {&applications};
+
+	//room for two of the 6x3 result batches
+	std::size_t batchBytes = 6 * 3 * sizeof(double);
+	LazyTransformedData<RealVector, CountingScale> lazy(data, functor, 2 * batchBytes);
+	for(std::size_t pass = 0; pass != 2; ++pass){
+		for(std::size_t b = 0; b != lazy.numberOfBatches(); ++b){
+			lazy.batch(b);
+			BOOST_CHECK_LE(lazy.usedBytes(), lazy.cacheBytes());
+		}
+	}
+	//the cache is too small for a full pass, so the second pass recomputes
+	BOOST_CHECK_GT(applications, data.numberOfBatches());
+
+	//repeated access of a cached batch computes nothing
+	applications = 0;
+	lazy.batch(0);
+	lazy.batch(0);
+	BOOST_CHECK_EQUAL(applications, 1u);
+
+	//shrinking the budget to zero drops all cached batches
+	lazy.setCacheBytes(0);
+	BOOST_CHECK_EQUAL(lazy.usedBytes(), 0u);
+}
+
+BOOST_AUTO_TEST_CASE( LazyTransformedData_ElementWise )
+{
+	Data<RealVector> data = createTestData();
+	ShiftElement functor;
+	Data<RealVector> eager = transform(data, functor);
+	auto lazy = lazyTransform(data, functor);
+	for(std::size_t b = 0; b != lazy.numberOfBatches(); ++b)
+		BOOST_CHECK_SMALL(norm_inf(lazy.batch(b) - eager.batch(b)), 1.e-15);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
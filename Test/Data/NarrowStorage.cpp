@@ -0,0 +1,70 @@
+#define BOOST_TEST_MODULE Data_NarrowStorage
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Data/NarrowStorage.h>
+
+using namespace shark;
+
+namespace {
+
+Data<RealVector> createCategoricalData(){
+	std::vector<RealVector> points;
+	for(std::size_t i = 0; i != 23; ++i){
+		RealVector point(3);
+		point(0) = (double)(i % 5);
+		point(1) = (double)((2 * i) % 200);
+		point(2) = (double)i;
+		points.push_back(point);
+	}
+	return createDataFromRange(points, 7);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE (Data_NarrowStorage)
+
+BOOST_AUTO_TEST_CASE( NarrowStorage_Roundtrip )
+{
+	Data<RealVector> data = createCategoricalData();
+	Data<UInt8Vector> narrow = narrowStorage<std::uint8_t>(data);
+	BOOST_REQUIRE_EQUAL(narrow.numberOfBatches(), data.numberOfBatches());
+	BOOST_REQUIRE_EQUAL(narrow.numberOfElements(), data.numberOfElements());
+
+	Data<RealVector> wide = widenStorage(narrow);
+	for(std::size_t b = 0; b != data.numberOfBatches(); ++b){
+		BOOST_REQUIRE_EQUAL(wide.batch(b).size1(), data.batch(b).size1());
+		BOOST_CHECK_SMALL(norm_inf(wide.batch(b) - data.batch(b)), 1.e-15);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( NarrowStorage_LazyWidening )
+{
+	Data<RealVector> data = createCategoricalData();
+	Data<UInt16Vector> narrow = narrowStorage<std::uint16_t>(data);
+
+	//budget for a single widened batch: batches are produced on access
+	auto lazy = lazyWidenStorage(narrow, 6 * 3 * sizeof(double));
+	for(std::size_t b = 0; b != lazy.numberOfBatches(); ++b){
+		BOOST_CHECK_SMALL(norm_inf(lazy.batch(b) - data.batch(b)), 1.e-15);
+		BOOST_CHECK_LE(lazy.usedBytes(), lazy.cacheBytes());
+	}
+}
+
+BOOST_AUTO_TEST_CASE( NarrowStorage_Rejects_Unrepresentable )
+{
+	std::vector<RealVector> points(23, RealVector(1, 0.0));
+	points[4](0) = 300.0;//does not fit an 8 bit code
+	Data<RealVector> data = createDataFromRange(points, 7);
+	BOOST_CHECK_THROW(narrowStorage<std::uint8_t>(data), shark::Exception);
+	//but fits 16 bit
+	BOOST_CHECK_NO_THROW(narrowStorage<std::uint16_t>(data));
+
+	points[4](0) = 7.5;//fractional values cannot be stored in integral codes
+	data = createDataFromRange(points, 7);
+	BOOST_CHECK_THROW(narrowStorage<std::uint16_t>(data), shark::Exception);
+	//float storage is allowed to round
+	BOOST_CHECK_NO_THROW(narrowStorage<float>(data));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,85 @@
+#define BOOST_TEST_MODULE Data_OutOfCoreData
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Data/OutOfCoreData.h>
+
+#include <random>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Data_OutOfCoreData)
+
+BOOST_AUTO_TEST_CASE( Data_OutOfCoreData_Sequential_Epochs ){
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<double> dist(-10.0, 10.0);
+	std::vector<RealVector> points;
+	for(std::size_t i = 0; i != 500; ++i){
+		RealVector point(20);
+		for(std::size_t j = 0; j != point.size(); ++j)
+			point(j) = dist(rng);
+		points.push_back(point);
+	}
+	Data<RealVector> data = createDataFromRange(points, 25);
+
+	//budget of roughly three batches out of twenty
+	OutOfCoreData<RealVector> spilled(data, "./test_output/spilled.bin", 3 * 4500);
+	BOOST_REQUIRE_EQUAL(spilled.numberOfBatches(), data.numberOfBatches());
+	BOOST_REQUIRE_EQUAL(spilled.numberOfElements(), points.size());
+
+	//iterating in order over several epochs must reproduce the values exactly
+	//while never exceeding the resident budget
+	for(std::size_t epoch = 0; epoch != 3; ++epoch){
+		std::size_t element = 0;
+		for(std::size_t b = 0; b != spilled.numberOfBatches(); ++b){
+			RealMatrix const& batch = spilled.batch(b);
+			BOOST_CHECK(spilled.usedBytes() <= spilled.residentBytes());
+			for(std::size_t i = 0; i != batch.size1(); ++i, ++element)
+				BOOST_CHECK_EQUAL(norm_inf(row(batch, i) - points[element]), 0.0);
+		}
+		BOOST_CHECK_EQUAL(element, points.size());
+	}
+}
+
+BOOST_AUTO_TEST_CASE( Data_OutOfCoreData_Random_Access ){
+	std::vector<RealVector> points;
+	for(std::size_t i = 0; i != 160; ++i){
+		RealVector point(7);
+		for(std::size_t j = 0; j != point.size(); ++j)
+			point(j) = 100.0 * i + j;
+		points.push_back(point);
+	}
+	Data<RealVector> data = createDataFromRange(points, 16);
+	OutOfCoreData<RealVector> spilled(data, "./test_output/spilled_random.bin", 2 * 1500);
+
+	//out-of-order access is slower but must stay correct and within budget
+	std::mt19937 rng(23);
+	std::uniform_int_distribution<std::size_t> pick(0, spilled.numberOfBatches() - 1);
+	for(std::size_t trial = 0; trial != 100; ++trial){
+		std::size_t b = pick(rng);
+		RealMatrix const& batch = spilled.batch(b);
+		BOOST_CHECK(spilled.usedBytes() <= spilled.residentBytes());
+		BOOST_CHECK_EQUAL(norm_inf(row(batch, 0) - points[16 * b]), 0.0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( Data_OutOfCoreData_Shrink_Budget ){
+	std::vector<RealVector> points(40, RealVector(11, 1.0));
+	Data<RealVector> data = createDataFromRange(points, 8);
+	OutOfCoreData<RealVector> spilled(data, "./test_output/spilled_shrink.bin");
+
+	//the default budget keeps everything resident
+	for(std::size_t b = 0; b != spilled.numberOfBatches(); ++b)
+		spilled.batch(b);
+	std::size_t allResident = spilled.usedBytes();
+	BOOST_CHECK(allResident > 0);
+
+	//shrinking the budget evicts batches immediately and later accesses
+	//still return the correct values
+	spilled.setResidentBytes(allResident / 2);
+	BOOST_CHECK(spilled.usedBytes() <= spilled.residentBytes());
+	RealMatrix const& batch = spilled.batch(0);
+	BOOST_CHECK_EQUAL(batch(0, 0), 1.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
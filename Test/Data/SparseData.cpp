@@ -3,6 +3,7 @@
 #include <boost/test/floating_point_comparison.hpp>
 
 #include <shark/Data/SparseData.h>
+#include <shark/Models/Normalizer.h>
 
 #include <iostream>
 #include <sstream>
@@ -226,4 +227,101 @@ BOOST_AUTO_TEST_CASE (Set_SparseData)
 	TestExportImport_regression(test_ds_sreg);
 }
 
+//the file overloads use the parallel scanner and must agree with the
+//stream based import in every value and label
+BOOST_AUTO_TEST_CASE (Set_SparseData_File)
+{
+	{
+		std::ofstream out("./test_output/sparse_mc.libsvm");
+		out << test_mc_classification;
+	}
+	{
+		std::ofstream out("./test_output/sparse_reg.libsvm");
+		out << test_regression;
+	}
+
+	LabeledData<RealVector,           unsigned int> test_ds_mc;
+	LabeledData<CompressedRealVector, unsigned int> test_ds_smc;
+	LabeledData<RealVector,           RealVector>   test_ds_reg;
+	LabeledData<CompressedRealVector, RealVector>   test_ds_sreg;
+
+	importSparseData(test_ds_mc, std::string("./test_output/sparse_mc.libsvm"));
+	importSparseData(test_ds_smc, std::string("./test_output/sparse_mc.libsvm"));
+	importSparseData(test_ds_reg, std::string("./test_output/sparse_reg.libsvm"));
+	importSparseData(test_ds_sreg, std::string("./test_output/sparse_reg.libsvm"));
+
+	BOOST_REQUIRE_EQUAL(test_ds_mc.numberOfElements(), NumLines);
+	BOOST_REQUIRE_EQUAL(test_ds_smc.numberOfElements(), NumLines);
+	BOOST_REQUIRE_EQUAL(test_ds_reg.numberOfElements(), NumLines);
+	BOOST_REQUIRE_EQUAL(test_ds_sreg.numberOfElements(), NumLines);
+
+	BOOST_CHECK_EQUAL(3u, test_ds_mc.element(0).label);
+	BOOST_CHECK_EQUAL(2u, test_ds_mc.element(1).label);
+	BOOST_CHECK_EQUAL(1u, test_ds_mc.element(2).label);
+	BOOST_CHECK_EQUAL(0u, test_ds_mc.element(3).label);
+	BOOST_CHECK_EQUAL(2u, test_ds_mc.element(4).label);
+	BOOST_CHECK_EQUAL(  7.1, test_ds_reg.element(0).label(0));
+	BOOST_CHECK_EQUAL( 9.99, test_ds_reg.element(1).label(0));
+	BOOST_CHECK_EQUAL( -5.0, test_ds_reg.element(2).label(0));
+	BOOST_CHECK_EQUAL(  1.0, test_ds_reg.element(3).label(0));
+	BOOST_CHECK_EQUAL(500.0, test_ds_reg.element(4).label(0));
+
+	for (std::size_t i=0; i<NumLines; i++)
+	{
+		BOOST_REQUIRE_EQUAL(test_ds_mc.element(i).input.size(), VectorSize);
+		BOOST_REQUIRE_EQUAL(test_ds_smc.element(i).input.size(), VectorSize);
+		BOOST_REQUIRE_EQUAL(test_ds_reg.element(i).input.size(), VectorSize);
+		BOOST_REQUIRE_EQUAL(test_ds_sreg.element(i).input.size(), VectorSize);
+		for (std::size_t j=0; j<VectorSize; j++)
+		{
+			BOOST_CHECK_EQUAL(test_ds_mc.element(i).input(j), input_values[i][j]);
+			BOOST_CHECK_EQUAL(test_ds_smc.element(i).input(j), input_values[i][j]);
+			BOOST_CHECK_EQUAL(test_ds_reg.element(i).input(j), input_values[i][j]);
+			BOOST_CHECK_EQUAL(test_ds_sreg.element(i).input(j), input_values[i][j]);
+		}
+		BOOST_CHECK_EQUAL(test_ds_mc.element(i).label, test_ds_smc.element(i).label);
+		BOOST_CHECK_EQUAL(test_ds_reg.element(i).label(0), test_ds_sreg.element(i).label(0));
+	}
+
+	//importing with a preprocessing model must give the same result as
+	//importing and transforming afterwards, for dense and sparse inputs
+	Normalizer<RealVector> normalizer;
+	RealVector diagonal(VectorSize);
+	for(std::size_t j = 0; j != VectorSize; ++j)
+		diagonal(j) = 0.5*j+0.25;
+	normalizer.setStructure(diagonal);
+
+	LabeledData<RealVector, unsigned int> test_ds_mc_pre;
+	importSparseData(test_ds_mc_pre, std::string("./test_output/sparse_mc.libsvm"), normalizer);
+	BOOST_REQUIRE_EQUAL(test_ds_mc_pre.numberOfElements(), NumLines);
+
+	Normalizer<CompressedRealVector> sparseNormalizer;
+	sparseNormalizer.setStructure(diagonal);
+	LabeledData<CompressedRealVector, unsigned int> test_ds_smc_pre;
+	importSparseData(test_ds_smc_pre, std::string("./test_output/sparse_mc.libsvm"), sparseNormalizer);
+	BOOST_REQUIRE_EQUAL(test_ds_smc_pre.numberOfElements(), NumLines);
+
+	for (std::size_t i=0; i<NumLines; i++)
+	{
+		BOOST_CHECK_EQUAL(test_ds_mc_pre.element(i).label, test_ds_mc.element(i).label);
+		BOOST_CHECK_EQUAL(test_ds_smc_pre.element(i).label, test_ds_smc.element(i).label);
+		for (std::size_t j=0; j<VectorSize; j++)
+		{
+			BOOST_CHECK_SMALL(test_ds_mc_pre.element(i).input(j) - diagonal(j)*input_values[i][j], 1.e-12);
+			BOOST_CHECK_SMALL(test_ds_smc_pre.element(i).input(j) - diagonal(j)*input_values[i][j], 1.e-12);
+		}
+	}
+
+	//malformed records are still reported as errors
+	{
+		std::ofstream out("./test_output/sparse_broken.libsvm");
+		out << "1 2:1.0 garbage\n";
+	}
+	LabeledData<RealVector, unsigned int> broken;
+	BOOST_CHECK_THROW(
+		importSparseData(broken, std::string("./test_output/sparse_broken.libsvm")),
+		shark::Exception
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,83 @@
+#define BOOST_TEST_MODULE LinAlg_BLAS_AlignedAllocator
+#include <boost/test/unit_test.hpp>
+
+#include <shark/LinAlg/BLAS/blas.h>
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace shark;
+
+namespace{
+bool isAligned(void const* pointer){
+	return reinterpret_cast<std::uintptr_t>(pointer) % blas::detail::memory_arena::alignment == 0;
+}
+}
+
+BOOST_AUTO_TEST_SUITE (LinAlg_BLAS_aligned_allocator)
+
+BOOST_AUTO_TEST_CASE( LinAlg_BLAS_Aligned_Allocator_Alignment ){
+	//container storage must be 64 byte aligned for every size, including odd ones
+	std::size_t sizes[] = {1, 3, 7, 8, 63, 64, 65, 1000, 4096, 100000};
+	for(std::size_t size: sizes){
+		blas::vector<double> v(size);
+		BOOST_CHECK(isAligned(v.raw_storage().values));
+		blas::vector<float> vf(size);
+		BOOST_CHECK(isAligned(vf.raw_storage().values));
+		blas::matrix<double> m(7, size);
+		BOOST_CHECK(isAligned(m.raw_storage().values));
+	}
+	//raw allocations of the allocator itself
+	blas::aligned_allocator<double> allocator;
+	double* p = allocator.allocate(17);
+	BOOST_CHECK(isAligned(p));
+	allocator.deallocate(p, 17);
+}
+
+BOOST_AUTO_TEST_CASE( LinAlg_BLAS_Aligned_Allocator_Arena_Reuse ){
+	//a freed block of the same size class must be handed out again
+	double* first = 0;
+	{
+		blas::vector<double> v(1000);
+		first = v.raw_storage().values;
+	}
+	blas::vector<double> w(1000);
+	BOOST_CHECK_EQUAL(w.raw_storage().values, first);
+}
+
+BOOST_AUTO_TEST_CASE( LinAlg_BLAS_Aligned_Allocator_Cross_Thread ){
+	//memory allocated on one thread may be freed on another;
+	//afterwards both threads must still produce correct results
+	blas::vector<double>* shared = new blas::vector<double>(10000, 1.0);
+	double sum = 0;
+	std::thread worker([&]{
+		delete shared;
+		blas::vector<double> v(512, 2.0);
+		blas::vector<double> w = v + v;
+		for(std::size_t i = 0; i != w.size(); ++i)
+			sum += w(i);
+	});
+	worker.join();
+	BOOST_CHECK_EQUAL(sum, 4.0 * 512);
+
+	//hammer the arenas from several threads in parallel
+	std::vector<std::thread> threads;
+	std::vector<int> failures(4, 0);
+	for(std::size_t t = 0; t != 4; ++t){
+		threads.emplace_back([t, &failures]{
+			for(std::size_t i = 0; i != 10000; ++i){
+				blas::vector<double> v(137, double(i));
+				blas::vector<double> w = 2.0 * v;
+				if(w(136) != 2.0 * i)
+					++failures[t];
+			}
+		});
+	}
+	for(std::size_t t = 0; t != 4; ++t)
+		threads[t].join();
+	for(std::size_t t = 0; t != 4; ++t)
+		BOOST_CHECK_EQUAL(failures[t], 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
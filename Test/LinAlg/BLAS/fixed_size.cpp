@@ -0,0 +1,88 @@
+#define BOOST_TEST_MODULE BLAS_fixed_size
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/LinAlg/BLAS/blas.h>
+
+using namespace shark;
+using namespace blas;
+
+BOOST_AUTO_TEST_SUITE (BLAS_fixed_size)
+
+BOOST_AUTO_TEST_CASE( BLAS_fixed_size_vector_construction ){
+	vectorN<double,4> zero;
+	for(std::size_t i = 0; i != 4; ++i){
+		BOOST_CHECK_EQUAL(zero(i), 0.0);
+	}
+	vectorN<double,4> filled(2.5);
+	for(std::size_t i = 0; i != 4; ++i){
+		BOOST_CHECK_EQUAL(filled(i), 2.5);
+	}
+	vectorN<double,4> list = {1.0,2.0,3.0,4.0};
+	BOOST_REQUIRE_EQUAL(list.size(), 4u);
+	for(std::size_t i = 0; i != 4; ++i){
+		BOOST_CHECK_EQUAL(list(i), i + 1.0);
+	}
+}
+
+BOOST_AUTO_TEST_CASE( BLAS_fixed_size_vector_expressions ){
+	vectorN<double,4> x = {1.0,2.0,3.0,4.0};
+	vector<double> y(4,1.0);
+
+	//mixing fixed and dynamic arguments in the same expression
+	vectorN<double,4> sum = x + y;
+	vector<double> sumDynamic = x + y;
+	BOOST_REQUIRE_EQUAL(sumDynamic.size(), 4u);
+	for(std::size_t i = 0; i != 4; ++i){
+		BOOST_CHECK_CLOSE(sum(i), x(i) + 1.0, 1.e-10);
+		BOOST_CHECK_CLOSE(sumDynamic(i), sum(i), 1.e-10);
+	}
+	BOOST_CHECK_CLOSE(inner_prod(x,y), 10.0, 1.e-10);
+}
+
+BOOST_AUTO_TEST_CASE( BLAS_fixed_size_matrix_products ){
+	matrixN<double,3,4> A;
+	for(std::size_t i = 0; i != 3; ++i){
+		for(std::size_t j = 0; j != 4; ++j){
+			A(i,j) = i + 0.1 * j;
+		}
+	}
+	vectorN<double,4> x = {1.0,-1.0,2.0,0.5};
+
+	vectorN<double,3> b = prod(A,x);
+	for(std::size_t i = 0; i != 3; ++i){
+		double result = 0;
+		for(std::size_t j = 0; j != 4; ++j){
+			result += A(i,j) * x(j);
+		}
+		BOOST_CHECK_CLOSE(b(i), result, 1.e-10);
+	}
+
+	//fixed size result of a matrix-matrix product, also column major
+	matrixN<double,3,3,column_major> B = prod(A,trans(A));
+	matrix<double> Bref = prod(A,trans(A));
+	for(std::size_t i = 0; i != 3; ++i){
+		for(std::size_t j = 0; j != 3; ++j){
+			BOOST_CHECK_CLOSE(B(i,j), Bref(i,j), 1.e-10);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( BLAS_fixed_size_matrix_proxies ){
+	matrixN<double,4,4> A;
+	for(std::size_t i = 0; i != 4; ++i){
+		for(std::size_t j = 0; j != 4; ++j){
+			A(i,j) = 4.0 * i + j;
+		}
+	}
+	vector<double> r = row(A,1);
+	BOOST_REQUIRE_EQUAL(r.size(), 4u);
+	for(std::size_t j = 0; j != 4; ++j){
+		BOOST_CHECK_EQUAL(r(j), A(1,j));
+	}
+	matrix<double> sub = subrange(A,1,3,0,2);
+	BOOST_CHECK_EQUAL(sub(0,0), A(1,0));
+	BOOST_CHECK_EQUAL(sub(1,1), A(2,1));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -155,6 +155,49 @@ BOOST_AUTO_TEST_CASE( BLAS_Vector_Sigmoid )
 	}
 	checkDenseExpressionEquality(sigmoid(x),result);
 }
+//assignment of the transcendental functions takes a vectorized batch path
+//for contiguous dense storage, so check it on vectors bigger than one simd
+//block, including the scalar remainder and extreme arguments
+BOOST_AUTO_TEST_CASE( BLAS_Vector_Transcendental_Batch_Assign )
+{
+	std::size_t dims = 103;
+	vector<double> x(dims);
+	vector<double> y(dims);
+	for(std::size_t i = 0; i != dims; ++i){
+		x(i) = 0.02 * i - 1.0;
+	}
+	noalias(y) = exp(x);
+	for(std::size_t i = 0; i != dims; ++i)
+		BOOST_CHECK_CLOSE(y(i), std::exp(x(i)), 1.e-12);
+	noalias(y) = sigmoid(x);
+	for(std::size_t i = 0; i != dims; ++i)
+		BOOST_CHECK_CLOSE(y(i), 1.0/(1.0+std::exp(-x(i))), 1.e-12);
+	noalias(y) = tanh(x);
+	for(std::size_t i = 0; i != dims; ++i)
+		BOOST_CHECK_CLOSE(y(i), std::tanh(x(i)), 1.e-12);
+
+	for(std::size_t i = 0; i != dims; ++i){
+		x(i) = std::pow(10.0, 0.5 * i - 25.0);
+	}
+	noalias(y) = log(x);
+	for(std::size_t i = 0; i != dims; ++i)
+		BOOST_CHECK_CLOSE(y(i), std::log(x(i)), 1.e-12);
+
+	//extreme arguments must saturate instead of producing garbage
+	vector<double> extremes(4);
+	extremes(0) = -1000; extremes(1) = 1000; extremes(2) = 0; extremes(3) = 709;
+	vector<double> results(4);
+	noalias(results) = exp(extremes);
+	BOOST_CHECK_EQUAL(results(0), 0.0);
+	BOOST_CHECK(results(1) > 1.e300);//saturates to infinity
+	BOOST_CHECK_EQUAL(results(2), 1.0);
+	BOOST_CHECK_CLOSE(results(3), std::exp(709.0), 1.e-12);
+	noalias(results) = sigmoid(extremes);
+	BOOST_CHECK_EQUAL(results(0), 0.0);
+	BOOST_CHECK_EQUAL(results(1), 1.0);
+	BOOST_CHECK_EQUAL(results(2), 0.5);
+}
+
 BOOST_AUTO_TEST_CASE( BLAS_Vector_SoftPlus )
 {
 	vector<double> x(Dimensions); 
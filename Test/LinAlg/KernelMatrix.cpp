@@ -4,11 +4,14 @@
 
 #include <shark/Algorithms/QP/QuadraticProgram.h>
 #include <shark/Models/Kernels/LinearKernel.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
 #include <shark/Models/Kernels/KernelHelpers.h>
+#include <shark/LinAlg/GaussianKernelMatrix.h>
 #include <shark/Data/DataDistribution.h>
 #include <shark/LinAlg/BlockMatrix2x2.h>
 #include <shark/LinAlg/CachedMatrix.h>
 #include <shark/LinAlg/KernelMatrix.h>
+#include <shark/LinAlg/KernelRowStore.h>
 #include <shark/LinAlg/ModifiedKernelMatrix.h>
 #include <shark/LinAlg/PrecomputedMatrix.h>
 #include <shark/LinAlg/RegularizedKernelMatrix.h>
@@ -47,6 +50,28 @@ struct Fixture {
 };
 
 
+//wrapper counting the matrix entries delegated to the base matrix
+template<class Matrix>
+struct CountingMatrix{
+	typedef typename Matrix::QpFloatType QpFloatType;
+	CountingMatrix(Matrix* base):mep_base(base),evaluatedEntries(0){}
+	void row(std::size_t k, std::size_t start, std::size_t end, QpFloatType* storage) const{
+		evaluatedEntries += end-start;
+		mep_base->row(k,start,end,storage);
+	}
+	QpFloatType entry(std::size_t i, std::size_t j) const{
+		return mep_base->entry(i,j);
+	}
+	void flipColumnsAndRows(std::size_t i, std::size_t j){
+		mep_base->flipColumnsAndRows(i,j);
+	}
+	std::size_t size() const{
+		return mep_base->size();
+	}
+	Matrix* mep_base;
+	mutable std::size_t evaluatedEntries;
+};
+
 template<class MatrixType, class Result>
 void testFullMatrix(MatrixType& matrix, Result const& result){
 	std::size_t size = matrix.size();
@@ -114,6 +139,21 @@ BOOST_AUTO_TEST_CASE( QP_KernelMatrix ) {
 	testMatrix(km,matrix);
 }
 
+BOOST_AUTO_TEST_CASE( QP_GaussianKernelMatrix ) {
+	double gamma = 0.5;
+	GaussianRbfKernel<> rbfKernel(gamma);
+	//compute the reference entry by entry
+	RealMatrix matrix(size,size);
+	for(std::size_t i = 0; i != size; ++i){
+		for(std::size_t j = 0; j != size; ++j){
+			matrix(i,j) = rbfKernel(data.inputs().element(i),data.inputs().element(j));
+		}
+	}
+	GaussianKernelMatrix<RealVector,double> km(gamma,data.inputs());
+	testFullMatrix(km,matrix);
+	testMatrix(km,matrix);
+}
+
 BOOST_AUTO_TEST_CASE( QP_RegularizedKernelMatrix ) {
 	RealMatrix matrix = kernelMatrix;
 	RealVector diagVec(size);
@@ -223,8 +263,49 @@ BOOST_AUTO_TEST_CASE( QP_CachedMatrix_Flipping ) {
 		BOOST_CHECK_EQUAL(cache.isCached(i), false);
 		BOOST_CHECK_EQUAL(cache.getCacheRowSize(i), 0);
 	}
-	
+
 }
 
+BOOST_AUTO_TEST_CASE( QP_CachedMatrix_SharedRowStore ) {
+	KernelRowStore<double>& store = KernelRowStore<double>::instance();
+	store.clear();
+	std::string key = kernelRowStoreKey(kernel,data.inputs());
+
+	//the first trainer instance computes its rows and publishes them
+	KernelMatrix<RealVector,double> km1(kernel,data.inputs());
+	CachedMatrix<KernelMatrix<RealVector,double> > cache1(&km1,2*size*size);
+	cache1.attachRowStore(key);
+	for(std::size_t i = 0; i != size; ++i){
+		double* line = cache1.row(i,0,size);
+		for(std::size_t j = 0; j != size; ++j)
+			BOOST_CHECK_SMALL(line[j]-kernelMatrix(i,j),1.e-13);
+	}
+	BOOST_CHECK_EQUAL(store.storedRows(),size);
+	BOOST_CHECK_EQUAL(store.size(),size*size);
+
+	//the second instance obtains all rows from the store without base evaluations,
+	//translating its own permutation when reading the shared rows
+	KernelMatrix<RealVector,double> km2(kernel,data.inputs());
+	CountingMatrix<KernelMatrix<RealVector,double> > counted(&km2);
+	CachedMatrix<CountingMatrix<KernelMatrix<RealVector,double> > > cache2(&counted,2*size*size);
+	cache2.attachRowStore(key);
+	cache2.flipColumnsAndRows(3,17);
+	KernelMatrix<RealVector,double> groundTruth(kernel,data.inputs());
+	groundTruth.flipColumnsAndRows(3,17);
+	for(std::size_t i = 0; i != size; ++i){
+		double* line = cache2.row(i,0,size);
+		for(std::size_t j = 0; j != size; ++j)
+			BOOST_CHECK_SMALL(line[j]-groundTruth(i,j),1.e-13);
+	}
+	BOOST_CHECK_EQUAL(counted.evaluatedEntries,0);
+
+	//a different kernel configuration must not alias with the stored rows
+	GaussianRbfKernel<> rbfKernel(0.5);
+	BOOST_CHECK(kernelRowStoreKey(rbfKernel,data.inputs()) != key);
+
+	store.clear();
+	BOOST_CHECK_EQUAL(store.storedRows(),0);
+	BOOST_CHECK_EQUAL(store.size(),0);
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -141,5 +141,82 @@ BOOST_AUTO_TEST_CASE( LinAlg_LRUCache_DifferentLength_Access_fliped ) {
 	simulateCache(maxIndex, cacheSize,accessIndices,accessSizes,flips);
 }
 
+///\brief tests correctness and budget obedience of the sharded cache
+BOOST_AUTO_TEST_CASE( LinAlg_ShardedLRUCache_Access ) {
+	std::size_t cacheSize = 40;
+	std::size_t maxIndex = 20;
+	std::size_t shards = 4;
+	std::size_t simulationSteps = 10000;
+
+	ShardedLRUCache<std::size_t> cache(maxIndex,cacheSize,shards);
+	std::vector<std::size_t> elemSizes(maxIndex,0);
+	for(std::size_t t = 0; t != simulationSteps; ++t){
+		std::size_t index = Rng::discrete(0,maxIndex-1);
+		std::size_t size = Rng::discrete(1,3);
+
+		std::size_t* line = cache.getCacheLine(index,size);
+		for(std::size_t i = 0; i != size; ++i){
+			line[i] = index+i;
+		}
+		BOOST_REQUIRE(cache.isCached(index));
+		BOOST_REQUIRE_GE(cache.lineLength(index), size);
+		//previously written values of the line must have been retained
+		std::size_t const* stored = cache.getLinePointer(index);
+		for(std::size_t i = 0; i != size; ++i){
+			BOOST_REQUIRE_EQUAL(stored[i], index+i);
+		}
+		//the cache must never exceed its total budget
+		BOOST_REQUIRE_LE(cache.size(), cache.maxSize());
+
+		//bookkeeping of all line lengths must be consistent
+		std::size_t totalSize = 0;
+		std::size_t lines = 0;
+		for(std::size_t i = 0; i != maxIndex; ++i){
+			totalSize += cache.lineLength(i);
+			if(cache.isCached(i)) ++lines;
+		}
+		BOOST_REQUIRE_EQUAL(totalSize, cache.size());
+		BOOST_REQUIRE_EQUAL(lines, cache.cachedLines());
+	}
+	cache.clear();
+	BOOST_REQUIRE_EQUAL(cache.size(), 0);
+	BOOST_REQUIRE_EQUAL(cache.cachedLines(), 0);
+}
+
+///\brief tests swapping of line indices across shards
+BOOST_AUTO_TEST_CASE( LinAlg_ShardedLRUCache_Swap ) {
+	std::size_t cacheSize = 40;
+	std::size_t maxIndex = 20;
+	std::size_t shards = 4;
+	std::size_t simulationSteps = 10000;
+
+	ShardedLRUCache<std::size_t> cache(maxIndex,cacheSize,shards);
+	std::vector<std::vector<std::size_t> > content(maxIndex);
+	for(std::size_t t = 0; t != simulationSteps; ++t){
+		std::size_t index = Rng::discrete(0,maxIndex-1);
+		std::size_t size = Rng::discrete(1,3);
+		std::size_t* line = cache.getCacheLine(index,size);
+		content[index].resize(std::max(content[index].size(),size));
+		for(std::size_t i = 0; i != size; ++i){
+			line[i] = Rng::discrete(0,1000);
+			content[index][i] = line[i];
+		}
+
+		std::size_t a = Rng::discrete(0,maxIndex-1);
+		std::size_t b = Rng::discrete(0,maxIndex-1);
+		cache.swapLineIndices(a,b);
+		std::swap(content[a],content[b]);
+
+		//swapped lines must carry their content with them unless they were evicted
+		for(std::size_t i = 0; i != maxIndex; ++i){
+			if(!cache.isCached(i)) continue;
+			std::size_t const* stored = cache.getLinePointer(i);
+			for(std::size_t k = 0; k != std::min(cache.lineLength(i),content[i].size()); ++k){
+				BOOST_REQUIRE_EQUAL(stored[k], content[i][k]);
+			}
+		}
+		BOOST_REQUIRE_LE(cache.size(), cache.maxSize());
+	}
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -95,4 +95,43 @@ BOOST_AUTO_TEST_CASE( LinAlg_eigensymm_general )
 		BOOST_CHECK_SMALL(error_orthogonalize,1.e-12);
 	}
 }
+
+BOOST_AUTO_TEST_CASE( LinAlg_eigensymm_randomized )
+{
+	std::size_t NumTests = 10;
+	std::size_t Dimensions = 60;
+	std::size_t NumEigenvalues = 5;
+	for(std::size_t test = 0; test != NumTests; ++test){
+		//generate a matrix with a fast decaying spectrum, the regime the
+		//randomized solver is designed for
+		RealVector lambda(Dimensions);
+		for(std::size_t i = 0; i != Dimensions; ++i){
+			lambda(i) = std::pow(0.5,(double)i)*100;
+		}
+		RealMatrix A = createRandomMatrix(lambda,Dimensions);
+
+		RealVector eigenvalues;
+		RealMatrix eigenVectors;
+		eigensymmRand(A, eigenVectors, eigenvalues, NumEigenvalues);
+
+		BOOST_REQUIRE_EQUAL(eigenVectors.size1(), Dimensions);
+		BOOST_REQUIRE_EQUAL(eigenVectors.size2(), NumEigenvalues);
+		BOOST_REQUIRE_EQUAL(eigenvalues.size(), NumEigenvalues);
+
+		//check that the truncated basis is orthonormal
+		double errorOrtho = max(abs(
+			prod(trans(eigenVectors),eigenVectors)-identity_matrix<double>(NumEigenvalues)
+		));
+		BOOST_CHECK(!(boost::math::isnan)(errorOrtho));
+		BOOST_CHECK_SMALL(errorOrtho,1.e-10);
+
+		//check the leading eigenvalues and the eigenvector property A v = lambda v
+		for(std::size_t i = 0; i != NumEigenvalues; ++i){
+			BOOST_CHECK_SMALL(std::abs(eigenvalues(i) - lambda(i))/lambda(i),1.e-5);
+			RealVector v = column(eigenVectors,i);
+			double residual = norm_2(prod(A,v) - eigenvalues(i)*v);
+			BOOST_CHECK_SMALL(residual/eigenvalues(i),1.e-4);
+		}
+	}
+}
 BOOST_AUTO_TEST_SUITE_END()
@@ -384,6 +384,64 @@ BOOST_AUTO_TEST_CASE( LinAlg_Solve_Symmetric_Approximated_Vector ){
 	}
 }
 
+BOOST_AUTO_TEST_CASE( LinAlg_Solve_Symmetric_Approximated_Preconditioned_Vector ){
+	unsigned int NumTests = 100;
+	std::size_t Dimensions = 50;
+
+	std::cout<<"approximately blas::solve Symmetric vector with Jacobi preconditioner"<<std::endl;
+	for(unsigned int testi = 0; testi != NumTests; ++testi){
+		RealMatrix A = createRandomInvertibleMatrix(Dimensions,0.1,2);
+		//scale the variables differently so that the preconditioner matters
+		for(std::size_t i = 0; i != Dimensions; ++i){
+			double scale = std::pow(10.0,Rng::uni(-2,2));
+			row(A,i) *= scale;
+			column(A,i) *= scale;
+		}
+		RealVector b(Dimensions);
+		for(std::size_t i = 0; i != Dimensions; ++i){
+			b(i) = Rng::gauss(0,1);
+		}
+
+		RealVector x;
+		blas::JacobiPreconditioner preconditioner(A);
+		approxsolveSymmPosDefSystem(A,preconditioner,x,b,1.e-13);
+		RealVector test = prod(A,x);
+		double error = norm_inf(test-b);
+		BOOST_CHECK_SMALL(error,1.e-10);
+	}
+}
+
+namespace {
+//applies a dense matrix through the matrix-free operator interface
+struct MatrixFreeProduct{
+	RealMatrix const& A;
+	void operator()(RealVector const& x, RealVector& result)const{
+		noalias(result) = prod(A,x);
+	}
+};
+}
+
+BOOST_AUTO_TEST_CASE( LinAlg_Solve_Symmetric_Approximated_MatrixFree_Vector ){
+	unsigned int NumTests = 100;
+	std::size_t Dimensions = 50;
+
+	std::cout<<"approximately blas::solve Symmetric vector through matrix-free operator"<<std::endl;
+	for(unsigned int testi = 0; testi != NumTests; ++testi){
+		RealMatrix A = createRandomInvertibleMatrix(Dimensions,0.1,2);
+		RealVector b(Dimensions);
+		for(std::size_t i = 0; i != Dimensions; ++i){
+			b(i) = Rng::gauss(0,1);
+		}
+
+		RealVector x;
+		MatrixFreeProduct op = {A};
+		blas::approxsolveSymmPosDefSystemMatrixFree(op,blas::NoPreconditioner(),x,b,1.e-13);
+		RealVector test = prod(A,x);
+		double error = norm_inf(test-b);
+		BOOST_CHECK_SMALL(error,1.e-12);
+	}
+}
+
 BOOST_AUTO_TEST_CASE( LinAlg_Solve_Symmetric_Matrix ){
 	unsigned int NumTests = 100;
 	std::size_t Dimensions = 50;
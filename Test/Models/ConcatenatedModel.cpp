@@ -185,6 +185,51 @@ BOOST_AUTO_TEST_CASE( CONCATENATED_MODEL_weightedInputDerivative )
 	}
 
 }
+//the combined derivative must equal the separately computed derivatives; the
+//intermediate buffers of the state are reused, so repeated calls must give the same result
+BOOST_AUTO_TEST_CASE( CONCATENATED_MODEL_weightedDerivatives )
+{
+	FFNet<LogisticNeuron,LogisticNeuron> net1;
+	LinearModel<> net2;
+	net1.setStructure(3,5,2);
+	net2.setStructure(2,4);
+	ConcatenatedModel<RealVector,RealVector> model (&net1,&net2);
+
+	RealMatrix patterns(7,3);
+	RealMatrix coefficients(7,4);
+	for(unsigned int test = 0; test != 10; ++test){
+		RealVector parameters(model.numberOfParameters());
+		for(size_t i = 0; i != parameters.size();++i){
+			parameters(i) = Rng::uni(-5,5);
+		}
+		model.setParameterVector(parameters);
+		for(size_t i = 0; i != patterns.size1();++i){
+			for(size_t j = 0; j != patterns.size2();++j){
+				patterns(i,j) = Rng::uni(-5,5);
+			}
+			for(size_t j = 0; j != coefficients.size2();++j){
+				coefficients(i,j) = Rng::uni(-5,5);
+			}
+		}
+
+		boost::shared_ptr<State> state = model.createState();
+		RealMatrix outputs;
+		model.eval(patterns,outputs,*state);
+
+		RealVector parameterDerivative;
+		RealMatrix inputDerivative;
+		RealVector expectedParameterDerivative;
+		RealMatrix expectedInputDerivative;
+		model.weightedParameterDerivative(patterns,coefficients,*state,expectedParameterDerivative);
+		model.weightedInputDerivative(patterns,coefficients,*state,expectedInputDerivative);
+		for(unsigned int call = 0; call != 3; ++call){
+			model.weightedDerivatives(patterns,coefficients,*state,parameterDerivative,inputDerivative);
+			BOOST_REQUIRE_EQUAL(parameterDerivative.size(), expectedParameterDerivative.size());
+			BOOST_CHECK_SMALL(norm_inf(parameterDerivative-expectedParameterDerivative),1.e-10);
+			BOOST_CHECK_SMALL(max(abs(inputDerivative-expectedInputDerivative)),1.e-10);
+		}
+	}
+}
 BOOST_AUTO_TEST_CASE( CONCATENATED_MODEL_SERIALIZE )
 {
 	Softmax net1(10);
@@ -0,0 +1,166 @@
+#define BOOST_TEST_MODULE Models_ConvolutionalLayer
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include "derivativeTestHelper.h"
+
+#include <shark/Models/ConvolutionalLayer.h>
+#include <shark/Models/PoolingLayer.h>
+#include <shark/Models/ConcatenatedModel.h>
+
+#include <shark/Rng/GlobalRng.h>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Models_ConvolutionalLayer)
+
+//check that the sizes are correct and eval matches a naive convolution
+BOOST_AUTO_TEST_CASE( ConvolutionalLayer_Eval )
+{
+	std::size_t channels = 2;
+	std::size_t height = 5;
+	std::size_t width = 4;
+	std::size_t filters = 3;
+	std::size_t filterHeight = 3;
+	std::size_t filterWidth = 2;
+
+	ConvolutionalLayer<LinearNeuron> layer;
+	layer.setStructure(channels,height,width,filters,filterHeight,filterWidth);
+	BOOST_REQUIRE_EQUAL(layer.inputSize(), channels*height*width);
+	BOOST_REQUIRE_EQUAL(layer.outputHeight(), height-filterHeight+1);
+	BOOST_REQUIRE_EQUAL(layer.outputWidth(), width-filterWidth+1);
+	BOOST_REQUIRE_EQUAL(layer.outputSize(), filters*layer.outputHeight()*layer.outputWidth());
+	BOOST_REQUIRE_EQUAL(layer.numberOfParameters(), filters*channels*filterHeight*filterWidth+filters);
+
+	RealVector parameters(layer.numberOfParameters());
+	for(double& p: parameters)
+		p = Rng::gauss(0,1);
+	layer.setParameterVector(parameters);
+
+	RealMatrix inputs(3,layer.inputSize());
+	for(std::size_t i = 0; i != inputs.size1(); ++i){
+		for(std::size_t j = 0; j != inputs.size2(); ++j){
+			inputs(i,j) = Rng::gauss(0,1);
+		}
+	}
+	RealMatrix outputs = layer(inputs);
+	BOOST_REQUIRE_EQUAL(outputs.size1(), inputs.size1());
+	BOOST_REQUIRE_EQUAL(outputs.size2(), layer.outputSize());
+
+	//compare against a naive convolution
+	for(std::size_t p = 0; p != inputs.size1(); ++p){
+		for(std::size_t f = 0; f != filters; ++f){
+			for(std::size_t y = 0; y != layer.outputHeight(); ++y){
+				for(std::size_t x = 0; x != layer.outputWidth(); ++x){
+					double sum = layer.bias()(f);
+					for(std::size_t c = 0; c != channels; ++c){
+						for(std::size_t i = 0; i != filterHeight; ++i){
+							for(std::size_t j = 0; j != filterWidth; ++j){
+								double weight = layer.filters()(f,(c*filterHeight+i)*filterWidth+j);
+								double pixel = inputs(p,(c*height+y+i)*width+x+j);
+								sum += weight*pixel;
+							}
+						}
+					}
+					std::size_t o = (f*layer.outputHeight()+y)*layer.outputWidth()+x;
+					BOOST_CHECK_SMALL(outputs(p,o)-sum, 1.e-12);
+				}
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( ConvolutionalLayer_Derivatives )
+{
+	ConvolutionalLayer<TanhNeuron> layer;
+	layer.setStructure(2,4,4,3,2,2);
+	testWeightedDerivative(layer,100);
+	testWeightedInputDerivative(layer,100);
+}
+
+//max and average pooling match a naive implementation
+BOOST_AUTO_TEST_CASE( PoolingLayer_Eval )
+{
+	std::size_t channels = 2;
+	std::size_t height = 4;
+	std::size_t width = 6;
+
+	PoolingLayer maxPool;
+	maxPool.setStructure(channels,height,width,2,3,PoolingLayer::Maximum);
+	PoolingLayer avgPool;
+	avgPool.setStructure(channels,height,width,2,3,PoolingLayer::Average);
+	BOOST_REQUIRE_EQUAL(maxPool.outputSize(), channels*2*2);
+	BOOST_REQUIRE_EQUAL(maxPool.numberOfParameters(), 0u);
+
+	RealMatrix inputs(5,maxPool.inputSize());
+	for(std::size_t i = 0; i != inputs.size1(); ++i){
+		for(std::size_t j = 0; j != inputs.size2(); ++j){
+			inputs(i,j) = Rng::gauss(0,1);
+		}
+	}
+	RealMatrix maxOutputs = maxPool(inputs);
+	RealMatrix avgOutputs = avgPool(inputs);
+	for(std::size_t p = 0; p != inputs.size1(); ++p){
+		for(std::size_t c = 0; c != channels; ++c){
+			for(std::size_t y = 0; y != 2u; ++y){
+				for(std::size_t x = 0; x != 2u; ++x){
+					double maximum = -1.e100;
+					double sum = 0.0;
+					for(std::size_t i = 0; i != 2u; ++i){
+						for(std::size_t j = 0; j != 3u; ++j){
+							double pixel = inputs(p,(c*height+2*y+i)*width+3*x+j);
+							maximum = std::max(maximum,pixel);
+							sum += pixel;
+						}
+					}
+					std::size_t o = (c*2+y)*2+x;
+					BOOST_CHECK_EQUAL(maxOutputs(p,o), maximum);
+					BOOST_CHECK_SMALL(avgOutputs(p,o)-sum/6.0, 1.e-12);
+				}
+			}
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE( PoolingLayer_Derivatives )
+{
+	PoolingLayer maxPool;
+	maxPool.setStructure(2,4,4,2,2,PoolingLayer::Maximum);
+	testWeightedInputDerivative(maxPool,100);
+
+	PoolingLayer avgPool;
+	avgPool.setStructure(2,4,4,2,2,PoolingLayer::Average);
+	testWeightedInputDerivative(avgPool,100);
+}
+
+//the layers can be stacked with the ConcatenatedModel
+BOOST_AUTO_TEST_CASE( ConvolutionalLayer_Concatenated )
+{
+	ConvolutionalLayer<TanhNeuron> conv;
+	conv.setStructure(1,5,5,2,2,2);
+	PoolingLayer pool;
+	pool.setStructure(2,4,4,2,2,PoolingLayer::Maximum);
+	ConcatenatedModel<RealVector,RealVector> network = conv>>pool;
+
+	RealVector parameters(network.numberOfParameters());
+	for(double& p: parameters)
+		p = Rng::gauss(0,1);
+	network.setParameterVector(parameters);
+
+	RealMatrix inputs(3,conv.inputSize());
+	for(std::size_t i = 0; i != inputs.size1(); ++i){
+		for(std::size_t j = 0; j != inputs.size2(); ++j){
+			inputs(i,j) = Rng::gauss(0,1);
+		}
+	}
+	RealMatrix outputs = network(inputs);
+	RealMatrix expected = pool(conv(inputs));
+	BOOST_REQUIRE_EQUAL(outputs.size1(), 3u);
+	BOOST_REQUIRE_EQUAL(outputs.size2(), pool.outputSize());
+	for(std::size_t i = 0; i != outputs.size1(); ++i){
+		for(std::size_t j = 0; j != outputs.size2(); ++j){
+			BOOST_CHECK_SMALL(outputs(i,j)-expected(i,j), 1.e-12);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -114,4 +114,34 @@ BOOST_AUTO_TEST_CASE( KernelHelpers_calculateKernelMatrixParameterDerivative ){
 		BOOST_CHECK_CLOSE(kernelGradient(0),result(0),1.e-12);
 	}
 }
+BOOST_AUTO_TEST_CASE( KernelHelpers_calculateKernelMatrixParameterDerivativeSampled ){
+	RealMatrix weights(datasetSize,datasetSize);
+	for(std::size_t i = 0; i != datasetSize; ++i){
+		for(std::size_t  j = 0; j <= i; ++j){
+			weights(j,i) = weights(i,j)=Rng::uni(1,2);
+		}
+	};
+	RealVector exact = calculateKernelMatrixParameterDerivative(kernel,data,weights);
+	BOOST_REQUIRE_EQUAL(exact.size(),1u);
+
+	//a dataset fitting into a single batch has only one tile, so the sampled
+	//estimate is exact no matter which fraction is requested
+	std::vector<RealVector> points;
+	for(std::size_t i = 0; i != datasetSize; ++i)
+		points.push_back(data.element(i));
+	Data<RealVector> singleBatch = createDataFromRange(points,datasetSize);
+	RealVector exactSingle = calculateKernelMatrixParameterDerivative(kernel,singleBatch,weights);
+	RealVector sampledSingle = calculateKernelMatrixParameterDerivativeSampled(kernel,singleBatch,weights,0.01);
+	BOOST_CHECK_CLOSE(sampledSingle(0),exactSingle(0),1.e-10);
+
+	//the estimator is unbiased, so the average over many independent draws
+	//converges to the exact derivative
+	double mean = 0;
+	std::size_t trials = 300;
+	for(std::size_t trial = 0; trial != trials; ++trial){
+		mean += calculateKernelMatrixParameterDerivativeSampled(kernel,data,weights,0.2)(0);
+	}
+	mean /= trials;
+	BOOST_CHECK_CLOSE(mean,exact(0),5);
+}
 BOOST_AUTO_TEST_SUITE_END()
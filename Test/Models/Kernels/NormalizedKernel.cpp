@@ -55,4 +55,53 @@ BOOST_AUTO_TEST_CASE( NormalizedKernel_GaussianRbf_Test )
 	testKernelDerivative(kernel, 2, 1e-7, 1e-4);
 	testKernelInputDerivative(kernel, 2, 1e-7, 1e-2);
 }
+
+BOOST_AUTO_TEST_CASE( NormalizedKernel_Batch_Cache_Test )
+{
+	PolynomialKernel<> baseKernel(2,1,false);
+	DenseNormalizedKernel kernel(&baseKernel);
+
+	std::size_t sizeX1 = 10;
+	std::size_t sizeX2 = 7;
+	std::size_t dim = 3;
+	RealMatrix batchX1(sizeX1,dim);
+	RealMatrix batchX2(sizeX2,dim);
+	for(std::size_t i = 0; i != sizeX1; ++i)
+		for(std::size_t d = 0; d != dim; ++d)
+			batchX1(i,d) = Rng::gauss(0,1);
+	for(std::size_t j = 0; j != sizeX2; ++j)
+		for(std::size_t d = 0; d != dim; ++d)
+			batchX2(j,d) = Rng::gauss(0,1);
+
+	//batch evaluation must agree with the single element evaluation
+	RealMatrix batchResult;
+	kernel.eval(batchX1,batchX2,batchResult);
+	for(std::size_t i = 0; i != sizeX1; ++i){
+		for(std::size_t j = 0; j != sizeX2; ++j){
+			double single = kernel.eval(row(batchX1,i),row(batchX2,j));
+			BOOST_CHECK_SMALL(batchResult(i,j) - single,1.e-13);
+		}
+	}
+
+	//with an enabled diagonal cache repeated evaluations must stay exact
+	kernel.setCacheSize(100);
+	RealMatrix cachedResult;
+	kernel.eval(batchX1,batchX2,cachedResult);//fills the cache
+	kernel.eval(batchX1,batchX2,cachedResult);//served from the cache
+	for(std::size_t i = 0; i != sizeX1; ++i)
+		for(std::size_t j = 0; j != sizeX2; ++j)
+			BOOST_CHECK_SMALL(cachedResult(i,j) - batchResult(i,j),1.e-15);
+
+	//changing the parameters must invalidate the cached diagonals
+	RealVector parameters(1);
+	parameters(0) = 2.0;
+	kernel.setParameterVector(parameters);
+	kernel.eval(batchX1,batchX2,cachedResult);
+	for(std::size_t i = 0; i != sizeX1; ++i){
+		for(std::size_t j = 0; j != sizeX2; ++j){
+			double single = kernel.eval(row(batchX1,i),row(batchX2,j));
+			BOOST_CHECK_SMALL(cachedResult(i,j) - single,1.e-13);
+		}
+	}
+}
 BOOST_AUTO_TEST_SUITE_END()
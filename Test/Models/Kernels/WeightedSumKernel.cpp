@@ -570,4 +570,58 @@ BOOST_AUTO_TEST_CASE( DenseWeightedSumKernel_Test_Detailed_NoDegreeParam_Unconst
 //  testKernelInputDerivative(kernel, 2, 1.e-8);
 //}
 
+BOOST_AUTO_TEST_CASE( DenseWeightedSumKernel_Test_Cache )
+{
+	DenseRbfKernel baseKernel1(0.1);
+	DenseLinearKernel baseKernel2;
+	std::vector<AbstractKernelFunction<RealVector>* > kernels;
+	kernels.push_back(&baseKernel1);
+	kernels.push_back(&baseKernel2);
+	DenseWeightedSumKernel kernel(kernels);
+
+	RealMatrix batchX1(5, 3);
+	RealMatrix batchX2(4, 3);
+	for (std::size_t i=0; i<5; i++)
+		for (std::size_t j=0; j<3; j++) batchX1(i,j) = Rng::gauss();
+	for (std::size_t i=0; i<4; i++)
+		for (std::size_t j=0; j<3; j++) batchX2(i,j) = Rng::gauss();
+
+	kernel.setCacheSize(1000);
+
+	//first evaluation fills the cache, second one recombines from it
+	RealMatrix resultDirect;
+	RealMatrix resultCached;
+	kernel.eval(batchX1, batchX2, resultDirect);
+	kernel.eval(batchX1, batchX2, resultCached);
+	for (std::size_t i=0; i<5; i++)
+		for (std::size_t j=0; j<4; j++)
+			BOOST_CHECK_SMALL(resultCached(i,j) - resultDirect(i,j), 1e-15);
+
+	//a weight update must be reflected by the recombined result
+	RealVector params(1);
+	params(0) = std::log(3.0);
+	kernel.setParameterVector(params);
+	kernel.eval(batchX1, batchX2, resultCached);
+	kernel.setCacheSize(0);
+	kernel.eval(batchX1, batchX2, resultDirect);
+	for (std::size_t i=0; i<5; i++)
+		for (std::size_t j=0; j<4; j++)
+			BOOST_CHECK_SMALL(resultCached(i,j) - resultDirect(i,j), 1e-15);
+
+	//changing the parameters of an adaptive sub-kernel clears the cache
+	kernel.setCacheSize(1000);
+	kernel.setAdaptive(0, true);
+	kernel.eval(batchX1, batchX2, resultCached);
+	RealVector adaptiveParams(2);
+	adaptiveParams(0) = std::log(3.0);
+	adaptiveParams(1) = 0.5;
+	kernel.setParameterVector(adaptiveParams);
+	kernel.eval(batchX1, batchX2, resultCached);
+	kernel.setCacheSize(0);
+	kernel.eval(batchX1, batchX2, resultDirect);
+	for (std::size_t i=0; i<5; i++)
+		for (std::size_t j=0; j<4; j++)
+			BOOST_CHECK_SMALL(resultCached(i,j) - resultDirect(i,j), 1e-15);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,79 @@
+#define BOOST_TEST_MODULE Models_Neurons
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/Rng/GlobalRng.h>
+#include <shark/Models/Neurons.h>
+#include <shark/Models/FFNet.h>
+
+#include <cmath>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Models_Neurons)
+
+//the fast approximations must be close to the exact functions over the whole range
+BOOST_AUTO_TEST_CASE( Neurons_FastTanh_Accuracy )
+{
+	FastTanhNeuron fastTanh;
+	FastLogisticNeuron fastLogistic;
+	for(double x = -12.0; x <= 12.0; x += 1.e-3){
+		BOOST_CHECK_SMALL(fastTanh.function(x) - std::tanh(x), 1.e-6);
+		BOOST_CHECK_SMALL(fastLogistic.function(x) - sigmoid(x), 1.e-6);
+	}
+	//the responses stay inside the range of the exact functions
+	BOOST_CHECK(std::abs(fastTanh.function(1000.0)) <= 1.0);
+	BOOST_CHECK(fastLogistic.function(1000.0) <= 1.0);
+	BOOST_CHECK(fastLogistic.function(-1000.0) >= 0.0);
+}
+
+//applying the neuron to a batch is the same as applying it elementwise
+BOOST_AUTO_TEST_CASE( Neurons_FastTanh_Batch )
+{
+	FastTanhNeuron fastTanh;
+	RealMatrix batch(10,5);
+	for(std::size_t i = 0; i != batch.size1(); ++i){
+		for(std::size_t j = 0; j != batch.size2(); ++j){
+			batch(i,j) = Rng::gauss(0,4);
+		}
+	}
+	RealMatrix response = fastTanh(batch);
+	RealMatrix responseDerivative = fastTanh.derivative(response);
+	for(std::size_t i = 0; i != batch.size1(); ++i){
+		for(std::size_t j = 0; j != batch.size2(); ++j){
+			BOOST_CHECK_EQUAL(response(i,j), fastTanh.function(batch(i,j)));
+			BOOST_CHECK_EQUAL(responseDerivative(i,j), fastTanh.functionDerivative(response(i,j)));
+		}
+	}
+}
+
+//a network using the fast neurons computes nearly the same outputs as with the exact ones
+BOOST_AUTO_TEST_CASE( Neurons_FastTanh_FFNet )
+{
+	FFNet<TanhNeuron,LinearNeuron> net;
+	FFNet<FastTanhNeuron,LinearNeuron> fastNet;
+	net.setStructure(2,5,3);
+	fastNet.setStructure(2,5,3);
+
+	RealVector parameters(net.numberOfParameters());
+	for(double& p: parameters)
+		p = Rng::gauss(0,1);
+	net.setParameterVector(parameters);
+	fastNet.setParameterVector(parameters);
+
+	RealMatrix inputs(20,2);
+	for(std::size_t i = 0; i != inputs.size1(); ++i){
+		for(std::size_t j = 0; j != inputs.size2(); ++j){
+			inputs(i,j) = Rng::gauss(0,2);
+		}
+	}
+	RealMatrix outputs = net(inputs);
+	RealMatrix fastOutputs = fastNet(inputs);
+	for(std::size_t i = 0; i != outputs.size1(); ++i){
+		for(std::size_t j = 0; j != outputs.size2(); ++j){
+			BOOST_CHECK_SMALL(outputs(i,j) - fastOutputs(i,j), 1.e-5);
+		}
+	}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
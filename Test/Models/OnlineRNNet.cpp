@@ -156,8 +156,49 @@ BOOST_AUTO_TEST_CASE( ONLINE_RNNET_WEIGHTED_PARAMETER_DERIVATIVE ){
 		}
 		std::cout<<"est: "<<testDerivative<<"\n calc:"<<derivative<<std::endl;
 		//check wether the derivatives are identical
-		BOOST_CHECK_SMALL(::shark::distance(derivative,testDerivative),epsilon);
+		BOOST_CHECK_SMALL(blas::distance(derivative,testDerivative),epsilon);
 	}
 
 }
+//for a network with a single neuron the diagonal sensitivity mode is exact,
+//so its gradients must match the full RTRL recursion step by step
+BOOST_AUTO_TEST_CASE( ONLINE_RNNET_DIAGONAL_SENSITIVITIES ){
+	//1 input, 1 bias, 1 output neuron with a self-recurrent connection
+	IntMatrix conn(1,3);
+	conn(0,0)=1;//input
+	conn(0,1)=1;//bias
+	conn(0,2)=1;//self
+	RecurrentStructure netStructFull;
+	netStructFull.setStructure(1,1,conn);
+	RecurrentStructure netStructDiagonal;
+	netStructDiagonal.setStructure(1,1,conn);
+	OnlineRNNet netFull(&netStructFull);
+	OnlineRNNet netDiagonal(&netStructDiagonal);
+	netDiagonal.setSensitivityMode(OnlineRNNet::DIAGONAL_SENSITIVITIES);
+	BOOST_REQUIRE_EQUAL(netFull.numberOfParameters(),3u);
+
+	RealVector parameters(3);
+	for(size_t i=0;i!=3;++i){
+		parameters(i)= Rng::gauss(0,1);
+	}
+	netFull.setParameterVector(parameters);
+	netDiagonal.setParameterVector(parameters);
+
+	RealMatrix coefficients(1,1);
+	coefficients(0,0) = 1;
+
+	const size_t T=10;
+	for(size_t t=0;t != T; ++t){
+		RealMatrix input(1,1);
+		input(0,0) = Rng::uni(-1,1);
+		RealVector derivativeFull;
+		RealVector derivativeDiagonal;
+		netFull(input);
+		netDiagonal(input);
+		netFull.weightedParameterDerivative(input,coefficients,derivativeFull);
+		netDiagonal.weightedParameterDerivative(input,coefficients,derivativeDiagonal);
+		BOOST_REQUIRE_EQUAL(derivativeDiagonal.size(),3u);
+		BOOST_CHECK_SMALL(blas::distance(derivativeDiagonal,derivativeFull),1.e-12);
+	}
+}
 BOOST_AUTO_TEST_SUITE_END()
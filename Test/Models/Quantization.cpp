@@ -0,0 +1,116 @@
+#include <shark/Models/Quantization.h>
+#define BOOST_TEST_MODULE Models_Quantization
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <sstream>
+
+using namespace std;
+using namespace boost::archive;
+using namespace shark;
+
+namespace{
+//create a batch of patterns with entries in [-range,range]
+Data<RealVector> createPatterns(std::size_t numPatterns, std::size_t dims, double range){
+	std::vector<RealVector> patterns(numPatterns, RealVector(dims));
+	for(std::size_t i = 0; i != numPatterns; ++i){
+		for(std::size_t j = 0; j != dims; ++j)
+			patterns[i](j) = Rng::uni(-range,range);
+	}
+	return createDataFromRange(patterns,32);
+}
+}
+
+BOOST_AUTO_TEST_SUITE (Models_Quantization)
+
+BOOST_AUTO_TEST_CASE( Models_Quantization_LinearModel )
+{
+	std::size_t inputs = 10;
+	std::size_t outputs = 3;
+	LinearModel<> model(inputs,outputs,true);
+	RealVector parameters(model.numberOfParameters());
+	for(std::size_t i = 0; i != parameters.size(); ++i)
+		parameters(i) = Rng::uni(-1,1);
+	model.setParameterVector(parameters);
+
+	Data<RealVector> calibration = createPatterns(200,inputs,2.0);
+	QuantizedLinearModel quantized(model,calibration);
+	BOOST_CHECK_EQUAL(quantized.inputSize(), inputs);
+	BOOST_CHECK_EQUAL(quantized.outputSize(), outputs);
+	BOOST_CHECK_EQUAL(quantized.numberOfParameters(), 0u);
+
+	//the quantized predictions must approximate the originals up to the
+	//quantization error. with weights in [-1,1] and inputs in [-2,2] every
+	//product contributes at most maxW*dx+maxX*dw ~ 1/127*(2+2) to the error
+	double errorBound = inputs*4.0/127;
+	Data<RealVector> test = createPatterns(500,inputs,2.0);
+	Data<RealVector> truth = model(test);
+	Data<RealVector> approximation = quantized(test);
+	for(std::size_t i = 0; i != test.numberOfElements(); ++i){
+		for(std::size_t o = 0; o != outputs; ++o)
+			BOOST_CHECK_SMALL(approximation.element(i)(o)-truth.element(i)(o), errorBound);
+	}
+
+	//serialization round trip preserves the predictions exactly
+	ostringstream outputStream;
+	TextOutArchive oa(outputStream);
+	quantized.write(oa);
+	QuantizedLinearModel restored;
+	istringstream inputStream(outputStream.str());
+	TextInArchive ia(inputStream);
+	restored.read(ia);
+	Data<RealVector> restoredOutput = restored(test);
+	for(std::size_t i = 0; i != test.numberOfElements(); ++i){
+		for(std::size_t o = 0; o != outputs; ++o)
+			BOOST_CHECK_EQUAL(restoredOutput.element(i)(o), approximation.element(i)(o));
+	}
+}
+
+BOOST_AUTO_TEST_CASE( Models_Quantization_FFNet )
+{
+	std::size_t inputs = 4;
+	std::size_t outputs = 2;
+	FFNet<LogisticNeuron,LinearNeuron> network;
+	network.setStructure(inputs,8,outputs);
+	RealVector parameters(network.numberOfParameters());
+	for(std::size_t i = 0; i != parameters.size(); ++i)
+		parameters(i) = Rng::uni(-1,1);
+	network.setParameterVector(parameters);
+
+	Data<RealVector> calibration = createPatterns(200,inputs,1.0);
+	QuantizedFFNet<LogisticNeuron,LinearNeuron> quantized(network,calibration);
+	BOOST_CHECK_EQUAL(quantized.inputSize(), inputs);
+	BOOST_CHECK_EQUAL(quantized.outputSize(), outputs);
+	BOOST_CHECK_EQUAL(quantized.numberOfParameters(), 0u);
+
+	//per layer the error behaves as in the linear case; the logistic
+	//activation does not amplify it, so a loose additive bound suffices
+	double errorBound = 0.5;
+	Data<RealVector> test = createPatterns(500,inputs,1.0);
+	Data<RealVector> truth = network(test);
+	Data<RealVector> approximation = quantized(test);
+	for(std::size_t i = 0; i != test.numberOfElements(); ++i){
+		for(std::size_t o = 0; o != outputs; ++o)
+			BOOST_CHECK_SMALL(approximation.element(i)(o)-truth.element(i)(o), errorBound);
+	}
+	//the approximation must track the network, not only stay inside the bound
+	double meanError = 0;
+	double meanResponse = 0;
+	for(std::size_t i = 0; i != test.numberOfElements(); ++i){
+		for(std::size_t o = 0; o != outputs; ++o){
+			meanError += std::abs(approximation.element(i)(o)-truth.element(i)(o));
+			meanResponse += std::abs(truth.element(i)(o));
+		}
+	}
+	BOOST_CHECK_SMALL(meanError, 0.1*meanResponse);
+
+	//networks with shortcuts can not be quantized
+	FFNet<LogisticNeuron,LinearNeuron> shortcutNetwork;
+	shortcutNetwork.setStructure(inputs,8,8,outputs,FFNetStructures::InputOutputShortcut);
+	BOOST_CHECK_THROW(
+		(QuantizedFFNet<LogisticNeuron,LinearNeuron>(shortcutNetwork,calibration)),
+		Exception
+	);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -212,6 +212,141 @@ BOOST_AUTO_TEST_CASE( RNNET_WEIGHTED_PARAMETER_DERIVATIVE ){
 
 }
 
+BOOST_AUTO_TEST_CASE( RNNET_TRUNCATED_WEIGHTED_PARAMETER_DERIVATIVE ){
+	const size_t T=6;
+
+	RecurrentStructure netStruct;
+	netStruct.setStructure(2,4,2);
+	RNNet net(&netStruct);
+	BOOST_REQUIRE_EQUAL(net.numberOfParameters(),numberOfParameters);
+
+	//initialize parameters
+	RealVector parameters(numberOfParameters);
+	for(size_t i=0;i!=numberOfParameters;++i){
+		parameters(i)= Rng::gauss(0,1);
+	}
+	net.setParameterVector(parameters);
+
+	//define sequence
+	Sequence testInputs(T,RealVector(2));
+	for (size_t t = 0; t < T; t++){
+		for(size_t j=0;j!=2;++j){
+			testInputs[t](j) = Rng::gauss(0,1);
+		}
+	}
+	std::vector<Sequence> testInputBatch(1,testInputs);
+	std::vector<Sequence> testOutputBatch;
+	boost::shared_ptr<State> state = net.createState();
+	net.eval(testInputBatch,testOutputBatch,*state);
+
+	//define coefficients
+	Sequence coefficients(T,RealVector(2));
+	for (size_t t = 0; t < T; t++){
+		for(size_t j=0;j!=2;++j){
+			coefficients[t](j) = Rng::gauss(0,1);
+		}
+	}
+	std::vector<Sequence> coefficientsBatch(1,coefficients);
+
+	//full backpropagation through time as reference
+	RealVector derivativeFull;
+	net.weightedParameterDerivative(testInputBatch,coefficientsBatch,*state,derivativeFull);
+	BOOST_REQUIRE_EQUAL(derivativeFull.size(),numberOfParameters);
+
+	//a window covering the whole sequence must reproduce the full derivative exactly
+	net.setTruncatedSteps(2*T);
+	BOOST_CHECK_EQUAL(net.truncatedSteps(),2*T);
+	RealVector derivativeWindow;
+	net.weightedParameterDerivative(testInputBatch,coefficientsBatch,*state,derivativeWindow);
+	BOOST_CHECK_SMALL(blas::distance(derivativeFull,derivativeWindow),1.e-12);
+
+	//when all recurrent weights (connections from neurons to neurons) are zero,
+	//no error is propagated between time steps, so truncation must not change
+	//the gradient either
+	size_t numUnits = 9;//2 inputs + bias + 6 neurons
+	RealVector feedForwardParameters = parameters;
+	for(size_t i=0;i!=6;++i)
+		for(size_t j=3;j!=numUnits;++j)
+			feedForwardParameters(i*numUnits+j) = 0;
+	net.setParameterVector(feedForwardParameters);
+	net.eval(testInputBatch,testOutputBatch,*state);
+
+	net.setTruncatedSteps(0);
+	net.weightedParameterDerivative(testInputBatch,coefficientsBatch,*state,derivativeFull);
+	net.setTruncatedSteps(2);
+	net.weightedParameterDerivative(testInputBatch,coefficientsBatch,*state,derivativeWindow);
+	BOOST_CHECK_SMALL(blas::distance(derivativeFull,derivativeWindow),1.e-12);
+}
+
+//the sparse computation mode multiplies with the packed weights of the
+//existing connections only; on the same topology it must reproduce the
+//dense kernels exactly
+BOOST_AUTO_TEST_CASE( RNNET_SPARSE_COMPUTATION_MODE ){
+	const size_t T=5;
+
+	//a sparse topology: the hidden neurons see the inputs and their
+	//predecessor, the outputs see the hidden neurons and the bias
+	int sparseConnections[4][7]=
+	{
+		{1,1,1,0,0,0,0},//hidden 1
+		{1,1,0,1,0,0,0},//hidden 2
+		{0,0,1,1,1,0,1},//output 1
+		{0,0,1,0,1,1,0} //output 2
+	};
+	IntMatrix conn(4,7);
+	for (size_t i = 0; i < 4; i++){
+		for (size_t j = 0; j < 7; j++){
+			conn(i,j)=sparseConnections[i][j];
+		}
+	}
+	RecurrentStructure netStructDense;
+	netStructDense.setStructure(2,2,conn);
+	RecurrentStructure netStructSparse;
+	netStructSparse.setStructure(2,2,conn);
+	netStructSparse.setSparseComputationMode(true);
+	RNNet netDense(&netStructDense);
+	RNNet netSparse(&netStructSparse);
+	BOOST_REQUIRE_EQUAL(netDense.numberOfParameters(),netSparse.numberOfParameters());
+
+	RealVector parameters(netDense.numberOfParameters());
+	for(size_t i=0;i!=parameters.size();++i){
+		parameters(i)= Rng::gauss(0,1);
+	}
+	netDense.setParameterVector(parameters);
+	netSparse.setParameterVector(parameters);
+
+	//define sequence and coefficients
+	Sequence testInputs(T,RealVector(2));
+	Sequence coefficients(T,RealVector(2));
+	for (size_t t = 0; t < T; t++){
+		for(size_t j=0;j!=2;++j){
+			testInputs[t](j) = Rng::uni(-1,1);
+			coefficients[t](j) = Rng::gauss(0,1);
+		}
+	}
+	std::vector<Sequence> testInputBatch(1,testInputs);
+	std::vector<Sequence> coefficientsBatch(1,coefficients);
+
+	//evaluate both networks and compare the outputs
+	std::vector<Sequence> outputsDense;
+	std::vector<Sequence> outputsSparse;
+	boost::shared_ptr<State> stateDense = netDense.createState();
+	boost::shared_ptr<State> stateSparse = netSparse.createState();
+	netDense.eval(testInputBatch,outputsDense,*stateDense);
+	netSparse.eval(testInputBatch,outputsSparse,*stateSparse);
+	for(size_t t=0;t!=T;++t){
+		BOOST_CHECK_SMALL(norm_2(outputsDense[0][t]-outputsSparse[0][t]),1.e-14);
+	}
+
+	//and the derivatives
+	RealVector derivativeDense;
+	RealVector derivativeSparse;
+	netDense.weightedParameterDerivative(testInputBatch,coefficientsBatch,*stateDense,derivativeDense);
+	netSparse.weightedParameterDerivative(testInputBatch,coefficientsBatch,*stateSparse,derivativeSparse);
+	BOOST_REQUIRE_EQUAL(derivativeSparse.size(),derivativeDense.size());
+	BOOST_CHECK_SMALL(blas::distance(derivativeDense,derivativeSparse),1.e-14);
+}
+
 //~ BOOST_AUTO_TEST_CASE( RNNET_SERIALIZATION_TEST)
 //~ {
 	//~ std::stringstream str;
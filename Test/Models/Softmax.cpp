@@ -67,6 +67,28 @@ BOOST_AUTO_TEST_CASE( Softmax_Value_Single )
 	BOOST_CHECK_SMALL(difference,1.e-15);
 }
 
+//with the max-shift, large activations must not overflow to nan
+BOOST_AUTO_TEST_CASE( Softmax_Value_Stability )
+{
+	Softmax model(3);
+	RealVector point(3);
+	point(0)=1000;
+	point(1)=999;
+	point(2)=-1000;
+	RealVector result=model(point);
+	BOOST_CHECK_SMALL(sum(result)-1.0,1.e-15);
+	BOOST_CHECK_SMALL(result(0)-1.0/(1.0+std::exp(-1.0)),1.e-15);
+	BOOST_CHECK_SMALL(result(1)-std::exp(-1.0)/(1.0+std::exp(-1.0)),1.e-15);
+	BOOST_CHECK_SMALL(result(2),1.e-15);
+
+	Softmax modelSingle(1);
+	RealVector pointSingle(1);
+	pointSingle(0)=1000;
+	RealVector resultSingle=modelSingle(pointSingle);
+	BOOST_CHECK_SMALL(resultSingle(0)-1.0,1.e-15);
+	BOOST_CHECK_SMALL(resultSingle(1),1.e-15);
+}
+
 BOOST_AUTO_TEST_CASE( Softmax_weightedParameterDerivative )
 {
 	Softmax model(2);
@@ -32,6 +32,8 @@
  */
 
 #include <shark/ObjectiveFunctions/NegativeAUC.h>
+#include <shark/ObjectiveFunctions/ROC.h>
+#include <shark/Rng/GlobalRng.h>
 
 #define BOOST_TEST_MODULE OBJECTIVEFUNCTIONS_AUC
 #include <boost/test/unit_test.hpp>
@@ -67,4 +69,59 @@ BOOST_AUTO_TEST_CASE( AUC_EVAL ) {
         //BOOST_CHECK((valueResult == 1.));
 }
 
+BOOST_AUTO_TEST_CASE( ROC_CURVE ) {
+	Data<RealVector> prediction(10,RealVector(1));
+	Data<unsigned int> label(10,0);
+
+	double values[10] = { .9, 8, .7, .6, .55, .54, .53, .52, .51, .505 };
+	unsigned int labels[10] = {1, 1, 0, 1, 1, 1, 0, 0, 1, 0};
+
+	for(std::size_t i=0; i<10; i++) {
+		prediction.element(i)(0)= values[i];
+		label.element(i) = labels[i];
+	}
+
+	RocCurve curve(prediction, label);
+	BOOST_CHECK_SMALL(curve.auc() - 0.75, 1.e-13);
+
+	//the curve starts at (0,0), ends at (1,1) and all scores are distinct
+	BOOST_CHECK_EQUAL(curve.falsePositiveRates().size(), 11u);
+	BOOST_CHECK_SMALL(curve.falsePositiveRates()(0), 1.e-13);
+	BOOST_CHECK_SMALL(curve.truePositiveRates()(0), 1.e-13);
+	BOOST_CHECK_SMALL(curve.falsePositiveRates()(10) - 1.0, 1.e-13);
+	BOOST_CHECK_SMALL(curve.truePositiveRates()(10) - 1.0, 1.e-13);
+
+	//the partial area up to fpr=1 is the full area
+	BOOST_CHECK_SMALL(curve.partialAuc(1.0) - 0.75, 1.e-13);
+	BOOST_CHECK_SMALL(curve.partialAuc(0.0), 1.e-13);
+}
+
+BOOST_AUTO_TEST_CASE( ROC_CURVE_TIES ) {
+	//all examples share one score: the curve is the diagonal with area 1/2
+	Data<RealVector> prediction(10,RealVector(1,0.5));
+	Data<unsigned int> label(10,0);
+	for(std::size_t i=0; i<10; i++)
+		label.element(i) = i%2;
+
+	RocCurve curve(prediction, label);
+	BOOST_CHECK_EQUAL(curve.falsePositiveRates().size(), 2u);
+	BOOST_CHECK_SMALL(curve.auc() - 0.5, 1.e-13);
+	BOOST_CHECK_SMALL(curve.partialAuc(0.4) - 0.08, 1.e-13);
+}
+
+BOOST_AUTO_TEST_CASE( ROC_CURVE_AGREES_WITH_NEGATIVE_AUC ) {
+	//random scores with many ties so that the tie handling is exercised
+	std::size_t elements = 3000;
+	Data<RealVector> prediction(elements,RealVector(1));
+	Data<unsigned int> label(elements,0);
+	for(std::size_t i=0; i<elements; i++) {
+		prediction.element(i)(0) = Rng::discrete(0,99)/100.0;
+		label.element(i) = (unsigned int)Rng::coinToss();
+	}
+
+	NegativeAUC<unsigned int, RealVector> auc;
+	RocCurve curve(prediction, label);
+	BOOST_CHECK_SMALL(curve.auc() + auc.eval(label, prediction), 1.e-12);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
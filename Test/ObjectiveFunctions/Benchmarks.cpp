@@ -53,6 +53,44 @@ BOOST_AUTO_TEST_CASE( Rosenbrock_Derivative )
 		shark::testDerivative(rosenbrock, point,1.e-7,1.e-7,0.005);
 	}
 }
+//the batch evaluation must return the same values as evaluating point by point
+template<class Function>
+void testEvalBatch(Function& f){
+	const std::size_t batchSize = 20;
+	std::vector<shark::RealVector> batch(batchSize);
+	for(std::size_t i = 0; i != batchSize; ++i){
+		batch[i] = f.proposeStartingPoint();
+	}
+	std::size_t evaluations = f.evaluationCounter();
+	std::vector<double> values;
+	f.evalBatch(batch,values);
+	BOOST_REQUIRE_EQUAL(values.size(), batchSize);
+	BOOST_CHECK_EQUAL(f.evaluationCounter(), evaluations + batchSize);
+	for(std::size_t i = 0; i != batchSize; ++i){
+		BOOST_CHECK_EQUAL(values[i], f.eval(batch[i]));
+	}
+}
+
+BOOST_AUTO_TEST_CASE( Benchmarks_EvalBatch )
+{
+	const std::size_t dimensions = 5;
+	shark::Sphere sphere(dimensions);
+	testEvalBatch(sphere);
+	shark::Rosenbrock rosenbrock(dimensions);
+	testEvalBatch(rosenbrock);
+	shark::Ackley ackley(dimensions);
+	testEvalBatch(ackley);
+	shark::Cigar cigar(dimensions);
+	testEvalBatch(cigar);
+	shark::Discus discus(dimensions);
+	testEvalBatch(discus);
+	shark::Ellipsoid ellipsoid(dimensions);
+	testEvalBatch(ellipsoid);
+	//functions without an own batch implementation use the default loop
+	shark::DiffPowers diffPowers(dimensions);
+	testEvalBatch(diffPowers);
+}
+
 BOOST_AUTO_TEST_CASE( Ellipsoid_Derivative )
 {
 	const std::size_t dimensions = 5;
@@ -88,6 +88,18 @@ BOOST_AUTO_TEST_CASE( ObjectiveFunctions_CrossValidation )
 	std::cout << "CV-error: " << cve << "    (should be 5/3 = 1.66666...)" << std::endl;
 
 	BOOST_CHECK_LT(std::abs(cve - 5.0 / 3.0), 1e-12);
+
+	// the same procedure with parallel fold training must give the
+	// same result; the trainer clones act as their own meta objects
+	LinearRegression foldTrainer0, foldTrainer1, foldTrainer2;
+	std::vector<IParameterizable*> foldMetas;
+	std::vector<AbstractTrainer<LinearModel<>, RealVector>*> foldTrainers;
+	foldMetas.push_back(&foldTrainer0); foldTrainers.push_back(&foldTrainer0);
+	foldMetas.push_back(&foldTrainer1); foldTrainers.push_back(&foldTrainer1);
+	foldMetas.push_back(&foldTrainer2); foldTrainers.push_back(&foldTrainer2);
+	cvError.enableParallelFolds(foldMetas, foldTrainers);
+	double cveParallel = cvError.eval(param);
+	BOOST_CHECK_LT(std::abs(cveParallel - cve), 1e-12);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
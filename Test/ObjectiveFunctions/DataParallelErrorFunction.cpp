@@ -0,0 +1,129 @@
+#define BOOST_TEST_MODULE ObjectiveFunctions_DataParallelErrorFunction
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/ObjectiveFunctions/DataParallelErrorFunction.h>
+#include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
+#include <shark/ObjectiveFunctions/Regularizer.h>
+#include <shark/Models/LinearModel.h>
+#include <shark/Rng/GlobalRng.h>
+
+using namespace shark;
+
+/// simulates the group by adding the precomputed packed buffers of the other
+/// workers. the packed layout puts weight and value first, so an eval call
+/// with a shorter buffer just adds the leading entries of every partial
+class FixedPartialsReducer : public AbstractGradientReducer{
+public:
+	std::vector<RealVector> partials;
+
+	std::string name() const
+	{ return "FixedPartialsReducer"; }
+
+	void allSum(double* buffer, std::size_t length) const{
+		for(std::size_t p = 0; p != partials.size(); ++p){
+			for(std::size_t i = 0; i != length; ++i)
+				buffer[i] += partials[p](i);
+		}
+	}
+
+	std::size_t numberOfWorkers() const{
+		return partials.size()+1;
+	}
+};
+
+struct DataParallelFixture{
+	DataParallelFixture() : numPoints(90), dims(3){
+		std::vector<RealVector> inputs(numPoints, RealVector(dims));
+		std::vector<RealVector> labels(numPoints, RealVector(1));
+		for(std::size_t i = 0; i != numPoints; ++i){
+			for(std::size_t j = 0; j != dims; ++j)
+				inputs[i](j) = Rng::uni(-1,1);
+			labels[i](0) = Rng::gauss();
+		}
+		fullData = createLabeledDataFromRange(inputs,labels,10);
+		//three shards of different sizes
+		std::size_t bounds[4] = {0, 20, 50, 90};
+		for(std::size_t s = 0; s != 3; ++s){
+			std::vector<RealVector> shardInputs(inputs.begin()+bounds[s],inputs.begin()+bounds[s+1]);
+			std::vector<RealVector> shardLabels(labels.begin()+bounds[s],labels.begin()+bounds[s+1]);
+			shards[s] = createLabeledDataFromRange(shardInputs,shardLabels,10);
+		}
+
+		model.setStructure(dims,1,true);
+		point.resize(model.numberOfParameters());
+		for(std::size_t i = 0; i != point.size(); ++i)
+			point(i) = Rng::uni(-1,1);
+	}
+
+	std::size_t numPoints;
+	std::size_t dims;
+	RegressionDataset fullData;
+	RegressionDataset shards[3];
+	LinearModel<> model;
+	SquaredLoss<> loss;
+	RealVector point;
+};
+
+BOOST_FIXTURE_TEST_SUITE (ObjectiveFunctions_DataParallelErrorFunction, DataParallelFixture)
+
+//with a single worker the function must match a plain ErrorFunction exactly
+BOOST_AUTO_TEST_CASE( ObjectiveFunctions_DataParallelErrorFunction_SingleWorker ){
+	LocalGradientReducer reducer;
+	DataParallelErrorFunction parallelError(fullData,&model,&loss,&reducer);
+	ErrorFunction error(fullData,&model,&loss);
+
+	BOOST_CHECK_CLOSE(parallelError.eval(point),error.eval(point),1.e-10);
+
+	RealVector derivative;
+	RealVector parallelDerivative;
+	double value = error.evalDerivative(point,derivative);
+	double parallelValue = parallelError.evalDerivative(point,parallelDerivative);
+	BOOST_CHECK_CLOSE(parallelValue,value,1.e-10);
+	BOOST_REQUIRE_EQUAL(parallelDerivative.size(),derivative.size());
+	for(std::size_t i = 0; i != derivative.size(); ++i)
+		BOOST_CHECK_SMALL(parallelDerivative(i)-derivative(i),1.e-12);
+}
+
+//a worker holding the first shard, combined with the packed partial sums of
+//the other two shards, must see the error and gradient of the full dataset
+BOOST_AUTO_TEST_CASE( ObjectiveFunctions_DataParallelErrorFunction_ThreeWorkers ){
+	FixedPartialsReducer reducer;
+	for(std::size_t s = 1; s != 3; ++s){
+		ErrorFunction shardError(shards[s],&model,&loss);
+		RealVector shardDerivative;
+		double shardValue = shardError.evalDerivative(point,shardDerivative);
+		double weight = (double)shards[s].numberOfElements();
+		RealVector partial(shardDerivative.size()+2);
+		partial(0) = weight;
+		partial(1) = weight*shardValue;
+		noalias(subrange(partial,2,partial.size())) = weight*shardDerivative;
+		reducer.partials.push_back(partial);
+	}
+	BOOST_REQUIRE_EQUAL(reducer.numberOfWorkers(),3u);
+
+	DataParallelErrorFunction parallelError(shards[0],&model,&loss,&reducer);
+	ErrorFunction error(fullData,&model,&loss);
+
+	BOOST_CHECK_CLOSE(parallelError.eval(point),error.eval(point),1.e-10);
+
+	RealVector derivative;
+	RealVector parallelDerivative;
+	double value = error.evalDerivative(point,derivative);
+	double parallelValue = parallelError.evalDerivative(point,parallelDerivative);
+	BOOST_CHECK_CLOSE(parallelValue,value,1.e-10);
+	for(std::size_t i = 0; i != derivative.size(); ++i)
+		BOOST_CHECK_SMALL(parallelDerivative(i)-derivative(i),1.e-12);
+
+	//the regularizer is added after the reduction and thus enters only once
+	TwoNormRegularizer regularizer;
+	parallelError.setRegularizer(0.1,&regularizer);
+	error.setRegularizer(0.1,&regularizer);
+	value = error.evalDerivative(point,derivative);
+	parallelValue = parallelError.evalDerivative(point,parallelDerivative);
+	BOOST_CHECK_CLOSE(parallelValue,value,1.e-10);
+	for(std::size_t i = 0; i != derivative.size(); ++i)
+		BOOST_CHECK_SMALL(parallelDerivative(i)-derivative(i),1.e-12);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
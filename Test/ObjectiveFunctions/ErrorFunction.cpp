@@ -1,5 +1,6 @@
 #include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
 #include <shark/ObjectiveFunctions/ErrorFunction.h>
+#include <shark/ObjectiveFunctions/Regularizer.h>
 #include <shark/Algorithms/Trainers/LinearRegression.h>
 #include <shark/Algorithms/GradientDescent/Rprop.h>
 #include <shark/Statistics/Distributions/MultiVariateNormalDistribution.h>
@@ -216,6 +217,129 @@ BOOST_AUTO_TEST_CASE( ObjFunct_ErrorFunction_LinearRegression ){
 	}	
 }
 
+//in minibatch mode every batch must be visited exactly once per epoch,
+//so averaging the minibatch estimates over an epoch recovers the
+//full-batch error and gradient when all batches have the same size.
+BOOST_AUTO_TEST_CASE( ObjFunct_ErrorFunction_Minibatch )
+{
+	Wave problem;
+	RegressionDataset dataset = problem.generateDataset(100,10);//10 batches of size 10
+	std::size_t numBatches = dataset.numberOfBatches();
+
+	LinearModel<> model;
+	model.setStructure(1,1,true);
+	SquaredLoss<> loss;
+	ErrorFunction fullError(dataset, &model, &loss);
+	ErrorFunction minibatchError(dataset, &model, &loss, 1);
+	RealVector point(2,0.0);
+
+	ErrorFunction::FirstOrderDerivative fullDerivative;
+	double full = fullError.evalDerivative(point,fullDerivative);
+
+	double epochError = 0.0;
+	RealVector epochDerivative(2,0.0);
+	for(std::size_t i = 0; i != numBatches; ++i){
+		ErrorFunction::FirstOrderDerivative derivative;
+		epochError += minibatchError.evalDerivative(point,derivative);
+		noalias(epochDerivative) += derivative;
+	}
+	epochError /= numBatches;
+	epochDerivative /= numBatches;
+
+	BOOST_CHECK_CLOSE(full, epochError, 1.e-11);
+	BOOST_CHECK_SMALL(norm_sqr(fullDerivative - epochDerivative), 1.e-20);
+
+	//eval must agree with evalDerivative over an epoch as well
+	double epochEval = 0.0;
+	for(std::size_t i = 0; i != numBatches; ++i){
+		epochEval += minibatchError.eval(point);
+	}
+	epochEval /= numBatches;
+	BOOST_CHECK_CLOSE(full, epochEval, 1.e-11);
+}
+
+//in minibatch mode the gradient is also offered as index/value pairs.
+//features which are identically zero over the batch contribute exactly
+//zero gradient entries and must not appear in the sparse form.
+BOOST_AUTO_TEST_CASE( ObjFunct_ErrorFunction_SparseDerivative )
+{
+	std::size_t examples = 30;
+	std::size_t dims = 6;
+	std::vector<RealVector> inputs(examples, RealVector(dims,0.0));
+	std::vector<RealVector> labels(examples, RealVector(1));
+	for(std::size_t i = 0; i != examples; ++i){
+		for(std::size_t j = 0; j != dims; ++j){
+			if(j == 1 || j == 3) continue;//structurally zero features
+			inputs[i](j) = Rng::gauss();
+		}
+		labels[i](0) = Rng::gauss();
+	}
+	RegressionDataset dataset = createLabeledDataFromRange(inputs, labels, examples);//one batch
+
+	LinearModel<> model;
+	model.setStructure(dims,1,false);
+	SquaredLoss<> loss;
+	ErrorFunction minibatchError(dataset, &model, &loss, 1);
+	BOOST_REQUIRE(minibatchError.hasSparseFirstDerivative());
+
+	RealVector point(dims);
+	for(std::size_t j = 0; j != dims; ++j)
+		point(j) = Rng::gauss();
+
+	ErrorFunction::FirstOrderDerivative dense;
+	double valueDense = minibatchError.evalDerivative(point,dense);
+	ErrorFunction::SparseFirstOrderDerivative sparse;
+	double valueSparse = minibatchError.evalSparseDerivative(point,sparse);
+	BOOST_CHECK_CLOSE(valueDense, valueSparse, 1.e-12);
+
+	//reconstructing the dense gradient from the pairs must be exact
+	RealVector reconstructed(dims,0.0);
+	for(std::size_t k = 0; k != sparse.indices.size(); ++k){
+		BOOST_CHECK(sparse.indices[k] != 1 && sparse.indices[k] != 3);
+		reconstructed(sparse.indices[k]) = sparse.values[k];
+	}
+	BOOST_CHECK_EQUAL(norm_inf(dense - reconstructed), 0.0);
+
+	//a regularizer makes the gradient dense again
+	TwoNormRegularizer regularizer;
+	minibatchError.setRegularizer(0.1, &regularizer);
+	BOOST_CHECK(!minibatchError.hasSparseFirstDerivative());
+}
+
+BOOST_AUTO_TEST_CASE( ObjFunct_ErrorFunction_ForwardCache )
+{
+	Wave problem;
+	RegressionDataset dataset = problem.generateDataset(100,10);
+
+	LinearModel<> model;
+	model.setStructure(1,1,true);
+	SquaredLoss<> loss;
+	ErrorFunction error(dataset, &model, &loss);
+
+	RealVector point1(2); point1(0) = 0.5; point1(1) = -0.2;
+	RealVector point2(2); point2(0) = -1.0; point2(1) = 0.7;
+
+	//reference values from the uncached fused path
+	ErrorFunction::FirstOrderDerivative derivative1, derivative2;
+	double value1 = error.evalDerivative(point1,derivative1);
+	double value2 = error.evalDerivative(point2,derivative2);
+
+	//eval followed by evalDerivative at the same point reuses the cached
+	//forward pass and must reproduce the reference results exactly
+	BOOST_CHECK_EQUAL(error.eval(point1), value1);
+	ErrorFunction::FirstOrderDerivative cachedDerivative;
+	BOOST_CHECK_EQUAL(error.evalDerivative(point1,cachedDerivative), value1);
+	BOOST_CHECK_SMALL(norm_sqr(cachedDerivative - derivative1), 1.e-25);
+
+	//a derivative at a different point must not pick up the stale cache
+	BOOST_CHECK_EQUAL(error.evalDerivative(point2,cachedDerivative), value2);
+	BOOST_CHECK_SMALL(norm_sqr(cachedDerivative - derivative2), 1.e-25);
+
+	//the cache stays valid for its point even after evaluations elsewhere
+	BOOST_CHECK_EQUAL(error.evalDerivative(point1,cachedDerivative), value1);
+	BOOST_CHECK_SMALL(norm_sqr(cachedDerivative - derivative1), 1.e-25);
+}
+
 BOOST_AUTO_TEST_CASE( ObjFunct_WeightedErrorFunction_LinearRegression )
 {
 	WeightedLabeledData<RealVector,RealVector> weightedData;
@@ -0,0 +1,85 @@
+#define BOOST_TEST_MODULE ObjectiveFunctions_EvaluationArchive
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <shark/ObjectiveFunctions/EvaluationArchive.h>
+#include <shark/ObjectiveFunctions/Benchmarks/Sphere.h>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (ObjectiveFunctions_EvaluationArchive)
+
+//evaluating a stored point must return the cached result without
+//calling the wrapped objective function again
+BOOST_AUTO_TEST_CASE( EvaluationArchive_Memoization )
+{
+	Sphere sphere(3);
+	EvaluationArchive<RealVector, double> archive(&sphere);
+
+	std::vector<RealVector> points(10);
+	std::vector<double> values(10);
+	for(std::size_t i = 0; i != 10; ++i){
+		points[i] = sphere.proposeStartingPoint();
+		values[i] = archive(points[i]);
+	}
+	BOOST_CHECK_EQUAL(archive.size(), 10u);
+	BOOST_CHECK_EQUAL(sphere.evaluationCounter(), 10u);
+
+	//re-evaluation hits the cache
+	for(std::size_t i = 0; i != 10; ++i){
+		BOOST_CHECK_EQUAL(archive(points[i]), values[i]);
+	}
+	BOOST_CHECK_EQUAL(archive.size(), 10u);
+	BOOST_CHECK_EQUAL(sphere.evaluationCounter(), 10u);
+}
+
+//with a capacity set, the least recently used pairs are dropped
+BOOST_AUTO_TEST_CASE( EvaluationArchive_Capacity )
+{
+	Sphere sphere(3);
+	EvaluationArchive<RealVector, double> archive(&sphere);
+	archive.setCapacity(5);
+
+	std::vector<RealVector> points(10);
+	for(std::size_t i = 0; i != 10; ++i){
+		points[i] = sphere.proposeStartingPoint();
+		archive(points[i]);
+	}
+	BOOST_CHECK_EQUAL(archive.size(), 5u);
+	BOOST_CHECK_EQUAL(sphere.evaluationCounter(), 10u);
+
+	//the oldest points were dropped and are evaluated again
+	for(std::size_t i = 0; i != 5; ++i){
+		archive(points[i]);
+	}
+	BOOST_CHECK_EQUAL(archive.size(), 5u);
+	BOOST_CHECK_EQUAL(sphere.evaluationCounter(), 15u);
+
+	//the newest points are still cached
+	for(std::size_t i = 0; i != 5; ++i){
+		archive(points[i]);
+	}
+	BOOST_CHECK_EQUAL(sphere.evaluationCounter(), 15u);
+
+	//shrinking the capacity drops all but the most recently used pairs
+	archive.setCapacity(2);
+	BOOST_CHECK_EQUAL(archive.size(), 2u);
+}
+
+//the archive can be iterated like before
+BOOST_AUTO_TEST_CASE( EvaluationArchive_Iteration )
+{
+	Sphere sphere(3);
+	EvaluationArchive<RealVector, double> archive(&sphere);
+	for(std::size_t i = 0; i != 10; ++i){
+		archive(sphere.proposeStartingPoint());
+	}
+	std::size_t numPairs = 0;
+	for(auto it = archive.begin(); it != archive.end(); ++it){
+		BOOST_CHECK_EQUAL(sphere.eval(it->point), it->result);
+		++numPairs;
+	}
+	BOOST_CHECK_EQUAL(numPairs, archive.size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
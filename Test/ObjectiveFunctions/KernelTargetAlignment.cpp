@@ -233,6 +233,32 @@ BOOST_AUTO_TEST_CASE( ObjectiveFunctions_KernelTargetAlignment_evalDerivative_Ga
 	
 }
 
+//sampled derivatives must be unbiased estimates of the exact derivative,
+//the value of the alignment itself stays exact in sampled mode
+BOOST_AUTO_TEST_CASE( ObjectiveFunctions_KernelTargetAlignment_sampledDerivative )
+{
+	GaussianRbfKernel<> kernel(1);
+	KernelTargetAlignment<> kta(data,&kernel);
+	KernelTargetAlignment<> ktaSampled(data,&kernel);
+	ktaSampled.setDerivativeSamplingFraction(0.3);
+
+	RealVector input(1);
+	input(0) = 0.5;
+	RealVector derivative;
+	double value = kta.evalDerivative(input,derivative);
+
+	double meanDerivative = 0;
+	std::size_t trials = 200;
+	for(std::size_t trial = 0; trial != trials; ++trial){
+		RealVector sampled;
+		double sampledValue = ktaSampled.evalDerivative(input,sampled);
+		BOOST_CHECK_CLOSE(sampledValue,value,1.e-10);
+		meanDerivative += sampled(0);
+	}
+	meanDerivative /= trials;
+	BOOST_CHECK_SMALL(meanDerivative-derivative(0),0.1*std::abs(derivative(0))+0.01);
+}
+
 BOOST_AUTO_TEST_CASE( ObjectiveFunctions_KernelTargetAlignment_evalDerivative_GaussKernel_Regression )
 {
 	GaussianRbfKernel<> kernel(1);
@@ -84,4 +84,51 @@ BOOST_AUTO_TEST_CASE( ML_NoisyErrorFunction )
 	BOOST_CHECK_SMALL(error, 1.e-15);
 }
 
+BOOST_AUTO_TEST_CASE( ML_NoisyErrorFunction_AdaptiveSampling )
+{
+	Rng::seed(42);
+	//create noisy regression data from the testfunction
+	TestFunction function;
+	std::vector<RealVector> data;
+	std::vector<RealVector> target;
+	RealVector input(3);
+	RealVector output(1);
+	for (size_t i=0; i<1000; i++)
+	{
+		for(size_t j=0;j!=3;++j)
+		{
+			input(j)=Rng::uni(-1,1);
+		}
+		data.push_back(input);
+		output(0)=function.eval(input) + Rng::gauss(0,0.01);
+		target.push_back(output);
+	}
+	RegressionDataset dataset = createLabeledDataFromRange(data,target);
+
+	SquaredLoss<> loss;
+	LinearModel<> model(3);
+	NoisyErrorFunction error(dataset,&model,&loss);
+	error.setAdaptiveSampling(10,1000,0.05);
+	error.setCommonRandomNumbers(true);
+
+	RealVector good = function.weights;
+	RealVector bad = good;
+	bad(0) += 0.3;
+
+	//with common random numbers repeated evaluations of a point are deterministic
+	double value = error.eval(good);
+	BOOST_CHECK_EQUAL(error.eval(good), value);
+
+	//and the better point must win every comparison, as both points
+	//are evaluated on the same sample
+	for(std::size_t trial = 0; trial != 20; ++trial){
+		error.resample();
+		BOOST_CHECK(error.eval(good) < error.eval(bad));
+	}
+
+	//resample draws a fresh sample, so the estimate changes
+	error.resample();
+	BOOST_CHECK(error.eval(good) != value);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1,4 +1,5 @@
 #include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
+#include <shark/Models/LinearModel.h>
 #include <shark/Rng/GlobalRng.h>
 #include "TestLoss.h"
 
@@ -79,6 +80,56 @@ BOOST_AUTO_TEST_CASE( SQUAREDLOSS_EVAL_Classification ) {
 	}
 }
 
+BOOST_AUTO_TEST_CASE( SQUAREDLOSS_EVAL_Weighted ) {
+	unsigned int maxTests = 1000;
+	for (unsigned int test = 0; test != maxTests; ++test) {
+		SquaredLoss<> loss;
+		SquaredLoss<RealVector,unsigned int> lossDisc;
+
+		//sample a batch of points, labels and weights
+		std::size_t batchSize = 10;
+		RealMatrix testPoints(batchSize,3);
+		RealMatrix testLabels(batchSize,3,0.0);
+		UIntVector testLabelsDisc(batchSize);
+		RealVector weights(batchSize);
+		for(std::size_t i = 0; i != batchSize; ++i){
+			for(std::size_t j = 0; j != 3; ++j){
+				testPoints(i,j) = Rng::uni(-10.0,10.0);
+			}
+			testLabelsDisc(i) = (unsigned int)Rng::discrete(0,2);
+			testLabels(i,testLabelsDisc(i)) = 1;
+			weights(i) = (i%3 == 0)? 0.0: Rng::uni(0.0,2.0);
+		}
+
+		//the test results: weighted sums of per-element evaluations
+		double valueResult = 0;
+		RealMatrix derivativeResult(batchSize,3);
+		for(std::size_t i = 0; i != batchSize; ++i){
+			RealMatrix point = subrange(testPoints,i,i+1,0,3);
+			RealMatrix label = subrange(testLabels,i,i+1,0,3);
+			RealMatrix singleDerivative;
+			valueResult += weights(i) * loss.evalDerivative(label, point, singleDerivative);
+			noalias(row(derivativeResult,i)) = weights(i) * row(singleDerivative,0);
+		}
+
+		//test the fused weighted evaluations
+		double value = loss.evalWeighted(testLabels,testPoints,weights);
+		BOOST_CHECK_SMALL(value-valueResult, 1.e-12);
+		RealMatrix derivative;
+		value = loss.evalDerivativeWeighted(testLabels, testPoints, weights, derivative);
+		BOOST_CHECK_SMALL(value-valueResult, 1.e-12);
+		BOOST_CHECK_SMALL(max(abs(derivative - derivativeResult)), 1.e-12);
+
+		//the classification specialization must agree with the one-hot encoding
+		value = lossDisc.evalWeighted(testLabelsDisc,testPoints,weights);
+		BOOST_CHECK_SMALL(value-valueResult, 1.e-12);
+		RealMatrix derivativeDisc;
+		value = lossDisc.evalDerivativeWeighted(testLabelsDisc, testPoints, weights, derivativeDisc);
+		BOOST_CHECK_SMALL(value-valueResult, 1.e-12);
+		BOOST_CHECK_SMALL(max(abs(derivativeDisc - derivativeResult)), 1.e-12);
+	}
+}
+
 BOOST_AUTO_TEST_CASE( SQUAREDLOSS_EVAL_Sequence ) {
 	unsigned int maxTests = 100;
 	unsigned int dims = 10;
@@ -140,8 +191,59 @@ BOOST_AUTO_TEST_CASE( SQUAREDLOSS_EVAL_Sequence ) {
 				}
 			}
 		}
-		
+
+	}
+}
+
+BOOST_AUTO_TEST_CASE( SQUAREDLOSS_EVAL_Sampled ) {
+	std::size_t numPoints = 20000;
+	SquaredLoss<> loss;
+
+	std::vector<RealVector> labels(numPoints, RealVector(1));
+	std::vector<RealVector> predictions(numPoints, RealVector(1));
+	for (std::size_t i = 0; i != numPoints; ++i) {
+		labels[i](0) = Rng::uni(-1.0,1.0);
+		predictions[i](0) = labels[i](0) + Rng::gauss(0,1);
+	}
+	Data<RealVector> labelData = createDataFromRange(labels,100);
+	Data<RealVector> predictionData = createDataFromRange(predictions,100);
+
+	double full = loss.eval(labelData,predictionData);
+	//with a precision that cannot be reached all batches are consumed
+	BOOST_CHECK_CLOSE(loss.evalSampled(labelData,predictionData,1.e-10), full, 1.e-10);
+	//a loose precision yields an estimate within the requested interval
+	//(with a generous safety margin for the 5% of failing intervals)
+	double estimate = loss.evalSampled(labelData,predictionData,0.2);
+	BOOST_CHECK_SMALL(estimate - full, 0.6);
+}
+
+BOOST_AUTO_TEST_CASE( SQUAREDLOSS_EVAL_Streaming ) {
+	//the streaming loss-of-a-model evaluation must match the two-stage
+	//predict-then-reduce path while never materializing the predictions
+	std::size_t numPoints = 1000;
+	std::size_t dims = 3;
+	SquaredLoss<> loss;
+
+	std::vector<RealVector> inputs(numPoints, RealVector(dims));
+	std::vector<RealVector> labels(numPoints, RealVector(1));
+	for (std::size_t i = 0; i != numPoints; ++i) {
+		for (std::size_t j = 0; j != dims; ++j)
+			inputs[i](j) = Rng::uni(-1.0,1.0);
+		labels[i](0) = Rng::gauss();
 	}
+	Data<RealVector> inputData = createDataFromRange(inputs,100);
+	Data<RealVector> labelData = createDataFromRange(labels,100);
+
+	LinearModel<> model;
+	model.setStructure(dims,1,true);
+	RealVector parameters(model.numberOfParameters());
+	for (std::size_t i = 0; i != parameters.size(); ++i)
+		parameters(i) = Rng::gauss();
+	model.setParameterVector(parameters);
+
+	double materialized = loss.eval(labelData, model(inputData));
+	double streamed = loss.eval(labelData, inputData, model);
+	BOOST_CHECK_CLOSE(materialized, streamed, 1.e-12);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -91,6 +91,21 @@ BOOST_AUTO_TEST_CASE( Energy_Partition_HiddenGreaterVisible )
 	}
 }
 
+BOOST_AUTO_TEST_CASE( Energy_AnnealedImportanceSampling_Adaptive )
+{
+	//create RBM with 4 visible and 2 hidden units and initialize it randomly
+	RBM<BinaryLayer,BinaryLayer,Rng::rng_type > rbm(Rng::globalRng);
+	rbm.setStructure(4,2);
+	initRandomNormal(rbm,1);
+
+	//for such a small RBM the partition function can be computed exactly.
+	//AIS estimates the free energy difference to the reference distribution at beta=0,
+	//so the exact difference is logZ(1)-logZ(0) and the adaptive estimate has to get close to it
+	double deltaF = logPartitionFunction(rbm)-logPartitionFunction(rbm,0.0);
+	double deltaFAIS = annealedImportanceSampling(rbm,30,100,0.05,20000);
+	BOOST_CHECK_SMALL(deltaF - deltaFAIS, 0.5);
+}
+
 BOOST_AUTO_TEST_CASE( Energy_NegLogLikelihood )
 {
 	
@@ -0,0 +1,125 @@
+#include <shark/Rng/Philox.h>
+#include <shark/Rng/Uniform.h>
+#include <shark/Rng/Normal.h>
+#include <shark/LinAlg/Base.h>
+
+#define BOOST_TEST_MODULE Rng_Philox
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <sstream>
+
+using namespace shark;
+
+BOOST_AUTO_TEST_SUITE (Rng_Philox)
+
+BOOST_AUTO_TEST_CASE( Philox_Deterministic ){
+	//engines with the same seed and stream generate the same sequence
+	Philox4x32 rng1(42,0);
+	Philox4x32 rng2(42,0);
+	for(std::size_t i = 0; i != 1000; ++i){
+		BOOST_CHECK_EQUAL(rng1(),rng2());
+	}
+	//reseeding restarts the sequence
+	Philox4x32 rng3(42,0);
+	rng1.seed(42);
+	for(std::size_t i = 0; i != 1000; ++i){
+		BOOST_CHECK_EQUAL(rng1(),rng3());
+	}
+}
+
+BOOST_AUTO_TEST_CASE( Philox_Streams ){
+	//engines split off with different stream numbers generate different sequences
+	Philox4x32 rng(42,0);
+	Philox4x32 split1 = rng.split(1);
+	Philox4x32 split2 = rng.split(2);
+	BOOST_CHECK_EQUAL(split1.stream(), 1u);
+	BOOST_CHECK_EQUAL(split2.stream(), 2u);
+
+	std::size_t collisions = 0;
+	for(std::size_t i = 0; i != 1000; ++i){
+		Philox4x32::result_type v0 = rng();
+		Philox4x32::result_type v1 = split1();
+		Philox4x32::result_type v2 = split2();
+		collisions += (v0 == v1) + (v0 == v2) + (v1 == v2);
+	}
+	//random 32 bit values collide with probability 2^-32 per pair
+	BOOST_CHECK_LE(collisions, 1u);
+}
+
+BOOST_AUTO_TEST_CASE( Philox_Distributions ){
+	//the engine models the boost rng concept and plugs into the shark distributions
+	Philox4x32 rng(42);
+	Uniform<Philox4x32> uni(rng,0,1);
+	Normal<Philox4x32> normal(rng,0,1);
+
+	std::size_t trials = 100000;
+	double uniMean = 0;
+	double normalMean = 0;
+	double normalVariance = 0;
+	for(std::size_t i = 0; i != trials; ++i){
+		uniMean += uni()/trials;
+		double n = normal();
+		normalMean += n/trials;
+		normalVariance += n*n/trials;
+	}
+	normalVariance -= normalMean*normalMean;
+	BOOST_CHECK_SMALL(uniMean-0.5, 0.01);
+	BOOST_CHECK_SMALL(normalMean, 0.01);
+	BOOST_CHECK_CLOSE(normalVariance, 1.0, 2.0);
+}
+
+BOOST_AUTO_TEST_CASE( Philox_GenerateUniform ){
+	Philox4x32 rng(42);
+	RealVector values(100000);
+	rng.generateUniform(values);
+
+	double mean = 0;
+	for(std::size_t i = 0; i != values.size(); ++i){
+		BOOST_CHECK(values(i) >= 0.0);
+		BOOST_CHECK(values(i) < 1.0);
+		mean += values(i)/values.size();
+	}
+	BOOST_CHECK_SMALL(mean-0.5, 0.01);
+
+	//bulk generation draws from the same stream as single number generation
+	Philox4x32 rngBulk(7,3);
+	Philox4x32 rngSingle(7,3);
+	RealVector bulk(100);
+	rngBulk.generateUniform(bulk);
+	for(std::size_t i = 0; i != bulk.size(); ++i){
+		boost::uint64_t bits = rngSingle();
+		bits = (bits << 32) | rngSingle();
+		BOOST_CHECK_EQUAL(bulk(i), (bits >> 11) * (1.0/9007199254740992.0));
+	}
+}
+
+BOOST_AUTO_TEST_CASE( Philox_Serialization ){
+	Philox4x32 rng(42,5);
+	//consume a few numbers so that the state includes a partial block
+	for(std::size_t i = 0; i != 7; ++i) rng();
+
+	std::stringstream stream;
+	stream << rng;
+	Philox4x32 restored;
+	stream >> restored;
+	BOOST_CHECK(rng == restored);
+	for(std::size_t i = 0; i != 1000; ++i){
+		BOOST_CHECK_EQUAL(rng(),restored());
+	}
+}
+
+BOOST_AUTO_TEST_CASE( Philox_ThreadRng ){
+	Philox4x32::seedThreadRngs(42);
+	Philox4x32& rng1 = Philox4x32::threadRng();
+	Philox4x32& rng2 = Philox4x32::threadRng();
+	//repeated calls from the same thread return the same engine
+	BOOST_CHECK_EQUAL(&rng1, &rng2);
+
+	//reseeding restarts the per-thread stream reproducibly
+	Philox4x32::seedThreadRngs(23);
+	Philox4x32 expected(23,0);
+	BOOST_CHECK_EQUAL(Philox4x32::threadRng()(),expected());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,98 @@
+#include <shark/Rng/ZigguratNormal.h>
+#include <shark/Rng/Philox.h>
+#include <shark/Rng/GlobalRng.h>
+#include <shark/LinAlg/Base.h>
+
+#define BOOST_TEST_MODULE Rng_ZigguratNormal
+#include <boost/test/unit_test.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+
+#include <boost/math/distributions/normal.hpp>
+
+using namespace shark;
+
+//checks empirical mean, variance and a few quantiles of the sampler
+template<class Sampler>
+void checkNormalSampler(Sampler& sampler, double mean, double variance){
+	std::size_t trials = 1000000;
+	double sigma = std::sqrt(variance);
+	//check the mass left of a few cut points against the exact cdf,
+	//this also covers the wedge and tail cases of the ziggurat
+	double cuts[]={-3.0,-1.0,0.0,0.5,2.0,3.5};
+	std::size_t counts[6]={0,0,0,0,0,0};
+
+	double resultMean = 0;
+	double resultVariance = 0;
+	for(std::size_t i = 0; i != trials; ++i){
+		double val = sampler();
+		resultMean += val/trials;
+		resultVariance += val*val/trials;
+		for(std::size_t c = 0; c != 6; ++c){
+			counts[c] += (val < mean+cuts[c]*sigma);
+		}
+	}
+	resultVariance -= resultMean*resultMean;
+
+	BOOST_CHECK_SMALL(resultMean-mean, 0.01*sigma);
+	BOOST_CHECK_CLOSE(resultVariance, variance, 1.);
+
+	boost::math::normal_distribution<> dist;
+	for(std::size_t c = 0; c != 6; ++c){
+		double p = boost::math::cdf(dist,cuts[c]);
+		BOOST_CHECK_SMALL(counts[c]/double(trials)-p, 0.005);
+	}
+}
+
+BOOST_AUTO_TEST_SUITE (Rng_ZigguratNormal)
+
+BOOST_AUTO_TEST_CASE( ZigguratNormal_Distribution ){
+	Rng::seed(42);
+	ZigguratNormal<> standard(Rng::globalRng);
+	checkNormalSampler(standard,0.0,1.0);
+
+	ZigguratNormal<> shifted(Rng::globalRng,2.0,9.0);
+	BOOST_CHECK_CLOSE(shifted.mean(),2.0,1.e-12);
+	BOOST_CHECK_CLOSE(shifted.variance(),9.0,1.e-12);
+	checkNormalSampler(shifted,2.0,9.0);
+}
+
+BOOST_AUTO_TEST_CASE( ZigguratNormal_Philox ){
+	//the sampler works on top of the counter-based engine
+	Philox4x32 rng(42);
+	ZigguratNormal<Philox4x32> normal(rng);
+	checkNormalSampler(normal,0.0,1.0);
+}
+
+BOOST_AUTO_TEST_CASE( ZigguratNormal_Bulk ){
+	Rng::seed(42);
+	ZigguratNormal<> normal(Rng::globalRng,1.0,4.0);
+
+	RealVector values(1000000);
+	normal.generate(values);
+	double mean = 0;
+	double variance = 0;
+	for(std::size_t i = 0; i != values.size(); ++i){
+		mean += values(i)/values.size();
+		variance += sqr(values(i))/values.size();
+	}
+	variance -= mean*mean;
+	BOOST_CHECK_SMALL(mean-1.0, 0.02);
+	BOOST_CHECK_CLOSE(variance, 4.0, 1.);
+
+	RealMatrix matrix(1000,500);
+	normal.generateMatrix(matrix);
+	mean = 0;
+	variance = 0;
+	std::size_t elements = matrix.size1()*matrix.size2();
+	for(std::size_t i = 0; i != matrix.size1(); ++i){
+		for(std::size_t j = 0; j != matrix.size2(); ++j){
+			mean += matrix(i,j)/elements;
+			variance += sqr(matrix(i,j))/elements;
+		}
+	}
+	variance -= mean*mean;
+	BOOST_CHECK_SMALL(mean-1.0, 0.02);
+	BOOST_CHECK_CLOSE(variance, 4.0, 2.);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
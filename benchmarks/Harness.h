@@ -0,0 +1,114 @@
+//===========================================================================
+/*!
+ *
+ * \brief       Shared timing methodology for the micro-benchmarks
+ *
+ * Every benchmark is measured with the same protocol: a number of warmup
+ * runs primes caches and lazy allocations, then the kernel is timed
+ * repeatedly and the minimum and median over all repetitions are
+ * reported. The minimum is the best estimate of the cost of the kernel
+ * itself, the median shows how noisy the machine was. Results are
+ * printed as CSV lines so they can be collected per commit and compared
+ * across hardware generations by scripts.
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_BENCHMARKS_HARNESS_H
+#define SHARK_BENCHMARKS_HARNESS_H
+
+#include <shark/Core/Timer.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace shark {
+namespace benchmarks {
+
+/// \brief Result of timing one benchmark kernel.
+struct Measurement{
+	std::size_t repetitions;
+	double minSeconds;
+	double medianSeconds;
+};
+
+/// \brief Times a kernel with warmup and repeated measurement.
+///
+/// The kernel is run \p warmup times without timing, then \p repetitions
+/// times with timing. Wallclock time is used so that multi-threaded
+/// kernels are measured by elapsed time and not by summed cpu time.
+template<class Kernel>
+Measurement measure(Kernel kernel, std::size_t repetitions = 10, std::size_t warmup = 2){
+	for(std::size_t i = 0; i != warmup; ++i){
+		kernel();
+	}
+	std::vector<double> times(repetitions);
+	for(std::size_t i = 0; i != repetitions; ++i){
+		Timer timer;
+		kernel();
+		times[i] = timer.stop();
+	}
+	std::sort(times.begin(),times.end());
+	Measurement result;
+	result.repetitions = repetitions;
+	result.minSeconds = times.front();
+	result.medianSeconds = times[repetitions/2];
+	return result;
+}
+
+/// \brief Prints the CSV header for the result lines of reportLine().
+inline void reportHeader(){
+	std::cout<<"benchmark,size,repetitions,min_seconds,median_seconds"<<std::endl;
+}
+
+/// \brief Prints one machine-readable result line.
+///
+/// \param name  name of the benchmarked kernel
+/// \param size  problem size parameter the kernel was run with
+/// \param m     timing result as returned by measure()
+inline void reportLine(std::string const& name, std::size_t size, Measurement const& m){
+	std::cout<<name<<","<<size<<","<<m.repetitions<<","<<m.minSeconds<<","<<m.medianSeconds<<std::endl;
+}
+
+/// \brief Parses the problem sizes from the command line.
+///
+/// Every argument is interpreted as one problem size; without arguments
+/// the supplied defaults are used. This keeps all benchmark programs
+/// parameterized the same way.
+inline std::vector<std::size_t> problemSizes(
+	int argc, char** argv, std::vector<std::size_t> const& defaults
+){
+	if(argc < 2) return defaults;
+	std::vector<std::size_t> sizes;
+	for(int i = 1; i < argc; ++i){
+		sizes.push_back(std::strtoul(argv[i],0,10));
+	}
+	return sizes;
+}
+
+}}
+#endif
@@ -0,0 +1,120 @@
+//===========================================================================
+/*!
+ *
+ * \brief       Micro-benchmark for the dense BLAS kernels gemm, gemv and dot
+ *
+ * Calls the kernels directly via blas::kernels so that the timings cover
+ * the kernel dispatch and the (possibly external) binding, but not the
+ * expression template machinery on top. Problem sizes can be given on
+ * the command line, one size per argument.
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#include "Harness.h"
+
+#include <shark/LinAlg/Base.h>
+#include <shark/LinAlg/BLAS/kernels/gemm.hpp>
+#include <shark/LinAlg/BLAS/kernels/gemv.hpp>
+#include <shark/LinAlg/BLAS/kernels/dot.hpp>
+#include <shark/Rng/GlobalRng.h>
+
+using namespace shark;
+using namespace shark::benchmarks;
+
+namespace {
+
+RealMatrix randomMatrix(std::size_t size1, std::size_t size2){
+	RealMatrix matrix(size1,size2);
+	for(std::size_t i = 0; i != size1; ++i){
+		for(std::size_t j = 0; j != size2; ++j){
+			matrix(i,j) = Rng::gauss(0,1);
+		}
+	}
+	return matrix;
+}
+
+struct GemmKernel{
+	RealMatrix A;
+	RealMatrix B;
+	RealMatrix C;
+	GemmKernel(std::size_t size)
+	: A(randomMatrix(size,size))
+	, B(randomMatrix(size,size))
+	, C(size,size,0.0){}
+	void operator()(){
+		blas::kernels::gemm(A,B,C,1.0);
+	}
+};
+
+struct GemvKernel{
+	RealMatrix A;
+	RealVector x;
+	RealVector y;
+	GemvKernel(std::size_t size)
+	: A(randomMatrix(size,size))
+	, x(row(randomMatrix(1,size),0))
+	, y(size,0.0){}
+	void operator()(){
+		blas::kernels::gemv(A,x,y,1.0);
+	}
+};
+
+//a single dot is far below the timer resolution, so a block
+//of calls is timed and the result divided by the block size
+struct DotKernel{
+	static std::size_t const innerIterations = 1000;
+	RealVector x;
+	RealVector y;
+	double result;
+	DotKernel(std::size_t size)
+	: x(row(randomMatrix(1,size),0))
+	, y(row(randomMatrix(1,size),0))
+	, result(0.0){}
+	void operator()(){
+		for(std::size_t i = 0; i != innerIterations; ++i){
+			blas::kernels::dot(x,y,result);
+		}
+	}
+};
+
+Measurement perCall(Measurement m, std::size_t innerIterations){
+	m.minSeconds /= innerIterations;
+	m.medianSeconds /= innerIterations;
+	return m;
+}
+
+}
+
+int main(int argc, char** argv){
+	std::vector<std::size_t> sizes = problemSizes(argc,argv,{128,256,512,1024});
+
+	reportHeader();
+	for(std::size_t size: sizes){
+		reportLine("blas.gemm",size,measure(GemmKernel(size)));
+		reportLine("blas.gemv",size,measure(GemvKernel(size),100));
+		reportLine("blas.dot",size,perCall(measure(DotKernel(size),100),DotKernel::innerIterations));
+	}
+}
@@ -0,0 +1,89 @@
+//===========================================================================
+/*!
+ *
+ * \brief       Micro-benchmark for Dataset batch and element iteration
+ *
+ * Sums over a Data<RealVector> once per batch and once per element.
+ * The difference between the two numbers is the overhead of the
+ * element abstraction on top of the batches; the batch numbers track
+ * the cost of the iteration machinery itself. The problem size is the
+ * number of data points; the input dimension and batch size are fixed.
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#include "Harness.h"
+
+#include <shark/Data/DataDistribution.h>
+#include <shark/Data/Dataset.h>
+
+using namespace shark;
+using namespace shark::benchmarks;
+
+namespace {
+
+std::size_t const benchInputDim = 20;
+std::size_t const batchSize = 256;
+
+//volatile sink so that the summation is not optimized away
+volatile double g_sink = 0.0;
+
+struct BatchIterationKernel{
+	Data<RealVector> data;
+	BatchIterationKernel(Data<RealVector> const& dataset): data(dataset){}
+	void operator()(){
+		double result = 0.0;
+		for(std::size_t b = 0; b != data.numberOfBatches(); ++b){
+			result += sum(data.batch(b));
+		}
+		g_sink = result;
+	}
+};
+
+struct ElementIterationKernel{
+	Data<RealVector> data;
+	ElementIterationKernel(Data<RealVector> const& dataset): data(dataset){}
+	void operator()(){
+		double result = 0.0;
+		for(auto const& element: data.elements()){
+			result += sum(element);
+		}
+		g_sink = result;
+	}
+};
+
+}
+
+int main(int argc, char** argv){
+	std::vector<std::size_t> sizes = problemSizes(argc,argv,{10000,100000,1000000});
+
+	reportHeader();
+	for(std::size_t size: sizes){
+		PamiToy problem(benchInputDim/2,benchInputDim/2);
+		Data<RealVector> data = problem.generateDataset(size,batchSize).inputs();
+		reportLine("dataset.batches",size,measure(BatchIterationKernel(data),20));
+		reportLine("dataset.elements",size,measure(ElementIterationKernel(data),20));
+	}
+}
@@ -0,0 +1,93 @@
+//===========================================================================
+/*!
+ *
+ * \brief       Micro-benchmark for kernel Gram matrix assembly
+ *
+ * Measures row-wise assembly through KernelMatrix::row, which is the
+ * access pattern of the decomposition based QP solvers, as well as
+ * assembly of the full matrix. The problem size is the number of data
+ * points; the input dimension is fixed.
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#include "Harness.h"
+
+#include <shark/Data/DataDistribution.h>
+#include <shark/LinAlg/KernelMatrix.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
+
+using namespace shark;
+using namespace shark::benchmarks;
+
+namespace {
+
+std::size_t const benchInputDim = 20;
+
+struct RowAssemblyKernel{
+	GaussianRbfKernel<> kernel;
+	Data<RealVector> data;
+	KernelMatrix<RealVector,double> matrix;
+	std::vector<double> storage;
+	RowAssemblyKernel(Data<RealVector> const& dataset)
+	: kernel(0.5)
+	, data(dataset)
+	, matrix(kernel,data)
+	, storage(data.numberOfElements()){}
+	void operator()(){
+		for(std::size_t i = 0; i != matrix.size(); ++i){
+			matrix.row(i,0,matrix.size(),&storage[0]);
+		}
+	}
+};
+
+struct FullAssemblyKernel{
+	GaussianRbfKernel<> kernel;
+	Data<RealVector> data;
+	KernelMatrix<RealVector,double> matrix;
+	RealMatrix storage;
+	FullAssemblyKernel(Data<RealVector> const& dataset)
+	: kernel(0.5)
+	, data(dataset)
+	, matrix(kernel,data)
+	, storage(data.numberOfElements(),data.numberOfElements()){}
+	void operator()(){
+		matrix.matrix(storage);
+	}
+};
+
+}
+
+int main(int argc, char** argv){
+	std::vector<std::size_t> sizes = problemSizes(argc,argv,{500,1000,2000});
+
+	reportHeader();
+	for(std::size_t size: sizes){
+		PamiToy problem(benchInputDim/2,benchInputDim/2);
+		Data<RealVector> data = problem.generateDataset(size).inputs();
+		reportLine("kernelmatrix.row",size,measure(RowAssemblyKernel(data),5));
+		reportLine("kernelmatrix.full",size,measure(FullAssemblyKernel(data),5));
+	}
+}
@@ -34,7 +34,9 @@
 #ifndef SHARK_OBJECTIVEFUNCTIONS_ABSTRACTOPTIMIZER_H
 #define SHARK_OBJECTIVEFUNCTIONS_ABSTRACTOPTIMIZER_H
 
+#include <shark/Core/ISerializable.h>
 #include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+#include <iosfwd>
 
 namespace shark {
 
@@ -130,6 +132,31 @@ public:
 	*/
 	virtual SolutionType const& solution() const = 0; //mt_hint: try accessing this thing via solution().point and solution().value..
 
+	/**
+	* \brief Writes a binary checkpoint of the full optimizer state to the supplied stream.
+	*
+	* The snapshot contains everything the solver carries between two calls to step() -
+	* history buffers, covariance matrices, step sizes - written through a binary archive,
+	* so large numeric state is dumped as raw memory instead of being formatted as text.
+	* This makes checkpointing long runs cheap enough to be done every few iterations.
+	*/
+	void saveState( std::ostream & stream ) const{
+		BinaryOutArchive archive( stream );
+		this->write( archive );
+	}
+
+	/**
+	* \brief Restores the optimizer state from a checkpoint written by saveState().
+	*
+	* The restored run continues bit-exactly where the checkpoint was taken:
+	* call step() directly afterwards. Calling init() instead would discard
+	* the restored state and restart the run from scratch.
+	*/
+	void loadState( std::istream & stream ){
+		BinaryInArchive archive( stream );
+		this->read( archive );
+	}
+
 protected:
 	/**
 	* \brief Convenience function that checks whether the features of the supplied objective function match with the required features of the optimizer.
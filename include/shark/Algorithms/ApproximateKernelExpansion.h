@@ -0,0 +1,76 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Approximation of a kernel expansion by a smaller basis.
+ *
+ *
+ *
+ * \author      O.Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_ALGORITHMS_APPROXIMATEKERNELEXPANSION_H
+#define SHARK_ALGORITHMS_APPROXIMATEKERNELEXPANSION_H
+
+#include <shark/Core/DLLSupport.h>
+#include <shark/Models/Kernels/KernelExpansion.h>
+
+namespace shark{
+
+///
+/// \brief Approximates a kernel expansion by a smaller expansion with a synthetic basis.
+///
+/// \par
+/// A trained kernel expansion \f$ w = \sum_i \alpha_i k(x_i, \cdot) \f$ often
+/// uses a large fraction of the training set as basis. This function computes
+/// a new expansion over a user-chosen number of synthetic basis vectors
+/// \f$ z_1,\dots,z_k \f$ which minimizes the squared distance
+/// \f$ \| \sum_j \beta_j k(z_j, \cdot) - w \|^2 \f$ in the kernel-induced
+/// feature space, as measured by the KernelBasisDistance. The basis vectors
+/// are free points in the input space and are found by gradient-based
+/// preimage optimization starting from a random subset of the original basis;
+/// the coefficients \f$ \beta \f$ are the optimal linear combination for the
+/// final basis. The offset term is copied unchanged.
+///
+/// \par
+/// The returned expansion references the same kernel object as the input
+/// model. If the kernel is not differentiable with respect to its inputs,
+/// the basis vectors cannot be optimized and the method returns the best
+/// linear combination of the random initial basis.
+///
+/// \param model            the kernel expansion to approximate
+/// \param numBasisVectors  the number of synthetic basis vectors of the approximation
+/// \param iterations       number of gradient-based optimization steps for the basis
+/// \return                 the approximating kernel expansion
+///
+SHARK_EXPORT_SYMBOL KernelExpansion<RealVector> approximateKernelExpansion(
+	KernelExpansion<RealVector> const& model,
+	std::size_t numBasisVectors,
+	std::size_t iterations = 100
+);
+
+}
+#endif
@@ -194,6 +194,24 @@ public:
 		return m_lambda;
 	}
 
+	/// \brief Returns the number of generations between two refreshs of the eigendecomposition.
+	std::size_t updateFrequency()const{
+		return m_updateFrequency;
+	}
+
+	/// \brief Sets the number of generations between two refreshs of the eigendecomposition.
+	///
+	/// In between, offspring are sampled using the cached factors of the
+	/// covariance matrix, which saves the O(n^3) decomposition per generation
+	/// at the cost of sampling from a slightly outdated distribution. Setting
+	/// it to 0 (the default) lets init choose the standard lazy schedule of
+	/// roughly n/lambda generations; 1 recovers a decomposition every
+	/// generation.
+	void setUpdateFrequency(std::size_t updateFrequency){
+		m_updateFrequency = updateFrequency;
+		m_userSetUpdateFrequency = updateFrequency > 0;
+	}
+
 	/**
 	 * \brief Returns eigenvectors of covariance matrix (not considering step size)
 	 */
@@ -242,6 +260,7 @@ private:
 
 	bool m_userSetMu; /// <The user set a value via setMu, do not overwrite with default
 	bool m_userSetLambda; /// <The user set a value via setMu, do not overwrite with default
+	bool m_userSetUpdateFrequency; /// <The user set a value via setUpdateFrequency, do not overwrite with default
 	double m_initSigma; ///< use provided initial value of sigma<=0 =>algorithm chooses
 
 	RecombinationType m_recombinationType; ///< Stores the recombination type.
@@ -264,6 +283,7 @@ private:
 	RealVector m_evolutionPathSigma;
 
 	std::size_t m_counter; ///< counter for generations
+	std::size_t m_updateFrequency; ///< generations between two refreshs of the eigendecomposition
 
 	MultiVariateNormalDistribution m_mutationDistribution;
 	DefaultRngType* mpe_rng;
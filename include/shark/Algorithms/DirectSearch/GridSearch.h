@@ -37,10 +37,14 @@
 
 
 #include <shark/Algorithms/AbstractSingleObjectiveOptimizer.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Rng/GlobalRng.h>
 
 #include <boost/serialization/vector.hpp>
 
+#include <algorithm>
+#include <functional>
+
 
 namespace shark {
 
@@ -65,6 +69,7 @@ class GridSearch : public AbstractSingleObjectiveOptimizer<RealVector >
 public:
 	GridSearch() {
 		m_configured=false;
+		m_archiveSize=0;
 	}
 
 	/// \brief From INameable: return the class name.
@@ -202,6 +207,8 @@ public:
 	{
 		archive>>m_nodeValues;
 		archive>>m_configured;
+		archive>>m_archiveSize;
+		archive>>m_archive;
 		archive>>m_best.point;
 		archive>>m_best.value;
 	}
@@ -210,6 +217,8 @@ public:
 	{
 		archive<<m_nodeValues;
 		archive<<m_configured;
+		archive<<m_archiveSize;
+		archive<<m_archive;
 		archive<<m_best.point;
 		archive<<m_best.value;
 	}
@@ -271,25 +280,72 @@ public:
 			m_nodeValues[index].push_back( factor * std::pow( exp_base, section+min ));
 	}
 
+	/*! Sets the number of best configurations kept in the archive.
+	 *  By default the archive is disabled and only the single best
+	 *  solution is stored.
+	 *  \param archiveSize number of solutions to keep, 0 disables the archive */
+	void setArchiveSize(std::size_t archiveSize)
+	{
+		m_archiveSize = archiveSize;
+	}
+
+	//! Returns the best configurations found by the last sweep, ordered by value.
+	std::vector<SolutionType> const& archive()const
+	{
+		return m_archive;
+	}
+
+	/*! Sets a callback which is called with every evaluated configuration.
+	 *  This allows monitoring of long sweeps while they are running. If the
+	 *  callback returns false, the remainder of the sweep is skipped.
+	 *  \param callback the callback to be notified after every evaluation */
+	void setResultCallback(std::function<bool(SolutionType const&)> const& callback)
+	{
+		m_resultCallback = callback;
+	}
+
 	//! Please note that for the grid search optimizer it does
 	//! not make sense to call step more than once, as the
 	//! solution does not improve iteratively.
+	//!
+	//! \par
+	//! If the objective function is flagged as thread safe, the grid
+	//! points are evaluated in parallel, otherwise strictly sequentially
+	//! in grid order.
 	void step(ObjectiveFunctionType const& objectiveFunction) {
-		size_t dimensions = m_nodeValues.size();
-		std::vector<size_t> index(dimensions, 0);
+		std::size_t numPoints = 1;
+		for(auto const& node: m_nodeValues)
+			numPoints *= node.size();
 		m_best.value = 1e100;
-		RealVector point(dimensions);
+		m_archive.clear();
 
-		// loop through all grid points
-		while (true)
+		if (objectiveFunction.isThreadSafe() && numPoints > 1)
 		{
-			// define the parameters
-			for (size_t dimension = 0; dimension < dimensions; dimension++)
-				point(dimension) = m_nodeValues[dimension][index[dimension]];
-
-			// evaluate the model
-			if (objectiveFunction.isFeasible(point))
+			bool abort = false;
+			SHARK_PARALLEL_FOR(int i = 0; i < (int)numPoints; ++i)
 			{
+				bool skip = false;
+				SHARK_CRITICAL_REGION{ skip = abort;}
+				RealVector point = gridPoint(i);
+				if (!skip && objectiveFunction.isFeasible(point))
+				{
+					double error = objectiveFunction.eval(point);
+					SHARK_CRITICAL_REGION{
+						if (!recordResult(point, error))
+							abort = true;
+					}
+				}
+			}
+		}
+		else
+		{
+			// loop through all grid points
+			for (std::size_t i = 0; i != numPoints; ++i)
+			{
+				RealVector point = gridPoint(i);
+
+				// evaluate the model
+				if (!objectiveFunction.isFeasible(point)) continue;
 				double error = objectiveFunction.eval(point);
 
 #ifdef SHARK_CV_VERBOSE_1
@@ -298,22 +354,8 @@ public:
 #ifdef SHARK_CV_VERBOSE
 				std::cout << point << "\t" << error << std::endl;
 #endif
-				if (error < m_best.value)
-				{
-					m_best.value = error;
-					m_best.point = point;		// [TG] swap() solution is out, caused ugly memory bug, I changed this back
-				}
-			}
-
-			// next index
-			size_t dimension = 0;
-			for (; dimension < dimensions; dimension++)
-			{
-				index[dimension]++;
-				if (index[dimension] < m_nodeValues[dimension].size()) break;
-				index[dimension] = 0;
+				if (!recordResult(point, error)) break;
 			}
-			if (dimension == dimensions) break;
 		}
 #ifdef SHARK_CV_VERBOSE_1
 		std::cout << std::endl;
@@ -322,9 +364,55 @@ public:
 
 protected:
 
+	//! decodes a linear index into the corresponding grid point
+	RealVector gridPoint(std::size_t linearIndex)const
+	{
+		std::size_t dimensions = m_nodeValues.size();
+		RealVector point(dimensions);
+		for (std::size_t dimension = 0; dimension < dimensions; dimension++)
+		{
+			point(dimension) = m_nodeValues[dimension][linearIndex % m_nodeValues[dimension].size()];
+			linearIndex /= m_nodeValues[dimension].size();
+		}
+		return point;
+	}
+
+	//! updates the best solution and the archive and notifies the callback.
+	//! returns false if the callback requested an abort of the sweep.
+	bool recordResult(RealVector const& point, double error)
+	{
+		if (error < m_best.value)
+		{
+			m_best.value = error;
+			m_best.point = point;		// [TG] swap() solution is out, caused ugly memory bug, I changed this back
+		}
+		SolutionType result(error, point);
+		if (m_archiveSize > 0)
+		{
+			m_archive.insert(
+				std::upper_bound(m_archive.begin(), m_archive.end(), result),
+				result
+			);
+			if (m_archive.size() > m_archiveSize)
+				m_archive.pop_back();
+		}
+		if (m_resultCallback)
+			return m_resultCallback(result);
+		return true;
+	}
+
 	//! The array columns contain the grid values for the corresponding parameter axis.
 	std::vector<std::vector<double> > m_nodeValues;
 
+	//! number of best solutions kept in the archive, 0 disables the archive
+	std::size_t m_archiveSize;
+
+	//! the best solutions of the last sweep, ordered by value
+	std::vector<SolutionType> m_archive;
+
+	//! called with every evaluated configuration, returns false to abort the sweep
+	std::function<bool(SolutionType const&)> m_resultCallback;
+
 	bool m_configured;
 };
 
@@ -568,6 +656,7 @@ public:
 	//! Constructor
 	PointSearch() {
 		m_configured=false;
+		m_archiveSize=0;
 	}
 
 	/// \brief From INameable: return the class name.
@@ -602,6 +691,8 @@ public:
 	{
 		archive>>m_points;
 		archive>>m_configured;
+		archive>>m_archiveSize;
+		archive>>m_archive;
 		archive>>m_best.point;
 		archive>>m_best.value;
 	}
@@ -610,10 +701,36 @@ public:
 	{
 		archive<<m_points;
 		archive<<m_configured;
+		archive<<m_archiveSize;
+		archive<<m_archive;
 		archive<<m_best.point;
 		archive<<m_best.value;
 	}
 
+	/*! Sets the number of best configurations kept in the archive.
+	 *  By default the archive is disabled and only the single best
+	 *  solution is stored.
+	 *  \param archiveSize number of solutions to keep, 0 disables the archive */
+	void setArchiveSize(std::size_t archiveSize)
+	{
+		m_archiveSize = archiveSize;
+	}
+
+	//! Returns the best configurations found by the last sweep, ordered by value.
+	std::vector<SolutionType> const& archive()const
+	{
+		return m_archive;
+	}
+
+	/*! Sets a callback which is called with every evaluated configuration.
+	 *  This allows monitoring of long sweeps while they are running. If the
+	 *  callback returns false, the remainder of the sweep is skipped.
+	 *  \param callback the callback to be notified after every evaluation */
+	void setResultCallback(std::function<bool(SolutionType const&)> const& callback)
+	{
+		m_resultCallback = callback;
+	}
+
 	//! If the class wasn't configured before, this method samples random uniform distributed points in [-1,1]^n.
 	void init(ObjectiveFunctionType& objectiveFunction, SearchPointType const& startingPoint) {
 		objectiveFunction.init();
@@ -630,32 +747,81 @@ public:
 	//! Please note that for the point search optimizer it does
 	//! not make sense to call step more than once, as the
 	//! solution does not improve iteratively.
+	//!
+	//! If the objective function is flagged as thread safe, the points
+	//! are evaluated in parallel, otherwise strictly sequentially.
 	void step(ObjectiveFunctionType const& objectiveFunction) {
-		size_t numPoints = m_points.size();
+		std::size_t numPoints = m_points.size();
 		m_best.value = 1e100;
-		size_t bestIndex=0;
+		m_archive.clear();
 
-		// loop through all points
-		for (size_t point = 0; point < numPoints; point++)
+		if (objectiveFunction.isThreadSafe() && numPoints > 1)
 		{
-			// evaluate the model
-			if (objectiveFunction.isFeasible(m_points[point]))
+			bool abort = false;
+			SHARK_PARALLEL_FOR(int i = 0; i < (int)numPoints; ++i)
 			{
-				double error = objectiveFunction.eval(m_points[point]);
-				if (error < m_best.value)
+				bool skip = false;
+				SHARK_CRITICAL_REGION{ skip = abort;}
+				if (!skip && objectiveFunction.isFeasible(m_points[i]))
 				{
-					m_best.value = error;
-					bestIndex=point;
+					double error = objectiveFunction.eval(m_points[i]);
+					SHARK_CRITICAL_REGION{
+						if (!recordResult(m_points[i], error))
+							abort = true;
+					}
 				}
 			}
 		}
-		m_best.point=m_points[bestIndex];
+		else
+		{
+			// loop through all points
+			for (std::size_t point = 0; point < numPoints; point++)
+			{
+				// evaluate the model
+				if (!objectiveFunction.isFeasible(m_points[point])) continue;
+				double error = objectiveFunction.eval(m_points[point]);
+				if (!recordResult(m_points[point], error)) break;
+			}
+		}
 	}
 
 protected:
+	//! updates the best solution and the archive and notifies the callback.
+	//! returns false if the callback requested an abort of the sweep.
+	bool recordResult(RealVector const& point, double error)
+	{
+		if (error < m_best.value)
+		{
+			m_best.value = error;
+			m_best.point = point;
+		}
+		SolutionType result(error, point);
+		if (m_archiveSize > 0)
+		{
+			m_archive.insert(
+				std::upper_bound(m_archive.begin(), m_archive.end(), result),
+				result
+			);
+			if (m_archive.size() > m_archiveSize)
+				m_archive.pop_back();
+		}
+		if (m_resultCallback)
+			return m_resultCallback(result);
+		return true;
+	}
+
 	//! The array holds one parameter configuration in every column.
 	std::vector<RealVector> m_points;
 
+	//! number of best solutions kept in the archive, 0 disables the archive
+	std::size_t m_archiveSize;
+
+	//! the best solutions of the last sweep, ordered by value
+	std::vector<SolutionType> m_archive;
+
+	//! called with every evaluated configuration, returns false to abort the sweep
+	std::function<bool(SolutionType const&)> m_resultCallback;
+
 	//! verbosity level
 	bool m_configured;
 };
@@ -0,0 +1,193 @@
+//===========================================================================
+/*!
+ *
+ * \brief       Island model meta-optimizer with ring migration.
+ *
+ *
+ *
+ * \author      O.Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_ALGORITHMS_DIRECT_SEARCH_ISLAND_MODEL_H
+#define SHARK_ALGORITHMS_DIRECT_SEARCH_ISLAND_MODEL_H
+
+#include <shark/Algorithms/AbstractSingleObjectiveOptimizer.h>
+#include <shark/Core/OpenMP.h>
+
+#include <limits>
+
+namespace shark {
+
+/// \brief Island model meta-optimizer running several optimizers in parallel.
+///
+/// The island model is a coarse-grained parallelization of randomized search:
+/// a number of independent instances of the same optimizer, the islands,
+/// explore the objective function side by side. Every migrationInterval
+/// generations the islands exchange their elites along a directed ring.
+/// An island receiving an immigrant which is better than its own best
+/// solution is restarted from the immigrant point, so successful regions of
+/// the search space spread slowly through the population of islands while
+/// diversity between distant islands is preserved.
+///
+/// If the objective function is flagged as thread safe, the islands perform
+/// their steps in parallel, otherwise they are stepped one after another.
+/// The solution of the model is the best solution any island has found so
+/// far, which is monotone over the run even when islands are restarted.
+///
+/// The underlying optimizer must be an AbstractSingleObjectiveOptimizer over
+/// RealVector, for example the CMA or the CrossEntropyMethod. The single
+/// islands can be accessed for configuration before init is called.
+template<class Optimizer>
+class IslandModel : public AbstractSingleObjectiveOptimizer<RealVector >
+{
+public:
+	/// \brief Constructor.
+	///
+	/// \param numIslands number of independent optimizer instances
+	/// \param migrationInterval number of generations between two migrations, 0 disables migration
+	IslandModel(std::size_t numIslands = 4, std::size_t migrationInterval = 10)
+	: m_islands(numIslands)
+	, m_migrationInterval(migrationInterval)
+	, m_generation(0)
+	, m_function(nullptr){}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "IslandModel"; }
+
+	/// \brief Returns the number of islands.
+	std::size_t numberOfIslands()const{
+		return m_islands.size();
+	}
+
+	/// \brief Returns the i-th island, e.g. for configuring its parameters.
+	Optimizer& island(std::size_t i){
+		return m_islands[i];
+	}
+	/// \brief Returns the i-th island.
+	Optimizer const& island(std::size_t i)const{
+		return m_islands[i];
+	}
+
+	/// \brief Returns the number of generations between two migrations.
+	std::size_t migrationInterval()const{
+		return m_migrationInterval;
+	}
+	/// \brief Sets the number of generations between two migrations, 0 disables migration.
+	void setMigrationInterval(std::size_t migrationInterval){
+		m_migrationInterval = migrationInterval;
+	}
+
+	void read( InArchive & archive ){
+		std::size_t numIslands = 0;
+		archive>>numIslands;
+		m_islands.resize(numIslands);
+		for(auto& island: m_islands)
+			island.read(archive);
+		archive>>m_migrationInterval;
+		archive>>m_generation;
+		archive>>m_best.point;
+		archive>>m_best.value;
+	}
+
+	void write( OutArchive & archive ) const{
+		std::size_t numIslands = m_islands.size();
+		archive<<numIslands;
+		for(auto const& island: m_islands)
+			island.write(archive);
+		archive<<m_migrationInterval;
+		archive<<m_generation;
+		archive<<m_best.point;
+		archive<<m_best.value;
+	}
+
+	/// \brief Initializes all islands with the supplied starting point.
+	///
+	/// The objective function is remembered so that islands can be restarted
+	/// from immigrant solutions during migration.
+	void init(ObjectiveFunctionType& objectiveFunction, SearchPointType const& startingPoint){
+		checkFeatures(objectiveFunction);
+		m_function = &objectiveFunction;
+		m_generation = 0;
+		for(auto& island: m_islands)
+			island.init(objectiveFunction, startingPoint);
+		m_best.point = startingPoint;
+		m_best.value = std::numeric_limits<double>::max();
+	}
+	using AbstractSingleObjectiveOptimizer<RealVector >::init;
+
+	/// \brief Performs one generation on every island followed by a possible migration.
+	///
+	/// Islands are stepped in parallel if the objective function is flagged
+	/// as thread safe.
+	void step(ObjectiveFunctionType const& objectiveFunction){
+		std::size_t numIslands = m_islands.size();
+		if(objectiveFunction.isThreadSafe() && numIslands > 1){
+			SHARK_PARALLEL_FOR(int i = 0; i < (int)numIslands; ++i){
+				m_islands[i].step(objectiveFunction);
+			}
+		}else{
+			for(auto& island: m_islands)
+				island.step(objectiveFunction);
+		}
+		for(auto const& island: m_islands){
+			if(island.solution().value < m_best.value)
+				m_best = island.solution();
+		}
+		++m_generation;
+		if(m_migrationInterval > 0 && m_generation % m_migrationInterval == 0)
+			migrate();
+	}
+
+private:
+	/// \brief Migrates the elites along a directed ring over the islands.
+	///
+	/// Every island receives the best solution of its predecessor in the
+	/// ring. If the immigrant is better than the island's own best solution,
+	/// the island is restarted from the immigrant point.
+	void migrate(){
+		std::size_t numIslands = m_islands.size();
+		if(numIslands < 2 || m_function == nullptr)
+			return;
+		//copy the elites first so that restarts do not alter what is sent
+		std::vector<SolutionType> elites(numIslands);
+		for(std::size_t i = 0; i != numIslands; ++i)
+			elites[i] = m_islands[i].solution();
+		for(std::size_t i = 0; i != numIslands; ++i){
+			SolutionType const& immigrant = elites[(i + numIslands - 1) % numIslands];
+			if(immigrant.value < elites[i].value)
+				m_islands[i].init(*m_function, immigrant.point);
+		}
+	}
+
+	std::vector<Optimizer> m_islands; ///< the independent optimizer instances
+	std::size_t m_migrationInterval; ///< number of generations between two migrations
+	std::size_t m_generation; ///< number of generations performed since init
+	ObjectiveFunctionType* m_function; ///< the function supplied to init, used for restarts
+};
+
+}
+
+#endif
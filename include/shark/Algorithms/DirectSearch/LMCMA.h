@@ -28,6 +28,7 @@
 #define SHARK_ALGORITHMS_DIRECT_SEARCH_LM_CMA_H
 
 #include <shark/Algorithms/AbstractSingleObjectiveOptimizer.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Statistics/Distributions/MultiVariateNormalDistribution.h>
 #include <shark/Algorithms/DirectSearch/Individual.h>
 
@@ -77,13 +78,22 @@ public:
 	//computes x = Az
 	template<class T>
 	void prod(RealVector& x, T const& z)const{
-		x = z;
+		//all inner products of the sequential recursion
+		// x_{j+1} = a*x_j + b_j <v_j,z> pc_j
+		//depend on z only, so they form a single matrix-vector product and the
+		//direction vectors can be applied in one blocked pass over the stored
+		//matrix instead of m passes over x
 		double a = std::sqrt(1-m_alpha);
-		for(std::size_t j=0; j != m_j.size(); j++){
-			std::size_t jcur = m_j[j];	
-			double k = m_b(jcur) *inner_prod(row(m_vArr,jcur),z);
-			noalias(x) = a*x+k*row(m_pcArr,jcur);
+		RealVector dots = blas::prod(m_vArr,z);
+		RealVector coefficients(m_b.size(),0.0);
+		double scale = 1.0;//a^(m-1-j), the remaining shrinkage applied to step j
+		for(std::size_t j = m_j.size(); j != 0; --j){
+			std::size_t jcur = m_j[j-1];
+			coefficients(jcur) = scale*m_b(jcur)*dots(jcur);
+			scale *= a;
 		}
+		x.resize(m_vArr.size2());
+		noalias(x) = scale*z + blas::prod(trans(m_pcArr),coefficients);
 	}
 	
 	//computes x= A^{-1}z
@@ -280,7 +290,17 @@ public:
 		std::vector< IndividualType > offspring( m_lambda );
 
 		PenalizingEvaluator penalizingEvaluator;
+		//the rng is shared, so the random numbers are drawn serially;
+		//the O(dm) reconstruction chains of the samples are independent
+		//and run in parallel
 		for( unsigned int i = 0; i < offspring.size(); i++ ) {
+			RealVector& z = offspring[i].chromosome();
+			z.resize(m_numberOfVariables);
+			for(std::size_t j = 0; j != m_numberOfVariables; ++j){
+				z(j) = gauss(*mpe_rng,0,1);
+			}
+		}
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)offspring.size(); ++i){
 			createSample(offspring[i].searchPoint(),offspring[i].chromosome());
 		}
 		penalizingEvaluator( function, offspring.begin(), offspring.end() );
@@ -362,13 +382,9 @@ private:
 
 	}
 	
-	/// \brief Creates a vector-sample pair x=Az, where z is a gaussian random vector.
-	void createSample(RealVector& x,RealVector& z)const{
+	/// \brief Reconstructs a sample x=Az from a gaussian random vector z.
+	void createSample(RealVector& x,RealVector const& z)const{
 		x.resize(m_numberOfVariables);
-		z.resize(m_numberOfVariables);
-		for(std::size_t i = 0; i != m_numberOfVariables; ++i){
-			z(i) = gauss(*mpe_rng,0,1);
-		}
 		m_A.prod(x,z);
 		noalias(x) = sigma()*x +m_mean;
 	}
@@ -36,8 +36,11 @@
 #ifndef SHARK_ALGORITHMS_DIRECT_SEARCH_OPERATORS_EVALUATION_PENALIZING_EVALUATOR_H
 #define SHARK_ALGORITHMS_DIRECT_SEARCH_OPERATORS_EVALUATION_PENALIZING_EVALUATOR_H
 
+#include <shark/Core/OpenMP.h>
 #include <shark/LinAlg/Base.h>
 
+#include <vector>
+
 namespace shark {
 /**
 * \brief Penalizing evaluator for scalar objective functions.
@@ -84,14 +87,44 @@ struct PenalizingEvaluator {
 	/**
 	* \brief Evaluates The function on individuals in the range [first,last]
 	*
+	* Functions flagged as thread safe are evaluated in parallel over the
+	* population, which directly divides the wall-clock time of expensive
+	* objectives by the population size. Functions drawing from the global
+	* Rng must not set the flag, as their evaluations would race.
+	*
+	* Otherwise the feasible points are evaluated with a single batch call.
+	* For cheap functions like the benchmark suite which override the batch
+	* evaluation, this removes the per-point call overhead. Infeasible points
+	* still take the repair-and-penalize path one by one.
+	*
 	* \param [in] f The function to be evaluated.
 	* \param [in] begin first indivdual in the range to be evaluated
 	* \param [in] end iterator pointing directly beehind the last individual to be evaluated
 	*/
 	template<typename Function, typename Iterator>
 	void operator()( Function const& f, Iterator begin, Iterator end ) const {
-		for(Iterator pos = begin; pos != end; ++pos){
-			(*this)(f,*pos);
+		std::ptrdiff_t numIndividuals = end - begin;
+		if(f.isThreadSafe() && numIndividuals > 1){
+			SHARK_PARALLEL_FOR(int i = 0; i < (int)numIndividuals; ++i){
+				(*this)(f,*(begin+i));
+			}
+		}else{
+			std::vector<typename Function::SearchPointType> points;
+			std::vector<std::ptrdiff_t> feasible;
+			for(std::ptrdiff_t i = 0; i != numIndividuals; ++i){
+				if( f.isFeasible( (begin+i)->searchPoint() ) ){
+					feasible.push_back(i);
+					points.push_back((begin+i)->searchPoint());
+				}else{
+					(*this)(f,*(begin+i));
+				}
+			}
+			std::vector<typename Function::ResultType> values;
+			f.evalBatch(points,values);
+			for(std::size_t i = 0; i != feasible.size(); ++i){
+				(begin+feasible[i])->unpenalizedFitness() = values[i];
+				(begin+feasible[i])->penalizedFitness() = values[i];
+			}
 		}
 	}
 	
@@ -33,12 +33,16 @@
 #include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculator.h>
 
 #include <algorithm>
+#include <limits>
 #include <vector>
 
 namespace shark {
 /// \brief Finds the hypervolume contribution for points in MD
 ///
-/// This is the naive default algorithm explicitely calculating Con{x\in S}=Hyp{S}-Hyp{S/x} for all x in the set of points S
+/// This is the naive default algorithm explicitely calculating Con{x\in S}=Hyp{S}-Hyp{S/x} for all x in the set of points S.
+/// The contributions are computed in parallel with dynamic scheduling, as their cost varies
+/// strongly between points. When only the least contributor is needed, cheap upper bounds
+/// of the contributions are used to skip most of the exact computations.
 struct HypervolumeContributionMD {
 	/// \brief Returns the index of the points with smallest contribution.
 	///
@@ -47,19 +51,23 @@ struct HypervolumeContributionMD {
 	/// \param [in] referencePointThe reference Point\f$\vec{r} \in \mathbb{R}^2\f$ for the hypervolume calculation, needs to fulfill: \f$ \forall s \in S: s \preceq \vec{r}\f$.
 	template<class Set, typename VectorType>
 	std::vector<KeyValuePair<double,std::size_t> > smallest(Set const& points, std::size_t k, VectorType const& ref)const{
+		if(k == 1){
+			std::vector<std::size_t> excluded;
+			return std::vector<KeyValuePair<double,std::size_t> >(1, leastContributor(points,ref,excluded));
+		}
 		HypervolumeCalculator hv;
 		double baseVol = hv(points,ref);
 		std::vector<KeyValuePair<double,std::size_t> > result( points.size() );
-		SHARK_PARALLEL_FOR( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
+		SHARK_PARALLEL_FOR_DYNAMIC( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
 			std::vector<RealVector> copy( points.begin(), points.end() );
 			copy.erase( copy.begin() + i );
-			
+
 			result[i].key = baseVol-hv(copy,ref);
 			result[i].value = i;
 		}
 		std::sort(result.begin(),result.end());
 		result.erase(result.begin()+k,result.end());
-		
+
 		return result;
 	}
 	
@@ -72,10 +80,10 @@ struct HypervolumeContributionMD {
 		HypervolumeCalculator hv;
 		double baseVol = hv(points,ref);
 		std::vector<KeyValuePair<double,std::size_t> > result( points.size() );
-		SHARK_PARALLEL_FOR( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
+		SHARK_PARALLEL_FOR_DYNAMIC( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
 			std::vector<RealVector> copy( points.begin(), points.end() );
 			copy.erase( copy.begin() + i );
-			
+
 			HypervolumeCalculator hv;
 			result[i].key = baseVol-hv(copy,ref);
 			result[i].value = i;
@@ -107,15 +115,18 @@ struct HypervolumeContributionMD {
 				}
 			}
 		}
+		if(k == 1){
+			return std::vector<KeyValuePair<double,std::size_t> >(1, leastContributor(points,ref,minIndex));
+		}
 		HypervolumeCalculator hv;
 		double baseVol = hv(points,ref);
 		std::vector<KeyValuePair<double,std::size_t> > result;
-		SHARK_PARALLEL_FOR( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
+		SHARK_PARALLEL_FOR_DYNAMIC( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
 			if(std::find(minIndex.begin(),minIndex.end(),i) != minIndex.end())
 				continue;
 			std::vector<RealVector> copy( points.begin(), points.end() );
 			copy.erase( copy.begin() + i );
-			
+
 			double volume = baseVol - hv(copy,ref);
 			SHARK_CRITICAL_REGION{
 				result.emplace_back(volume,i);
@@ -123,7 +134,7 @@ struct HypervolumeContributionMD {
 		}
 		std::sort(result.begin(),result.end());
 		result.erase(result.begin()+k,result.end());
-		
+
 		return result;
 	}
 
@@ -156,12 +167,12 @@ struct HypervolumeContributionMD {
 		HypervolumeCalculator hv;
 		double baseVol = hv(points,ref);
 		std::vector<KeyValuePair<double,std::size_t> > result;
-		SHARK_PARALLEL_FOR( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
+		SHARK_PARALLEL_FOR_DYNAMIC( int i = 0; i < static_cast< int >( points.size() ); i++ ) {
 			if(std::find(minIndex.begin(),minIndex.end(),i) != minIndex.end())
 				continue;
 			std::vector<RealVector> copy( points.begin(), points.end() );
 			copy.erase( copy.begin() + i );
-			
+
 			HypervolumeCalculator hv;
 			double volume = baseVol - hv(copy,ref);
 			SHARK_CRITICAL_REGION{
@@ -173,6 +184,74 @@ struct HypervolumeContributionMD {
 		std::reverse(result.begin(),result.end());
 		return result;
 	}
+
+private:
+	/// \brief Returns the least contributor, computing exact contributions only when needed.
+	///
+	/// The contribution of a point is at most the volume between its box and the box of the
+	/// closest cap max(p_i,p_j) over all other points j of the set, and at least the volume
+	/// of its box minus the volumes of all caps. A point whose upper bound is zero is
+	/// dominated and is returned without computing any hypervolume; a point whose lower
+	/// bound exceeds the smallest contribution found so far is skipped. The candidates are
+	/// processed in parallel in the order of their upper bounds, so that a small
+	/// contribution is found early and rules out as many candidates as possible.
+	template<class Set, typename VectorType>
+	KeyValuePair<double,std::size_t> leastContributor(
+		Set const& points, VectorType const& ref, std::vector<std::size_t> const& excluded
+	)const{
+		std::size_t numPoints = points.size();
+		std::size_t numObjectives = ref.size();
+
+		//compute the bounds of the contributions
+		std::vector<KeyValuePair<double,std::size_t> > upperBounds;
+		std::vector<double> lowerBounds(numPoints);
+		for(std::size_t i = 0; i != numPoints; ++i){
+			if(std::find(excluded.begin(),excluded.end(),i) != excluded.end())
+				continue;
+			double boxVolume = 1.0;
+			for(std::size_t m = 0; m != numObjectives; ++m)
+				boxVolume *= ref[m] - points[i][m];
+			double upper = boxVolume;
+			double lower = boxVolume;
+			for(std::size_t j = 0; j != numPoints; ++j){
+				if(j == i) continue;
+				double capVolume = 1.0;
+				for(std::size_t m = 0; m != numObjectives; ++m)
+					capVolume *= ref[m] - std::max(points[i][m],points[j][m]);
+				upper = std::min(upper, boxVolume - capVolume);
+				lower -= capVolume;
+			}
+			upperBounds.emplace_back(upper,i);
+			lowerBounds[i] = lower;
+		}
+		std::sort(upperBounds.begin(),upperBounds.end());
+
+		//a point with upper bound zero is dominated and contributes nothing
+		if(upperBounds[0].key <= 0)
+			return makeKeyValuePair(0.0,upperBounds[0].value);
+
+		HypervolumeCalculator hvBase;
+		double baseVol = hvBase(points,ref);
+		KeyValuePair<double,std::size_t> best(std::numeric_limits<double>::max(),upperBounds[0].value);
+		SHARK_PARALLEL_FOR_DYNAMIC( int i = 0; i < static_cast< int >( upperBounds.size() ); i++ ) {
+			bool canImprove = false;
+			SHARK_CRITICAL_REGION{
+				canImprove = lowerBounds[upperBounds[i].value] < best.key;
+			}
+			if(canImprove){
+				std::vector<RealVector> copy( points.begin(), points.end() );
+				copy.erase( copy.begin() + upperBounds[i].value );
+
+				HypervolumeCalculator hv;
+				double contribution = baseVol - hv(copy,ref);
+				SHARK_CRITICAL_REGION{
+					if(contribution < best.key)
+						best = makeKeyValuePair(contribution,upperBounds[i].value);
+				}
+			}
+		}
+		return best;
+	}
 };
 
 }
@@ -0,0 +1,93 @@
+/*!
+ *
+ *
+ * \brief       Calculates the crowding distance of a pareto front
+ *
+ * \author      O.Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_ALGORITHMS_DIRECT_SEARCH_OPERATORS_INDICATORS_CROWDING_DISTANCE_H
+#define SHARK_ALGORITHMS_DIRECT_SEARCH_OPERATORS_INDICATORS_CROWDING_DISTANCE_H
+
+#include <shark/LinAlg/Base.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace shark {
+
+/// \brief Implements the crowding distance of the original NSGA-II.
+///
+/// The crowding distance of a point is the sum over all objectives of the
+/// normalized distance between its two neighbours on either side. Boundary
+/// points of a front are assigned infinite distance and are therefore never
+/// removed. The point in the most crowded region, i.e. the one with the
+/// smallest distance, contributes least to the spread of the front.
+///
+/// One call costs O(m n log(n)) for a front of n points and m objectives,
+/// which makes it much cheaper than volume based indicators.
+///
+/// See the following reference for further details:
+/// - Deb, Pratap, Agarwal, Meyarivan. A Fast Elitist Multi-Objective Genetic Algorithm: NSGA-II.
+///   IEEE Transactions on Evolutionary Computation, 2002.
+struct CrowdingDistance {
+	/// \brief Given a pareto front, returns the index of the point with the smallest crowding distance
+	template<typename ParetofrontType>
+	std::size_t leastContributor(ParetofrontType const& front)const{
+		SIZE_CHECK(front.size() > 0);
+		std::size_t numPoints = front.size();
+		std::size_t numObjectives = front[0].size();
+		double const infinity = std::numeric_limits<double>::max();
+
+		std::vector<double> distances(numPoints, 0.0);
+		std::vector<std::size_t> order(numPoints);
+		for(std::size_t m = 0; m != numObjectives; ++m){
+			//sort the front by the current objective
+			std::iota(order.begin(),order.end(),0);
+			std::sort(order.begin(),order.end(),
+				[&](std::size_t i, std::size_t j){return front[i](m) < front[j](m);}
+			);
+			//boundary points are kept unconditionally
+			distances[order.front()] = infinity;
+			distances[order.back()] = infinity;
+			double range = front[order.back()](m) - front[order.front()](m);
+			if(range == 0) continue;
+			//interior points get the normalized gap between their neighbours added
+			for(std::size_t i = 1; i + 1 < numPoints; ++i){
+				if(distances[order[i]] == infinity) continue;
+				distances[order[i]] += (front[order[i+1]](m) - front[order[i-1]](m)) / range;
+			}
+		}
+		return std::min_element(distances.begin(),distances.end()) - distances.begin();
+	}
+
+	template<typename Archive>
+	void serialize( Archive &, const unsigned int ) {}
+};
+
+}
+
+#endif
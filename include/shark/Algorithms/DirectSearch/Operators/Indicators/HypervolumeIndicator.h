@@ -34,6 +34,7 @@
 
 #include <shark/Core/Exception.h>
 #include <shark/Core/OpenMP.h>
+#include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeCalculator.h>
 #include <shark/Algorithms/DirectSearch/Operators/Hypervolume/HypervolumeContribution.h>
 
 #include <algorithm>
@@ -50,28 +51,45 @@ namespace shark {
 /// Note, that for boundary points that are not extrema, this does not hold and they are selected.
 ///
 /// for problems with many objectives, an approximative algorithm can be used.
+///
+/// When a reference point is set and more than 3 objectives are used, the indicator
+/// caches the contributions between calls and only recomputes the points whose
+/// neighbourhood changed. This makes steady state algorithms like the SMS-EMOA,
+/// which insert and remove a single point per iteration, cheap even for large fronts.
 struct HypervolumeIndicator {
+	/// \brief Default c'tor.
+	HypervolumeIndicator() : m_useApproximation(false) {}
+
 	/// \brief Determines the point contributing the least hypervolume to the overall front of points.
 	///
 	/// \param [in] front pareto front of points
 	template<typename ParetoFrontType>
-	std::size_t leastContributor( ParetoFrontType const& front)const{
-		HypervolumeContribution algorithm;
+	std::size_t leastContributor( ParetoFrontType const& front){
+		std::size_t numObjectives = front[0].size();
+		//with more than 3 objectives there is no specialized contribution algorithm and
+		//recomputing every contribution from scratch is expensive. In this case the
+		//contributions of the previous call are reused and only the neighbourhood of
+		//the points that changed since then is recomputed.
+		if(m_reference.size() != 0 && numObjectives > 3 && !m_useApproximation)
+			return leastContributorIncremental(front);
 		if(m_reference.size() != 0)
 			return m_algorithm.smallest(front,1,m_reference)[0].value;
-		else	
+		else
 			return m_algorithm.smallest(front,1)[0].value;
 	}
-	
-	/// \brief Sets the reference point. 
+
+	/// \brief Sets the reference point.
 	///
 	/// If no point is set, it is estimated from the current front and the extremum points are never selected.
 	void setReference(RealVector const& newReference){
 		m_reference = newReference;
+		m_cachedFront.clear();
+		m_cachedContributions.clear();
 	}
-	
+
 	/// \brief Whether the approximtive algorithm should be used on large problems
 	void useApproximation(bool useApproximation){
+		m_useApproximation = useApproximation;
 		m_algorithm.useApproximation(useApproximation);
 	}
 	
@@ -98,11 +116,119 @@ struct HypervolumeIndicator {
 	void serialize( Archive & archive, const unsigned int version ) {
 		archive & BOOST_SERIALIZATION_NVP( m_reference );
 		archive & BOOST_SERIALIZATION_NVP( m_algorithm );
+		archive & BOOST_SERIALIZATION_NVP( m_useApproximation );
+		archive & BOOST_SERIALIZATION_NVP( m_cachedFront );
+		archive & BOOST_SERIALIZATION_NVP( m_cachedContributions );
 	}
 
 private:
+	/// \brief Computes the least contributor, reusing the contributions cached by the previous call.
+	///
+	/// In a steady state algorithm like the SMS-EMOA the front changes by only one or
+	/// two points between two selections, yet a full recomputation evaluates the
+	/// hypervolume once per point of the front. A changed point c can only alter the
+	/// contribution of a point x if no third, unchanged point of the front dominates
+	/// the common corner max(x,c): otherwise the region covered by both x and c is
+	/// covered before and after the change and the cached contribution of x stays
+	/// valid. Thus only the affected neighbourhood has to be recomputed.
+	template<typename ParetoFrontType>
+	std::size_t leastContributorIncremental( ParetoFrontType const& front){
+		std::size_t numPoints = front.size();
+		std::vector<RealVector> points(front.begin(),front.end());
+
+		//match the points of the front with the points of the previous call
+		std::size_t const notFound = m_cachedFront.size();
+		std::vector<std::size_t> cachePosition(numPoints, notFound);
+		std::vector<bool> stillInFront(m_cachedFront.size(), false);
+		for(std::size_t i = 0; i != numPoints; ++i){
+			for(std::size_t j = 0; j != m_cachedFront.size(); ++j){
+				if(stillInFront[j]) continue;
+				if(points[i].size() == m_cachedFront[j].size() && norm_inf(points[i] - m_cachedFront[j]) == 0.0){
+					cachePosition[i] = j;
+					stillInFront[j] = true;
+					break;
+				}
+			}
+		}
+
+		//collect the points that were inserted or removed since the last call
+		//as well as the points surviving it. only surviving points are allowed
+		//to validate a cached contribution.
+		std::vector<RealVector> changed;
+		std::vector<std::size_t> survivors;
+		for(std::size_t i = 0; i != numPoints; ++i){
+			if(cachePosition[i] == notFound)
+				changed.push_back(points[i]);
+			else
+				survivors.push_back(i);
+		}
+		for(std::size_t j = 0; j != m_cachedFront.size(); ++j){
+			if(!stillInFront[j]) changed.push_back(m_cachedFront[j]);
+		}
+
+		//decide which contributions have to be recomputed. checking the neighbourhood
+		//of many changed points costs more than it saves, so in that case everything
+		//is recomputed, which is no more expensive than a computation without cache.
+		bool recomputeAll = 4 * changed.size() > numPoints;
+		std::vector<std::size_t> recompute;
+		std::vector<double> contributions(numPoints, 0.0);
+		for(std::size_t i = 0; i != numPoints; ++i){
+			if(recomputeAll || cachePosition[i] == notFound || contributionChanged(points, i, changed, survivors))
+				recompute.push_back(i);
+			else
+				contributions[i] = m_cachedContributions[cachePosition[i]];
+		}
+
+		//recompute the affected neighbourhood
+		if(!recompute.empty()){
+			HypervolumeCalculator hvFront;
+			double frontVolume = hvFront(points, m_reference);
+			SHARK_PARALLEL_FOR( int r = 0; r < static_cast<int>( recompute.size() ); r++ ) {
+				std::size_t i = recompute[r];
+				std::vector<RealVector> copy(points);
+				copy.erase(copy.begin() + i);
+
+				HypervolumeCalculator hv;
+				contributions[i] = frontVolume - hv(copy, m_reference);
+			}
+		}
+
+		m_cachedFront = std::move(points);
+		m_cachedContributions = contributions;
+		return std::min_element(contributions.begin(), contributions.end()) - contributions.begin();
+	}
+
+	/// \brief Returns true if one of the changed points can alter the cached contribution of point i.
+	bool contributionChanged(
+		std::vector<RealVector> const& points,
+		std::size_t i,
+		std::vector<RealVector> const& changed,
+		std::vector<std::size_t> const& survivors
+	)const{
+		for(std::size_t c = 0; c != changed.size(); ++c){
+			RealVector corner = max(points[i], changed[c]);
+			bool covered = false;
+			for(std::size_t s = 0; s != survivors.size() && !covered; ++s){
+				std::size_t j = survivors[s];
+				if(j == i) continue;
+				covered = true;
+				for(std::size_t m = 0; m != corner.size(); ++m){
+					if(points[j](m) > corner(m)){
+						covered = false;
+						break;
+					}
+				}
+			}
+			if(!covered) return true;
+		}
+		return false;
+	}
+
 	RealVector m_reference;
 	HypervolumeContribution m_algorithm;
+	bool m_useApproximation;
+	std::vector<RealVector> m_cachedFront;
+	std::vector<double> m_cachedContributions;
 };
 }
 
@@ -57,6 +57,11 @@ struct IndicatorBasedSelection {
 	* its level non-dominance (rank) and its individual contribution to the front
 	* it belongs to (share).
 	*
+	* The fitness of the population is gathered in a dense array first, so that
+	* ranking and environmental selection only touch contiguous memory instead of
+	* the scattered individuals. The individuals themselves are never moved, the
+	* fronts are represented by their indices into the population.
+	*
 	* \param [in,out] population The population to be ranked.
 	* \param [in,out] mu the number of individuals to select
 	*/
@@ -64,40 +69,51 @@ struct IndicatorBasedSelection {
 	void operator()( PopulationType & population, std::size_t mu )
 	{
 		if(population.empty()) return;
-		
-		//perform a nondominated sort to assign the rank to every element
-		nonDominatedSort(penalizedFitness(population), ranks(population));
+		typedef typename PopulationType::value_type::FitnessType FitnessType;
 
-		typedef std::vector< view_reference<typename PopulationType::value_type > > View;
+		//gather the fitness of the population in a dense array
+		std::size_t numPoints = population.size();
+		std::vector<FitnessType> fitness(numPoints);
+		for(std::size_t i = 0; i != numPoints; ++i)
+			fitness[i] = population[i].penalizedFitness();
+
+		//perform a nondominated sort to assign the rank to every element
+		std::vector<unsigned int> rank(numPoints, 0);
+		nonDominatedSort(fitness, rank);
 
 		unsigned int maxRank = 0;
-		std::map< unsigned int, View > fronts;
+		std::map< unsigned int, std::vector<std::size_t> > fronts;
 
-		for( unsigned int i = 0; i < population.size(); i++ ) {
-			maxRank = std::max( maxRank, static_cast<unsigned int>( population[i].rank() ) );
-			fronts[population[i].rank()].push_back( population[i] );
+		for( std::size_t i = 0; i < numPoints; i++ ) {
+			population[i].rank() = rank[i];
+			maxRank = std::max( maxRank, rank[i] );
+			fronts[rank[i]].push_back( i );
 			population[i].selected() = true;
 		}
 
 		//deselect the highest rank fronts until we would end up with less or equal mu elements
-		unsigned int rank = maxRank;
-		std::size_t popSize = population.size();
-		
-		while(popSize-fronts[rank].size() >= mu){
+		unsigned int frontRank = maxRank;
+		std::size_t popSize = numPoints;
+
+		while(popSize-fronts[frontRank].size() >= mu){
 			//deselect all elements in this front
-			View & front = fronts[rank];
+			std::vector<std::size_t> & front = fronts[frontRank];
 			for(std::size_t i = 0; i != front.size(); ++i){
-				front[i].selected() = false;
+				population[front[i]].selected() = false;
 			}
 			popSize -= front.size();
-			--rank;
+			--frontRank;
 		}
 		//now use the indicator to deselect the worst approximating elements of the last selected front
-		View& front = fronts[rank];
+		std::vector<std::size_t>& front = fronts[frontRank];
+		std::vector<FitnessType> frontFitness(front.size());
+		for(std::size_t i = 0; i != front.size(); ++i)
+			frontFitness[i] = fitness[front[i]];
 		for(; popSize >mu;--popSize) {
-			std::size_t lc = m_indicator.leastContributor(penalizedFitness(front));
-			front[lc].selected() = false;
+			std::size_t lc = m_indicator.leastContributor(frontFitness);
+			population[front[lc]].selected() = false;
 			front.erase( front.begin() + lc );
+			frontFitness.erase( frontFitness.begin() + lc );
 		}
 	}
 
@@ -120,54 +136,6 @@ struct IndicatorBasedSelection {
 	}
 private:
 	Indicator m_indicator; ///< Instance of the second level sorting criterion.
-
-	/** \cond */
-	template<typename T>
-	struct view_reference {
-		T * mep_value;
-	public:
-		typedef RealVector FitnessType;
-	
-		view_reference() : mep_value( NULL ){}
-		view_reference(T & value) : mep_value( &value ){}
-
-		operator T & ()
-		{
-			return( *mep_value );
-		}
-
-		operator const T & () const
-		{
-			return( *mep_value );
-		}
-
-		view_reference<T> operator=( const T & rhs )
-		{
-			*mep_value = rhs;
-			return *this;
-		}
-
-		RealVector& penalizedFitness() {
-			return mep_value->penalizedFitness();
-		}
-		
-		RealVector& unpenalizedFitness(){
-			return mep_value->unpenalizedFitness();
-		}
-		
-		RealVector const& penalizedFitness() const{
-			return mep_value->penalizedFitness();
-		}
-		
-		RealVector const& unpenalizedFitness() const{
-			return mep_value->unpenalizedFitness();
-		}
-		
-		bool& selected(){
-			return mep_value->selected();
-		}
-	};
-	/** \endcond */
 };
 }
 
@@ -0,0 +1,277 @@
+//===========================================================================
+/*!
+ *
+ * \brief       Restart meta-optimizer with population escalation and racing.
+ *
+ *
+ *
+ * \author      O.Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_ALGORITHMS_DIRECT_SEARCH_RESTART_STRATEGY_H
+#define SHARK_ALGORITHMS_DIRECT_SEARCH_RESTART_STRATEGY_H
+
+#include <shark/Algorithms/AbstractSingleObjectiveOptimizer.h>
+#include <shark/Algorithms/DirectSearch/CMA.h>
+#include <shark/Core/OpenMP.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace shark {
+
+namespace detail{
+/// \brief Applies the configuration of the given escalation level to the optimizer.
+///
+/// For the CMA the level scales the offspring population size: level l uses
+/// suggestLambda * 2^l offspring as in the IPOP restart scheme. Optimizers
+/// without a population size parameter, like the ElitistCMA, are left at
+/// their current configuration and the restart only resets their state.
+inline void applyRestartLevel(CMA& cma, std::size_t dimension, std::size_t level){
+	//cap the escalation, doublings beyond this are not sensible population sizes
+	std::size_t lambda = CMA::suggestLambda(dimension) << std::min<std::size_t>(level, 16);
+	cma.setLambda(lambda);
+	cma.setMu(CMA::suggestMu(lambda, cma.recombinationType()));
+}
+template<class Optimizer>
+void applyRestartLevel(Optimizer&, std::size_t, std::size_t){}
+}
+
+/// \brief Restart meta-optimizer racing several restart configurations.
+///
+/// Restart strategies like IPOP wrap a randomized search algorithm and restart
+/// it whenever a run stagnates, escalating the population size from restart to
+/// restart so that later runs search more globally. This driver manages the
+/// whole scheme behind the usual optimizer interface: it keeps a small set of
+/// concurrently racing instances of the underlying optimizer, one per
+/// escalation level, and steps them side by side - in parallel when the
+/// objective function is flagged as thread safe. The solution of the driver is
+/// the best solution any instance has found over all of its restarts.
+///
+/// An instance is restarted when it has not improved its own best value for
+/// stagnationGenerations generations or when it exhausts its generation
+/// budget. On a restart the instance moves to the next free escalation level
+/// and its budget doubles, so cheap small-population runs are tried often
+/// while expensive large-population runs get the time they need - the
+/// budget balancing idea of the BIPOP scheme. Restarts reuse the already
+/// allocated instance; its internal buffers are recycled by init instead of
+/// being reallocated. The restart point is drawn from the objective function
+/// if it can propose starting points, otherwise the initial point is reused.
+///
+/// The underlying optimizer must be an AbstractSingleObjectiveOptimizer over
+/// RealVector. Population escalation is applied to the CMA; other optimizers
+/// restart with their current configuration.
+template<class Optimizer>
+class RestartStrategy : public AbstractSingleObjectiveOptimizer<RealVector >
+{
+public:
+	/// \brief Constructor.
+	///
+	/// \param numConfigurations number of concurrently racing instances
+	/// \param stagnationGenerations generations without improvement after which an instance is restarted
+	/// \param initialBudget generation budget of the first run of every instance, doubled on every restart
+	RestartStrategy(
+		std::size_t numConfigurations = 2,
+		std::size_t stagnationGenerations = 100,
+		std::size_t initialBudget = 500
+	)
+	: m_instances(numConfigurations)
+	, m_stagnationGenerations(stagnationGenerations)
+	, m_initialBudget(initialBudget)
+	, m_nextLevel(0)
+	, m_function(nullptr){}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "RestartStrategy"; }
+
+	/// \brief Returns the number of concurrently racing instances.
+	std::size_t numberOfConfigurations()const{
+		return m_instances.size();
+	}
+
+	/// \brief Returns the i-th instance, e.g. for configuring its parameters.
+	Optimizer& instance(std::size_t i){
+		return m_instances[i].optimizer;
+	}
+	/// \brief Returns the i-th instance.
+	Optimizer const& instance(std::size_t i)const{
+		return m_instances[i].optimizer;
+	}
+
+	/// \brief Returns the number of generations without improvement which triggers a restart.
+	std::size_t stagnationGenerations()const{
+		return m_stagnationGenerations;
+	}
+	/// \brief Sets the number of generations without improvement which triggers a restart.
+	void setStagnationGenerations(std::size_t stagnationGenerations){
+		m_stagnationGenerations = stagnationGenerations;
+	}
+
+	/// \brief Returns the generation budget of the first run of every instance.
+	std::size_t initialBudget()const{
+		return m_initialBudget;
+	}
+	/// \brief Sets the generation budget of the first run of every instance.
+	void setInitialBudget(std::size_t initialBudget){
+		m_initialBudget = initialBudget;
+	}
+
+	void read( InArchive & archive ){
+		std::size_t numConfigurations = 0;
+		archive>>numConfigurations;
+		m_instances.resize(numConfigurations);
+		for(auto& instance: m_instances){
+			instance.optimizer.read(archive);
+			archive>>instance.level;
+			archive>>instance.budget;
+			archive>>instance.generations;
+			archive>>instance.sinceImprovement;
+			archive>>instance.bestValue;
+		}
+		archive>>m_stagnationGenerations;
+		archive>>m_initialBudget;
+		archive>>m_nextLevel;
+		archive>>m_startingPoint;
+		archive>>m_best.point;
+		archive>>m_best.value;
+	}
+
+	void write( OutArchive & archive ) const{
+		std::size_t numConfigurations = m_instances.size();
+		archive<<numConfigurations;
+		for(auto const& instance: m_instances){
+			instance.optimizer.write(archive);
+			archive<<instance.level;
+			archive<<instance.budget;
+			archive<<instance.generations;
+			archive<<instance.sinceImprovement;
+			archive<<instance.bestValue;
+		}
+		archive<<m_stagnationGenerations;
+		archive<<m_initialBudget;
+		archive<<m_nextLevel;
+		archive<<m_startingPoint;
+		archive<<m_best.point;
+		archive<<m_best.value;
+	}
+
+	/// \brief Initializes one racing instance per escalation level.
+	///
+	/// Instance i starts at escalation level i; the objective function and
+	/// the starting point are remembered for later restarts.
+	void init(ObjectiveFunctionType& objectiveFunction, SearchPointType const& startingPoint){
+		checkFeatures(objectiveFunction);
+		m_function = &objectiveFunction;
+		m_startingPoint = startingPoint;
+		m_nextLevel = m_instances.size();
+		m_best.point = startingPoint;
+		m_best.value = std::numeric_limits<double>::max();
+		for(std::size_t i = 0; i != m_instances.size(); ++i)
+			startRun(m_instances[i], i, m_initialBudget << i, startingPoint);
+	}
+	using AbstractSingleObjectiveOptimizer<RealVector >::init;
+
+	/// \brief Performs one generation on every instance and restarts stagnated ones.
+	///
+	/// Instances are stepped in parallel if the objective function is flagged
+	/// as thread safe.
+	void step(ObjectiveFunctionType const& objectiveFunction){
+		std::size_t numInstances = m_instances.size();
+		if(objectiveFunction.isThreadSafe() && numInstances > 1){
+			SHARK_PARALLEL_FOR(int i = 0; i < (int)numInstances; ++i){
+				stepInstance(m_instances[i], objectiveFunction);
+			}
+		}else{
+			for(auto& instance: m_instances)
+				stepInstance(instance, objectiveFunction);
+		}
+		//collect the elites and restart every instance which stagnated or
+		//exhausted its budget. restarting is serial as it may draw a new
+		//starting point from the objective function
+		for(auto& instance: m_instances){
+			if(instance.optimizer.solution().value < m_best.value)
+				m_best = instance.optimizer.solution();
+			bool stagnated = instance.sinceImprovement >= m_stagnationGenerations;
+			bool exhausted = instance.generations >= instance.budget;
+			if(stagnated || exhausted)
+				restart(instance);
+		}
+	}
+
+private:
+	/// \brief One racing instance together with its restart bookkeeping.
+	struct Instance{
+		Optimizer optimizer;
+		std::size_t level; ///< escalation level of the current run
+		std::size_t budget; ///< generation budget of the current run
+		std::size_t generations; ///< generations performed in the current run
+		std::size_t sinceImprovement; ///< generations since the current run improved
+		double bestValue; ///< best value seen in the current run
+	};
+
+	/// \brief Steps one instance and updates its stagnation bookkeeping.
+	void stepInstance(Instance& instance, ObjectiveFunctionType const& objectiveFunction){
+		instance.optimizer.step(objectiveFunction);
+		++instance.generations;
+		if(instance.optimizer.solution().value < instance.bestValue){
+			instance.bestValue = instance.optimizer.solution().value;
+			instance.sinceImprovement = 0;
+		}else{
+			++instance.sinceImprovement;
+		}
+	}
+
+	/// \brief Begins a run of the given escalation level on an existing instance.
+	void startRun(Instance& instance, std::size_t level, std::size_t budget, SearchPointType const& point){
+		detail::applyRestartLevel(instance.optimizer, point.size(), level);
+		instance.optimizer.init(*m_function, point);
+		instance.level = level;
+		instance.budget = budget;
+		instance.generations = 0;
+		instance.sinceImprovement = 0;
+		instance.bestValue = instance.optimizer.solution().value;
+	}
+
+	/// \brief Restarts an instance on the next free escalation level with doubled budget.
+	void restart(Instance& instance){
+		SearchPointType point = m_startingPoint;
+		if(m_function->canProposeStartingPoint())
+			point = m_function->proposeStartingPoint();
+		startRun(instance, m_nextLevel, 2*instance.budget, point);
+		++m_nextLevel;
+	}
+
+	std::vector<Instance> m_instances; ///< the racing instances
+	std::size_t m_stagnationGenerations; ///< generations without improvement triggering a restart
+	std::size_t m_initialBudget; ///< generation budget of the first run of every instance
+	std::size_t m_nextLevel; ///< escalation level assigned to the next restart
+	SearchPointType m_startingPoint; ///< the point supplied to init, fallback restart point
+	ObjectiveFunctionType* m_function; ///< the function supplied to init, used for restarts
+};
+
+}
+
+#endif
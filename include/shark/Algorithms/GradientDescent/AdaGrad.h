@@ -0,0 +1,160 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       AdaGrad
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_ML_OPTIMIZER_ADAGRAD_H
+#define SHARK_ML_OPTIMIZER_ADAGRAD_H
+
+#include <shark/Algorithms/AbstractSingleObjectiveOptimizer.h>
+
+#include <cmath>
+
+namespace shark{
+
+/// \brief Adaptive (sub)gradient descent (AdaGrad).
+///
+/// AdaGrad accumulates the elementwise squared gradients over all steps and
+/// divides the learning rate of every coordinate by the square root of its
+/// accumulator. Rarely updated coordinates thus keep a large step size while
+/// frequently updated ones are damped, which works well for sparse gradients
+/// and stochastic objectives like a minibatch ErrorFunction; see<br/>
+/// Adaptive Subgradient Methods for Online Learning and Stochastic Optimization.
+/// John Duchi, Elad Hazan and Yoram Singer. JMLR 12, pages 2121-2159, 2011.<br/>
+///
+/// The accumulator is allocated once in init and the update is a single fused
+/// loop over the parameter vector without temporaries. If the objective
+/// function offers its gradient in sparse index/value form, only the listed
+/// coordinates are updated; since the AdaGrad update of a coordinate depends
+/// only on its own gradient history this sparse path is exact.
+class AdaGrad : public AbstractSingleObjectiveOptimizer<RealVector >
+{
+public:
+	AdaGrad() {
+		m_features |= REQUIRES_FIRST_DERIVATIVE;
+
+		m_useSparse = false;
+		m_learningRate = 0.1;
+		m_epsilon = 1.e-8;
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "AdaGrad"; }
+
+	void init(ObjectiveFunctionType & objectiveFunction, SearchPointType const& startingPoint) {
+		checkFeatures(objectiveFunction);
+
+		m_squaredGradSum = RealVector(startingPoint.size(),0.0);
+		m_best.point = startingPoint;
+		m_useSparse = objectiveFunction.hasSparseFirstDerivative();
+		if(m_useSparse)
+			m_best.value = objectiveFunction.evalSparseDerivative(m_best.point,m_sparseDerivative);
+		else
+			m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
+	}
+	using AbstractSingleObjectiveOptimizer<RealVector >::init;
+
+	/*!
+	 *  \brief get learning rate
+	 */
+	double learningRate() const {
+		return m_learningRate;
+	}
+
+	/*!
+	 *  \brief set learning rate
+	 */
+	void setLearningRate(double learningRate) {
+		m_learningRate = learningRate;
+	}
+
+	/*!
+	 *  \brief get the numerical stabilisation added to the denominator
+	 */
+	double epsilon() const {
+		return m_epsilon;
+	}
+
+	/*!
+	 *  \brief set the numerical stabilisation added to the denominator
+	 */
+	void setEpsilon(double epsilon) {
+		m_epsilon = epsilon;
+	}
+
+	/*!
+	 *  \brief accumulates the squared gradient and performs a step
+	 */
+	void step(ObjectiveFunctionType const& objectiveFunction) {
+		if(m_useSparse){
+			//only the coordinates with nonzero gradient change their state
+			for(std::size_t k = 0; k != m_sparseDerivative.indices.size(); ++k){
+				std::size_t i = m_sparseDerivative.indices[k];
+				double g = m_sparseDerivative.values[k];
+				m_squaredGradSum(i) += g * g;
+				m_best.point(i) -= m_learningRate * g / (std::sqrt(m_squaredGradSum(i)) + m_epsilon);
+			}
+			m_best.value = objectiveFunction.evalSparseDerivative(m_best.point,m_sparseDerivative);
+		}else{
+			for(std::size_t i = 0; i != m_best.point.size(); ++i){
+				double g = m_derivative(i);
+				m_squaredGradSum(i) += g * g;
+				m_best.point(i) -= m_learningRate * g / (std::sqrt(m_squaredGradSum(i)) + m_epsilon);
+			}
+			m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
+		}
+	}
+	virtual void read( InArchive & archive )
+	{
+		archive>>m_squaredGradSum;
+		archive>>m_learningRate;
+		archive>>m_epsilon;
+	}
+
+	virtual void write( OutArchive & archive ) const
+	{
+		archive<<m_squaredGradSum;
+		archive<<m_learningRate;
+		archive<<m_epsilon;
+	}
+
+private:
+	RealVector m_squaredGradSum;
+	ObjectiveFunctionType::FirstOrderDerivative m_derivative;
+	ObjectiveFunctionType::SparseFirstOrderDerivative m_sparseDerivative;
+	bool m_useSparse; ///< whether the objective function provides sparse gradients
+	double m_learningRate;
+	double m_epsilon;
+};
+
+}
+#endif
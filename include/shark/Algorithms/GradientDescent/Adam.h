@@ -0,0 +1,223 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Adam
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_ML_OPTIMIZER_ADAM_H
+#define SHARK_ML_OPTIMIZER_ADAM_H
+
+#include <shark/Algorithms/AbstractSingleObjectiveOptimizer.h>
+
+#include <cmath>
+
+namespace shark{
+
+/// \brief Adaptive Moment Estimation (Adam).
+///
+/// Adam keeps exponentially decaying averages of the gradient and of the
+/// elementwise squared gradient and scales every coordinate of the step by
+/// the ratio of the two, so that the effective step size is roughly
+/// independent of the gradient magnitude. This makes it well suited for
+/// stochastic objective functions like a minibatch ErrorFunction, where no
+/// line search is possible; see<br/>
+/// Adam: A Method for Stochastic Optimization. Diederik P. Kingma and Jimmy Ba. ICLR 2015.<br/>
+///
+/// The moment buffers are allocated once in init and the update is a single
+/// fused loop over the parameter vector without temporaries. If the objective
+/// function offers its gradient in sparse index/value form, only the listed
+/// coordinates are updated. The moment averages of untouched coordinates are
+/// decayed lazily: the missed decay steps are applied in one power when the
+/// coordinate is next touched, and parameter entries without gradient keep
+/// their value - the usual sparse approximation of Adam.
+class Adam : public AbstractSingleObjectiveOptimizer<RealVector >
+{
+public:
+	Adam() {
+		m_features |= REQUIRES_FIRST_DERIVATIVE;
+
+		m_useSparse = false;
+		m_learningRate = 0.001;
+		m_beta1 = 0.9;
+		m_beta2 = 0.999;
+		m_epsilon = 1.e-8;
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "Adam"; }
+
+	void init(ObjectiveFunctionType & objectiveFunction, SearchPointType const& startingPoint) {
+		checkFeatures(objectiveFunction);
+
+		m_avgGrad = RealVector(startingPoint.size(),0.0);
+		m_secondMoment = RealVector(startingPoint.size(),0.0);
+		m_counter = 0;
+		m_best.point = startingPoint;
+		m_useSparse = objectiveFunction.hasSparseFirstDerivative();
+		if(m_useSparse){
+			m_lastUpdate.assign(startingPoint.size(),0);
+			m_best.value = objectiveFunction.evalSparseDerivative(m_best.point,m_sparseDerivative);
+		}else{
+			m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
+		}
+	}
+	using AbstractSingleObjectiveOptimizer<RealVector >::init;
+
+	/*!
+	 *  \brief get learning rate
+	 */
+	double learningRate() const {
+		return m_learningRate;
+	}
+
+	/*!
+	 *  \brief set learning rate
+	 */
+	void setLearningRate(double learningRate) {
+		m_learningRate = learningRate;
+	}
+
+	/*!
+	 *  \brief get decay rate of the gradient average
+	 */
+	double beta1() const {
+		return m_beta1;
+	}
+
+	/*!
+	 *  \brief set decay rate of the gradient average
+	 */
+	void setBeta1(double beta1) {
+		m_beta1 = beta1;
+	}
+
+	/*!
+	 *  \brief get decay rate of the squared gradient average
+	 */
+	double beta2() const {
+		return m_beta2;
+	}
+
+	/*!
+	 *  \brief set decay rate of the squared gradient average
+	 */
+	void setBeta2(double beta2) {
+		m_beta2 = beta2;
+	}
+
+	/*!
+	 *  \brief get the numerical stabilisation added to the denominator
+	 */
+	double epsilon() const {
+		return m_epsilon;
+	}
+
+	/*!
+	 *  \brief set the numerical stabilisation added to the denominator
+	 */
+	void setEpsilon(double epsilon) {
+		m_epsilon = epsilon;
+	}
+
+	/*!
+	 *  \brief updates the moment estimates and performs a step
+	 */
+	void step(ObjectiveFunctionType const& objectiveFunction) {
+		++m_counter;
+		//correct the bias of the averages towards their initialisation at 0
+		double bias1 = 1.0 - std::pow(m_beta1, (double)m_counter);
+		double bias2 = 1.0 - std::pow(m_beta2, (double)m_counter);
+		if(m_useSparse){
+			for(std::size_t k = 0; k != m_sparseDerivative.indices.size(); ++k){
+				std::size_t i = m_sparseDerivative.indices[k];
+				double g = m_sparseDerivative.values[k];
+				//apply the decay of the steps this coordinate was skipped in one power
+				double skipped = (double)(m_counter - 1 - m_lastUpdate[i]);
+				if(skipped > 0){
+					m_avgGrad(i) *= std::pow(m_beta1, skipped);
+					m_secondMoment(i) *= std::pow(m_beta2, skipped);
+				}
+				m_lastUpdate[i] = m_counter;
+				m_avgGrad(i) = m_beta1 * m_avgGrad(i) + (1.0 - m_beta1) * g;
+				m_secondMoment(i) = m_beta2 * m_secondMoment(i) + (1.0 - m_beta2) * g * g;
+				m_best.point(i) -= m_learningRate * (m_avgGrad(i) / bias1)
+					/ (std::sqrt(m_secondMoment(i) / bias2) + m_epsilon);
+			}
+			m_best.value = objectiveFunction.evalSparseDerivative(m_best.point,m_sparseDerivative);
+		}else{
+			for(std::size_t i = 0; i != m_best.point.size(); ++i){
+				double g = m_derivative(i);
+				m_avgGrad(i) = m_beta1 * m_avgGrad(i) + (1.0 - m_beta1) * g;
+				m_secondMoment(i) = m_beta2 * m_secondMoment(i) + (1.0 - m_beta2) * g * g;
+				m_best.point(i) -= m_learningRate * (m_avgGrad(i) / bias1)
+					/ (std::sqrt(m_secondMoment(i) / bias2) + m_epsilon);
+			}
+			m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
+		}
+	}
+	virtual void read( InArchive & archive )
+	{
+		archive>>m_avgGrad;
+		archive>>m_secondMoment;
+		archive>>m_counter;
+		archive>>m_learningRate;
+		archive>>m_beta1;
+		archive>>m_beta2;
+		archive>>m_epsilon;
+	}
+
+	virtual void write( OutArchive & archive ) const
+	{
+		archive<<m_avgGrad;
+		archive<<m_secondMoment;
+		archive<<m_counter;
+		archive<<m_learningRate;
+		archive<<m_beta1;
+		archive<<m_beta2;
+		archive<<m_epsilon;
+	}
+
+private:
+	RealVector m_avgGrad;
+	RealVector m_secondMoment;
+	unsigned long m_counter;
+	ObjectiveFunctionType::FirstOrderDerivative m_derivative;
+	ObjectiveFunctionType::SparseFirstOrderDerivative m_sparseDerivative;
+	std::vector<unsigned long> m_lastUpdate; ///< step in which every coordinate was last touched
+	bool m_useSparse; ///< whether the objective function provides sparse gradients
+	double m_learningRate;
+	double m_beta1;
+	double m_beta2;
+	double m_epsilon;
+};
+
+}
+#endif
@@ -0,0 +1,162 @@
+//===========================================================================
+/*!
+ *  \brief Speculative line search evaluating a bracket of step lengths at once
+ *
+ *  Instead of probing candidate step lengths one after another, this
+ *  procedure evaluates a small geometric ladder of step lengths in every
+ *  round - concurrently when the objective function allows it - and selects
+ *  among them by the strong Wolfe conditions. When the evaluations run in
+ *  parallel, the wall-clock critical path of a round is a single function
+ *  evaluation regardless of the bracket width.
+ *
+ *  \author O. Krause
+ *  \date   2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_ALGORITHMS_GRADIENTDESCENT_IMPL_SPECULATIVE_INL
+#define SHARK_ALGORITHMS_GRADIENTDESCENT_IMPL_SPECULATIVE_INL
+
+#include <shark/Core/OpenMP.h>
+#include <vector>
+#include <cmath>
+
+namespace shark {
+
+namespace detail{
+
+/// \brief Speculative line search satisfying the strong Wolfe conditions.
+///
+/// Every round evaluates bracketWidth candidate step lengths spaced by
+/// factors of two around the current guess. A candidate satisfying both
+/// Wolfe conditions ends the search; otherwise the best candidate with
+/// sufficient decrease recenters the next round, or the ladder is moved
+/// below the smallest candidate when none decreases enough. If no candidate
+/// ever satisfies the curvature condition, the best sufficient-decrease
+/// point found is accepted.
+///
+/// \param point            the point the line search starts from; set to the accepted point
+/// \param searchDirection  the direction of the line search
+/// \param value            value of the function at point; set to the accepted value
+/// \param func             the objective function
+/// \param gradient         gradient at point; set to the gradient of the accepted point
+/// \param t                initial step length guess
+/// \param bracketWidth     number of step lengths evaluated per round
+/// \param parallel         whether the candidates of a round may be evaluated concurrently
+template <class VectorT, class Function>
+void speculativeWolfe(
+	VectorT &point,
+	VectorT const& searchDirection,
+	double &value,
+	Function const& func,
+	VectorT &gradient,
+	double t,
+	std::size_t bracketWidth,
+	bool parallel
+) {
+	SIZE_CHECK(point.size() == searchDirection.size());
+	SIZE_CHECK(point.size() == gradient.size());
+
+	// Constants, matching the wolfecubic line search
+	const double c1 = 1e-4;
+	const double c2 = 0.9;
+	const std::size_t maxRounds = 8;
+
+	double gtd = inner_prod(gradient, searchDirection);
+	std::size_t k = bracketWidth;
+
+	std::vector<double> steps(k);
+	std::vector<double> values(k);
+	std::vector<double> gtds(k);
+	std::vector<VectorT> gradients(k, VectorT(point.size()));
+
+	// best candidate with sufficient decrease found so far
+	bool found = false;
+	bool wolfe = false;
+	double bestT = 0.0;
+	double bestF = value;
+	double bestGtd = gtd;
+
+	double center = t;
+	for(std::size_t round = 0; round != maxRounds && !wolfe; ++round){
+		// geometric ladder of candidate steps centered at the current guess
+		for(std::size_t i = 0; i != k; ++i)
+			steps[i] = center * std::pow(2.0, double(i) - (k - 1) / 2.0);
+
+		// speculative evaluation of all candidates of the round
+		if(parallel){
+			SHARK_PARALLEL_FOR(long i = 0; i < (long)k; ++i){
+				values[i] = func.evalDerivative(point + steps[i] * searchDirection, gradients[i]);
+				gtds[i] = inner_prod(gradients[i], searchDirection);
+			}
+		}else{
+			for(std::size_t i = 0; i != k; ++i){
+				values[i] = func.evalDerivative(point + steps[i] * searchDirection, gradients[i]);
+				gtds[i] = inner_prod(gradients[i], searchDirection);
+			}
+		}
+
+		// selection by the strong Wolfe conditions: prefer candidates
+		// satisfying both, otherwise track the best sufficient decrease
+		for(std::size_t i = 0; i != k; ++i){
+			if(values[i] > value + c1 * steps[i] * gtd) continue;//not enough decrease
+			bool curvature = std::abs(gtds[i]) <= -c2 * gtd;
+			//a candidate satisfying both conditions always beats one that only
+			//decreases enough; within the same class the lower value wins
+			bool better = curvature == wolfe? (!found || values[i] < bestF): curvature;
+			if(better){
+				found = true;
+				wolfe = curvature;
+				bestT = steps[i];
+				bestF = values[i];
+				bestGtd = gtds[i];
+				noalias(gradient) = gradients[i];
+			}
+		}
+		if(wolfe) break;
+
+		// recenter the ladder for the next round
+		if(!found){
+			// no candidate decreased enough - move the whole ladder below
+			// the smallest candidate
+			center = steps[0] / std::pow(2.0, double(k));
+		}else if(bestGtd < 0){
+			// still descending at the best candidate - longer steps needed
+			center = bestT * std::pow(2.0, double(k));
+		}else{
+			// overshot the minimum - search between 0 and the best candidate
+			center = bestT / 2.0;
+		}
+	}
+
+	if(found){
+		noalias(point) += bestT * searchDirection;
+		value = bestF;
+	}
+}
+
+}}
+
+
+#endif
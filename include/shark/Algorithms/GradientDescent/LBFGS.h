@@ -42,7 +42,6 @@
 
 #include <shark/Core/DLLSupport.h>
 #include <shark/Algorithms/GradientDescent/AbstractLineSearchOptimizer.h>
-#include <deque>
 
 namespace shark {
 
@@ -52,51 +51,85 @@ protected:
 	SHARK_EXPORT_SYMBOL void initModel();
 	SHARK_EXPORT_SYMBOL void computeSearchDirection();
 public:
-	LBFGS() :m_numHist(100){}
+	/// \brief Scaling of the initial Hessian approximation H_0 = hdiag * I.
+	enum HessianScaling {
+		SCALING_IDENTITY, ///< H_0 = I
+		SCALING_GAMMA,    ///< H_0 = <s,y>/<y,y> * I, rescaled after every update (default)
+		SCALING_FIXED     ///< H_0 = initialHessianScale * I
+	};
+
+	LBFGS() :m_numHist(100), m_scaling(SCALING_GAMMA), m_fixedScale(1.0){}
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
 	{ return "LBFGS"; }
-	
+
 	///  \brief Specify the amount of steps to be memorized and used to find the L-BFGS direction.
 	///
+	/// Takes effect at the next call to init, which allocates the history buffers.
+	///
 	///\param numhist The amount of steps to use.
 	void setHistCount(unsigned int numhist) {
 		SHARK_CHECK(numhist > 0, "[LBFGS::setHistCount] An empty history is not allowed");
 		m_numHist = numhist;
 	}
 
+	/// \brief Returns the scaling of the initial Hessian approximation.
+	HessianScaling hessianScaling() const{
+		return m_scaling;
+	}
+
+	/// \brief Sets the scaling of the initial Hessian approximation.
+	void setHessianScaling(HessianScaling scaling){
+		m_scaling = scaling;
+	}
+
+	/// \brief Returns the scale of the initial Hessian approximation used with SCALING_FIXED.
+	double initialHessianScale() const{
+		return m_fixedScale;
+	}
+
+	/// \brief Sets the scale of the initial Hessian approximation used with SCALING_FIXED.
+	void setInitialHessianScale(double scale){
+		SHARK_CHECK(scale > 0, "[LBFGS::setInitialHessianScale] scale must be positive");
+		m_fixedScale = scale;
+	}
+
 	//from ISerializable
 	SHARK_EXPORT_SYMBOL void read(InArchive &archive);
 	SHARK_EXPORT_SYMBOL void write(OutArchive &archive) const;
 protected: // Methods
 
-	///\brief Stores another step and searchDirection, discarding the oldest on if necessary.
-	///
-	/// \param step Last performed step
-	/// \param y difference in gradients
-	SHARK_EXPORT_SYMBOL void updateHist(RealVector& y, RealVector &step);
-	/// \brief Get the LBFGS direction. 
+	///\brief Stores the last step and gradient difference in the ring buffer, overwriting the oldest pair if necessary.
+	SHARK_EXPORT_SYMBOL void updateHist();
+	/// \brief Get the LBFGS direction.
 	///
-	/// This approximates the inverse hessian multiplied by the gradient.
-	/// This uses the rho, alpha and beta vectors. Description of these
-	/// can be seen in ie. the wiki page of LBFGS.
+	/// This approximates the inverse hessian multiplied by the gradient
+	/// using the two-loop recursion over the stored (s,y) pairs. The axpy
+	/// of one loop iteration is fused with the dot product of the next,
+	/// so every stored pair is swept exactly once per loop.
 	SHARK_EXPORT_SYMBOL void getDirection(RealVector& searchDirection);
 
 
 protected: // Instance vars
 	double m_updThres;///<Threshold for when to update history.
 	unsigned int m_numHist; ///< Number of steps to use for LBFGS.
+	HessianScaling m_scaling; ///< scaling of the initial Hessian approximation
+	double m_fixedScale; ///< scale used with SCALING_FIXED
 	// Initial Hessian approximation. We use a diagonal matrix, where each element is
 	// the same, so we only need to store one double.
 	double          m_hdiag;
 
-	// Saved steps for creating the approximation.
-	// Use deque as it gives fast pop.front, push.back and access. Supposedly.
-	// steps holds the values x_(k+1) - x_k
-	// gradientDifferences holds the values g_(k+1) - g_k
-	std::deque<RealVector> m_steps;
-	std::deque<RealVector> m_gradientDifferences;
+	// Ring buffer of the last m_numHist update pairs, allocated once in initModel.
+	// Row i of m_steps holds a value x_(k+1) - x_k
+	// Row i of m_gradientDifferences holds the matching g_(k+1) - g_k
+	// m_rho caches 1/<s,y> of every stored pair.
+	RealMatrix m_steps;
+	RealMatrix m_gradientDifferences;
+	RealVector m_rho;
+	RealVector m_alpha; ///< two-loop coefficients, preallocated
+	std::size_t m_histCount; ///< number of valid pairs in the ring buffer
+	std::size_t m_histPos; ///< slot the next pair is written to (the oldest when full)
 };
 
 }
@@ -39,6 +39,7 @@
 #include <shark/Core/ISerializable.h>
 #include "Impl/wolfecubic.inl"
 #include "Impl/dlinmin.inl"
+#include "Impl/speculative.inl"
 #include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
 
 namespace shark {
@@ -51,7 +52,8 @@ class LineSearch:public ISerializable {
 public:
 	enum LineSearchType {
 	    Dlinmin,
-	    WolfeCubic
+	    WolfeCubic,
+	    Speculative ///< evaluates a bracket of step lengths at once, concurrently if the function is thread safe
 	};
 	typedef AbstractObjectiveFunction<RealVector,double> ObjectiveFunction;
 
@@ -60,6 +62,7 @@ public:
 	LineSearch() {
 		m_minInterval=0;
 		m_maxInterval=1;
+		m_bracketWidth=4;
 		m_lineSearchType=Dlinmin;
 	}
 
@@ -85,6 +88,14 @@ public:
 	double &maxInterval() {
 		return m_maxInterval;
 	}
+	///bracketWidth sets the number of step lengths evaluated per round of the speculative search
+	std::size_t bracketWidth()const {
+		return m_bracketWidth;
+	}
+	///bracketWidth sets the number of step lengths evaluated per round of the speculative search
+	std::size_t &bracketWidth() {
+		return m_bracketWidth;
+	}
 
 	///initializes the internal state of the LineSearch class and sets the function on which the lineSearch is to be evaluated
 	void init(ObjectiveFunction const& objectiveFunction) {
@@ -101,11 +112,19 @@ public:
 		switch (m_lineSearchType) {
 		case Dlinmin:
 			detail::dlinmin(searchPoint, newtonDirection, pointValue, *m_function, m_minInterval, m_maxInterval);
-			m_function->evalDerivative(searchPoint, derivative);
+			//the fused call returns the exact value along with the gradient;
+			//functions caching their forward pass skip the re-evaluation entirely
+			pointValue = m_function->evalDerivative(searchPoint, derivative);
 			break;
 		case WolfeCubic:
 			detail::wolfecubic(searchPoint, newtonDirection, pointValue, *m_function, derivative, stepLength);
 			break;
+		case Speculative:
+			detail::speculativeWolfe(
+				searchPoint, newtonDirection, pointValue, *m_function, derivative,
+				stepLength, m_bracketWidth, m_function->isThreadSafe()
+			);
+			break;
 		}
 	}
 
@@ -113,12 +132,14 @@ public:
 	virtual void read(InArchive &archive) {
 		archive>>m_minInterval;
 		archive>>m_maxInterval;
+		archive>>m_bracketWidth;
 		archive>>m_lineSearchType;
 	}
 
 	virtual void write(OutArchive &archive) const {
 		archive<<m_minInterval;
 		archive<<m_maxInterval;
+		archive<<m_bracketWidth;
 		archive<<m_lineSearchType;
 	}
 
@@ -128,6 +149,8 @@ protected:
 	double m_minInterval;
 	///initial [min,max] bracket for linesearch
 	double m_maxInterval;
+	///number of step lengths evaluated per round of the speculative search
+	std::size_t m_bracketWidth;
 
 	LineSearchType m_lineSearchType;
 
@@ -62,10 +62,18 @@ namespace shark {
 /// is set by a forcing-schedule so that accuracy increases in the vicinity of the
 /// optimum, enabling solutions with arbitrary precision.
 ///
-/// The algorithm is based on 
+/// The algorithm is based on
 /// Jorge Nocedal, Stephen J. Wright
 /// Numerical Optimization, 2nd Edition
 /// Algorithm 4.1 with Algorithm 7.2 to solve the sub-problem
+///
+/// By default the full Hessian is queried from the objective function, which is
+/// infeasible for large parameter vectors. Enabling the Hessian-free mode via
+/// setHessianFree replaces the explicit Hessian by Hessian-vector products,
+/// approximated by a forward finite difference of the gradient along the CG
+/// direction. Then only first derivatives are required and every inner CG
+/// iteration costs one additional gradient evaluation, so the method scales to
+/// models with millions of parameters.
 class TrustRegionNewton : public AbstractSingleObjectiveOptimizer<RealVector >
 {
 public:
@@ -96,12 +104,30 @@ public:
 		return m_minImprovementRatio;
 	}
 
+	/// \brief Whether Hessian-vector products are approximated matrix-free by finite differences of the gradient.
+	bool hessianFree()const{
+		return m_hessianFree;
+	}
+
+	/// \brief Enables or disables the matrix-free mode. Must be set before init.
+	///
+	/// In the matrix-free mode the objective function only needs to provide
+	/// first derivatives; the explicit Hessian is never formed.
+	void setHessianFree(bool hessianFree){
+		m_hessianFree = hessianFree;
+		if(m_hessianFree)
+			m_features.reset(REQUIRES_SECOND_DERIVATIVE);
+		else
+			m_features |= REQUIRES_SECOND_DERIVATIVE;
+	}
+
 	/// \brief Perform one trust region Newton step, update point and trust region radius.
 	SHARK_EXPORT_SYMBOL void step(ObjectiveFunctionType const& objectiveFunction);
 
 protected:
 	double m_delta;                                               ///< Current trust region size
 	double m_minImprovementRatio;                                 ///< Minimal improvement ratio (see the algorithm details in the class description).
+	bool m_hessianFree;                                           ///< Whether the Hessian is replaced by finite-difference Hessian-vector products.
 	ObjectiveFunctionType::SecondOrderDerivative m_derivatives;   ///< First and second derivative of the objective function in the current point.
 };
 }
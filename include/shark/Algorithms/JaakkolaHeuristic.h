@@ -38,7 +38,10 @@
 
 
 #include <shark/Data/Dataset.h>
+#include <shark/Data/DataView.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Core/Traits/ProxyReferenceTraits.h>
+#include <shark/Rng/GlobalRng.h>
 
 #include <boost/range/adaptor/filtered.hpp>
 #include <algorithm>
@@ -68,13 +71,17 @@ public:
 	/// Constructor
 	/// \param dataset           vector-valued input data
 	/// \param nearestFalseNeighbor  if true, only the nearest neighboring point with different label is considered (default true)
+	/// \param maxPairs          if nonzero, the distance distribution is estimated from this many randomly sampled pairs instead of a full enumeration (default 0)
 	template<class InputType>
-	JaakkolaHeuristic(LabeledData<InputType,unsigned int> const& dataset, bool nearestFalseNeighbor = true)
+	JaakkolaHeuristic(LabeledData<InputType,unsigned int> const& dataset, bool nearestFalseNeighbor = true, std::size_t maxPairs = 0)
 	{
 		typedef typename LabeledData<InputType,unsigned int>::const_element_range Elements;
 		typedef typename ConstProxyReference<InputType const>::type Element;
 		Elements elements = dataset.elements();
-		if(!nearestFalseNeighbor) {
+		if(maxPairs > 0){
+			sampleDistances(dataset, nearestFalseNeighbor, maxPairs);
+		}
+		else if(!nearestFalseNeighbor) {
 			for(typename Elements::iterator it = elements.begin(); it != elements.end(); ++it){
 				Element x = it->input;
 				typename Elements::iterator itIn = it;
@@ -144,11 +151,10 @@ public:
 				//~ }
 				//~ m_stat.push_back(minDistSqr);
 			//~ }
-			
+
 		}
-		std::sort(m_stat.begin(), m_stat.end());
 	}
-		
+
 	/// Compute the given quantile (usually median)
 	/// of the empirical distribution of Euclidean distances
 	/// of data pairs with different labels.
@@ -157,25 +163,25 @@ public:
 		std::size_t ic = m_stat.size();
 		SHARK_ASSERT(ic > 0);
 
-		std::sort(m_stat.begin(), m_stat.end());
-
 		if (quantile < 0.0)
 		{
-			// TODO: find minimum
-			return std::sqrt(m_stat[0]);
+			return std::sqrt(*std::min_element(m_stat.begin(), m_stat.end()));
 		}
 		if (quantile >= 1.0)
 		{
-			// TODO: find maximum
-			return std::sqrt(m_stat[ic-1]);
+			return std::sqrt(*std::max_element(m_stat.begin(), m_stat.end()));
 		}
 		else
 		{
-			// TODO: partial sort!
+			//select the required order statistic instead of sorting all distances
 			double t = quantile * (ic - 1);
 			std::size_t i = (std::size_t)floor(t);
 			double rest = t - i;
-			return ((1.0 - rest) * std::sqrt(m_stat[i]) + rest * std::sqrt(m_stat[i+1]));
+			std::nth_element(m_stat.begin(), m_stat.begin() + i, m_stat.end());
+			if (rest == 0.0)
+				return std::sqrt(m_stat[i]);
+			double next = *std::min_element(m_stat.begin() + i + 1, m_stat.end());
+			return ((1.0 - rest) * std::sqrt(m_stat[i]) + rest * std::sqrt(next));
 		}
 	}
 
@@ -191,6 +197,47 @@ public:
 
 
 private:
+	/// \brief Estimates the distance distribution from randomly sampled pairs.
+	///
+	/// Draws maxPairs pairs of elements with different labels uniformly at
+	/// random, so that memory and time grow with the number of samples and not
+	/// quadratically with the dataset. If nearestFalseNeighbor is set, one
+	/// anchor element is sampled per pair instead and its exact distance to the
+	/// closest point with different label enters the statistic, which costs one
+	/// pass over the data per sample. Samples are seeded individually so that
+	/// they can be computed in parallel.
+	template<class InputType>
+	void sampleDistances(LabeledData<InputType,unsigned int> const& dataset, bool nearestFalseNeighbor, std::size_t maxPairs){
+		SHARK_CHECK(numberOfClasses(dataset) > 1, "[JaakkolaHeuristic] sampling requires more than one class");
+		DataView<LabeledData<InputType,unsigned int> const> view(dataset);
+		std::size_t numElements = view.size();
+		m_stat.resize(maxPairs);
+		int baseSeed = Rng::discrete(0,std::numeric_limits<int>::max());
+		SHARK_PARALLEL_FOR(int s = 0; s < (int)maxPairs; ++s){
+			Rng::rng_type rng(maxPairs * baseSeed + s);
+			DiscreteUniform<Rng::rng_type> uni(rng, 0, numElements - 1);
+			if(nearestFalseNeighbor){
+				std::size_t anchor = uni();
+				unsigned int label = view[anchor].label;
+				double minDistSqr = std::numeric_limits<double>::max();
+				for(std::size_t k = 0; k != numElements; ++k){
+					if(view[k].label == label) continue;
+					minDistSqr = std::min(minDistSqr, distanceSqr(view[anchor].input, view[k].input));
+				}
+				m_stat[s] = minDistSqr;
+			}
+			else{
+				std::size_t i = uni();
+				std::size_t j = uni();
+				while(view[i].label == view[j].label){
+					i = uni();
+					j = uni();
+				}
+				m_stat[s] = distanceSqr(view[i].input, view[j].input);
+			}
+		}
+	}
+
 	/// all pairwise distances
 	std::vector<double> m_stat;
 };
@@ -104,6 +104,36 @@ SHARK_EXPORT_SYMBOL std::size_t kMeans(Data<RealVector> const& data, std::size_t
 ///
 SHARK_EXPORT_SYMBOL std::size_t kMeans(Data<RealVector> const& data, RBFLayer& model, std::size_t maxIterations = 0);
 
+///
+/// \brief Minibatch k-means clustering for large data sets.
+///
+/// \par
+/// Instead of sweeping over the whole data set, every iteration assigns a
+/// random sample of points to the current centroids and then moves every
+/// centroid towards its sampled points, with a per-centroid learning rate
+/// that decays with the number of points the centroid has seen. This gives
+/// a fast approximation of the k-means solution on data sets too large for
+/// full batch iterations and is also useful for refining existing centroids
+/// on streaming data; see<br/>
+/// D. Sculley. Web-scale k-means clustering. WWW, 2010.
+///
+/// \par
+/// As in \ref kMeans, the search starts from the given centroids if the
+/// centroids object already contains k clusters, otherwise from the first
+/// k data points.
+///
+/// \param data           vector-valued data to be clustered
+/// \param k              number of clusters
+/// \param centroids      centroids input/output
+/// \param iterations     number of minibatch iterations
+/// \param batchSize      number of points sampled per iteration
+/// \return               number of iterations
+///
+SHARK_EXPORT_SYMBOL std::size_t kMeansMinibatch(
+	Data<RealVector> const& data, std::size_t k, Centroids& centroids,
+	std::size_t iterations = 100, std::size_t batchSize = 1000
+);
+
 ///
 /// \brief The kernel k-means clustering algorithm
 ///
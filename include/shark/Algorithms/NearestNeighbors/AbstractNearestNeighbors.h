@@ -55,7 +55,27 @@ public:
 	///Given a batch of size n, a array with nxk values is returned where each entry is a key-value pair of distance and label.
 	///the first k entries are the neighbors of point 1, the next k of point 2 and so on.
 	virtual std::vector<DistancePair> getNeighbors(BatchInputType const& batch, std::size_t k) const = 0;
-	
+
+	///\brief Returns the k-nearest neighbors of a batch of points as a distance matrix and a batch of labels.
+	///
+	///Given a batch of size n, the distances are returned as an nxk matrix and the labels as one
+	///batch of nxk elements in the same linearized order as in the pair-based query. Keeping the
+	///results in batch form allows the caller to process whole neighborhoods with matrix operations.
+	///The default implementation reassembles the output of the pair-based query; implementations
+	///can override it to fill the matrices directly.
+	virtual void getNeighbors(BatchInputType const& batch, std::size_t k, RealMatrix& distances, typename Batch<LabelType>::type& labels) const{
+		std::vector<DistancePair> results = getNeighbors(batch, k);
+		std::size_t numPoints = results.size() / k;
+		distances.resize(numPoints, k);
+		labels = Batch<LabelType>::createBatch(results[0].value, numPoints * k);
+		for(std::size_t p = 0; p != numPoints; ++p){
+			for(std::size_t i = 0; i != k; ++i){
+				distances(p,i) = results[i+p*k].key;
+				get(labels, i+p*k) = results[i+p*k].value;
+			}
+		}
+	}
+
 	///\brief returns a const reference to the dataset used by the algorithm
 	virtual LabeledData<InputType,LabelType>const& dataset()const = 0;
 
@@ -45,8 +45,15 @@ namespace shark {
 
 ///\brief Brute force optimized nearest neighbor implementation
 ///
-///Returns the labels and distances of the k nearest neighbors of a point 
-/// The distance is measured using an arbitrary metric
+///Returns the labels and distances of the k nearest neighbors of a point.
+///The distance is measured using an arbitrary metric.
+///
+///The search is blocked: every thread computes the full distance matrix
+///between the query batch and one batch of the training set through the
+///metric's batch interface — for the Euclidean metric (LinearKernel) this
+///is a single gemm — and folds its rows directly into per-thread k-element
+///heaps. The heaps are merged at the end, so no full distance column is
+///ever stored or sorted.
 template<class InputType, class LabelType>
 class SimpleNearestNeighbors:public AbstractNearestNeighbors<InputType,LabelType>{
 private:
@@ -66,6 +73,9 @@ public:
 	SimpleNearestNeighbors(Dataset const& dataset, Metric const* metric)
 	:m_dataset(dataset), mep_metric(metric){}
 
+	//makes the batched matrix-returning query of the base class available as well
+	using base_type::getNeighbors;
+
 	///\brief Return the k nearest neighbors of the query point.
 	std::vector<DistancePair> getNeighbors(BatchInputType const& patterns, std::size_t k)const{
 		std::size_t numPatterns = size(patterns);
@@ -83,11 +93,11 @@ public:
 		SHARK_PARALLEL_FOR(int b = 0; b < (int)m_dataset.numberOfBatches(); ++b){
 			//evaluate distances between the points of the patterns and the batch
 			RealMatrix distances=mep_metric->featureDistanceSqr(patterns,m_dataset.batch(b).input);
-			
+			std::size_t batchSize = distances.size2();
+
 			//now update the heaps with the distances
 			for(std::size_t p = 0; p != numPatterns; ++p){
-				std::size_t batchSize = distances.size2();
-				
+
 				//get current heap
 				std::size_t heap = p*maxThreads+SHARK_THREAD_NUM;
 				iterator heapStart=heaps.begin()+heap*k;
@@ -40,6 +40,8 @@
 #include <shark/Models/Trees/BinaryTree.h>
 #include <shark/Algorithms/NearestNeighbors/AbstractNearestNeighbors.h>
 #include <shark/Data/DataView.h>
+#include <shark/Core/OpenMP.h>
+#include <algorithm>
 namespace shark {
 
 
@@ -70,10 +72,11 @@ namespace shark {
 /// out the be the (current) nearest neighbor.
 ///
 /// \par
-/// The tree must have a bucket size of one, but leaf nodes
-/// with multiple copies of the same point are allowed.
-/// This means that the space partitioning must be carried
-/// out to the finest possible scale.
+/// Leaf nodes may hold buckets of multiple points. The
+/// distances of all points of a bucket to the reference
+/// point are computed in one contiguous scan when the leaf
+/// is first visited and the points are returned in order of
+/// increasing distance.
 ///
 /// The Data must be sotred in a random access container. This means that elements
 /// have O(1) access time. This is crucial for the performance of the tree lookup.
@@ -94,7 +97,6 @@ public:
 	IterativeNNQuery(tree_type const* tree, DataContainer const& data, value_type const& point)
 	: m_data(data)
 	, m_reference(point)
-	, m_nextIndex(0)
 	, mp_trace(NULL)
 	, mep_head(NULL)
 	, m_squaredRadius(0.0)
@@ -132,21 +134,11 @@ public:
 
 	/// find and return the next nearest neighbor
 	result_type next() {
-		if (m_neighbors >= mp_trace->m_tree->size()) 
+		if (m_neighbors >= mp_trace->m_tree->size())
 			throw SHARKEXCEPTION("[IterativeNNQuery::next] no more neighbors available");
 
 		assert(! m_queue.empty());
 
-		// Check whether the current node has points
-		// left, or whether it should be discarded.
-		if (m_neighbors > 0){
-			TraceLeaf& q = *m_queue.begin();
-			if (m_nextIndex < q.m_tree->size()){
-				return getNextPoint(q);
-			}
-			else
-				m_queue.erase(q);
-		}
 		if (m_queue.empty() || (*m_queue.begin()).m_squaredPtDistance > m_squaredRadius){
 			// enqueue more points
 			TraceNode* tn = mep_head;
@@ -159,9 +151,16 @@ public:
 			// re-compute the radius
 			m_squaredRadius = mp_trace->squaredRadius(m_reference);
 		}
-		m_nextIndex = 0;
+		// return the closest pending point. The leaf is re-inserted into the
+		// queue keyed by the distance of its next point, so that the points
+		// of a bucket interleave correctly with those of other leaves.
+		TraceLeaf& q = *m_queue.begin();
+		m_queue.erase(q);
+		result_type result = q.pop();
+		if (! q.exhausted())
+			m_queue.insert_unique(q);
 		++m_neighbors;
-		return getNextPoint(*m_queue.begin());
+		return result;
 	}
 
 	/// return the size of the queue,
@@ -259,39 +258,70 @@ private:
 	typedef boost::intrusive::set_base_hook<> HookType;
 
 	/// Leaves of the three have three roles:
-	/// (1) they are tree nodes holding exactly one point
-	///     (possibly multiple copies of this point),
-	/// (2) they know the distance of their point to the
-	///     reference point,
-	/// (3) they can be added to the candidates queue.
+	/// (1) they are tree nodes holding a bucket of points,
+	/// (2) they know the distances of their points to the
+	///     reference point, sorted in increasing order,
+	/// (3) they can be added to the candidates queue, keyed
+	///     by the distance of their next unreturned point.
 	class TraceLeaf : public TraceNode, public HookType
 	{
 	public:
 		/// Constructor
 		TraceLeaf(tree_type const* tree, TraceNode* parent, DataContainer const& data, value_type const& ref)
-		: TraceNode(tree, parent, ref){
-			//check whether the tree uses a differen metric than a linear one.
-			if(tree->kernel() != NULL)
-				m_squaredPtDistance = tree->kernel()->featureDistanceSqr(data[tree->index(0)], ref);
-			else
-				m_squaredPtDistance = distanceSqr(data[tree->index(0)], ref);
+		: TraceNode(tree, parent, ref)
+		, m_nextPoint(0){
+			//compute the distance of every point of the bucket to the
+			//reference point in one scan over the contiguous index list
+			m_points.resize(tree->size());
+			for(std::size_t i = 0; i != tree->size(); ++i){
+				std::size_t index = tree->index(i);
+				//check whether the tree uses a differen metric than a linear one.
+				double dist;
+				if(tree->kernel() != NULL)
+					dist = tree->kernel()->featureDistanceSqr(data[index], ref);
+				else
+					dist = distanceSqr(data[index], ref);
+				m_points[i] = std::make_pair(dist,index);
+			}
+			std::sort(m_points.begin(),m_points.end());
+			m_squaredPtDistance = m_points[0].first;
 		}
 
 		/// Destructor
 		~TraceLeaf() { }
 
+		/// Return the next point of the bucket and advance the sort key
+		/// to the distance of the point after it.
+		result_type pop(){
+			result_type result(std::sqrt(m_points[m_nextPoint].first), m_points[m_nextPoint].second);
+			++m_nextPoint;
+			if (m_nextPoint != m_points.size())
+				m_squaredPtDistance = m_points[m_nextPoint].first;
+			return result;
+		}
+
+		/// Returns whether all points of the bucket have been returned.
+		bool exhausted() const{
+			return m_nextPoint == m_points.size();
+		}
 
 		/// Comparison by distance, ties are broken arbitrarily,
 		/// but deterministically, by tree node pointer.
 		inline bool operator < (TraceLeaf const& rhs) const{
-			if (m_squaredPtDistance == rhs.m_squaredPtDistance) 
+			if (m_squaredPtDistance == rhs.m_squaredPtDistance)
 				return (this->m_tree < rhs.m_tree);
 			else
 				return (m_squaredPtDistance < rhs.m_squaredPtDistance);
 		}
 
-		/// Squared distance of the single point in the leaf to the reference point.
+		/// Squared distance of the next unreturned point of the bucket to the reference point.
 		double m_squaredPtDistance;
+
+		/// squared distances and indices of the points of the bucket, sorted by distance
+		std::vector<std::pair<double,std::size_t> > m_points;
+
+		/// position of the next unreturned point in m_points
+		std::size_t m_nextPoint;
 	};
 
 	/// insert a point into the queue
@@ -322,13 +352,6 @@ private:
 		}
 	}
 
-	result_type getNextPoint(TraceLeaf const& leaf){
-		double dist = std::sqrt(leaf.m_squaredPtDistance);
-		std::size_t index = leaf.m_tree->index(m_nextIndex);
-		++m_nextIndex;
-		return std::make_pair(dist,index);
-	}
-
 	/// Recursively descend the node and enqueue
 	/// all points in cells intersecting the
 	/// current bounding sphere.
@@ -381,10 +404,6 @@ private:
 	/// queue of candidates
 	QueueType m_queue;
 
-	/// index of the next not yet returned element
-	/// of the current leaf.
-	std::size_t m_nextIndex;
-
 	/// recursion trace tree
 	TraceNode* mp_trace;
 
@@ -425,7 +444,9 @@ public:
 	std::vector<DistancePair> getNeighbors(BatchInputType const& patterns, std::size_t k)const{
 		std::size_t numPoints = shark::size(patterns);
 		std::vector<DistancePair> results(k*numPoints);
-		for(std::size_t p = 0; p != numPoints; ++p){
+		//the queries are independent of each other and the tree is only
+		//read, so the patterns of the batch are processed in parallel
+		SHARK_PARALLEL_FOR(int p = 0; p < (int)numPoints; ++p){
 			IterativeNNQuery<DataView<Data<InputType> const> > query(mep_tree, m_inputs, get(patterns, p));
 			//find the neighbors using the queries
 			for(std::size_t i = 0; i != k; ++i){
@@ -437,6 +458,29 @@ public:
 		return results;
 	}
 
+	///\brief returns the k nearest neighbors of the batch as a distance matrix and a batch of labels
+	///
+	/// The traversals themselves stay independent per query point, but the per-neighbor
+	/// key-value pairs are skipped: only the dataset indices leave the parallel region
+	/// and the labels are gathered into one batch in a single scan afterwards. This
+	/// avoids a label copy per neighbor, which matters for vectorial labels.
+	void getNeighbors(BatchInputType const& patterns, std::size_t k, RealMatrix& distances, typename Batch<LabelType>::type& labels)const{
+		std::size_t numPoints = shark::size(patterns);
+		distances.resize(numPoints, k);
+		std::vector<std::size_t> indices(k*numPoints);
+		SHARK_PARALLEL_FOR(int p = 0; p < (int)numPoints; ++p){
+			IterativeNNQuery<DataView<Data<InputType> const> > query(mep_tree, m_inputs, get(patterns, p));
+			for(std::size_t i = 0; i != k; ++i){
+				typename IterativeNNQuery<DataView<Data<InputType> const> >::result_type result = query.next();
+				distances(p,i) = result.first;
+				indices[i+p*k] = result.second;
+			}
+		}
+		labels = Batch<LabelType>::createBatch(m_labels[indices[0]], k*numPoints);
+		for(std::size_t j = 0; j != indices.size(); ++j)
+			get(labels, j) = m_labels[indices[j]];
+	}
+
 	LabeledData<InputType,LabelType>const& dataset()const {
 		return m_dataset;
 	}
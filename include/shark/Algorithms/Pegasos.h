@@ -39,6 +39,7 @@
 
 #include <shark/LinAlg/Base.h>
 #include <shark/Data/Dataset.h>
+#include <shark/Data/DataView.h>
 #include <shark/Rng/GlobalRng.h>
 #include <cmath>
 #include <iostream>
@@ -59,6 +60,13 @@ public:
 	/// In addition to "standard" Pegasos this solver checks a
 	/// meaningful stopping criterion.
 	///
+	/// With averaging enabled the solver returns the mean of all
+	/// iterates instead of the last one, which smooths out the
+	/// oscillations of the projected subgradient steps. The running
+	/// mean is maintained through a correction vector updated only
+	/// on the non-zero pattern of each gradient estimate, so the
+	/// cost per step stays proportional to the batch sparsity.
+	///
 	/// The function returns the number of model predictions
 	/// during training (this is comparable to SMO iterations).
 	template <class WeightType>
@@ -67,18 +75,29 @@ public:
 			double C,                                           ///< SVM regularization parameter
 			WeightType& w,                                      ///< weight vector
 			std::size_t batchsize = 1,                          ///< number of samples in each gradient estimate
-			double varepsilon = 0.001)                          ///< solution accuracy (factor by which the primal gradient should be reduced)
+			double varepsilon = 0.001,                          ///< solution accuracy (factor by which the primal gradient should be reduced)
+			bool average = false)                               ///< return the average of all iterates instead of the last one?
 	{
 		std::size_t ell = data.numberOfElements();
 		double lambda = 1.0 / (ell * C);
 		SHARK_ASSERT(batchsize > 0);
+		DataView<LabeledData<VectorType, unsigned int> const> view(data);
 
 		double initialPrimal = 1.0;
 		double normbound2 = initialPrimal / lambda;     // upper bound for |sigma * w|^2
 		double norm_w2 = 0.0;                           // squared norm of w
 		double sigma = 1.0;                             // scaling factor for w
 		VectorType gradient(w.size());                  // gradient (to be computed in each iteration)
-		w = RealZeroVector(w.size());                   // clear does not work on matrix rows (ublas sucks!)
+		w = blas::repeat(0.0, w.size());                // clear does not work on matrix rows
+
+		// state of the iterate average. the average of the iterates
+		// sigma_t * w_t is represented as (sigmasum * w + correction)
+		// divided by the number of iterations, which allows for sparse
+		// updates of the correction vector.
+		double sigmasum = 0.0;                          // sum of the scaling factors of all iterates
+		std::size_t iterates = 0;                       // number of averaged iterates
+		VectorType correction;                          // sum over all steps, weighted by the scaling factors preceding them
+		if (average) correction = blas::repeat(0.0, w.size());
 
 		// pegasos main loop
 		std::size_t start = 10;
@@ -94,8 +113,8 @@ public:
 				gradient = (lambda * sigma * (double)ell) * w;
 				for (std::size_t i=0; i<ell; i++)
 				{
-					VectorType const& x = data(i).input;
-					unsigned int y = data(i).label;
+					VectorType const& x = view[i].input;
+					unsigned int y = view[i].label;
 					double f = sigma * inner_prod(w, x);
 					lg(x, y, f, gradient);
 				}
@@ -124,8 +143,8 @@ public:
 			{
 				// select the active variable (sample with replacement)
 				std::size_t active = Rng::discrete(0, ell-1);
-				VectorType const& x = data(active).input;
-				unsigned int y = data(active).label;
+				VectorType const& x = view[active].input;
+				unsigned int y = view[active].label;
 				SHARK_ASSERT(y < 2);
 
 				// compute the prediction
@@ -144,15 +163,22 @@ public:
 				gradient *= eta;
 				norm_w2 += inner_prod(gradient, gradient) - 2.0 * inner_prod(w, gradient);
 				noalias(w) -= gradient;
+				if (average) noalias(correction) += sigmasum * gradient;
 
 				// project to the ball
 				double n2 = sigma * sigma * norm_w2;
 				if (n2 > normbound2) sigma *= std::sqrt(normbound2 / n2);
 			}
+			if (average)
+			{
+				sigmasum += sigma;
+				iterates++;
+			}
 		}
 
 		// rescale the solution
-		w *= sigma;
+		if (average) w = (1.0 / (double)iterates) * (sigmasum * w + correction);
+		else w *= sigma;
 		return predictions;
 	}
 
@@ -212,7 +238,8 @@ public:
 	/// \brief Solve the primal multi-class SVM problem.
 	///
 	/// In addition to "standard" Pegasos this solver checks a
-	/// meaningful stopping criterion.
+	/// meaningful stopping criterion. Averaging of the iterates
+	/// is available exactly as in the binary solver.
 	///
 	/// The function returns the number of model predictions
 	/// during training (this is comparable to SMO iterations).
@@ -225,10 +252,12 @@ public:
 			double C,                                           ///< SVM regularization parameter
 			std::vector<WeightType>& w,                         ///< class-wise weight vectors
 			std::size_t batchsize = 1,                          ///< number of samples in each gradient estimate
-			double varepsilon = 0.001)                          ///< solution accuracy (factor by which the primal gradient should be reduced)
+			double varepsilon = 0.001,                          ///< solution accuracy (factor by which the primal gradient should be reduced)
+			bool average = false)                               ///< return the average of all iterates instead of the last one?
 	{
 		SHARK_ASSERT(batchsize > 0);
 		std::size_t ell = data.numberOfElements();
+		DataView<LabeledData<VectorType, unsigned int> const> view(data);
 		unsigned int classes = w.size();
 		SHARK_ASSERT(classes >= 2);
 		double lambda = 1.0 / (ell * C);
@@ -294,7 +323,17 @@ public:
 		for (unsigned int c=0; c<classes; c++)
 		{
 			gradient[c].resize(w[c].size());
-			w[c] = RealZeroVector(w[c].size());
+			w[c] = blas::repeat(0.0, w[c].size());
+		}
+
+		// state of the iterate average, see Pegasos::solve
+		double sigmasum = 0.0;                          // sum of the scaling factors of all iterates
+		std::size_t iterates = 0;                       // number of averaged iterates
+		std::vector<VectorType> correction;             // sum over all steps, weighted by the scaling factors preceding them
+		if (average)
+		{
+			correction.resize(classes);
+			for (unsigned int c=0; c<classes; c++) correction[c] = blas::repeat(0.0, w[c].size());
 		}
 
 		// pegasos main loop
@@ -311,8 +350,8 @@ public:
 				for (unsigned int c=0; c<classes; c++) gradient[c] = (lambda * sigma * (double)ell) * w[c];
 				for (std::size_t i=0; i<ell; i++)
 				{
-					VectorType const& x = data(i).input;
-					unsigned int y = data(i).label;
+					VectorType const& x = view[i].input;
+					unsigned int y = view[i].label;
 					for (unsigned int c=0; c<classes; c++) f(c) = sigma * inner_prod(w[c], x);
 					lg(x, y, f, gradient, sumToZero);
 				}
@@ -342,8 +381,8 @@ public:
 			{
 				// select the active variable (sample with replacement)
 				std::size_t active = Rng::discrete(0, ell-1);
-				VectorType const& x = data(active).input;
-				unsigned int y = data(active).label;
+				VectorType const& x = view[active].input;
+				unsigned int y = view[active].label;
 				SHARK_ASSERT(y < classes);
 
 				// compute the prediction
@@ -364,16 +403,23 @@ public:
 					gradient[c] *= eta;
 					norm_w2 += inner_prod(gradient[c], gradient[c]) - 2.0 * inner_prod(w[c], gradient[c]);
 					noalias(w[c]) -= gradient[c];
+					if (average) noalias(correction[c]) += sigmasum * gradient[c];
 				}
 
 				// project to the ball
 				double n2 = sigma * sigma * norm_w2;
 				if (n2 > normbound2) sigma *= std::sqrt(normbound2 / n2);
 			}
+			if (average)
+			{
+				sigmasum += sigma;
+				iterates++;
+			}
 		}
 
 		// rescale the solution
-		for (unsigned int c=0; c<classes; c++) w[c] *= sigma;
+		if (average) for (unsigned int c=0; c<classes; c++) w[c] = (1.0 / (double)iterates) * (sigmasum * w[c] + correction[c]);
+		else for (unsigned int c=0; c<classes; c++) w[c] *= sigma;
 		return predictions;
 	}
 
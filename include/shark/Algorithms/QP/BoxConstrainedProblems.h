@@ -226,9 +226,9 @@ public:
 			double mu = -alpha(i);
 			detail::solveQuadraticEdge(m_problem.alpha(i),gradient(i),diagonal(i),boxMin(i),boxMax(i));
 			mu+=alpha(i);
-			
-			// update the internal states
-			for (std::size_t a = 0; a < active(); a++) 
+
+			// update the internal states in parallel, the entries are independent
+			SHARK_PARALLEL_FOR(int a = 0; a < (int)active(); a++)
 				m_gradient(a) -= mu * q[a];
 			
 			updateAlphaStatus(i);
@@ -256,8 +256,8 @@ public:
 		mui += alpha(i);
 		muj += alpha(j);
 
-		// update the internal states
-		for (std::size_t a = 0; a < active(); a++) 
+		// update the internal states in parallel, the entries are independent
+		SHARK_PARALLEL_FOR(int a = 0; a < (int)active(); a++)
 			m_gradient(a) -= mui * qi[a] + muj * qj[a];
 			
 		updateAlphaStatus(i);
@@ -286,7 +286,7 @@ public:
 		for (std::size_t i=0; i<n; i++)
 		{
 			std::size_t j = permutation(i);
-			SHARK_ASSERT(alpha(j) >= boxMin(j) && alpha(j) <= boxMax(j));
+			SHARK_ASSERT(alpha(j) >= boxMin(i) && alpha(j) <= boxMax(i));
 			m_problem.alpha(i) = alpha(j);
 			m_gradient(i) = gradient(j);
 			updateAlphaStatus(i);
@@ -303,15 +303,20 @@ public:
 	{
 		std::size_t n = dimensions();
 		SIZE_CHECK(alpha.size() == n);
-		RealVector gradient = m_problem.linear;
+		//compute the gradient in the internal variable order of the problem
+		RealVector gradientInternal = m_problem.linear;
 		blas::vector<QpFloatType> q(n);
 		for (std::size_t i=0; i<n; i++)
 		{
-			double a = alpha(i);
+			double a = alpha(permutation(i));
 			if (a == 0.0) continue;
 			m_problem.quadratic.row(i, 0, n, q.storage());
-			noalias(gradient) -= a * q;
+			noalias(gradientInternal) -= a * q;
 		}
+		//permute into dataset order as expected by the two-argument overload
+		RealVector gradient(n);
+		for (std::size_t i=0; i<n; i++)
+			gradient(permutation(i)) = gradientInternal(i);
 		setInitialSolution(alpha, gradient);
 	}
 
@@ -344,13 +349,26 @@ public:
 		std::swap( m_alphaStatus[i], m_alphaStatus[j]);
 	}
 	
+	/// \brief Scales all box constraints by a constant factor and adapts the solution using a separate scaling
+	void scaleBoxConstraints(double factor, double variableScalingFactor){
+		m_problem.scaleBoxConstraints(factor,variableScalingFactor);
+		for(std::size_t i = 0; i != this->dimensions(); ++i){
+			//don't change deactivated variables
+			if(m_alphaStatus[i] == AlphaDeactivated) continue;
+			m_gradient(i) -= linear(i);
+			m_gradient(i) *= variableScalingFactor;
+			m_gradient(i) += linear(i);
+			updateAlphaStatus(i);
+		}
+	}
+
 	/// \brief adapts the linear part of the problem and updates the internal data structures accordingly.
 	virtual void setLinear(std::size_t i, double newValue){
 		m_gradient(i) -= linear(i);
 		m_gradient(i) += newValue;
 		m_problem.linear(i) = newValue;
 	}
-	
+
 	double checkKKT()const{
 		double maxViolation = 0.0;
 		for(std::size_t i = 0; i != dimensions(); ++i){
@@ -501,7 +519,7 @@ public:
 		for (std::size_t i=0; i<n; i++)
 		{
 			std::size_t j = this->permutation(i);
-			SHARK_ASSERT(alpha(j) >= boxMin(j) && alpha(j) <= boxMax(j));
+			SHARK_ASSERT(alpha(j) >= boxMin(i) && alpha(j) <= boxMax(i));
 			this->m_problem.alpha(i) = alpha(j);
 			this->m_gradient(i) = gradient(j);
 			m_gradientEdge(i) = gradientEdge(j);
@@ -519,19 +537,24 @@ public:
 	{
 		std::size_t n = dimensions();
 		SIZE_CHECK(alpha.size() == n);
-		RealVector gradient = this->m_problem.linear;
-		RealVector gradientEdge = this->m_problem.linear;
+		//compute the gradients in the internal variable order of the problem
+		RealVector gradientInternal = this->m_problem.linear;
+		RealVector gradientEdgeInternal = this->m_problem.linear;
 		blas::vector<QpFloatType> q(n);
-		std::vector<std::size_t> inverse(n);
-		for (std::size_t i=0; i<n; i++) inverse[this->permutation(i)] = i;
 		for (std::size_t i=0; i<n; i++)
 		{
-			double a = alpha(i);
+			double a = alpha(this->permutation(i));
 			if (a == 0.0) continue;
 			this->m_problem.quadratic.row(i, 0, n, q.raw_storage().values);
-			noalias(gradient) -= a * q;
-			std::size_t j = inverse[i];
-			if (a == boxMin(j) || a == boxMax(j)) gradientEdge -= a * q;
+			noalias(gradientInternal) -= a * q;
+			if (a == boxMin(i) || a == boxMax(i)) gradientEdgeInternal -= a * q;
+		}
+		//permute into dataset order as expected by the three-argument overload
+		RealVector gradient(n);
+		RealVector gradientEdge(n);
+		for (std::size_t i=0; i<n; i++){
+			gradient(this->permutation(i)) = gradientInternal(i);
+			gradientEdge(this->permutation(i)) = gradientEdgeInternal(i);
 		}
 		setInitialSolution(alpha, gradient, gradientEdge);
 	}
@@ -596,7 +619,7 @@ protected:
 		}
 
 		QpFloatType* q = quadratic().row(i, 0, dimensions());
-		for(std::size_t a = 0; a != dimensions(); ++a){
+		SHARK_PARALLEL_FOR(int a = 0; a < (int)dimensions(); ++a){
 			m_gradientEdge(a) -= diff*q[a];
 		}
 	}
@@ -333,6 +333,256 @@ protected:
 };
 
 
+///
+/// \brief Dual coordinate descent solver for linear SVMs with shrinking
+///
+/// \par
+/// In contrast to QpBoxLinear, which adapts per-variable preferences,
+/// this solver is a faithful implementation of Algorithm 3 of the paper<br>
+///   "A Dual Coordinate Descent Method for Large-scale Linear SVM"
+///   by Hsieh, Chang, and Lin, ICML, 2007.
+/// Every epoch sweeps over the active variables in random order and
+/// maintains the primal weight vector incrementally, touching only the
+/// non-zero coordinates of the current training point. Variables that
+/// are clamped to the bounds of the box are shrunk from the active set;
+/// when the stopping condition holds on the shrunk problem, one final
+/// sweep over all variables verifies it before the solver stops.
+///
+template <class InputT>
+class QpDcdLinear
+{
+public:
+	typedef LabeledData<InputT, unsigned int> DatasetType;
+
+	///
+	/// \brief Constructor
+	///
+	/// \param  dataset  training data
+	/// \param  dim      problem dimension
+	///
+	QpDcdLinear(const DatasetType& dataset, std::size_t dim)
+	: m_data(dataset)
+	, m_dim(dim)
+	, m_xSquared(m_data.size())
+	, m_alpha(m_data.size(),0.0)
+	, m_weights(m_dim,0.0)
+	, m_offset(0)
+	{
+		SHARK_ASSERT(dim > 0);
+
+		// pre-compute squared norms
+		for (std::size_t i=0; i<m_data.size(); i++)
+		{
+			m_xSquared(i) = norm_sqr(m_data[i].input);
+		}
+	}
+
+	void setOffset(double newOffset){
+		m_offset = newOffset;
+	}
+
+	double offsetGradient()const{
+		double result = 0;
+		for(std::size_t i = 0; i != m_data.size(); ++i){
+			double y_i = (m_data[i].label > 0) ? +1.0 : -1.0;
+			result += m_alpha(i) * y_i;
+		}
+		return result;
+	}
+
+	RealVector const& solutionWeightVector()const{
+		return m_weights;
+	}
+
+	///
+	/// \brief Solve the SVM training problem.
+	///
+	/// \param  bound    upper bound for alpha-components, complexity parameter of the hinge loss SVM
+	/// \param  reg      coefficient of the penalty term \f$-\frac{reg}{2} \cdot \|\alpha\|^2\f$, reg=1/C where C is the complexity parameter of the squared hinge loss SVM
+	/// \param  stop     stopping condition(s)
+	/// \param  prop     solution properties
+	/// \param  verbose  if true, the solver prints status information and solution statistics
+	///
+	void solve(
+		double bound,
+		double reg,
+		QpStoppingCondition& stop,
+		QpSolutionProperties* prop = NULL,
+		bool verbose = false
+	){
+		// sanity checks
+		SHARK_ASSERT(bound > 0.0);
+		SHARK_ASSERT(reg >= 0.0);
+
+		// measure training time
+		Timer timer;
+
+		// prepare dimensions and vectors
+		std::size_t ell = m_data.size();
+		std::size_t active = ell;
+		std::vector<std::size_t> index(ell);
+		for (std::size_t i=0; i<ell; i++) index[i] = i;
+
+		// projected gradient bounds of the previous epoch, used for shrinking
+		double pgMaxOld = 1e100;
+		double pgMinOld = -1e100;
+
+		// prepare counters
+		std::size_t epoch = 0;
+		std::size_t iterations = 0;
+		std::size_t steps = 0;
+		double max_violation = 0.0;
+
+		// outer optimization loop
+		while (true)
+		{
+			double pgMax = -1e100;
+			double pgMin = 1e100;
+
+			// random permutation of the active variables
+			for (std::size_t s=0; s<active; s++)
+				std::swap(index[s], index[Rng::discrete(s, active - 1)]);
+
+			// inner loop over the active set
+			for (std::size_t s=0; s<active; s++)
+			{
+				std::size_t i = index[s];
+				auto const& e_i = m_data[i];
+				double y_i = (e_i.label > 0) ? +1.0 : -1.0;
+
+				// gradient of the dual objective w.r.t. alpha(i)
+				double a = m_alpha(i);
+				double g = y_i * (inner_prod(m_weights, e_i.input) + m_offset) - 1.0 + reg * a;
+
+				// projected gradient and shrinking of bound-clamped variables
+				double pg = g;
+				if (a == 0.0)
+				{
+					if (g > pgMaxOld)
+					{
+						active--;
+						std::swap(index[s], index[active]);
+						s--;
+						continue;
+					}
+					pg = std::min(g, 0.0);
+				}
+				else if (a == bound)
+				{
+					if (g < pgMinOld)
+					{
+						active--;
+						std::swap(index[s], index[active]);
+						s--;
+						continue;
+					}
+					pg = std::max(g, 0.0);
+				}
+				pgMax = std::max(pgMax, pg);
+				pgMin = std::min(pgMin, pg);
+				iterations++;
+
+				// coordinate descent step, maintaining the weight vector
+				if (std::abs(pg) > 1e-12)
+				{
+					double q = m_xSquared(i) + reg;
+					double new_a = std::min(std::max(a - g / q, 0.0), bound);
+					m_alpha(i) = new_a;
+					noalias(m_weights) += ((new_a - a) * y_i) * e_i.input;
+					steps++;
+				}
+			}
+
+			epoch++;
+			max_violation = std::max(pgMax - pgMin, 0.0);
+
+			// stopping criteria
+			if (stop.maxIterations > 0 && iterations >= stop.maxIterations)
+			{
+				if (prop != NULL) prop->type = QpMaxIterationsReached;
+				break;
+			}
+
+			if (timer.stop() >= stop.maxSeconds)
+			{
+				if (prop != NULL) prop->type = QpTimeout;
+				break;
+			}
+
+			if (max_violation < stop.minAccuracy)
+			{
+				if (active == ell)
+				{
+					if (prop != NULL) prop->type = QpAccuracyReached;
+					break;
+				}
+				// optimal on the shrunk problem; unshrink and
+				// verify the stopping condition on all variables
+				if (verbose) std::cout << "*" << std::flush;
+				active = ell;
+				pgMaxOld = 1e100;
+				pgMinOld = -1e100;
+			}
+			else
+			{
+				if (verbose) std::cout << "." << std::flush;
+				pgMaxOld = (pgMax <= 0.0) ? 1e100 : pgMax;
+				pgMinOld = (pgMin >= 0.0) ? -1e100 : pgMin;
+			}
+		}
+
+		timer.stop();
+
+		// compute solution statistics
+		std::size_t free_SV = 0;
+		std::size_t bounded_SV = 0;
+		double objective = -0.5 * norm_sqr(m_weights);
+		for (std::size_t i=0; i<ell; i++)
+		{
+			double a = m_alpha(i);
+			if (a > 0.0)
+			{
+				objective += a;
+				objective -= reg/2.0 * a * a;
+				if (a == bound) bounded_SV++;
+				else free_SV++;
+			}
+		}
+
+		// return solution statistics
+		if (prop != NULL)
+		{
+			prop->accuracy = max_violation;       // this is approximate, but a good guess
+			prop->iterations = iterations;
+			prop->value = objective;
+			prop->seconds = timer.lastLap();
+		}
+
+		// output solution statistics
+		if (verbose)
+		{
+			std::cout << std::endl;
+			std::cout << "training time (seconds): " << timer.lastLap() << std::endl;
+			std::cout << "number of epochs: " << epoch << std::endl;
+			std::cout << "number of iterations: " << iterations << std::endl;
+			std::cout << "number of non-zero steps: " << steps << std::endl;
+			std::cout << "dual accuracy: " << max_violation << std::endl;
+			std::cout << "dual objective value: " << objective << std::endl;
+			std::cout << "number of free support vectors: " << free_SV << std::endl;
+			std::cout << "number of bounded support vectors: " << bounded_SV << std::endl;
+		}
+	}
+
+protected:
+	DataView<const DatasetType> m_data;               ///< view on training data
+	std::size_t m_dim;                                ///< input space dimension
+	RealVector m_xSquared;                            ///< diagonal entries of the quadratic matrix
+	RealVector m_alpha;                               ///< storage of the alpha values for warm start
+	RealVector m_weights;                             ///< storage of weight vector for warm start
+	double m_offset;                                  ///< offset of the decision function
+};
+
+
 //~ template < >
 //~ class QpBoxLinear<CompressedRealVector>
 //~ {
@@ -93,6 +93,7 @@ public:
 	, m_storage1(m_numVariables)
 	, m_storage2(m_numVariables)
 	, m_useShrinking(true)
+	, m_blockSize(2)
 	{
 
 		SHARK_CHECK(
@@ -131,9 +132,22 @@ public:
 	///enable/disable shrinking
 	void setShrinking(bool shrinking = true)
 	{
-		m_useShrinking = shrinking; 
+		m_useShrinking = shrinking;
 	}
-	
+
+	/// \brief Set the size of the working set.
+	///
+	/// The default size of two variables yields plain S2DO steps. For
+	/// larger sizes the blockSize most violating variables are collected
+	/// and the corresponding dense sub-problem is solved exactly, so that
+	/// each kernel row obtained from the cache is used for considerably
+	/// more progress per decomposition iteration.
+	void setBlockSize(std::size_t blockSize = 2)
+	{
+		SHARK_CHECK(blockSize >= 2, "[QpMcBoxDecomp::setBlockSize] the working set must consist of at least two variables");
+		m_blockSize = blockSize;
+	}
+
 	/// \brief Return the solution found.
 	RealMatrix solution() const{
 		RealMatrix solutionMatrix(m_numVariables,m_cardP,0);
@@ -213,6 +227,12 @@ public:
 	void updateSMO(std::size_t v, std::size_t w){
 		SIZE_CHECK(v < m_activeVar);
 		SIZE_CHECK(w < m_activeVar);
+		if (m_blockSize > 2 && m_blockWS.size() > 1)
+		{
+			// block mode; the working set was collected by selectWorkingSet
+			updateBlock();
+			return;
+		}
 		// update
 		if (v == w)
 		{
@@ -392,6 +412,8 @@ public:
 	///a KKT violation of zero, indicating optimality.
 	double selectWorkingSet(std::size_t& i, std::size_t& j)
 	{
+		if (m_blockSize > 2) return selectBlockWorkingSet(i, j);
+
 		// box case
 		double maxViolation = 0.0;
 
@@ -465,7 +487,151 @@ public:
 	}
 	
 protected:
-	
+
+	//!
+	///\brief select a block working set of up to m_blockSize variables
+	//!
+	///The variables are picked by first order criteria, that is, by the
+	///magnitude of their KKT violation. The indices are stored in
+	///m_blockWS sorted by violation; the most violating variable is
+	///reported through i and j so that the surrounding decomposition
+	///loop can track progress exactly as in the two-variable case.
+	double selectBlockWorkingSet(std::size_t& i, std::size_t& j)
+	{
+		m_blockWS.clear();
+		m_blockViolation.clear();
+		for (std::size_t a=0; a<m_activeVar; a++)
+		{
+			double aa = m_alpha(a);
+			double ga = m_gradient(a);
+			if (ga > 0.0 && aa < m_C)
+				insertBlockVariable(a, ga);
+			else if (ga < 0.0 && aa > 0.0)
+				insertBlockVariable(a, -ga);
+		}
+		if (m_blockWS.empty()) return 0.0;
+		i = j = m_blockWS[0];
+		return m_blockViolation[0];
+	}
+
+	///insert a variable into the block working set, keeping the set
+	///sorted by violation and capped at m_blockSize entries
+	void insertBlockVariable(std::size_t v, double violation)
+	{
+		if (m_blockWS.size() == m_blockSize && violation <= m_blockViolation.back()) return;
+		std::size_t pos = m_blockWS.size();
+		m_blockWS.push_back(v);
+		m_blockViolation.push_back(violation);
+		for (; pos > 0 && m_blockViolation[pos-1] < violation; pos--)
+		{
+			m_blockWS[pos] = m_blockWS[pos-1];
+			m_blockViolation[pos] = m_blockViolation[pos-1];
+		}
+		m_blockWS[pos] = v;
+		m_blockViolation[pos] = violation;
+		if (m_blockWS.size() > m_blockSize)
+		{
+			m_blockWS.pop_back();
+			m_blockViolation.pop_back();
+		}
+	}
+
+	///solve the sub-problem restricted to the current block working set
+	void updateBlock()
+	{
+		std::size_t q = m_blockWS.size();
+		SHARK_ASSERT(q > 1);
+
+		// obtain the kernel row of each example in the block only once;
+		// it serves the whole inner optimization and the gradient update
+		std::vector<std::size_t> rowOf(q);
+		std::vector<std::size_t> rowExample;
+		std::vector<std::vector<QpFloatType> > rows;
+		for (std::size_t a=0; a<q; a++)
+		{
+			std::size_t ia = m_variables[m_blockWS[a]].i;
+			SHARK_ASSERT(ia < m_activeEx);
+			std::size_t r = 0;
+			while (r != rowExample.size() && rowExample[r] != ia) r++;
+			if (r == rowExample.size())
+			{
+				rowExample.push_back(ia);
+				rows.push_back(std::vector<QpFloatType>(m_activeEx));
+				m_kernelMatrix.row(ia, 0, m_activeEx, &rows[r][0]);
+			}
+			rowOf[a] = r;
+		}
+
+		// restriction of the big Q-matrix to the working set and local
+		// copies of the state of the involved variables
+		RealMatrix Q(q, q);
+		RealVector alpha(q);
+		RealVector gradient(q);
+		for (std::size_t a=0; a<q; a++)
+		{
+			std::size_t va = m_blockWS[a];
+			std::size_t ra = m_cardP * m_examples[m_variables[va].i].y + m_variables[va].p;
+			QpFloatType* k = &rows[rowOf[a]][0];
+			for (std::size_t b=0; b<q; b++)
+			{
+				std::size_t vb = m_blockWS[b];
+				std::size_t ib = m_variables[vb].i;
+				Q(a,b) = m_M(m_classes * ra + m_examples[ib].y, m_variables[vb].p) * k[ib];
+			}
+			Q(a,a) = m_variables[va].diagonal;
+			alpha(a) = m_alpha(va);
+			gradient(a) = m_gradient(va);
+		}
+
+		// solve the dense sub-problem (almost) exactly by pairwise
+		// descent on the local copies; no kernel access is needed here
+		for (std::size_t sweep=0; sweep<100; sweep++)
+		{
+			double delta = 0.0;
+			for (std::size_t a=0; a+1<q; a++)
+			{
+				for (std::size_t b=a+1; b<q; b++)
+				{
+					double alpha_a = alpha(a);
+					double alpha_b = alpha(b);
+					detail::solveQuadratic2DBox(alpha(a), alpha(b),
+						gradient(a), gradient(b),
+						Q(a,a), Q(a,b), Q(b,b),
+						0, m_C, 0, m_C
+					);
+					double mu_a = alpha(a) - alpha_a;
+					double mu_b = alpha(b) - alpha_b;
+					if (mu_a == 0.0 && mu_b == 0.0) continue;
+					// for an already optimal pair the analytic solver may
+					// return an arbitrary corner; only accept the step if
+					// it actually improves the objective
+					double gain = mu_a * (gradient(a) - 0.5 * (Q(a,a)*mu_a + Q(a,b)*mu_b))
+								+ mu_b * (gradient(b) - 0.5 * (Q(a,b)*mu_a + Q(b,b)*mu_b));
+					if (gain <= 0.0)
+					{
+						alpha(a) = alpha_a;
+						alpha(b) = alpha_b;
+						continue;
+					}
+					noalias(gradient) -= mu_a * row(Q, a) + mu_b * row(Q, b);
+					delta = std::max(delta, std::max(std::abs(mu_a), std::abs(mu_b)));
+				}
+			}
+			if (delta < 1e-12 * m_C) break;
+		}
+
+		// perform the delayed gradient updates for the accumulated steps
+		for (std::size_t a=0; a<q; a++)
+		{
+			std::size_t va = m_blockWS[a];
+			double mu = alpha(a) - m_alpha(va);
+			if (mu == 0.0) continue;
+			m_alpha(va) = alpha(a);
+			std::size_t ra = m_cardP * m_examples[m_variables[va].i].y + m_variables[va].p;
+			gradientUpdate(ra, mu, &rows[rowOf[a]][0]);
+		}
+	}
+
 	void gradientUpdate(std::size_t r, double mu, QpFloatType* q)
 	{
 		for ( std::size_t a= 0; a< m_activeEx; a++)
@@ -636,6 +802,15 @@ protected:
 
 	///should the m_problem use the shrinking heuristics?
 	bool m_useShrinking;
+
+	///size of the working set; the default of 2 amounts to plain S2DO
+	std::size_t m_blockSize;
+
+	///variables of the current block working set, sorted by violation
+	std::vector<std::size_t> m_blockWS;
+
+	///KKT violations of the block working set variables
+	std::vector<double> m_blockViolation;
 };
 
 
@@ -115,7 +115,7 @@ public:
 		// prepare dimensions and vectors
 		std::size_t ell = m_data.size();             // number of training examples
 		RealMatrix alpha(ell, m_classes + 1, 0.0);   // Lagrange multipliers; dual variables. Reserve one extra column.
-		RealMatrix w(m_classes, m_dim, 0.0);         // weight vectors; primal variables
+		RealMatrix w(m_dim, m_classes, 0.0);         // weight vectors; primal variables. Stored feature-major, so that the entries of all classes for one feature are contiguous.
 
 		// scheduling of steps, for ACF only
 		RealVector pref(ell, 1.0);                   // example-wise measure of success
@@ -199,7 +199,7 @@ public:
 				blas::matrix_row<RealMatrix> a = row(alpha, i);
 
 				// compute gradient and KKT violation
-				RealVector wx = prod(w,x_i);
+				RealVector wx = classScores(w, x_i);
 				RealVector g(m_classes);
 				double kkt = calcGradient(g, wx, a, C, y_i);
 
@@ -298,9 +298,9 @@ public:
 
 		// calculate dual objective value
 		objective = 0.0;
-		for (std::size_t j=0; j<m_classes; j++)
+		for (std::size_t d=0; d<m_dim; d++)
 		{
-			for (std::size_t d=0; d<m_dim; d++) objective -= w(j, d) * w(j, d);
+			for (std::size_t j=0; j<m_classes; j++) objective -= w(d, j) * w(d, j);
 		}
 		objective *= 0.5;
 		for (std::size_t i=0; i<ell; i++)
@@ -329,15 +329,29 @@ public:
 			std::cout << "dual objective value: " << objective << std::endl;
 		}
 
-		// return the solution
-		return w;
+		// return the solution with one weight vector per row
+		return RealMatrix(trans(w));
 	}
 
 protected:
-	// for all c: row(w, c) += mu(c) * x
+	// compute wx(c) = <w_c, x> for all classes in a single pass over the
+	// entries of x; for each entry the class-contiguous row of w is
+	// accumulated with a dense axpy, so a sparse x is walked only once
+	RealVector classScores(RealMatrix const& w, InputReferenceType x) const
+	{
+		RealVector wx(m_classes, 0.0);
+		auto end = x.end();
+		for (auto it = x.begin(); it != end; ++it)
+			noalias(wx) += (*it) * row(w, it.index());
+		return wx;
+	}
+
+	// for all c: w_c += mu(c) * x, with w stored feature-major
 	void add_scaled(RealMatrix& w, RealVector const& mu, InputReferenceType x)
 	{
-		for (std::size_t c=0; c<m_classes; c++) noalias(row(w, c)) += mu(c) * x;
+		auto end = x.end();
+		for (auto it = x.begin(); it != end; ++it)
+			noalias(row(w, it.index())) += (*it) * mu;
 	}
 
 	/// \brief Compute the gradient from the inner products of the weight vectors with the current sample.
@@ -353,7 +367,7 @@ protected:
 
 	/// \brief Update the weight vectors (primal variables) after a step on the dual variables.
 	///
-	/// \param  w   matrix of (dense) weight vectors (as rows)
+	/// \param  w   matrix of (dense) weight vectors, stored feature-major (one row per feature)
 	/// \param  mu  dual step on the variables corresponding to the current sample
 	/// \param  index   current sample
 	virtual void updateWeightVectors(RealMatrix& w, RealVector const& mu, std::size_t index) = 0;
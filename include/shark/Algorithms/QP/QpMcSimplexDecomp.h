@@ -93,6 +93,7 @@ public:
 	, m_storage1(m_numVariables)
 	, m_storage2(m_numVariables)
 	, m_useShrinking(true)
+	, m_blockSize(2)
 	{
 
 		SHARK_CHECK(
@@ -135,9 +136,22 @@ public:
 	/// enable/disable shrinking
 	void setShrinking(bool shrinking = true)
 	{
-		m_useShrinking = shrinking; 
+		m_useShrinking = shrinking;
 	}
-	
+
+	/// \brief Set the size of the working set.
+	///
+	/// By default the solver performs S2DO steps on two variables. A
+	/// larger working set amortizes the cost of fetching kernel rows:
+	/// the blockSize most violating variables are collected and the
+	/// restricted dense sub-problem is solved to high precision before
+	/// the gradient is updated.
+	void setBlockSize(std::size_t blockSize = 2)
+	{
+		SHARK_CHECK(blockSize >= 2, "[QpMcSimplexDecomp::setBlockSize] the working set must consist of at least two variables");
+		m_blockSize = blockSize;
+	}
+
 	/// \brief Returns the solution found.
 	RealMatrix solution() const{
 		RealMatrix solutionMatrix(m_numVariables,m_cardP,0);
@@ -192,6 +206,12 @@ public:
 	void updateSMO(std::size_t v, std::size_t w){
 		SIZE_CHECK(v < m_activeVar);
 		SIZE_CHECK(w < m_activeVar);
+		if (m_blockSize > 2 && m_blockWS.size() > 1)
+		{
+			// block mode; the working set was prepared by selectWorkingSet
+			updateBlock();
+			return;
+		}
 		// update
 		if (v == w)
 		{
@@ -410,7 +430,8 @@ public:
 	/// a KKT violation of zero, indicating optimality.	
 	double selectWorkingSet(std::size_t& i, std::size_t& j)
 	{
-		
+		if (m_blockSize > 2) return selectBlockWorkingSet(i, j);
+
 		//first order selection
 		//we select the best variable along the box constraint (for a step between samples)
 		//and the best gradient and example index for a step along the simplex (step inside a sample)
@@ -720,6 +741,211 @@ protected:
 		return std::make_pair(std::make_pair(up,maxUp),std::make_pair(down,minDown));
 	}
 	
+	/// \brief Select a block working set of up to m_blockSize variables.
+	///
+	/// Candidates are generated per simplex from its MVP pair, covering
+	/// the same three search directions as checkKKT: decreasing a
+	/// variable, growing a variable while the simplex is not at its
+	/// bound, and the exchange step along a bounded simplex. For the
+	/// exchange both ends of the pair enter the working set, since
+	/// neither variable can move without the other. The most violating
+	/// variable is reported through i and j so that the decomposition
+	/// loop can track progress as in the two-variable case.
+	double selectBlockWorkingSet(std::size_t& i, std::size_t& j)
+	{
+		m_blockWS.clear();
+		m_blockViolation.clear();
+		for (std::size_t e=0; e<m_activeEx; e++)
+		{
+			Example const& ex = m_examples[e];
+			std::pair<std::pair<double,std::size_t>,std::pair<double,std::size_t> > pair = getSimplexMVP(ex);
+			double up = pair.first.first;
+			double down = pair.second.first;
+
+			if (down < 0.0)
+				insertBlockVariable(pair.second.second, -down);
+			if (ex.varsum < m_C && up > 0.0)
+				insertBlockVariable(pair.first.second, up);
+			if (ex.varsum == m_C && up - down > 0.0)
+			{
+				insertBlockVariable(pair.first.second, up - down);
+				insertBlockVariable(pair.second.second, up - down);
+			}
+		}
+		if (m_blockWS.empty()) return 0.0;
+		i = j = m_blockWS[0];
+		return m_blockViolation[0];
+	}
+
+	/// insert a variable into the block working set, keeping the set
+	/// sorted by violation and capped at m_blockSize entries
+	void insertBlockVariable(std::size_t v, double violation)
+	{
+		// the same variable can qualify through different criteria;
+		// in this case only the largest violation is kept
+		std::size_t pos = 0;
+		while (pos != m_blockWS.size() && m_blockWS[pos] != v) pos++;
+		if (pos != m_blockWS.size())
+		{
+			if (violation <= m_blockViolation[pos]) return;
+			m_blockWS.erase(m_blockWS.begin() + pos);
+			m_blockViolation.erase(m_blockViolation.begin() + pos);
+		}
+		else if (m_blockWS.size() == m_blockSize && violation <= m_blockViolation.back())
+			return;
+
+		pos = m_blockWS.size();
+		m_blockWS.push_back(v);
+		m_blockViolation.push_back(violation);
+		for (; pos > 0 && m_blockViolation[pos-1] < violation; pos--)
+		{
+			m_blockWS[pos] = m_blockWS[pos-1];
+			m_blockViolation[pos] = m_blockViolation[pos-1];
+		}
+		m_blockWS[pos] = v;
+		m_blockViolation[pos] = violation;
+		if (m_blockWS.size() > m_blockSize)
+		{
+			m_blockWS.pop_back();
+			m_blockViolation.pop_back();
+		}
+	}
+
+	/// solve the sub-problem restricted to the current block working set
+	void updateBlock()
+	{
+		std::size_t q = m_blockWS.size();
+		SHARK_ASSERT(q > 1);
+
+		// fetch the kernel row of each example in the block only once
+		std::vector<std::size_t> rowOf(q);
+		std::vector<std::size_t> rowExample;
+		std::vector<std::vector<QpFloatType> > rows;
+		for (std::size_t a=0; a<q; a++)
+		{
+			std::size_t ia = m_variables[m_blockWS[a]].example;
+			SHARK_ASSERT(ia < m_activeEx);
+			std::size_t r = 0;
+			while (r != rowExample.size() && rowExample[r] != ia) r++;
+			if (r == rowExample.size())
+			{
+				rowExample.push_back(ia);
+				rows.push_back(std::vector<QpFloatType>(m_activeEx));
+				m_kernelMatrix.row(ia, 0, m_activeEx, &rows[r][0]);
+			}
+			rowOf[a] = r;
+		}
+
+		// restriction of the big Q-matrix to the working set and local
+		// copies of the state of the involved variables and simplices
+		RealMatrix Q(q, q);
+		RealVector alpha(q);
+		RealVector gradient(q);
+		RealVector varsum(rowExample.size());
+		for (std::size_t r=0; r<rowExample.size(); r++)
+			varsum(r) = m_examples[rowExample[r]].varsum;
+		for (std::size_t a=0; a<q; a++)
+		{
+			std::size_t va = m_blockWS[a];
+			std::size_t ra = m_cardP * m_examples[m_variables[va].example].y + m_variables[va].p;
+			QpFloatType* k = &rows[rowOf[a]][0];
+			for (std::size_t b=0; b<q; b++)
+			{
+				std::size_t vb = m_blockWS[b];
+				std::size_t ib = m_variables[vb].example;
+				Q(a,b) = m_M(m_classes * ra + m_examples[ib].y, m_variables[vb].p) * k[ib];
+			}
+			Q(a,a) = m_variables[va].diagonal;
+			alpha(a) = m_alpha(va);
+			gradient(a) = m_gradient(va);
+		}
+
+		// pairwise descent on the local copies until the sub-problem is
+		// solved to high precision, obeying the simplex constraints of
+		// the involved examples; no kernel access is needed in here
+		for (std::size_t sweep=0; sweep<100; sweep++)
+		{
+			double delta = 0.0;
+			for (std::size_t a=0; a+1<q; a++)
+			{
+				for (std::size_t b=a+1; b<q; b++)
+				{
+					double alpha_a = alpha(a);
+					double alpha_b = alpha(b);
+					if (rowOf[a] == rowOf[b])
+					{
+						// both variables belong to the same simplex
+						double upperBound = m_C - varsum(rowOf[a]) + alpha(a) + alpha(b);
+						detail::solveQuadratic2DTriangle(alpha(a), alpha(b),
+							gradient(a), gradient(b),
+							Q(a,a), Q(a,b), Q(b,b),
+							upperBound
+						);
+					}
+					else
+					{
+						double Ua = m_C - varsum(rowOf[a]) + alpha(a);
+						double Ub = m_C - varsum(rowOf[b]) + alpha(b);
+						detail::solveQuadratic2DBox(alpha(a), alpha(b),
+							gradient(a), gradient(b),
+							Q(a,a), Q(a,b), Q(b,b),
+							0, Ua, 0, Ub
+						);
+					}
+					double mu_a = alpha(a) - alpha_a;
+					double mu_b = alpha(b) - alpha_b;
+					if (mu_a == 0.0 && mu_b == 0.0) continue;
+					// an already optimal pair must not move; the analytic
+					// solvers return an arbitrary edge solution in this
+					// case, so verify that the step improves the objective
+					double gain = mu_a * (gradient(a) - 0.5 * (Q(a,a)*mu_a + Q(a,b)*mu_b))
+								+ mu_b * (gradient(b) - 0.5 * (Q(a,b)*mu_a + Q(b,b)*mu_b));
+					if (gain <= 0.0)
+					{
+						alpha(a) = alpha_a;
+						alpha(b) = alpha_b;
+						continue;
+					}
+					varsum(rowOf[a]) += mu_a;
+					varsum(rowOf[b]) += mu_b;
+					noalias(gradient) -= mu_a * row(Q, a) + mu_b * row(Q, b);
+					delta = std::max(delta, std::max(std::abs(mu_a), std::abs(mu_b)));
+				}
+			}
+			if (delta < 1e-12 * m_C) break;
+		}
+
+		// write back the solution first, so that the varsum updates can
+		// recalibrate from a consistent state
+		RealVector mu(q);
+		for (std::size_t a=0; a<q; a++)
+		{
+			std::size_t va = m_blockWS[a];
+			mu(a) = alpha(a) - m_alpha(va);
+			m_alpha(va) = alpha(a);
+		}
+		// update each involved simplex once with the net change of all of
+		// its variables; per-variable updates would recalibrate in between
+		// and count parts of the change twice
+		for (std::size_t r=0; r<rowExample.size(); r++)
+		{
+			double net = 0.0;
+			for (std::size_t a=0; a<q; a++)
+			{
+				if (rowOf[a] == r) net += mu(a);
+			}
+			updateVarsum(rowExample[r], net);
+		}
+		// perform the delayed gradient updates
+		for (std::size_t a=0; a<q; a++)
+		{
+			if (mu(a) == 0.0) continue;
+			std::size_t va = m_blockWS[a];
+			std::size_t ra = m_cardP * m_examples[m_variables[va].example].y + m_variables[va].p;
+			gradientUpdate(ra, mu(a), &rows[rowOf[a]][0]);
+		}
+	}
+
 	void updateVarsum(std::size_t exampleId, double mu){
 		double& varsum = m_examples[exampleId].varsum;
 		varsum += mu;
@@ -881,7 +1107,16 @@ protected:
 
 	/// should the m_problem use the shrinking heuristics?
 	bool m_useShrinking;
-	
+
+	/// size of the working set; the default of 2 amounts to plain S2DO
+	std::size_t m_blockSize;
+
+	/// variables of the current block working set, sorted by violation
+	std::vector<std::size_t> m_blockWS;
+
+	/// KKT violations of the block working set variables
+	std::vector<double> m_blockViolation;
+
 	/// true if the problem has already been unshrinked
 	bool bUnshrinked;
 };
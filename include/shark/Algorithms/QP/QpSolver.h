@@ -36,6 +36,7 @@
 #ifndef SHARK_ALGORITHMS_QP_QPSOLVER_H
 #define SHARK_ALGORITHMS_QP_QPSOLVER_H
 
+#include <shark/Core/Profiler.h>
 #include <shark/Core/Timer.h>
 #include <shark/Algorithms/QP/QuadraticProgram.h>
 #include <shark/Data/Dataset.h>
@@ -407,6 +408,7 @@ public:
 		QpStoppingCondition& stop,
 		QpSolutionProperties* prop = NULL
 	){
+		SHARK_PROFILE_SCOPE("QpSolver.solve");
 		double start_time = Timer::now();
 		unsigned long long iter = 0;
 		unsigned long long shrinkCounter = 0;
@@ -448,13 +450,18 @@ public:
 			
 			//do a shrinking every 1000 iterations. if variables got shrink
 			//notify working set selection
-			if(shrinkCounter == 0 && m_problem.shrink(stop.minAccuracy)){
+			if(shrinkCounter == 0){
+				//restart the schedule even if no variable could be shrunk this
+				//time; otherwise the counter wraps around below and shrinking
+				//is effectively switched off for the rest of the optimization
+				if(m_problem.shrink(stop.minAccuracy))
+					workingSet.reset();
 				shrinkCounter = std::max<std::size_t>(1000,m_problem.dimensions());
-				workingSet.reset();
 			}
 			iter++;
 			shrinkCounter--;
 		}
+		SHARK_PROFILE_COUNT_N("QpSolver.iterations",iter);
 
 		if (prop != NULL)
 		{
@@ -399,7 +399,7 @@ public:
 		for (std::size_t i=0; i<n; i++)
 		{
 			std::size_t j = permutation(i);
-			SHARK_ASSERT(alpha(j) >= boxMin(j) && alpha(j) <= boxMax(j));
+			SHARK_ASSERT(alpha(j) >= boxMin(i) && alpha(j) <= boxMax(i));
 			m_problem.alpha(i) = alpha(j);
 			m_gradient(i) = gradient(j);
 			updateAlphaStatus(i);
@@ -416,15 +416,20 @@ public:
 	{
 		std::size_t n = dimensions();
 		SIZE_CHECK(alpha.size() == n);
-		RealVector gradient = m_problem.linear;
+		//compute the gradient in the internal variable order of the problem
+		RealVector gradientInternal = m_problem.linear;
 		blas::vector<QpFloatType> q(n);
 		for (std::size_t i=0; i<n; i++)
 		{
-			double a = alpha(i);
+			double a = alpha(permutation(i));
 			if (a == 0.0) continue;
 			m_problem.quadratic.row(i, 0, n, q.storage());
-			noalias(gradient) -= a * q;
+			noalias(gradientInternal) -= a * q;
 		}
+		//permute into dataset order as expected by the two-argument overload
+		RealVector gradient(n);
+		for (std::size_t i=0; i<n; i++)
+			gradient(permutation(i)) = gradientInternal(i);
 		setInitialSolution(alpha, gradient);
 	}
 
@@ -555,10 +560,12 @@ protected:
 		
 		if(ai == aiOld && aj == ajOld)return;
 		
-		//Update internal data structures (gradient and alpha status)
+		//Update internal data structures (gradient and alpha status).
+		//The gradient entries are independent, so the update is spread
+		//over the threads like the kernel row computation itself.
 		QpFloatType* qi = quadratic().row(i, 0, active());
 		QpFloatType* qj = quadratic().row(j, 0, active());
-		for (std::size_t a = 0; a < active(); a++) 
+		SHARK_PARALLEL_FOR(int a = 0; a < (int)active(); a++)
 			m_gradient(a) -= step * qi[a] - step * qj[a];
 		
 		//update boundary status
@@ -672,7 +679,7 @@ public:
 		for (std::size_t i=0; i<n; i++)
 		{
 			std::size_t j = this->permutation(i);
-			SHARK_ASSERT(alpha(j) >= boxMin(j) && alpha(j) <= boxMax(j));
+			SHARK_ASSERT(alpha(j) >= boxMin(i) && alpha(j) <= boxMax(i));
 			this->m_problem.alpha(i) = alpha(j);
 			this->m_gradient(i) = gradient(j);
 			m_gradientEdge(i) = gradientEdge(j);
@@ -690,19 +697,24 @@ public:
 	{
 		std::size_t n = dimensions();
 		SIZE_CHECK(alpha.size() == n);
-		RealVector gradient = this->m_problem.linear;
-		RealVector gradientEdge = this->m_problem.linear;
+		//compute the gradients in the internal variable order of the problem
+		RealVector gradientInternal = this->m_problem.linear;
+		RealVector gradientEdgeInternal = this->m_problem.linear;
 		blas::vector<QpFloatType> q(n);
-		std::vector<std::size_t> inverse(n);
-		for (std::size_t i=0; i<n; i++) inverse[this->permutation(i)] = i;
 		for (std::size_t i=0; i<n; i++)
 		{
-			double a = alpha(i);
+			double a = alpha(this->permutation(i));
 			if (a == 0.0) continue;
 			this->m_problem.quadratic.row(i, 0, n, q.raw_storage().values);
-			noalias(gradient) -= a * q;
-			std::size_t j = inverse[i];
-			if (a == boxMin(j) || a == boxMax(j)) gradientEdge -= a * q;
+			noalias(gradientInternal) -= a * q;
+			if (a == boxMin(i) || a == boxMax(i)) gradientEdgeInternal -= a * q;
+		}
+		//permute into dataset order as expected by the three-argument overload
+		RealVector gradient(n);
+		RealVector gradientEdge(n);
+		for (std::size_t i=0; i<n; i++){
+			gradient(this->permutation(i)) = gradientInternal(i);
+			gradientEdge(this->permutation(i)) = gradientEdgeInternal(i);
 		}
 		setInitialSolution(alpha, gradient, gradientEdge);
 	}
@@ -774,7 +786,7 @@ private:
 		}
 
 		QpFloatType* q = quadratic().row(i, 0, dimensions());
-		for(std::size_t a = 0; a != dimensions(); ++a){
+		SHARK_PARALLEL_FOR(int a = 0; a < (int)dimensions(); ++a){
 			m_gradientEdge(a) -= diff*q[a];
 		}
 	}
@@ -0,0 +1,148 @@
+/*!
+ *
+ *
+ * \brief       Combined stopping criterion evaluating several rules over one shared window
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SHARK_TRAINERS_STOPPINGCRITERA_TRAININGCONVERGENCE_H
+#define SHARK_TRAINERS_STOPPINGCRITERA_TRAININGCONVERGENCE_H
+
+#include "AbstractStoppingCriterion.h"
+#include "WindowedStatistics.h"
+#include <shark/Core/ResultSets.h>
+#include <shark/LinAlg/Base.h>
+
+#include <cmath>
+
+namespace shark{
+
+/// \brief Combined stopping criterion evaluating several rules over one shared window.
+///
+/// Monitoring several convergence rules by chaining single criteria means
+/// every criterion keeps its own copy of the recent error history and updates
+/// it separately per iteration. This class keeps one window of the last
+/// intervalSize training errors and evaluates all enabled rules in a single
+/// pass over it:
+///
+/// - the absolute difference rule of TrainingError: stop when the error
+///   dropped by less than minDifference over the interval,
+/// - the relative improvement rule of TrainingProgress: stop when the mean of
+///   the interval exceeds the best error seen by less than the factor
+///   minImprovement,
+/// - a variance rule: stop when the standard deviation of the interval falls
+///   below minDeviation, indicating that the error has flattened out.
+///
+/// Rules are enabled by their setters; disabled rules do not influence the
+/// decision. Training stops as soon as any enabled rule fires, after the
+/// window covers a full interval. The decisions of the first two rules match
+/// those of the single criteria fed with the same sequence of errors.
+template<class PointType = RealVector>
+class TrainingConvergence: public AbstractStoppingCriterion< SingleObjectiveResultSet<PointType> >{
+public:
+	typedef SingleObjectiveResultSet<PointType> ResultSet;
+
+	///constructs the TrainingConvergence with all rules disabled
+	///@param intervalSize the size of the interval which is checked
+	TrainingConvergence(size_t intervalSize)
+	: m_interval(intervalSize){
+		m_useMinDifference = false;
+		m_useMinImprovement = false;
+		m_useMinDeviation = false;
+		m_minDifference = 0.0;
+		m_minImprovement = 0.0;
+		m_minDeviation = 0.0;
+		reset();
+	}
+
+	///enables the absolute difference rule of TrainingError
+	///@param minDifference minimum drop of the error over the interval before training stops
+	void stopAtMinDifference(double minDifference){
+		m_useMinDifference = true;
+		m_minDifference = minDifference;
+	}
+
+	///enables the relative improvement rule of TrainingProgress
+	///@param minImprovement minimum relative improvement of the interval mean over the best error before training stops
+	void stopAtMinImprovement(double minImprovement){
+		m_useMinImprovement = true;
+		m_minImprovement = minImprovement;
+	}
+
+	///enables the variance rule
+	///@param minDeviation minimum standard deviation of the interval before training stops
+	void stopAtMinDeviation(double minDeviation){
+		m_useMinDeviation = true;
+		m_minDeviation = minDeviation;
+	}
+
+	/// returns true if training should stop
+	bool stop(const ResultSet& set){
+		m_minTraining = std::min(m_minTraining, set.value);
+		m_interval.push(set.value);
+		if(!m_interval.full())
+			return false;
+
+		if(m_useMinDifference){
+			double difference = m_interval.front() - set.value;
+			if(difference >= 0 && difference < m_minDifference)
+				return true;
+		}
+		if(m_useMinImprovement){
+			if(m_interval.mean()/m_minTraining - 1 < m_minImprovement)
+				return true;
+		}
+		if(m_useMinDeviation){
+			if(std::sqrt(m_interval.variance()) < m_minDeviation)
+				return true;
+		}
+		return false;
+	}
+
+	///resets the internal state
+	void reset(){
+		m_interval.reset();
+		m_minTraining = 1.e10;
+	}
+
+protected:
+	///window statistics over the last intervalSize errors
+	WindowedStatistics m_interval;
+	///minimum training error encountered
+	double m_minTraining;
+
+	bool m_useMinDifference; ///< whether the absolute difference rule is enabled
+	bool m_useMinImprovement; ///< whether the relative improvement rule is enabled
+	bool m_useMinDeviation; ///< whether the variance rule is enabled
+	double m_minDifference; ///< threshold of the absolute difference rule
+	double m_minImprovement; ///< threshold of the relative improvement rule
+	double m_minDeviation; ///< threshold of the variance rule
+};
+}
+
+#endif
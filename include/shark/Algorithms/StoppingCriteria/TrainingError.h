@@ -34,9 +34,8 @@
 #define SHARK_TRAINERS_STOPPINGCRITERA_TRAININGERROR_H
 
 #include "AbstractStoppingCriterion.h"
+#include "WindowedStatistics.h"
 #include <shark/Core/ResultSets.h>
-#include <queue>
-#include <numeric>
 #include <shark/LinAlg/Base.h>
 namespace shark{
 
@@ -57,33 +56,29 @@ public:
 	/// constructs the TrainingError generalization loss
 	/// @param intervalSize size of the interval over which the progress is monitored
 	/// @param minDifference minimum difference between start and end of the interval allowed before training stops
-	TrainingError(size_t intervalSize, double minDifference){
+	TrainingError(size_t intervalSize, double minDifference)
+	: m_interval(intervalSize){
 		m_minDifference = minDifference;
-		m_intervalSize = intervalSize;
 		reset();
 	}
 	/// returns true if training should stop
 	bool stop(const SingleObjectiveResultSet<PointType>& set){
-
-		m_interval.pop();
 		m_interval.push(set.value);
+		//before the window covers a full interval no comparison is possible
+		if(!m_interval.full())
+			return false;
 		return (m_interval.front()-set.value) >= 0
 		    && (m_interval.front()-set.value) < m_minDifference;
 	}
 	/// resets the internal state
 	void reset(){
-		m_interval = std::queue<double>();
-		for(size_t i = 0; i != m_intervalSize;++i) {
-			m_interval.push(std::numeric_limits<double>::max());
-		}
+		m_interval.reset();
 	}
 protected:
-	/// monitored training interval
-	std::queue<double> m_interval;
+	/// window over the monitored training interval
+	WindowedStatistics m_interval;
 	/// minmum difference allowed
 	double m_minDifference;
-	/// size of the interval
-	size_t m_intervalSize;
 };
 }
 
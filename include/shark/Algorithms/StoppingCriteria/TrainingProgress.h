@@ -34,9 +34,8 @@
 #define SHARK_TRAINERS_STOPPINGCRITERA_TRAININGPROGRESS_H
 
 #include "AbstractStoppingCriterion.h"
+#include "WindowedStatistics.h"
 #include <shark/Core/ResultSets.h>
-#include <queue>
-#include <numeric>
 #include <shark/LinAlg/Base.h>
 
 namespace shark{
@@ -62,55 +61,48 @@ public:
 	///constructs the TrainingProgress
 	///@param intervalSize the size of the interval which is checked
 	///@param minImprovement minimum relative improvement of the interval to the minimum training error before training stops
-	TrainingProgress(size_t intervalSize, double minImprovement){
+	TrainingProgress(size_t intervalSize, double minImprovement)
+	: m_interval(intervalSize){
 		m_minImprovement = minImprovement;
-		m_intervalSize = intervalSize;
 		reset();
 	}
 	/// returns true if training should stop
 	bool stop(const ResultSet& set){
 		m_minTraining = std::min(m_minTraining, set.value);
 
-		m_meanPerformance += set.value;
 		m_interval.push(set.value);
-		if(m_interval.size()>m_intervalSize){
-			m_meanPerformance -= m_interval.front();
-			m_interval.pop();
-		}
-		m_progress = (m_meanPerformance/(m_minTraining*m_interval.size()))-1;
-		
-		if(m_interval.size()<m_intervalSize){
+		m_progress = (m_interval.mean()/m_minTraining)-1;
+
+		if(!m_interval.full()){
 			return false;
 		}
 
-		
 		return m_progress < m_minImprovement;
 	}
 	///resets the internal state
 	void reset(){
-		m_interval = std::queue<double>();
+		m_interval.reset();
 		m_minTraining = 1.e10;
-		m_meanPerformance = 0;
 		m_progress = 0.0;
 	}
 	///returns current value of progress
 	double value()const{
 		return m_progress;
 	}
+	///returns the variance of the training error over the interval
+	double intervalVariance()const{
+		return m_interval.variance();
+	}
 protected:
 	///minimum training error encountered
 	double m_minTraining;
 	///minimum improvement allowed before training stops
 	double m_minImprovement;
-	///mean performance over the last intervalSize timesteps
-	double m_meanPerformance;
 	///current progress measure. if it is below minTraining, stop() will return true
 	double m_progress;
 
-	///current interval
-	std::queue<double> m_interval;
-	///size of the interval
-	size_t m_intervalSize;
+	///window statistics over the last intervalSize errors
+	WindowedStatistics m_interval;
 };
 }
 
@@ -38,11 +38,25 @@
 #include <shark/LinAlg/Base.h>
 #include<shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
 
+#include <chrono>
+#include <future>
+
 namespace shark{
 
 
 /// \brief Given the current Result set of the optimizer, calculates the validation error using a validation function and hands the results over to the underlying stopping criterion.
 ///
+/// By default the validation function is evaluated synchronously inside every
+/// call to stop(), which stalls training for the duration of the evaluation.
+/// Alternatively the criterion can be constructed in asynchronous mode: stop()
+/// then snapshots the current point, evaluates it on a background thread and
+/// hands the most recently completed validation error to the child criterion.
+/// Training only blocks for the very first evaluation; afterwards validation
+/// overlaps with training and the child criterion sees errors that are at most
+/// one check stale. Asynchronous mode requires a validation function which can
+/// be evaluated concurrently with training, i.e. one that does not share
+/// mutable state - such as the model being trained - with the optimizer.
+///
 /// Currently only implemented for functions over RealVector
 class ValidatedStoppingCriterion: public AbstractStoppingCriterion< SingleObjectiveResultSet<RealVector> >{
 private:
@@ -55,21 +69,57 @@ public:
 	typedef SingleObjectiveFunction ObjectiveFunctionType;
 
 
-	ValidatedStoppingCriterion(ObjectiveFunctionType* validation, StoppingCriterionType* child)
-	:mpe_validation(validation), mpe_child(child){
+	ValidatedStoppingCriterion(ObjectiveFunctionType* validation, StoppingCriterionType* child, bool asynchronous = false)
+	:mpe_validation(validation), mpe_child(child), m_asynchronous(asynchronous){
 		reset();
 	}
+	~ValidatedStoppingCriterion(){
+		if(m_pendingValidation.valid())
+			m_pendingValidation.wait();
+	}
 	/// returns true if training should stop
 	bool stop(ResultSet const& set){
-		double validationError = mpe_validation->eval(set.point);
-		return mpe_child->stop(ValidationResultSet(set,validationError));
+		if(!m_asynchronous){
+			double validationError = mpe_validation->eval(set.point);
+			return mpe_child->stop(ValidationResultSet(set,validationError));
+		}
+		//collect a completed background evaluation if one is available
+		if(m_pendingValidation.valid()
+		&& m_pendingValidation.wait_for(std::chrono::seconds(0)) == std::future_status::ready){
+			m_lastValidationError = m_pendingValidation.get();
+			m_hasValidationError = true;
+		}
+		//launch an evaluation of a snapshot of the current point,
+		//unless a previous evaluation is still running
+		if(!m_pendingValidation.valid()){
+			ObjectiveFunctionType* validation = mpe_validation;
+			PointType point = set.point;
+			m_pendingValidation = std::async(std::launch::async,[validation,point](){
+				return validation->eval(point);
+			});
+		}
+		//the first check has no completed evaluation to fall back on; wait for it
+		if(!m_hasValidationError){
+			m_lastValidationError = m_pendingValidation.get();
+			m_hasValidationError = true;
+		}
+		return mpe_child->stop(ValidationResultSet(set,m_lastValidationError));
 	}
 	void reset(){
+		if(m_pendingValidation.valid())
+			m_pendingValidation.wait();
+		m_pendingValidation = std::future<double>();
+		m_hasValidationError = false;
+		m_lastValidationError = 0.0;
 		mpe_child->reset();
 	}
 protected:
 	ObjectiveFunctionType* mpe_validation;
 	StoppingCriterionType* mpe_child;
+	bool m_asynchronous;
+	bool m_hasValidationError;
+	double m_lastValidationError;
+	std::future<double> m_pendingValidation;
 };
 }
 
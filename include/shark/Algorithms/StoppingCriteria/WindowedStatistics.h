@@ -0,0 +1,151 @@
+/*!
+ *
+ *
+ * \brief       Incremental statistics over a sliding window of values
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SHARK_TRAINERS_STOPPINGCRITERA_WINDOWEDSTATISTICS_H
+#define SHARK_TRAINERS_STOPPINGCRITERA_WINDOWEDSTATISTICS_H
+
+#include <shark/Core/Exception.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+namespace shark{
+
+/// \brief Incremental mean and variance over the last k values of a stream.
+///
+/// The values are kept in a fixed size ring buffer and the first two moments
+/// are maintained as running sums, so pushing a value and querying the window
+/// statistics are O(1) - there is no per-step allocation and no recomputation
+/// over the history. To keep the running sums from drifting away from the
+/// buffer contents, they are recomputed exactly whenever the buffer wraps
+/// around, which costs O(k) once every k steps and thus stays O(1) amortized.
+///
+/// The stopping criteria share this class as their history bookkeeping; it is
+/// in no way specific to them and can track any scalar stream.
+class WindowedStatistics{
+public:
+	/// \brief Constructor.
+	///
+	/// \param capacity number of most recent values the window covers
+	WindowedStatistics(std::size_t capacity = 1)
+	: m_buffer(capacity){
+		SIZE_CHECK(capacity > 0);
+		reset();
+	}
+
+	///\brief Removes all values from the window.
+	void reset(){
+		m_head = 0;
+		m_size = 0;
+		m_sum = 0.0;
+		m_sumSqr = 0.0;
+	}
+
+	///\brief Pushes a value, evicting the oldest one once the window is full.
+	void push(double value){
+		if(m_size == m_buffer.size()){
+			double old = m_buffer[m_head];
+			m_sum -= old;
+			m_sumSqr -= old * old;
+		}else{
+			++m_size;
+		}
+		m_buffer[m_head] = value;
+		m_sum += value;
+		m_sumSqr += value * value;
+		++m_head;
+		if(m_head == m_buffer.size()){
+			m_head = 0;
+			refreshMoments();
+		}
+	}
+
+	///\brief Returns the number of values currently in the window.
+	std::size_t size()const{
+		return m_size;
+	}
+
+	///\brief Returns the number of values the window covers when full.
+	std::size_t capacity()const{
+		return m_buffer.size();
+	}
+
+	///\brief Returns whether the window covers its full capacity.
+	bool full()const{
+		return m_size == m_buffer.size();
+	}
+
+	///\brief Returns the oldest value of the window.
+	double front()const{
+		SIZE_CHECK(m_size > 0);
+		if(m_size < m_buffer.size())
+			return m_buffer[0];
+		return m_buffer[m_head];
+	}
+
+	///\brief Returns the mean of the values in the window.
+	double mean()const{
+		SIZE_CHECK(m_size > 0);
+		return m_sum / m_size;
+	}
+
+	///\brief Returns the variance of the values in the window.
+	double variance()const{
+		SIZE_CHECK(m_size > 0);
+		double meanValue = mean();
+		//guard against small negative values from cancellation
+		return std::max(0.0, m_sumSqr / m_size - meanValue * meanValue);
+	}
+
+private:
+	///\brief Recomputes the running sums exactly from the buffer contents.
+	void refreshMoments(){
+		m_sum = 0.0;
+		m_sumSqr = 0.0;
+		for(std::size_t i = 0; i != m_size; ++i){
+			m_sum += m_buffer[i];
+			m_sumSqr += m_buffer[i] * m_buffer[i];
+		}
+	}
+
+	std::vector<double> m_buffer; ///< the last capacity() values, ring order
+	std::size_t m_head; ///< position the next value is written to
+	std::size_t m_size; ///< number of values pushed, saturating at the capacity
+	double m_sum; ///< running sum of the window
+	double m_sumSqr; ///< running sum of squares of the window
+};
+
+}
+
+#endif
@@ -0,0 +1,207 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Bagging ensemble trainer
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_ALGORITHMS_TRAINERS_BAGGINGTRAINER_H
+#define SHARK_ALGORITHMS_TRAINERS_BAGGINGTRAINER_H
+
+#include <shark/Algorithms/Trainers/AbstractWeightedTrainer.h>
+#include <shark/Models/MeanModel.h>
+#include <shark/ObjectiveFunctions/Loss/AbstractLoss.h>
+#include <shark/Data/DataView.h>
+#include <shark/Core/OpenMP.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <utility>
+#include <vector>
+
+namespace shark {
+
+/// \brief Turns any weighted base trainer into a bagging ensemble trainer.
+///
+/// Bagging (bootstrap aggregating) trains every ensemble member on a
+/// bootstrap sample of the training set and averages the member outputs;
+/// see<br/>
+/// Bagging predictors. Leo Breiman. Machine Learning, 24(2), pages 123-140, 1996.<br/>
+///
+/// \par
+/// Every bootstrap sample is represented as a weighted view on the
+/// training set where the weight of a point is its multiplicity in the
+/// sample, so the data is never copied. The members are trained in
+/// parallel and aggregated into a MeanModel. If a loss is supplied via
+/// setOOBLoss, the out-of-bag error - the loss of every point averaged
+/// over the members that did not see it during training - is computed
+/// on the fly and can be queried with OOBerror(), giving an unbiased
+/// estimate of the ensemble error without a holdout set.
+template<class BaseTrainerType>
+class BaggingTrainer : public AbstractTrainer<
+	MeanModel<typename BaseTrainerType::ModelType>,
+	typename BaseTrainerType::LabelType
+>{
+public:
+	typedef typename BaseTrainerType::ModelType BaseModelType;
+	typedef MeanModel<BaseModelType> ModelType;
+	typedef typename BaseTrainerType::InputType InputType;
+	typedef typename BaseTrainerType::LabelType LabelType;
+	typedef LabeledData<InputType, LabelType> DatasetType;
+	typedef WeightedLabeledData<InputType, LabelType> WeightedDatasetType;
+	typedef AbstractLoss<LabelType, typename BaseModelType::OutputType> LossType;
+
+	/// \brief Constructor.
+	///
+	/// \param baseTrainer    trainer used for the ensemble members; must outlive the BaggingTrainer
+	/// \param numberOfModels number of ensemble members
+	BaggingTrainer(BaseTrainerType* baseTrainer, std::size_t numberOfModels = 100)
+	: m_baseTrainer(baseTrainer)
+	, m_numberOfModels(numberOfModels)
+	, m_oobLoss(nullptr)
+	, m_oobError(0.0){
+		SHARK_CHECK(baseTrainer != nullptr, "[BaggingTrainer] base trainer must not be null");
+		SHARK_CHECK(numberOfModels > 0, "[BaggingTrainer] ensemble must have at least one member");
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "BaggingTrainer"; }
+
+	/// \brief Returns the number of ensemble members.
+	std::size_t numberOfModels() const{
+		return m_numberOfModels;
+	}
+	/// \brief Sets the number of ensemble members.
+	void setNumberOfModels(std::size_t numberOfModels){
+		SHARK_CHECK(numberOfModels > 0, "[BaggingTrainer] ensemble must have at least one member");
+		m_numberOfModels = numberOfModels;
+	}
+
+	/// \brief Sets the loss used to compute the out-of-bag error during training.
+	///
+	/// The loss must outlive the call to train. Without a loss, no
+	/// out-of-bag error is computed.
+	void setOOBLoss(LossType const* loss){
+		m_oobLoss = loss;
+	}
+
+	/// \brief Out-of-bag error of the last training; 0 if no loss was set.
+	double OOBerror() const{
+		return m_oobError;
+	}
+
+	void train(ModelType& model, DatasetType const& dataset){
+		model.clearModels();
+		DataView<DatasetType const> elements(dataset);
+		std::size_t numElements = elements.size();
+		SHARK_CHECK(numElements != 0, "[BaggingTrainer::train] dataset must not be empty");
+
+		//out-of-bag tallies: summed member output and number of members
+		//for which every point was out of bag
+		RealMatrix oobTally;
+		UIntVector oobCount(numElements, 0);
+
+		auto seed = Rng::discrete(0,(unsigned)-1);
+		m_oobError = 0.0;
+
+		SHARK_PARALLEL_FOR(long b = 0; b < (long)m_numberOfModels; ++b){
+			Rng::rng_type rng{static_cast<unsigned>(seed + b)};
+
+			//draw the multiplicity of every point in the bootstrap sample
+			std::vector<std::size_t> counts(numElements, 0);
+			DiscreteUniform<Rng::rng_type> uniform(rng, 0, numElements - 1);
+			for(std::size_t i = 0; i != numElements; ++i){
+				++counts[uniform()];
+			}
+
+			//wrap the multiplicities as weights around the dataset;
+			//this shares the data, nothing is copied
+			Data<double> weights(dataset.numberOfBatches());
+			std::size_t element = 0;
+			for(std::size_t j = 0; j != dataset.numberOfBatches(); ++j){
+				std::size_t currentBatchSize = shark::size(dataset.inputs().batch(j));
+				RealVector batchWeights(currentBatchSize);
+				for(std::size_t e = 0; e != currentBatchSize; ++e){
+					batchWeights(e) = (double)counts[element++];
+				}
+				weights.batch(j) = batchWeights;
+			}
+			WeightedDatasetType bootstrapSample(dataset, weights);
+
+			BaseModelType member;
+			m_baseTrainer->train(member, bootstrapSample);
+
+			//evaluate the points this member has not seen before
+			//entering the critical region
+			std::vector<std::pair<std::size_t, RealVector> > oobOutputs;
+			if(m_oobLoss){
+				for(std::size_t i = 0; i != numElements; ++i){
+					if(counts[i] != 0) continue;
+					oobOutputs.emplace_back(i, member(elements[i].input));
+				}
+			}
+
+			SHARK_CRITICAL_REGION{
+				model.addModel(member);
+				if(m_oobLoss && !oobOutputs.empty()){
+					if(oobTally.size1() == 0)
+						oobTally.resize(numElements, oobOutputs.front().second.size());
+					for(auto const& output : oobOutputs){
+						noalias(row(oobTally, output.first)) += output.second;
+						++oobCount(output.first);
+					}
+				}
+			}
+		}
+
+		//average the tallies and compute the out-of-bag error
+		if(m_oobLoss && oobTally.size1() != 0){
+			std::vector<typename BaseModelType::OutputType> predictions;
+			std::vector<LabelType> labels;
+			for(std::size_t i = 0; i != numElements; ++i){
+				if(oobCount(i) == 0) continue;
+				predictions.push_back(row(oobTally,i)/oobCount(i));
+				labels.push_back(elements[i].label);
+			}
+			m_oobError = m_oobLoss->eval(
+				createDataFromRange(labels),
+				createDataFromRange(predictions)
+			);
+		}
+	}
+
+private:
+	BaseTrainerType* m_baseTrainer; ///< trainer of the ensemble members
+	std::size_t m_numberOfModels;   ///< number of ensemble members
+	LossType const* m_oobLoss;      ///< loss for the out-of-bag error, may be null
+	double m_oobError;              ///< out-of-bag error of the last training
+};
+
+}
+#endif
@@ -51,13 +51,18 @@
 #define SHARK_MODELS_MERGEBUDGETMAINTENANCESTRATEGY_H
 
 #include <shark/Algorithms/GradientDescent/LineSearch.h>
+#include <shark/Algorithms/NearestNeighbors/TreeNearestNeighbors.h>
 #include <shark/Data/Dataset.h>
 #include <shark/Data/DataView.h>
 #include <shark/Models/Converter.h>
 #include <shark/Models/Kernels/AbstractKernelFunction.h>
+#include <shark/Models/Trees/KDTree.h>
 
 #include <shark/Algorithms/Trainers/Budgeted/AbstractBudgetMaintenanceStrategy.h>
 
+#include <boost/shared_ptr.hpp>
+#include <set>
+
 
 namespace shark
 {
@@ -136,7 +141,26 @@ public:
 
 	/// constructor.
 	MergeBudgetMaintenanceStrategy()
+		: m_maxCandidates(32)
+	{
+	}
+
+
+	/// Sets the number of merge candidates inspected per merge.
+	/// On budgets larger than this, only the approximate nearest
+	/// neighbours of the first merging partner are evaluated instead
+	/// of the whole budget; 0 restores the exhaustive O(B) search.
+	/// \param[in]  maxCandidates   number of candidates, 0 for the exhaustive search
+	void setMaxCandidates(std::size_t maxCandidates)
 	{
+		m_maxCandidates = maxCandidates;
+	}
+
+
+	/// Returns the number of merge candidates inspected per merge.
+	std::size_t maxCandidates() const
+	{
+		return m_maxCandidates;
 	}
 
 
@@ -229,11 +253,10 @@ public:
 	{
 		size_t maxIndex = model.basis().numberOfElements();
 
-		// compute the kernel row of the given, first element and all the others
-		// should take O(B) time, as it is a row of size B
-		blas::vector<float> kernelRow(maxIndex, 0.0);
-		for(size_t j = 0; j < maxIndex; j++)
-			kernelRow(j) = static_cast<float>( model.kernel()->eval(model.basis().element(firstIndex), model.basis().element(j)));
+		// select the pairs to inspect: either the whole budget or, on
+		// large budgets, the approximate nearest neighbours of the first
+		// element (see mergeCandidates)
+		std::vector<size_t> candidates = mergeCandidates(model, firstIndex);
 
 		// initialize the search
 		double fret(0.);
@@ -248,9 +271,9 @@ public:
 		size_t secondIndex = 0;
 
 
-		// we need to check every other vector
+		// we need to check every candidate vector
 		RealMatrix &alpha = model.alpha();
-		for(size_t currentIndex = 0; currentIndex < maxIndex; currentIndex++)
+		for(size_t currentIndex : candidates)
 		{
 			// we do not want the vector already chosen
 			if(firstIndex == currentIndex)
@@ -271,7 +294,7 @@ public:
 			h(0) = 0.0;
 			xi(0) = 0.5;
 
-			double k = kernelRow(currentIndex);
+			double k = model.kernel()->eval(model.basis().element(firstIndex), model.basis().element(currentIndex));
 			MergingProblemFunction mergingProblemFunction(a, b, k);
 
 			// minimize function
@@ -340,6 +363,11 @@ public:
 		// clear the  buffer by cleaning the alphas
 		// finally the vectors we merged.
 		row(model.alpha(), maxIndex - 1).clear();
+
+		// both positions now hold vectors the search tree snapshot
+		// does not know about
+		m_dirty.insert(firstIndex);
+		m_dirty.insert(secondIndex);
 	}
 
 
@@ -408,6 +436,79 @@ public:
 
 
 protected:
+
+	/// Select the indices to inspect as merging partners.
+	/// For small budgets, or if the approximate search is disabled, this
+	/// is every vector but the first one, reproducing the exhaustive
+	/// O(B) search. For large budgets a KD-tree snapshot of the budget
+	/// vectors is maintained and only the approximate nearest neighbours
+	/// of the first vector are returned: the closer a vector is, the
+	/// larger its kernel value with the first vector and the smaller the
+	/// expected merging degradation. Vectors changed since the snapshot
+	/// was taken are not represented in the tree, so they are always
+	/// added to the candidate set, and the tree is rebuilt once too many
+	/// of them accumulate. This bounds the work per merge by the number
+	/// of candidates plus an O(log B) query, with the rebuilds amortized
+	/// over the merges between them.
+	/// \param[in]  model       Model to work on
+	/// \param[in]  firstIndex  The index of the first element of the pair to merge.
+	/// \return     indices of the candidate merging partners
+	///
+	std::vector<size_t> mergeCandidates(ModelType& model, size_t firstIndex)
+	{
+		size_t maxIndex = model.basis().numberOfElements();
+		std::vector<size_t> candidates;
+
+		// exhaustive search for small budgets or when disabled
+		if(m_maxCandidates == 0 || maxIndex <= m_maxCandidates + 2)
+		{
+			for(size_t j = 0; j < maxIndex; j++)
+				if(j != firstIndex)
+					candidates.push_back(j);
+			return candidates;
+		}
+
+		// rebuild the snapshot when too many vectors changed since the last one
+		if(!m_tree || m_dirty.size() >= std::max(m_maxCandidates, maxIndex / 10))
+		{
+			std::vector<RealVector> points(maxIndex);
+			for(size_t j = 0; j < maxIndex; j++)
+				points[j] = model.basis().element(j);
+			m_treeData = createDataFromRange(points);
+			m_treeView.reset(new DataView<Data<RealVector> const>(m_treeData));
+			m_tree.reset(new KDTree<RealVector>(m_treeData));
+			m_dirty.clear();
+		}
+
+		// query the approximate nearest neighbours of the first vector
+		RealVector reference = model.basis().element(firstIndex);
+		IterativeNNQuery<DataView<Data<RealVector> const> > query(m_tree.get(), *m_treeView, reference);
+		std::set<size_t> selected;
+		size_t neighbours = std::min(m_maxCandidates, maxIndex - 1);
+		for(size_t j = 0; j < maxIndex && selected.size() < neighbours; j++)
+		{
+			size_t neighbour = query.next().second;
+			if(neighbour != firstIndex)
+				selected.insert(neighbour);
+		}
+
+		// vectors changed since the snapshot, including the buffer
+		// holding the newest vector, are always inspected
+		selected.insert(m_dirty.begin(), m_dirty.end());
+		selected.insert(maxIndex - 1);
+		selected.erase(firstIndex);
+
+		candidates.assign(selected.begin(), selected.end());
+		return candidates;
+	}
+
+
+	std::size_t m_maxCandidates; ///< number of merge candidates inspected per merge, 0 for the exhaustive search
+	std::set<size_t> m_dirty;    ///< indices of budget vectors changed since the last tree rebuild
+
+	Data<RealVector> m_treeData; ///< snapshot of the budget vectors the tree is built on
+	boost::shared_ptr<DataView<Data<RealVector> const> > m_treeView; ///< view on the snapshot for the queries
+	boost::shared_ptr<KDTree<RealVector> > m_tree; ///< KD-tree over the snapshot
 };
 
 }
@@ -43,12 +43,16 @@
 #ifndef SHARK_MODELS_PROJECTBUDGETMAINTENANCESTRATEGY_H
 #define SHARK_MODELS_PROJECTBUDGETMAINTENANCESTRATEGY_H
 
+#include <shark/LinAlg/Cholesky.h>
+#include <shark/LinAlg/solveTriangular.h>
 #include <shark/Models/Converter.h>
 #include <shark/Models/Kernels/AbstractKernelFunction.h>
 #include <shark/ObjectiveFunctions/KernelBasisDistance.h>
 #include <shark/Data/Dataset.h>
 #include <shark/Data/DataView.h>
 
+#include <algorithm>
+
 
 namespace shark {
 
@@ -111,18 +115,19 @@ namespace shark {
         public:
 
             /// constructor.
-            ProjectBudgetMaintenanceStrategy() {
+            ProjectBudgetMaintenanceStrategy()
+            : m_trackedModel (NULL) {
             }
 
 
-                
+
             /// add a vector to the model.
             /// this will add the given vector to the model and merge the budget so that afterwards
             /// the budget size is kept the same. If the budget has a free entry anyway, no merging
             /// will be performed, but instead the given vector is simply added to the budget.
             ///
             /// @param[in,out]  model   the model the strategy will work with
-            /// @param[in]  alpha   alphas for the new budget vector 
+            /// @param[in]  alpha   alphas for the new budget vector
             /// @param[in]  supportVector the vector to add to the model by applying the maintenance strategy
             ///
             virtual void addToModel (ModelType& model, InputType const& alpha, ElementType const& supportVector) {
@@ -135,13 +140,13 @@ namespace shark {
                 size_t maxIndex = model.basis().numberOfElements();
                 model.basis().element(maxIndex - 1) = supportVector.input;
                 row (model.alpha(), maxIndex - 1) = alpha;
-                
-                
+
+
                 size_t firstIndex = 0;
                 double firstAlpha = 0;
                 findSmallestVector (model, firstIndex, firstAlpha);
-                
-                // if the smallest vector has zero alpha, 
+
+                // if the smallest vector has zero alpha,
                 // the budget is not yet filled so we can skip projecting.
                 if (firstAlpha == 0.0f)
                 {
@@ -152,18 +157,208 @@ namespace shark {
 
                     // enough to zero out the alpha
                     row (model.alpha(), maxIndex - 1).clear();
-                    
+
+                    // the budget composition is still changing, so any cached
+                    // factorization of it is stale
+                    m_trackedModel = NULL;
+
                     // ready.
                     return;
                 }
-                
-                // now solve the projection equation
-                
+
+                // now solve the projection equation K_z beta = k_zx alpha_x,
+                // where z are all budget vectors except the chosen one x.
+                // the cholesky factor of the gram matrix K_z is maintained
+                // across calls: each projection swaps a single vector of the
+                // budget, so the factor is repaired by a rank-one downdate and
+                // an appended row instead of a full refactorization. this makes
+                // a projection cost O(B^2) instead of O(B^3).
+                try
+                {
+                    if (m_trackedModel != &model || m_memberSlots.size() != maxIndex - 1) {
+                        rebuildFactor (model, firstIndex);
+                    }
+                    else if (firstIndex != maxIndex - 1) {
+                        // swap the projected vector out of the factor and the new one in.
+                        // if the new vector itself is projected, the factor already
+                        // covers exactly the remaining budget.
+                        size_t position = std::find (m_memberSlots.begin(), m_memberSlots.end(), firstIndex) - m_memberSlots.begin();
+                        removeMember (position);
+                        if (!appendMember (model, maxIndex - 1))
+                            rebuildFactor (model, firstIndex);
+                    }
+
+                    projectOntoMembers (model, firstIndex);
+                }
+                catch (Exception const&)
+                {
+                    // the incrementally maintained factor became indefinite;
+                    // fall back to the robust semi-definite solver for this call
+                    m_trackedModel = NULL;
+                    projectWithBasisDistance (model, firstIndex);
+                }
+
+                // overwrite the projected vector with the last vector. the new
+                // vector keeps the projected coefficients it accumulated as a
+                // budget member.
+                model.basis().element(firstIndex) = supportVector.input;
+                row (model.alpha(), firstIndex) = row (model.alpha(), maxIndex - 1);
+
+                // zero out buffer, enough to zero out the alpha
+                row (model.alpha(), maxIndex - 1).clear();
+
+                // the new vector moved from the buffer slot into the freed one
+                if ((m_trackedModel == &model) && (firstIndex != maxIndex - 1))
+                    *std::find (m_memberSlots.begin(), m_memberSlots.end(), maxIndex - 1) = firstIndex;
+            }
+
+
+            /// class name
+            std::string name() const
+            { return "ProjectBudgetMaintenanceStrategy"; }
+
+        protected:
+
+            /// rebuild the gram matrix factor of all budget vectors except the given one.
+            /// this is the O(B^3) path, taken only when no valid factor is cached.
+            ///
+            /// @param[in]  model   the model the strategy currently works with
+            /// @param[in]  excludedSlot    budget slot left out of the factor
+            ///
+            void rebuildFactor (ModelType& model, size_t excludedSlot) {
+                AbstractKernelFunction<InputType> const& kernel = *model.kernel();
+                size_t maxIndex = model.basis().numberOfElements();
+
+                m_memberSlots.clear();
+                for (size_t t = 0; t < maxIndex; t++) {
+                    if (t != excludedSlot)
+                        m_memberSlots.push_back(t);
+                }
+
+                size_t members = m_memberSlots.size();
+                std::vector<RealVector> memberVectors (members);
+                for (size_t r = 0; r < members; r++)
+                    memberVectors[r] = model.basis().element(m_memberSlots[r]);
+
+                RealMatrix gram (members, members);
+                for (size_t i = 0; i < members; i++) {
+                    for (size_t j = 0; j <= i; j++)
+                        gram(i, j) = gram(j, i) = kernel.eval(memberVectors[i], memberVectors[j]);
+                }
+                choleskyDecomposition (gram, m_cholesky);
+                m_trackedModel = &model;
+            }
+
+
+            /// remove the member at the given factor position.
+            /// the part of the factor below the removed row absorbs the removed
+            /// column as a rank-one update, which costs O(B^2).
+            ///
+            /// @param[in]  position    position of the member within the factor
+            ///
+            void removeMember (size_t position) {
+                size_t members = m_memberSlots.size();
+                if (position + 1 != members) {
+                    RealVector update = subrange(column(m_cholesky, position), position + 1, members);
+                    auto trailing = subrange(m_cholesky, position + 1, members, position + 1, members);
+                    choleskyUpdate (trailing, update, 1.0, 1.0);
+                }
+
+                // close the gap left by the removed row and column
+                RealMatrix cholesky (members - 1, members - 1, 0.0);
+                for (size_t i = 0, ti = 0; i < members; i++) {
+                    if (i == position)
+                        continue;
+                    for (size_t j = 0, tj = 0; j <= i; j++) {
+                        if (j == position)
+                            continue;
+                        cholesky(ti, tj) = m_cholesky(i, j);
+                        tj++;
+                    }
+                    ti++;
+                }
+                m_cholesky = cholesky;
+                m_memberSlots.erase(m_memberSlots.begin() + position);
+            }
+
+
+            /// append the vector in the given budget slot to the factor in O(B^2).
+            /// returns false if the extended gram matrix is not numerically
+            /// positive definite, in which case the factor is left unchanged.
+            ///
+            /// @param[in]  model   the model the strategy currently works with
+            /// @param[in]  slot    budget slot of the vector to append
+            ///
+            bool appendMember (ModelType& model, size_t slot) {
+                AbstractKernelFunction<InputType> const& kernel = *model.kernel();
+                size_t members = m_memberSlots.size();
+                RealVector newVector = model.basis().element(slot);
+
+                RealVector kernelRow (members);
+                RealVector memberVector;
+                for (size_t r = 0; r < members; r++) {
+                    memberVector = model.basis().element(m_memberSlots[r]);
+                    kernelRow(r) = kernel.eval(memberVector, newVector);
+                }
+                double diagonal = kernel.eval(newVector, newVector);
+
+                blas::solveTriangularSystemInPlace<blas::SolveAXB, blas::lower>(m_cholesky, kernelRow);
+                double remainder = diagonal - norm_sqr(kernelRow);
+                if (remainder <= 0.0)
+                    return false;
+
+                RealMatrix cholesky (members + 1, members + 1, 0.0);
+                noalias(subrange(cholesky, 0, members, 0, members)) = m_cholesky;
+                noalias(subrange(row(cholesky, members), 0, members)) = kernelRow;
+                cholesky(members, members) = std::sqrt(remainder);
+                m_cholesky = cholesky;
+                m_memberSlots.push_back(slot);
+                return true;
+            }
+
+
+            /// project the vector in the given budget slot onto the factor members
+            /// and add the resulting coefficients to their alphas. with the factor
+            /// in place this is two triangular solves, O(B^2) per class.
+            ///
+            /// @param[in,out]  model   the model the strategy currently works with
+            /// @param[in]  removedSlot budget slot of the vector projected out
+            ///
+            void projectOntoMembers (ModelType& model, size_t removedSlot) {
+                AbstractKernelFunction<InputType> const& kernel = *model.kernel();
+                size_t members = m_memberSlots.size();
+                RealVector removedVector = model.basis().element(removedSlot);
+
+                RealVector kernelRow (members);
+                RealVector memberVector;
+                for (size_t r = 0; r < members; r++) {
+                    memberVector = model.basis().element(m_memberSlots[r]);
+                    kernelRow(r) = kernel.eval(memberVector, removedVector);
+                }
+
+                RealMatrix projectedAlphas = outer_prod(kernelRow, row(model.alpha(), removedSlot));
+                blas::solveTriangularCholeskyInPlace<blas::SolveAXB>(m_cholesky, projectedAlphas);
+
+                for (size_t r = 0; r < members; r++)
+                    noalias(row(model.alpha(), m_memberSlots[r])) += row(projectedAlphas, r);
+            }
+
+
+            /// project the vector in the given budget slot onto all others with
+            /// the kernel basis distance. this refactorizes the full system and
+            /// is only used when the incremental factor cannot be repaired.
+            ///
+            /// @param[in,out]  model   the model the strategy will work with
+            /// @param[in]  firstIndex  budget slot of the vector projected out
+            ///
+            void projectWithBasisDistance (ModelType& model, size_t firstIndex) {
+                size_t maxIndex = model.basis().numberOfElements();
+
                 // we need to project the one vector we have chosen down
                 // to all others. so we need a model with just thet one vector
                 // and then we try to approximate alphas from the rest of thet
                 // vectors, such that the difference is small as possible.
-                
+
                 // create a KernelExpansion just with the one selected vector.
                 std::vector<RealVector> singlePointVector (1,model.basis().element(firstIndex));
                 std::vector<unsigned int> singlePointLabel (1, 0);
@@ -172,7 +367,7 @@ namespace shark {
                 row (singlePointExpansion.alpha(), 0) = row (model.alpha(), firstIndex);
                 KernelBasisDistance distance(&singlePointExpansion, maxIndex - 1);
 
-                // now create a whole new 'point' with all the other vectors. 
+                // now create a whole new 'point' with all the other vectors.
                 // then our approximation will give us one coefficient to approximate
                 // the basis, which consits only of the one selected vector.
                 // thus, we approximate the one vector with the rest of them.
@@ -188,41 +383,37 @@ namespace shark {
                     noalias(subrange(point, linearIndex*inputDimension, (linearIndex+1)*inputDimension)) = (model.basis().element(t));
                     linearIndex++;
                 }
-                
+
                 //calculate solution found by the function and check that it is close
                 RealMatrix projectedAlphas = distance.findOptimalBeta(point);
 
                 // stupid sanity check
                 SHARK_ASSERT (projectedAlphas.size2() == model.alpha().size2());
-                
+
                 // add the projected values to the budget
                 linearIndex = 0;
                 for (std::size_t j = 0; j < maxIndex; j++)
                 {
                     if (j == firstIndex)
                         continue;
-            
+
                     // for each class we add the alpha contribution to the true alphas.
-                    for (std::size_t c = 0; c < model.alpha().size2(); c++) 
+                    for (std::size_t c = 0; c < model.alpha().size2(); c++)
                         model.alpha(j, c) += projectedAlphas(linearIndex, c);
-                    
+
                     linearIndex++;
                 }
-                
-                // overwrite the projected vector with the last vector
-                model.basis().element(firstIndex) = supportVector.input;
-                row (model.alpha(), firstIndex) = alpha;
-
-                // zero out buffer, enough to zero out the alpha
-                row (model.alpha(), maxIndex - 1).clear();
             }
 
 
-            /// class name
-            std::string name() const
-            { return "ProjectBudgetMaintenanceStrategy"; }
+            /// the model the cached factor belongs to; NULL if no factor is cached
+            ModelType const* m_trackedModel;
 
-        protected:
+            /// lower cholesky factor of the gram matrix of the tracked budget members
+            RealMatrix m_cholesky;
+
+            /// budget slot of every factor position
+            std::vector<std::size_t> m_memberSlots;
 
     };
 
@@ -79,6 +79,7 @@ public:
 	CARTTrainer(){
 		m_nodeSize = 1;
 		m_numberOfFolds = 10;
+		m_histogramBins = 0;
 	}
 
 	/// \brief From INameable: return the class name.
@@ -95,6 +96,15 @@ public:
 	void setNumberOfFolds(unsigned int folds){
 		m_numberOfFolds = folds;
 	}
+
+	///Sets the number of histogram bins used for split finding.
+	///The default of zero searches all distinct attribute values exactly.
+	///A positive value quantizes every attribute once per tree into at most
+	///that many quantile bins and only considers bin boundaries as split
+	///points, which turns split finding into a linear pass per node.
+	void setHistogramBins(std::size_t bins){
+		m_histogramBins = bins;
+	}
 protected:
 	using Split = detail::cart::Split;
 
@@ -130,6 +140,9 @@ protected:
 	///Number of folds used to create the tree.
 	unsigned int m_numberOfFolds;
 
+	///Number of histogram bins used for split finding; zero searches exactly
+	std::size_t m_histogramBins;
+
 	//Classification functions
 	///Builds a single decision tree from a classification dataset
 	///The method requires the attribute tables,
@@ -154,6 +167,14 @@ protected:
 	SHARK_EXPORT_SYMBOL Split findSplit(detail::cart::SortedIndex const& tables, ClassificationDataset const& dataset, ClassVector const& cFull) const;
 	SHARK_EXPORT_SYMBOL Split findSplit(detail::cart::SortedIndex const& tables, RegressionDataset const& dataset, RealVector const& sumFull) const;
 
+	//Histogram mode: the index quantizes each attribute once per tree and
+	//nodes keep a plain list of their element ids instead of sorted tables
+	SHARK_EXPORT_SYMBOL TreeType buildTreeHistogram(detail::cart::BinnedIndex const& index, std::vector<std::size_t>&& elementIds, std::vector<unsigned int> const& labels, ClassVector& cFull, std::size_t nodeId);
+	SHARK_EXPORT_SYMBOL TreeType buildTreeHistogram(detail::cart::BinnedIndex const& index, std::vector<std::size_t>&& elementIds, std::vector<RealVector> const& labels, RealVector const& sumFull, std::size_t nodeId, std::size_t trainSize);
+
+	SHARK_EXPORT_SYMBOL Split findSplitHistogram(detail::cart::BinnedIndex const& index, std::vector<std::size_t> const& elementIds, std::vector<unsigned int> const& labels, ClassVector const& cFull) const;
+	SHARK_EXPORT_SYMBOL Split findSplitHistogram(detail::cart::BinnedIndex const& index, std::vector<std::size_t> const& elementIds, std::vector<RealVector> const& labels, RealVector const& sumFull) const;
+
 };
 
 
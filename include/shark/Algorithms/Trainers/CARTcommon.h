@@ -37,6 +37,7 @@
 #include <shark/Models/Trees/General.h>
 #include <shark/Data/DataView.h>
 #include <shark/Models/Trees/CARTClassifier.h>
+#include <cstdint>
 #include <vector>
 #include <utility>
 namespace shark {
@@ -185,6 +186,73 @@ public:
 	}
 };
 
+/**
+ * A quantization of a dataset into per-attribute histogram bins.
+ *
+ * Every attribute is sorted once and cut at (approximate) quantiles into at
+ * most a fixed number of bins, so that each bin holds roughly the same number
+ * of training points. A tree node can then accumulate per-bin statistics with
+ * one linear pass over its elements and only needs to consider the bin
+ * boundaries as split points, instead of maintaining sorted attribute tables
+ * through every split.
+ */
+class BinnedIndex {
+	std::size_t const m_noElements, m_noInputDimensions, m_noBins;
+	/// bin of every element, one table per attribute
+	std::vector<std::vector<std::uint16_t>> m_bins;
+	/// largest attribute value mapped to each bin
+	std::vector<std::vector<double>> m_binMax;
+public:
+	template<class Dataset>
+	explicit BinnedIndex(Dataset const& dataset, std::size_t noBins)
+			: m_noElements{dataset.numberOfElements()},
+			  m_noInputDimensions{inputDimension(dataset)},
+			  m_noBins{std::min<std::size_t>(noBins, 65535)},
+			  m_bins(m_noInputDimensions),
+			  m_binMax(m_noInputDimensions)
+	{
+		SHARK_CHECK(m_noBins >= 2, "[BinnedIndex] at least two bins are required");
+		std::vector<Attribute> table(m_noElements);
+		for (std::size_t j = 0; j < m_noInputDimensions; j++) {
+			std::size_t i = 0;
+			for(auto const& element: dataset.elements()){
+				table[i] = Attribute{element.input[j], i};
+				++i;
+			}
+			std::sort(table.begin(), table.end());
+
+			auto& bins = m_bins[j];
+			bins.resize(m_noElements);
+			auto& binMax = m_binMax[j];
+			binMax.assign(m_noBins, -std::numeric_limits<double>::max());
+			// walk the sorted values and advance to the next bin at every
+			// quantile boundary, but never inside a run of equal values
+			std::size_t bin = 0;
+			for (std::size_t i = 0; i < m_noElements; i++) {
+				if(i && table[i].value != table[i-1].value
+				     && (i * m_noBins) / m_noElements != ((i-1) * m_noBins) / m_noElements){
+					++bin;
+				}
+				bins[table[i].id] = static_cast<std::uint16_t>(bin);
+				binMax[bin] = table[i].value;
+			}
+		}
+	}
+
+	std::size_t noTables() const { return m_noInputDimensions; }
+	std::size_t noRows() const { return m_noElements; }
+	std::size_t noBins() const { return m_noBins; }
+	/// bin of element i under attribute j
+	std::uint16_t bin(std::size_t j, std::size_t i) const {
+		return m_bins[j][i];
+	}
+	/// largest value of attribute j mapped to bin b; a valid split
+	/// threshold because bins separate distinct sorted values
+	double binMax(std::size_t j, std::size_t b) const {
+		return m_binMax[j][b];
+	}
+};
+
 /// Generate a histogram from the count vector.
 inline RealVector hist(ClassVector const& countVector) {
 	return countVector/double(sum(countVector));
@@ -92,7 +92,9 @@ public:
 	/// The default is float, offering sufficient accuracy in the vast majority
 	/// of cases, at a memory cost of only four bytes. However, the template
 	/// parameter makes it easy to use double instead, (e.g., in case high
-	/// accuracy training is needed).
+	/// accuracy training is needed). For very large, memory bound problems
+	/// shark::HalfFloat (see shark/Core/HalfPrecision.h) halves the cache
+	/// footprint once more; the solver still accumulates in double precision.
 	typedef CacheType QpFloatType;
 
 	typedef AbstractKernelFunction<InputType> KernelType;
@@ -103,7 +105,7 @@ public:
 	//! \param offset whether to train the svm with offset term
 	//! \param  unconstrained  when a C-value is given via setParameter, should it be piped through the exp-function before using it in the solver?
 	CSvmTrainer(KernelType* kernel, double C, bool offset, bool unconstrained = false)
-	: base_type(kernel, C, offset, unconstrained), m_computeDerivative(false), m_McSvmType(McSvm::WW) //make  Vapnik happy!
+	: base_type(kernel, C, offset, unconstrained), m_computeDerivative(false), m_McSvmType(McSvm::WW), m_mcBlockSize(2) //make  Vapnik happy!
 	{ }
 	
 	//! Constructor
@@ -113,7 +115,7 @@ public:
 	//! \param offset whether to train the svm with offset term
 	//! \param  unconstrained  when a C-value is given via setParameter, should it be piped through the exp-function before using it in the solver?
 	CSvmTrainer(KernelType* kernel, double negativeC, double positiveC, bool offset, bool unconstrained = false)
-	: base_type(kernel,negativeC, positiveC, offset, unconstrained), m_computeDerivative(false), m_McSvmType(McSvm::WW) //make  Vapnik happy!
+	: base_type(kernel,negativeC, positiveC, offset, unconstrained), m_computeDerivative(false), m_McSvmType(McSvm::WW), m_mcBlockSize(2) //make  Vapnik happy!
 	{ }
 
 	/// \brief From INameable: return the class name.
@@ -129,6 +131,16 @@ public:
 		m_McSvmType = type;
 	}
 
+	/// \brief sets the working set size of the multi-class decomposition solvers
+	///
+	/// The default size of 2 performs classic S2DO steps. Larger working
+	/// sets amortize the kernel row computations over more progress per
+	/// iteration, which pays off in particular for many classes. The
+	/// setting has no effect on binary and one-versus-all training.
+	void setMcBlockSize(std::size_t blockSize){
+		m_mcBlockSize = blockSize;
+	}
+
 
 	/// \brief Train the C-SVM.
 	void train(KernelClassifier<InputType>& svm, LabeledData<InputType, unsigned int> const& dataset)
@@ -279,6 +291,45 @@ public:
 		if (base_type::sparsify()) f.sparsify();
 	}
 	
+	/// \brief Train C-SVMs for a whole regularization path.
+	///
+	/// Trains one machine per entry of regularizations, sharing a single
+	/// kernel cache across all solves and warm starting every solve from
+	/// the previous solution with the alphas clipped to the new box. When
+	/// C is grid-searched this makes the full path cost little more than
+	/// the hardest single solve of the sequence. svms is resized to hold
+	/// one classifier per value of C; solutionProperties() refers to the
+	/// last solve. For trainers with class-wise regularization both
+	/// parameters are scaled proportionally along the path.
+	///
+	/// \param svms             trained classifiers, one per regularization value
+	/// \param dataset          binary classification problem to train on
+	/// \param regularizations  sequence of C values, best traversed in increasing order
+	void trainPath(
+		std::vector<KernelClassifier<InputType> >& svms,
+		LabeledData<InputType, unsigned int> const& dataset,
+		RealVector const& regularizations
+	){
+		SHARK_CHECK(regularizations.size() > 0, "[CSvmTrainer::trainPath] empty regularization path");
+		if(numberOfClasses(dataset) != 2)
+			throw SHARKEXCEPTION("[CSvmTrainer::trainPath] regularization paths are only implemented for binary problems");
+		svms.resize(regularizations.size());
+
+		typedef KernelMatrix<InputType, QpFloatType> KernelMatrixType;
+		KernelMatrixType km(*base_type::m_kernel, dataset.inputs());
+		if (QpConfig::precomputeKernel())
+		{
+			PrecomputedMatrix<KernelMatrixType> matrix(&km);
+			optimizePath(svms,matrix,dataset,regularizations);
+		}
+		else
+		{
+			CachedMatrix<KernelMatrixType> matrix(&km);
+			optimizePath(svms,matrix,dataset,regularizations);
+		}
+		base_type::m_accessCount = km.getAccessCount();
+	}
+
 	RealVector const& get_db_dParams()const{
 		return m_db_dParams;
 	}
@@ -302,6 +353,7 @@ private:
 			QpMcSimplexDecomp< PrecomputedMatrixType> problem(matrix, M, dataset.labels(), linear, this->C());
 			QpSolutionProperties& prop = base_type::m_solutionproperties;
 			problem.setShrinking(base_type::m_shrinking);
+			problem.setBlockSize(m_mcBlockSize);
 			if(this->m_trainOffset){
 				BiasSolverSimplex<PrecomputedMatrixType> biasSolver(&problem);
 				biasSolver.solve(bias,base_type::m_stoppingcondition,nu,sumToZero, &prop);
@@ -318,6 +370,7 @@ private:
 			QpMcSimplexDecomp< CachedMatrixType> problem(matrix, M, dataset.labels(), linear, this->C());
 			QpSolutionProperties& prop = base_type::m_solutionproperties;
 			problem.setShrinking(base_type::m_shrinking);
+			problem.setBlockSize(m_mcBlockSize);
 			if(this->m_trainOffset){
 				BiasSolverSimplex<CachedMatrixType> biasSolver(&problem);
 				biasSolver.solve(bias,base_type::m_stoppingcondition,nu,sumToZero, &prop);
@@ -348,6 +401,7 @@ private:
 			QpMcBoxDecomp< PrecomputedMatrixType> problem(matrix, M, dataset.labels(), linear, this->C());
 			QpSolutionProperties& prop = base_type::m_solutionproperties;
 			problem.setShrinking(base_type::m_shrinking);
+			problem.setBlockSize(m_mcBlockSize);
 			if(this->m_trainOffset){
 				BiasSolver<PrecomputedMatrixType> biasSolver(&problem);
 				biasSolver.solve(bias,base_type::m_stoppingcondition,nu, sumToZero, &prop);
@@ -364,6 +418,7 @@ private:
 			QpMcBoxDecomp< CachedMatrixType> problem(matrix, M, dataset.labels(), linear, this->C());
 			QpSolutionProperties& prop = base_type::m_solutionproperties;
 			problem.setShrinking(base_type::m_shrinking);
+			problem.setBlockSize(m_mcBlockSize);
 			if(this->m_trainOffset){
 				BiasSolver<CachedMatrixType> biasSolver(&problem);
 				biasSolver.solve(bias,base_type::m_stoppingcondition,nu, sumToZero, &prop);
@@ -684,10 +739,91 @@ private:
 		}
 	}
 	
+	// create one shared problem for the whole regularization path
+	template<class Matrix>
+	void optimizePath(
+		std::vector<KernelClassifier<InputType> >& svms, Matrix& matrix,
+		LabeledData<InputType, unsigned int> const& dataset, RealVector const& regularizations
+	){
+		typedef CSVMProblem<Matrix> SVMProblemType;
+		//start the path with the trainer's class-wise ratio scaled to the first C value
+		RealVector regularizers = base_type::m_regularizers * (regularizations(0) / base_type::m_regularizers(0));
+		SVMProblemType svmProblem(matrix,dataset.labels(),regularizers);
+		if (this->m_trainOffset)
+		{
+			SvmShrinkingProblem<SVMProblemType> problem(svmProblem,base_type::m_shrinking);
+			solvePath(svms,problem,dataset,regularizations);
+		}
+		else
+		{
+			BoxConstrainedShrinkingProblem<SVMProblemType> problem(svmProblem,base_type::m_shrinking);
+			solvePath(svms,problem,dataset,regularizations);
+		}
+	}
+
+	// solve the sequence of problems, warm starting each C value from the previous solution
+	template<class ProblemType>
+	void solvePath(
+		std::vector<KernelClassifier<InputType> >& svms,
+		ProblemType& problem,
+		LabeledData<InputType, unsigned int> const& dataset, RealVector const& regularizations
+	){
+		QpSolver<ProblemType> solver(problem);
+		RealVector regularizers = base_type::m_regularizers * (regularizations(0) / base_type::m_regularizers(0));
+		double currentC = regularizations(0);
+		for(std::size_t k = 0; k != regularizations.size(); ++k){
+			double C = regularizations(k);
+			if(k != 0){
+				//rescale the box while keeping the alphas, then clip the previous
+				//solution to the new bounds and feed it back as starting point
+				problem.scaleBoxConstraints(C / currentC, 1.0);
+				regularizers *= C / currentC;
+				currentC = C;
+				double C_minus = regularizers(0);
+				double C_plus = (regularizers.size() == 1) ? regularizers(0) : regularizers(1);
+				RealVector start = problem.getUnpermutedAlpha();
+				std::size_t i = 0;
+				for (auto label : dataset.labels().elements()) {
+					if (label == 0) start(i) = std::max(std::min(start(i), 0.0), -C_minus);
+					else            start(i) = std::min(std::max(start(i), 0.0), C_plus);
+					i++;
+				}
+				if (this->m_trainOffset){
+					//the offset formulation carries the constraint sum(alpha) = 0,
+					//which clipping may violate; shift alphas within their boxes
+					//until the constraint holds again
+					double excess = 0.0;
+					for (double a : start) excess += a;
+					i = 0;
+					for (auto label : dataset.labels().elements()) {
+						if (excess == 0.0) break;
+						double lo = (label == 0) ? -C_minus : 0.0;
+						double hi = (label == 0) ? 0.0 : C_plus;
+						double step = std::max(lo - start(i), std::min(hi - start(i), -excess));
+						start(i) += step;
+						excess += step;
+						i++;
+					}
+				}
+				problem.setInitialSolution(start);
+			}
+			solver.solve(base_type::stoppingCondition(), &base_type::solutionProperties());
+
+			auto& f = svms[k].decisionFunction();
+			f.setStructure(base_type::m_kernel,dataset.inputs(),this->m_trainOffset);
+			column(f.alpha(),0) = problem.getUnpermutedAlpha();
+			if (this->m_trainOffset)
+				f.offset(0) = computeBias(problem,dataset);
+			if (base_type::sparsify())
+				f.sparsify();
+		}
+	}
+
 	RealVector m_db_dParams; ///< in the rare case that there are only bounded SVs and no free SVs, this will hold the derivative of b w.r.t. the hyperparameters. Derivative w.r.t. C is last.
 
 	bool m_computeDerivative;
 	McSvm m_McSvmType;
+	std::size_t m_mcBlockSize;
 
 	template<class Problem>
 	double computeBias(Problem const& problem, LabeledData<InputType, unsigned int> const& dataset){
@@ -803,18 +939,28 @@ class LinearCSvmTrainer : public AbstractLinearSvmTrainer<InputType>
 public:
 	typedef AbstractLinearSvmTrainer<InputType> base_type;
 
-	LinearCSvmTrainer(double C, bool offset, bool unconstrained = false) 
-	: AbstractLinearSvmTrainer<InputType>(C, offset, unconstrained){}
+	LinearCSvmTrainer(double C, bool offset, bool unconstrained = false)
+	: AbstractLinearSvmTrainer<InputType>(C, offset, unconstrained)
+	, m_dcd(false){}
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
 	{ return "LinearCSvmTrainer"; }
-	
+
 	/// \brief sets the type of the multi-class svm used
 	void setMcSvmType(McSvm type){
 		m_McSvmType = type;
 	}
 
+	/// \brief Whether the binary problem is solved by dual coordinate
+	/// descent with shrinking instead of the default solver.
+	bool& dualCoordinateDescent()
+	{ return m_dcd; }
+	/// \brief Whether the binary problem is solved by dual coordinate
+	/// descent with shrinking instead of the default solver.
+	bool const& dualCoordinateDescent() const
+	{ return m_dcd; }
+
 	void train(LinearClassifier<InputType>& model, LabeledData<InputType, unsigned int> const& dataset)
 	{
 		std::size_t classes = numberOfClasses(dataset);
@@ -854,11 +1000,24 @@ public:
 	}
 private:
 	McSvm m_McSvmType;
+	bool m_dcd;
 
 	void trainBinary(LinearClassifier<InputType>& model, LabeledData<InputType, unsigned int> const& dataset)
 	{
 		std::size_t dim = inputDimension(dataset);
-		QpBoxLinear<InputType> solver(dataset, dim);
+		if(m_dcd){
+			QpDcdLinear<InputType> solver(dataset, dim);
+			trainBinary(solver, model, dim);
+		}
+		else{
+			QpBoxLinear<InputType> solver(dataset, dim);
+			trainBinary(solver, model, dim);
+		}
+	}
+
+	template<class Solver>
+	void trainBinary(Solver& solver, LinearClassifier<InputType>& model, std::size_t dim)
+	{
 		solver.solve(
 				base_type::C(),
 				0.0,
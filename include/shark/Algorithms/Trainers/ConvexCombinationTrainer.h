@@ -0,0 +1,178 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Exponentiated gradient trainer for ConvexCombination ensembles
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_ALGORITHMS_TRAINERS_CONVEXCOMBINATIONTRAINER_H
+#define SHARK_ALGORITHMS_TRAINERS_CONVEXCOMBINATIONTRAINER_H
+
+#include <shark/Algorithms/Trainers/AbstractTrainer.h>
+#include <shark/Models/ConvexCombination.h>
+#include <shark/ObjectiveFunctions/Loss/AbstractLoss.h>
+#include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
+
+namespace shark {
+
+/// \brief Trains the simplex weights of a ConvexCombination by exponentiated gradient descent.
+///
+/// In a stacking setup the inputs of a ConvexCombination are the predictions
+/// of the ensemble members, and tuning the handful of combination weights via
+/// a generic optimizer re-evaluates the members in every gradient step. This
+/// trainer instead works on the cached prediction matrix only: the canonical
+/// train() method receives the member predictions as its input data, and the
+/// member overload assembles that matrix once by evaluating every member a
+/// single time, batch parallel, before any weight update happens.
+///
+/// The weights are optimized by the exponentiated gradient rule
+/// \f$ w_j \leftarrow w_j e^{-\eta g_j} / Z \f$, which performs multiplicative
+/// updates followed by a normalization and therefore keeps every iterate on
+/// the simplex - no projection and no reparametrization is needed. Each row
+/// of the weight matrix is an independent block and is updated separately.
+/// The loss to minimize is exchangeable; by default the squared loss is used.
+class ConvexCombinationTrainer : public AbstractTrainer<ConvexCombination>
+{
+public:
+	/// Constructor
+	/// \param loss          the differentiable loss to minimize; NULL uses the squared loss
+	/// \param iterations    maximum number of exponentiated gradient iterations
+	/// \param learningRate  step size of the multiplicative updates
+	ConvexCombinationTrainer(
+		AbstractLoss<RealVector,RealVector>* loss = NULL,
+		std::size_t iterations = 1000,
+		double learningRate = 0.5
+	): mep_loss(loss)
+	, m_iterations(iterations)
+	, m_learningRate(learningRate)
+	, m_tolerance(1.e-9){}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "ConvexCombinationTrainer"; }
+
+	/// \brief Sets the tolerance below which a weight change stops the iteration.
+	void setTolerance(double tolerance){
+		m_tolerance = tolerance;
+	}
+
+	/// \brief Trains on a dataset whose inputs are the member predictions.
+	///
+	/// Input dimension j holds the prediction of ensemble member j; the member
+	/// models themselves are not needed and never evaluated here.
+	void train(ConvexCombination& model, LabeledData<RealVector, RealVector> const& dataset){
+		SquaredLoss<RealVector,RealVector> squaredLoss;
+		AbstractLoss<RealVector,RealVector> const& loss = mep_loss? *mep_loss : squaredLoss;
+
+		std::size_t members = inputDimension(dataset);
+		std::size_t outputs = labelDimension(dataset);
+		std::size_t numElements = dataset.numberOfElements();
+		if(model.inputSize() != members || model.outputSize() != outputs)
+			model.setStructure(members,outputs);
+
+		//start from the uniform combination in the interior of the simplex
+		RealMatrix W(outputs,members,1.0/members);
+
+		RealMatrix G(outputs,members);
+		RealMatrix predictions;
+		RealMatrix coefficients;
+		for(std::size_t iteration = 0; iteration != m_iterations; ++iteration){
+			//gradient of the mean loss over the cached prediction matrix
+			G.clear();
+			for(std::size_t b = 0; b != dataset.numberOfBatches(); ++b){
+				RealMatrix const& X = dataset.inputs().batch(b);
+				predictions.resize(X.size1(),outputs);
+				noalias(predictions) = prod(X,trans(W));
+				loss.evalDerivative(dataset.labels().batch(b),predictions,coefficients);
+				noalias(G) += prod(trans(coefficients),X);
+			}
+			G /= (double)numElements;
+
+			//multiplicative update of every output row, the rows are
+			//independent blocks. shifting the gradient by its smallest entry
+			//cancels in the normalization but keeps the exponentials bounded
+			double delta = 0;
+			for(std::size_t i = 0; i != outputs; ++i){
+				double shift = min(row(G,i));
+				RealVector updated = element_prod(
+					row(W,i),
+					exp(-m_learningRate*(row(G,i) - shift))
+				);
+				updated /= sum(updated);
+				delta = std::max(delta, max(abs(updated - row(W,i))));
+				noalias(row(W,i)) = updated;
+			}
+			if(delta < m_tolerance)
+				break;
+		}
+		noalias(model.weights()) = W;
+	}
+
+	/// \brief Evaluates the members once and trains on the cached prediction matrix.
+	///
+	/// Every member must be a single-output model; member j fills column j of
+	/// the prediction matrix. No matter how many weight iterations follow,
+	/// each member is evaluated exactly once over the dataset.
+	template<class InputType>
+	void train(
+		ConvexCombination& model,
+		std::vector<AbstractModel<InputType,RealVector>*> const& members,
+		LabeledData<InputType,RealVector> const& dataset
+	){
+		SIZE_CHECK(!members.empty());
+		//pre-allocate the batches of the prediction matrix
+		Data<RealVector> stacked(dataset.numberOfBatches());
+		for(std::size_t b = 0; b != dataset.numberOfBatches(); ++b){
+			stacked.batch(b).resize(boost::size(dataset.inputs().batch(b)),members.size());
+		}
+		//fill the columns member by member; the batches of every member are
+		//evaluated in parallel and sunk directly into the prediction matrix
+		for(std::size_t j = 0; j != members.size(); ++j){
+			auto sink = [&](std::size_t b, RealMatrix const& memberPredictions){
+				SIZE_CHECK(memberPredictions.size2() == 1);
+				noalias(column(stacked.batch(b),j)) = column(memberPredictions,0);
+			};
+			members[j]->eval(dataset.inputs(),sink);
+		}
+		train(model,LabeledData<RealVector,RealVector>(stacked,dataset.labels()));
+	}
+
+protected:
+	/// loss to minimize, NULL means squared loss
+	AbstractLoss<RealVector,RealVector>* mep_loss;
+	/// maximum number of exponentiated gradient iterations
+	std::size_t m_iterations;
+	/// step size of the multiplicative updates
+	double m_learningRate;
+	/// weight change below which the iteration stops early
+	double m_tolerance;
+};
+
+}
+#endif
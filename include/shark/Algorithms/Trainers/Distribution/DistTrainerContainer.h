@@ -47,6 +47,19 @@ public:
 	void setNormalTrainer(const NormalTrainer& normalTrainer) { m_normalTrainer = normalTrainer; }
 	/// @}
 
+	/// Fit one normal distribution per group from grouped data in a single
+	/// parallel pass, delegating to the contained normal trainer.
+	/// @see NormalTrainer::train(std::vector<Normal<RngType> >&, const std::vector<double>&, const std::vector<std::size_t>&)
+	template <typename RngType>
+	void trainNormals(
+		std::vector<Normal<RngType> >& normals,
+		const std::vector<double>& input,
+		const std::vector<std::size_t>& groups
+	) const
+	{
+		m_normalTrainer.train(normals, input, groups);
+	}
+
 	// Other distributions go here
 
 private:
@@ -67,6 +67,24 @@ public:
 		throw SHARKEXCEPTION("No trainer for this distribution.");
 	}
 
+	/// Train an abstract distribution from the sufficient statistics of a sample
+	/// @param abstractDist the distribution we want to train
+	/// @param count the size of the sample
+	/// @param mean the mean of the sample
+	/// @param sumSqrDeviation the centered second moment of the sample
+	/// @throw throw shark exception if training attempt for this distribution failed
+	void train(AbstractDistribution& abstractDist, std::size_t count, double mean, double sumSqrDeviation) const
+	{
+		if (tryTrain<Normal<DefaultRngType> >(abstractDist, getNormalTrainer(), count, mean, sumSqrDeviation))
+			return;
+		if (tryTrain<Normal<FastRngType> >(abstractDist, getNormalTrainer(), count, mean, sumSqrDeviation))
+			return;
+
+		// Other distributions go here
+
+		throw SHARKEXCEPTION("No trainer for this distribution.");
+	}
+
 private:
 
 	/// Try to train an abstract distribution with given concrete distribution type
@@ -90,6 +108,30 @@ private:
 			return false;
 		}
 	}
+
+	/// Try to train an abstract distribution from sufficient statistics
+	/// @param abstractDist the abstract distribution
+	/// @param trainer the trainer to be used for training the distribution
+	/// @param count the size of the sample
+	/// @param mean the mean of the sample
+	/// @param sumSqrDeviation the centered second moment of the sample
+	/// @tparam DistType the type of concrete distribution
+	/// @tparam TrainerType the type of trainer
+	/// @return true if the training attempt succeeded, false otherwise
+	template <typename DistType, typename TrainerType>
+	bool tryTrain(AbstractDistribution& abstractDist, const TrainerType& trainer, std::size_t count, double mean, double sumSqrDeviation) const
+	{
+		DistType* dist = dynamic_cast<DistType*>(&abstractDist);
+		if (dist)
+		{
+			trainer.train(*dist, count, mean, sumSqrDeviation);
+			return true;
+		}
+		else
+		{
+			return false;
+		}
+	}
 };
 
 } // namespace shark {
@@ -35,6 +35,7 @@
 #ifndef SHARK_ALGORITHMS_TRAINERS_DISTRIBUTION_NORMAL_H
 #define SHARK_ALGORITHMS_TRAINERS_DISTRIBUTION_NORMAL_H
 
+#include "shark/Core/OpenMP.h"
 #include "shark/Rng/Normal.h"
 #include "shark/Rng/Rng.h"
 
@@ -46,6 +47,8 @@
 #include <boost/bind/placeholders.hpp>
 #include <boost/range/algorithm/for_each.hpp>
 
+#include <algorithm>
+
 namespace shark {
 
 /// Trainer for normal distribution
@@ -87,6 +90,67 @@ public:
 			: bae::variance(accu));
 	}
 
+	/// Train a normal distribution from the sufficient statistics of a sample:
+	/// its size, its mean and its centered second moment \f$ \sum_i (x_i - \bar x)^2 \f$.
+	/// This allows callers to accumulate the statistics in a single pass over
+	/// the data instead of buffering the sample.
+	template <typename RngType>
+	void train(Normal<RngType>& normal, std::size_t count, double mean, double sumSqrDeviation) const
+	{
+		SIZE_CHECK(count > 1u);
+		normal.mean(mean);
+		normal.variance(
+			VARIANCE_BY_SAMPLE == m_varianceType
+			? sumSqrDeviation / (count - 1)
+			: sumSqrDeviation / count);
+	}
+
+	/// Train one normal distribution per group from grouped data in a single pass.
+	/// The i-th input value belongs to group \a groups[i] and contributes only to
+	/// \a normals[groups[i]]. The sufficient statistics of all groups are gathered
+	/// with one accumulator per thread and merged afterwards, so the data is
+	/// traversed only once no matter how many distributions are fitted.
+	/// Every group must receive at least two values.
+	template <typename RngType>
+	void train(
+		std::vector<Normal<RngType> >& normals,
+		const std::vector<double>& input,
+		const std::vector<std::size_t>& groups
+	) const
+	{
+		SIZE_CHECK(input.size() == groups.size());
+		std::size_t numGroups = normals.size();
+
+		//thread-local sufficient statistics per group
+		std::vector<std::vector<std::size_t> > counts(SHARK_NUM_THREADS,std::vector<std::size_t>(numGroups,0));
+		std::vector<std::vector<double> > sums(SHARK_NUM_THREADS,std::vector<double>(numGroups,0.0));
+		std::vector<std::vector<double> > sumsSqr(SHARK_NUM_THREADS,std::vector<double>(numGroups,0.0));
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)input.size(); ++i){
+			std::size_t g = groups[i];
+			SIZE_CHECK(g < numGroups);
+			++counts[SHARK_THREAD_NUM][g];
+			sums[SHARK_THREAD_NUM][g] += input[i];
+			sumsSqr[SHARK_THREAD_NUM][g] += input[i]*input[i];
+		}
+
+		//merge the thread statistics and fit every group
+		SHARK_PARALLEL_FOR(int g = 0; g < (int)numGroups; ++g){
+			std::size_t count = 0;
+			double sum = 0.0;
+			double sumSqr = 0.0;
+			for(std::size_t t = 0; t != counts.size(); ++t){
+				count += counts[t][g];
+				sum += sums[t][g];
+				sumSqr += sumsSqr[t][g];
+			}
+			SIZE_CHECK(count > 1u);
+			double mean = sum / count;
+			//guard against cancellation for tightly concentrated groups
+			double sumSqrDeviation = std::max(0.0, sumSqr - count * mean * mean);
+			train(normals[g], count, mean, sumSqrDeviation);
+		}
+	}
+
 private:
 
 	/// The covariance type this trainer will use
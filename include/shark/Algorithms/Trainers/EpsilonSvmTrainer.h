@@ -84,7 +84,7 @@ public:
 
 	typedef KernelMatrix< InputType, QpFloatType > KernelMatrixType;
 	typedef BlockMatrix2x2< KernelMatrixType > BlockMatrixType;
-	typedef CachedMatrix< BlockMatrixType > CachedBlockMatrixType;
+	typedef CachedBlockMatrix2x2< KernelMatrixType > CachedBlockMatrixType;
 	typedef PrecomputedMatrix< BlockMatrixType > PrecomputedBlockMatrixType;
 
 	typedef AbstractModel<InputType, RealVector> ModelType;
@@ -137,25 +137,31 @@ public:
 		
 		SHARK_CHECK(labelDimension(dataset) == 1, "[EpsilonSvmTrainer::train] can only train 1D labels");
 
-		if (QpConfig::precomputeKernel())
-			trainSVM<PrecomputedBlockMatrixType>(svm,dataset);
-		else
-			trainSVM<CachedBlockMatrixType>(svm,dataset);
-		
+		if (QpConfig::precomputeKernel()){
+			KernelMatrixType km(*base_type::m_kernel, dataset.inputs());
+			BlockMatrixType blockkm(&km);
+			PrecomputedBlockMatrixType matrix(&blockkm);
+			trainSVM(svm,dataset,km,matrix);
+		}
+		else{
+			//cache the base kernel matrix, so that the twin variables
+			//i and i+n of the doubled problem share their kernel rows
+			KernelMatrixType km(*base_type::m_kernel, dataset.inputs());
+			CachedBlockMatrixType matrix(&km, base_type::m_cacheSize);
+			trainSVM(svm,dataset,km,matrix);
+		}
+
 		if (base_type::sparsify()) svm.sparsify();
 	}
 
 private:
 	template<class MatrixType>
-	void trainSVM(KernelExpansion<InputType>& svm, LabeledData<InputType, RealVector> const& dataset){
+	void trainSVM(KernelExpansion<InputType>& svm, LabeledData<InputType, RealVector> const& dataset, KernelMatrixType& km, MatrixType& matrix){
 		typedef GeneralQuadraticProblem<MatrixType> SVMProblemType;
 		typedef SvmShrinkingProblem<SVMProblemType> ProblemType;
-		
+
 		//Set up the problem
-		KernelMatrixType km(*base_type::m_kernel, dataset.inputs());
 		std::size_t ic = km.size();
-		BlockMatrixType blockkm(&km);
-		MatrixType matrix(&blockkm);
 		SVMProblemType svmProblem(matrix);
 		for(std::size_t i = 0; i != ic; ++i){
 			svmProblem.linear(i) = dataset.element(i).label(0) - m_epsilon;
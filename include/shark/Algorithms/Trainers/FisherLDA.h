@@ -109,6 +109,7 @@ public:
 
 protected:
 	SHARK_EXPORT_SYMBOL void meanAndScatter(LabeledData<RealVector, unsigned int> const& dataset, RealVector& mean, RealMatrix& scatter);
+	SHARK_EXPORT_SYMBOL void meanAndScatter(LabeledData<RealVector, unsigned int> const& dataset, RealVector& mean, RealMatrix& Sb, RealMatrix& Sw);
 	bool m_whitening;
 	std::size_t m_subspaceDimensions;
 };
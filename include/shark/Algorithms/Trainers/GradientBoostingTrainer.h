@@ -0,0 +1,163 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Gradient Boosting Trainer
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+
+#ifndef SHARK_ALGORITHMS_TRAINERS_GRADIENTBOOSTINGTRAINER_H
+#define SHARK_ALGORITHMS_TRAINERS_GRADIENTBOOSTINGTRAINER_H
+
+#include <shark/Core/DLLSupport.h>
+#include <shark/Models/Trees/GradientBoostingModel.h>
+#include <shark/Algorithms/Trainers/CARTcommon.h>
+#include <shark/Algorithms/Trainers/AbstractTrainer.h>
+
+namespace shark {
+/*!
+ * \brief Gradient Boosting for regression and binary classification
+ *
+ * The trainer grows an additive ensemble of shallow regression trees in a
+ * stage-wise fashion. In every iteration a tree is fit to the negative
+ * gradient of the loss at the current ensemble prediction and added with a
+ * small weight, the shrinkage. Regression datasets are trained with the
+ * squared loss; classification datasets with the binary logistic loss, in
+ * which case the leaf values are Newton steps and the ensemble outputs
+ * log-odds.
+ *
+ * Trees are grown depth-first to a fixed maximum depth. Split finding uses
+ * the histogram quantization of CARTcommon: every attribute is quantized
+ * once for the whole ensemble and each node accumulates per-bin statistics
+ * in a linear pass. Optionally each tree is fit on a random subsample of
+ * the training set, which both regularizes and speeds up training.
+ *
+ * For the algorithm see J. H. Friedman, Greedy Function Approximation:
+ * A Gradient Boosting Machine, Annals of Statistics 29(5), 2001.
+ */
+class GradientBoostingTrainer
+: public AbstractTrainer<GradientBoostingModel, RealVector>
+, public AbstractTrainer<GradientBoostingModel, unsigned int>
+{
+public:
+	typedef GradientBoostingModel ModelType;
+
+	/// Constructor
+	GradientBoostingTrainer(){
+		m_numberOfTrees = 100;
+		m_shrinkage = 0.1;
+		m_subsamplingFraction = 1.0;
+		m_maxDepth = 4;
+		m_nodeSize = 10;
+		m_histogramBins = 256;
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "GradientBoostingTrainer"; }
+
+	///Train with the squared loss
+	SHARK_EXPORT_SYMBOL void train(ModelType& model, RegressionDataset const& dataset);
+
+	///Train with the binary logistic loss; the model predicts log-odds
+	SHARK_EXPORT_SYMBOL void train(ModelType& model, ClassificationDataset const& dataset);
+
+	///Sets the number of boosting iterations, i.e. trees in the ensemble.
+	void setNumberOfTrees(std::size_t numberOfTrees){
+		m_numberOfTrees = numberOfTrees;
+	}
+
+	///Sets the shrinkage, the weight with which every tree enters the ensemble.
+	void setShrinkage(double shrinkage){
+		m_shrinkage = shrinkage;
+	}
+
+	///Sets the fraction of the training set each tree is fit on.
+	///A value below one draws a fresh random subsample for every tree.
+	void setSubsamplingFraction(double fraction){
+		m_subsamplingFraction = fraction;
+	}
+
+	///Sets the maximum depth of the trees; the root has depth zero.
+	void setMaxDepth(std::size_t maxDepth){
+		m_maxDepth = maxDepth;
+	}
+
+	///Sets the minimum number of samples required to split a node.
+	void setNodeSize(std::size_t nodeSize){
+		m_nodeSize = nodeSize;
+	}
+
+	///Sets the number of histogram bins used for split finding.
+	void setHistogramBins(std::size_t bins){
+		m_histogramBins = bins;
+	}
+
+protected:
+	using Split = detail::cart::Split;
+	typedef ModelType::SubmodelType::TreeType TreeType;
+
+	///Number of attributes in the dataset
+	std::size_t m_inputDimension;
+
+	///Dimension of a label; one for the logistic loss
+	std::size_t m_labelDimension;
+
+	///Number of boosting iterations
+	std::size_t m_numberOfTrees;
+
+	///Weight of every tree in the ensemble
+	double m_shrinkage;
+
+	///Fraction of the training set each tree is fit on
+	double m_subsamplingFraction;
+
+	///Maximum depth of the trees
+	std::size_t m_maxDepth;
+
+	///Minimum number of samples required to split a node
+	std::size_t m_nodeSize;
+
+	///Number of histogram bins used for split finding
+	std::size_t m_histogramBins;
+
+	///Fits a regression tree to the residuals of the subsampled elements
+	SHARK_EXPORT_SYMBOL TreeType buildTree(detail::cart::BinnedIndex const& index, std::vector<std::size_t>&& elementIds, std::vector<RealVector> const& residuals, RealVector const& sum, std::size_t nodeId, std::size_t depth) const;
+
+	///Finds the best squared-error split among the bin boundaries
+	SHARK_EXPORT_SYMBOL Split findSplit(detail::cart::BinnedIndex const& index, std::vector<std::size_t> const& elementIds, std::vector<RealVector> const& residuals, RealVector const& sumFull) const;
+
+	///Draws the element ids each tree is fit on
+	SHARK_EXPORT_SYMBOL std::vector<std::size_t> subsample(std::size_t numElements, Rng::rng_type& rng) const;
+};
+
+
+}
+#endif
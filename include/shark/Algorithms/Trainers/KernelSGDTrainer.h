@@ -40,6 +40,8 @@
 
 #include <shark/Algorithms/Trainers/AbstractTrainer.h>
 #include <shark/Core/IParameterizable.h>
+#include <shark/Core/OpenMP.h>
+#include <shark/Data/DataView.h>
 #include <shark/LinAlg/KernelMatrix.h>
 #include <shark/LinAlg/PartlyPrecomputedMatrix.h>
 #include <shark/Models/Kernels/KernelExpansion.h>
@@ -117,6 +119,7 @@ public:
 		, m_offset(offset)
 		, m_unconstrained(unconstrained)
 		, m_epochs(0)
+		, m_batchSize(1)
 		, m_cacheSize(cacheSize)
 	{ }
 
@@ -147,10 +150,7 @@ public:
 
 		RealMatrix& alpha = model.alpha();
 
-		// pre-compute the kernel matrix (may change in the future)
-		// and create linear array of labels
-		KernelMatrixType  km(*(this->m_kernel), dataset.inputs());
-		PartlyPrecomputedMatrixType  K(&km, m_cacheSize);
+		// create linear array of labels
 		UIntVector y = createBatch(dataset.labels().elements());
 		const double lambda = 0.5 / (ell * m_C);
 
@@ -163,30 +163,95 @@ public:
 		RealVector f_b(classes, 0.0);
 		RealVector derivative(classes, 0.0);
 
-		// SGD loop
-		blas::vector<QpFloatType> kernelRow(ell, 0);
-		for(std::size_t iter = 0; iter < iterations; iter++)
+		if(m_batchSize <= 1)
 		{
-			// active variable
-			std::size_t b = Rng::discrete(0, ell - 1);
-
-			// learning rate
-			const double eta = 1.0 / (lambda * (iter + ell));
-
-			// compute prediction
-			K.row(b, kernelRow);
-			noalias(f_b) = alphaScale * prod(trans(alpha), kernelRow);
-			if(m_offset) noalias(f_b) += model.offset();
-
-			// stochastic gradient descent (SGD) step
-			derivative.clear();
-			m_loss->evalDerivative(y[b], f_b, derivative);
-
-			// alphaScale *= (1.0 - eta * lambda);
-			alphaScale = (ell - 1.0) / (ell + iter);   // numerically more stable
-
-			noalias(row(alpha, b)) -= (eta / alphaScale) * derivative;
-			if(m_offset) noalias(model.offset()) -= eta * derivative;
+			// pre-compute the kernel matrix (may change in the future)
+			KernelMatrixType  km(*(this->m_kernel), dataset.inputs());
+			PartlyPrecomputedMatrixType  K(&km, m_cacheSize);
+
+			// SGD loop
+			blas::vector<QpFloatType> kernelRow(ell, 0);
+			for(std::size_t iter = 0; iter < iterations; iter++)
+			{
+				// active variable
+				std::size_t b = Rng::discrete(0, ell - 1);
+
+				// learning rate
+				const double eta = 1.0 / (lambda * (iter + ell));
+
+				// compute prediction
+				K.row(b, kernelRow);
+				noalias(f_b) = alphaScale * prod(trans(alpha), kernelRow);
+				if(m_offset) noalias(f_b) += model.offset();
+
+				// stochastic gradient descent (SGD) step
+				derivative.clear();
+				m_loss->evalDerivative(y[b], f_b, derivative);
+
+				// alphaScale *= (1.0 - eta * lambda);
+				alphaScale = (ell - 1.0) / (ell + iter);   // numerically more stable
+
+				noalias(row(alpha, b)) -= (eta / alphaScale) * derivative;
+				if(m_offset) noalias(model.offset()) -= eta * derivative;
+			}
+		}
+		else
+		{
+			// mini-batch SGD loop: the kernel rows of all active variables of
+			// a mini-batch are computed blockwise against the dataset batches,
+			// which shares the kernel evaluation work within the mini-batch.
+			// The rows do not depend on alpha, so the per-example updates
+			// below are identical to the ones of the plain loop above - only
+			// the order in which the uniformly drawn variables are visited
+			// changes.
+			DataView<Data<InputType> const> inputView(dataset.inputs());
+			std::size_t numBatches = dataset.inputs().numberOfBatches();
+			std::vector<std::size_t> batchStart(numBatches);
+			for(std::size_t j = 0, start = 0; j != numBatches; ++j)
+			{
+				batchStart[j] = start;
+				start += size(dataset.inputs().batch(j));
+			}
+			std::vector<std::size_t> active(m_batchSize);
+			for(std::size_t iter = 0; iter < iterations; )
+			{
+				// draw the active variables and sort them, so that the gather
+				// and the blockwise evaluation follow the storage order of
+				// the dataset
+				std::size_t activeSize = std::min(m_batchSize, iterations - iter);
+				for(std::size_t i = 0; i != activeSize; ++i)
+					active[i] = Rng::discrete(0, ell - 1);
+				std::sort(active.begin(), active.begin() + activeSize);
+				typename Batch<InputType>::type activeBatch
+					= subBatch(inputView, boost::make_iterator_range(active.begin(), active.begin() + activeSize));
+
+				// compute the kernel rows of the active variables
+				RealMatrix rows(activeSize, ell);
+				SHARK_PARALLEL_FOR(int j = 0; j < (int)numBatches; ++j)
+				{
+					auto const& dataBatch = dataset.inputs().batch(j);
+					std::size_t width = size(dataBatch);
+					noalias(columns(rows, batchStart[j], batchStart[j] + width)) = (*m_kernel)(activeBatch, dataBatch);
+				}
+
+				// per-example SGD steps using the precomputed rows
+				for(std::size_t i = 0; i != activeSize; ++i, ++iter)
+				{
+					std::size_t b = active[i];
+					const double eta = 1.0 / (lambda * (iter + ell));
+
+					noalias(f_b) = alphaScale * prod(trans(alpha), row(rows, i));
+					if(m_offset) noalias(f_b) += model.offset();
+
+					derivative.clear();
+					m_loss->evalDerivative(y[b], f_b, derivative);
+
+					alphaScale = (ell - 1.0) / (ell + iter);   // numerically more stable
+
+					noalias(row(alpha, b)) -= (eta / alphaScale) * derivative;
+					if(m_offset) noalias(model.offset()) -= eta * derivative;
+				}
+			}
 		}
 
 		alpha *= alphaScale;
@@ -204,6 +269,21 @@ public:
 	void setEpochs(std::size_t value)
 	{ m_epochs = value; }
 
+	/// Return the number of examples whose kernel rows are computed with a
+	/// shared blockwise evaluation.
+	std::size_t batchSize() const
+	{ return m_batchSize; }
+
+	/// Set the number of examples whose kernel rows are computed with a
+	/// shared blockwise evaluation. The updates performed are the same as
+	/// with the default of 1, which restores the plain per-example loop
+	/// with its row cache.
+	void setBatchSize(std::size_t value)
+	{
+		RANGE_CHECK(value > 0);
+		m_batchSize = value;
+	}
+
 	/// get the kernel function
 	KernelType* kernel()
 	{ return m_kernel; }
@@ -269,6 +349,7 @@ protected:
 	bool m_offset;                            ///< should the resulting model have an offset term?
 	bool m_unconstrained;                     ///< should C be stored as log(C) as a parameter?
 	std::size_t m_epochs;                     ///< number of training epochs (sweeps over the data), or 0 for default = max(10, C)
+	std::size_t m_batchSize;                  ///< size of the mini-batches sharing a blockwise kernel evaluation, 1 for the plain per-example loop
 
 	// size of cache to use.
 	std::size_t m_cacheSize;
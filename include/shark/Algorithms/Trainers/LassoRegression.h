@@ -136,193 +136,112 @@ public:
 	}
 
 	/// \brief Train a linear model with LASSO regression.
+	///
+	/// The solver is coordinate descent over an active set of features.
+	/// Candidate features are preselected with the strong rule of
+	/// Tibshirani et al., the working set is optimized to the target
+	/// accuracy, and the optimality conditions of all features are
+	/// verified afterwards; violators re-enter the working set until
+	/// none are left. For many more points than features the covariance
+	/// matrix of the features is cached once, so that coordinate steps
+	/// and optimality checks cost O(dim) instead of O(points).
 	void train(ModelType& model, DataType const& dataset)
 	{
 		SIZE_CHECK(model.outputSize() == 1);
 
-		// strategy constants
-		const double CHANGE_RATE = 0.2;
-		const double PREF_MIN = 0.05;
-		const double PREF_MAX = 20.0;
-
-		// console output
-		const bool verbose = false;
-
 		std::size_t dim = inputDimension(dataset);
+		std::size_t numPoints = dataset.numberOfElements();
 		RealVector w(dim, 0.0);
 
 		// transpose the dataset and push it inside a single matrix
 		typename Batch<InputVectorType>::type data = trans(createBatch(dataset.inputs().elements()));
 		RealVector label = column(createBatch(dataset.labels().elements()),0);
 
-		RealVector diag(dim);
-		RealVector difference = -label;
-		UIntVector index(dim);
-
 		// pre-calculate diagonal matrix entries (feature-wise squared norms)
+		RealVector diag(dim);
 		for (size_t i=0; i<dim; i++){
 			diag[i] = norm_sqr(row(data,i));
 		}
 
-		// prepare preferences for scheduling
-		RealVector pref(dim, 1.0);
-		double prefsum = (double)dim;
-
-		// prepare performance monitoring for self-adaptation
-		const double gain_learning_rate = 1.0 / dim;
-		double average_gain = 0.0;
-		bool canstop = true;
-		const double lambda = m_lambda;
+		// correlation of every feature with the labels; its largest
+		// absolute value is the smallest lambda with an all-zero solution
+		RealVector correlation = prod(data,label);
+		double lambdaMax = norm_inf(correlation);
+
+		// for many more points than features it pays off to cache the
+		// covariance matrix of the features once and to maintain the full
+		// gradient instead of the residual
+		bool covarianceMode = (numPoints >= 4*dim) && (dim <= 4096);
+		RealMatrix covariance;
+		RealVector gradient;   // covariance mode: X^T (Xw - y) for all features
+		RealVector difference; // residual mode: Xw - y
+		if (covarianceMode){
+			covariance = prod(data,trans(data));
+			gradient = -correlation;
+		}
+		else{
+			difference = -label;
+		}
 
-		// main optimization loop
-		std::size_t iter = 0;
-		std::size_t steps = 0;
-		while (true)
+		// screen the features with the strong rule; the sequence of the
+		// rule is anchored at lambdaMax, where the solution is known
+		std::vector<std::size_t> working;
+		std::vector<bool> inWorking(dim, false);
+		for (std::size_t i=0; i<dim; i++)
 		{
-			double maxvio = 0.0;
-
-			// define schedule
-			double psum = prefsum;
-			prefsum = 0.0;
-			int pos = 0;
-
-			for (std::size_t i=0; i<dim; i++)
-			{
-				double p = pref[i];
-				double n;
-				if (psum >= 1e-6 && p < psum) 
-					n = (dim - pos) * p / psum;
-				else 
-					n = (dim - pos);                // for numerical stability
-
-				unsigned int m = (unsigned int)floor(n);
-				double prob = n - m;
-				if ((double)rand() / (double)RAND_MAX < prob) m++;
-				for (std::size_t  j=0; j<m; j++)
-				{
-					index[pos] = (unsigned int)i;
-					pos++;
-				}
-				psum -= p;
-				prefsum += p;
-			}
-			for (std::size_t i=0; i<dim; i++)
+			if (std::fabs(correlation(i)) > 2.0 * m_lambda - lambdaMax)
 			{
-				std::size_t r = rand() % dim;
-				std::swap(index[r], index[i]);
+				working.push_back(i);
+				inWorking[i] = true;
 			}
+		}
 
-			steps += dim;
-			for (size_t s=0; s<dim; s++)
+		// active-set outer loop
+		while (true)
+		{
+			// optimize the working set with cyclic coordinate descent
+			while (!working.empty())
 			{
-				std::size_t i = index[s];
-				double a = w[i];
-				double d = diag[i];
-
-				// compute gradient
-				double grad = inner_prod(difference, row(data,i));
-
-				// compute optimal coordinate descent step and corresponding gain
-				double vio = 0.0;
-				double gain = 0.0;
-				double delta = 0.0;
-				if (a == 0.0)
+				double maxvio = 0.0;
+				for (std::size_t i : working)
 				{
-					if (grad > lambda)
+					double grad = covarianceMode?
+						gradient(i) :
+						inner_prod(difference, row(data,i));
+					double vio = 0.0;
+					double delta = coordinateDescentStep(w[i], grad, diag[i], vio);
+					if (vio > maxvio) maxvio = vio;
+					if (delta != 0.0)
 					{
-						vio = grad - lambda;
-						delta = -vio / d;
-						gain = 0.5 * d * delta * delta;
-					}
-					else if (grad < -lambda)
-					{
-						vio = -grad - lambda;
-						delta = vio / d;
-						gain = 0.5 * d * delta * delta;
-					}
-				}
-				else if (a > 0.0)
-				{
-					grad += lambda;
-					vio = std::fabs(grad);
-					delta = -grad / d;
-					if (delta < -a)
-					{
-						delta = -a;
-						gain = delta * (grad - 0.5 * d * delta);
-						double g0 = grad - a * d - 2.0 * lambda;
-						if (g0 > 0.0)
-						{
-							double dd = -g0 / d;
-							gain = dd * (grad - 0.5 * d * dd);
-							delta += dd;
-						}
-					}
-					else gain = 0.5 * d * delta * delta;
-				}
-				else
-				{
-					grad -= lambda;
-					vio = std::fabs(grad);
-					delta = -grad / d;
-					if (delta > -a)
-					{
-						delta = -a;
-						gain = delta * (grad - 0.5 * d * delta);
-						double g0 = grad - a * d + 2.0 * lambda;
-						if (g0 < 0.0)
-						{
-							double dd = -g0 / d;
-							gain = dd * (grad - 0.5 * d * dd);
-							delta += dd;
-						}
-					}
-					else gain = 0.5 * d * delta * delta;
-				}
-
-				// update state
-				if (vio > maxvio) maxvio = vio;
-				if (delta != 0.0)
-				{
-					w[i] += delta;
-					noalias(difference) += delta*row(data,i);
-				}
-
-				// update gain-based preferences
-				{
-					if (iter == 0) 
-						average_gain += gain / (double)dim;
-					else
-					{
-						double change = CHANGE_RATE * (gain / average_gain - 1.0);
-						double newpref = pref[i] * std::exp(change);
-						newpref = std::min(std::max(newpref, PREF_MIN), PREF_MAX);
-						prefsum += newpref - pref[i];
-						pref[i] = newpref;
-						average_gain = (1.0 - gain_learning_rate) * average_gain + gain_learning_rate * gain;
+						w[i] += delta;
+						if (covarianceMode)
+							noalias(gradient) += delta*row(covariance,i);
+						else
+							noalias(difference) += delta*row(data,i);
 					}
 				}
+				if (maxvio <= m_accuracy) break;
 			}
-			iter++;
 
-			if (maxvio <= m_accuracy)
+			// check the optimality conditions of all features in one
+			// matrix-vector product and collect the violators
+			RealVector fullGradient;
+			if (covarianceMode)
+				fullGradient = gradient;
+			else
+				fullGradient = prod(data,difference);
+			bool violation = false;
+			for (std::size_t i=0; i<dim; i++)
 			{
-				if (canstop)
-					break;
-				else
+				if (inWorking[i]) continue;
+				if (optimalityViolation(w[i], fullGradient(i)) > m_accuracy)
 				{
-					// prepare full sweep for a reliable check of the stopping criterion
-					canstop = true;
-					noalias(pref) = blas::repeat(1.0, dim);
-					prefsum = (double)dim;
-					if (verbose) std::cout << "*" << std::flush;
+					working.push_back(i);
+					inWorking[i] = true;
+					violation = true;
 				}
 			}
-			else
-			{
-				canstop = false;
-				if (verbose) std::cout << "." << std::flush;
-			}
+			if (!violation) break;
 		}
 
 		// write the weight vector into the model
@@ -332,6 +251,65 @@ public:
 	}
 
 protected:
+	/// \brief Violation of the optimality conditions of a single coordinate.
+	double optimalityViolation(double a, double grad) const
+	{
+		if (a > 0.0) return std::fabs(grad + m_lambda);
+		if (a < 0.0) return std::fabs(grad - m_lambda);
+		return std::max(std::fabs(grad) - m_lambda, 0.0);
+	}
+
+	/// \brief Optimal coordinate descent step for a single coordinate.
+	///
+	/// Minimizes the objective along the coordinate with current weight a,
+	/// gradient grad of the squared error term and curvature d, taking the
+	/// kink of the L1 penalty at zero into account. Returns the step and
+	/// stores the violation of the optimality conditions in vio.
+	double coordinateDescentStep(double a, double grad, double d, double& vio) const
+	{
+		const double lambda = m_lambda;
+		double delta = 0.0;
+		vio = 0.0;
+		if (a == 0.0)
+		{
+			if (grad > lambda)
+			{
+				vio = grad - lambda;
+				delta = -vio / d;
+			}
+			else if (grad < -lambda)
+			{
+				vio = -grad - lambda;
+				delta = vio / d;
+			}
+		}
+		else if (a > 0.0)
+		{
+			grad += lambda;
+			vio = std::fabs(grad);
+			delta = -grad / d;
+			if (delta < -a)
+			{
+				delta = -a;
+				double g0 = grad - a * d - 2.0 * lambda;
+				if (g0 > 0.0) delta -= g0 / d;
+			}
+		}
+		else
+		{
+			grad -= lambda;
+			vio = std::fabs(grad);
+			delta = -grad / d;
+			if (delta > -a)
+			{
+				delta = -a;
+				double g0 = grad - a * d + 2.0 * lambda;
+				if (g0 < 0.0) delta -= g0 / d;
+			}
+		}
+		return delta;
+	}
+
 	double m_lambda;             ///< regularization parameter
 	double m_accuracy;           ///< gradient accuracy
 };
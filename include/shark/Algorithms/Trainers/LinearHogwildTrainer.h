@@ -0,0 +1,297 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Asynchronous lock-free parallel SGD training for linear models
+ *
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+
+#ifndef SHARK_ALGORITHMS_LinearHogwildTrainer_H
+#define SHARK_ALGORITHMS_LinearHogwildTrainer_H
+
+
+#include <shark/Algorithms/Trainers/AbstractWeightedTrainer.h>
+#include <shark/Core/IParameterizable.h>
+#include <shark/Core/OpenMP.h>
+#include <shark/Models/LinearModel.h>
+#include <shark/Models/LinearClassifier.h>
+#include <shark/ObjectiveFunctions/Loss/AbstractLoss.h>
+#include <shark/Statistics/Distributions/MultiNomialDistribution.h>
+#include <shark/Data/DataView.h>
+
+
+namespace shark
+{
+
+namespace detail{
+	template<class InputType, class LabelType>
+	struct LinearHogwildTrainerBase{
+		typedef AbstractWeightedTrainer< LinearModel<InputType>,LabelType > type;
+		typedef AbstractLoss<LabelType,RealVector> LossType;
+	};
+	template<class InputType>
+	struct LinearHogwildTrainerBase<InputType, unsigned int>{
+		typedef AbstractWeightedTrainer< LinearClassifier<InputType>, unsigned int > type;
+		typedef AbstractLoss<unsigned int,RealVector> LossType;
+	};
+}
+
+
+///
+/// \brief Asynchronous lock-free parallel SGD (Hogwild) for training of linear models
+///
+/// Given a differentiable loss function L(f, y) and a model f_j(x)= w_j^Tx+b
+/// this trainer solves the regularized risk minimization problem
+/// \f[
+///     \min \frac{1}{2} \sum_j \frac{\lambda}{2}\|w_j\|^2 + \frac 1 {\ell} \sum_i L(y_i, f(x_i)),
+/// \f]
+/// where i runs over training data, j over the model outputs, and lambda > 0 is the
+/// regularization parameter.
+///
+/// Every thread samples examples independently and applies plain SGD updates to the
+/// shared weight matrix without any locks or atomics. As an update only touches the
+/// coordinates in the support of the sampled example, collisions between threads are
+/// rare when the gradients are sparse and the scheme converges at near-linear
+/// multicore speedup; see<br/>
+/// Hogwild: A Lock-Free Approach to Parallelizing Stochastic Gradient Descent.
+/// Feng Niu, Benjamin Recht, Christopher Re and Stephen J. Wright. NIPS 2011.<br/>
+///
+/// Following the decomposition used in the paper, the 2-norm penalty of a coordinate
+/// is split over the examples whose support contains it, so the regularization update
+/// is as sparse as the data and no dense rescaling of the weight matrix is needed.
+///
+/// The algorithm supports classification and regression, dense and sparse inputs
+/// and weighted and unweighted datasets.
+template <class InputType, class LabelType>
+class LinearHogwildTrainer : public detail::LinearHogwildTrainerBase<InputType,LabelType>::type, public IParameterizable
+{
+private:
+	typedef typename detail::LinearHogwildTrainerBase<InputType,LabelType>::type Base;
+public:
+	typedef typename Base::ModelType ModelType;
+	typedef typename Base::WeightedDatasetType WeightedDatasetType;
+	typedef typename detail::LinearHogwildTrainerBase<InputType,LabelType>::LossType LossType;
+
+
+	/// \brief Constructor
+	///
+	/// \param  loss            (sub-)differentiable loss function
+	/// \param  lambda          regularization parameter for two-norm regularization, 0 by default
+	/// \param  learningRate    SGD step size, 0.1 by default
+	/// \param  offset          whether to train with offset/bias parameter or not, default is true
+	LinearHogwildTrainer(LossType const* loss, double lambda = 0, double learningRate = 0.1, bool offset = true)
+	: mep_loss(loss)
+	, m_lambda(lambda)
+	, m_learningRate(learningRate)
+	, m_offset(offset)
+	, m_maxEpochs(0)
+	{ }
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "LinearHogwildTrainer"; }
+
+	using Base::train;
+	void train(ModelType& model, WeightedDatasetType const& dataset){
+		trainImpl(model,dataset,*mep_loss);
+	}
+
+
+	/// \brief Return the number of training epochs.
+	/// A value of 0 indicates that the default of 10 should be used.
+	std::size_t epochs() const
+	{ return m_maxEpochs; }
+
+	/// \brief Set the number of training epochs.
+	/// A value of 0 indicates that the default of 10 should be used.
+	void setEpochs(std::size_t value)
+	{ m_maxEpochs = value; }
+
+
+	/// \brief Return the value of the regularization parameter lambda.
+	double lambda() const
+	{ return m_lambda; }
+
+	/// \brief Set the value of the regularization parameter lambda.
+	void setLambda(double lambda)
+	{ m_lambda = lambda; }
+
+	/// \brief Return the SGD step size.
+	double learningRate() const
+	{ return m_learningRate; }
+
+	/// \brief Set the SGD step size.
+	void setLearningRate(double learningRate)
+	{ m_learningRate = learningRate; }
+
+	/// \brief Check whether the model to be trained should include an offset term.
+	bool trainOffset() const
+	{ return m_offset; }
+
+	/// \brief Sets whether the model to be trained should include an offset term.
+	void setTrainOffset(bool offset)
+	{ m_offset = offset;}
+
+	/// \brief Returns the vector of hyper-parameters(same as lambda)
+	RealVector parameterVector() const
+	{
+		return RealVector(1,m_lambda);
+	}
+
+	/// \brief Sets the vector of hyper-parameters(same as lambda)
+	void setParameterVector(RealVector const& newParameters)
+	{
+		SIZE_CHECK(newParameters.size() == 1);
+		m_lambda = newParameters(0);
+	}
+
+	///\brief Returns the number of hyper-parameters.
+	size_t numberOfParameters() const
+	{
+		return 1;
+	}
+
+private:
+	//initializes the model in the classification case and calls iterate to train it
+	void trainImpl(
+		LinearClassifier<InputType>& classifier,
+		WeightedLabeledData<InputType, unsigned int> const& dataset,
+		AbstractLoss<unsigned int,RealVector> const& loss
+	){
+		//initialize model
+		std::size_t classes = numberOfClasses(dataset);
+		if(classes == 2) classes = 1;//special case: 2D classification is always encoded by the sign of the output
+		std::size_t dim = inputDimension(dataset);
+		auto& model = classifier.decisionFunction();
+		model.setStructure(dim,classes, m_offset);
+
+		iterate(model,dataset,loss);
+	}
+	//initializes the model in the regression case and calls iterate to train it
+	template<class LabelT>
+	void trainImpl(
+		LinearModel<InputType>& model,
+		WeightedLabeledData<InputType, LabelT> const& dataset,
+		AbstractLoss<LabelT,RealVector> const& loss
+	){
+		//initialize model
+		std::size_t labelDim = labelDimension(dataset);
+		std::size_t dim = inputDimension(dataset);
+		model.setStructure(dim,labelDim, m_offset);
+		iterate(model,dataset,loss);
+	}
+
+	void iterate(
+		LinearModel<InputType>& model,
+		WeightedLabeledData<InputType, LabelType> const& dataset,
+		AbstractLoss<LabelType,RealVector> const& loss
+	){
+		//get stats of the dataset
+		DataView<LabeledData<InputType, LabelType> const> data(dataset.data());
+		std::size_t ell = data.size();
+		std::size_t labelDim = model.outputSize();
+
+		//set number of iterations
+		std::size_t epochs = m_maxEpochs? m_maxEpochs: 10;
+		std::size_t iterations = epochs * ell;
+
+		//picking distribution picks proportional to weight
+		RealVector probabilities = createBatch(dataset.weights().elements());
+		probabilities /= sum(probabilities);
+		MultiNomialDistribution dist(probabilities);
+
+		//the 2-norm penalty of every coordinate is split over the examples whose
+		//support contains it: with d_j the summed picking probability of those
+		//examples, sampling example i and applying lambda/d_j * w_j on its support
+		//gives lambda*w_j in expectation while keeping the update sparse.
+		RealVector regWeight(model.inputSize(),0.0);
+		if(m_lambda > 0){
+			for(std::size_t i = 0; i != ell; ++i){
+				auto const& input = data[i].input;
+				auto end = input.end();
+				for(auto pos = input.begin(); pos != end; ++pos){
+					if(*pos != 0) regWeight(pos.index()) += probabilities(i);
+				}
+			}
+			for(std::size_t j = 0; j != regWeight.size(); ++j){
+				if(regWeight(j) > 0) regWeight(j) = m_lambda/regWeight(j);
+			}
+		}
+
+		auto& matrix = model.matrix();
+		auto seed = Rng::discrete(0,(unsigned)-1);
+		std::size_t numThreads = std::min<std::size_t>(SHARK_NUM_THREADS, iterations);
+
+		SHARK_PARALLEL_FOR(long t = 0; t < (long)numThreads; ++t){
+			Rng::rng_type rng{static_cast<unsigned>(seed + t)};
+			std::size_t threadIterations = iterations/numThreads;
+			if(t == 0) threadIterations += iterations % numThreads;
+
+			// preinitialize everything to prevent costly memory allocations in the loop
+			RealVector f_b(labelDim, 0.0); // prediction of the model
+			RealVector derivative(labelDim, 0.0); //derivative of the loss
+
+			for(std::size_t iter = 0; iter != threadIterations; ++iter){
+				// choose data point
+				std::size_t b = dist(rng);
+				auto point = data[b];
+
+				// compute prediction; the shared weights are read without locks
+				noalias(f_b) = prod(matrix, point.input);
+				if(m_offset) noalias(f_b) += model.offset();
+
+				// compute loss gradient
+				loss.evalDerivative(point.label, f_b, derivative);
+
+				// lock-free update of the shared weights, restricted to the
+				// support of the sampled point
+				auto end = point.input.end();
+				for(auto pos = point.input.begin(); pos != end; ++pos){
+					std::size_t j = pos.index();
+					double x_j = *pos;
+					for(std::size_t i = 0; i != labelDim; ++i){
+						matrix(i,j) -= m_learningRate * (derivative(i) * x_j + regWeight(j) * matrix(i,j));
+					}
+				}
+				if(m_offset) noalias(model.offset()) -= m_learningRate * derivative;
+			}
+		}
+	}
+
+	LossType const* mep_loss;                 ///< pointer to loss function
+	double m_lambda;                          ///< regularization parameter
+	double m_learningRate;                    ///< SGD step size
+	bool m_offset;                            ///< should the resulting model have an offset term?
+	std::size_t m_maxEpochs;                  ///< number of training epochs (sweeps over the data), or 0 for the default of 10
+};
+
+}
+#endif
@@ -344,9 +344,13 @@ private:
 			
 			// update gradient
 			double eta = 1.0/(L+m_lambda);
-			stepsCumSum += kappa * eta;//we delay update of the matrix
 			if(m_offset) noalias(model.offset()) -= eta * gradOffset;
 			kappa *= 1 - eta * m_lambda;//2-norm regularization
+			//the model is stored as kappa * matrix, so a step of -eta*grad
+			//on the represented matrix requires a step of -eta/kappa*grad
+			//on the stored one. we delay this update until the affected
+			//coordinates are accessed again.
+			stepsCumSum += eta / kappa;
 			
 			//line-search procedure, 4.6 in the paper
 			noalias(f_b) -= derivative/L*pointNorms(b);
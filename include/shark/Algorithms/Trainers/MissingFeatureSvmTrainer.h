@@ -36,6 +36,8 @@
 #define SHARK_ALGORITHMS_TRAINERS_MISSING_FEATURE_SVM_H
 
 #include "shark/Algorithms/Trainers/AbstractSvmTrainer.h"
+#include "shark/Core/OpenMP.h"
+#include "shark/Data/DataView.h"
 #include "shark/Models/Kernels/EvalSkipMissingFeatures.h"
 #include "shark/Models/Kernels/KernelExpansion.h"
 #include "shark/Models/Kernels/MissingFeaturesKernelExpansion.h"
@@ -44,6 +46,8 @@
 #include <shark/LinAlg/CachedMatrix.h>
 #include <shark/LinAlg/ExampleModifiedKernelMatrix.h>
 
+#include <algorithm>
+
 namespace shark {
 
 /// \brief Trainer for binary SVMs natively supporting missing features.
@@ -111,12 +115,115 @@ private:
 	/// Number of iterations to run
 	std::size_t m_maxIterations;
 
+	/// Kernel matrices of the training data for every distinct missingness
+	/// pattern, plus the pattern index of every element. The matrix entries
+	/// depend only on which features are present, not on the current alphas or
+	/// scaling coefficients, so they are computed once before the alternating
+	/// optimization starts and every iteration reduces to quadratic forms.
+	struct MissingnessCache
+	{
+		/// Kernel matrix with no extra features masked out, used for \f$ ||w|| \f$
+		RealMatrix fullKernelMatrix;
+
+		/// One kernel matrix per distinct missingness pattern
+		std::vector<RealMatrix> patternKernelMatrices;
+
+		/// Pattern index of every element of the dataset
+		std::vector<std::size_t> patternOfElement;
+	};
+
+	MissingnessCache createMissingnessCache(Data<InputType> const& inputs) const
+	{
+		DataView<Data<InputType> const> elements(inputs);
+		const std::size_t numElements = elements.size();
+
+		MissingnessCache cache;
+		cache.patternOfElement.resize(numElements);
+
+		// Group the elements by their missingness pattern
+		std::vector<std::vector<bool> > patterns;
+		std::vector<std::size_t> representatives;
+		for (std::size_t i = 0; i < numElements; ++i)
+		{
+			std::vector<bool> pattern(elements[i].size());
+			for (std::size_t f = 0; f < pattern.size(); ++f)
+				pattern[f] = (bool)boost::math::isnan(elements[i](f));
+			const std::size_t q = std::find(patterns.begin(), patterns.end(), pattern) - patterns.begin();
+			if (q == patterns.size())
+			{
+				patterns.push_back(pattern);
+				representatives.push_back(i);
+			}
+			cache.patternOfElement[i] = q;
+		}
+
+		// The matrix entries are independent, so the rows are filled in parallel
+		cache.fullKernelMatrix.resize(numElements, numElements);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)numElements; ++i)
+		{
+			for (std::size_t j = 0; j <= (std::size_t)i; ++j)
+			{
+				const double k = evalSkipMissingFeatures(*base_type::m_kernel, elements[i], elements[j]);
+				cache.fullKernelMatrix(i, j) = k;
+				cache.fullKernelMatrix(j, i) = k;
+			}
+		}
+		cache.patternKernelMatrices.resize(patterns.size());
+		for (std::size_t q = 0; q < patterns.size(); ++q)
+		{
+			RealMatrix& matrix = cache.patternKernelMatrices[q];
+			matrix.resize(numElements, numElements);
+			SHARK_PARALLEL_FOR(int i = 0; i < (int)numElements; ++i)
+			{
+				for (std::size_t j = 0; j <= (std::size_t)i; ++j)
+				{
+					const double k = evalSkipMissingFeatures(
+						*base_type::m_kernel,
+						elements[i],
+						elements[j],
+						elements[representatives[q]]);
+					matrix(i, j) = k;
+					matrix(j, i) = k;
+				}
+			}
+		}
+		return cache;
+	}
+
+	/// Update the scaling coefficients with \f$ s_i = ||w_i|| / ||w|| \f$ where both
+	/// norms are quadratic forms of \f$ \alpha / s \f$ in the cached kernel matrices.
+	/// Elements sharing a missingness pattern share \f$ ||w_i|| \f$, so only one norm
+	/// per distinct pattern is computed.
+	void updateScalingCoefficients(
+		RealVector& scalingCoefficients,
+		RealVector const& alpha,
+		MissingnessCache const& cache
+	) const
+	{
+		const RealVector effectiveAlpha = element_div(alpha, scalingCoefficients);
+		const RealVector kernelTimesAlpha = prod(cache.fullKernelMatrix, effectiveAlpha);
+		const double classifierNorm = std::sqrt(inner_prod(effectiveAlpha, kernelTimesAlpha));
+		SHARK_ASSERT(classifierNorm > 0.0);
+
+		RealVector patternNorm(cache.patternKernelMatrices.size());
+		SHARK_PARALLEL_FOR(int q = 0; q < (int)patternNorm.size(); ++q)
+		{
+			const RealVector patternKernelTimesAlpha = prod(cache.patternKernelMatrices[q], effectiveAlpha);
+			patternNorm(q) = std::sqrt(inner_prod(effectiveAlpha, patternKernelTimesAlpha));
+		}
+		for (std::size_t i = 0; i < scalingCoefficients.size(); ++i)
+			scalingCoefficients(i) = patternNorm(cache.patternOfElement[i]) / classifierNorm;
+	}
+
 	void trainWithoutOffset(MissingFeaturesKernelExpansion<InputType>& svm, LabeledData<InputType, unsigned int> const& dataset)
 	{
 		
 		// Initialize scaling coefficients as 1.0
 		RealVector scalingCoefficients(dataset.numberOfElements(), 1.0);
 
+		// The masked kernel evaluations depend only on the missingness patterns
+		MissingnessCache cache = createMissingnessCache(dataset.inputs());
+
 		// What body of this loop does:
 		//   *) Solve the QP with a normal solver treating s_i as constants
 		//   *) Calculate norms: w_i and w
@@ -137,20 +244,10 @@ private:
 			QpSolver< ProblemType > solver(problem);
 			solver.solve(base_type::stoppingCondition(), &base_type::solutionProperties());
 			RealVector alpha = problem.getUnpermutedAlpha();
-			
+
 			//update s_i and w_i
-			const double classifierNorm = svm.computeNorm(alpha, scalingCoefficients);
-			SHARK_ASSERT(classifierNorm > 0.0);
-			for (std::size_t i = 0; i < scalingCoefficients.size(); ++i)
-			{
-				// Update scaling coefficients
-				scalingCoefficients(i) = svm.computeNorm(
-					alpha,
-					scalingCoefficients,
-					dataset.element(i).input)
-					/ classifierNorm;
-			}
-			
+			updateScalingCoefficients(scalingCoefficients, alpha, cache);
+
 			//store alpha in the last iteration inside the svm
 			if(iteration == m_maxIterations-1)
 				column(svm.alpha(),0)= alpha;
@@ -166,6 +263,9 @@ private:
 		std::size_t datasetSize = dataset.numberOfElements();
 		RealVector scalingCoefficients(datasetSize, 1.0);
 
+		// The masked kernel evaluations depend only on the missingness patterns
+		MissingnessCache cache = createMissingnessCache(dataset.inputs());
+
 		// What body of this loop does:
 		//   *) Solve the QP with a normal solver treating s_i as constants
 		//   *) Calculate norms: w_i and w
@@ -186,20 +286,10 @@ private:
 			QpSolver< ProblemType > solver(problem);
 			solver.solve(base_type::stoppingCondition(), &base_type::solutionProperties());
 			RealVector unpermutedAlpha = problem.getUnpermutedAlpha();
-			
+
 			//update s_i and w_i
-			const double classifierNorm = svm.computeNorm(unpermutedAlpha, scalingCoefficients);
-			SHARK_ASSERT(classifierNorm > 0.0);
-			for (std::size_t i = 0; i < scalingCoefficients.size(); ++i)
-			{
-				// Update scaling coefficients
-				scalingCoefficients(i) = svm.computeNorm(
-					unpermutedAlpha,
-					scalingCoefficients,
-					dataset.element(i).input
-				)/ classifierNorm;
-			}
-			
+			updateScalingCoefficients(scalingCoefficients, unpermutedAlpha, cache);
+
 			
 			if(iteration == m_maxIterations-1){
 				//in the last tieration,y
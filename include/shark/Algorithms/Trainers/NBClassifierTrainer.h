@@ -38,6 +38,7 @@
 #include "shark/Algorithms/Trainers/AbstractTrainer.h"
 #include "shark/Algorithms/Trainers/Distribution/GenericDistTrainer.h"
 #include "shark/Core/Exception.h"
+#include "shark/Core/OpenMP.h"
 #include "shark/Models/NBClassifier.h"
 
 #include <cmath>
@@ -59,7 +60,6 @@ class NBClassifierTrainer
 private:
 
 	typedef NBClassifier<InputType, OutputType> NBClassifierType;
-	typedef typename InputType::value_type InputValueType;
 
 public:
 
@@ -68,6 +68,12 @@ public:
 	{ return "NBClassifierTrainer"; }
 
 	/// @see AbstractTrainer::train
+	///
+	/// Training needs only a single pass over the dataset: every batch is
+	/// reduced to per-class counts, means and centered second moments, which
+	/// are then merged into the global statistics. Batches are processed in
+	/// parallel, and no sample buffers are kept, so the trainer also works on
+	/// datasets which are generated or streamed batch by batch.
 	void train(NBClassifierType& model, LabeledData<InputType, OutputType> const& dataset)
 	{
 		SIZE_CHECK(dataset.numberOfElements() > 0u);
@@ -79,28 +85,64 @@ public:
 		SHARK_CHECK(classSize == numberOfClasses(dataset), "Number of classes in dataset and model should match.");
 		SHARK_CHECK(featureSize == inputDimension(dataset), "Number of features in dataset and model should match.");
 
-		// Initialize trainer & buffer
-		std::vector<InputValueType> buffer;
-		buffer.reserve(dataset.numberOfElements() / classSize);
+		// Accumulate the sufficient statistics of all feature distributions in one pass
+		std::vector<std::size_t> counts(classSize, 0);
+		RealMatrix means(classSize, featureSize, 0.0);
+		RealMatrix sumSqrDeviations(classSize, featureSize, 0.0);
+		SHARK_PARALLEL_FOR(int b = 0; b < (int)dataset.numberOfBatches(); ++b)
+		{
+			auto const& batch = dataset.batch(b);
+
+			// Reduce the batch to per-class statistics
+			std::vector<std::size_t> batchCounts(classSize, 0);
+			RealMatrix batchMeans(classSize, featureSize, 0.0);
+			RealMatrix batchSumSqrDeviations(classSize, featureSize, 0.0);
+			for (std::size_t e = 0; e != batch.size(); ++e)
+			{
+				OutputType label = get(batch, e).label;
+				auto const& input = get(batch, e).input;
+				++batchCounts[label];
+				for (std::size_t j = 0; j != featureSize; ++j)
+				{
+					double delta = input(j) - batchMeans(label, j);
+					batchMeans(label, j) += delta / batchCounts[label];
+					batchSumSqrDeviations(label, j) += delta * (input(j) - batchMeans(label, j));
+				}
+			}
+
+			// Merge into the global statistics
+			SHARK_CRITICAL_REGION
+			{
+				for (std::size_t i = 0; i != classSize; ++i)
+				{
+					if (batchCounts[i] == 0) continue;
+					std::size_t newCount = counts[i] + batchCounts[i];
+					for (std::size_t j = 0; j != featureSize; ++j)
+					{
+						double delta = batchMeans(i, j) - means(i, j);
+						means(i, j) += batchCounts[i] * delta / newCount;
+						sumSqrDeviations(i, j) += batchSumSqrDeviations(i, j)
+							+ double(counts[i]) * batchCounts[i] / newCount * delta * delta;
+					}
+					counts[i] = newCount;
+				}
+			}
+		}
 
-		// Train individual feature distribution
+		// Train individual feature distribution from the accumulated statistics
 		for (std::size_t i = 0; i < classSize; ++i)
 		{
 			for (std::size_t j = 0; j < featureSize; ++j)
 			{
 				AbstractDistribution& dist = model.getFeatureDist(i, j);
-				buffer.clear();
-				getFeatureSample(buffer, dataset, i, j);
-				m_distTrainer.train(dist, buffer);
+				m_distTrainer.train(dist, counts[i], means(i, j), sumSqrDeviations(i, j));
 			}
 		}
 
 		// Figure out class distribution and add it to the model
-		const std::vector<std::size_t> occuranceCounter = classSizes(dataset);
-
 		const double totalClassOccurances = dataset.numberOfElements();
 		for (std::size_t i = 0; i < classSize; ++i) {
-			model.setClassPrior(i, occuranceCounter[i] / totalClassOccurances);
+			model.setClassPrior(i, counts[i] / totalClassOccurances);
 		}
 	}
 
@@ -109,26 +151,6 @@ public:
 
 private:
 
-	/// Get samples for a given feature in a given class
-	/// @param samples[out] the container which will store the samples we want to get
-	/// @param dataset the entire dataset
-	/// @param classIndex the index of class we are interested in
-	/// @param featureIndex the index of feature we are interested in
-	///
-	/// @note This can/should be optimized
-	void getFeatureSample(
-		std::vector<InputValueType>& samples,
-		const LabeledData<InputType, OutputType>& dataset,
-		OutputType classIndex,
-		std::size_t featureIndex
-	) const{
-		SHARK_CHECK(samples.empty(), "The output buffer should be cleaned before usage usually.");
-		for(auto elem: dataset.elements()){
-			if (elem.label == classIndex)
-				samples.push_back(elem.input(featureIndex));
-		}
-	}
-
 	/// Generic distribution trainer
 	GenericDistTrainer m_distTrainer;
 };
@@ -38,6 +38,7 @@
 #define SHARK_ALGORITHMS_TRAINERS_NORMALIZEKERNELUNITVARIANCE_H
 
 
+#include <shark/Core/OpenMP.h>
 #include <shark/Models/Kernels/ScaledKernel.h>
 #include <shark/Algorithms/Trainers/AbstractTrainer.h>
 
@@ -79,38 +80,95 @@ public:
 	void train( ScaledKernel<InputType>& kernel, UnlabeledData<InputType> const& input )
 	{
 		SHARK_CHECK(input.numberOfElements() >= 2, "[NormalizeKernelUnitVariance::train] input needs to contain at least two points");
-		AbstractKernelFunction< InputType > const& k = *kernel.base(); //get direct access to the kernel we want to use.		
-		
-		// Next compute the trace and mean of the kernel matrix. This means heavy lifting: 
+		AbstractKernelFunction< InputType > const& k = *kernel.base(); //get direct access to the kernel we want to use.
+
+		// Next compute the trace and mean of the kernel matrix. This means heavy lifting:
 		// calculate each entry of one diagonal half of the kernel matrix exactly once.
 		// [MT] This part was taken from the PrecomputedMatrix constructor in QuadraticProgram.h
 		// Blockwise version, with order of computations optimized for better use of the processor
-		// cache. This can save around 10% computation time for fast kernel functions.
-		std::size_t N = input.numberOfElements();
-		
-		//O.K. tried to make it more efficient (and shorter)
-		m_mean = 0.0;
-		m_matrixTrace = 0.0;
-		for(std::size_t i = 0; i != input.numberOfBatches(); ++i){
+		// cache. The tiles are independent of each other, so the rows of tiles are computed in
+		// parallel with one accumulator per thread; the dynamic schedule balances the growing
+		// row lengths of the triangular traversal.
+		m_numElements = input.numberOfElements();
+
+		std::vector<double> threadSum(SHARK_NUM_THREADS, 0.0);
+		std::vector<double> threadTrace(SHARK_NUM_THREADS, 0.0);
+		SHARK_PARALLEL_FOR_DYNAMIC(int i = 0; i < (int)input.numberOfBatches(); ++i){
 			typename UnlabeledData<InputType>::const_batch_reference batch = input.batch(i);
+			double rowSum = 0.0;
 			//off diagonal entries
-			for(std::size_t j = 0; j < i; ++j){
+			for(std::size_t j = 0; j < (std::size_t)i; ++j){
 				RealMatrix matrixBlock = k(batch, input.batch(j));
-				m_mean += 2*sum(matrixBlock);
+				rowSum += 2*sum(matrixBlock);
 			}
 			RealMatrix matrixBlock = k(batch, batch);
-			m_mean += sum(matrixBlock);
-			m_matrixTrace += blas::trace(matrixBlock);
+			rowSum += sum(matrixBlock);
+			threadSum[SHARK_THREAD_NUM] += rowSum;
+			threadTrace[SHARK_THREAD_NUM] += blas::trace(matrixBlock);
 		}
-		double tm = m_matrixTrace/N - m_mean/N/N;
-		SHARK_ASSERT( tm > 0 );
-		double scaling_factor = 1.0 / tm;
-		kernel.setFactor( scaling_factor );
+		m_mean = 0.0;
+		m_matrixTrace = 0.0;
+		for(std::size_t t = 0; t != threadSum.size(); ++t){
+			m_mean += threadSum[t];
+			m_matrixTrace += threadTrace[t];
+		}
+		setScalingFactor(kernel);
+	}
+
+	/// \brief Extend a previous normalization by additional points.
+	///
+	/// Only the kernel matrix blocks involving the new points are evaluated:
+	/// extending \f$ N \f$ already normalized points by \f$ M \f$ new ones costs
+	/// \f$ O(NM + M^2) \f$ kernel evaluations instead of \f$ O((N+M)^2) \f$ for
+	/// retraining from scratch. \a oldInput must be the data the trainer was
+	/// trained on (including any points added by previous updates).
+	void update( ScaledKernel<InputType>& kernel, UnlabeledData<InputType> const& oldInput, UnlabeledData<InputType> const& newInput )
+	{
+		SHARK_CHECK(
+			oldInput.numberOfElements() == m_numElements,
+			"[NormalizeKernelUnitVariance::update] oldInput must be the previously normalized data"
+		);
+		AbstractKernelFunction< InputType > const& k = *kernel.base();
+
+		std::vector<double> threadSum(SHARK_NUM_THREADS, 0.0);
+		std::vector<double> threadTrace(SHARK_NUM_THREADS, 0.0);
+		SHARK_PARALLEL_FOR_DYNAMIC(int i = 0; i < (int)newInput.numberOfBatches(); ++i){
+			typename UnlabeledData<InputType>::const_batch_reference batch = newInput.batch(i);
+			double rowSum = 0.0;
+			//blocks between new and old points
+			for(std::size_t j = 0; j != oldInput.numberOfBatches(); ++j){
+				RealMatrix matrixBlock = k(batch, oldInput.batch(j));
+				rowSum += 2*sum(matrixBlock);
+			}
+			//blocks among the new points
+			for(std::size_t j = 0; j < (std::size_t)i; ++j){
+				RealMatrix matrixBlock = k(batch, newInput.batch(j));
+				rowSum += 2*sum(matrixBlock);
+			}
+			RealMatrix matrixBlock = k(batch, batch);
+			rowSum += sum(matrixBlock);
+			threadSum[SHARK_THREAD_NUM] += rowSum;
+			threadTrace[SHARK_THREAD_NUM] += blas::trace(matrixBlock);
+		}
+		for(std::size_t t = 0; t != threadSum.size(); ++t){
+			m_mean += threadSum[t];
+			m_matrixTrace += threadTrace[t];
+		}
+		m_numElements += newInput.numberOfElements();
+		setScalingFactor(kernel);
 	}
 
 protected:
+	void setScalingFactor( ScaledKernel<InputType>& kernel ) const
+	{
+		double tm = m_matrixTrace/m_numElements - m_mean/m_numElements/m_numElements;
+		SHARK_ASSERT( tm > 0 );
+		kernel.setFactor( 1.0 / tm );
+	}
+
 	double m_mean; //store for other uses, external queries, etc.
 	double m_matrixTrace;
+	std::size_t m_numElements; //number of points the current sums are taken over
 };
 
 
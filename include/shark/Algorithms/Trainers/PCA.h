@@ -123,6 +123,39 @@ public:
 	//! of the data is stored inthe PCA object.
 	SHARK_EXPORT_SYMBOL void setData(UnlabeledData<RealVector> const& inputs);
 
+	//! Adds a chunk of data to the sufficient statistics of the PCA.
+	//! Mean and second moment are accumulated batch-wise as rank-k
+	//! updates, so append-only data can be folded in chunk by chunk
+	//! without revisiting old data. The eigendecomposition is deferred
+	//! until finalize() is called. Only the standard algorithm, which
+	//! decomposes the covariance matrix in input space, is available
+	//! in this mode.
+	SHARK_EXPORT_SYMBOL void update(UnlabeledData<RealVector> const& inputs);
+
+	//! Merges the sufficient statistics accumulated by another PCA
+	//! object via update(), e.g. on a different shard of the data.
+	SHARK_EXPORT_SYMBOL void merge(PCA const& other);
+
+	//! Computes the eigendecomposition from the statistics accumulated
+	//! by update() and merge(). Afterwards encoder() and decoder() can
+	//! be used as if the PCA had been trained on the whole data at once.
+	//! Further calls to update() may follow, refining the statistics.
+	SHARK_EXPORT_SYMBOL void finalize();
+
+	//! Refits the leading eigenbasis by warm-started subspace iteration.
+	//! Starting from the eigenvectors of the previous decomposition, a few
+	//! orthogonal iteration sweeps against the covariance matrix given by
+	//! the accumulated statistics are performed, followed by a
+	//! Rayleigh-Ritz rotation. When the basis drifts slowly between refits
+	//! - e.g. daily maintenance over a growing dataset - two to three
+	//! sweeps recover the leading components at a fraction of the cost of
+	//! the full eigendecomposition done by finalize(). Afterwards the PCA
+	//! holds only the refitted components, which encoder() and decoder()
+	//! then use.
+	//! \param components number of leading components to refit; 0 refits the whole previous basis
+	//! \param sweeps     number of subspace iteration sweeps
+	SHARK_EXPORT_SYMBOL void refit(std::size_t components = 0, std::size_t sweeps = 3);
+
 	//! Returns a model mapping the original data to the
 	//! m-dimensional PCA coordinate system.
 	SHARK_EXPORT_SYMBOL void encoder(LinearModel<>& model, std::size_t m = 0);
@@ -166,6 +199,9 @@ protected:
 	RealVector m_eigenvalues;  ///< eigenvalues
 	RealVector m_mean;	   ///< mean value
 
+	RealVector m_sum;          ///< sum of the data points seen by update()
+	RealMatrix m_secondMoment; ///< second moment matrix of the data seen by update()
+
 	std::size_t m_n;           ///< number of attributes
 	std::size_t m_l;           ///< number of training data points
 
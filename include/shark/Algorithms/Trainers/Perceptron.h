@@ -50,18 +50,40 @@ public:
 	/// @param kernel is the (Mercer) kernel function.
 	/// @param maxTimesPattern defines the maximum number of times the data is processed before the algorithms stopps.
 	Perceptron(AbstractKernelFunction<InputType>* kernel, std::size_t maxTimesPattern = 10000)
-	:mpe_kernel(kernel),m_maxTimesPattern(maxTimesPattern){}
+	:mpe_kernel(kernel),m_maxTimesPattern(maxTimesPattern),m_batchTraining(false){}
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
 	{ return "Perceptron"; }
 
+	/// \brief Returns whether the batch update rule is used.
+	bool batchTraining()const{
+		return m_batchTraining;
+	}
+
+	/// \brief Enables or disables the batch update rule.
+	///
+	/// In batch mode every pass evaluates the current model over the whole
+	/// dataset with the blocked expansion evaluator and then applies all
+	/// violating updates at once, scaled by one over their number. This
+	/// replaces the per-element kernel evaluations of the classic sequential
+	/// rule by large kernel blocks and is much faster on big datasets, at the
+	/// price of typically more passes until convergence.
+	void setBatchTraining(bool batchTraining){
+		m_batchTraining = batchTraining;
+	}
+
 	void train(KernelClassifier<InputType>& classifier, LabeledData<InputType, unsigned int> const& dataset){
 		std::size_t patterns = dataset.numberOfElements();
 		KernelExpansion<InputType>& model= classifier.decisionFunction();
 		model.setStructure(mpe_kernel,dataset.inputs(),false,1);
 		model.alpha().clear();
 
+		if(m_batchTraining){
+			trainBatch(model,dataset);
+			return;
+		}
+
 		bool err;
 		std::size_t iter = 0;
 		do {
@@ -80,8 +102,40 @@ public:
 		} while (err);
 	}
 private:
+	void trainBatch(KernelExpansion<InputType>& model, LabeledData<InputType, unsigned int> const& dataset){
+		std::size_t patterns = dataset.numberOfElements();
+		bool err;
+		std::size_t iter = 0;
+		do {
+			err = false;
+			//evaluate the current model over the whole dataset at once
+			Data<RealVector> predictions = model(dataset.inputs());
+			//collect the violating elements of this pass
+			std::vector<std::size_t> violators;
+			for (std::size_t i = 0; i != patterns; i++){
+				double result = predictions.element(i)(0);
+				double label = dataset.element(i).label*2.0-1;
+				if ( result * label  <= 0.0)
+					violators.push_back(i);
+			}
+			//apply all updates averaged, so a pass takes a normalized step
+			//along the gradient of the perceptron criterion
+			if(!violators.empty()){
+				err = true;
+				double eta = 1.0/violators.size();
+				for(std::size_t i: violators){
+					double label = dataset.element(i).label*2.0-1;
+					model.alpha(i,0) += eta*label;
+				}
+			}
+			if (iter > m_maxTimesPattern * patterns) break;	// probably non-separable data
+			iter++;
+		} while (err);
+	}
+
 	AbstractKernelFunction<InputType>* mpe_kernel;
 	std::size_t m_maxTimesPattern; //< maximum number of times a training is processed
+	bool m_batchTraining; //< whether the batch update rule is used
 };
 
 
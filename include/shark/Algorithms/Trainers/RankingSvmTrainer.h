@@ -37,12 +37,17 @@
 
 
 #include <shark/Algorithms/Trainers/AbstractSvmTrainer.h>
+#include <shark/Algorithms/GradientDescent/Rprop.h>
 #include <shark/Algorithms/QP/BoxConstrainedProblems.h>
 #include <shark/Algorithms/QP/SvmProblems.h>
 #include <shark/Algorithms/QP/QpSolver.h>
 #include <shark/LinAlg/DifferenceKernelMatrix.h>
 #include <shark/LinAlg/CachedMatrix.h>
 #include <shark/LinAlg/PrecomputedMatrix.h>
+#include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+
+#include <algorithm>
+#include <map>
 
 namespace shark {
 
@@ -92,12 +97,38 @@ public:
 	//! \param  unconstrained  when a C-value is given via setParameter, should it be piped through the exp-function before using it in the solver?
 	RankingSvmTrainer(KernelType* kernel, double C, bool unconstrained = false)
 	: base_type(kernel, C, false, unconstrained)
+	, m_implicitPairs(false)
+	, m_implicitIterations(100)
 	{ }
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
 	{ return "RankingSvmTrainer"; }
 
+	/// \brief Whether preference pairs are represented implicitly during training.
+	bool implicitPairs() const
+	{ return m_implicitPairs; }
+
+	/// \brief Enables or disables the implicit pair representation.
+	///
+	/// In implicit mode the trainer optimizes the equivalent primal problem
+	/// with Rprop. Hinge terms and their per-document subgradients are
+	/// aggregated over rank positions with a Fenwick tree, so an iteration
+	/// costs O(n log n) plus the kernel matrix-vector products, and no pair
+	/// structures are ever materialized. The mode applies to the two train
+	/// variants which derive the pairs from a total order or from labels;
+	/// explicitly given pairs are always solved in the dual.
+	void setImplicitPairs(bool implicitPairs)
+	{ m_implicitPairs = implicitPairs; }
+
+	/// \brief Number of Rprop iterations used in implicit mode.
+	unsigned int implicitIterations() const
+	{ return m_implicitIterations; }
+
+	/// \brief Sets the number of Rprop iterations used in implicit mode.
+	void setImplicitIterations(unsigned int iterations)
+	{ m_implicitIterations = iterations; }
+
 	/// \brief Train the ranking SVM.
 	///
 	/// This variant of the train function assumes that all pairs of
@@ -105,8 +136,15 @@ public:
 	/// the data set. 
 	void train(KernelExpansion<InputType>& function, Data<InputType> const& dataset)
 	{
-		// create all pairs
 		std::size_t n = dataset.numberOfElements();
+		if (m_implicitPairs) {
+			//every element forms its own rank group
+			std::vector<unsigned int> ranks(n);
+			for (std::size_t i=0; i<n; i++) ranks[i] = (unsigned int)i;
+			trainImplicit(function, dataset, ranks);
+			return;
+		}
+		// create all pairs
 		std::vector<std::pair<std::size_t, std::size_t>> pairs;
 		for (std::size_t i=0; i<n; i++) {
 			for (std::size_t j=0; j<i; j++) {
@@ -124,6 +162,16 @@ public:
 	/// the point with smaller label.
 	void train(KernelExpansion<InputType>& function, LabeledData<InputType, unsigned int> const& dataset)
 	{
+		if (m_implicitPairs) {
+			std::vector<unsigned int> ranks(dataset.numberOfElements());
+			std::size_t i = 0;
+			for (auto const& yi : dataset.labels().elements()) {
+				ranks[i] = yi;
+				i++;
+			}
+			trainImplicit(function, dataset.inputs(), ranks);
+			return;
+		}
 		std::vector<std::pair<std::size_t, std::size_t>> pairs;
 		std::size_t i = 0;
 		for (auto const& yi : dataset.labels().elements()) {
@@ -162,6 +210,210 @@ public:
 	}
 
 private:
+	/// \brief Primal ranking objective over implicitly represented preference pairs.
+	///
+	/// The objective is
+	/// \f[ \frac{1}{2} a^T K a + C \sum_{rank_i < rank_j} \max(0, 1 - (f_j - f_i)) \f]
+	/// with \f$ f = K a \f$. The pairs are never enumerated: documents are
+	/// processed in rank order while a Fenwick tree indexed by score position
+	/// accumulates counts and score sums of the documents seen so far, so the
+	/// hinge terms and their per-document subgradients are aggregated in
+	/// O(n log n) on top of the kernel matrix-vector products.
+	class ImplicitRankingProblem : public SingleObjectiveFunction
+	{
+	public:
+		ImplicitRankingProblem(KernelType const& kernel, Data<InputType> const& data, std::vector<unsigned int> const& ranks, double C)
+		: m_kernel(kernel)
+		, m_data(data)
+		, m_size(ranks.size())
+		, m_C(C)
+		{
+			m_features |= HAS_FIRST_DERIVATIVE;
+			m_features |= CAN_PROPOSE_STARTING_POINT;
+
+			//bucket the documents into groups of equal rank, ordered by rank
+			std::map<unsigned int, std::vector<std::size_t>> buckets;
+			for (std::size_t i=0; i<m_size; i++) buckets[ranks[i]].push_back(i);
+			for (auto const& bucket : buckets) m_groups.push_back(bucket.second);
+		}
+
+		std::string name() const
+		{ return "ImplicitRankingProblem"; }
+
+		std::size_t numberOfVariables() const
+		{ return m_size; }
+
+		SearchPointType proposeStartingPoint() const
+		{ return SearchPointType(m_size, 0.0); }
+
+		double eval(SearchPointType const& point) const
+		{
+			SIZE_CHECK(point.size() == m_size);
+			m_evaluationCounter++;
+			RealVector f(m_size, 0.0);
+			kernelProduct(point, f);
+			return 0.5 * inner_prod(point, f) + m_C * aggregateHinge(f, NULL);
+		}
+
+		double evalDerivative(SearchPointType const& point, FirstOrderDerivative& derivative) const
+		{
+			SIZE_CHECK(point.size() == m_size);
+			m_evaluationCounter++;
+			RealVector f(m_size, 0.0);
+			kernelProduct(point, f);
+			RealVector g(m_size, 0.0);
+			double loss = aggregateHinge(f, &g);
+			derivative.resize(m_size);
+			noalias(derivative) = f;
+			//chain rule through f = K a: add C * K g to the regularizer gradient
+			RealVector Kg(m_size, 0.0);
+			kernelProduct(g, Kg);
+			noalias(derivative) += m_C * Kg;
+			return 0.5 * inner_prod(point, f) + m_C * loss;
+		}
+
+	private:
+		/// Fenwick tree over score positions, holding counts and score sums.
+		struct PrefixSums
+		{
+			std::vector<double> counts;
+			std::vector<double> sums;
+
+			PrefixSums(std::size_t n): counts(n+1, 0.0), sums(n+1, 0.0){}
+
+			void insert(std::size_t pos, double value){
+				for (std::size_t i=pos+1; i<counts.size(); i += i & (~i + 1)){
+					counts[i] += 1.0;
+					sums[i] += value;
+				}
+			}
+
+			//accumulates count and sum over all inserted positions < pos
+			void prefix(std::size_t pos, double& count, double& sum) const{
+				for (std::size_t i=pos; i>0; i -= i & (~i + 1)){
+					count += counts[i];
+					sum += sums[i];
+				}
+			}
+		};
+
+		/// \brief Computes result += K point with blockwise kernel evaluations.
+		void kernelProduct(RealVector const& point, RealVector& result) const
+		{
+			std::size_t batches = m_data.numberOfBatches();
+			RealMatrix block;
+			std::size_t start1 = 0;
+			for (std::size_t b1=0; b1<batches; b1++)
+			{
+				auto const& batch1 = m_data.batch(b1);
+				std::size_t size1 = size(batch1);
+				std::size_t start2 = start1;
+				for (std::size_t b2=b1; b2<batches; b2++)
+				{
+					auto const& batch2 = m_data.batch(b2);
+					std::size_t size2 = size(batch2);
+					m_kernel.eval(batch1, batch2, block);
+					noalias(subrange(result, start1, start1 + size1)) += prod(block, subrange(point, start2, start2 + size2));
+					//by symmetry the transposed block serves the mirrored contribution
+					if (b2 != b1)
+						noalias(subrange(result, start2, start2 + size2)) += prod(trans(block), subrange(point, start1, start1 + size1));
+					start2 += size2;
+				}
+				start1 += size1;
+			}
+		}
+
+		/// \brief Aggregated hinge loss over all pairs of documents with different rank.
+		///
+		/// If gradient is non-NULL, the subgradient with respect to the function
+		/// values is added to it.
+		double aggregateHinge(RealVector const& f, RealVector* gradient) const
+		{
+			//score positions: queries are answered with value bounds on the
+			//sorted scores, so ties may be broken arbitrarily
+			std::vector<double> sorted(f.begin(), f.end());
+			std::sort(sorted.begin(), sorted.end());
+			std::vector<std::size_t> position(m_size);
+			{
+				std::vector<std::size_t> order(m_size);
+				for (std::size_t i=0; i<m_size; i++) order[i] = i;
+				std::sort(order.begin(), order.end(), [&f](std::size_t a, std::size_t b){ return f(a) < f(b); });
+				for (std::size_t r=0; r<m_size; r++) position[order[r]] = r;
+			}
+
+			//forward pass in increasing rank order: for each document the
+			//tree holds all lower ranked documents, of which those with
+			//score above f - 1 form active pairs
+			double loss = 0.0;
+			PrefixSums lower(m_size);
+			double insertedCount = 0.0;
+			double insertedSum = 0.0;
+			for (std::size_t g=0; g<m_groups.size(); g++)
+			{
+				for (std::size_t idx : m_groups[g])
+				{
+					std::size_t pos = std::upper_bound(sorted.begin(), sorted.end(), f(idx) - 1.0) - sorted.begin();
+					double count = 0.0, sum = 0.0;
+					lower.prefix(pos, count, sum);
+					count = insertedCount - count;
+					sum = insertedSum - sum;
+					loss += count * (1.0 - f(idx)) + sum;
+					if (gradient) (*gradient)(idx) -= count;
+				}
+				for (std::size_t idx : m_groups[g])
+				{
+					lower.insert(position[idx], f(idx));
+					insertedCount += 1.0;
+					insertedSum += f(idx);
+				}
+			}
+
+			//backward pass for the other side of the subgradient: each
+			//document gains one unit per higher ranked document scoring
+			//below f + 1
+			if (gradient)
+			{
+				PrefixSums upper(m_size);
+				for (std::size_t g=m_groups.size(); g>0; g--)
+				{
+					for (std::size_t idx : m_groups[g-1])
+					{
+						std::size_t pos = std::lower_bound(sorted.begin(), sorted.end(), f(idx) + 1.0) - sorted.begin();
+						double count = 0.0, sum = 0.0;
+						upper.prefix(pos, count, sum);
+						(*gradient)(idx) += count;
+					}
+					for (std::size_t idx : m_groups[g-1])
+						upper.insert(position[idx], f(idx));
+				}
+			}
+			return loss;
+		}
+
+		KernelType const& m_kernel;
+		Data<InputType> const& m_data;
+		std::size_t m_size;
+		double m_C;
+		std::vector<std::vector<std::size_t>> m_groups;
+	};
+
+	/// \brief Trains the primal problem on implicitly represented pairs.
+	void trainImplicit(KernelExpansion<InputType>& function, Data<InputType> const& dataset, std::vector<unsigned int> const& ranks)
+	{
+		function.setStructure(base_type::m_kernel, dataset, false);
+		ImplicitRankingProblem objective(*base_type::m_kernel, dataset, ranks, this->C());
+		IRpropPlus rprop;
+		rprop.init(objective);
+		for (unsigned int i=0; i<m_implicitIterations; i++)
+			rprop.step(objective);
+		blas::column(function.alpha(),0) = rprop.solution().point;
+
+		if (base_type::sparsify()) function.sparsify();
+	}
+
+	bool m_implicitPairs;               ///< train on implicitly represented pairs?
+	unsigned int m_implicitIterations;  ///< number of Rprop iterations in implicit mode
+
 	template <typename MatrixType>
 	void trainInternal(KernelExpansion<InputType>& function, Data<InputType> const& dataset, std::vector<std::pair<std::size_t, std::size_t>> const& pairs, MatrixType& matrix)
 	{
@@ -39,6 +39,7 @@
 
 
 #include <shark/Algorithms/Trainers/AbstractSvmTrainer.h>
+#include <shark/Data/DataView.h>
 #include <shark/Models/Kernels/KernelHelpers.h>
 #include <shark/LinAlg/solveSystem.h>
 
@@ -130,6 +131,101 @@ public:
 };
 
 
+///
+/// \brief Nystrom-approximated training of a regularization network.
+///
+/// Instead of solving the full \f$ n \times n \f$ kernel system, a
+/// random subset of m landmark points is drawn and the solution is
+/// restricted to their span. With \f$ K_{nm} \f$ the kernel matrix
+/// between data and landmarks and \f$ K_{mm} \f$ the landmark Gram
+/// matrix, the coefficients solve
+/// \f[ (K_{mn} K_{nm} + \sigma_n^2 K_{mm}) \alpha = K_{mn} y, \f]
+/// which is the regularization network objective restricted to the
+/// landmark span. The cost is one streamed pass over the data for
+/// the projections plus an \f$ m \times m \f$ solve; the full Gram
+/// matrix is never materialized. The landmark count trades accuracy
+/// for speed: for m equal to the dataset size the exact solution is
+/// recovered, small m gives large savings at reduced accuracy.
+///
+template <class InputType>
+class NystromRegularizationNetworkTrainer : public AbstractSvmTrainer<InputType, RealVector,KernelExpansion<InputType> >
+{
+public:
+	typedef AbstractModel<InputType, RealVector> ModelType;
+	typedef AbstractKernelFunction<InputType> KernelType;
+	typedef AbstractSvmTrainer<InputType, RealVector, KernelExpansion<InputType> > base_type;
+
+	/// \param kernel Kernel
+	/// \param betaInv Inverse precision, equal to assumed noise variance, equal to inverse regularization parameter C
+	/// \param landmarks Number of landmark points of the approximation
+	/// \param unconstrained Indicates exponential encoding of the regularization parameter
+	NystromRegularizationNetworkTrainer(KernelType* kernel, double betaInv, std::size_t landmarks, bool unconstrained = false)
+	: base_type(kernel, 1.0 / betaInv, false, unconstrained)
+	, m_landmarks(landmarks)
+	{ }
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "NystromRegularizationNetworkTrainer"; }
+
+	/// \brief Returns the assumed noise variance (i.e., 1/C)
+	double noiseVariance() const
+	{ return 1.0 / this->C(); }
+	/// \brief Sets the assumed noise variance (i.e., 1/C)
+	void setNoiseVariance(double betaInv)
+	{ this->C() = 1.0 / betaInv; }
+
+	/// \brief Returns the number of landmark points of the approximation
+	std::size_t numberOfLandmarks() const
+	{ return m_landmarks; }
+	/// \brief Sets the number of landmark points of the approximation
+	void setNumberOfLandmarks(std::size_t landmarks)
+	{ m_landmarks = landmarks; }
+
+	void train(KernelExpansion<InputType>& svm, const LabeledData<InputType, RealVector>& dataset)
+	{
+		//draw the landmark points as a random subset of the data
+		std::size_t m = std::min(m_landmarks,dataset.numberOfElements());
+		DataView<Data<InputType> const> view(dataset.inputs());
+		Data<InputType> landmarks = toDataset(randomSubset(view,m));
+		svm.setStructure(base_type::m_kernel,landmarks,false);
+
+		RealMatrix Kmm = calculateRegularizedKernelMatrix(*(this->m_kernel),landmarks,0.0);
+
+		//stream over the data once and accumulate the projected system
+		//K_mn K_nm and K_mn y without materializing K_nm as a whole
+		RealMatrix M(m,m,0.0);
+		RealVector v(m,0.0);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)dataset.numberOfBatches(); ++i){
+			//kernel block between the batch and all landmarks
+			std::size_t batchSize = size(dataset.batch(i));
+			RealMatrix blockK(batchSize,m);
+			std::size_t start = 0;
+			for(std::size_t j = 0; j != landmarks.numberOfBatches(); ++j){
+				std::size_t landmarkBatchSize = size(landmarks.batch(j));
+				noalias(columns(blockK,start,start+landmarkBatchSize))
+					= (*base_type::m_kernel)(dataset.batch(i).input,landmarks.batch(j));
+				start += landmarkBatchSize;
+			}
+			RealMatrix threadM = prod(trans(blockK),blockK);
+			RealVector threadv = prod(trans(blockK),column(dataset.batch(i).label,0));
+			SHARK_CRITICAL_REGION{
+				noalias(M) += threadM;
+				noalias(v) += threadv;
+			}
+		}
+		noalias(M) += noiseVariance()*Kmm;
+
+		//Kmm and thus M may be rank-deficient, e.g. for duplicate landmarks
+		blas::solveSymmSemiDefiniteSystemInPlace<blas::SolveAXB>(M,v);
+		column(svm.alpha(),0) = v;
+	}
+
+protected:
+	std::size_t m_landmarks; ///< number of landmark points of the approximation
+};
+
+
 // A regularization network can be interpreted as a Gaussian
 // process, with the same trainer:
 #define GaussianProcessTrainer RegularizationNetworkTrainer
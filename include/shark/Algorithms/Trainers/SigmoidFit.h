@@ -54,16 +54,28 @@ namespace shark{
 class SigmoidFitRpropNLL: public AbstractTrainer<SigmoidModel, unsigned int>
 {
 public:
-	SHARK_EXPORT_SYMBOL SigmoidFitRpropNLL( unsigned int iters = 100 );
+	SHARK_EXPORT_SYMBOL SigmoidFitRpropNLL( unsigned int iters = 100, std::size_t maxSamples = 0 );
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
 	{ return "SigmoidFitRpropNLL"; }
 
+	/// \brief Maximum number of decision values used for the fit, 0 uses all of them.
+	std::size_t maxSamples() const
+	{ return m_maxSamples; }
+
+	/// \brief Sets the maximum number of decision values used for the fit.
+	///
+	/// If the dataset holds more elements, a random subset of this size is
+	/// drawn once before the optimization starts. 0 disables subsampling.
+	void setMaxSamples( std::size_t maxSamples )
+	{ m_maxSamples = maxSamples; }
+
 	SHARK_EXPORT_SYMBOL void train(SigmoidModel& model, LabeledData<RealVector, unsigned int> const& dataset);
-	
+
 private:
 	unsigned int m_iterations;
+	std::size_t m_maxSamples;
 };
 
 
@@ -0,0 +1,250 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Versioned raw-binary snapshots of models and datasets
+ *
+ *
+ * \par
+ * The archive based serialization of ISerializable visits every stored
+ * value through the polymorphic archive interface, which makes saving
+ * large models - a kernel expansion with millions of support vectors,
+ * say - unnecessarily slow. The snapshot functions in this file write
+ * the same state as a flat binary image: the storage of dense vectors
+ * and matrices is written in bulk instead of element by element. Every
+ * snapshot starts with a small versioned header so that readers can
+ * reject foreign files and future format revisions can stay readable.
+ *
+ * \par
+ * Snapshots store values in native byte order and are meant as a fast
+ * machine-local format; the boost archives remain the portable and
+ * compatible fallback.
+ *
+ *
+ * \author      O. Krause
+ * \date        2016
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_CORE_BINARYSNAPSHOT_H
+#define SHARK_CORE_BINARYSNAPSHOT_H
+
+#include <shark/Core/Exception.h>
+#include <shark/Core/IParameterizable.h>
+#include <shark/LinAlg/Base.h>
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace shark {
+
+template<class Type> class Data;
+
+namespace detail {
+
+//tags identifying what a snapshot contains
+std::uint64_t const SnapshotContentParameters = 1;
+std::uint64_t const SnapshotContentKernelExpansion = 2;
+std::uint64_t const SnapshotContentData = 3;
+
+inline char const* binarySnapshotMagic(){
+	return "SHRKSNAP";
+}
+
+inline void writeSnapshotHeader(std::ostream& out, std::uint64_t contentTag, std::uint64_t contentVersion){
+	out.write(binarySnapshotMagic(), 8);
+	std::uint64_t formatVersion = 1;
+	out.write(reinterpret_cast<char const*>(&formatVersion), sizeof(formatVersion));
+	out.write(reinterpret_cast<char const*>(&contentTag), sizeof(contentTag));
+	out.write(reinterpret_cast<char const*>(&contentVersion), sizeof(contentVersion));
+}
+
+///\brief Checks magic, format version and content tag; returns the content version.
+inline std::uint64_t readSnapshotHeader(std::istream& in, std::uint64_t expectedTag){
+	char magic[8];
+	std::uint64_t formatVersion = 0;
+	std::uint64_t contentTag = 0;
+	std::uint64_t contentVersion = 0;
+	in.read(magic, 8);
+	in.read(reinterpret_cast<char*>(&formatVersion), sizeof(formatVersion));
+	in.read(reinterpret_cast<char*>(&contentTag), sizeof(contentTag));
+	in.read(reinterpret_cast<char*>(&contentVersion), sizeof(contentVersion));
+	if(!in || std::memcmp(magic, binarySnapshotMagic(), 8) != 0)
+		throw SHARKEXCEPTION("[loadBinarySnapshot] file is not a binary snapshot");
+	if(formatVersion != 1)
+		throw SHARKEXCEPTION("[loadBinarySnapshot] unsupported snapshot format version");
+	if(contentTag != expectedTag)
+		throw SHARKEXCEPTION("[loadBinarySnapshot] snapshot stores a different type of object");
+	return contentVersion;
+}
+
+}
+
+/**
+ * \ingroup shark_globals
+ *
+ * @{
+ */
+
+/// \brief Writes a single arithmetic value to a snapshot stream.
+template<class T>
+typename std::enable_if<std::is_arithmetic<T>::value, void>::type
+writeBinary(std::ostream& out, T value){
+	out.write(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+/// \brief Reads a single arithmetic value from a snapshot stream.
+template<class T>
+typename std::enable_if<std::is_arithmetic<T>::value, void>::type
+readBinary(std::istream& in, T& value){
+	in.read(reinterpret_cast<char*>(&value), sizeof(T));
+	if(!in)
+		throw SHARKEXCEPTION("[loadBinarySnapshot] snapshot is truncated");
+}
+
+/// \brief Writes a dense vector to a snapshot stream, storage in bulk.
+template<class T>
+void writeBinary(std::ostream& out, blas::vector<T> const& vector){
+	writeBinary(out, std::uint64_t(vector.size()));
+	if(vector.size())
+		out.write(
+			reinterpret_cast<char const*>(vector.raw_storage().values),
+			vector.size() * sizeof(T)
+		);
+}
+
+/// \brief Reads a dense vector from a snapshot stream, storage in bulk.
+template<class T>
+void readBinary(std::istream& in, blas::vector<T>& vector){
+	std::uint64_t size = 0;
+	readBinary(in, size);
+	vector.resize(size);
+	if(size){
+		in.read(
+			reinterpret_cast<char*>(vector.raw_storage().values),
+			size * sizeof(T)
+		);
+		if(!in)
+			throw SHARKEXCEPTION("[loadBinarySnapshot] snapshot is truncated");
+	}
+}
+
+/// \brief Writes a dense matrix to a snapshot stream, storage in bulk.
+template<class T>
+void writeBinary(std::ostream& out, blas::matrix<T> const& matrix){
+	writeBinary(out, std::uint64_t(matrix.size1()));
+	writeBinary(out, std::uint64_t(matrix.size2()));
+	if(matrix.size1() * matrix.size2())
+		out.write(
+			reinterpret_cast<char const*>(matrix.raw_storage().values),
+			matrix.size1() * matrix.size2() * sizeof(T)
+		);
+}
+
+/// \brief Reads a dense matrix from a snapshot stream, storage in bulk.
+template<class T>
+void readBinary(std::istream& in, blas::matrix<T>& matrix){
+	std::uint64_t size1 = 0;
+	std::uint64_t size2 = 0;
+	readBinary(in, size1);
+	readBinary(in, size2);
+	matrix.resize(size1, size2);
+	if(size1 * size2){
+		in.read(
+			reinterpret_cast<char*>(matrix.raw_storage().values),
+			size1 * size2 * sizeof(T)
+		);
+		if(!in)
+			throw SHARKEXCEPTION("[loadBinarySnapshot] snapshot is truncated");
+	}
+}
+
+/// \brief Writes a dataset of dense vectors to a snapshot stream.
+///
+/// In contrast to exportBinaryData this keeps the exact batch structure,
+/// so a reloaded dataset is indistinguishable from the stored one.
+template<class T>
+void writeBinary(std::ostream& out, Data<blas::vector<T> > const& data){
+	writeBinary(out, std::uint64_t(data.numberOfBatches()));
+	for(std::size_t b = 0; b != data.numberOfBatches(); ++b)
+		writeBinary(out, data.batch(b));
+}
+
+/// \brief Reads a dataset of dense vectors from a snapshot stream.
+template<class T>
+void readBinary(std::istream& in, Data<blas::vector<T> >& data){
+	std::uint64_t numberOfBatches = 0;
+	readBinary(in, numberOfBatches);
+	data = Data<blas::vector<T> >(numberOfBatches);
+	for(std::size_t b = 0; b != data.numberOfBatches(); ++b)
+		readBinary(in, data.batch(b));
+}
+
+/// \brief Saves the parameters of a model as a raw binary snapshot.
+///
+/// The snapshot stores the parameter vector in bulk. It restores the
+/// parameters of a model whose structure - layer sizes, input dimension
+/// and the like - has already been set up, exactly as the archive based
+/// read() of most models requires.
+inline void saveBinarySnapshot(IParameterizable const& model, std::ostream& out){
+	detail::writeSnapshotHeader(out, detail::SnapshotContentParameters, 1);
+	writeBinary(out, model.parameterVector());
+	if(!out)
+		throw SHARKEXCEPTION("[saveBinarySnapshot] error while writing the snapshot");
+}
+
+/// \brief Restores the parameters of a model from a raw binary snapshot.
+///
+/// \param model  model to restore; its structure must match the stored parameters
+/// \param in     stream positioned at the start of a snapshot
+inline void loadBinarySnapshot(IParameterizable& model, std::istream& in){
+	detail::readSnapshotHeader(in, detail::SnapshotContentParameters);
+	RealVector parameters;
+	readBinary(in, parameters);
+	if(parameters.size() != model.numberOfParameters())
+		throw SHARKEXCEPTION("[loadBinarySnapshot] snapshot stores a different number of parameters");
+	model.setParameterVector(parameters);
+}
+
+/// \brief Saves a dataset of dense vectors as a raw binary snapshot.
+template<class T>
+void saveBinarySnapshot(Data<blas::vector<T> > const& data, std::ostream& out){
+	detail::writeSnapshotHeader(out, detail::SnapshotContentData, 1);
+	writeBinary(out, data);
+	if(!out)
+		throw SHARKEXCEPTION("[saveBinarySnapshot] error while writing the snapshot");
+}
+
+/// \brief Restores a dataset of dense vectors from a raw binary snapshot.
+template<class T>
+void loadBinarySnapshot(Data<blas::vector<T> >& data, std::istream& in){
+	detail::readSnapshotHeader(in, detail::SnapshotContentData);
+	readBinary(in, data);
+}
+
+/** @}*/
+
+}
+#endif
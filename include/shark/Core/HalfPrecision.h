@@ -0,0 +1,170 @@
+/*!
+ *
+ *
+ * \brief       16-bit floating point storage type.
+ *
+ * \par
+ * Provides a half precision (IEEE 754 binary16) value type which is
+ * intended purely as a compact storage format. All arithmetic is carried
+ * out after conversion to float or double; only the stored representation
+ * is 16 bits wide.
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_CORE_HALFPRECISION_H
+#define SHARK_CORE_HALFPRECISION_H
+
+#include <boost/cstdint.hpp>
+#include <cstring>
+
+namespace shark {
+
+namespace detail{
+
+/// \brief Converts a single precision value to its nearest binary16 representation.
+///
+/// Rounding is to nearest, ties to even. Overflowing values are mapped to
+/// infinity, values below the subnormal range are flushed to (signed) zero.
+inline boost::uint16_t floatToHalf(float value){
+	boost::uint32_t f;
+	std::memcpy(&f, &value, sizeof(f));
+	boost::uint16_t sign = boost::uint16_t((f >> 16) & 0x8000);
+	boost::int32_t exponent = boost::int32_t((f >> 23) & 0xff) - 127 + 15;
+	boost::uint32_t mantissa = f & 0x007fffff;
+
+	//NaN and infinity
+	if(((f >> 23) & 0xff) == 0xff){
+		return boost::uint16_t(sign | 0x7c00 | (mantissa? 0x0200 : 0));
+	}
+	//overflow to infinity
+	if(exponent >= 0x1f){
+		return boost::uint16_t(sign | 0x7c00);
+	}
+	//subnormal half or underflow to zero
+	if(exponent <= 0){
+		if(exponent < -10)
+			return sign;
+		mantissa |= 0x00800000;//make the implicit leading bit explicit
+		boost::uint32_t shift = 14 - exponent;
+		boost::uint32_t rounded = (mantissa >> shift)
+			+ ((mantissa >> (shift - 1)) & 1
+			& ((mantissa & ((1u << (shift - 1)) - 1)) != 0 | (mantissa >> shift) & 1));
+		return boost::uint16_t(sign | rounded);
+	}
+	//normalized half, round to nearest even
+	boost::uint32_t rounded = (mantissa >> 13)
+		+ ((mantissa >> 12) & 1 & (((mantissa & 0x0fff) != 0) | (mantissa >> 13) & 1));
+	return boost::uint16_t(sign + (boost::uint32_t(exponent) << 10) + rounded);//carry may bump the exponent
+}
+
+/// \brief Converts a binary16 bit pattern back to single precision.
+inline float halfToFloat(boost::uint16_t value){
+	boost::uint32_t sign = boost::uint32_t(value & 0x8000) << 16;
+	boost::uint32_t exponent = (value >> 10) & 0x1f;
+	boost::uint32_t mantissa = value & 0x03ff;
+	boost::uint32_t f;
+	if(exponent == 0x1f){//NaN and infinity
+		f = sign | 0x7f800000 | (mantissa << 13);
+	}
+	else if(exponent == 0){
+		if(mantissa == 0){
+			f = sign;
+		}
+		else{//subnormal: renormalize
+			exponent = 127 - 15 + 1;
+			while((mantissa & 0x0400) == 0){
+				mantissa <<= 1;
+				--exponent;
+			}
+			mantissa &= 0x03ff;
+			f = sign | (exponent << 23) | (mantissa << 13);
+		}
+	}
+	else{
+		f = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+	}
+	float result;
+	std::memcpy(&result, &f, sizeof(result));
+	return result;
+}
+
+}
+
+/// \brief Half precision (16 bit) floating point storage type.
+///
+/// HalfFloat stores a value in the IEEE 754 binary16 format and converts
+/// implicitly from and to float. It is meant as a storage format for large,
+/// memory bound tables such as cached or precomputed kernel matrices: with
+/// roughly three decimal digits of precision and a range up to 65504 it can
+/// represent typical kernel values well while halving the memory footprint
+/// compared to float. It is not meant as a computation type - all arithmetic
+/// happens in single or double precision after conversion, so accumulations
+/// retain their usual accuracy.
+class HalfFloat{
+public:
+	HalfFloat():m_bits(0){}
+	HalfFloat(float value):m_bits(detail::floatToHalf(value)){}
+	HalfFloat(double value):m_bits(detail::floatToHalf(float(value))){}
+	HalfFloat(int value):m_bits(detail::floatToHalf(float(value))){}
+	HalfFloat(unsigned int value):m_bits(detail::floatToHalf(float(value))){}
+	HalfFloat(std::size_t value):m_bits(detail::floatToHalf(float(value))){}
+
+	operator float()const{
+		return detail::halfToFloat(m_bits);
+	}
+
+	HalfFloat& operator+=(float rhs){
+		m_bits = detail::floatToHalf(float(*this) + rhs);
+		return *this;
+	}
+	HalfFloat& operator-=(float rhs){
+		m_bits = detail::floatToHalf(float(*this) - rhs);
+		return *this;
+	}
+	HalfFloat& operator*=(float rhs){
+		m_bits = detail::floatToHalf(float(*this) * rhs);
+		return *this;
+	}
+	HalfFloat& operator/=(float rhs){
+		m_bits = detail::floatToHalf(float(*this) / rhs);
+		return *this;
+	}
+
+	/// \brief Returns the raw binary16 bit pattern, mainly for serialization.
+	boost::uint16_t bits()const{
+		return m_bits;
+	}
+
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int /*version*/){
+		ar & m_bits;
+	}
+private:
+	boost::uint16_t m_bits;
+};
+
+}
+#endif
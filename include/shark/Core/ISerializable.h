@@ -48,6 +48,8 @@
 	#include <boost/archive/polymorphic_oarchive.hpp>
 	#include <boost/archive/polymorphic_text_iarchive.hpp>
 	#include <boost/archive/polymorphic_text_oarchive.hpp>
+	#include <boost/archive/polymorphic_binary_iarchive.hpp>
+	#include <boost/archive/polymorphic_binary_oarchive.hpp>
 #endif
 namespace shark {
 	
@@ -60,25 +62,34 @@ namespace shark {
 	*/
 	typedef boost::archive::text_iarchive InArchive;
 	typedef boost::archive::text_iarchive TextInArchive;
-	
+	//the broken boost versions can not dispatch on the archive type,
+	//so the binary archives fall back to the text format
+	typedef boost::archive::text_iarchive BinaryInArchive;
+
 
 	/**
 	* \brief Type of an archive to write to.
 	*/
 	typedef boost::archive::text_oarchive OutArchive;
 	typedef boost::archive::text_oarchive TextOutArchive;
-#else	
+	typedef boost::archive::text_oarchive BinaryOutArchive;
+#else
 	/**
 	* \brief Type of an archive to read from.
 	*/
 	typedef boost::archive::polymorphic_iarchive InArchive;
 	typedef boost::archive::polymorphic_text_iarchive TextInArchive;
+	///\brief Archive reading the raw binary format written by BinaryOutArchive.
+	typedef boost::archive::polymorphic_binary_iarchive BinaryInArchive;
 
 	/**
 	* \brief Type of an archive to write to.
 	*/
 	typedef boost::archive::polymorphic_oarchive OutArchive;
 	typedef boost::archive::polymorphic_text_oarchive TextOutArchive;
+	///\brief Archive writing the raw binary format, which skips all text formatting
+	///and thus is a lot faster for large numeric state, e.g. checkpoints of a run.
+	typedef boost::archive::polymorphic_binary_oarchive BinaryOutArchive;
 #endif
     /**
      * \brief Abstracts serializing functionality.
@@ -42,6 +42,7 @@
 #include <boost/math/constants/constants.hpp>
 #include <boost/math/special_functions/sign.hpp>
 #include <boost/utility/enable_if.hpp>
+#include <algorithm>
 #include <limits>
 #include <cmath>
 #include <type_traits>
@@ -90,15 +91,13 @@ namespace shark {
 	///\brief Logistic function/logistic function.
 	///
 	///Calculates the sigmoid function 1/(1+exp(-x)). The type must be arithmetic. For example
-	///float,double,long double, int,... but no custom Type. 
+	///float,double,long double, int,... but no custom Type.
+	///
+	///The argument is clamped to the valid input range of exp, so the function
+	///saturates at 0 and 1 without data-dependent branches.
 	template<class T>
 	typename boost::enable_if<std::is_arithmetic<T>, T>::type sigmoid(T x){
-		if(x < minExpInput<T>()) {
-			return 1;
-		}
-		if(x > maxExpInput<T>()) {
-			return 0;
-		}
+		x = std::min(-minExpInput<T>(), std::max(minExpInput<T>(), x));
 		return 1. / (1.+ std::exp(-x));
 	}
 	
@@ -109,7 +108,7 @@ namespace shark {
 	///
 	///@param x the exponent
 	template<class T>
-	T safeExp(T x ){
+	typename boost::enable_if<std::is_arithmetic<T>, T>::type safeExp(T x ){
 		if(x > maxExpInput<T>()){
 			//std::cout<<"warning, x too high"<<std::endl;
 			return 0.9 * std::numeric_limits<long double>::max();
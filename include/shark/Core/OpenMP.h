@@ -34,6 +34,10 @@
 #define SHARK_CORE_OPENMP_H
 
 #include <shark/Core/Shark.h>
+#include <shark/Core/Exception.h>
+
+#include <cstddef>
+#include <vector>
 
 #ifdef SHARK_USE_OPENMP
 #include <omp.h>
@@ -43,14 +47,39 @@
 #define SHARK_PARALLEL_FOR __pragma(omp parallel for)\
 for
 
+#define SHARK_PARALLEL_FOR_DYNAMIC __pragma(omp parallel for schedule(dynamic,1))\
+for
+
 #define SHARK_CRITICAL_REGION __pragma(omp critical)
 
+#ifdef __INTEL_COMPILER
+#define SHARK_PARALLEL_TASKREGION __pragma(omp parallel) __pragma(omp single nowait)
+#define SHARK_TASK __pragma(omp task)
+#define SHARK_TASK_WAIT __pragma(omp taskwait)
+#else
+//Visual C++ only implements OpenMP 2.0 which does not support tasks
+#define SHARK_PARALLEL_TASKREGION
+#define SHARK_TASK
+#define SHARK_TASK_WAIT
+#endif
+
 #else
 #define SHARK_PARALLEL_FOR \
 _Pragma ( "omp parallel for" )\
 for
 
+#define SHARK_PARALLEL_FOR_DYNAMIC \
+_Pragma ( "omp parallel for schedule(dynamic,1)" )\
+for
+
 #define SHARK_CRITICAL_REGION _Pragma("omp critical (globalSharkLock)")
+
+#define SHARK_PARALLEL_TASKREGION \
+_Pragma ( "omp parallel" )\
+_Pragma ( "omp single nowait" )
+
+#define SHARK_TASK _Pragma ( "omp task" )
+#define SHARK_TASK_WAIT _Pragma ( "omp taskwait" )
 #endif
 
 #define SHARK_NUM_THREADS (std::size_t)(omp_in_parallel()?omp_get_num_threads():omp_get_max_threads())
@@ -58,9 +87,66 @@ for
 
 #else
 #define SHARK_PARALLEL_FOR for
+#define SHARK_PARALLEL_FOR_DYNAMIC for
 #define SHARK_CRITICAL_REGION
+#define SHARK_PARALLEL_TASKREGION
+#define SHARK_TASK
+#define SHARK_TASK_WAIT
 #define SHARK_NUM_THREADS (std::size_t)1
 #define SHARK_THREAD_NUM (std::size_t)0
 #endif
 
+namespace shark{
+
+/// \brief Sums a set of partial results in a fixed pairwise tree order.
+///
+/// The merge order depends only on the number of partials, never on the
+/// number of threads or the order in which they finish. Thus a parallel
+/// accumulation becomes bit-reproducible when every partial is produced by a
+/// fixed chunk of the work - for example one partial per batch of a parallel
+/// loop. Summing into per-thread accumulators does not have this property,
+/// because the assignment of iterations to threads changes with the thread
+/// count. The merge itself is parallelized over the pairs of every tree level.
+///
+/// The partials are consumed by the reduction; the result is returned as a
+/// reference to the first element, which the caller may move from or copy.
+template<class T>
+T& deterministicSum(std::vector<T>& partials){
+	SIZE_CHECK(!partials.empty());
+	for(std::size_t stride = 1; stride < partials.size(); stride *= 2){
+		long pairs = (long)((partials.size() - stride - 1)/(2*stride) + 1);
+		SHARK_PARALLEL_FOR(long i = 0; i < pairs; ++i){
+			partials[2*stride*i] += partials[2*stride*i + stride];
+		}
+	}
+	return partials[0];
+}
+
+/// \brief Sums a sequence of values using Kahan compensated summation.
+///
+/// A running compensation term captures the low-order bits lost by every
+/// addition and feeds them back into the next one, so the result is accurate
+/// to within a few ulps independent of the summation length. The loop is
+/// serial and traverses the sequence in order, making it deterministic; it is
+/// meant for combining scalar partials of parallel loops, where the sequence
+/// is short and the serial pass is cheap.
+template<class Iterator>
+double compensatedSum(Iterator begin, Iterator end){
+	double sum = 0.0;
+	double compensation = 0.0;
+	for(Iterator pos = begin; pos != end; ++pos){
+		double adjusted = *pos - compensation;
+		double corrected = sum + adjusted;
+		compensation = (corrected - sum) - adjusted;
+		sum = corrected;
+	}
+	return sum;
+}
+
+/// \brief Convenience overload summing a whole vector of doubles.
+inline double compensatedSum(std::vector<double> const& values){
+	return compensatedSum(values.begin(), values.end());
+}
+
+}
 #endif
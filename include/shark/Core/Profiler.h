@@ -0,0 +1,198 @@
+/*!
+ *
+ *
+ * \brief       Lightweight hot-path instrumentation, compiled away by default.
+ *
+ *
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_CORE_PROFILER_H
+#define SHARK_CORE_PROFILER_H
+
+#ifdef SHARK_PROFILE
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace shark{
+
+/// \brief Collects named counters and timers from the library's hot paths.
+///
+/// Instrumentation is placed in the code via the SHARK_PROFILE_COUNT and
+/// SHARK_PROFILE_SCOPE macros, which expand to nothing unless the library and
+/// the application are compiled with SHARK_PROFILE defined - release builds
+/// pay nothing. When enabled, every thread aggregates into its own storage so
+/// measuring adds no synchronisation to parallel regions; report() merges the
+/// per-thread numbers.
+///
+/// report() and clear() must not be called while other threads are still
+/// measuring - call them from serial code, e.g. after train() returned.
+class Profiler{
+public:
+	/// \brief Aggregated values of one named probe.
+	struct Metric{
+		unsigned long long count;///< number of events, or number of timed scopes
+		double seconds;///< total time spent in timed scopes, 0 for plain counters
+		Metric():count(0),seconds(0.0){}
+	};
+	typedef std::map<std::string, Metric> Report;
+
+	/// \brief Adds to the named counter of the calling thread.
+	static void count(char const* name, unsigned long long amount = 1){
+		localMetrics()[name].count += amount;
+	}
+
+	/// \brief Adds elapsed seconds to the named timer of the calling thread.
+	static void addSeconds(char const* name, double seconds){
+		Metric& metric = localMetrics()[name];
+		++metric.count;
+		metric.seconds += seconds;
+	}
+
+	/// \brief Returns all probes merged over all threads.
+	static Report report(){
+		std::lock_guard<std::mutex> lock(registryMutex());
+		Report merged = retired();
+		for(std::size_t i = 0; i != registry().size(); ++i){
+			mergeInto(merged,*registry()[i]);
+		}
+		return merged;
+	}
+
+	/// \brief Resets all probes of all threads.
+	static void clear(){
+		std::lock_guard<std::mutex> lock(registryMutex());
+		retired().clear();
+		for(std::size_t i = 0; i != registry().size(); ++i){
+			registry()[i]->clear();
+		}
+	}
+
+	/// \brief Returns the merged probes as an aligned, human readable table.
+	static std::string reportString(){
+		Report merged = report();
+		std::size_t nameWidth = 4;
+		for(Report::const_iterator pos = merged.begin(); pos != merged.end(); ++pos){
+			nameWidth = std::max(nameWidth,pos->first.size());
+		}
+		std::ostringstream stream;
+		stream<<std::left<<std::setw(nameWidth)<<"name"
+			<<std::right<<std::setw(16)<<"count"<<std::setw(16)<<"seconds"<<'\n';
+		stream<<std::setprecision(6)<<std::fixed;
+		for(Report::const_iterator pos = merged.begin(); pos != merged.end(); ++pos){
+			stream<<std::left<<std::setw(nameWidth)<<pos->first
+				<<std::right<<std::setw(16)<<pos->second.count
+				<<std::setw(16)<<pos->second.seconds<<'\n';
+		}
+		return stream.str();
+	}
+
+	/// \brief Adds the time between construction and destruction to the named timer.
+	class ScopedTimer{
+	public:
+		explicit ScopedTimer(char const* name)
+		: m_name(name), m_start(std::chrono::steady_clock::now()){}
+		~ScopedTimer(){
+			std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_start;
+			addSeconds(m_name,elapsed.count());
+		}
+	private:
+		ScopedTimer(ScopedTimer const&);
+		ScopedTimer& operator=(ScopedTimer const&);
+
+		char const* m_name;
+		std::chrono::steady_clock::time_point m_start;
+	};
+
+private:
+	/// registers the thread's storage on creation, moves it to the
+	/// retired metrics when the thread ends
+	struct ThreadMetrics{
+		Report metrics;
+		ThreadMetrics(){
+			std::lock_guard<std::mutex> lock(registryMutex());
+			registry().push_back(&metrics);
+		}
+		~ThreadMetrics(){
+			std::lock_guard<std::mutex> lock(registryMutex());
+			mergeInto(retired(),metrics);
+			std::vector<Report*>& reports = registry();
+			reports.erase(std::find(reports.begin(),reports.end(),&metrics));
+		}
+	};
+
+	static Report& localMetrics(){
+		thread_local ThreadMetrics threadMetrics;
+		return threadMetrics.metrics;
+	}
+	static std::mutex& registryMutex(){
+		static std::mutex mutex;
+		return mutex;
+	}
+	static std::vector<Report*>& registry(){
+		static std::vector<Report*> reports;
+		return reports;
+	}
+	static Report& retired(){
+		static Report report;
+		return report;
+	}
+	static void mergeInto(Report& target, Report const& source){
+		for(Report::const_iterator pos = source.begin(); pos != source.end(); ++pos){
+			Metric& metric = target[pos->first];
+			metric.count += pos->second.count;
+			metric.seconds += pos->second.seconds;
+		}
+	}
+};
+
+}
+
+#define SHARK_PROFILE_JOIN_IMPL(a,b) a##b
+#define SHARK_PROFILE_JOIN(a,b) SHARK_PROFILE_JOIN_IMPL(a,b)
+
+/// \brief Increments the named profiler counter by one.
+#define SHARK_PROFILE_COUNT(name) shark::Profiler::count(name)
+/// \brief Increments the named profiler counter by the given amount.
+#define SHARK_PROFILE_COUNT_N(name, amount) shark::Profiler::count(name, amount)
+/// \brief Adds the runtime of the enclosing scope to the named profiler timer.
+#define SHARK_PROFILE_SCOPE(name)\
+	shark::Profiler::ScopedTimer SHARK_PROFILE_JOIN(sharkProfileScope_,__LINE__)(name)
+
+#else
+
+#define SHARK_PROFILE_COUNT(name)
+#define SHARK_PROFILE_COUNT_N(name, amount)
+#define SHARK_PROFILE_SCOPE(name)
+
+#endif
+#endif
@@ -0,0 +1,165 @@
+/*!
+ *
+ *
+ * \brief       Composable task parallelism on top of the OpenMP thread team.
+ *
+ *
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_CORE_THREADPOOL_H
+#define SHARK_CORE_THREADPOOL_H
+
+#include <shark/Core/OpenMP.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace shark{
+
+/// \brief Scoped group of tasks executed by the ThreadPool.
+///
+/// Tasks spawned through a TaskGroup are queued to the thread team and may be
+/// picked up by any idle worker; wait() blocks until all tasks of the group
+/// have finished and is called automatically by the destructor. Task groups
+/// nest: a task may itself open a TaskGroup and spawn subtasks, which are
+/// scheduled on the same team instead of creating new threads.
+class TaskGroup{
+public:
+	TaskGroup(){}
+
+	/// \brief Queues a task for execution by the thread team.
+	///
+	/// The function object is copied, so it must not reference locals that die
+	/// before wait(). Outside of a ThreadPool::run region, or when tasks are
+	/// not available, the task is executed immediately in the calling thread.
+	template<class Function>
+	void spawn(Function task){
+		SHARK_TASK
+		{task();}
+	}
+
+	/// \brief Waits until all tasks spawned by this group have finished.
+	void wait(){
+		SHARK_TASK_WAIT
+	}
+
+	~TaskGroup(){
+		wait();
+	}
+private:
+	TaskGroup(TaskGroup const&);
+	TaskGroup& operator=(TaskGroup const&);
+};
+
+/// \brief Entry point for composable task parallelism with a bounded thread count.
+///
+/// SHARK_PARALLEL_FOR only offers flat parallel loops: when a parallel
+/// algorithm calls another parallel algorithm, the inner loops either
+/// serialize or, with nested OpenMP enabled, oversubscribe the machine.
+/// ThreadPool::run instead executes its argument inside the task scheduler of
+/// the single OpenMP thread team: the caller spawns tasks through TaskGroup,
+/// idle workers steal queued tasks, and nested run() calls detect the
+/// existing team and simply execute inline, so composing parallel trainers,
+/// objective functions and optimizers never exceeds the team size.
+///
+/// Typical usage:
+/// \code
+/// ThreadPool::run([&]{
+///     TaskGroup tasks;
+///     for(std::size_t i = 0; i != folds; ++i){
+///         tasks.spawn([&,i]{ trainFold(i); });//may itself spawn subtasks
+///     }
+/// });//all tasks finished here
+/// \endcode
+class ThreadPool{
+public:
+	/// \brief Number of threads executing tasks.
+	static std::size_t numThreads(){
+		return SHARK_NUM_THREADS;
+	}
+
+	/// \brief Returns true if the worker threads are pinned to places.
+	///
+	/// Pinning is controlled by the OpenMP runtime, typically via the
+	/// environment variables OMP_PROC_BIND and OMP_PLACES. On NUMA
+	/// machines pinning should be enabled (e.g. OMP_PROC_BIND=spread),
+	/// otherwise threads migrate between nodes and the first-touch
+	/// placement of Data batches loses its effect. Callers like
+	/// benchmarks can query this to warn about unpinned runs.
+	static bool threadsPinned(){
+#if defined(SHARK_USE_OPENMP) && defined(_OPENMP) && _OPENMP >= 201307
+		return omp_get_proc_bind() != omp_proc_bind_false;
+#else
+		return false;
+#endif
+	}
+
+	/// \brief Executes the function inside the thread team.
+	///
+	/// If the calling thread is already part of a parallel region - be it a
+	/// surrounding run() or a SHARK_PARALLEL_FOR - the function is executed
+	/// directly in the calling thread and its tasks join the existing team.
+	template<class Function>
+	static void run(Function const& function){
+#ifdef SHARK_USE_OPENMP
+		if(omp_in_parallel()){
+			function();
+			return;
+		}
+		SHARK_PARALLEL_TASKREGION
+		{function();}
+#else
+		function();
+#endif
+	}
+
+	/// \brief Applies the function to all indices in [start,end) using tasks.
+	///
+	/// The range is split into chunks which are executed as stealable tasks,
+	/// so unevenly expensive iterations balance over the team. Unlike
+	/// SHARK_PARALLEL_FOR this may be called from inside other tasks or
+	/// parallel regions without oversubscribing.
+	template<class Function>
+	static void forEach(std::size_t start, std::size_t end, Function const& function){
+		if(start >= end) return;
+		//split into a few chunks per thread so that uneven tasks can balance
+		std::size_t chunk = std::max<std::size_t>(1,(end-start)/(4*numThreads()));
+		run([&]{
+			TaskGroup tasks;
+			for(std::size_t i = start; i < end; i += chunk){
+				std::size_t chunkEnd = std::min(end,i+chunk);
+				tasks.spawn([&function,i,chunkEnd]{
+					for(std::size_t j = i; j != chunkEnd; ++j){
+						function(j);
+					}
+				});
+			}
+		});
+	}
+};
+
+}
+#endif
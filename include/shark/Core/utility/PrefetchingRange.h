@@ -0,0 +1,205 @@
+/*!
+ *
+ *
+ * \brief       Range adaptor prefetching batches on a background thread.
+ *
+ *
+ * \par
+ * Trainers walk the batches of a dataset synchronously. When the batches
+ * come from slow storage - an out-of-core container or a memory mapped
+ * file whose pages still reside on disk - the gradient computation stalls
+ * on I/O. The adaptor in this file decouples the two: a background thread
+ * loads the upcoming batches into a bounded queue while the consumer
+ * processes the current one, so disk latency overlaps with computation.
+ *
+ *
+ * \author      O. Krause
+ * \date        2016
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_CORE_UTILITY_PREFETCHINGRANGE_H
+#define SHARK_CORE_UTILITY_PREFETCHINGRANGE_H
+
+#include <shark/Core/Exception.h>
+
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace shark{
+
+/// \brief Single-pass range over the batches of a container, loaded ahead of time by a background thread.
+///
+/// The range visits the batches of its source in order. A background thread
+/// calls source.batch(i) for the upcoming indices and stores the results in a
+/// queue holding at most \em depth batches; dereferencing the range iterator
+/// only pops the queue. The source works for everything offering
+/// numberOfBatches() and batch(i), e.g. Data<T>, OutOfCoreData<T> and
+/// MappedBinaryData<T>.
+///
+/// The range is single-pass: begin() may only be called once and the
+/// iterators are input iterators. While the range is alive the source is
+/// accessed from the background thread and must not be used concurrently.
+/// Exceptions thrown while loading a batch are rethrown to the consumer.
+///
+/// Typical use overlapping disk reads with the gradient computation:
+/// \code
+/// PrefetchingRange<OutOfCoreData<RealVector> > range(spilled, 4);
+/// for(RealMatrix const& batch: range){ ... }
+/// \endcode
+template<class Source>
+class PrefetchingRange{
+public:
+	typedef typename std::decay<
+		decltype(std::declval<Source&>().batch(0))
+	>::type batch_type;
+
+	/// \brief Input iterator popping prefetched batches from the queue.
+	class iterator: public std::iterator<std::input_iterator_tag, batch_type>{
+	public:
+		iterator(): m_range(nullptr), m_index(0){}
+		iterator(PrefetchingRange* range, std::size_t index)
+		: m_range(range), m_index(index){
+			if(m_index != m_range->m_numberOfBatches)
+				m_batch = m_range->pop();
+		}
+
+		batch_type const& operator*()const{
+			return m_batch;
+		}
+		batch_type const* operator->()const{
+			return &m_batch;
+		}
+		iterator& operator++(){
+			++m_index;
+			if(m_index != m_range->m_numberOfBatches)
+				m_batch = m_range->pop();
+			return *this;
+		}
+		bool operator==(iterator const& other)const{
+			return m_index == other.m_index;
+		}
+		bool operator!=(iterator const& other)const{
+			return m_index != other.m_index;
+		}
+	private:
+		PrefetchingRange* m_range;
+		std::size_t m_index;
+		batch_type m_batch;
+	};
+
+	/// \brief Starts prefetching the batches of the source.
+	///
+	/// \param source  The container whose batches are visited; must outlive the range
+	/// \param depth   Maximum number of batches loaded ahead of the consumer
+	PrefetchingRange(Source& source, std::size_t depth = 2)
+	: m_source(&source)
+	, m_numberOfBatches(source.numberOfBatches())
+	, m_depth(depth)
+	, m_stop(false)
+	, m_begun(false){
+		SIZE_CHECK(depth > 0);
+		m_worker = std::thread(&PrefetchingRange::produce, this);
+	}
+	PrefetchingRange(PrefetchingRange const&) = delete;
+	PrefetchingRange& operator=(PrefetchingRange const&) = delete;
+	~PrefetchingRange(){
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_spaceAvailable.notify_all();
+		m_worker.join();
+	}
+
+	/// \brief Returns the number of batches of the range.
+	std::size_t numberOfBatches()const{
+		return m_numberOfBatches;
+	}
+
+	iterator begin(){
+		if(m_begun)
+			throw SHARKEXCEPTION("[PrefetchingRange] the range may only be traversed once");
+		m_begun = true;
+		return iterator(this, 0);
+	}
+	iterator end(){
+		return iterator(this, m_numberOfBatches);
+	}
+
+private:
+	//loads the batches in order, blocking while the queue is full
+	void produce(){
+		for(std::size_t i = 0; i != m_numberOfBatches; ++i){
+			batch_type batch;
+			try{
+				batch = m_source->batch(i);
+			}catch(...){
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_error = std::current_exception();
+				m_batchAvailable.notify_all();
+				return;
+			}
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_spaceAvailable.wait(lock, [this](){
+				return m_stop || m_queue.size() < m_depth;
+			});
+			if(m_stop) return;
+			m_queue.push_back(std::move(batch));
+			m_batchAvailable.notify_all();
+		}
+	}
+
+	//removes the oldest prefetched batch, blocking while the queue is empty
+	batch_type pop(){
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_batchAvailable.wait(lock, [this](){
+			return m_error || !m_queue.empty();
+		});
+		if(m_queue.empty() && m_error)
+			std::rethrow_exception(m_error);
+		batch_type batch = std::move(m_queue.front());
+		m_queue.pop_front();
+		m_spaceAvailable.notify_all();
+		return batch;
+	}
+
+	Source* m_source;
+	std::size_t m_numberOfBatches;
+	std::size_t m_depth;
+	std::mutex m_mutex;
+	std::condition_variable m_batchAvailable;
+	std::condition_variable m_spaceAvailable;
+	std::deque<batch_type> m_queue;
+	std::exception_ptr m_error;
+	bool m_stop;
+	bool m_begun;
+	std::thread m_worker;
+};
+
+}
+#endif
@@ -0,0 +1,288 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Support for a native binary dataset format with memory-mapped, zero-copy loading
+ *
+ *
+ * \par
+ * This file provides a simple binary container format for dense vector
+ * datasets. In contrast to the text based CSV and libSVM importers, the
+ * loader can memory-map the file and expose the stored batches as matrix
+ * views directly over the mapping. Opening a file therefore takes constant
+ * time regardless of its size, pages are only read when the corresponding
+ * batches are accessed, and several processes opening the same file share
+ * the underlying physical memory read-only.
+ *
+ * \par
+ * The format is a small fixed header followed by all values in row-major
+ * order, stored in native byte order. It is a machine-local exchange and
+ * caching format, not an archival one.
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2016
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_DATA_BINARYDATA_H
+#define SHARK_DATA_BINARYDATA_H
+
+#include <shark/Data/Dataset.h>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define SHARK_BINARYDATA_USE_MMAP
+#endif
+
+namespace shark {
+
+/**
+ * \ingroup shark_globals
+ *
+ * @{
+ */
+
+namespace detail {
+
+//layout of the fixed file header. The payload starts at payloadOffset so
+//that the mapped values are cacheline aligned (mappings are page aligned).
+struct BinaryDataHeader{
+	char magic[8];
+	std::uint64_t version;
+	std::uint64_t valueTypeCode;
+	std::uint64_t numberOfElements;
+	std::uint64_t dimension;
+	std::uint64_t payloadOffset;
+};
+
+inline char const* binaryDataMagic(){
+	return "SHRKDATA";
+}
+
+template<class T> struct BinaryDataValueCode;
+template<> struct BinaryDataValueCode<double>{ static const std::uint64_t value = 1; };
+template<> struct BinaryDataValueCode<float>{ static const std::uint64_t value = 2; };
+
+///\brief Read-only mapping of a whole file, memory mapped when the platform supports it.
+class BinaryDataMapping{
+public:
+	explicit BinaryDataMapping(std::string const& fn): m_data(0), m_size(0), m_mapped(false){
+#ifdef SHARK_BINARYDATA_USE_MMAP
+		int fd = ::open(fn.c_str(), O_RDONLY);
+		if(fd == -1)
+			throw std::invalid_argument("[importBinaryData] Stream cannot be opened for reading.");
+		struct stat info;
+		if(::fstat(fd, &info) == 0 && info.st_size > 0){
+			void* memory = ::mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(memory != MAP_FAILED){
+				m_data = static_cast<char const*>(memory);
+				m_size = info.st_size;
+				m_mapped = true;
+			}
+		}
+		::close(fd);
+		if(m_mapped) return;
+#endif
+		std::ifstream stream(fn.c_str(), std::ios::binary);
+		if(!stream)
+			throw std::invalid_argument("[importBinaryData] Stream cannot be opened for reading.");
+		m_buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		m_data = m_buffer.data();
+		m_size = m_buffer.size();
+	}
+	BinaryDataMapping(BinaryDataMapping const&) = delete;
+	BinaryDataMapping& operator=(BinaryDataMapping const&) = delete;
+	~BinaryDataMapping(){
+#ifdef SHARK_BINARYDATA_USE_MMAP
+		if(m_mapped)
+			::munmap(const_cast<char*>(m_data), m_size);
+#endif
+	}
+
+	char const* data()const{ return m_data; }
+	std::size_t size()const{ return m_size; }
+private:
+	char const* m_data;
+	std::size_t m_size;
+	bool m_mapped;
+	std::string m_buffer;
+};
+
+}
+
+/// \brief Memory-mapped view of a dataset stored in the binary format.
+///
+/// The file is mapped read-only on construction and its batches are exposed
+/// as matrix proxies directly over the mapping - nothing is copied, so even
+/// a file far larger than physical memory opens instantly and only the pages
+/// of the batches that are actually accessed get read from disk. The views
+/// can be used everywhere a constant dense matrix batch is accepted, e.g. as
+/// arguments to batchEval or as training batches of streaming algorithms.
+/// The object must outlive all views obtained from it.
+template<class T>
+class MappedBinaryData{
+public:
+	typedef blas::dense_matrix_adaptor<T const> const_batch_reference;
+
+	/// \brief Opens a file in the binary dataset format.
+	///
+	/// \param fn                The file to be mapped
+	/// \param maximumBatchSize  Size of the batch views, defaults to the dataset default
+	explicit MappedBinaryData(
+		std::string const& fn,
+		std::size_t maximumBatchSize = Data<blas::vector<T> >::DefaultBatchSize
+	): m_mapping(fn){
+		detail::BinaryDataHeader header;
+		if(m_mapping.size() < sizeof(header))
+			throw SHARKEXCEPTION("[importBinaryData] file too small to be a binary dataset");
+		std::memcpy(&header, m_mapping.data(), sizeof(header));
+		if(std::memcmp(header.magic, detail::binaryDataMagic(), sizeof(header.magic)) != 0)
+			throw SHARKEXCEPTION("[importBinaryData] file is not in the binary dataset format");
+		if(header.version != 1)
+			throw SHARKEXCEPTION("[importBinaryData] unsupported version of the binary dataset format");
+		if(header.valueTypeCode != detail::BinaryDataValueCode<T>::value)
+			throw SHARKEXCEPTION("[importBinaryData] file stores a different value type");
+		m_numberOfElements = header.numberOfElements;
+		m_dimension = header.dimension;
+		if(m_mapping.size() < header.payloadOffset + m_numberOfElements * m_dimension * sizeof(T))
+			throw SHARKEXCEPTION("[importBinaryData] file is truncated");
+		m_values = reinterpret_cast<T const*>(m_mapping.data() + header.payloadOffset);
+		if(m_numberOfElements)//empty file leads to a view without batches
+			m_batchSizes = detail::optimalBatchSizes(m_numberOfElements, maximumBatchSize);
+		m_batchStarts.resize(m_batchSizes.size());
+		std::size_t start = 0;
+		for(std::size_t b = 0; b != m_batchSizes.size(); ++b){
+			m_batchStarts[b] = start;
+			start += m_batchSizes[b];
+		}
+	}
+
+	/// \brief Returns the total number of stored vectors.
+	std::size_t numberOfElements()const{
+		return m_numberOfElements;
+	}
+	/// \brief Returns the dimensionality of the stored vectors.
+	std::size_t dimension()const{
+		return m_dimension;
+	}
+	/// \brief Returns the number of batch views.
+	std::size_t numberOfBatches()const{
+		return m_batchSizes.size();
+	}
+	/// \brief Returns the i-th batch as a matrix view over the mapping.
+	const_batch_reference batch(std::size_t i)const{
+		RANGE_CHECK(i < numberOfBatches());
+		return const_batch_reference(
+			m_values + m_batchStarts[i] * m_dimension,
+			m_batchSizes[i], m_dimension
+		);
+	}
+	/// \brief Returns the i-th stored vector as a vector view over the mapping.
+	blas::dense_vector_adaptor<T const> element(std::size_t i)const{
+		RANGE_CHECK(i < numberOfElements());
+		return blas::dense_vector_adaptor<T const>(m_values + i * m_dimension, m_dimension);
+	}
+
+private:
+	detail::BinaryDataMapping m_mapping;
+	T const* m_values;
+	std::size_t m_numberOfElements;
+	std::size_t m_dimension;
+	std::vector<std::size_t> m_batchSizes;
+	std::vector<std::size_t> m_batchStarts;
+};
+
+/// \brief Export a Dataset of dense vectors to the binary format.
+///
+/// \param  data  Container to be exported, all elements must have the same dimension
+/// \param  fn    The file to be written to
+template<class T>
+void exportBinaryData(Data<blas::vector<T> > const& data, std::string fn){
+	std::ofstream out(fn.c_str(), std::ios::binary);
+	if(!out)
+		throw std::invalid_argument("[exportBinaryData] Stream cannot be opened for writing.");
+
+	detail::BinaryDataHeader header;
+	std::memcpy(header.magic, detail::binaryDataMagic(), sizeof(header.magic));
+	header.version = 1;
+	header.valueTypeCode = detail::BinaryDataValueCode<T>::value;
+	header.numberOfElements = data.numberOfElements();
+	header.dimension = data.numberOfElements()? dataDimension(data): 0;
+	header.payloadOffset = 64;
+	static_assert(sizeof(header) <= 64, "binary dataset header must fit the payload offset");
+	out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+	for(std::size_t pad = sizeof(header); pad != header.payloadOffset; ++pad)
+		out.put(0);
+
+	//batches of a dense Data are stored row-major and contiguously
+	for(std::size_t b = 0; b != data.numberOfBatches(); ++b){
+		blas::matrix<T> const& batch = data.batch(b);
+		SIZE_CHECK(batch.size2() == header.dimension);
+		out.write(
+			reinterpret_cast<char const*>(batch.raw_storage().values),
+			batch.size1() * batch.size2() * sizeof(T)
+		);
+	}
+	if(!out)
+		throw SHARKEXCEPTION("[exportBinaryData] error while writing the file");
+}
+
+/// \brief Import a Dataset of dense vectors from a file in the binary format.
+///
+/// The batches of the returned dataset own their memory. For a zero-copy
+/// view of the file use MappedBinaryData directly.
+///
+/// \param  data              Container storing the loaded data
+/// \param  fn                The file to be read from
+/// \param  maximumBatchSize  Size of batches in the dataset
+template<class T>
+void importBinaryData(
+	Data<blas::vector<T> >& data,
+	std::string fn,
+	std::size_t maximumBatchSize = Data<blas::vector<T> >::DefaultBatchSize
+){
+	MappedBinaryData<T> file(fn, maximumBatchSize);
+	data = Data<blas::vector<T> >(file.numberOfBatches());
+	for(std::size_t b = 0; b != file.numberOfBatches(); ++b){
+		typename MappedBinaryData<T>::const_batch_reference view = file.batch(b);
+		data.batch(b).resize(view.size1(), view.size2());
+		noalias(data.batch(b)) = view;
+	}
+}
+
+/** @}*/
+
+} // namespace shark
+#endif // SHARK_DATA_BINARYDATA_H
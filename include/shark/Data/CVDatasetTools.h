@@ -141,6 +141,78 @@ private:
 };
 
 
+/// \brief Cross-validation folds represented as element index subsets of an unchanged dataset.
+///
+/// In contrast to CVFolds, which requires the dataset to be physically
+/// repartitioned so that every fold is a contiguous range of batches, the
+/// view based folds leave the dataset untouched. Every fold is only a set
+/// of element indices into a DataView of the dataset; training(i) and
+/// validation(i) return views sharing the original batches, so creating
+/// ten folds of a huge dataset costs ten index vectors instead of ten
+/// near-full copies. When a trainer needs the packed batch format, gather
+/// the fold on demand via toDataset() or process it with subBatch().
+template<class DatasetTypeT>
+class CVViewFolds {
+public:
+	typedef DatasetTypeT DatasetType;
+	typedef DataView<DatasetType const> ViewType;
+
+	/// \brief Creates an empty set of folds.
+	CVViewFolds() {}
+	///\brief Partitions the view into the validation folds indicated by the second argument.
+	///
+	/// The folds are given as element indices into the view
+	CVViewFolds(
+		ViewType const& view,
+		std::vector<std::vector<std::size_t> > const& validationIndizes
+	) : m_view(view), m_validationFolds(validationIndizes) {}
+
+	///\brief Returns the training part of the i-th fold as a view on the dataset.
+	ViewType training(std::size_t i) const {
+		SIZE_CHECK(i < size());
+		return subset(m_view, trainingFoldIndices(i));
+	}
+	///\brief Returns the validation part of the i-th fold as a view on the dataset.
+	ViewType validation(std::size_t i) const {
+		SIZE_CHECK(i < size());
+		return subset(m_view, m_validationFolds[i]);
+	}
+
+	///\brief returns the element indices that make up the i-th validation fold
+	std::vector<std::size_t> const& validationFoldIndices(std::size_t i)const {
+		SIZE_CHECK(i < size());
+		return m_validationFolds[i];
+	}
+
+	///\brief returns the element indices that make up the training part of the i-th fold
+	std::vector<std::size_t> trainingFoldIndices(std::size_t i)const {
+		SIZE_CHECK(i < size());
+		std::vector<std::size_t> trainingFold;
+		detail::complement(m_validationFolds[i], m_view.size(), trainingFold);
+		return trainingFold;
+	}
+
+	///\brief Returns the number of folds of the dataset.
+	std::size_t size()const {
+		return m_validationFolds.size();
+	}
+
+	/// \brief Returns the view underlying the folds
+	ViewType const& view()const{
+		return m_view;
+	}
+
+	/// \brief Returns the dataset underlying the folds
+	DatasetType const& dataset()const{
+		return m_view.dataset();
+	}
+
+private:
+	ViewType m_view;
+	std::vector<std::vector<std::size_t> > m_validationFolds;
+};
+
+
 /// auxiliary typedef for createCVSameSizeBalanced and createCVFullyIndexed, stores location index in the first and partition index in the second
 typedef std::pair< std::vector<std::size_t> , std::vector<std::size_t> > RecreationIndices;
 
@@ -235,6 +307,38 @@ CVFolds<LabeledData<I,L> > createCVSameSizeBalanced(
 	return CVFolds<LabeledData<I,L> >(set,partitionStart);
 
 }
+
+///\brief Version of createCVViewSameSizeBalanced working on prebuilt per-class index lists
+///
+/// members[c][i] is the position of the i-th member of class c in the set. The members
+/// of every class are shuffled and dealt out to the partitions in turn.
+template<class I,class L>
+CVViewFolds<LabeledData<I,L> > createCVViewSameSizeBalanced(
+	LabeledData<I,L> const& set,
+	std::size_t numberOfPartitions,
+	std::vector< std::vector<std::size_t> >& members
+){
+	//shuffle elements in members
+	DiscreteUniform< Rng::rng_type > uni(shark::Rng::globalRng);
+	for (std::size_t c = 0; c != members.size(); c++) {
+		std::random_shuffle(members[c].begin(), members[c].end(), uni);
+	}
+
+	//deal the elements of every class out to the partitions in turn
+	std::vector<std::vector<std::size_t> > folds(numberOfPartitions);
+	std::size_t fold = 0;
+	for (std::size_t c = 0; c != members.size(); c++) {
+		for (std::size_t i = 0; i != members[c].size(); i++) {
+			folds[fold].push_back(members[c][i]);
+			fold = (fold+1) % numberOfPartitions;
+		}
+	}
+	//keep the elements of every fold in dataset order
+	for (std::size_t f = 0; f != numberOfPartitions; f++) {
+		std::sort(folds[f].begin(), folds[f].end());
+	}
+	return CVViewFolds<LabeledData<I,L> >(DataView<LabeledData<I,L> const>(set),folds);
+}
 }//namespace detail
 
 /**
@@ -489,6 +593,184 @@ CVFolds<LabeledData<I,L> > createCVFullyIndexed(
 }
 
 
+//! \brief Create view based folds for cross validation from validation fold indices
+//!
+//! The indices vector states for each element of what validation partition it
+//! should become a member. The dataset itself is neither copied nor changed;
+//! the folds are index subsets of a view of it.
+//!
+//! \param set partitions will be view subsets of this set
+//! \param numberOfPartitions  number of partitions to create
+//! \param indices             partition indices of the examples in [0, ..., numberOfPartitions[.
+template<class I,class L>
+CVViewFolds<LabeledData<I,L> > createCVViewIndexed(
+	LabeledData<I,L> const& set,
+	std::size_t numberOfPartitions,
+	std::vector<std::size_t> const& indices
+) {
+	std::size_t numInputs = set.numberOfElements();
+	SIZE_CHECK(indices.size() == numInputs);
+	SIZE_CHECK(numberOfPartitions == *std::max_element(indices.begin(),indices.end())+1);
+
+	std::vector<std::vector<std::size_t> > folds(numberOfPartitions);
+	for (std::size_t input = 0; input != numInputs; input++) {
+		folds[indices[input]].push_back(input);
+	}
+	return CVViewFolds<LabeledData<I,L> >(DataView<LabeledData<I,L> const>(set),folds);
+}
+
+//! \brief Create view based folds for cross validation
+//!
+//! The subset each training example belongs to is drawn independently and
+//! uniformly distributed. The dataset itself is neither copied nor changed.
+//!
+//! \param set the input data for which the new partitions are created
+//! \param numberOfPartitions  number of partitions to create
+template<class I,class L>
+CVViewFolds<LabeledData<I,L> > createCVViewIID(
+	LabeledData<I,L> const& set,
+	std::size_t numberOfPartitions
+) {
+	std::vector<std::size_t> indices(set.numberOfElements());
+	for (std::size_t i=0; i != set.numberOfElements(); i++)
+		indices[i] = Rng::discrete(0, numberOfPartitions - 1);
+	return createCVViewIndexed(set,numberOfPartitions,indices);
+}
+
+//! \brief Create view based folds for cross validation
+//!
+//! Every subset contains (approximately) the same number of elements,
+//! drawn at random. The dataset itself is neither copied nor changed.
+//!
+//! \param set the input data from which to draw the partitions
+//! \param numberOfPartitions  number of partitions to create
+template<class I,class L>
+CVViewFolds<LabeledData<I,L> > createCVViewSameSize(
+	LabeledData<I,L> const& set,
+	std::size_t numberOfPartitions
+) {
+	std::size_t numInputs = set.numberOfElements();
+	std::vector<std::size_t> elements(numInputs);
+	std::iota(elements.begin(),elements.end(),0);
+	DiscreteUniform< Rng::rng_type > uni(shark::Rng::globalRng);
+	shark::shuffle(elements.begin(),elements.end(), uni);
+
+	//deal the shuffled elements out to the partitions
+	std::vector<std::size_t> indices(numInputs);
+	for (std::size_t i=0; i != numInputs; i++)
+		indices[elements[i]] = i % numberOfPartitions;
+	return createCVViewIndexed(set,numberOfPartitions,indices);
+}
+
+//! \brief Create view based folds for cross validation with balanced class proportions
+//!
+//! Every subset contains (approximately) the same number of elements and
+//! (approximately) the same fraction of every class. The dataset itself
+//! is neither copied nor changed.
+//!
+//! \param set the input data from which to draw the partitions
+//! \param numberOfPartitions  number of partitions to create
+template<class I>
+CVViewFolds<LabeledData<I,unsigned int> > createCVViewSameSizeBalanced(
+	LabeledData<I,unsigned int> const& set,
+	std::size_t numberOfPartitions
+){
+	DataView<LabeledData<I,unsigned int> const> setView(set);
+	std::size_t numInputs = setView.size();
+	std::size_t numClasses = numberOfClasses(set);
+
+	//find members of each class
+	std::vector< std::vector<std::size_t> > members(numClasses);
+	for (std::size_t i = 0; i != numInputs; i++) {
+		members[setView[i].label].push_back(i);
+	}
+	return detail::createCVViewSameSizeBalanced(set,numberOfPartitions,members);
+}
+
+//! \brief Create view based folds for cross validation from a persistent class index
+//!
+//! Version of createCVViewSameSizeBalanced which obtains the members of every
+//! class from the batch lists stored in a ClassBatchIndex instead of scanning
+//! the labels. Only the batch sizes are read; the dataset itself is neither
+//! copied nor changed.
+//!
+//! \param index a class index of the dataset from which to draw the partitions
+//! \param numberOfPartitions  number of partitions to create
+template<class I>
+CVViewFolds<LabeledData<I,unsigned int> > createCVViewSameSizeBalanced(
+	ClassBatchIndex<I> const& index,
+	std::size_t numberOfPartitions
+){
+	LabeledData<I,unsigned int> const& set = index.dataset();
+
+	//flat element offset of every batch
+	std::vector<std::size_t> batchStart(set.numberOfBatches() + 1, 0);
+	for (std::size_t b = 0; b != set.numberOfBatches(); b++)
+		batchStart[b+1] = batchStart[b] + boost::size(set.batch(b));
+
+	//enumerate the elements of every class from its stored batch indices
+	std::vector< std::vector<std::size_t> > members(index.numberOfClasses());
+	for (unsigned int c = 0; c != index.numberOfClasses(); c++) {
+		members[c].reserve(index.classSize(c));
+		std::vector<std::size_t> const& batches = index.batchesOfClass(c);
+		for (std::size_t b = 0; b != batches.size(); b++) {
+			std::size_t start = batchStart[batches[b]];
+			std::size_t end = batchStart[batches[b]+1];
+			for (std::size_t i = start; i != end; i++) members[c].push_back(i);
+		}
+	}
+	return detail::createCVViewSameSizeBalanced(set,numberOfPartitions,members);
+}
+
+//! \brief Split the dataset into a stratified training and validation view
+//!
+//! A single pass over the labels builds the index list of every class; the
+//! members of every class are then shuffled and the requested fraction of
+//! each class is drawn into the validation part, so both parts preserve the
+//! class proportions of the dataset. Unlike shuffling followed by
+//! splitAtElement, the dataset is neither copied nor changed; the result
+//! holds the training view in the first and the validation view in the
+//! second component, each in dataset order.
+//!
+//! \param set the input data to be split
+//! \param validationFraction  fraction of every class assigned to the validation part, in [0, 1]
+template<class I>
+std::pair<
+	DataView<LabeledData<I,unsigned int> const>,
+	DataView<LabeledData<I,unsigned int> const>
+> splitViewStratified(
+	LabeledData<I,unsigned int> const& set,
+	double validationFraction
+){
+	SHARK_CHECK(validationFraction >= 0.0 && validationFraction <= 1.0,
+		"[shark::splitViewStratified] validationFraction must be a fraction in [0, 1]");
+	DataView<LabeledData<I,unsigned int> const> setView(set);
+	std::size_t numInputs = setView.size();
+
+	//single pass over the labels builds the index list of every class
+	std::vector< std::vector<std::size_t> > members;
+	for (std::size_t i = 0; i != numInputs; i++) {
+		unsigned int c = setView[i].label;
+		if (c >= members.size()) members.resize(c + 1);
+		members[c].push_back(i);
+	}
+
+	//draw the validation share of every class, the rest is training
+	DiscreteUniform< Rng::rng_type > uni(shark::Rng::globalRng);
+	std::vector<std::size_t> training;
+	std::vector<std::size_t> validation;
+	for (std::size_t c = 0; c != members.size(); c++) {
+		std::size_t n = members[c].size();
+		std::size_t nv = std::min(n, (std::size_t)(validationFraction * n + 0.5));
+		std::random_shuffle(members[c].begin(), members[c].end(), uni);
+		validation.insert(validation.end(), members[c].begin(), members[c].begin() + nv);
+		training.insert(training.end(), members[c].begin() + nv, members[c].end());
+	}
+	std::sort(training.begin(), training.end());
+	std::sort(validation.begin(), validation.end());
+	return std::make_pair(subset(setView, training), subset(setView, validation));
+}
+
 // much more to come...
 
 /** @}*/
@@ -43,7 +43,9 @@
 #define SHARK_DATA_CSV_H
 
 #include <shark/Core/DLLSupport.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Data/Dataset.h>
+#include <shark/Models/AbstractModel.h>
 
 #include <fstream>
 #include <string>
@@ -363,6 +365,48 @@ SHARK_EXPORT_SYMBOL void csvStringToData(
 
 
 
+/// \brief Import unlabeled vectors directly from a csv file using the parallel reader.
+///
+/// The file is memory mapped when the platform supports it, split at line
+/// boundaries into one chunk per thread and parsed with a fast numeric
+/// scanner, so that loading large dense files is limited by disk bandwidth
+/// rather than parsing speed. Files the fast scanner cannot handle are
+/// transparently re-parsed with the general grammar.
+///
+/// \param  data       Container storing the loaded data
+/// \param  fn         The file to be read from
+/// \param  separator  Optional separator between entries, typically a comma, spaces ar automatically ignored
+/// \param  comment    Trailing character indicating comment line. By dfault it is '#'
+/// \param  maximumBatchSize   Size of batches in the dataset
+/// \param  titleLines   Specifies a number of lines to be skipped in the beginning of the file
+SHARK_EXPORT_SYMBOL void csvFileToData(
+	Data<RealVector>& data,
+	std::string const& fn,
+	char separator = ',',
+	char comment = '#',
+	std::size_t maximumBatchSize = Data<RealVector>::DefaultBatchSize,
+	std::size_t titleLines = 0
+);
+
+/// \brief Import unlabeled vectors directly from a csv file using the parallel reader.
+///
+/// See the RealVector overload for a description of the parallel reader.
+///
+/// \param  data       Container storing the loaded data
+/// \param  fn         The file to be read from
+/// \param  separator  Optional separator between entries, typically a comma, spaces ar automatically ignored
+/// \param  comment    Trailing character indicating comment line. By dfault it is '#'
+/// \param  maximumBatchSize   Size of batches in the dataset
+/// \param  titleLines   Specifies a number of lines to be skipped in the beginning of the file
+SHARK_EXPORT_SYMBOL void csvFileToData(
+	Data<FloatVector>& data,
+	std::string const& fn,
+	char separator = ',',
+	char comment = '#',
+	std::size_t maximumBatchSize = Data<FloatVector>::DefaultBatchSize,
+	std::size_t titleLines = 0
+);
+
 /// \brief Import a Dataset from a csv file
 ///
 /// \param  data       Container storing the loaded data
@@ -370,7 +414,7 @@ SHARK_EXPORT_SYMBOL void csvStringToData(
 /// \param  separator  Optional separator between entries, typically a comma, spaces ar automatically ignored
 /// \param  comment    Trailing character indicating comment line. By dfault it is '#'
 /// \param  maximumBatchSize   Size of batches in the dataset
-/// \param  titleLines   Specifies a number of lines to be skipped in the beginning of the file 
+/// \param  titleLines   Specifies a number of lines to be skipped in the beginning of the file
 template<class T>
 void importCSV(
 	Data<T>& data,
@@ -397,6 +441,34 @@ void importCSV(
 	csvStringToData(data,contents,separator,comment,maximumBatchSize);
 }
 
+/// \brief Import a Dataset of real vectors from a csv file.
+///
+/// Dense vector data is read with the parallel reader, see csvFileToData.
+inline void importCSV(
+	Data<RealVector>& data,
+	std::string fn,
+	char separator = ',',
+	char comment = '#',
+	std::size_t maximumBatchSize = Data<RealVector>::DefaultBatchSize,
+	std::size_t titleLines = 0
+){
+	csvFileToData(data,fn,separator,comment,maximumBatchSize,titleLines);
+}
+
+/// \brief Import a Dataset of float vectors from a csv file.
+///
+/// Dense vector data is read with the parallel reader, see csvFileToData.
+inline void importCSV(
+	Data<FloatVector>& data,
+	std::string fn,
+	char separator = ',',
+	char comment = '#',
+	std::size_t maximumBatchSize = Data<FloatVector>::DefaultBatchSize,
+	std::size_t titleLines = 0
+){
+	csvFileToData(data,fn,separator,comment,maximumBatchSize,titleLines);
+}
+
 /// \brief Import a labeled Dataset from a csv file
 ///
 /// \param  data       Container storing the loaded data
@@ -459,6 +531,68 @@ void importCSV(
 	csvStringToData(data,contents,lp, numberOfOutputs, separator,comment,maximumBatchSize);
 }
 
+/// \brief Import a Dataset from a csv file and apply a preprocessing model to it.
+///
+/// The model - typically a Normalizer or LinearModel trained on an earlier
+/// dataset - is applied to the batches in place right after parsing. Compared
+/// to importing first and calling transform() afterwards this does not
+/// materialize a second, untransformed copy of the dataset.
+///
+/// \param  data          Container storing the loaded data
+/// \param  fn            The file to be read from
+/// \param  preprocessor  Model applied to every batch after parsing
+/// \param  separator     Optional separator between entries, typically a comma, spaces ar automatically ignored
+/// \param  comment       Trailing character indicating comment line. By dfault it is '#'
+/// \param  maximumBatchSize   Size of batches in the dataset
+/// \param  titleLines    Specifies a number of lines to be skipped in the beginning of the file
+template<class T>
+void importCSV(
+	Data<T>& data,
+	std::string fn,
+	AbstractModel<T, T> const& preprocessor,
+	char separator = ',',
+	char comment = '#',
+	std::size_t maximumBatchSize = Data<T>::DefaultBatchSize,
+	std::size_t titleLines = 0
+){
+	importCSV(data,fn,separator,comment,maximumBatchSize,titleLines);
+	SHARK_PARALLEL_FOR(int i = 0; i < (int)data.numberOfBatches(); ++i){
+		typename Batch<T>::type transformed;
+		preprocessor.eval(data.batch(i),transformed);
+		data.batch(i) = transformed;
+	}
+}
+
+/// \brief Import a labeled Dataset from a csv file and apply a preprocessing model to the inputs.
+///
+/// The model is applied to the input batches in place right after parsing,
+/// see the unlabeled overload for details. Labels are not transformed.
+///
+/// \param  data          Container storing the loaded data
+/// \param  fn            The file to be read from
+/// \param  preprocessor  Model applied to every input batch after parsing
+/// \param  lp            Position of the label in the record, either first or last column
+/// \param  separator     Optional separator between entries, typically a comma, spaces ar automatically ignored
+/// \param  comment       Trailing character indicating comment line. By dfault it is '#'
+/// \param  maximumBatchSize   Size of batches in the dataset
+template<class T>
+void importCSV(
+	LabeledData<blas::vector<T>, unsigned int>& data,
+	std::string fn,
+	AbstractModel<blas::vector<T>, blas::vector<T> > const& preprocessor,
+	LabelPosition lp,
+	char separator = ',',
+	char comment = '#',
+	std::size_t maximumBatchSize = LabeledData<RealVector, unsigned int>::DefaultBatchSize
+){
+	importCSV(data,fn,lp,separator,comment,maximumBatchSize);
+	SHARK_PARALLEL_FOR(int i = 0; i < (int)data.numberOfBatches(); ++i){
+		typename Batch<blas::vector<T> >::type transformed;
+		preprocessor.eval(data.batch(i).input,transformed);
+		data.batch(i).input = transformed;
+	}
+}
+
 /// \brief Format unlabeled data into a character-separated value file.
 ///
 /// \param  set       Container to be exported
@@ -40,6 +40,7 @@
 
 #include <shark/Data/Dataset.h>
 #include <shark/Core/utility/functional.h>
+#include <algorithm>
 #include <numeric>
 namespace shark {
 /// \brief Constant time Element-Lookup for Datasets
@@ -194,6 +195,16 @@ public:
 		return m_indices.size();
 	}
 
+	/// \brief Randomly permutes the order in which the elements are seen through the view.
+	///
+	/// Only the index table of the view is shuffled, the underlying dataset
+	/// is not touched. This makes the per-epoch reshuffle of a training loop
+	/// a pass over the indices instead of a pass over the data.
+	void shuffle(){
+		DiscreteUniform<Rng::rng_type> uni(Rng::globalRng);
+		shark::shuffle(m_indices.begin(),m_indices.end(),uni);
+	}
+
 	iterator begin(){
 		return iterator(*this, 0);
 	}
@@ -244,20 +255,63 @@ DataView<DatasetType> randomSubset(DataView<DatasetType> const& view, std::size_
 	return subset(view,boost::make_iterator_range(indices.begin(),indices.begin()+size));
 }
 
+/// \brief Creates a packed batch from a set of indices using a fused gather
+///
+/// Instead of resolving every element independently, the requested indices
+/// are sorted by the batch they live in, so that every batch of the dataset
+/// is visited at most once and its rows are read in ascending order. The
+/// elements appear in the created batch in the order given by indizes.
+///
+/// \param view the view from which the batch is to be created
+/// \param indizes the set of indizes defining the batch
+template<class DatasetType,class IndexRange>
+typename DataView<DatasetType>::batch_type gatherBatch(
+	DataView<DatasetType> const& view,
+	IndexRange const& indizes
+){
+	SIZE_CHECK(shark::size(indizes) != 0);
+	std::size_t numElements = shark::size(indizes);
+
+	//translate the element indices into batch coordinates, remembering
+	//for every element the position it takes in the created batch
+	struct Coordinate{
+		std::size_t batch;
+		std::size_t positionInBatch;
+		std::size_t positionInResult;
+	};
+	std::vector<Coordinate> coordinates(numElements);
+	for(std::size_t i = 0; i != numElements; ++i){
+		coordinates[i].batch = view.batch(indizes[i]);
+		coordinates[i].positionInBatch = view.positionInBatch(indizes[i]);
+		coordinates[i].positionInResult = i;
+	}
+	std::sort(coordinates.begin(),coordinates.end(),
+		[](Coordinate const& lhs, Coordinate const& rhs){
+			if(lhs.batch != rhs.batch) return lhs.batch < rhs.batch;
+			return lhs.positionInBatch < rhs.positionInBatch;
+		}
+	);
+
+	//gather the elements batch by batch into the packed result
+	typedef typename DataView<DatasetType>::batch_type batch_type;
+	batch_type result = Batch<typename DatasetType::element_type>::createBatch(view[indizes[0]],numElements);
+	for(std::size_t i = 0; i != numElements; ++i){
+		Coordinate const& c = coordinates[i];
+		get(result,c.positionInResult) = get(view.dataset().batch(c.batch),c.positionInBatch);
+	}
+	return result;
+}
+
 /// \brief Creates a batch given a set of indices
 ///
 /// \param view the view from which the batch is to be created
 /// \param indizes the set of indizes defining the batch
 template<class DatasetType,class IndexRange>
 typename DataView<DatasetType>::batch_type subBatch(
-	DataView<DatasetType> const& view, 
+	DataView<DatasetType> const& view,
 	IndexRange const& indizes
 ){
-	//create a subset of the view containing the elements of the batch
-	DataView<DatasetType> batchElems = subset(view,indizes);
-	
-	//and now use the batch range construction to create it
-	return Batch<typename DatasetType::element_type>::createBatch(batchElems);
+	return gatherBatch(view,indizes);
 }
 
 /// \brief Creates a random batch of a given size
@@ -424,9 +424,16 @@ public:
 	}
 
 	///\brief shuffles all elements in the entire dataset (that is, also across the batches)
+	///
+	/// The elements are swapped inside the existing batch storage,
+	/// no batch is reallocated.
 	virtual void shuffle(){
 		DiscreteUniform<Rng::rng_type> uni(Rng::globalRng);
-		shark::shuffle(this->elements().begin(),this->elements().end(), uni);
+		std::vector<std::size_t> permutation(this->numberOfElements());
+		for(std::size_t i = 0; i != permutation.size(); ++i)
+			permutation[i] = i;
+		shark::shuffle(permutation.begin(),permutation.end(), uni);
+		permuteElementsInPlace(*this,permutation);
 	}
 };
 
@@ -633,9 +640,16 @@ public:
 	}
 
 	///\brief shuffles all elements in the entire dataset (that is, also across the batches)
+	///
+	/// Inputs and labels are reordered by the same permutation, swapping
+	/// the elements inside the existing batch storage of both containers.
 	virtual void shuffle(){
 		DiscreteUniform<Rng::rng_type> uni(Rng::globalRng);
-		shark::shuffle(this->elements().begin(),this->elements().end(), uni);
+		std::vector<std::size_t> permutation(numberOfElements());
+		for(std::size_t i = 0; i != permutation.size(); ++i)
+			permutation[i] = i;
+		shark::shuffle(permutation.begin(),permutation.end(), uni);
+		permuteElementsInPlace(*this,permutation);
 	}
 
 	void splitBatch(std::size_t batch, std::size_t elementIndex){
@@ -760,15 +774,16 @@ createDataFromRange(Range const& inputs, std::size_t maximumBatchSize = 0){
 	std::size_t remainder = numPoints-batches*optimalBatchSize;
 	Data<Input> data(batches);
 
-	//now create the batches taking the remainder into account
-	Iterator start= boost::begin(inputs);
-	for(std::size_t i = 0; i != batches; ++i){
-		std::size_t size = (i<remainder)?optimalBatchSize+1:optimalBatchSize;
-		Iterator end = start+size;
+	//now create the batches taking the remainder into account. the start of
+	//every batch is computed directly from its index, so the batches can be
+	//packed in parallel - each thread copies a contiguous slice of the range
+	Iterator begin = boost::begin(inputs);
+	SHARK_PARALLEL_FOR(int i = 0; i < (int)batches; ++i){
+		std::size_t size = (i < (int)remainder)? optimalBatchSize+1 : optimalBatchSize;
+		Iterator start = begin + i*optimalBatchSize + std::min<std::size_t>(i,remainder);
 		data.batch(i) = createBatch<Input>(
-			boost::make_iterator_range(start,end)
+			boost::make_iterator_range(start,start+size)
 		);
-		start = end;
 	}
 
 	return data;
@@ -949,6 +964,53 @@ LabeledData<RealVector,T> selectInputFeatures(LabeledData<RealVector,T> const& d
 
 
 
+/// \brief Reorders the elements of a dataset in place according to a permutation.
+///
+/// The element at position i is moved to position permutation[i]. In contrast
+/// to rebuilding the dataset element by element this only swaps elements
+/// inside the existing batch storage, so no batch is reallocated and the
+/// batch structure - number, order and sizes of the batches - is unchanged.
+///
+/// \param data         the dataset to be reordered
+/// \param permutation  target position for every element; must be a permutation of 0,...,n-1
+template<class T>
+void permuteElementsInPlace(Data<T>& data, std::vector<std::size_t> permutation){
+	SIZE_CHECK(permutation.size() == data.numberOfElements());
+
+	//start of every batch, so that an element index can be located in its batch
+	std::vector<std::size_t> batchStart(data.numberOfBatches() + 1, 0);
+	for(std::size_t b = 0; b != data.numberOfBatches(); ++b)
+		batchStart[b + 1] = batchStart[b] + boost::size(data.batch(b));
+
+	//walk the cycles of the permutation, swapping elements into place
+	for(std::size_t i = 0; i != permutation.size(); ++i){
+		while(permutation[i] != i){
+			std::size_t j = permutation[i];
+			std::size_t batchI = std::upper_bound(batchStart.begin(), batchStart.end(), i) - batchStart.begin() - 1;
+			std::size_t batchJ = std::upper_bound(batchStart.begin(), batchStart.end(), j) - batchStart.begin() - 1;
+			using std::swap;
+			swap(
+				get(data.batch(batchI), i - batchStart[batchI]),
+				get(data.batch(batchJ), j - batchStart[batchJ])
+			);
+			std::swap(permutation[i], permutation[j]);
+		}
+	}
+}
+
+/// \brief Reorders the elements of a labeled dataset in place according to a permutation.
+///
+/// The same permutation is applied to the inputs and the labels, swapping
+/// elements inside the existing batch storage of both containers.
+///
+/// \param data         the dataset to be reordered
+/// \param permutation  target position for every element; must be a permutation of 0,...,n-1
+template<class I, class L>
+void permuteElementsInPlace(LabeledData<I,L>& data, std::vector<std::size_t> const& permutation){
+	permuteElementsInPlace(data.inputs(), permutation);
+	permuteElementsInPlace(data.labels(), permutation);
+}
+
 /// \brief Removes the last part of a given dataset and returns a new split containing the removed elements
 ///
 /// For this operation, the dataset is not allowed to be shared.
@@ -1072,6 +1134,90 @@ LabeledData<I,unsigned int> binarySubProblem(
 	return transformLabels(indexedSubset(data,indexSet), detail::TransformOneVersusRestLabels(oneClass));
 }
 
+/// \brief Persistent index of the batches belonging to every class.
+///
+/// binarySubProblem scans all batches of the dataset on every call, which
+/// one-versus-one training repeats for every pair of classes. This index
+/// performs the scan once over a dataset whose batches each hold a single
+/// class (see repartitionByClass) and afterwards creates class subsets and
+/// binary subproblems directly from the stored batch indices. All subsets
+/// share the input batches of the indexed dataset, no elements are copied.
+template<class I>
+class ClassBatchIndex{
+public:
+	typedef LabeledData<I,unsigned int> DatasetType;
+
+	ClassBatchIndex(){}
+
+	/// \brief Builds the index; the batches of the dataset must be pure by class.
+	explicit ClassBatchIndex(DatasetType const& data)
+	: m_data(data){
+		for(std::size_t b = 0; b != data.numberOfBatches(); ++b){
+			typename Batch<unsigned int>::type const& labels = data.labels().batch(b);
+			unsigned int c = shark::get(labels, 0);
+			for(std::size_t e = 1; e != boost::size(labels); ++e){
+				SHARK_CHECK(shark::get(labels, e) == c,
+					"[ClassBatchIndex] batch contains several classes, apply repartitionByClass first");
+			}
+			if(c >= m_classBatches.size())
+				m_classBatches.resize(c + 1);
+			m_classBatches[c].push_back(b);
+			if(c >= m_classSizes.size())
+				m_classSizes.resize(c + 1, 0);
+			m_classSizes[c] += boost::size(labels);
+		}
+	}
+
+	/// \brief Returns the number of classes of the indexed dataset.
+	std::size_t numberOfClasses()const{
+		return m_classBatches.size();
+	}
+	/// \brief Returns the indexed dataset.
+	DatasetType const& dataset()const{
+		return m_data;
+	}
+	/// \brief Returns the indices of the batches holding elements of a class.
+	std::vector<std::size_t> const& batchesOfClass(unsigned int c)const{
+		RANGE_CHECK(c < m_classBatches.size());
+		return m_classBatches[c];
+	}
+	/// \brief Returns the number of elements of a class.
+	std::size_t classSize(unsigned int c)const{
+		RANGE_CHECK(c < m_classSizes.size());
+		return m_classSizes[c];
+	}
+
+	/// \brief Returns the subset of the dataset holding one class, sharing its batches.
+	DatasetType classSubset(unsigned int c)const{
+		SHARK_CHECK(c < m_classBatches.size() && !m_classBatches[c].empty(),
+			"[ClassBatchIndex::classSubset] class does not exist");
+		return indexedSubset(m_data, m_classBatches[c]);
+	}
+
+	/// \brief Creates the binary subproblem of a pair of classes without scanning the dataset.
+	///
+	/// As for the free binarySubProblem, the elements of zeroClass receive
+	/// label 0 and the elements of oneClass label 1; the input batches are
+	/// shared with the indexed dataset.
+	DatasetType binarySubProblem(unsigned int zeroClass, unsigned int oneClass)const{
+		std::size_t smaller = std::min(zeroClass, oneClass);
+		std::size_t bigger = std::max(zeroClass, oneClass);
+		SHARK_CHECK(smaller < m_classBatches.size() && !m_classBatches[smaller].empty(),
+			"[ClassBatchIndex::binarySubProblem] class does not exist");
+		SHARK_CHECK(bigger < m_classBatches.size() && !m_classBatches[bigger].empty(),
+			"[ClassBatchIndex::binarySubProblem] class does not exist");
+
+		std::vector<std::size_t> indexSet(m_classBatches[smaller]);
+		indexSet.insert(indexSet.end(), m_classBatches[bigger].begin(), m_classBatches[bigger].end());
+		return transformLabels(indexedSubset(m_data, indexSet), detail::TransformOneVersusRestLabels(oneClass));
+	}
+
+private:
+	DatasetType m_data;
+	std::vector<std::vector<std::size_t> > m_classBatches;//batches holding each class, in dataset order
+	std::vector<std::size_t> m_classSizes;//number of elements of each class
+};
+
 /// \brief Construct a binary (two-class) one-versus-rest problem from a multi-class problem.
 ///
 /// \par
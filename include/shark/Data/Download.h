@@ -64,15 +64,17 @@ namespace shark {
 /// \param  port          TCP/IP port, default is 80
 /// \param  highestIndex  highest feature index, or 0 for auto-detection
 /// \param  batchSize     size of batch
+/// \param  connections   number of parallel download connections, used if the server supports ranges
 SHARK_EXPORT_SYMBOL template <class InputType, class LabelType> void downloadSparseData(
 	LabeledData<InputType, LabelType>& dataset,
 	std::string const& url,
 	unsigned short port = 80,
 	unsigned int highestIndex = 0,
-	std::size_t batchSize = LabeledData<RealVector, unsigned int>::DefaultBatchSize
+	std::size_t batchSize = LabeledData<RealVector, unsigned int>::DefaultBatchSize,
+	std::size_t connections = 4
 )
 {
-	std::string content = download(url, port);
+	std::string content = downloadRanged(url, port, connections);
 	std::stringstream ss(content);
 	importSparseData(dataset, ss, highestIndex, batchSize);
 }
@@ -110,6 +112,7 @@ SHARK_EXPORT_SYMBOL template <class InputType, class LabelType> void downloadFro
 /// \param  comment       Trailing character indicating comment line. By dfault it is '#'
 /// \param  port          TCP/IP port, default is 80
 /// \param  maximumBatchSize   size of batches in the dataset
+/// \param  connections   number of parallel download connections, used if the server supports ranges
 SHARK_EXPORT_SYMBOL template <class InputType> void downloadCsvData(
 	LabeledData<InputType, unsigned int>& dataset,
 	std::string const& url,
@@ -117,10 +120,11 @@ SHARK_EXPORT_SYMBOL template <class InputType> void downloadCsvData(
 	char separator = ',',
 	char comment = '#',
 	unsigned short port = 80,
-	std::size_t maximumBatchSize = LabeledData<RealVector, RealVector>::DefaultBatchSize
+	std::size_t maximumBatchSize = LabeledData<RealVector, RealVector>::DefaultBatchSize,
+	std::size_t connections = 4
 )
 {
-	std::string content = download(url, port);
+	std::string content = downloadRanged(url, port, connections);
 	csvStringToData(dataset, content, lp, separator, comment, maximumBatchSize);
 }
 
@@ -135,6 +139,7 @@ SHARK_EXPORT_SYMBOL template <class InputType> void downloadCsvData(
 /// \param  comment       Trailing character indicating comment line. By dfault it is '#'
 /// \param  port          TCP/IP port, default is 80
 /// \param  maximumBatchSize   size of batches in the dataset
+/// \param  connections   number of parallel download connections, used if the server supports ranges
 SHARK_EXPORT_SYMBOL template <class InputType> void downloadCsvData(
 	LabeledData<InputType, RealVector>& dataset,
 	std::string const& url,
@@ -143,10 +148,11 @@ SHARK_EXPORT_SYMBOL template <class InputType> void downloadCsvData(
 	char separator = ',',
 	char comment = '#',
 	unsigned short port = 80,
-	std::size_t maximumBatchSize = LabeledData<RealVector, RealVector>::DefaultBatchSize
+	std::size_t maximumBatchSize = LabeledData<RealVector, RealVector>::DefaultBatchSize,
+	std::size_t connections = 4
 )
 {
-	std::string content = download(url, port);
+	std::string content = downloadRanged(url, port, connections);
 	csvStringToData(dataset, content, lp, numberOfOutputs, separator, comment, maximumBatchSize);
 }
 
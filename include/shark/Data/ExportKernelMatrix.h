@@ -38,9 +38,13 @@
 
 
 #include <fstream>
+#include <sstream>
+#include <vector>
+#include <shark/Core/OpenMP.h>
 #include <shark/Data/Dataset.h>
 #include <shark/Data/DataView.h>
 #include <shark/Models/Kernels/AbstractKernelFunction.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
 #include <shark/Models/Kernels/ScaledKernel.h>
 #include <shark/Algorithms/Trainers/NormalizeKernelUnitVariance.h>
 
@@ -64,105 +68,311 @@ enum KernelMatrixNormalizationType
 	CENTER_AND_MULTIPLICATIVE_TRACE_ONE // first center the kernel in featrue space. then devide each entry by the centered kernel's trace.
 };
 
-/// \brief Write a kernel Gram matrix to stream.
+namespace detail
+{
+
+/// \brief Gathers the data needed for the Gaussian matrix-product fast path.
 ///
-/// \param  dataset    data basis for the Gram matrix
-/// \param  kernel     pointer to kernel function to be used
-/// \param  out         The stream to be written to
-/// \param  normalizer what kind of normalization to apply. see enum declaration for details.
-/// \param  scientific        should the output be in scientific notation?
-/// \param  fieldwidth      field width for pretty printing
-template<typename InputType, typename LabelType>
-void exportKernelMatrix(
-	LabeledData<InputType, LabelType> const &dataset,
-	AbstractKernelFunction<InputType> &kernel,           // kernel function (can't be const b/c of ScaledKernel later)
-	std::ostream &out,                                     // The stream to be written to
-	KernelMatrixNormalizationType normalizer = NONE, // what kind of normalization to apply. see enum declaration for details.
-	bool scientific = false,                         // scientific notation?
-	unsigned int fieldwidth = 0                      // for pretty-printing
+/// For dense data and a Gaussian rbf kernel the points are collected into one
+/// dense matrix together with their squared norms, so that blocks of the Gram
+/// matrix can later be assembled from matrix-matrix products. Returns false
+/// for all other kernels, in which case nothing is written to the outputs.
+inline bool setupGaussianKernelRowBlocks(
+	AbstractKernelFunction<RealVector> const &kernel,
+	Data<RealVector> const &dataset,
+	RealMatrix &X,
+	RealVector &norms,
+	double &gamma
 )
 {
-	//get access to the range of elements
-	DataView<LabeledData<InputType, LabelType> const> points(dataset);
-	std::size_t size = points.size();
+	GaussianRbfKernel<RealVector> const *rbf
+	        = dynamic_cast<GaussianRbfKernel<RealVector> const *>(&kernel);
+	if(rbf == 0)
+		return false;
+
+	std::size_t n = dataset.numberOfElements();
+	std::size_t dim = dataDimension(dataset);
+	X.resize(n, dim);
+	std::size_t start = 0;
+	for(std::size_t b = 0; b != dataset.numberOfBatches(); ++b)
+	{
+		std::size_t batchSize = boost::size(dataset.batch(b));
+		noalias(rows(X, start, start + batchSize)) = dataset.batch(b);
+		start += batchSize;
+	}
+	norms.resize(n);
+	for(std::size_t i = 0; i != n; ++i)
+	{
+		norms(i) = norm_sqr(row(X, i));
+	}
+	gamma = rbf->gamma();
+	return true;
+}
 
-	SIZE_CHECK(size != 0);
-	// check outstream status
-	if(!out)
+/// \brief Fallback overload: no fast path for non-dense input types.
+template<class InputType>
+bool setupGaussianKernelRowBlocks(
+	AbstractKernelFunction<InputType> const &,
+	Data<InputType> const &,
+	RealMatrix &,
+	RealVector &,
+	double &
+)
+{
+	return false;
+}
+
+/// \brief Computes a kernel Gram matrix in horizontal stripes of bounded size.
+///
+/// The matrix is split into stripes of consecutive rows aligned to the batch
+/// structure of the dataset. A stripe is computed in parallel over the column
+/// batches, or from a single matrix-matrix product when the Gaussian fast
+/// path applies. Only one stripe needs to be held in memory at a time, which
+/// keeps the footprint bounded for arbitrarily large datasets.
+template<class InputType>
+class KernelMatrixRowBlock
+{
+public:
+	KernelMatrixRowBlock(
+		AbstractKernelFunction<InputType> const &kernel,
+		Data<InputType> const &dataset
+	)
+	: m_kernel(kernel)
+	, m_dataset(dataset)
 	{
-		throw(std::invalid_argument("[export_kernel_matrix] Can't write to stream."));
+		std::size_t B = dataset.numberOfBatches();
+		m_batchStart.resize(B + 1, 0);
+		for(std::size_t i = 1; i != B + 1; ++i)
+		{
+			m_batchStart[i] = m_batchStart[i - 1] + boost::size(dataset.batch(i - 1));
+		}
+		// group consecutive batches into stripes of roughly blockRows rows
+		std::size_t const blockRows = 256;
+		m_stripeBatch.push_back(0);
+		for(std::size_t i = 0; i != B; ++i)
+		{
+			if(m_batchStart[i + 1] - m_batchStart[m_stripeBatch.back()] >= blockRows)
+			{
+				m_stripeBatch.push_back(i + 1);
+			}
+		}
+		if(m_stripeBatch.back() != B)
+		{
+			m_stripeBatch.push_back(B);
+		}
+		m_gaussian = setupGaussianKernelRowBlocks(kernel, dataset, m_X, m_norms, m_gamma);
 	}
 
-	// COMPUTE MODIFIERS
+	/// total number of data points (rows and columns of the Gram matrix)
+	std::size_t size() const
+	{
+		return m_batchStart.back();
+	}
+	/// number of stripes
+	std::size_t blocks() const
+	{
+		return m_stripeBatch.size() - 1;
+	}
+	/// index of the first matrix row covered by stripe b
+	std::size_t blockFirstRow(std::size_t b) const
+	{
+		return m_batchStart[m_stripeBatch[b]];
+	}
 
-	// if multiplicative trace normalization: determine trace
-	double trace = 0.0;
-	double trace_factor = 1.0;
+	/// \brief Computes stripe b of the Gram matrix into tile.
+	///
+	/// The tile is resized to hold all rows of the stripe and all columns.
+	void compute(std::size_t b, RealMatrix &tile) const
+	{
+		std::size_t first = blockFirstRow(b);
+		std::size_t numRows = m_batchStart[m_stripeBatch[b + 1]] - first;
+		std::size_t n = size();
+		tile.resize(numRows, n);
+		if(m_gaussian)
+		{
+			noalias(tile) = -2 * prod(rows(m_X, first, first + numRows), trans(m_X));
+			for(std::size_t r = 0; r != numRows; ++r)
+			{
+				noalias(row(tile, r)) += blas::repeat(m_norms(first + r), n) + m_norms;
+			}
+			noalias(tile) = exp(-m_gamma * tile);
+			return;
+		}
+		for(std::size_t i = m_stripeBatch[b]; i != m_stripeBatch[b + 1]; ++i)
+		{
+			std::size_t startX = m_batchStart[i] - first;
+			std::size_t endX = m_batchStart[i + 1] - first;
+			SHARK_PARALLEL_FOR(int j = 0; j < (int)m_dataset.numberOfBatches(); j++)
+			{
+				std::size_t startY = m_batchStart[j];
+				std::size_t endY = m_batchStart[j + 1];
+				RealMatrix submatrix = m_kernel(m_dataset.batch(i), m_dataset.batch(j));
+				noalias(subrange(tile, startX, endX, startY, endY)) = submatrix;
+			}
+		}
+	}
+
+private:
+	AbstractKernelFunction<InputType> const &m_kernel;
+	Data<InputType> m_dataset;
+	std::vector<std::size_t> m_batchStart;
+	std::vector<std::size_t> m_stripeBatch;
+	bool m_gaussian;
+	double m_gamma;
+	RealMatrix m_X;
+	RealVector m_norms;
+};
+
+/// \brief Modifiers derived from the data for the various normalization modes.
+struct KernelMatrixNormalizationData
+{
+	KernelMatrixNormalizationData()
+	: traceFactor(1.0)
+	, varianceFactor(0.0)
+	, mean(0.0)
+	{}
+
+	double traceFactor;
+	double varianceFactor;
+	double mean;
+	RealVector rowmeans;
+};
+
+/// \brief Computes the modifiers required by the requested normalization.
+///
+/// The centering modes need the full matrix of row means, which is obtained
+/// by one pass over the Gram matrix in stripes; the other modes only touch
+/// the diagonal or delegate to NormalizeKernelUnitVariance.
+template<class InputType>
+void setupKernelMatrixNormalization(
+	AbstractKernelFunction<InputType> &kernel,
+	Data<InputType> const &dataset,
+	KernelMatrixRowBlock<InputType> const &blocks,
+	KernelMatrixNormalizationType normalizer,
+	KernelMatrixNormalizationData &norm
+)
+{
+	std::size_t size = blocks.size();
+	DataView<Data<InputType> const> points(dataset);
 	if(normalizer == MULTIPLICATIVE_TRACE_ONE || normalizer == MULTIPLICATIVE_TRACE_N)
 	{
-		for(auto point: points)
+		double trace = 0.0;
+		for(std::size_t i = 0; i < size; i++)
 		{
-			trace += kernel.eval(point.input, point.input);
+			trace += kernel.eval(points[i], points[i]);
 		}
 		SHARK_ASSERT(trace > 0);
-		trace_factor = 1.0 / trace;
+		norm.traceFactor = 1.0 / trace;
 		if(normalizer == MULTIPLICATIVE_TRACE_N)
 		{
-			trace_factor *= size;
+			norm.traceFactor *= size;
 		}
 	}
-
-	// if multiplicative variance normalization: determine factor
-	double variance_factor = 0.0;
-	if(normalizer == MULTIPLICATIVE_VARIANCE_ONE)
+	else if(normalizer == MULTIPLICATIVE_VARIANCE_ONE)
 	{
 		ScaledKernel<InputType> scaled(&kernel);
-		NormalizeKernelUnitVariance<InputType> normalizer;
-		normalizer.train(scaled, dataset.inputs());
-		variance_factor = scaled.factor();
+		NormalizeKernelUnitVariance<InputType> trainer;
+		trainer.train(scaled, dataset);
+		norm.varianceFactor = scaled.factor();
 	}
-
-	// if centering: determine matrix- and row-wise means;
-	double mean = 0;
-	RealVector rowmeans(size, 0.0);
-	if(normalizer == CENTER_ONLY || normalizer == CENTER_AND_MULTIPLICATIVE_TRACE_ONE)
+	else if(normalizer == CENTER_ONLY || normalizer == CENTER_AND_MULTIPLICATIVE_TRACE_ONE)
 	{
-		// initialization: calculate mean and rowmeans
-		for(std::size_t i = 0; i < size; i++)
+		norm.rowmeans.resize(size);
+		RealMatrix tile;
+		for(std::size_t b = 0; b != blocks.blocks(); ++b)
 		{
-			double k = kernel.eval(points[i].input, points[i].input);
-			mean += k; //add diagonal value to mean once
-			rowmeans(i) += k; //add diagonal to its rowmean
-			for(std::size_t j = 0; j < i; j++)
+			blocks.compute(b, tile);
+			std::size_t first = blocks.blockFirstRow(b);
+			for(std::size_t r = 0; r != tile.size1(); ++r)
 			{
-				double k = kernel.eval(points[i].input, points[j].input);
-				mean += 2.0 * k; //add off-diagonals to mean twice
-				rowmeans(i) += k; //add to mean of row
-				rowmeans(j) += k; //add to mean of transposed row
+				norm.rowmeans(first + r) = sum(row(tile, r));
 			}
 		}
-		mean = mean / (double) size / (double) size;
-		rowmeans /= size;
-		// get trace if necessary
+		norm.mean = sum(norm.rowmeans) / (double) size / (double) size;
+		norm.rowmeans /= size;
+		// get trace of the centered matrix if necessary
 		if(normalizer == CENTER_AND_MULTIPLICATIVE_TRACE_ONE)
 		{
-			trace = 0.0;
+			double trace = 0.0;
 			for(std::size_t i = 0; i < size; i++)
 			{
-				trace += kernel.eval(points[i].input, points[i].input) - 2 * rowmeans(i) + mean;
+				trace += kernel.eval(points[i], points[i]) - 2 * norm.rowmeans(i) + norm.mean;
 			}
 			SHARK_ASSERT(trace > 0);
-			trace_factor = 1.0 / trace;
+			norm.traceFactor = 1.0 / trace;
 		}
 	}
+	else if(normalizer != NONE)
+	{
+		throw SHARKEXCEPTION("[exportKernelMatrix] Unknown normalization type.");
+	}
+}
 
-	// FIX OUTPUT FORMAT
+/// \brief Applies the normalization to one stripe of the Gram matrix.
+inline void normalizeKernelMatrixBlock(
+	RealMatrix &tile,
+	std::size_t firstRow,
+	KernelMatrixNormalizationType normalizer,
+	KernelMatrixNormalizationData const &norm
+)
+{
+	if(normalizer == MULTIPLICATIVE_TRACE_ONE || normalizer == MULTIPLICATIVE_TRACE_N)
+	{
+		tile *= norm.traceFactor;
+	}
+	else if(normalizer == MULTIPLICATIVE_VARIANCE_ONE)
+	{
+		tile *= norm.varianceFactor;
+	}
+	else if(normalizer == CENTER_ONLY || normalizer == CENTER_AND_MULTIPLICATIVE_TRACE_ONE)
+	{
+		for(std::size_t r = 0; r != tile.size1(); ++r)
+		{
+			noalias(row(tile, r)) += blas::repeat(norm.mean - norm.rowmeans(firstRow + r), tile.size2()) - norm.rowmeans;
+		}
+		if(normalizer == CENTER_AND_MULTIPLICATIVE_TRACE_ONE)
+		{
+			tile *= norm.traceFactor;
+		}
+	}
+}
 
-	// set output format
-	if(scientific)
-		out.setf(std::ios_base::scientific);
-	std::streamsize ss = out.precision();
-	out.precision(10);
+} // namespace detail
+
+/// \brief Write a kernel Gram matrix to stream.
+///
+/// \param  dataset    data basis for the Gram matrix
+/// \param  kernel     pointer to kernel function to be used
+/// \param  out         The stream to be written to
+/// \param  normalizer what kind of normalization to apply. see enum declaration for details.
+/// \param  scientific        should the output be in scientific notation?
+/// \param  fieldwidth      field width for pretty printing
+template<typename InputType, typename LabelType>
+void exportKernelMatrix(
+	LabeledData<InputType, LabelType> const &dataset,
+	AbstractKernelFunction<InputType> &kernel,           // kernel function (can't be const b/c of ScaledKernel later)
+	std::ostream &out,                                     // The stream to be written to
+	KernelMatrixNormalizationType normalizer = NONE, // what kind of normalization to apply. see enum declaration for details.
+	bool scientific = false,                         // scientific notation?
+	unsigned int fieldwidth = 0                      // for pretty-printing
+)
+{
+	//get access to the range of elements
+	DataView<LabeledData<InputType, LabelType> const> points(dataset);
+	std::size_t size = points.size();
+
+	SIZE_CHECK(size != 0);
+	// check outstream status
+	if(!out)
+	{
+		throw(std::invalid_argument("[export_kernel_matrix] Can't write to stream."));
+	}
+
+	// COMPUTE MODIFIERS
+
+	detail::KernelMatrixRowBlock<InputType> blocks(kernel, dataset.inputs());
+	detail::KernelMatrixNormalizationData norm;
+	detail::setupKernelMatrixNormalization(kernel, dataset.inputs(), blocks, normalizer, norm);
 
 	// determine dataset type
 	double max_label = -1e100;
@@ -184,79 +394,53 @@ void exportKernelMatrix(
 	// WRITE OUT
 
 	// write to file:
-	// loop through examples (rows)
-	for(std::size_t i = 0; i < size; i++)
+	// loop through stripes of rows; each stripe is computed as one block,
+	// its rows are formatted in parallel and written with one sequential pass
+	RealMatrix tile;
+	std::vector<std::string> lines;
+	for(std::size_t b = 0; b != blocks.blocks(); ++b)
 	{
-
-		// write label
-		if(regression)
-		{
-			out << std::setw(fieldwidth) << std::left << points[i].label << " ";
-		}
-		else if(binary)
-		{
-			out << std::setw(fieldwidth) << std::left << (int)(points[i].label * 2 - 1) << " ";
-		}
-		else
-		{
-			out << std::setw(fieldwidth) << std::left << (unsigned int)(points[i].label + 1) << " ";
-		}
-
-		out << "0:" << std::setw(fieldwidth) << std::left << i + 1; //write index
-
-		// loop through examples (columns)
-		// CASE DISTINCTION:
-		if(normalizer == NONE)
-		{
-			for(std::size_t j = 0; j < size; j++)
-			{
-				out  << " " << j + 1 << ":" << std::setw(fieldwidth) << std::left << kernel.eval(points[i].input, points[j].input);
-			}
-			out << "\n";
-		}
-		else if(normalizer == MULTIPLICATIVE_TRACE_ONE || normalizer == MULTIPLICATIVE_TRACE_N)
+		blocks.compute(b, tile);
+		std::size_t first = blocks.blockFirstRow(b);
+		detail::normalizeKernelMatrixBlock(tile, first, normalizer, norm);
+		lines.resize(tile.size1());
+		SHARK_PARALLEL_FOR(int r = 0; r < (int)tile.size1(); r++)
 		{
-			for(std::size_t j = 0; j < size; j++)
+			std::size_t i = first + r;
+			std::ostringstream line;
+			if(scientific)
+				line.setf(std::ios_base::scientific);
+			line.precision(10);
+
+			// write label
+			if(regression)
 			{
-				out  << " " << j + 1 << ":" << std::setw(fieldwidth) << std::left << trace_factor * kernel.eval(points[i].input, points[j].input);
+				line << std::setw(fieldwidth) << std::left << points[i].label << " ";
 			}
-			out << "\n";
-		}
-		else if(normalizer == MULTIPLICATIVE_VARIANCE_ONE)
-		{
-			for(std::size_t j = 0; j < size; j++)
+			else if(binary)
 			{
-				out  << " " << j + 1 << ":" << std::setw(fieldwidth) << std::left <<  variance_factor *kernel.eval(points[i].input, points[j].input);
+				line << std::setw(fieldwidth) << std::left << (int)(points[i].label * 2 - 1) << " ";
 			}
-			out << "\n";
-		}
-		else if(normalizer == CENTER_ONLY)
-		{
-			for(std::size_t j = 0; j < size; j++)
+			else
 			{
-				double tmp = kernel.eval(points[i].input, points[j].input) - rowmeans(i) - rowmeans(j) + mean;
-				out  << " " << j + 1 << ":" << std::setw(fieldwidth) << std::left << tmp;
+				line << std::setw(fieldwidth) << std::left << (unsigned int)(points[i].label + 1) << " ";
 			}
-			out << "\n";
-		}
-		else if(normalizer == CENTER_AND_MULTIPLICATIVE_TRACE_ONE)
-		{
+
+			line << "0:" << std::setw(fieldwidth) << std::left << i + 1; //write index
+
+			// loop through examples (columns)
 			for(std::size_t j = 0; j < size; j++)
 			{
-				double tmp = kernel.eval(points[i].input, points[j].input) - rowmeans(i) - rowmeans(j) + mean;
-				out  << " " << j + 1 << ":" << std::setw(fieldwidth) << std::left << trace_factor *tmp;
+				line  << " " << j + 1 << ":" << std::setw(fieldwidth) << std::left << tile(r, j);
 			}
-			out << "\n";
+			line << "\n";
+			lines[r] = line.str();
 		}
-		else
+		for(std::size_t r = 0; r != lines.size(); ++r)
 		{
-			throw SHARKEXCEPTION("[detail::export_kernel_matrix] Unknown normalization type.");
+			out << lines[r];
 		}
-
 	}
-
-	// clean up
-	out.precision(ss);
 }
 
 
@@ -291,6 +475,107 @@ void exportKernelMatrix(
 
 
 
+/// \brief Write a kernel Gram matrix to stream as a dense binary matrix.
+///
+/// The matrix is written in row-major order as consecutive IEEE values
+/// without header or labels, the natural input format for numpy.fromfile
+/// and similar offline tooling. With singlePrecision set the entries are
+/// converted to float32, halving the file size.
+///
+/// \param  dataset         data basis for the Gram matrix
+/// \param  kernel          pointer to kernel function to be used
+/// \param  out             the stream to be written to
+/// \param  normalizer      what kind of normalization to apply. see enum declaration for details.
+/// \param  singlePrecision write float32 entries instead of float64
+template<typename InputType>
+void exportKernelMatrixBinary(
+	Data<InputType> const &dataset,
+	AbstractKernelFunction<InputType> &kernel,
+	std::ostream &out,
+	KernelMatrixNormalizationType normalizer = NONE,
+	bool singlePrecision = false
+)
+{
+	std::size_t size = dataset.numberOfElements();
+
+	SIZE_CHECK(size != 0);
+	// check outstream status
+	if(!out)
+	{
+		throw(std::invalid_argument("[exportKernelMatrixBinary] Can't write to stream."));
+	}
+
+	detail::KernelMatrixRowBlock<InputType> blocks(kernel, dataset);
+	detail::KernelMatrixNormalizationData norm;
+	detail::setupKernelMatrixNormalization(kernel, dataset, blocks, normalizer, norm);
+
+	// compute the matrix stripe by stripe and write each stripe with a
+	// single large sequential write
+	RealMatrix tile;
+	std::vector<float> floatBuffer;
+	std::vector<double> doubleBuffer;
+	for(std::size_t b = 0; b != blocks.blocks(); ++b)
+	{
+		blocks.compute(b, tile);
+		detail::normalizeKernelMatrixBlock(tile, blocks.blockFirstRow(b), normalizer, norm);
+		std::size_t numRows = tile.size1();
+		if(singlePrecision)
+		{
+			floatBuffer.resize(numRows * size);
+			for(std::size_t r = 0; r != numRows; ++r)
+			{
+				for(std::size_t j = 0; j != size; ++j)
+				{
+					floatBuffer[r * size + j] = static_cast<float>(tile(r, j));
+				}
+			}
+			out.write(reinterpret_cast<char const *>(&floatBuffer[0]), floatBuffer.size() * sizeof(float));
+		}
+		else
+		{
+			doubleBuffer.resize(numRows * size);
+			for(std::size_t r = 0; r != numRows; ++r)
+			{
+				for(std::size_t j = 0; j != size; ++j)
+				{
+					doubleBuffer[r * size + j] = tile(r, j);
+				}
+			}
+			out.write(reinterpret_cast<char const *>(&doubleBuffer[0]), doubleBuffer.size() * sizeof(double));
+		}
+	}
+}
+
+
+
+/// \brief Write a kernel Gram matrix to file as a dense binary matrix.
+///
+/// \param  dataset         data basis for the Gram matrix
+/// \param  kernel          pointer to kernel function to be used
+/// \param  fn              the filename of the file to be written to
+/// \param  normalizer      what kind of normalization to apply. see enum declaration for details.
+/// \param  singlePrecision write float32 entries instead of float64
+template<typename InputType>
+void exportKernelMatrixBinary(
+	Data<InputType> const &dataset,
+	AbstractKernelFunction<InputType> &kernel,
+	std::string fn,
+	KernelMatrixNormalizationType normalizer = NONE,
+	bool singlePrecision = false
+)
+{
+	std::ofstream ofs(fn.c_str(), std::ios::binary);
+	if(ofs)
+	{
+		exportKernelMatrixBinary(dataset, kernel, ofs, normalizer, singlePrecision);
+	}
+	else
+		throw(std::invalid_argument("[exportKernelMatrixBinary] Stream cannot be opened for writing."));
+
+}
+
+
+
 
 // deprecated wrapper
 template<typename InputType, typename LabelType>
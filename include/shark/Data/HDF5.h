@@ -42,6 +42,7 @@
 #ifndef SHARK_DATA_HDF5_H
 #define SHARK_DATA_HDF5_H
 
+#include "shark/Core/OpenMP.h"
 #include "shark/Core/utility/ScopedHandle.h"
 #include "shark/Data/Dataset.h"
 
@@ -52,7 +53,9 @@
 #include <boost/format.hpp>
 #include <boost/range/algorithm/fill.hpp>
 #include <boost/range/algorithm/max_element.hpp>
+#include <boost/range/iterator_range.hpp>
 #include <boost/smart_ptr/scoped_array.hpp>
+#include <algorithm>
 #include <type_traits>
 
 namespace shark {
@@ -113,6 +116,14 @@ bool isSupported(H5T_class_t typeClass, size_t typeSize)
 	return false;
 }
 
+/// Map raw value types to the native HDF5 memory type used for reading
+///@{
+inline hid_t nativeHDF5Type(int) { return H5T_NATIVE_INT; }
+inline hid_t nativeHDF5Type(long) { return H5T_NATIVE_LONG; }
+inline hid_t nativeHDF5Type(float) { return H5T_NATIVE_FLOAT; }
+inline hid_t nativeHDF5Type(double) { return H5T_NATIVE_DOUBLE; }
+///@}
+
 /// @brief Load a dataset in a HDF5 file into a matrix
 ///
 /// @param data
@@ -231,6 +242,147 @@ void loadHDF5Csc(MatrixType& data, const std::string& fileName, const std::vecto
 	}
 }
 
+/// @brief Stream a two dimensional dataset chunk-wise into Data batches, keeping only selected columns
+///
+/// The dataset is interpreted as samples x features. Instead of reading the
+/// whole dataset into one buffer, rows are read block by block through
+/// hyperslab selections which cover only the requested feature columns, so
+/// I/O and peak memory scale with the number of selected columns. Blocks are
+/// aligned to the chunk layout of the dataset so that every compressed chunk
+/// is decompressed exactly once.
+///
+/// @param data the dataset to be filled; its batch structure is created here
+/// @param fileName the name of HDF5 file
+/// @param dataSetName the HDF5 dataset name to access in the HDF5 file
+/// @param columns the feature columns to keep, in the order in which they
+///     shall appear in the imported vectors; an empty list keeps all columns
+/// @param maximumBatchSize maximum size of the batches of the imported dataset
+template<typename VectorType>
+void loadProjectedChunks(
+	Data<VectorType>& data,
+	const std::string& fileName,
+	const std::string& dataSetName,
+	const std::vector<std::size_t>& columns,
+	std::size_t maximumBatchSize)
+{
+	typedef typename VectorType::value_type RawValueType;
+
+	H5Eset_auto1(0, 0);
+
+	hid_t open = H5Fopen(fileName.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+	if(open < 0)
+		throw SHARKEXCEPTION((boost::format("[importHDF5] open file name: %1% (FAILED)") % fileName).str());
+	const ScopedHandle<hid_t> fileId(open, H5Fclose);
+
+	hid_t openSet = H5Dopen2(*fileId, dataSetName.c_str(), H5P_DEFAULT);
+	THROW_IF(
+		openSet < 0,
+		(boost::format("[importHDF5] open data set(%1%) in file(%2%). (FAILED)") % dataSetName % fileName).str());
+	const ScopedHandle<hid_t> dataSet(openSet, H5Dclose);
+
+	const ScopedHandle<hid_t> fileSpace(H5Dget_space(*dataSet), H5Sclose);
+	THROW_IF(
+		2 != H5Sget_simple_extent_ndims(*fileSpace),
+		(boost::format("[importHDF5][%1%][%2%] Column projection requires a two dimensional dataset.") % fileName % dataSetName).str());
+	boost::array<hsize_t, 2> dims;
+	H5Sget_simple_extent_dims(*fileSpace, dims.c_array(), NULL);
+	const std::size_t rows = dims[0];
+	const std::size_t totalColumns = dims[1];
+
+	const ScopedHandle<hid_t> dataType(H5Dget_type(*dataSet), H5Tclose);
+	THROW_IF(
+		!isSupported<RawValueType>(H5Tget_class(*dataType), H5Tget_size(*dataType)),
+		(boost::format(
+			"[importHDF5] DataType doesn't match. HDF5 data type in dataset(%3%::%4%): %1%, size: %2%")
+			% H5Tget_class(*dataType)
+			% H5Tget_size(*dataType)
+			% fileName
+			% dataSetName).str());
+
+	// an empty projection list keeps all columns
+	std::vector<std::size_t> projection(columns);
+	if (projection.empty())
+		for (std::size_t c = 0; c != totalColumns; ++c)
+			projection.push_back(c);
+	THROW_IF(
+		*boost::max_element(projection) >= totalColumns,
+		(boost::format("[importHDF5][%1%][%2%] Projected column is out of range.") % fileName % dataSetName).str());
+
+	// hyperslab selections deliver the union of the selected columns in
+	// ascending order, so read through the sorted unique columns and keep a
+	// rank table to restore the order the caller asked for
+	std::vector<std::size_t> sortedColumns(projection);
+	std::sort(sortedColumns.begin(), sortedColumns.end());
+	sortedColumns.erase(std::unique(sortedColumns.begin(), sortedColumns.end()), sortedColumns.end());
+	std::vector<std::size_t> rank(projection.size());
+	for (std::size_t j = 0; j != projection.size(); ++j)
+		rank[j] = std::lower_bound(sortedColumns.begin(), sortedColumns.end(), projection[j]) - sortedColumns.begin();
+
+	if (0 == rows) {
+		data = Data<VectorType>();
+		return;
+	}
+
+	// read blocks of rows aligned to the chunk layout so that every
+	// compressed chunk is decompressed exactly once
+	const ScopedHandle<hid_t> createProps(H5Dget_create_plist(*dataSet), H5Pclose);
+	std::size_t blockRows = maximumBatchSize;
+	if (H5D_CHUNKED == H5Pget_layout(*createProps)) {
+		boost::array<hsize_t, 2> chunkDims;
+		H5Pget_chunk(*createProps, 2, chunkDims.c_array());
+		const std::size_t chunkRows = chunkDims[0];
+		blockRows = (maximumBatchSize + chunkRows - 1) / chunkRows * chunkRows;
+	}
+
+	const std::vector<std::size_t> batchSizes = detail::optimalBatchSizes(rows, maximumBatchSize);
+	data = Data<VectorType>(batchSizes.size());
+
+	boost::scoped_array<RawValueType> buffer(new RawValueType[blockRows * sortedColumns.size()]);
+	std::vector<VectorType> elements;
+	std::size_t batch = 0;
+	for (std::size_t row = 0; row < rows; row += blockRows) {
+		const std::size_t rowsNow = std::min(blockRows, rows - row);
+
+		// select the requested columns of the current block of rows
+		for (std::size_t k = 0; k != sortedColumns.size(); ++k) {
+			boost::array<hsize_t, 2> start = {{row, sortedColumns[k]}};
+			boost::array<hsize_t, 2> count = {{rowsNow, 1}};
+			THROW_IF(
+				H5Sselect_hyperslab(
+					*fileSpace, k ? H5S_SELECT_OR : H5S_SELECT_SET,
+					start.data(), NULL, count.data(), NULL) < 0,
+				"[importHDF5] Select columns of a block of rows.");
+		}
+		boost::array<hsize_t, 2> memDims = {{rowsNow, sortedColumns.size()}};
+		const ScopedHandle<hid_t> memSpace(H5Screate_simple(2, memDims.c_array(), NULL), H5Sclose);
+		THROW_IF(
+			H5Dread(*dataSet, nativeHDF5Type(RawValueType()), *memSpace, *fileSpace, H5P_DEFAULT, buffer.get()) < 0,
+			"[importHDF5] Read a block of rows.");
+
+		// scatter the block into sample vectors, restoring the caller's column order
+		const std::size_t base = elements.size();
+		elements.resize(base + rowsNow, VectorType(projection.size()));
+		SHARK_PARALLEL_FOR(int r = 0; r < (int)rowsNow; ++r) {
+			VectorType& sample = elements[base + r];
+			for (std::size_t j = 0; j != projection.size(); ++j)
+				sample[j] = buffer[r * sortedColumns.size() + rank[j]];
+		}
+
+		// hand over complete batches so that memory stays bounded by the block size
+		std::size_t consumed = 0;
+		while (batch != batchSizes.size() && elements.size() - consumed >= batchSizes[batch]) {
+			data.batch(batch) = Batch<VectorType>::createBatchFromRange(
+				boost::make_iterator_range(
+					elements.begin() + consumed,
+					elements.begin() + consumed + batchSizes[batch]));
+			consumed += batchSizes[batch];
+			++batch;
+		}
+		elements.erase(elements.begin(), elements.begin() + consumed);
+	}
+	SHARK_ASSERT(batch == batchSizes.size());
+}
+
 /// @brief Construct labeled data from passed in data and label
 ///
 /// @param labeledData
@@ -305,6 +457,87 @@ void importHDF5(
 	detail::constructLabeledData(labeledData, readinData, readinLabel);
 }
 
+/// @brief Import a two dimensional HDF5 dataset chunk by chunk, keeping only selected columns.
+///
+/// In contrast to importHDF5, which loads the full dataset into one buffer,
+/// this importer streams blocks of rows - aligned to the chunk layout of the
+/// dataset - directly into the batches of the Data object and reads only the
+/// requested feature columns. I/O and peak memory thereby scale with the
+/// number of selected columns instead of the width of the file, which matters
+/// for wide feature-store files of which a training run uses a small subset.
+///
+/// The dataset is interpreted as samples x features; the imported vectors
+/// contain the projected columns in the order given by @a columns.
+///
+/// @param data        Container storing the loaded data
+/// @param fileName    The name of HDF5 file to be read from
+/// @param datasetName the HDF5 dataset name to access in the HDF5 file
+/// @param columns     the feature columns to keep, in their desired order;
+///     an empty list keeps all columns
+/// @param maximumBatchSize maximum size of the batches of the imported dataset
+///
+/// @tparam VectorType   Type of object stored in Shark data container
+template<typename VectorType>
+void importHDF5Chunked(
+	Data<VectorType>& data,
+	const std::string& fileName,
+	const std::string& datasetName,
+	const std::vector<std::size_t>& columns,
+	std::size_t maximumBatchSize = Data<VectorType>::DefaultBatchSize)
+{
+	detail::loadProjectedChunks(data, fileName, datasetName, columns, maximumBatchSize);
+}
+
+/// @brief Import labeled data from a HDF5 file chunk by chunk, keeping only selected columns.
+///
+/// The inputs are streamed with column projection as by the unlabeled
+/// overload; the labels - typically tiny compared to the inputs - are read in
+/// one piece and batched along the input batch structure.
+///
+/// @param labeledData Container storing the loaded data
+/// @param fileName    The name of HDF5 file to be read from
+/// @param data        the HDF5 dataset name for data
+/// @param label       the HDF5 dataset name for label
+/// @param columns     the feature columns to keep, in their desired order;
+///     an empty list keeps all columns
+/// @param maximumBatchSize maximum size of the batches of the imported dataset
+///
+/// @tparam VectorType   Type of object stored in Shark data container
+/// @tparam LabelType    Type of label
+template<typename VectorType, typename LabelType>
+void importHDF5Chunked(
+	LabeledData<VectorType, LabelType>& labeledData,
+	const std::string& fileName,
+	const std::string& data,
+	const std::string& label,
+	const std::vector<std::size_t>& columns,
+	std::size_t maximumBatchSize = LabeledData<VectorType, LabelType>::DefaultBatchSize)
+{
+	Data<VectorType> inputs;
+	detail::loadProjectedChunks(inputs, fileName, data, columns, maximumBatchSize);
+
+	std::vector<std::vector<LabelType> > labelBuffer;
+	detail::loadIntoMatrix(labelBuffer, fileName, label);
+	THROW_IF(
+		1 != labelBuffer.size(),
+		(boost::format("[importHDF5] Expect only one label vector, but get %1%.") % labelBuffer.size()).str());
+	const std::vector<LabelType>& labels = labelBuffer.front();
+	THROW_IF(
+		inputs.numberOfElements() != labels.size(),
+		boost::format("[importHDF5] Dimensions of data and label don't match.").str());
+
+	// batch the labels along the input batch structure
+	Data<LabelType> labelData(inputs.numberOfBatches());
+	std::size_t element = 0;
+	for (std::size_t b = 0; b != inputs.numberOfBatches(); ++b) {
+		const std::size_t batchSize = boost::size(inputs.batch(b));
+		labelData.batch(b) = Batch<LabelType>::createBatchFromRange(
+			boost::make_iterator_range(labels.begin() + element, labels.begin() + element + batchSize));
+		element += batchSize;
+	}
+	labeledData = LabeledData<VectorType, LabelType>(inputs, labelData);
+}
+
 /// @brief Import data from HDF5 dataset of compressed sparse column format.
 ///
 /// @param data        Container storing the loaded data
@@ -32,6 +32,7 @@
 #include <shark/Core/ISerializable.h>
 #include <shark/Core/utility/ZipPair.h>
 #include <shark/Core/Exception.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Core/utility/CanBeCalled.h>
 
 #include <boost/mpl/eval_if.hpp>
@@ -159,16 +160,19 @@ public:
 		std::size_t optimalBatchSize=points/batches;
 		std::size_t remainder = points-batches*optimalBatchSize;
 
-		//now create the batches taking the remainder into account
-		m_data.reserve(batches);
-		std::size_t batchStart = 0;
-		for(std::size_t i = 0; i != batches; ++i){
-			std::size_t size = (i<remainder)?optimalBatchSize+1:optimalBatchSize;
+		//now create the batches taking the remainder into account. the start of
+		//every batch is computed directly from its index so the batches can be
+		//packed in parallel. on NUMA machines this places every batch on the
+		//node of the thread which first touches it - the same thread that will
+		//process the batch in the statically scheduled batch-parallel loops.
+		m_data.resize(batches);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)batches; ++i){
+			std::size_t size = (i < (int)remainder)? optimalBatchSize+1 : optimalBatchSize;
+			std::size_t batchStart = i*optimalBatchSize + std::min<std::size_t>(i,remainder);
 			std::size_t batchEnd = batchStart+size;//sliced is last element inclusive
-			push_back(Batch<Type>::createBatch(
+			m_data[i].reset(new BatchType(Batch<Type>::createBatch(
 				boost::make_iterator_range(boost::begin(data)+batchStart,boost::begin(data)+batchEnd)
-			));
-			batchStart+=size;
+			)));
 		}
 	}
 
@@ -30,7 +30,10 @@
 
 #include <string>
 #include <map>
+#include <sstream>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 #include <cstring>
 
 #ifdef _WIN32
@@ -213,45 +216,26 @@ private:
 	int m_handle;                      ///< POSIX socket handle
 };
 
-} // namespace detail
+/// \brief Status code and headers of an HTTP reply.
+struct HttpResponse
+{
+	std::string statusCode;                       ///< three digit status code, e.g. "200"
+	std::map<std::string, std::string> headers;   ///< headers, tags and values in lower case
+};
 
-/// \brief Download a document with the HTTP protocol.
-///
-/// \param  url       download URL, for example "www.shark-ml.org/index.html"
-/// \param  port      TCP/IP port, defaults to 80
+/// \brief Read and parse the status line and the headers of an HTTP reply.
 ///
-/// The function requests the document with a HTTP request and returns
-/// the body of the corresponding HTTP reply. In case of success this
-/// is the requested document. In case of an error the function throws
-/// an exception. Note that the function does not perform standard
-/// actions of web browsers, e.g., execute javascript or follow http
-/// redirects. All HTTP response status codes other than 200 are
-/// reported as failure to download the document and trigger an
-/// exception.
-std::string download(std::string const& url, unsigned short port = 80)
+/// The body of the reply remains on the socket. An exception is thrown
+/// if the reply violates the HTTP protocol.
+inline HttpResponse readHttpResponse(Socket& socket)
 {
-	// split the URL into domain and resource
-	std::size_t start = 0;
-	if (url.size() >= 7 && url.substr(0, 7) == "http://") start = 7;
-	std::size_t slash = url.find('/', start);
-	if (slash == std::string::npos) throw std::runtime_error("[download] invalid URL (failed to split into domain and resource)");
-	std::string domain = url.substr(start, slash - start);
-	std::string resource = url.substr(slash);
-
-	// open a TCP/IP socket connection
-	detail::Socket socket(domain, port);
-	std::string request = "GET " + resource + " HTTP/1.1\r\nhost: " + domain + "\r\n\r\n";
-	socket.writeAll(request.c_str(), request.size());
-
-	// http reply data
-	std::map<std::string, std::string> headers;
-	std::string body;
+	HttpResponse response;
 
 	// parse http reply line
 	std::string reply = socket.readLine();
 	if (reply.size() < 12) throw std::runtime_error("[download] http protocol violation");
 	if (reply.substr(0, 9) != "HTTP/1.0 " && reply.substr(0, 9) != "HTTP/1.1 ") throw std::runtime_error("[download] http protocol violation");
-	if (reply.substr(9, 3) != "200") throw std::runtime_error("[download] failed with HTTP status " + reply.substr(9));
+	response.statusCode = reply.substr(9, 3);
 
 	// parse http headers
 	while (true)
@@ -268,9 +252,98 @@ std::string download(std::string const& url, unsigned short port = 80)
 		while (! value.empty() && value[value.size() - 1] == ' ') value.erase(value.size() - 1);
 		// convert plain ASCII to lower case
 		for (std::size_t i=0; i<value.size(); i++) value[i] = std::tolower(value[i]);
-		headers[tag] = value;
+		response.headers[tag] = value;
 	}
 
+	return response;
+}
+
+/// \brief Split a URL into domain and resource part.
+inline void splitUrl(std::string const& url, std::string& domain, std::string& resource)
+{
+	std::size_t start = 0;
+	if (url.size() >= 7 && url.substr(0, 7) == "http://") start = 7;
+	std::size_t slash = url.find('/', start);
+	if (slash == std::string::npos) throw std::runtime_error("[download] invalid URL (failed to split into domain and resource)");
+	domain = url.substr(start, slash - start);
+	resource = url.substr(slash);
+}
+
+/// \brief Download the byte range [begin, end) of a resource into a buffer.
+///
+/// The function opens its own connection and issues a ranged GET request.
+/// It returns the number of bytes actually received, which may be smaller
+/// than the requested range if the connection drops or the server does
+/// not honor range requests; the caller can resume from begin plus the
+/// returned count on a fresh connection.
+inline std::size_t downloadRangePart(
+	std::string const& domain,
+	unsigned short port,
+	std::string const& resource,
+	std::size_t begin,
+	std::size_t end,
+	char* buffer)
+{
+	Socket socket(domain, port);
+	if (! socket.connected()) return 0;
+
+	std::ostringstream request;
+	request << "GET " << resource << " HTTP/1.1\r\nhost: " << domain
+		<< "\r\nrange: bytes=" << begin << "-" << (end - 1) << "\r\n\r\n";
+	std::string req = request.str();
+	if (! socket.writeAll(req.c_str(), req.size())) return 0;
+
+	HttpResponse response;
+	try
+	{ response = readHttpResponse(socket); }
+	catch (std::runtime_error const&)
+	{ return 0; }
+	if (response.statusCode != "206") return 0;
+
+	// stream the body directly into the target buffer
+	std::size_t length = end - begin;
+	std::size_t received = 0;
+	while (received < length)
+	{
+		std::size_t r = socket.read(buffer + received, length - received);
+		if (r == 0) break;
+		received += r;
+	}
+	return received;
+}
+
+} // namespace detail
+
+/// \brief Download a document with the HTTP protocol.
+///
+/// \param  url       download URL, for example "www.shark-ml.org/index.html"
+/// \param  port      TCP/IP port, defaults to 80
+///
+/// The function requests the document with a HTTP request and returns
+/// the body of the corresponding HTTP reply. In case of success this
+/// is the requested document. In case of an error the function throws
+/// an exception. Note that the function does not perform standard
+/// actions of web browsers, e.g., execute javascript or follow http
+/// redirects. All HTTP response status codes other than 200 are
+/// reported as failure to download the document and trigger an
+/// exception.
+std::string download(std::string const& url, unsigned short port = 80)
+{
+	// split the URL into domain and resource
+	std::string domain, resource;
+	detail::splitUrl(url, domain, resource);
+
+	// open a TCP/IP socket connection
+	detail::Socket socket(domain, port);
+	std::string request = "GET " + resource + " HTTP/1.1\r\nhost: " + domain + "\r\n\r\n";
+	socket.writeAll(request.c_str(), request.size());
+
+	// parse http reply line and headers
+	detail::HttpResponse response = detail::readHttpResponse(socket);
+	if (response.statusCode != "200") throw std::runtime_error("[download] failed with HTTP status " + response.statusCode);
+	std::map<std::string, std::string>& headers = response.headers;
+	std::string body;
+
 	// receive http body
 	std::string len = headers["content-length"];
 	if (! len.empty())
@@ -297,5 +370,97 @@ std::string download(std::string const& url, unsigned short port = 80)
 	return body;
 }
 
+/// \brief Download a document over several parallel ranged HTTP connections.
+///
+/// \param  url          download URL, for example "www.shark-ml.org/index.html"
+/// \param  port         TCP/IP port, defaults to 80
+/// \param  connections  number of parallel connections
+/// \param  maxRetries   reconnect attempts per connection before giving up
+///
+/// A single blocking connection often cannot saturate the available
+/// bandwidth towards an object store. This function first probes whether
+/// the server honors range requests; if so, the document is split into
+/// one contiguous stripe per connection and the stripes are fetched by
+/// parallel worker threads, each streaming its range directly into the
+/// shared result buffer. A dropped connection is reopened and the
+/// transfer resumes at the first missing byte of its stripe, up to
+/// maxRetries times per stripe. Servers without range support are served
+/// by a plain download() over one connection, so the function can be
+/// used unconditionally. In case of an error the function throws an
+/// exception.
+inline std::string downloadRanged(
+	std::string const& url,
+	unsigned short port = 80,
+	std::size_t connections = 4,
+	std::size_t maxRetries = 3)
+{
+	std::string domain, resource;
+	detail::splitUrl(url, domain, resource);
+
+	// probe for range support and total size with a one byte range request
+	std::size_t total = 0;
+	{
+		detail::Socket socket(domain, port);
+		std::string request = "GET " + resource + " HTTP/1.1\r\nhost: " + domain + "\r\nrange: bytes=0-0\r\n\r\n";
+		if (! socket.connected() || ! socket.writeAll(request.c_str(), request.size()))
+			throw std::runtime_error("[downloadRanged] cannot connect to " + domain);
+		detail::HttpResponse response = detail::readHttpResponse(socket);
+		if (response.statusCode != "206")
+		{
+			// the server ignores ranges; fall back to a plain download
+			if (response.statusCode == "200") return download(url, port);
+			throw std::runtime_error("[downloadRanged] failed with HTTP status " + response.statusCode);
+		}
+		// total size is the part after the slash of "bytes 0-0/total"
+		std::string contentRange = response.headers["content-range"];
+		std::size_t slash = contentRange.find('/');
+		if (slash == std::string::npos) throw std::runtime_error("[downloadRanged] http protocol violation");
+		total = strtol(contentRange.c_str() + slash + 1, NULL, 10);
+	}
+	if (total == 0) return std::string();
+
+	if (connections == 0) connections = 1;
+	if (connections > total) connections = total;
+
+	// one contiguous stripe per connection, fetched directly into the result
+	std::string body(total, '\0');
+	std::size_t stripeSize = total / connections;
+	std::size_t remainder = total % connections;
+	std::vector<char> failed(connections, 0);
+	std::vector<std::thread> workers;
+	std::size_t begin = 0;
+	for (std::size_t c = 0; c != connections; ++c)
+	{
+		std::size_t end = begin + stripeSize + (c < remainder ? 1 : 0);
+		workers.push_back(std::thread(
+			[&domain, port, &resource, &body, &failed, begin, end, maxRetries, c]()
+			{
+				std::size_t position = begin;
+				std::size_t attempts = 0;
+				while (position < end)
+				{
+					position += detail::downloadRangePart(domain, port, resource, position, end, &body[position]);
+					if (position == end) break;
+					// the connection dropped; reconnect and resume at the first missing byte
+					++attempts;
+					if (attempts > maxRetries)
+					{
+						failed[c] = 1;
+						return;
+					}
+				}
+			}
+		));
+		begin = end;
+	}
+	for (std::size_t c = 0; c != connections; ++c) workers[c].join();
+	for (std::size_t c = 0; c != connections; ++c)
+	{
+		if (failed[c]) throw std::runtime_error("[downloadRanged] download failed despite retries");
+	}
+
+	return body;
+}
+
 } // namespace shark
 #endif
@@ -33,6 +33,11 @@ namespace shark{
  *  Given the vector of data, the mean and variance values
  *  are calculated as in the functions #mean and #variance.
  *
+ *  The computation needs only a single pass over the data: every batch
+ *  contributes its size, mean and summed squared deviation from the batch
+ *  mean, and the partial statistics are merged with the standard pairwise
+ *  update. The batches are processed in parallel.
+ *
  *      \param  data Input data.
  *      \param  meanVec Vector of mean values.
  *      \param  varianceVec Vector of variances.
@@ -47,20 +52,30 @@ void meanvar
 )
 {
 	SIZE_CHECK(!data.empty());
-	std::size_t const dataSize = data.numberOfElements();
 	std::size_t elementSize=dataDimension(data);
 
+	meanVec().resize(elementSize);
+	meanVec().clear();
 	varianceVec().resize(elementSize);
 	varianceVec().clear();
-	
-	meanVec()= mean(data);
-	
-	//sum of variances of each column
-	for(auto& batch: data.batches()){
+
+	double count = 0;
+	SHARK_PARALLEL_FOR(int b = 0; b < (int)data.numberOfBatches(); ++b){
+		auto const& batch = data.batch(b);
 		std::size_t batchSize = batch.size1();
-		noalias(varianceVec()) += sum_rows(sqr(batch-repeat(meanVec,batchSize)));
+		//statistics of this batch, centered at the batch mean
+		RealVector batchMean = sum_rows(batch)/batchSize;
+		RealVector batchM2 = sum_rows(sqr(batch-repeat(batchMean,batchSize)));
+		//merge the batch statistics into the accumulated statistics
+		SHARK_CRITICAL_REGION{
+			double newCount = count + batchSize;
+			RealVector delta = batchMean - meanVec();
+			noalias(meanVec()) += (batchSize/newCount)*delta;
+			noalias(varianceVec()) += batchM2 + (count*batchSize/newCount)*sqr(delta);
+			count = newCount;
+		}
 	}
-	varianceVec() /= double(dataSize);
+	varianceVec() /= count;
 }
 
 /*!
@@ -69,6 +84,11 @@ void meanvar
  *  Given the vector of data, the mean and variance values
  *  are calculated as in the functions #mean and #variance.
  *
+ *  As in the vector valued version, mean and covariance are computed
+ *  in a single parallel pass: every batch contributes its mean and its
+ *  scatter matrix around the batch mean, and the partial statistics are
+ *  merged pairwise with an outer product correction term.
+ *
  *      \param  data Input data.
  *      \param  meanVec Vector of mean values.
  *      \param  covariance Covariance matrix.
@@ -82,21 +102,31 @@ void meanvar
 	blas::matrix_container<MatT, Device>& covariance
 ){
 	SIZE_CHECK(!data.empty());
-	typedef typename Batch<Vec1T>::type BatchType;
-	std::size_t const dataSize = data.numberOfElements();
 	std::size_t elementSize=dataDimension(data);
 
+	meanVec().resize(elementSize);
+	meanVec().clear();
 	covariance().resize(elementSize,elementSize);
 	covariance().clear();
-	
-	meanVec() = mean(data);
-	//sum of variances of each column
-	for(std::size_t b = 0; b != data.numberOfBatches(); ++b){
-		//make the batch mean-free
-		BatchType batch = data.batch(b)-repeat(meanVec,data.batch(b).size1());
-		noalias(covariance) += prod(trans(batch),batch);
+
+	double count = 0;
+	SHARK_PARALLEL_FOR(int b = 0; b < (int)data.numberOfBatches(); ++b){
+		auto const& batch = data.batch(b);
+		std::size_t batchSize = batch.size1();
+		//statistics of this batch, centered at the batch mean
+		RealVector batchMean = sum_rows(batch)/batchSize;
+		RealMatrix centered = batch-repeat(batchMean,batchSize);
+		RealMatrix batchScatter = prod(trans(centered),centered);
+		//merge the batch statistics into the accumulated statistics
+		SHARK_CRITICAL_REGION{
+			double newCount = count + batchSize;
+			RealVector delta = batchMean - meanVec();
+			noalias(meanVec()) += (batchSize/newCount)*delta;
+			noalias(covariance()) += batchScatter + (count*batchSize/newCount)*outer_prod(delta,delta);
+			count = newCount;
+		}
 	}
-	covariance() /= double(dataSize);
+	covariance() /= count;
 }
 
 /*!
@@ -140,9 +170,12 @@ VectorType mean(Data<VectorType> const& data){
 	SIZE_CHECK(!data.empty());
 
 	VectorType mean(dataDimension(data),0.0);
-	 
-	for(auto& batch: data.batches()){
-		mean += sum_rows(batch);
+
+	SHARK_PARALLEL_FOR(int b = 0; b < (int)data.numberOfBatches(); ++b){
+		VectorType batchSum = sum_rows(data.batch(b));
+		SHARK_CRITICAL_REGION{
+			noalias(mean) += batchSum;
+		}
 	}
 	mean /= double(data.numberOfElements());
 	return mean;
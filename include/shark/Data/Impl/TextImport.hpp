@@ -0,0 +1,222 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Shared low-level machinery of the parallel text importers
+ *
+ *
+ * \par
+ * The fast readers of the CSV and libSVM importers share the same
+ * building blocks: a read-only view of a whole file that is memory
+ * mapped where the platform supports it, and an exact floating point
+ * scanner that avoids strtod on the common token shapes. They live here
+ * so that the parsers in src/Data only contain the format specific
+ * chunk logic. This header is an implementation detail and offers no
+ * stable interface.
+ *
+ *
+ * \author      O. Krause
+ * \date        2016
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_DATA_IMPL_TEXTIMPORT_HPP
+#define SHARK_DATA_IMPL_TEXTIMPORT_HPP
+
+#include <boost/cstdint.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define SHARK_TEXTIMPORT_USE_MMAP
+#endif
+
+namespace shark { namespace detail {
+
+///\brief Read-only view of a file, memory mapped when the platform supports it.
+class MappedFile{
+public:
+	MappedFile(std::string const& fn, char const* openError)
+	: m_data(0), m_size(0), m_mapped(false){
+#ifdef SHARK_TEXTIMPORT_USE_MMAP
+		int fd = ::open(fn.c_str(), O_RDONLY);
+		if(fd == -1)
+			throw std::invalid_argument(openError);
+		struct stat info;
+		if(::fstat(fd, &info) == 0 && info.st_size > 0){
+			void* memory = ::mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(memory != MAP_FAILED){
+				m_data = static_cast<char const*>(memory);
+				m_size = info.st_size;
+				m_mapped = true;
+			}
+		}
+		::close(fd);
+		if(m_mapped) return;
+#endif
+		std::ifstream stream(fn.c_str(), std::ios::binary);
+		if(!stream)
+			throw std::invalid_argument(openError);
+		m_buffer.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+		m_data = m_buffer.data();
+		m_size = m_buffer.size();
+	}
+	MappedFile(MappedFile const&) = delete;
+	MappedFile& operator=(MappedFile const&) = delete;
+	~MappedFile(){
+#ifdef SHARK_TEXTIMPORT_USE_MMAP
+		if(m_mapped)
+			::munmap(const_cast<char*>(m_data), m_size);
+#endif
+	}
+
+	char const* begin()const{ return m_data; }
+	char const* end()const{ return m_data + m_size; }
+private:
+	char const* m_data;
+	std::size_t m_size;
+	bool m_mapped;
+	std::string m_buffer;
+};
+
+//skips spaces, tabs and carriage returns, but not the newline ending the row
+inline void skipBlank(char const*& pos, char const* end){
+	while(pos != end && (*pos == ' ' || *pos == '\t' || *pos == '\r'))
+		++pos;
+}
+
+///\brief Parses a single floating point value, advancing pos past it.
+///
+/// The common case - at most 19 significant digits and a decimal exponent
+/// in [-22,22] - is converted exactly from an integer mantissa. Everything
+/// else is handed to strtod for correctly rounded results, which keeps the
+/// fast path branch-light without losing a single ulp.
+inline double parseValue(char const*& pos, char const* end, bool& ok){
+	static double const powersOfTen[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+	char const* start = pos;
+	bool negative = false;
+	if(pos != end && (*pos == '+' || *pos == '-')){
+		negative = (*pos == '-');
+		++pos;
+	}
+	boost::uint64_t mantissa = 0;
+	int digits = 0;
+	int exponent = 0;
+	bool anyDigit = false;
+	while(pos != end && *pos >= '0' && *pos <= '9'){
+		anyDigit = true;
+		if(digits < 19){
+			mantissa = 10 * mantissa + (*pos - '0');
+			++digits;
+		}else
+			++exponent;
+		++pos;
+	}
+	if(pos != end && *pos == '.'){
+		++pos;
+		while(pos != end && *pos >= '0' && *pos <= '9'){
+			anyDigit = true;
+			if(digits < 19){
+				mantissa = 10 * mantissa + (*pos - '0');
+				++digits;
+				--exponent;
+			}
+			++pos;
+		}
+	}
+	if(!anyDigit){
+		ok = false;
+		pos = start;
+		return 0.0;
+	}
+	if(pos != end && (*pos == 'e' || *pos == 'E')){
+		++pos;
+		bool exponentNegative = false;
+		if(pos != end && (*pos == '+' || *pos == '-')){
+			exponentNegative = (*pos == '-');
+			++pos;
+		}
+		int e = 0;
+		bool anyExponentDigit = false;
+		while(pos != end && *pos >= '0' && *pos <= '9'){
+			anyExponentDigit = true;
+			if(e < 100000)
+				e = 10 * e + (*pos - '0');
+			++pos;
+		}
+		if(!anyExponentDigit){
+			ok = false;
+			pos = start;
+			return 0.0;
+		}
+		exponent += exponentNegative? -e : e;
+	}
+	ok = true;
+	if(digits < 19 && exponent >= -22 && exponent <= 22 && mantissa < (boost::uint64_t(1) << 53)){
+		double result = static_cast<double>(mantissa);
+		if(exponent < 0)
+			result /= powersOfTen[-exponent];
+		else
+			result *= powersOfTen[exponent];
+		return negative? -result : result;
+	}
+	//rare path: strtod parses the whole token again, including the sign
+	char token[64];
+	std::size_t length = std::min<std::size_t>(pos - start, sizeof(token) - 1);
+	std::memcpy(token, start, length);
+	token[length] = 0;
+	return std::strtod(token, 0);
+}
+
+///\brief Parses an unsigned integer index, advancing pos past it.
+inline std::size_t parseIndex(char const*& pos, char const* end, bool& ok){
+	char const* start = pos;
+	std::size_t index = 0;
+	while(pos != end && *pos >= '0' && *pos <= '9'){
+		if(index > (std::numeric_limits<std::size_t>::max() - 9) / 10){
+			ok = false;
+			pos = start;
+			return 0;
+		}
+		index = 10 * index + (*pos - '0');
+		++pos;
+	}
+	ok = (pos != start);
+	return index;
+}
+
+}}
+#endif
@@ -40,6 +40,7 @@
 #include <shark/Core/ISerializable.h>
 
 #include <shark/Data/Dataset.h>
+#include <shark/Data/LazyTransformedData.h>
 
 
 
@@ -74,6 +75,37 @@ public:
 	{ return "LabelOrder"; }
 
 
+	/// \brief Element-wise functor applying a stored label compaction.
+	///
+	/// The functor maps every original label to its position in the label
+	/// ordering it was built from. It can be passed to transformLabels to
+	/// obtain a normalized dataset sharing the input batches, or to
+	/// lazyTransform on the label container to map labels on batch access.
+	class Mapping
+	{
+	public:
+		typedef unsigned int result_type;
+
+		Mapping() : m_minLabel(0) {}
+
+		Mapping(std::vector<unsigned int> const& map, unsigned int minLabel)
+			: m_map(map), m_minLabel(minLabel) {}
+
+		unsigned int operator()(unsigned int label) const
+		{
+			// check if the ordering fits the label
+			if(label < m_minLabel || label - m_minLabel >= m_map.size() ||
+				m_map[label - m_minLabel] == std::numeric_limits<unsigned int>::max())
+				throw SHARKEXCEPTION("Dataset labels do not fit to the stored ordering!");
+			return m_map[label - m_minLabel];
+		}
+
+	private:
+		std::vector<unsigned int> m_map;
+		unsigned int m_minLabel;
+	};
+
+
 	/// \brief This will normalize the labels and store the ordering in the
 	/// member variables. The dataset will afterwards have labels ranging
 	/// from 0 to N-1, with N the number of classes.
@@ -127,6 +159,107 @@ public:
 			int label = dataset.labels().element(i);
 			dataset.labels().element(i) = foundLabels[label - minLabel];
 		}
+
+		rebuildMapping();
+	}
+
+
+	/// \brief This will determine the label ordering without modifying the dataset.
+	///
+	/// This performs the same compaction as normalizeLabels, but only reads
+	/// the labels, batch by batch: the ordering and the label map are stored
+	/// in the object and the dataset stays untouched, so building the order
+	/// no longer costs a full-dataset rewrite. Apply the compaction with
+	/// normalizedLabels, or with mapping() and lazyTransform if the labels
+	/// should only be mapped on batch access.
+	/// This will overwrite any previously stored label ordering in the object.
+	///
+	/// \param[in]  dataset     dataset whose labels are scanned
+	void buildLabelOrder(LabeledData<RealVector, unsigned int> const& dataset)
+	{
+		Data<unsigned int> const& labels = dataset.labels();
+
+		// determine the min and max labels of the given dataset
+		unsigned int minLabel = std::numeric_limits<unsigned int>::max();
+		unsigned int maxLabel = 0;
+		for(std::size_t b = 0; b < labels.numberOfBatches(); ++b)
+		{
+			Batch<unsigned int>::type const& batch = labels.batch(b);
+			for(std::size_t e = 0; e < boost::size(batch); ++e)
+			{
+				unsigned int label = shark::get(batch, e);
+				if(label < minLabel)
+					minLabel = label;
+				if(label > maxLabel)
+					maxLabel = label;
+			}
+		}
+
+		// now we create an vector that can hold the label ordering
+		m_labelOrder.clear();
+
+		// and one array that tracks what we already encountered
+		unsigned int maxval = std::numeric_limits<unsigned int>::max();
+		std::vector<unsigned int> foundLabels(maxLabel - minLabel + 1, maxval);
+
+		// and insert all labels we encounter
+		unsigned int currentPosition = 0;
+		for(std::size_t b = 0; b < labels.numberOfBatches(); ++b)
+		{
+			Batch<unsigned int>::type const& batch = labels.batch(b);
+			for(std::size_t e = 0; e < boost::size(batch); ++e)
+			{
+				// is it a new label?
+				unsigned int label = shark::get(batch, e);
+				if(foundLabels[label - minLabel] == maxval)
+				{
+					foundLabels[label - minLabel] = currentPosition;
+					m_labelOrder.push_back(label);
+					currentPosition++;
+				}
+			}
+		}
+
+		m_labelMap = Mapping(foundLabels, minLabel);
+	}
+
+
+	/// \brief Get the element-wise functor applying the stored compaction.
+	///
+	/// The functor maps original labels to 0..N-1 as defined by the stored
+	/// ordering and throws on labels the ordering does not contain. Combined
+	/// with lazyTransform on the label container it forms a mapping layer
+	/// which relabels on batch access without any data pass.
+	Mapping const& mapping() const
+	{
+		return m_labelMap;
+	}
+
+
+	/// \brief Returns a dataset with normalized labels without rewriting the given one.
+	///
+	/// This builds the label ordering as buildLabelOrder and applies it in
+	/// the same call. The result shares the input batches of the dataset;
+	/// only the label batches are newly allocated, so the elements are never
+	/// copied or rewritten.
+	///
+	/// \param[in]  dataset     dataset to be relabeled
+	LabeledData<RealVector, unsigned int> normalizedLabels(LabeledData<RealVector, unsigned int> const& dataset)
+	{
+		buildLabelOrder(dataset);
+		return transformLabels(dataset, m_labelMap);
+	}
+
+
+	/// \brief Returns the label container of the dataset with the stored compaction applied on batch access.
+	///
+	/// No label batch is mapped before it is requested; see LazyTransformedData
+	/// for the caching behavior. The ordering must have been built before.
+	///
+	/// \param[in]  dataset     dataset whose labels are to be mapped
+	LazyTransformedData<unsigned int, Mapping> mapLabelsLazily(LabeledData<RealVector, unsigned int> const& dataset) const
+	{
+		return lazyTransform(dataset.labels(), m_labelMap);
 	}
 
 
@@ -185,6 +318,7 @@ public:
 	void setLabelOrder(std::vector<int> &labelOrder)
 	{
 		m_labelOrder = labelOrder;
+		rebuildMapping();
 	}
 
 
@@ -194,12 +328,31 @@ public:
         void setLabelOrder (std::vector<unsigned int> &labelOrder)
         {
                 m_labelOrder  = std::vector<int>( labelOrder.begin(), labelOrder.end() );
+                rebuildMapping();
         }
 
 
 protected:
 
+	/// \brief Rebuilds the label map from the stored ordering.
+	void rebuildMapping()
+	{
+		if(m_labelOrder.empty())
+		{
+			m_labelMap = Mapping();
+			return;
+		}
+		unsigned int minLabel = (unsigned int)*std::min_element(m_labelOrder.begin(), m_labelOrder.end());
+		unsigned int maxLabel = (unsigned int)*std::max_element(m_labelOrder.begin(), m_labelOrder.end());
+		unsigned int maxval = std::numeric_limits<unsigned int>::max();
+		std::vector<unsigned int> map(maxLabel - minLabel + 1, maxval);
+		for(std::size_t position = 0; position < m_labelOrder.size(); ++position)
+			map[m_labelOrder[position] - minLabel] = (unsigned int)position;
+		m_labelMap = Mapping(map, minLabel);
+	}
+
 	std::vector<int> m_labelOrder;
+	Mapping m_labelMap;
 };
 
 }
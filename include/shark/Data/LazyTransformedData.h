@@ -0,0 +1,227 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Lazily transformed datasets with a bounded result cache
+ *
+ *
+ * \par
+ * transform() materializes the complete transformed dataset before the
+ * first batch of it is used. For cheap maps like mean-centering this
+ * triples the peak memory of a preprocessing chain, since the original
+ * data, the transformed copy and the consumer's working set are alive
+ * at the same time. The adaptor in this file instead applies the
+ * functor when a batch is accessed and keeps the computed batches in a
+ * cache whose size is bounded by a byte budget.
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2016
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_DATA_LAZYTRANSFORMEDDATA_H
+#define SHARK_DATA_LAZYTRANSFORMEDDATA_H
+
+#include <shark/Data/Dataset.h>
+
+#include <deque>
+#include <vector>
+
+namespace shark {
+
+namespace detail {
+
+/// Estimate of the memory held by a cached batch
+///@{
+template<class BatchT>
+std::size_t batchCacheBytes(BatchT const& batch){
+	return boost::size(batch) * sizeof(typename BatchT::value_type);
+}
+template<class U>
+std::size_t batchCacheBytes(blas::matrix<U> const& batch){
+	return batch.size1() * batch.size2() * sizeof(U);
+}
+template<class U>
+std::size_t batchCacheBytes(blas::compressed_matrix<U> const& batch){
+	return batch.nnz() * (sizeof(U) + sizeof(std::size_t));
+}
+///@}
+
+}
+
+/**
+ * \ingroup shark_globals
+ *
+ * @{
+ */
+
+/// \brief Dataset adaptor applying a functor to batches on access.
+///
+/// The adaptor holds the original dataset - sharing its batches, not
+/// copying them - and computes a transformed batch the first time it is
+/// requested. Computed batches are cached; when the combined size of the
+/// cached batches exceeds the byte budget, the batches computed longest
+/// ago are dropped and recomputed on their next access. With a small
+/// budget a chain like normalize-transform-train therefore only ever
+/// holds a handful of transformed batches next to the original data
+/// instead of a full transformed copy.
+///
+/// The functor is applied exactly as by transform(): batch-wise if it
+/// accepts a whole batch, element by element otherwise. The returned
+/// references stay valid until the batch is evicted, i.e. at least until
+/// the next call to batch(). The adaptor is not thread-safe.
+template<class T, class Functor>
+class LazyTransformedData{
+public:
+	typedef typename detail::TransformedDataElement<Functor, T>::type element_type;
+	typedef typename Batch<element_type>::type batch_type;
+
+	LazyTransformedData(){}
+
+	/// \brief Adapts a dataset with a transformation functor.
+	///
+	/// \param data       the dataset to be transformed
+	/// \param functor    the transformation applied to every batch
+	/// \param cacheBytes budget for the combined size of cached result batches
+	LazyTransformedData(
+		Data<T> const& data,
+		Functor const& functor,
+		std::size_t cacheBytes = std::size_t(1) << 28
+	): m_data(data)
+	, m_functor(functor)
+	, m_slots(data.numberOfBatches())
+	, m_cacheBytes(cacheBytes)
+	, m_usedBytes(0){}
+
+	/// \brief Returns the number of batches of the container.
+	std::size_t numberOfBatches()const{
+		return m_data.numberOfBatches();
+	}
+	/// \brief Returns the total number of elements.
+	std::size_t numberOfElements()const{
+		return m_data.numberOfElements();
+	}
+	/// \brief Returns the underlying untransformed dataset.
+	Data<T> const& dataset()const{
+		return m_data;
+	}
+	/// \brief Returns the transformation functor.
+	Functor const& functor()const{
+		return m_functor;
+	}
+	/// \brief Returns the budget for the combined size of cached batches.
+	std::size_t cacheBytes()const{
+		return m_cacheBytes;
+	}
+	/// \brief Sets the budget for the combined size of cached batches.
+	void setCacheBytes(std::size_t cacheBytes){
+		m_cacheBytes = cacheBytes;
+		shrinkToBudget(0);
+	}
+	/// \brief Returns the combined size of the currently cached batches.
+	std::size_t usedBytes()const{
+		return m_usedBytes;
+	}
+
+	/// \brief Returns the i-th transformed batch, computing it if it is not cached.
+	batch_type const& batch(std::size_t i){
+		RANGE_CHECK(i < m_slots.size());
+		if(!m_slots[i].cached)
+			compute(i);
+		return m_slots[i].value;
+	}
+
+private:
+	struct CacheSlot{
+		batch_type value;
+		std::size_t bytes;
+		bool cached;
+		CacheSlot(): bytes(0), cached(false){}
+	};
+
+	//batch-wise functors get the whole batch
+	batch_type apply(typename Data<T>::const_batch_reference input, boost::mpl::true_)const{
+		return m_functor(input);
+	}
+	//element-wise functors are mapped over the batch
+	batch_type apply(typename Data<T>::const_batch_reference input, boost::mpl::false_)const{
+		return createBatch<element_type>(boost::adaptors::transform(input, m_functor));
+	}
+
+	void compute(std::size_t i){
+		typename CanBeCalled<Functor, typename Data<T>::batch_type>::type tag;
+		batch_type result = apply(m_data.batch(i), tag);
+		std::size_t bytes = detail::batchCacheBytes(result);
+		shrinkToBudget(bytes);
+		using std::swap;
+		swap(m_slots[i].value, result);
+		m_slots[i].bytes = bytes;
+		m_slots[i].cached = true;
+		m_usedBytes += bytes;
+		m_window.push_back(i);
+	}
+
+	//drops the oldest cached batches until extraBytes more fit the budget
+	void shrinkToBudget(std::size_t extraBytes){
+		while(!m_window.empty() && m_usedBytes + extraBytes > m_cacheBytes){
+			std::size_t victim = m_window.front();
+			m_window.pop_front();
+			m_slots[victim].value = batch_type();
+			m_slots[victim].cached = false;
+			m_usedBytes -= m_slots[victim].bytes;
+		}
+	}
+
+	Data<T> m_data;
+	Functor m_functor;
+	std::vector<CacheSlot> m_slots;
+	std::deque<std::size_t> m_window;//cached batches, oldest first
+	std::size_t m_cacheBytes;
+	std::size_t m_usedBytes;
+};
+
+/// \brief Creates a lazily transformed view of a dataset.
+///
+/// This is the lazy counterpart of transform(): no batch is computed
+/// before it is accessed and at most cacheBytes worth of transformed
+/// batches are kept alive.
+///
+/// \param data       the dataset to be transformed
+/// \param functor    the transformation applied to every batch
+/// \param cacheBytes budget for the combined size of cached result batches
+template<class T, class Functor>
+LazyTransformedData<T, Functor> lazyTransform(
+	Data<T> const& data,
+	Functor const& functor,
+	std::size_t cacheBytes = std::size_t(1) << 28
+){
+	return LazyTransformedData<T, Functor>(data, functor, cacheBytes);
+}
+
+/** @}*/
+
+} // namespace shark
+#endif // SHARK_DATA_LAZYTRANSFORMEDDATA_H
@@ -0,0 +1,165 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Narrow in-memory storage for low-cardinality features
+ *
+ *
+ * \par
+ * Data<RealVector> stores every feature as a double even when a column
+ * only ever holds small categorical codes, wasting a factor of eight in
+ * footprint. The batch machinery is generic in the element type, so a
+ * dataset of 8-bit codes can simply be held as Data<UInt8Vector> with
+ * matrix<uint8_t> batches. This file provides the conversions between
+ * the wide and the narrow representation: a checked narrowing of an
+ * existing dataset, an eager widening back to doubles and a lazy
+ * widening that produces double batches on access under a byte budget,
+ * so consumers expecting RealMatrix batches can work off the narrow
+ * storage without a resident double copy.
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2016
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_DATA_NARROWSTORAGE_H
+#define SHARK_DATA_NARROWSTORAGE_H
+
+#include <shark/Data/Dataset.h>
+#include <shark/Data/LazyTransformedData.h>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace shark {
+
+namespace detail {
+
+//integral storage types must represent the value exactly
+template<class StorageT>
+bool representableByStorage(double value, std::true_type){
+	StorageT narrowed = static_cast<StorageT>(value);
+	return static_cast<double>(narrowed) == value;
+}
+//floating point storage is allowed to round
+template<class StorageT>
+bool representableByStorage(double, std::false_type){
+	return true;
+}
+
+}
+
+/**
+ * \ingroup shark_globals
+ *
+ * @{
+ */
+
+/// \brief Widens a batch of narrow storage values into a double batch.
+///
+/// Usable directly as the functor of a LazyTransformedData, see
+/// lazyWidenStorage().
+template<class StorageT>
+struct WidenBatch{
+	typedef RealVector result_type;
+	RealMatrix operator()(blas::matrix<StorageT> const& batch)const{
+		RealMatrix wide(batch.size1(), batch.size2());
+		for(std::size_t i = 0; i != batch.size1(); ++i)
+			for(std::size_t j = 0; j != batch.size2(); ++j)
+				wide(i,j) = batch(i,j);
+		return wide;
+	}
+};
+
+/// \brief Converts a dataset of doubles into a narrow storage type.
+///
+/// Every value is checked to be exactly representable by the storage
+/// type; for a dataset of 8-bit categorical codes mistakenly containing
+/// a continuous column this throws instead of silently truncating.
+/// Floating point storage types are allowed to round. The batch
+/// structure of the dataset is kept.
+///
+/// \param data the dataset to be narrowed
+/// \tparam StorageT the narrow element type, e.g. std::uint8_t
+template<class StorageT>
+Data<blas::vector<StorageT> > narrowStorage(Data<RealVector> const& data){
+	int batches = (int)data.numberOfBatches();
+	Data<blas::vector<StorageT> > result(batches);
+	bool representable = true;
+	SHARK_PARALLEL_FOR(int b = 0; b < batches; ++b){
+		RealMatrix const& batch = data.batch(b);
+		blas::matrix<StorageT> narrowed(batch.size1(), batch.size2());
+		for(std::size_t i = 0; i != batch.size1(); ++i){
+			for(std::size_t j = 0; j != batch.size2(); ++j){
+				if(!detail::representableByStorage<StorageT>(
+					batch(i,j), typename std::is_integral<StorageT>::type()
+				))
+					representable = false;
+				narrowed(i,j) = static_cast<StorageT>(batch(i,j));
+			}
+		}
+		using std::swap;
+		swap(result.batch(b), narrowed);
+	}
+	if(!representable)
+		throw SHARKEXCEPTION("[narrowStorage] value is not representable by the narrow storage type");
+	return result;
+}
+
+/// \brief Converts a narrow dataset back into a dataset of doubles.
+///
+/// The batch structure of the dataset is kept.
+template<class StorageT>
+Data<RealVector> widenStorage(Data<blas::vector<StorageT> > const& data){
+	int batches = (int)data.numberOfBatches();
+	Data<RealVector> result(batches);
+	WidenBatch<StorageT> widen;
+	SHARK_PARALLEL_FOR(int b = 0; b < batches; ++b)
+		result.batch(b) = widen(data.batch(b));
+	return result;
+}
+
+/// \brief Creates a view delivering double batches from narrow storage on access.
+///
+/// Only the narrow dataset stays resident; double batches are produced
+/// when accessed and at most cacheBytes worth of them are kept alive.
+/// This lets batch consumers expecting RealMatrix run off narrow storage
+/// at a small, bounded widening cost.
+///
+/// \param data the narrow dataset
+/// \param cacheBytes budget for the combined size of cached double batches
+template<class StorageT>
+LazyTransformedData<blas::vector<StorageT>, WidenBatch<StorageT> > lazyWidenStorage(
+	Data<blas::vector<StorageT> > const& data,
+	std::size_t cacheBytes = std::size_t(1) << 28
+){
+	return lazyTransform(data, WidenBatch<StorageT>(), cacheBytes);
+}
+
+/** @}*/
+
+} // namespace shark
+#endif // SHARK_DATA_NARROWSTORAGE_H
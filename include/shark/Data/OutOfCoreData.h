@@ -0,0 +1,211 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Out-of-core access to datasets larger than main memory
+ *
+ *
+ * \par
+ * Data<T> keeps all batches resident in memory. For datasets exceeding
+ * the available RAM this file provides a container that spills its
+ * batches to a backing file and transparently reloads them on access,
+ * keeping only a configurable window of batches resident. Since the
+ * error functions and SGD-style trainers iterate batches in order, the
+ * window policy combined with sequential read-ahead keeps the working
+ * set warm while training on datasets many times the size of RAM.
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2016
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_DATA_OUTOFCOREDATA_H
+#define SHARK_DATA_OUTOFCOREDATA_H
+
+#include <shark/Data/Dataset.h>
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+#include <deque>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace shark {
+
+/**
+ * \ingroup shark_globals
+ *
+ * @{
+ */
+
+/// \brief Batch container spilling cold batches to a backing file.
+///
+/// The container is filled from an ordinary Data<T> object. Every batch is
+/// serialized into the backing file; afterwards only a window of batches
+/// whose combined size stays below the resident budget is kept in memory.
+/// Accessing a non-resident batch reloads it from the file and evicts the
+/// oldest resident batches until the budget holds again, so iterating the
+/// container in batch order - as the error functions and the SGD-style
+/// trainers do - streams the file front to back with one read per batch.
+/// After a batch is loaded, the following batch is read ahead while the
+/// file position is still sequential.
+///
+/// The returned references stay valid until the batch is evicted, i.e. at
+/// least until residentBytes() worth of other batches has been accessed.
+/// The container is not thread-safe.
+template<class T>
+class OutOfCoreData{
+public:
+	typedef typename Batch<T>::type batch_type;
+
+	/// \brief Spills the batches of a dataset to a backing file.
+	///
+	/// \param data          The dataset to be spilled; its batch structure is kept
+	/// \param backingFile   File receiving the serialized batches, overwritten if present
+	/// \param residentBytes Budget for the combined size of resident batches
+	OutOfCoreData(
+		Data<T> const& data,
+		std::string const& backingFile,
+		std::size_t residentBytes = std::size_t(1) << 28
+	): m_fileName(backingFile), m_residentBytes(residentBytes), m_usedBytes(0){
+		std::ofstream out(backingFile.c_str(), std::ios::binary | std::ios::trunc);
+		if(!out)
+			throw std::invalid_argument("[OutOfCoreData] backing file cannot be opened for writing");
+		m_slots.resize(data.numberOfBatches());
+		for(std::size_t b = 0; b != data.numberOfBatches(); ++b){
+			//serialize the batch into its own self-contained blob so that
+			//it can later be reloaded without replaying the whole archive
+			std::ostringstream blob(std::ios::binary);
+			{
+				boost::archive::binary_oarchive archive(blob);
+				archive << data.batch(b);
+			}
+			std::string const& bytes = blob.str();
+			m_slots[b].offset = out.tellp();
+			m_slots[b].length = bytes.size();
+			m_slots[b].size = boost::size(data.batch(b));
+			m_slots[b].resident = false;
+			out.write(bytes.data(), bytes.size());
+		}
+		if(!out)
+			throw SHARKEXCEPTION("[OutOfCoreData] error while writing the backing file");
+		out.close();
+		m_file.open(backingFile.c_str(), std::ios::binary);
+		if(!m_file)
+			throw std::invalid_argument("[OutOfCoreData] backing file cannot be opened for reading");
+	}
+	OutOfCoreData(OutOfCoreData const&) = delete;
+	OutOfCoreData& operator=(OutOfCoreData const&) = delete;
+
+	/// \brief Returns the number of batches of the container.
+	std::size_t numberOfBatches()const{
+		return m_slots.size();
+	}
+	/// \brief Returns the total number of elements.
+	std::size_t numberOfElements()const{
+		std::size_t elements = 0;
+		for(std::size_t b = 0; b != m_slots.size(); ++b)
+			elements += m_slots[b].size;
+		return elements;
+	}
+	/// \brief Returns the budget for the combined size of resident batches.
+	std::size_t residentBytes()const{
+		return m_residentBytes;
+	}
+	/// \brief Sets the budget for the combined size of resident batches.
+	void setResidentBytes(std::size_t residentBytes){
+		m_residentBytes = residentBytes;
+		shrinkToBudget(0);
+	}
+	/// \brief Returns the combined serialized size of the resident batches.
+	std::size_t usedBytes()const{
+		return m_usedBytes;
+	}
+
+	/// \brief Returns the i-th batch, reloading it from the backing file if necessary.
+	batch_type const& batch(std::size_t i){
+		RANGE_CHECK(i < m_slots.size());
+		if(!m_slots[i].resident)
+			load(i);
+		//read ahead: the next access is most likely the next batch
+		std::size_t next = i + 1;
+		if(next != m_slots.size() && !m_slots[next].resident
+		&& m_usedBytes + m_slots[next].length <= m_residentBytes)
+			load(next);
+		return m_slots[i].value;
+	}
+
+private:
+	struct BatchSlot{
+		batch_type value;
+		std::streamoff offset;
+		std::size_t length;//serialized size in bytes
+		std::size_t size;//number of elements
+		bool resident;
+	};
+
+	void load(std::size_t i){
+		shrinkToBudget(m_slots[i].length);
+		m_file.clear();
+		m_file.seekg(m_slots[i].offset);
+		std::string bytes(m_slots[i].length, '\0');
+		m_file.read(&bytes[0], bytes.size());
+		if(!m_file)
+			throw SHARKEXCEPTION("[OutOfCoreData] error while reading the backing file");
+		std::istringstream blob(bytes, std::ios::binary);
+		boost::archive::binary_iarchive archive(blob);
+		archive >> m_slots[i].value;
+		m_slots[i].resident = true;
+		m_usedBytes += m_slots[i].length;
+		m_window.push_back(i);
+	}
+
+	//evicts the oldest resident batches until extraBytes more fit the budget
+	void shrinkToBudget(std::size_t extraBytes){
+		while(!m_window.empty() && m_usedBytes + extraBytes > m_residentBytes){
+			std::size_t victim = m_window.front();
+			m_window.pop_front();
+			m_slots[victim].value = batch_type();
+			m_slots[victim].resident = false;
+			m_usedBytes -= m_slots[victim].length;
+		}
+	}
+
+	std::string m_fileName;
+	std::ifstream m_file;
+	std::vector<BatchSlot> m_slots;
+	std::deque<std::size_t> m_window;//resident batches, oldest first
+	std::size_t m_residentBytes;
+	std::size_t m_usedBytes;
+};
+
+/** @}*/
+
+} // namespace shark
+#endif // SHARK_DATA_OUTOFCOREDATA_H
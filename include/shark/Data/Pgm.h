@@ -36,12 +36,14 @@
 #define SHARK_DATA_IMPORT_PGM_H
 
 #include <fstream>
+#include <exception>
 
 #include <boost/format.hpp>
 #include <boost/filesystem.hpp>
 #include <boost/archive/text_oarchive.hpp>
 
 
+#include <shark/Core/OpenMP.h>
 #include <shark/LinAlg/Base.h>
 #include <shark/Data/Dataset.h>
 
@@ -79,6 +81,36 @@ void importPGM( std::string const& fileName, std::vector<unsigned char>& ppData,
 		throw SHARKEXCEPTION( "[importPGM] error reading file: " + fileName );
 }
 
+/// \brief Downscales a raw gray image by averaging blocks of factor x factor pixels.
+///
+/// Border blocks which the image does not fill completely are averaged over
+/// the pixels it provides. The image buffer and its sizes are replaced by
+/// the scaled versions.
+inline void downscalePGM( std::vector<unsigned char>& data, std::size_t& sx, std::size_t& sy, std::size_t factor )
+{
+	std::size_t nx = (sx + factor - 1) / factor;
+	std::size_t ny = (sy + factor - 1) / factor;
+	std::vector<unsigned char> scaled(nx*ny);
+	for(std::size_t y = 0; y != ny; y++){
+		for(std::size_t x = 0; x != nx; x++){
+			std::size_t sum = 0;
+			std::size_t count = 0;
+			std::size_t endV = std::min((y+1)*factor, sy);
+			std::size_t endU = std::min((x+1)*factor, sx);
+			for(std::size_t v = y*factor; v != endV; v++){
+				for(std::size_t u = x*factor; u != endU; u++){
+					sum += data[v*sx+u];
+					++count;
+				}
+			}
+			scaled[y*nx+x] = (unsigned char)((sum + count/2) / count);
+		}
+	}
+	data.swap(scaled);
+	sx = nx;
+	sy = ny;
+}
+
 /**
  * \ingroup shark_globals
  *
@@ -281,6 +313,76 @@ void importPGMSet(const std::string &p, Data<T> &set, Data<ImageInformation> &se
 	setInfo = createDataFromRange(tmpInfo);
 }
 
+/// \brief Import PGM images scanning a directory recursively, decoding in parallel
+///
+/// The directory is scanned recursively for .pgm files as by importPGMDir.
+/// The files are then read and decoded by parallel worker threads into
+/// preallocated slots of the image container, so that reading one file
+/// overlaps with decoding others and the import is no longer bound by the
+/// latency of loading one file at a time. With a downscale factor greater
+/// than one every image is additionally reduced on load by averaging
+/// blocks of factor x factor pixels, before it is stored.
+///
+/// \param  p          Directory
+/// \param  set        Set storing images
+/// \param  setInfo    Vector storing image informations
+/// \param  downscale  Factor by which every image is downscaled on load, default 1 (no scaling)
+template<class T>
+void importPGMSetParallel(
+	const std::string &p,
+	Data<T> &set,
+	Data<ImageInformation> &setInfo,
+	std::size_t downscale = 1
+){
+	SHARK_CHECK(downscale > 0, "[importPGMSetParallel] downscale factor must be positive");
+	if (!boost::filesystem::is_directory(p))
+		throw( std::invalid_argument( "[importPGMSetParallel] cannot open file" ) );
+
+	//scan the directory for image files
+	std::vector<std::string> files;
+	std::vector<std::string> names;
+	for (boost::filesystem::recursive_directory_iterator itr(p); itr!=boost::filesystem::recursive_directory_iterator(); ++itr) {
+		if (boost::filesystem::is_regular(itr->status())) {
+			if ((boost::filesystem::extension(itr->path()) == ".PGM") ||
+			    (boost::filesystem::extension(itr->path()) == ".pgm")) {
+				files.push_back(itr->path().string());
+				names.push_back(itr->path().filename().string());
+			}
+		}
+	}
+
+	//read and decode the files into their preallocated slots in parallel;
+	//exceptions must not leave the parallel region, so the first one is
+	//captured and rethrown afterwards
+	std::vector<T> images(files.size());
+	std::vector<ImageInformation> info(files.size());
+	std::exception_ptr error;
+	SHARK_PARALLEL_FOR(int i = 0; i < (int)files.size(); i++){
+		try{
+			std::vector<unsigned char> raw;
+			std::size_t sx = 0;
+			std::size_t sy = 0;
+			detail::importPGM(files[i], raw, sx, sy);
+			if (downscale > 1)
+				detail::downscalePGM(raw, sx, sy, downscale);
+			images[i].resize(sx*sy);
+			std::copy(raw.begin(), raw.end(), images[i].begin());
+			info[i].x = sx;
+			info[i].y = sy;
+			info[i].name = names[i];
+		}
+		catch(...){
+			SHARK_CRITICAL_REGION{
+				if (!error) error = std::current_exception();
+			}
+		}
+	}
+	if (error) std::rethrow_exception(error);
+
+	set = createDataFromRange(images);
+	setInfo = createDataFromRange(info);
+}
+
 /** @}*/
 
 } // end namespace shark
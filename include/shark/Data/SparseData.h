@@ -42,8 +42,10 @@
 #define SHARK_DATA_SPARSEDATA_H
 
 #include <shark/Core/DLLSupport.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Core/utility/KeyValuePair.h>
 #include <shark/Data/Dataset.h>
+#include <shark/Models/AbstractModel.h>
 #include <fstream>
 
 namespace shark {
@@ -161,6 +163,61 @@ SHARK_EXPORT_SYMBOL void importSparseData(
 );
 
 
+/// \brief Import data from a sparse data (libSVM) stream and apply a preprocessing model to the inputs.
+///
+/// The model - typically a Normalizer trained on an earlier dataset - is
+/// applied to the input batches in place right after parsing. Compared to
+/// importing first and calling transform() afterwards this does not
+/// materialize a second, untransformed copy of the dataset. Labels are not
+/// transformed.
+///
+/// \param  dataset       container storing the loaded data
+/// \param  stream        stream to be read from
+/// \param  preprocessor  model applied to every input batch after parsing
+/// \param  highestIndex  highest feature index, or 0 for auto-detection
+/// \param  batchSize     size of batch
+template<class InputT, class LabelT>
+void importSparseData(
+	LabeledData<InputT, LabelT>& dataset,
+	std::istream& stream,
+	AbstractModel<InputT, InputT> const& preprocessor,
+	unsigned int highestIndex = 0,
+	std::size_t batchSize = LabeledData<InputT, LabelT>::DefaultBatchSize
+){
+	importSparseData(dataset,stream,highestIndex,batchSize);
+	SHARK_PARALLEL_FOR(int i = 0; i < (int)dataset.numberOfBatches(); ++i){
+		typename Batch<InputT>::type transformed;
+		preprocessor.eval(dataset.batch(i).input,transformed);
+		dataset.batch(i).input = transformed;
+	}
+}
+
+/// \brief Import data from a sparse data (libSVM) file and apply a preprocessing model to the inputs.
+///
+/// See the stream overload for details.
+///
+/// \param  dataset       container storing the loaded data
+/// \param  fn            the file to be read from
+/// \param  preprocessor  model applied to every input batch after parsing
+/// \param  highestIndex  highest feature index, or 0 for auto-detection
+/// \param  batchSize     size of batch
+template<class InputT, class LabelT>
+void importSparseData(
+	LabeledData<InputT, LabelT>& dataset,
+	std::string fn,
+	AbstractModel<InputT, InputT> const& preprocessor,
+	unsigned int highestIndex = 0,
+	std::size_t batchSize = LabeledData<InputT, LabelT>::DefaultBatchSize
+){
+	importSparseData(dataset,fn,highestIndex,batchSize);
+	SHARK_PARALLEL_FOR(int i = 0; i < (int)dataset.numberOfBatches(); ++i){
+		typename Batch<InputT>::type transformed;
+		preprocessor.eval(dataset.batch(i).input,transformed);
+		dataset.batch(i).input = transformed;
+	}
+}
+
+
 /// \brief Export classification data to sparse data (libSVM) format.
 ///
 /// \param  dataset     Container storing the  data
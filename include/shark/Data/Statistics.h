@@ -35,6 +35,7 @@
 #define SHARK_DATA_STATISTICS_H
 
 #include <shark/Data/Dataset.h>
+#include <shark/Core/OpenMP.h>
 
 /**
 * \ingroup shark_globals
@@ -46,6 +46,7 @@
 #define SHARK_DATA_WEIGHTED_DATASET_H
 
 #include <shark/Data/Dataset.h>
+#include <shark/Data/DataView.h>
 namespace shark {
 	
 namespace detail{
@@ -567,6 +568,49 @@ double sumOfWeights(WeightedLabeledData<InputType,LabelType> const& dataset){
 	return weightSum;
 }
 
+///\brief Removes all elements with zero weight from a weighted dataset.
+///
+/// Bootstrap and boosting style weightings set many weights to exactly zero,
+/// yet every pass over the weighted dataset still evaluates the model on
+/// those elements. This function gathers the elements with nonzero weight
+/// into newly packed batches and returns them together with their weights;
+/// the given dataset is left unchanged.
+template<class InputType, class LabelType>
+WeightedLabeledData<InputType, LabelType> compactWeights(
+	WeightedLabeledData<InputType, LabelType> const& dataset,
+	std::size_t batchSize = WeightedLabeledData<InputType, LabelType>::DefaultBatchSize
+){
+	//collect the positions and weights of the elements to be kept
+	std::vector<std::size_t> kept;
+	std::vector<double> keptWeights;
+	std::size_t element = 0;
+	for(std::size_t b = 0; b != dataset.numberOfBatches(); ++b){
+		auto const& weights = dataset.batch(b).weight;
+		for(std::size_t e = 0; e != weights.size(); ++e, ++element){
+			if(weights(e) != 0.0){
+				kept.push_back(element);
+				keptWeights.push_back(weights(e));
+			}
+		}
+	}
+
+	//gather the kept elements into packed batches
+	DataView<LabeledData<InputType, LabelType> const> view(dataset.data());
+	LabeledData<InputType, LabelType> packed = toDataset(subset(view, kept), batchSize);
+
+	//store the weights with the same batch structure as the packed data
+	Data<double> packedWeights(packed.numberOfBatches());
+	std::size_t pos = 0;
+	for(std::size_t b = 0; b != packed.numberOfBatches(); ++b){
+		std::size_t size = shark::size(packed.batch(b));
+		RealVector& batchWeights = packedWeights.batch(b);
+		batchWeights.resize(size);
+		for(std::size_t e = 0; e != size; ++e, ++pos)
+			batchWeights(e) = keptWeights[pos];
+	}
+	return WeightedLabeledData<InputType, LabelType>(packed, packedWeights);
+}
+
 inline std::size_t numberOfClasses(WeightedUnlabeledData<unsigned int> const& labels){
 	return numberOfClasses(labels.data());
 }
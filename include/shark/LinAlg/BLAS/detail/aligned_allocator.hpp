@@ -0,0 +1,194 @@
+/*!
+ * \brief       Aligned, thread-local arena backed allocator for dense containers
+ *
+ * \author      O. Krause
+ * \date        2016
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_LINALG_BLAS_DETAIL_ALIGNED_ALLOCATOR_HPP
+#define SHARK_LINALG_BLAS_DETAIL_ALIGNED_ALLOCATOR_HPP
+
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace shark {
+namespace blas {
+namespace detail {
+
+///\brief Allocates a block whose address is a multiple of alignment.
+///
+/// The original pointer is stored directly in front of the returned block
+/// so that aligned_free can recover it.
+inline void* aligned_malloc(std::size_t bytes, std::size_t alignment){
+	void* raw = std::malloc(bytes + alignment + sizeof(void*));
+	if(raw == 0)
+		throw std::bad_alloc();
+	std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+	std::uintptr_t aligned = (address + alignment - 1) & ~std::uintptr_t(alignment - 1);
+	reinterpret_cast<void**>(aligned)[-1] = raw;
+	return reinterpret_cast<void*>(aligned);
+}
+
+inline void aligned_free(void* pointer){
+	if(pointer != 0)
+		std::free(reinterpret_cast<void**>(pointer)[-1]);
+}
+
+///\brief Thread-local pool of aligned memory blocks in power-of-two size classes.
+///
+/// Freed blocks are cached in per-size-class free lists and reused by later
+/// allocations of the same class, so that the frequent allocate/free cycles
+/// of expression template temporaries do not hit the global heap. Every
+/// thread owns its own arena, which makes both paths lock free. Blocks above
+/// the caching threshold and everything beyond the per-thread cache budget
+/// go straight to malloc/free.
+class memory_arena{
+public:
+	static const std::size_t alignment = 64;
+
+	memory_arena():m_freeLists(numClasses), m_cachedBytes(0){}
+	memory_arena(memory_arena const&) = delete;
+	memory_arena& operator=(memory_arena const&) = delete;
+	~memory_arena(){
+		for(std::size_t c = 0; c != numClasses; ++c){
+			for(std::size_t i = 0; i != m_freeLists[c].size(); ++i)
+				aligned_free(m_freeLists[c][i]);
+		}
+	}
+
+	void* allocate(std::size_t bytes){
+		std::size_t c = sizeClass(bytes);
+		if(c >= numClasses)
+			return aligned_malloc(bytes, alignment);
+		std::vector<void*>& freeList = m_freeLists[c];
+		if(!freeList.empty()){
+			void* block = freeList.back();
+			freeList.pop_back();
+			m_cachedBytes -= classSize(c);
+			return block;
+		}
+		return aligned_malloc(classSize(c), alignment);
+	}
+
+	void deallocate(void* pointer, std::size_t bytes){
+		std::size_t c = sizeClass(bytes);
+		if(c >= numClasses || m_cachedBytes + classSize(c) > maxCachedBytes){
+			aligned_free(pointer);
+			return;
+		}
+		m_freeLists[c].push_back(pointer);
+		m_cachedBytes += classSize(c);
+	}
+
+private:
+	//size classes are powers of two from 64 bytes to 4MB; at most 32MB are cached
+	static const std::size_t minClassShift = 6;
+	static const std::size_t numClasses = 17;
+	static const std::size_t maxCachedBytes = std::size_t(1) << 25;
+
+	static std::size_t classSize(std::size_t c){
+		return std::size_t(1) << (c + minClassShift);
+	}
+	///\brief Smallest size class whose blocks hold at least the requested bytes.
+	static std::size_t sizeClass(std::size_t bytes){
+		std::size_t c = 0;
+		while(c < numClasses && classSize(c) < bytes)
+			++c;
+		return c;
+	}
+
+	std::vector<std::vector<void*> > m_freeLists;
+	std::size_t m_cachedBytes;
+};
+
+inline memory_arena& thread_arena(){
+	static thread_local memory_arena arena;
+	return arena;
+}
+
+}
+
+///\brief Allocator serving 64 byte aligned memory from a thread-local arena.
+///
+/// This is the default allocator of the dense blas containers. The alignment
+/// guarantees that simd kernels can always issue aligned loads on container
+/// storage, and the thread-local arena in the back removes malloc contention
+/// when many threads create and destroy expression temporaries in parallel,
+/// e.g. during concurrent error function evaluations. Memory freed on a
+/// different thread than it was allocated on simply migrates to that
+/// thread's arena.
+template<class T>
+class aligned_allocator{
+public:
+	typedef T value_type;
+	typedef T* pointer;
+	typedef T const* const_pointer;
+	typedef T& reference;
+	typedef T const& const_reference;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template<class U>
+	struct rebind{
+		typedef aligned_allocator<U> other;
+	};
+
+	aligned_allocator(){}
+	template<class U>
+	aligned_allocator(aligned_allocator<U> const&){}
+
+	pointer allocate(size_type n, void const* = 0){
+		return static_cast<pointer>(detail::thread_arena().allocate(n * sizeof(T)));
+	}
+	void deallocate(pointer p, size_type n){
+		detail::thread_arena().deallocate(p, n * sizeof(T));
+	}
+
+	size_type max_size()const{
+		return std::size_t(-1) / sizeof(T);
+	}
+	template<class U, class... Args>
+	void construct(U* p, Args&&... args){
+		::new(static_cast<void*>(p)) U(std::forward<Args>(args)...);
+	}
+	template<class U>
+	void destroy(U* p){
+		p->~U();
+	}
+};
+
+//all instances share the per-thread arenas and are therefore interchangeable
+template<class T, class U>
+bool operator==(aligned_allocator<T> const&, aligned_allocator<U> const&){
+	return true;
+}
+template<class T, class U>
+bool operator!=(aligned_allocator<T> const&, aligned_allocator<U> const&){
+	return false;
+}
+
+}}
+#endif
@@ -404,6 +404,17 @@ struct scalar_sigmoid {
 	}
 };
 
+template<class T>
+struct scalar_safe_exp {
+	typedef T argument_type;
+	typedef argument_type result_type;
+	static const bool zero_identity = false;
+
+	result_type operator()(argument_type x)const {
+		return shark::safeExp(x);
+	}
+};
+
 template<class T, class ScalarType>
 struct scalar_less_than{
 	typedef T argument_type;
@@ -715,9 +726,9 @@ private:
 		for(;iter != end;++iter,++nnz){
 			result = m_functor(result,*iter);
 		}
-		//apply final operator f(0,v)
+		//apply final operator f(v,0) to account for the implicit zero elements
 		if(nnz != v.size())
-			result = m_functor(result,*iter);
+			result = m_functor(result,typename F::argument2_type());
 		return result;
 	}
 	functor_type m_functor;
@@ -32,6 +32,7 @@
 #define SHARK_LINALG_BLAS_KERNELS_DEFAULT_GEMM_HPP
 
 #include "../gemv.hpp"
+#include "simd_gemm.hpp"
 #include "../../vector.hpp"
 #include <boost/mpl/bool.hpp>
 
@@ -129,7 +130,158 @@ void gemm_impl(
 	}
 }
 
-	
+
+//special case: row-major sparse times dense argument with dense result (2.1)
+//=> CSR x dense product: every nonzero a_ik contributes the scaled row k of
+//the dense argument to row i of the result, so each result row is a short
+//sequence of axpy updates over contiguous memory. Rows are distributed over
+//threads in blocks holding roughly the same number of nonzeros, so skewed
+//sparsity patterns do not leave threads idle.
+template<class M, class E1, class E2>
+void gemm_sparse_dense(
+	matrix_expression<E1, cpu_tag> const& e1,
+	matrix_expression<E2, cpu_tag> const& e2,
+	matrix_expression<M, cpu_tag>& m,
+	typename M::value_type alpha,
+	dense_tag //result category
+) {
+	std::size_t size1 = e1().size1();
+	//prefix sum of the nonzeros of each row, used to balance the blocks
+	std::vector<std::size_t> nnzPrefix(size1 + 1, 0);
+	for(std::size_t i = 0; i != size1; ++i){
+		auto e1Row = row(e1,i);
+		nnzPrefix[i + 1] = nnzPrefix[i] + std::distance(e1Row.begin(), e1Row.end());
+	}
+	std::size_t nnz = nnzPrefix[size1];
+	if(nnz == 0)
+		return;
+	std::size_t numBlocks = std::min(SHARK_NUM_THREADS, size1);
+	//block b starts at the first row whose prefix reaches b * nnz/numBlocks
+	std::vector<std::size_t> blockStart(numBlocks + 1, size1);
+	blockStart[0] = 0;
+	for(std::size_t b = 1; b != numBlocks; ++b){
+		std::size_t target = (b * nnz) / numBlocks;
+		blockStart[b] = std::lower_bound(
+			nnzPrefix.begin(), nnzPrefix.end(), target
+		) - nnzPrefix.begin();
+	}
+	SHARK_PARALLEL_FOR(int b = 0; b < (int)numBlocks; ++b){
+		for(std::size_t i = blockStart[b]; i != blockStart[b + 1]; ++i){
+			auto mRow = row(m,i);
+			auto e1Row = row(e1,i);
+			auto end = e1Row.end();
+			for(auto it = e1Row.begin(); it != end; ++it){
+				noalias(mRow) += (alpha * (*it)) * row(e2,it.index());
+			}
+		}
+	}
+}
+
+//sparse result: keep the row-wise matrix-vector products of the general case
+template<class M, class E1, class E2>
+void gemm_sparse_dense(
+	matrix_expression<E1, cpu_tag> const& e1,
+	matrix_expression<E2, cpu_tag> const& e2,
+	matrix_expression<M, cpu_tag>& m,
+	typename M::value_type alpha,
+	sparse_tag //result category
+) {
+	for (std::size_t i = 0; i != e1().size1(); ++i) {
+		auto mat_row = row(m,i);
+		kernels::gemv(trans(e2),row(e1,i),mat_row,alpha);
+	}
+}
+
+//special case: row-major sparse times column-major dense with dense result (2.2)
+//=> gather: result(i,j) is the dot product of the sparse row i with column j
+//of the dense argument, which is contiguous in memory. This avoids the
+//strided accesses the axpy formulation above would produce for this
+//orientation. The same nonzero-balanced row blocks are used for threading.
+template<class M, class E1, class E2>
+void gemm_sparse_dense_gather(
+	matrix_expression<E1, cpu_tag> const& e1,
+	matrix_expression<E2, cpu_tag> const& e2,
+	matrix_expression<M, cpu_tag>& m,
+	typename M::value_type alpha,
+	dense_tag //result category
+) {
+	typedef typename M::value_type value_type;
+	std::size_t size1 = e1().size1();
+	std::size_t size2 = e2().size2();
+	//prefix sum of the nonzeros of each row, used to balance the blocks
+	std::vector<std::size_t> nnzPrefix(size1 + 1, 0);
+	for(std::size_t i = 0; i != size1; ++i){
+		auto e1Row = row(e1,i);
+		nnzPrefix[i + 1] = nnzPrefix[i] + std::distance(e1Row.begin(), e1Row.end());
+	}
+	std::size_t nnz = nnzPrefix[size1];
+	if(nnz == 0)
+		return;
+	std::size_t numBlocks = std::min(SHARK_NUM_THREADS, size1);
+	//block b starts at the first row whose prefix reaches b * nnz/numBlocks
+	std::vector<std::size_t> blockStart(numBlocks + 1, size1);
+	blockStart[0] = 0;
+	for(std::size_t b = 1; b != numBlocks; ++b){
+		std::size_t target = (b * nnz) / numBlocks;
+		blockStart[b] = std::lower_bound(
+			nnzPrefix.begin(), nnzPrefix.end(), target
+		) - nnzPrefix.begin();
+	}
+	SHARK_PARALLEL_FOR(int b = 0; b < (int)numBlocks; ++b){
+		for(std::size_t i = blockStart[b]; i != blockStart[b + 1]; ++i){
+			auto mRow = row(m,i);
+			auto e1Row = row(e1,i);
+			auto end = e1Row.end();
+			for(std::size_t j = 0; j != size2; ++j){
+				auto e2Column = column(e2,j);
+				value_type sum = value_type();
+				for(auto it = e1Row.begin(); it != end; ++it){
+					sum += *it * e2Column(it.index());
+				}
+				mRow(j) += alpha * sum;
+			}
+		}
+	}
+}
+
+//sparse result: keep the row-wise matrix-vector products of the general case
+template<class M, class E1, class E2>
+void gemm_sparse_dense_gather(
+	matrix_expression<E1, cpu_tag> const& e1,
+	matrix_expression<E2, cpu_tag> const& e2,
+	matrix_expression<M, cpu_tag>& m,
+	typename M::value_type alpha,
+	sparse_tag //result category
+) {
+	for (std::size_t i = 0; i != e1().size1(); ++i) {
+		auto mat_row = row(m,i);
+		kernels::gemv(trans(e2),row(e1,i),mat_row,alpha);
+	}
+}
+
+template<class M, class E1, class E2>
+void gemm_impl(
+	matrix_expression<E1, cpu_tag> const& e1,
+	matrix_expression<E2, cpu_tag> const& e2,
+	matrix_expression<M, cpu_tag>& m,
+	typename M::value_type alpha,
+	row_major, row_major, row_major,
+	sparse_tag, dense_tag
+) {
+	gemm_sparse_dense(e1,e2,m,alpha,typename M::evaluation_category::tag());
+}
+
+template<class M, class E1, class E2>
+void gemm_impl(
+	matrix_expression<E1, cpu_tag> const& e1,
+	matrix_expression<E2, cpu_tag> const& e2,
+	matrix_expression<M, cpu_tag>& m,
+	typename M::value_type alpha,
+	row_major, row_major, column_major,
+	sparse_tag, dense_tag
+) {
+	gemm_sparse_dense_gather(e1,e2,m,alpha,typename M::evaluation_category::tag());
+}
 
 
 // case 3.3
@@ -209,30 +361,106 @@ void gemm_impl(
 	gemm_impl(trans(e2),trans(e1),transposedM,alpha,row_major(),transpO2(),transpO1(), Tag2(),Tag1());
 }
 
-//dispatcher
+//storage backed dense arguments with a matching float/double value_type are
+//handled by the packed register blocked kernel in simd_gemm.hpp.
 template<class M, class E1, class E2>
-void gemm(
+struct has_simd_gemm{
+	typedef typename M::value_type value_type;
+	typedef boost::mpl::bool_<
+		(std::is_same<value_type,float>::value || std::is_same<value_type,double>::value)
+		&& std::is_same<typename E1::value_type, value_type>::value
+		&& std::is_same<typename E2::value_type, value_type>::value
+		&& std::is_same<typename M::storage_type::storage_tag, dense_tag>::value
+		&& std::is_same<typename E1::storage_type::storage_tag, dense_tag>::value
+		&& std::is_same<typename E2::storage_type::storage_tag, dense_tag>::value
+	> type;
+};
+
+//simd case with row_major result: the packing of the kernel handles arbitrary
+//strides of the arguments, so we only translate orientations into strides.
+template<class M, class E1, class E2>
+void gemm_simd(
 	matrix_expression<E1, cpu_tag> const& e1,
 	matrix_expression<E2, cpu_tag> const& e2,
 	matrix_expression<M, cpu_tag>& m,
 	typename M::value_type alpha,
-	boost::mpl::false_
-) {
-	SIZE_CHECK(m().size1() == e1().size1());
-	SIZE_CHECK(m().size2() == e2().size2());
-	
+	row_major
+){
+	auto storageA = e1().raw_storage();
+	auto storageB = e2().raw_storage();
+	auto storageC = m().raw_storage();
+	bool rowA = std::is_same<typename E1::orientation, row_major>::value;
+	bool rowB = std::is_same<typename E2::orientation, row_major>::value;
+	detail::dense_gemm_parallel(
+		m().size1(), m().size2(), e1().size2(), alpha,
+		storageA.values,
+		rowA? storageA.leading_dimension : 1,
+		rowA? 1 : storageA.leading_dimension,
+		storageB.values,
+		rowB? storageB.leading_dimension : 1,
+		rowB? 1 : storageB.leading_dimension,
+		storageC.values, storageC.leading_dimension
+	);
+}
+//simd case with column_major result: transform to row_major via A=B*C <=> A^T = C^T B^T
+template<class M, class E1, class E2>
+void gemm_simd(
+	matrix_expression<E1, cpu_tag> const& e1,
+	matrix_expression<E2, cpu_tag> const& e2,
+	matrix_expression<M, cpu_tag>& m,
+	typename M::value_type alpha,
+	column_major
+){
+	matrix_transpose<M> transposedM(m());
+	gemm_simd(trans(e2),trans(e1),transposedM,alpha,row_major());
+}
+
+template<class M, class E1, class E2>
+void gemm_simd_dispatch(
+	matrix_expression<E1, cpu_tag> const& e1,
+	matrix_expression<E2, cpu_tag> const& e2,
+	matrix_expression<M, cpu_tag>& m,
+	typename M::value_type alpha,
+	boost::mpl::true_ //simd kernel applicable
+){
+	gemm_simd(e1,e2,m,alpha,typename M::orientation());
+}
+
+template<class M, class E1, class E2>
+void gemm_simd_dispatch(
+	matrix_expression<E1, cpu_tag> const& e1,
+	matrix_expression<E2, cpu_tag> const& e2,
+	matrix_expression<M, cpu_tag>& m,
+	typename M::value_type alpha,
+	boost::mpl::false_ //no simd kernel, use the generic loop nests
+){
 	typedef typename M::orientation ResultOrientation;
 	typedef typename E1::orientation E1Orientation;
 	typedef typename E2::orientation E2Orientation;
 	typedef typename E1::evaluation_category::tag E1Tag;
 	typedef typename E2::evaluation_category::tag E2Tag;
-	
+
 	gemm_impl(e1, e2, m,alpha,
 		ResultOrientation(),E1Orientation(),E2Orientation(),
 		E1Tag(),E2Tag()
 	);
 }
 
+//dispatcher
+template<class M, class E1, class E2>
+void gemm(
+	matrix_expression<E1, cpu_tag> const& e1,
+	matrix_expression<E2, cpu_tag> const& e2,
+	matrix_expression<M, cpu_tag>& m,
+	typename M::value_type alpha,
+	boost::mpl::false_
+) {
+	SIZE_CHECK(m().size1() == e1().size1());
+	SIZE_CHECK(m().size2() == e2().size2());
+
+	gemm_simd_dispatch(e1, e2, m, alpha, typename has_simd_gemm<M,E1,E2>::type());
+}
+
 }}}
 
 #endif
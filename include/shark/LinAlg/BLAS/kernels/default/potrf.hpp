@@ -31,6 +31,8 @@
 #define SHARK_LINALG_BLAS_KERNELS_DEFAULT_POTRF_HPP
 
 #include "../../expression_types.hpp"
+#include "../gemm.hpp"
+#include "../trsm.hpp"
 #include <boost/mpl/bool.hpp>
 
 namespace shark {
@@ -40,7 +42,7 @@ namespace bindings {
 
 //upper potrf(row-major)
 template<class MatA>
-std::size_t potrf_impl(
+std::size_t potrf_unblocked(
     matrix_expression<MatA, cpu_tag>& A,
     row_major, lower
 ) {
@@ -65,7 +67,7 @@ std::size_t potrf_impl(
 
 //lower potrf(row-major)
 template<class MatA>
-std::size_t potrf_impl(
+std::size_t potrf_unblocked(
     matrix_expression<MatA, cpu_tag>& A,
     row_major, upper
 ) {
@@ -91,6 +93,78 @@ std::size_t potrf_impl(
 }
 
 
+//blocked right-looking factorization A = L L^T (row-major, lower triangle).
+//the diagonal blocks are factorized with the unblocked algorithm, the panel
+//below is brought up to date with a triangular solve and the trailing matrix
+//is updated blockwise through the gemm kernel, which carries the bulk of the
+//flops and is blocked and parallelised itself.
+template<class MatA>
+std::size_t potrf_impl(
+    matrix_expression<MatA, cpu_tag>& A,
+    row_major, lower
+) {
+	std::size_t const blockSize = 96;
+	std::size_t m = A().size1();
+	if(m <= blockSize)
+		return potrf_unblocked(A, row_major(), lower());
+	for(std::size_t k = 0; k < m; k += blockSize) {
+		std::size_t kend = std::min(k + blockSize, m);
+		//factorize the diagonal block
+		auto Akk = subrange(A, k, kend, k, kend);
+		std::size_t result = potrf_unblocked(Akk, row_major(), lower());
+		if(result != 0)
+			return k + result;
+		if(kend == m) break;
+		//panel solve: A21 <- A21 L11^{-T}, i.e. solve L11 A21^T = A21^T
+		auto A21 = subrange(A, kend, m, k, kend);
+		auto A21trans = trans(A21);
+		kernels::trsm<false,false>(Akk, A21trans);
+		//trailing update of the lower triangle, one block row at a time:
+		//A(i.,k+1...) -= A21_i A21_.^T restricted to the columns left of the diagonal
+		for(std::size_t i = kend; i < m; i += blockSize) {
+			std::size_t iend = std::min(i + blockSize, m);
+			auto left = subrange(A, i, iend, k, kend);
+			auto update = subrange(A, i, iend, kend, iend);
+			kernels::gemm(left, trans(subrange(A, kend, iend, k, kend)), update, -1.0);
+		}
+	}
+	return 0;
+}
+
+//blocked factorization A = U^T U (row-major, upper triangle), analogous to the
+//lower case with the panel to the right of the diagonal block.
+template<class MatA>
+std::size_t potrf_impl(
+    matrix_expression<MatA, cpu_tag>& A,
+    row_major, upper
+) {
+	std::size_t const blockSize = 96;
+	std::size_t m = A().size1();
+	if(m <= blockSize)
+		return potrf_unblocked(A, row_major(), upper());
+	for(std::size_t k = 0; k < m; k += blockSize) {
+		std::size_t kend = std::min(k + blockSize, m);
+		auto Akk = subrange(A, k, kend, k, kend);
+		std::size_t result = potrf_unblocked(Akk, row_major(), upper());
+		if(result != 0)
+			return k + result;
+		if(kend == m) break;
+		//panel solve: A12 <- U11^{-T} A12
+		auto A12 = subrange(A, k, kend, kend, m);
+		auto AkkTrans = trans(Akk);
+		kernels::trsm<false,false>(AkkTrans, A12);
+		//trailing update of the upper triangle, one block row at a time:
+		//A(i.,i...) -= A12_i^T A12 restricted to the columns right of the diagonal
+		for(std::size_t i = kend; i < m; i += blockSize) {
+			std::size_t iend = std::min(i + blockSize, m);
+			auto top = subrange(A, k, kend, i, iend);
+			auto update = subrange(A, i, iend, i, m);
+			kernels::gemm(trans(top), subrange(A, k, kend, i, m), update, -1.0);
+		}
+	}
+	return 0;
+}
+
 //dispatcher for column major
 template<class MatA, class Triangular>
 std::size_t potrf_impl(
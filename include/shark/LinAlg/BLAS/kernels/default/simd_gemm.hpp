@@ -0,0 +1,315 @@
+/*!
+ *
+ *
+ * \brief       Register blocked gemm micro kernel with simd runtime dispatch
+ *
+ * \author      O. Krause
+ * \date        2016
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_LINALG_BLAS_KERNELS_DEFAULT_SIMD_GEMM_HPP
+#define SHARK_LINALG_BLAS_KERNELS_DEFAULT_SIMD_GEMM_HPP
+
+#include <shark/Core/OpenMP.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+//the vectorized micro kernels are only available for gcc/clang on x86-64.
+//everything else falls back to a scalar register blocked kernel which is still
+//a lot faster than the naive loop nest as it reuses packed panels of the inputs.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+	#define SHARK_GEMM_SIMD_DISPATCH
+	#include <immintrin.h>
+#endif
+
+namespace shark { namespace blas { namespace bindings { namespace detail {
+
+//cache and register blocking parameters of the packed gemm.
+//MR/NR are the register tile sizes of the micro kernel, MC/KC/NC
+//the cache block sizes of the macro kernel. MR and NR must divide MC and NC.
+template<class T>
+struct gemm_block{
+	static const std::size_t MR = 4;
+	static const std::size_t NR = 8;
+	static const std::size_t MC = 256;
+	static const std::size_t KC = 256;
+	static const std::size_t NC = 2048;
+};
+
+///\brief Packs the MR x kc panel starting at A(0,0) in k-major order, padding with zeros.
+template<class T>
+void gemm_pack_A(
+	T const* A, std::size_t rsA, std::size_t csA,
+	std::size_t mr, std::size_t kc, T* buffer
+){
+	static const std::size_t MR = gemm_block<T>::MR;
+	for(std::size_t k = 0; k != kc; ++k){
+		for(std::size_t i = 0; i != mr; ++i)
+			buffer[k * MR + i] = A[i * rsA + k * csA];
+		for(std::size_t i = mr; i != MR; ++i)
+			buffer[k * MR + i] = T();
+	}
+}
+
+///\brief Packs the kc x NR panel starting at B(0,0) in k-major order, padding with zeros.
+template<class T>
+void gemm_pack_B(
+	T const* B, std::size_t rsB, std::size_t csB,
+	std::size_t kc, std::size_t nr, T* buffer
+){
+	static const std::size_t NR = gemm_block<T>::NR;
+	for(std::size_t k = 0; k != kc; ++k){
+		for(std::size_t j = 0; j != nr; ++j)
+			buffer[k * NR + j] = B[k * rsB + j * csB];
+		for(std::size_t j = nr; j != NR; ++j)
+			buffer[k * NR + j] = T();
+	}
+}
+
+///\brief Scalar fallback micro kernel: C+=alpha * A B for an MR x NR register tile.
+///
+/// A is an MR x kc packed panel, B a kc x NR packed panel. The accumulators are
+/// kept in a local array so that the compiler can place them in registers.
+template<class T>
+void ugemm_generic(
+	std::size_t kc, T alpha,
+	T const* A, T const* B,
+	T* C, std::size_t ldc
+){
+	static const std::size_t MR = gemm_block<T>::MR;
+	static const std::size_t NR = gemm_block<T>::NR;
+	T acc[MR * NR] = {};
+	for(std::size_t k = 0; k != kc; ++k){
+		for(std::size_t i = 0; i != MR; ++i){
+			for(std::size_t j = 0; j != NR; ++j)
+				acc[i * NR + j] += A[k * MR + i] * B[k * NR + j];
+		}
+	}
+	for(std::size_t i = 0; i != MR; ++i){
+		for(std::size_t j = 0; j != NR; ++j)
+			C[i * ldc + j] += alpha * acc[i * NR + j];
+	}
+}
+
+#ifdef SHARK_GEMM_SIMD_DISPATCH
+
+inline bool gemm_has_avx2(){
+	static bool const available =
+		__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	return available;
+}
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+
+///\brief AVX2/FMA micro kernel for double: 4x8 register tile, 8 accumulator registers.
+inline void ugemm_avx2(
+	std::size_t kc, double alpha,
+	double const* A, double const* B,
+	double* C, std::size_t ldc
+){
+	__m256d acc[4][2] = {};
+	for(std::size_t k = 0; k != kc; ++k){
+		__m256d b0 = _mm256_loadu_pd(B + k * 8);
+		__m256d b1 = _mm256_loadu_pd(B + k * 8 + 4);
+		for(std::size_t i = 0; i != 4; ++i){
+			__m256d a = _mm256_broadcast_sd(A + k * 4 + i);
+			acc[i][0] = _mm256_fmadd_pd(a, b0, acc[i][0]);
+			acc[i][1] = _mm256_fmadd_pd(a, b1, acc[i][1]);
+		}
+	}
+	__m256d valpha = _mm256_broadcast_sd(&alpha);
+	for(std::size_t i = 0; i != 4; ++i){
+		double* c = C + i * ldc;
+		_mm256_storeu_pd(c, _mm256_fmadd_pd(valpha, acc[i][0], _mm256_loadu_pd(c)));
+		_mm256_storeu_pd(c + 4, _mm256_fmadd_pd(valpha, acc[i][1], _mm256_loadu_pd(c + 4)));
+	}
+}
+
+///\brief AVX2/FMA micro kernel for float: 4x8 register tile, 4 accumulator registers.
+inline void ugemm_avx2(
+	std::size_t kc, float alpha,
+	float const* A, float const* B,
+	float* C, std::size_t ldc
+){
+	__m256 acc[4] = {};
+	for(std::size_t k = 0; k != kc; ++k){
+		__m256 b = _mm256_loadu_ps(B + k * 8);
+		for(std::size_t i = 0; i != 4; ++i){
+			__m256 a = _mm256_broadcast_ss(A + k * 4 + i);
+			acc[i] = _mm256_fmadd_ps(a, b, acc[i]);
+		}
+	}
+	__m256 valpha = _mm256_broadcast_ss(&alpha);
+	for(std::size_t i = 0; i != 4; ++i){
+		float* c = C + i * ldc;
+		_mm256_storeu_ps(c, _mm256_fmadd_ps(valpha, acc[i], _mm256_loadu_ps(c)));
+	}
+}
+
+#pragma GCC pop_options
+
+template<class T>
+void ugemm(
+	std::size_t kc, T alpha,
+	T const* A, T const* B,
+	T* C, std::size_t ldc
+){
+	if(gemm_has_avx2())
+		ugemm_avx2(kc, alpha, A, B, C, ldc);
+	else
+		ugemm_generic(kc, alpha, A, B, C, ldc);
+}
+
+#else
+
+template<class T>
+void ugemm(
+	std::size_t kc, T alpha,
+	T const* A, T const* B,
+	T* C, std::size_t ldc
+){
+	ugemm_generic(kc, alpha, A, B, C, ldc);
+}
+
+#endif
+
+///\brief Macro kernel: multiplies the packed mc x kc block of A with the packed kc x nc block of B.
+template<class T>
+void gemm_macro_kernel(
+	std::size_t mc, std::size_t nc, std::size_t kc, T alpha,
+	T const* Abuffer, T const* Bbuffer,
+	T* C, std::size_t ldc
+){
+	static const std::size_t MR = gemm_block<T>::MR;
+	static const std::size_t NR = gemm_block<T>::NR;
+	for(std::size_t j = 0; j < nc; j += NR){
+		std::size_t nr = std::min(NR, nc - j);
+		for(std::size_t i = 0; i < mc; i += MR){
+			std::size_t mr = std::min(MR, mc - i);
+			T const* Apanel = Abuffer + i * kc;
+			T const* Bpanel = Bbuffer + j * kc;
+			if(mr == MR && nr == NR){
+				ugemm(kc, alpha, Apanel, Bpanel, C + i * ldc + j, ldc);
+			}else{
+				//partial tile at the border: compute into a local buffer
+				//and add only the valid part to C.
+				T tile[MR * NR] = {};
+				ugemm(kc, alpha, Apanel, Bpanel, tile, NR);
+				for(std::size_t i2 = 0; i2 != mr; ++i2){
+					for(std::size_t j2 = 0; j2 != nr; ++j2)
+						C[(i + i2) * ldc + j + j2] += tile[i2 * NR + j2];
+				}
+			}
+		}
+	}
+}
+
+///\brief Packed, register blocked gemm on raw storage: C += alpha * A B.
+///
+/// C must be row-major with leading dimension ldc, while A and B are described
+/// by arbitrary row/column strides so that transposed or column-major arguments
+/// do not need to be copied beforehand - packing handles the layout.
+template<class T>
+void dense_gemm(
+	std::size_t M, std::size_t N, std::size_t K, T alpha,
+	T const* A, std::size_t rsA, std::size_t csA,
+	T const* B, std::size_t rsB, std::size_t csB,
+	T* C, std::size_t ldc
+){
+	static const std::size_t MR = gemm_block<T>::MR;
+	static const std::size_t NR = gemm_block<T>::NR;
+	static const std::size_t MC = gemm_block<T>::MC;
+	static const std::size_t KC = gemm_block<T>::KC;
+	static const std::size_t NC = gemm_block<T>::NC;
+
+	std::vector<T> Abuffer(MC * KC);
+	std::vector<T> Bbuffer(KC * NC);
+
+	for(std::size_t jc = 0; jc < N; jc += NC){
+		std::size_t nc = std::min(NC, N - jc);
+		for(std::size_t pc = 0; pc < K; pc += KC){
+			std::size_t kc = std::min(KC, K - pc);
+			//pack the kc x nc block of B into NR-wide panels
+			for(std::size_t j = 0; j < nc; j += NR){
+				gemm_pack_B(
+					B + pc * rsB + (jc + j) * csB, rsB, csB,
+					kc, std::min(NR, nc - j), &Bbuffer[j * kc]
+				);
+			}
+			for(std::size_t ic = 0; ic < M; ic += MC){
+				std::size_t mc = std::min(MC, M - ic);
+				//pack the mc x kc block of A into MR-high panels
+				for(std::size_t i = 0; i < mc; i += MR){
+					gemm_pack_A(
+						A + (ic + i) * rsA + pc * csA, rsA, csA,
+						std::min(MR, mc - i), kc, &Abuffer[i * kc]
+					);
+				}
+				gemm_macro_kernel(
+					mc, nc, kc, alpha,
+					Abuffer.data(), Bbuffer.data(),
+					C + ic * ldc + jc, ldc
+				);
+			}
+		}
+	}
+}
+
+///\brief Multithreaded version of dense_gemm: C += alpha * A B.
+///
+/// The rows of C are partitioned into contiguous blocks which are computed
+/// independently by the threads with the sequential packed kernel. Small
+/// products are computed sequentially as the fork overhead would dominate.
+template<class T>
+void dense_gemm_parallel(
+	std::size_t M, std::size_t N, std::size_t K, T alpha,
+	T const* A, std::size_t rsA, std::size_t csA,
+	T const* B, std::size_t rsB, std::size_t csB,
+	T* C, std::size_t ldc
+){
+	static const std::size_t MR = gemm_block<T>::MR;
+	std::size_t blocks = std::min<std::size_t>(SHARK_NUM_THREADS, M / MR);
+	if(blocks <= 1 || M * N * K < 32 * 32 * 32){
+		dense_gemm(M, N, K, alpha, A, rsA, csA, B, rsB, csB, C, ldc);
+		return;
+	}
+	//round the block height to a multiple of the register tile height
+	std::size_t rowsPerBlock = (((M + blocks - 1) / blocks + MR - 1) / MR) * MR;
+	blocks = (M + rowsPerBlock - 1) / rowsPerBlock;
+	SHARK_PARALLEL_FOR(int b = 0; b < (int)blocks; ++b){
+		std::size_t start = b * rowsPerBlock;
+		std::size_t rows = std::min(rowsPerBlock, M - start);
+		dense_gemm(
+			rows, N, K, alpha,
+			A + start * rsA, rsA, csA,
+			B, rsB, csB,
+			C + start * ldc, ldc
+		);
+	}
+}
+
+}}}}
+#endif
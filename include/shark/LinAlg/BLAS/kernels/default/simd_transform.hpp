@@ -0,0 +1,354 @@
+/*!
+ *
+ *
+ * \brief       Vectorized batch kernels for elementwise transcendental functions
+ *
+ * \author      O. Krause
+ * \date        2016
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_LINALG_BLAS_KERNELS_DEFAULT_SIMD_TRANSFORM_HPP
+#define SHARK_LINALG_BLAS_KERNELS_DEFAULT_SIMD_TRANSFORM_HPP
+
+#include "../../detail/functional.hpp"
+
+#include <boost/mpl/bool.hpp>
+#include <type_traits>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+
+//the vectorized kernels are only available for gcc/clang on x86-64,
+//everything else evaluates through the scalar standard library functions.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+	#define SHARK_TRANSFORM_SIMD_DISPATCH
+	#include <immintrin.h>
+	#include <cstring>
+#endif
+
+namespace shark { namespace blas {
+
+//forward declaration, the expression classes are included after the kernels
+template<class E, class F> class vector_unary;
+
+namespace bindings {
+
+namespace detail {
+
+#ifdef SHARK_TRANSFORM_SIMD_DISPATCH
+
+inline bool transform_has_avx2(){
+	static bool const available =
+		__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+	return available;
+}
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+
+///\brief exp of four doubles using the Cephes rational approximation.
+///
+/// The argument is split as x = n log 2 + r with |r| <= log(2)/2 and
+/// exp(r) is computed by a rational polynomial accurate to about 1 ulp;
+/// scaling by 2^n happens through direct exponent manipulation. Overflow
+/// saturates to infinity, underflow flushes to zero, NaN stays NaN.
+inline __m256d exp4_avx2(__m256d x){
+	__m256d const log2e = _mm256_set1_pd(1.4426950408889634073599);
+	__m256d const c1 = _mm256_set1_pd(6.93145751953125e-1);
+	__m256d const c2 = _mm256_set1_pd(1.42860682030941723212e-6);
+	__m256d const one = _mm256_set1_pd(1.0);
+
+	__m256d n = _mm256_round_pd(
+		_mm256_mul_pd(x, log2e),
+		_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC
+	);
+	//r = x - n*log(2), the constant is split for extra precision
+	__m256d r = _mm256_fnmadd_pd(n, c1, x);
+	r = _mm256_fnmadd_pd(n, c2, r);
+	__m256d r2 = _mm256_mul_pd(r, r);
+
+	__m256d p = _mm256_set1_pd(1.26177193074810590878e-4);
+	p = _mm256_fmadd_pd(p, r2, _mm256_set1_pd(3.02994407707441961300e-2));
+	p = _mm256_fmadd_pd(p, r2, _mm256_set1_pd(9.99999999999999999910e-1));
+	p = _mm256_mul_pd(p, r);
+
+	__m256d q = _mm256_set1_pd(3.00198505138664455042e-6);
+	q = _mm256_fmadd_pd(q, r2, _mm256_set1_pd(2.52448340349684104192e-3));
+	q = _mm256_fmadd_pd(q, r2, _mm256_set1_pd(2.27265548208155028766e-1));
+	q = _mm256_fmadd_pd(q, r2, _mm256_set1_pd(2.00000000000000000005e0));
+	//exp(r) = 1 + 2 p/(q - p)
+	__m256d expr = _mm256_div_pd(p, _mm256_sub_pd(q, p));
+	expr = _mm256_fmadd_pd(_mm256_set1_pd(2.0), expr, one);
+
+	//scale by 2^n via the exponent bits
+	__m128i n32 = _mm256_cvtpd_epi32(n);
+	__m256i n64 = _mm256_cvtepi32_epi64(n32);
+	__m256i scaleBits = _mm256_slli_epi64(
+		_mm256_add_epi64(n64, _mm256_set1_epi64x(1023)), 52
+	);
+	__m256d result = _mm256_mul_pd(expr, _mm256_castsi256_pd(scaleBits));
+
+	//fix up over- and underflow
+	__m256d const hi = _mm256_set1_pd(709.08);
+	__m256d const lo = _mm256_set1_pd(-708.4);
+	__m256d inf = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+	result = _mm256_blendv_pd(result, inf, _mm256_cmp_pd(x, hi, _CMP_GT_OQ));
+	result = _mm256_blendv_pd(result, _mm256_setzero_pd(), _mm256_cmp_pd(x, lo, _CMP_LT_OQ));
+	return result;
+}
+
+///\brief log of four doubles.
+///
+/// The mantissa m in [sqrt(1/2),sqrt(2)) is extracted through the exponent
+/// bits and log(m) = 2 atanh((m-1)/(m+1)) is evaluated with an odd
+/// polynomial in (m-1)/(m+1). Nonpositive arguments yield -infinity for
+/// zero and NaN otherwise, matching std::log.
+inline __m256d log4_avx2(__m256d x){
+	__m256d const one = _mm256_set1_pd(1.0);
+	__m256d const half = _mm256_set1_pd(0.5);
+
+	//scale denormals so the exponent extraction below is exact
+	__m256d denormalMask = _mm256_cmp_pd(x, _mm256_set1_pd(2.2250738585072014e-308), _CMP_LT_OQ);
+	denormalMask = _mm256_and_pd(denormalMask, _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_GT_OQ));
+	__m256d xScaled = _mm256_mul_pd(x, _mm256_set1_pd(1.8014398509481984e16));//2^54
+	__m256d xs = _mm256_blendv_pd(x, xScaled, denormalMask);
+
+	//split into exponent and mantissa in [1,2)
+	__m256i bits = _mm256_castpd_si256(xs);
+	__m256i expBits = _mm256_srli_epi64(bits, 52);
+	expBits = _mm256_and_si256(expBits, _mm256_set1_epi64x(0x7ff));
+	__m256i mantBits = _mm256_and_si256(bits, _mm256_set1_epi64x(0x000fffffffffffffll));
+	mantBits = _mm256_or_si256(mantBits, _mm256_set1_epi64x(0x3ff0000000000000ll));
+	__m256d m = _mm256_castsi256_pd(mantBits);
+	//int64->double conversion of the small exponents via the 2^52 trick
+	__m256d e = _mm256_sub_pd(
+		_mm256_castsi256_pd(_mm256_or_si256(expBits, _mm256_set1_epi64x(0x4330000000000000ll))),
+		_mm256_set1_pd(4503599627370496.0)//2^52
+	);
+	e = _mm256_sub_pd(e, _mm256_set1_pd(1023.0));
+	e = _mm256_blendv_pd(e, _mm256_sub_pd(e, _mm256_set1_pd(54.0)), denormalMask);
+
+	//move m into [sqrt(1/2), sqrt(2)) for a small expansion argument
+	__m256d bigMask = _mm256_cmp_pd(m, _mm256_set1_pd(1.4142135623730950488), _CMP_GE_OQ);
+	m = _mm256_blendv_pd(m, _mm256_mul_pd(m, half), bigMask);
+	e = _mm256_blendv_pd(e, _mm256_add_pd(e, one), bigMask);
+
+	//log(m) = 2 atanh(s), s = (m-1)/(m+1), via an odd polynomial in s
+	__m256d s = _mm256_div_pd(_mm256_sub_pd(m, one), _mm256_add_pd(m, one));
+	__m256d s2 = _mm256_mul_pd(s, s);
+	__m256d p = _mm256_set1_pd(1.0 / 23.0);
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 21.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 19.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 17.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 15.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 13.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 11.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 9.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 7.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 5.0));
+	p = _mm256_fmadd_pd(p, s2, _mm256_set1_pd(1.0 / 3.0));
+	p = _mm256_fmadd_pd(p, s2, one);
+	__m256d logm = _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(2.0), s), p);
+
+	//log(x) = e*log(2) + log(m), the constant is split for extra precision
+	__m256d result = _mm256_fmadd_pd(e, _mm256_set1_pd(6.93145751953125e-1), logm);
+	result = _mm256_fmadd_pd(e, _mm256_set1_pd(1.42860682030941723212e-6), result);
+
+	//fix up zero, negative arguments and infinity
+	__m256d minusInf = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+	__m256d nan = _mm256_set1_pd(std::numeric_limits<double>::quiet_NaN());
+	result = _mm256_blendv_pd(result, minusInf, _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_EQ_OQ));
+	result = _mm256_blendv_pd(result, nan, _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_LT_OQ));
+	result = _mm256_blendv_pd(result, x, _mm256_cmp_pd(x, _mm256_set1_pd(std::numeric_limits<double>::infinity()), _CMP_EQ_OQ));
+	result = _mm256_blendv_pd(result, nan, _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+	return result;
+}
+
+///\brief sigmoid 1/(1+exp(-x)) of four doubles, saturating at 0 and 1.
+inline __m256d sigmoid4_avx2(__m256d x){
+	__m256d one = _mm256_set1_pd(1.0);
+	__m256d e = exp4_avx2(_mm256_sub_pd(_mm256_setzero_pd(), x));
+	return _mm256_div_pd(one, _mm256_add_pd(one, e));
+}
+
+///\brief tanh of four doubles computed as (exp(2x)-1)/(exp(2x)+1).
+inline __m256d tanh4_avx2(__m256d x){
+	__m256d const one = _mm256_set1_pd(1.0);
+	//tanh saturates below double precision for |x| > 19.1
+	__m256d xc = _mm256_max_pd(_mm256_set1_pd(-19.1), x);
+	xc = _mm256_min_pd(_mm256_set1_pd(19.1), xc);
+	__m256d e = exp4_avx2(_mm256_add_pd(xc, xc));
+	return _mm256_div_pd(_mm256_sub_pd(e, one), _mm256_add_pd(e, one));
+}
+
+///\brief Applies exp to a contiguous block of doubles, four elements at a time.
+inline void exp_block_avx2(double const* x, double* y, std::size_t n){
+	std::size_t nn = n - n % 4;
+	for(std::size_t i = 0; i != nn; i += 4)
+		_mm256_storeu_pd(y + i, exp4_avx2(_mm256_loadu_pd(x + i)));
+	for(std::size_t i = nn; i != n; ++i)
+		y[i] = std::exp(x[i]);
+}
+
+///\brief Applies log to a contiguous block of doubles, four elements at a time.
+inline void log_block_avx2(double const* x, double* y, std::size_t n){
+	std::size_t nn = n - n % 4;
+	for(std::size_t i = 0; i != nn; i += 4)
+		_mm256_storeu_pd(y + i, log4_avx2(_mm256_loadu_pd(x + i)));
+	for(std::size_t i = nn; i != n; ++i)
+		y[i] = std::log(x[i]);
+}
+
+///\brief Applies the sigmoid to a contiguous block of doubles, four elements at a time.
+inline void sigmoid_block_avx2(double const* x, double* y, std::size_t n){
+	std::size_t nn = n - n % 4;
+	for(std::size_t i = 0; i != nn; i += 4)
+		_mm256_storeu_pd(y + i, sigmoid4_avx2(_mm256_loadu_pd(x + i)));
+	for(std::size_t i = nn; i != n; ++i)
+		y[i] = 1.0 / (1.0 + std::exp(-x[i]));
+}
+
+///\brief Applies tanh to a contiguous block of doubles, four elements at a time.
+inline void tanh_block_avx2(double const* x, double* y, std::size_t n){
+	std::size_t nn = n - n % 4;
+	for(std::size_t i = 0; i != nn; i += 4)
+		_mm256_storeu_pd(y + i, tanh4_avx2(_mm256_loadu_pd(x + i)));
+	for(std::size_t i = nn; i != n; ++i)
+		y[i] = std::tanh(x[i]);
+}
+
+#pragma GCC pop_options
+
+#endif
+
+///\brief Applies exp to a contiguous block of doubles.
+inline void exp_block(double const* x, double* y, std::size_t n){
+#ifdef SHARK_TRANSFORM_SIMD_DISPATCH
+	if(transform_has_avx2()){
+		exp_block_avx2(x, y, n);
+		return;
+	}
+#endif
+	for(std::size_t i = 0; i != n; ++i)
+		y[i] = std::exp(x[i]);
+}
+
+///\brief Applies log to a contiguous block of doubles.
+inline void log_block(double const* x, double* y, std::size_t n){
+#ifdef SHARK_TRANSFORM_SIMD_DISPATCH
+	if(transform_has_avx2()){
+		log_block_avx2(x, y, n);
+		return;
+	}
+#endif
+	for(std::size_t i = 0; i != n; ++i)
+		y[i] = std::log(x[i]);
+}
+
+///\brief Applies the sigmoid function to a contiguous block of doubles.
+inline void sigmoid_block(double const* x, double* y, std::size_t n){
+#ifdef SHARK_TRANSFORM_SIMD_DISPATCH
+	if(transform_has_avx2()){
+		sigmoid_block_avx2(x, y, n);
+		return;
+	}
+#endif
+	for(std::size_t i = 0; i != n; ++i)
+		y[i] = 1.0 / (1.0 + std::exp(-x[i]));
+}
+
+///\brief Applies tanh to a contiguous block of doubles.
+inline void tanh_block(double const* x, double* y, std::size_t n){
+#ifdef SHARK_TRANSFORM_SIMD_DISPATCH
+	if(transform_has_avx2()){
+		tanh_block_avx2(x, y, n);
+		return;
+	}
+#endif
+	for(std::size_t i = 0; i != n; ++i)
+		y[i] = std::tanh(x[i]);
+}
+
+//map the scalar functors of the expression templates to their batch kernels
+inline void transform_block(double const* x, double* y, std::size_t n, scalar_exp<double>){
+	exp_block(x, y, n);
+}
+inline void transform_block(double const* x, double* y, std::size_t n, scalar_log<double>){
+	log_block(x, y, n);
+}
+inline void transform_block(double const* x, double* y, std::size_t n, scalar_sigmoid<double>){
+	sigmoid_block(x, y, n);
+}
+inline void transform_block(double const* x, double* y, std::size_t n, scalar_tanh<double>){
+	tanh_block(x, y, n);
+}
+
+///\brief Functors with a vectorized batch kernel.
+template<class F>
+struct is_simd_transform_functor : public boost::mpl::false_{};
+template<>
+struct is_simd_transform_functor<scalar_exp<double> > : public boost::mpl::true_{};
+template<>
+struct is_simd_transform_functor<scalar_log<double> > : public boost::mpl::true_{};
+template<>
+struct is_simd_transform_functor<scalar_sigmoid<double> > : public boost::mpl::true_{};
+template<>
+struct is_simd_transform_functor<scalar_tanh<double> > : public boost::mpl::true_{};
+
+}
+
+///\brief Traits deciding whether assigning E to V can use a vectorized batch transform.
+///
+/// This is the case when E applies one of the supported transcendental
+/// functions directly to an expression with dense double storage and the
+/// target has dense double storage as well. Strides are checked at runtime.
+template<class V, class E>
+struct has_simd_transform : public boost::mpl::false_{};
+
+template<class V, class E, class F>
+struct has_simd_transform<V, vector_unary<E, F> > : public boost::mpl::bool_<
+	detail::is_simd_transform_functor<F>::value
+	&& std::is_same<typename V::storage_type::storage_tag, dense_tag>::value
+	&& std::is_same<typename E::const_storage_type::storage_tag, dense_tag>::value
+	&& std::is_same<typename V::value_type, double>::value
+	&& std::is_same<typename E::value_type, double>::value
+>{};
+
+template<class V, class E>
+bool simd_transform_assign(V&, E const&, boost::mpl::false_){
+	return false;
+}
+
+template<class V, class E>
+bool simd_transform_assign(V& v, E const& e, boost::mpl::true_){
+	auto storageV = v.raw_storage();
+	auto storageE = e.expression().raw_storage();
+	//the batch kernels require contiguous storage on both sides
+	if(storageV.stride != 1 || storageE.stride != 1)
+		return false;
+	detail::transform_block(storageE.values, storageV.values, v.size(), e.functor());
+	return true;
+}
+
+}}}
+#endif
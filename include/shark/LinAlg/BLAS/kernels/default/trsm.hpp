@@ -32,7 +32,10 @@
 #define SHARK_LINALG_BLAS_KERNELS_ATLAS_TRSM_HPP
 
 #include "../../expression_types.hpp"
+#include "../gemm.hpp"
+#include <shark/Core/OpenMP.h>
 #include <boost/mpl/bool.hpp>
+#include <algorithm>
 
 namespace shark {namespace blas {namespace bindings {
 	
@@ -141,17 +144,82 @@ void trsm_impl(
 	}
 }
 
+//Blocked recursive solver. The triangular matrix is halved and the
+//off-diagonal block is applied to the already solved part of the panel
+//as a gemm update, so for large systems nearly all work runs inside the
+//matrix-matrix product kernel; only the small diagonal blocks are solved
+//with the elementwise kernels above.
+
+// Lower triangular case
+template<bool Unit, class MatA, class MatB>
+void trsm_recursive(
+	matrix_expression<MatA, cpu_tag> const& A,
+	matrix_expression<MatB, cpu_tag>& B,
+	boost::mpl::false_ //lower
+){
+	std::size_t const blockSize = 32;
+	std::size_t size = A().size1();
+	if(size <= blockSize){
+		trsm_impl<Unit>(A,B,boost::mpl::false_(),typename MatA::orientation());
+		return;
+	}
+	std::size_t split = size/2;
+	auto A11 = subrange(A(),0,split,0,split);
+	auto A21 = subrange(A(),split,size,0,split);
+	auto A22 = subrange(A(),split,size,split,size);
+	auto B1 = rows(B(),0,split);
+	auto B2 = rows(B(),split,size);
+	trsm_recursive<Unit>(A11,B1,boost::mpl::false_());
+	kernels::gemm(A21,B1,B2,typename MatB::value_type(-1));
+	trsm_recursive<Unit>(A22,B2,boost::mpl::false_());
+}
+
+// Upper triangular case - solved bottom-up
+template<bool Unit, class MatA, class MatB>
+void trsm_recursive(
+	matrix_expression<MatA, cpu_tag> const& A,
+	matrix_expression<MatB, cpu_tag>& B,
+	boost::mpl::true_ //upper
+){
+	std::size_t const blockSize = 32;
+	std::size_t size = A().size1();
+	if(size <= blockSize){
+		trsm_impl<Unit>(A,B,boost::mpl::true_(),typename MatA::orientation());
+		return;
+	}
+	std::size_t split = size/2;
+	auto A11 = subrange(A(),0,split,0,split);
+	auto A12 = subrange(A(),0,split,split,size);
+	auto A22 = subrange(A(),split,size,split,size);
+	auto B1 = rows(B(),0,split);
+	auto B2 = rows(B(),split,size);
+	trsm_recursive<Unit>(A22,B2,boost::mpl::true_());
+	kernels::gemm(A12,B2,B1,typename MatB::value_type(-1));
+	trsm_recursive<Unit>(A11,B1,boost::mpl::true_());
+}
+
 template <bool Upper, bool Unit,typename MatA, typename MatB>
 void trsm(
 	matrix_expression<MatA, cpu_tag> const& A,
 	matrix_expression<MatB, cpu_tag>& B,
 	boost::mpl::false_
 ){
-	trsm_impl<Unit>(
-		A,B,
-		boost::mpl::bool_<Upper>(),
-		typename MatA::orientation()
-	);
+	//partition the right hand side panel across threads; the solves of the
+	//column blocks are completely independent of each other
+	std::size_t size2 = B().size2();
+	std::size_t const minPanelSize = 16;
+	std::size_t maxBlocks = (size2+minPanelSize-1)/minPanelSize;
+	std::size_t numBlocks = std::min<std::size_t>(SHARK_NUM_THREADS, maxBlocks);
+	if(numBlocks <= 1){
+		trsm_recursive<Unit>(A,B,boost::mpl::bool_<Upper>());
+		return;
+	}
+	SHARK_PARALLEL_FOR(int b = 0; b < (int)numBlocks; ++b){
+		std::size_t start = (b*size2)/numBlocks;
+		std::size_t end = ((b+1)*size2)/numBlocks;
+		auto panel = columns(B(),start,end);
+		trsm_recursive<Unit>(A,panel,boost::mpl::bool_<Upper>());
+	}
 }
 
 }}}
@@ -0,0 +1,69 @@
+/*!
+ *
+ *
+ * \brief       batched matrix-matrix multiplication kernel
+ *
+ * \author      O. Krause
+ * \date        2016
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SHARK_LINALG_BLAS_KERNELS_GEMM_BATCHED_HPP
+#define SHARK_LINALG_BLAS_KERNELS_GEMM_BATCHED_HPP
+
+#include "gemm.hpp"
+#include <shark/Core/OpenMP.h>
+
+#include <vector>
+
+namespace shark { namespace blas {namespace kernels{
+
+///\brief Batched GEneral Matrix-Matrix product kernel M_i += alpha*E1_i*E2_i.
+///
+/// Computes a whole set of independent matrix-matrix products at once. The
+/// individual products of a batched workload - for example one model layer
+/// applied to every batch of a dataset - are typically too small to amortise
+/// the threading overhead of a single gemm call. This kernel therefore
+/// parallelises over the products and computes every product with the
+/// sequential gemm kernel, which also picks the optimized bindings when
+/// available. All three ranges must have the same length and the pointed-to
+/// arguments must obey the size requirements of gemm.
+template<class M, class E1, class E2>
+void gemm_batched(
+	std::vector<E1 const*> const& e1s,
+	std::vector<E2 const*> const& e2s,
+	std::vector<M*> const& ms,
+	typename M::value_type alpha
+) {
+	SIZE_CHECK(e1s.size() == ms.size());
+	SIZE_CHECK(e2s.size() == ms.size());
+
+	SHARK_PARALLEL_FOR(int i = 0; i < (int)ms.size(); ++i){
+		M& m = *ms[i];
+		gemm(*e1s[i], *e2s[i], m, alpha);
+	}
+}
+
+}}}
+
+#endif
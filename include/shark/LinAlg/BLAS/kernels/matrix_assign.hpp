@@ -105,39 +105,56 @@ void assign(
 //remain the versions where both argumnts to not have the same orientation
 
 //dense-dense case
+
+//Recursive cache-oblivious kernel for transposed assignment. The rectangle is
+//split along its larger dimension until a tile is reached; the tile is then
+//transposed through a small stack buffer so that both the reads from e and
+//the writes to m are contiguous in their respective major order. Because the
+//recursion halves the working set on every level, the traversal blocks for
+//every level of the memory hierarchy (L1, L2, TLB) without knowing the sizes.
 template<class M, class E>
-void assign(
-	matrix_expression<M, cpu_tag> &m, 
+void assign_transposed_recursive(
+	matrix_expression<M, cpu_tag> &m,
 	matrix_expression<E, cpu_tag> const& e,
-	row_major, column_major,dense_tag, dense_tag
+	std::size_t start1, std::size_t end1,
+	std::size_t start2, std::size_t end2
 ) {
-	//compute blockwise and wrelem the transposed block.
-	std::size_t const blockSize = 16;
+	std::size_t const blockSize = 32;//two tiles of doubles fit into a 32KB L1
+	std::size_t size1 = end1 - start1;
+	std::size_t size2 = end2 - start2;
+	if(size1 > blockSize || size2 > blockSize){
+		if(size1 >= size2){
+			std::size_t split = start1 + size1/2;
+			assign_transposed_recursive(m,e,start1,split,start2,end2);
+			assign_transposed_recursive(m,e,split,end1,start2,end2);
+		}else{
+			std::size_t split = start2 + size2/2;
+			assign_transposed_recursive(m,e,start1,end1,start2,split);
+			assign_transposed_recursive(m,e,start1,end1,split,end2);
+		}
+		return;
+	}
+	//base case: transpose the tile through the buffer
 	typename M::value_type blockStorage[blockSize][blockSize];
-	
-	typedef typename M::index_type index_type;
-	index_type size1 = m().size1();
-	index_type size2 = m().size2();
-	for (index_type iblock = 0; iblock < size1; iblock += blockSize){
-		for (index_type jblock = 0; jblock < size2; jblock += blockSize){
-			std::size_t blockSizei = std::min(blockSize,size1-iblock);
-			std::size_t blockSizej = std::min(blockSize,size2-jblock);
-			
-			//compute block values
-			for (index_type j = 0; j < blockSizej; ++j){
-				for (index_type i = 0; i < blockSizei; ++i){
-					blockStorage[i][j] = e()(iblock+i,jblock+j);
-				}
-			}
-			
-			//copy block in a different order to m
-			for (index_type i = 0; i < blockSizei; ++i){
-				for (index_type j = 0; j < blockSizej; ++j){
-					m()(iblock+i,jblock+j) = blockStorage[i][j];
-				}
-			}
+	for (std::size_t j = 0; j < size2; ++j){
+		for (std::size_t i = 0; i < size1; ++i){
+			blockStorage[i][j] = e()(start1+i,start2+j);
 		}
 	}
+	for (std::size_t i = 0; i < size1; ++i){
+		for (std::size_t j = 0; j < size2; ++j){
+			m()(start1+i,start2+j) = blockStorage[i][j];
+		}
+	}
+}
+
+template<class M, class E>
+void assign(
+	matrix_expression<M, cpu_tag> &m,
+	matrix_expression<E, cpu_tag> const& e,
+	row_major, column_major,dense_tag, dense_tag
+) {
+	assign_transposed_recursive(m,e,0,m().size1(),0,m().size2());
 }
 
 // dense-sparse
@@ -335,40 +352,52 @@ void assign(
 //we only need to implement the remaining versions for column major second argument
 
 //dense-dense case
+
+//recursive cache-oblivious kernel, see the version without functor above
+template<class F, class M, class E>
+void assign_transposed_recursive(
+	matrix_expression<M, cpu_tag> &m,
+	matrix_expression<E, cpu_tag> const& e,
+	std::size_t start1, std::size_t end1,
+	std::size_t start2, std::size_t end2,
+	F f
+) {
+	std::size_t const blockSize = 32;
+	std::size_t size1 = end1 - start1;
+	std::size_t size2 = end2 - start2;
+	if(size1 > blockSize || size2 > blockSize){
+		if(size1 >= size2){
+			std::size_t split = start1 + size1/2;
+			assign_transposed_recursive(m,e,start1,split,start2,end2,f);
+			assign_transposed_recursive(m,e,split,end1,start2,end2,f);
+		}else{
+			std::size_t split = start2 + size2/2;
+			assign_transposed_recursive(m,e,start1,end1,start2,split,f);
+			assign_transposed_recursive(m,e,start1,end1,split,end2,f);
+		}
+		return;
+	}
+	typename M::value_type blockStorage[blockSize][blockSize];
+	for (std::size_t j = 0; j < size2; ++j){
+		for (std::size_t i = 0; i < size1; ++i){
+			blockStorage[i][j] = e()(start1+i,start2+j);
+		}
+	}
+	for (std::size_t i = 0; i < size1; ++i){
+		for (std::size_t j = 0; j < size2; ++j){
+			f(m()(start1+i,start2+j), blockStorage[i][j]);
+		}
+	}
+}
+
 template<template <class, class> class F,class M, class E>
 void assign(
-	matrix_expression<M, cpu_tag> &m, 
+	matrix_expression<M, cpu_tag> &m,
 	matrix_expression<E, cpu_tag> const& e,
 	row_major, column_major,dense_tag, dense_tag
 ) {
 	F<typename major_iterator<M>::type::reference, typename E::value_type> f;
-	//compute blockwise and wrelem the transposed block.
-	std::size_t const blockSize = 16;
-	typename M::value_type blockStorage[blockSize][blockSize];
-	
-	typedef typename M::index_type index_type;
-	index_type size1 = m().size1();
-	index_type size2 = m().size2();
-	for (index_type iblock = 0; iblock < size1; iblock += blockSize){
-		for (index_type jblock = 0; jblock < size2; jblock += blockSize){
-			std::size_t blockSizei = std::min(blockSize,size1-iblock);
-			std::size_t blockSizej = std::min(blockSize,size2-jblock);
-			
-			//fill the block with the values of e
-			for (index_type j = 0; j < blockSizej; ++j){
-				for (index_type i = 0; i < blockSizei; ++i){
-					blockStorage[i][j] = e()(iblock+i,jblock+j);
-				}
-			}
-			
-			//compute block values and store in m
-			for (index_type i = 0; i < blockSizei; ++i){
-				for (index_type j = 0; j < blockSizej; ++j){
-					f(m()(iblock+i,jblock+j), blockStorage[i][j]);
-				}
-			}
-		}
-	}
+	assign_transposed_recursive(m,e,0,m().size1(),0,m().size2(),f);
 }
 
 //dense-sparse case
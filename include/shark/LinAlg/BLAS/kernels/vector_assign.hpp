@@ -30,6 +30,7 @@
 
 #include "../detail/functional.hpp"
 #include "../expression_types.hpp"
+#include "default/simd_transform.hpp"
 
 namespace shark {
 namespace blas {
@@ -53,10 +54,17 @@ void assign(vector_expression<V, cpu_tag>& v, typename V::value_type t) {
 // Dense-Dense case
 template< class V, class E>
 void assign(
-	vector_expression<V, cpu_tag>& v, vector_expression<E, cpu_tag> const& e, 
+	vector_expression<V, cpu_tag>& v, vector_expression<E, cpu_tag> const& e,
 	dense_tag, dense_tag
 ) {
 	SIZE_CHECK(v().size() == e().size());
+	//elementwise transcendental functions of contiguous storage are
+	//evaluated by vectorized batch kernels
+	if(bindings::simd_transform_assign(
+		v(), e(), typename bindings::has_simd_transform<V,E>::type()
+	)){
+		return;
+	}
 	for(std::size_t i = 0; i != v().size(); ++i){
 		v()(i) = static_cast<typename V::value_type>(e()(i));
 	}
@@ -29,6 +29,7 @@
 #define SHARK_LINALG_BLAS_MATRIX_HPP
 
 #include "detail/matrix_proxy_classes.hpp"
+#include "detail/aligned_allocator.hpp"
 #include <array>
 #include <initializer_list>
 #include <boost/serialization/collection_size_type.hpp>
@@ -50,11 +51,12 @@ namespace blas {
  *
  * \tparam T the type of object stored in the matrix (like double, float, complex, etc...)
  * \tparam L the storage organization. It can be either \c row_major or \c column_major. Default is \c row_major
+ * \tparam A allocator providing the storage. Defaults to the 64 byte aligned thread-local arena allocator
  */
-template<class T, class L=row_major>
-class matrix:public matrix_container<matrix<T, L>, cpu_tag > {
-	typedef matrix<T, L> self_type;
-	typedef std::vector<T> array_type;
+template<class T, class L=row_major, class A = aligned_allocator<T> >
+class matrix:public matrix_container<matrix<T, L, A>, cpu_tag > {
+	typedef matrix<T, L, A> self_type;
+	typedef std::vector<T, A> array_type;
 public:
 	typedef typename array_type::value_type value_type;
 	typedef value_type scalar_type;
@@ -353,6 +355,271 @@ private:
 	index_type m_size2;
 	array_type m_data;
 };
+/** \brief A dense matrix of values of type \c T with compile-time fixed dimensions.
+ *
+ * The matrix has the same interface and expression template integration as the
+ * dynamically sized matrix, but its \c M x \c N elements are stored directly
+ * inside the object without heap allocation. Like its dynamic counterpart it
+ * integrates with all kernels through the dense storage interface, so small
+ * products and solves avoid the allocation overhead which dominates their
+ * runtime. Assigning expressions with different dimensions is an error.
+ *
+ * \tparam T the type of object stored in the matrix (like double, float, complex, etc...)
+ * \tparam M number of rows of the matrix
+ * \tparam N number of columns of the matrix
+ * \tparam L the storage organization. It can be either \c row_major or \c column_major. Default is \c row_major
+ */
+template<class T, std::size_t M, std::size_t N, class L=row_major>
+class matrixN:public matrix_container<matrixN<T, M, N, L>, cpu_tag > {
+	typedef matrixN<T, M, N, L> self_type;
+	typedef std::array<T, M*N> array_type;
+public:
+	typedef typename array_type::value_type value_type;
+	typedef value_type scalar_type;
+	typedef typename array_type::const_reference const_reference;
+	typedef typename array_type::reference reference;
+	typedef typename array_type::size_type index_type;
+
+	typedef matrix_reference<self_type const> const_closure_type;
+	typedef matrix_reference<self_type> closure_type;
+	typedef dense_matrix_storage<T> storage_type;
+	typedef dense_matrix_storage<T const> const_storage_type;
+	typedef elementwise<dense_tag> evaluation_category;
+	typedef L orientation;
+
+	// Construction
+
+	/// \brief Default constructor. All elements are initialized to 0.
+	matrixN():m_data{}{}
+
+	/// \brief Constructor with an initial value for all the matrix elements
+	/// \param init initial value assigned to all elements
+	explicit matrixN(value_type const& init){
+		m_data.fill(init);
+	}
+
+	/// \brief Constructor from a nested initializer list.
+	///
+	/// Constructs a matrix like this: m = {{1,2},{3,4}}.
+	/// \param list The nested initializer list storing the values of the matrix.
+	matrixN(std::initializer_list<std::initializer_list<T> > list){
+		SIZE_CHECK(list.size() == M);
+		auto pos = list.begin();
+		for(std::size_t i = 0; i != list.size(); ++i,++pos){
+			SIZE_CHECK(pos->size() == N);
+			std::copy(pos->begin(),pos->end(),row_begin(i));
+		}
+	}
+
+	/// \brief Copy-constructor of a dense matrix
+	///\param m is a dense matrix
+	matrixN(matrixN const& m) = default;
+
+	/// \brief Constructor of a fixed size matrix from a matrix expression.
+	///
+	/// Constructs the matrix by evaluating the expression and assigning the
+	/// results to the newly constructed matrix using a call to assign.
+	/// The expression must have dimensions M x N.
+	///
+	/// \param e is a matrix expression
+	template<class E>
+	matrixN(matrix_expression<E, cpu_tag> const& e){
+		SIZE_CHECK(e().size1() == M);
+		SIZE_CHECK(e().size2() == N);
+		assign(*this,e);
+	}
+
+	// Assignment
+
+	/// \brief Assigns m to this
+	matrixN& operator = (matrixN const& m) = default;
+
+	/// \brief Assigns m to this
+	///
+	/// As containers are assumed to not overlap, no temporary is created
+	///
+	/// \param m is a matrix expression
+	template<class C>
+	matrixN& operator = (matrix_container<C, cpu_tag> const& m) {
+		SIZE_CHECK(m().size1() == M);
+		SIZE_CHECK(m().size2() == N);
+		assign(*this, m);
+		return *this;
+	}
+	/// \brief Assigns e to this
+	///
+	/// A temporary is created to prevent aliasing.
+	///
+	/// \param e is a matrix expression
+	template<class E>
+	matrixN& operator = (matrix_expression<E, cpu_tag> const& e) {
+		self_type temporary(e);
+		swap(temporary);
+		return *this;
+	}
+
+	///\brief Returns the number of rows of the matrix.
+	index_type size1() const {
+		return M;
+	}
+	///\brief Returns the number of columns of the matrix.
+	index_type size2() const {
+		return N;
+	}
+
+	///\brief Returns the underlying storage structure for low level access
+	storage_type raw_storage(){
+		return {m_data.data(), orientation::index_m(M,N)};
+	}
+
+	///\brief Returns the underlying storage structure for low level access
+	const_storage_type raw_storage()const{
+		return {m_data.data(), orientation::index_m(M,N)};
+	}
+
+	// ---------
+	// High level interface
+	// ---------
+
+	/// \brief Resize a matrix. Only asserts that the dimensions match, the storage is fixed.
+	/// \param size1 the new number of rows, must be M
+	/// \param size2 the new number of colums, must be N
+	void resize(index_type size1, index_type size2) {
+		SIZE_CHECK(size1 == M);
+		SIZE_CHECK(size2 == N);
+		(void)size1;(void)size2;
+	}
+
+	void clear(){
+		std::fill(m_data.begin(), m_data.end(), value_type/*zero*/());
+	}
+
+	// Element access
+	const_reference operator()(index_type i, index_type j) const {
+		SIZE_CHECK(i < size1());
+		SIZE_CHECK(j < size2());
+		return m_data[orientation::element(i, M, j, N)];
+	}
+	reference operator()(index_type i, index_type j) {
+		SIZE_CHECK(i < size1());
+		SIZE_CHECK(j < size2());
+		return m_data[orientation::element(i, M, j, N)];
+	}
+
+	void set_element(index_type i, index_type j,value_type t){
+		SIZE_CHECK(i < size1());
+		SIZE_CHECK(j < size2());
+		m_data[orientation::element(i, M, j, N)]  = t;
+	}
+
+	// Swapping
+	void swap(matrixN& m) {
+		m_data.swap(m.m_data);
+	}
+	friend void swap(matrixN& m1, matrixN& m2) {
+		m1.swap(m2);
+	}
+
+	friend void swap_rows(matrixN& a, index_type i, matrixN& b, index_type j){
+		SIZE_CHECK(i < a.size1());
+		SIZE_CHECK(j < b.size1());
+		for(std::size_t k = 0; k != N; ++k){
+			std::swap(a(i,k),b(j,k));
+		}
+	}
+
+	friend void swap_rows(matrixN& a, index_type i, index_type j) {
+		if(i == j) return;
+		swap_rows(a,i,a,j);
+	}
+
+	friend void swap_columns(matrixN& a, index_type i, matrixN& b, index_type j){
+		SIZE_CHECK(i < a.size2());
+		SIZE_CHECK(j < b.size2());
+		for(std::size_t k = 0; k != M; ++k){
+			std::swap(a(k,i),b(k,j));
+		}
+	}
+
+	friend void swap_columns(matrixN& a, index_type i, index_type j) {
+		if(i == j) return;
+		swap_columns(a,i,a,j);
+	}
+
+	//Iterators
+	typedef dense_storage_iterator<value_type> row_iterator;
+	typedef dense_storage_iterator<value_type> column_iterator;
+	typedef dense_storage_iterator<value_type const> const_row_iterator;
+	typedef dense_storage_iterator<value_type const> const_column_iterator;
+
+	const_row_iterator row_begin(index_type i) const {
+		return const_row_iterator(m_data.data() + i*stride1(),0,stride2());
+	}
+	const_row_iterator row_end(index_type i) const {
+		return const_row_iterator(m_data.data() + i*stride1()+stride2()*size2(),size2(),stride2());
+	}
+	row_iterator row_begin(index_type i){
+		return row_iterator(m_data.data() + i*stride1(),0,stride2());
+	}
+	row_iterator row_end(index_type i){
+		return row_iterator(m_data.data() + i*stride1()+stride2()*size2(),size2(),stride2());
+	}
+
+	const_row_iterator column_begin(std::size_t j) const {
+		return const_column_iterator(m_data.data() + j*stride2(),0,stride1());
+	}
+	const_column_iterator column_end(std::size_t j) const {
+		return const_column_iterator(m_data.data() + j*stride2()+ stride1()*size1(),size1(),stride1());
+	}
+	column_iterator column_begin(std::size_t j){
+		return column_iterator(m_data.data() + j*stride2(),0,stride1());
+	}
+	column_iterator column_end(std::size_t j){
+		return column_iterator(m_data.data() + j * stride2()+ stride1() * size1(), size1(), stride1());
+	}
+
+	typedef typename blas::major_iterator<self_type>::type major_iterator;
+
+	//sparse interface
+	major_iterator set_element(major_iterator pos, index_type index, value_type value) {
+		RANGE_CHECK(pos.index() == index);
+		*pos=value;
+		return pos;
+	}
+
+	major_iterator clear_element(major_iterator elem) {
+		*elem = value_type();
+		return elem+1;
+	}
+
+	major_iterator clear_range(major_iterator start, major_iterator end) {
+		std::fill(start,end,value_type());
+		return end;
+	}
+
+	void reserve(index_type non_zeros) {}
+	void reserve_row(std::size_t, std::size_t){}
+	void reserve_column(std::size_t, std::size_t){}
+
+	// Serialization
+	template<class Archive>
+	void serialize(Archive& ar, const unsigned int /* file_version */) {
+		ar& boost::serialization::make_nvp("data",
+			boost::serialization::make_array(m_data.data(), m_data.size())
+		);
+	}
+
+private:
+	index_type stride1() const {
+		return orientation::stride1(M, N);
+	}
+	index_type stride2() const {
+		return orientation::stride2(M, N);
+	}
+
+	array_type m_data;
+};
+
 template<class T, class L>
 struct matrix_temporary_type<T,L,dense_tag, cpu_tag>{
 	typedef matrix<T,L> type;
@@ -130,6 +130,7 @@ SHARK_UNARY_MATRIX_TRANSFORMATION(sqr, scalar_sqr)
 SHARK_UNARY_MATRIX_TRANSFORMATION(abs_sqr, scalar_abs_sqr)
 SHARK_UNARY_MATRIX_TRANSFORMATION(sqrt, scalar_sqrt)
 SHARK_UNARY_MATRIX_TRANSFORMATION(sigmoid, scalar_sigmoid)
+SHARK_UNARY_MATRIX_TRANSFORMATION(safeExp, scalar_safe_exp)
 SHARK_UNARY_MATRIX_TRANSFORMATION(softPlus, scalar_soft_plus)
 SHARK_UNARY_MATRIX_TRANSFORMATION(elem_inv, scalar_inverse)
 #undef SHARK_UNARY_MATRIX_TRANSFORMATION
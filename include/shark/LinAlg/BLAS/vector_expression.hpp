@@ -89,6 +89,7 @@ SHARK_UNARY_VECTOR_TRANSFORMATION(sqr, scalar_sqr)
 SHARK_UNARY_VECTOR_TRANSFORMATION(abs_sqr, scalar_abs_sqr)
 SHARK_UNARY_VECTOR_TRANSFORMATION(sqrt, scalar_sqrt)
 SHARK_UNARY_VECTOR_TRANSFORMATION(sigmoid, scalar_sigmoid)
+SHARK_UNARY_VECTOR_TRANSFORMATION(safeExp, scalar_safe_exp)
 SHARK_UNARY_VECTOR_TRANSFORMATION(softPlus, scalar_soft_plus)
 SHARK_UNARY_VECTOR_TRANSFORMATION(elem_inv, scalar_inverse)
 #undef SHARK_UNARY_VECTOR_TRANSFORMATION
@@ -49,6 +49,7 @@
 #include <shark/LinAlg/Metrics.h>
 //this ensures, that Sequence is serializable
 #include <boost/serialization/deque.hpp>
+#include <cstdint>
 #include <deque>
 
 namespace shark{
@@ -65,6 +66,9 @@ namespace shark{
 	SHARK_VECTOR_MATRIX_TYPEDEFS(std::complex<double>, Complex)
 	SHARK_VECTOR_MATRIX_TYPEDEFS(int, Int)
 	SHARK_VECTOR_MATRIX_TYPEDEFS(unsigned int, UInt)
+	//narrow storage types for low-cardinality features, see Data/NarrowStorage.h
+	SHARK_VECTOR_MATRIX_TYPEDEFS(std::uint8_t, UInt8)
+	SHARK_VECTOR_MATRIX_TYPEDEFS(std::uint16_t, UInt16)
         SHARK_VECTOR_MATRIX_TYPEDEFS(bool, Bool);
 #undef SHARK_VECTOR_MATRIX_TYPEDEFS
 
@@ -41,6 +41,7 @@
 
 #include <shark/Data/Dataset.h>
 #include <shark/LinAlg/Base.h>
+#include <shark/LinAlg/CachedMatrix.h>
 
 #include <vector>
 #include <cmath>
@@ -95,9 +96,24 @@ public:
     ///
     ///The entries start,...,end of the i-th row are computed and stored in storage.
     ///There must be enough room for this operation preallocated.
+    ///
+    ///Long ranges delegate to the row machinery of the underlying matrix,
+    ///which evaluates in parallel, and gather the entries through the
+    ///variable permutation; short ranges are computed entry by entry.
     void row(std::size_t i, std::size_t start,std::size_t end, QpFloatType* storage) const{
+        std::size_t basesize = m_base->size();
+        if(2 * (end - start) < basesize){
+            for(std::size_t j = start; j < end; j++){
+                storage[j-start] = m_base->entry(m_mapping[i], m_mapping[j]);
+            }
+            return;
+        }
+        //the base matrix is never flipped, so its rows stay in the
+        //original coordinate order addressed by the mapping
+        std::vector<QpFloatType> baseRow(basesize);
+        m_base->row(m_mapping[i], 0, basesize, &baseRow[0]);
         for(std::size_t j = start; j < end; j++){
-            storage[j-start] = m_base->entry(m_mapping[i], m_mapping[j]);
+            storage[j-start] = baseRow[m_mapping[j]];
         }
     }
     
@@ -131,5 +147,122 @@ protected:
     std::vector<std::size_t> m_mapping;
 };
 
+
+///
+/// \brief Cached SVM regression matrix with shared rows for twin variables
+///
+/// \par
+/// In the doubled regression problem the variables i and i+n both refer to
+/// example i, so the rows i and i+n of the \f$ 2n \times 2n \f$ block matrix
+/// contain exactly the same kernel values, each of them twice. Caching the
+/// block matrix directly therefore stores every kernel value up to four
+/// times. This class instead maintains a CachedMatrix of the underlying
+/// \f$ n \times n \f$ kernel matrix and assembles requested rows of the
+/// doubled problem by gathering from the shared cached base row through the
+/// variable permutation, so both twins hit the same cache line and the cache
+/// effectively quadruples in capacity. Assembled rows are returned from two
+/// rotating buffers, since the solver accesses at most two rows at a time.
+///
+template <class Matrix>
+class CachedBlockMatrix2x2
+{
+public:
+    typedef typename Matrix::QpFloatType QpFloatType;
+
+    /// Constructor.
+    /// \param base       underlying matrix M, see class description of BlockMatrix2x2.
+    /// \param cachesize  size of the cache for the base matrix, in QpFloatTypes.
+    CachedBlockMatrix2x2(Matrix* base, std::size_t cachesize = 0x4000000)
+    : m_cache(base, cachesize)
+    , m_mapping(2 * base->size())
+    , m_nextStorage(0)
+    {
+        std::size_t ic = base->size();
+        for (std::size_t i = 0; i < ic; i++)
+        {
+            m_mapping[i] = i;
+            m_mapping[i + ic] = i;
+        }
+        m_rowStorage[0].resize(size());
+        m_rowStorage[1].resize(size());
+    }
+
+    /// return a single matrix entry
+    QpFloatType operator () (std::size_t i, std::size_t j) const
+    { return entry(i, j); }
+
+    /// return a single matrix entry
+    QpFloatType entry(std::size_t i, std::size_t j) const
+    {
+        return m_cache.entry(m_mapping[i], m_mapping[j]);
+    }
+
+    /// \brief Computes the i-th row of the kernel matrix.
+    ///
+    ///The entries start,...,end of the i-th row are computed and stored in storage.
+    ///There must be enough room for this operation preallocated.
+    ///The access does not influence the cache.
+    void row(std::size_t i, std::size_t start, std::size_t end, QpFloatType* storage) const{
+        SIZE_CHECK(start <= end);
+        SIZE_CHECK(end <= size());
+        std::vector<QpFloatType> baseRow(m_cache.size());
+        m_cache.row(m_mapping[i], 0, m_cache.size(), &baseRow[0]);
+        for(std::size_t j = start; j < end; j++){
+            storage[j - start] = baseRow[m_mapping[j]];
+        }
+    }
+
+    /// \brief Return a subset of a matrix row
+    ///
+    /// \par
+    /// This method returns an array of QpFloatType with at least
+    /// the entries in the interval [begin, end[ filled in. The
+    /// returned pointer stays valid over one further row request.
+    ///
+    /// \param i      matrix row
+    /// \param begin  first column to be filled in
+    /// \param end    last column to be filled in +1
+    QpFloatType* row(std::size_t i, std::size_t begin, std::size_t end){
+        (void)begin;//unused
+        SIZE_CHECK(end <= size());
+        //cache the full base row; both twins of i and all columns share it
+        QpFloatType* line = m_cache.row(m_mapping[i], 0, m_cache.size());
+        std::vector<QpFloatType>& storage = m_rowStorage[m_nextStorage];
+        m_nextStorage = 1 - m_nextStorage;
+        for(std::size_t j = 0; j < end; j++){
+            storage[j] = line[m_mapping[j]];
+        }
+        return &storage[0];
+    }
+
+    /// swap two variables
+    void flipColumnsAndRows(std::size_t i, std::size_t j)
+    {
+        std::swap(m_mapping[i], m_mapping[j]);
+    }
+
+    /// return the size of the quadratic matrix
+    std::size_t size() const
+    { return 2 * m_cache.size(); }
+
+    /// return the size of the kernel cache (in "number of QpFloatType-s")
+    std::size_t getMaxCacheSize() const
+    { return m_cache.getMaxCacheSize(); }
+
+protected:
+    /// cache of the underlying kernel matrix; never flipped, so its
+    /// rows stay in the original coordinate order of the examples
+    CachedMatrix<Matrix> m_cache;
+
+    /// coordinate permutation of the doubled problem
+    std::vector<std::size_t> m_mapping;
+
+    /// rotating buffers holding the two most recently assembled rows
+    std::vector<QpFloatType> m_rowStorage[2];
+
+    /// buffer to be used for the next assembled row
+    std::size_t m_nextStorage;
+};
+
 }
 #endif
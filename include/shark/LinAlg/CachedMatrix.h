@@ -39,10 +39,13 @@
 #ifndef SHARK_LINALG_CACHEDMATRIX_H
 #define SHARK_LINALG_CACHEDMATRIX_H
 
+#include <shark/Core/Profiler.h>
 #include <shark/Data/Dataset.h>
 #include <shark/LinAlg/Base.h>
+#include <shark/LinAlg/KernelRowStore.h>
 #include <shark/LinAlg/LRUCache.h>
 
+#include <string>
 #include <vector>
 #include <cmath>
 
@@ -153,6 +156,16 @@ namespace shark {
 /// have information on the fullness of the cache (although this functionality
 /// could easily be added).
 ///
+/// \par
+/// Optionally, a CachedMatrix can attach to the process-wide KernelRowStore
+/// via attachRowStore(..) as a second-level cache. On a miss, the row method
+/// then first checks whether another cache of the process already published
+/// the complete row under the same fingerprint, and completely evaluated rows
+/// are published for later trainer instances over the same dataset and kernel
+/// configuration. Since the store keeps rows in the original column order,
+/// the CachedMatrix tracks its own row/column permutation and translates
+/// through it when exchanging rows with the store.
+///
 template <class Matrix>
 class CachedMatrix
 {
@@ -163,8 +176,27 @@ public:
     /// \param base       Matrix to cache
     /// \param cachesize  Main memory to use as a kernel cache, in QpFloatTypes. Default is 256MB if QpFloatType is float, 512 if double.
     CachedMatrix(Matrix* base, std::size_t cachesize = 0x4000000)
-    : mep_baseMatrix(base), m_cache( base->size(),cachesize ){}
-        
+    : mep_baseMatrix(base), m_cache( base->size(),cachesize )
+    , mep_rowStore(NULL), m_storeIndex(base->size()){
+        for(std::size_t i = 0; i != m_storeIndex.size(); ++i)
+            m_storeIndex[i] = i;
+    }
+
+    /// \brief Attaches the process-wide KernelRowStore as a second-level cache.
+    ///
+    /// \param key fingerprint identifying the dataset and kernel parameters; rows
+    /// are shared only between caches attached under an identical key, see
+    /// kernelRowStoreKey(..) in KernelHelpers.h.
+    void attachRowStore(std::string const& key){
+        mep_rowStore = &KernelRowStore<QpFloatType>::instance();
+        m_rowStoreKey = key;
+    }
+
+    /// \brief Detaches the cache from the shared row store.
+    void detachRowStore(){
+        mep_rowStore = NULL;
+    }
+
     /// \brief Copies the range [start,end) of the k-th row of the matrix in external storage
     ///
     /// This call regards the access to the line as out-of-order, thus the cache is not influenced.
@@ -198,10 +230,30 @@ public:
         (void)start;//unused
         //Save amount of entries already cached
         std::size_t cached= m_cache.lineLength(k);
+        SHARK_PROFILE_COUNT_N("CachedMatrix.cachedEntries",std::min(cached,end));
         //create or extend cache line
         QpFloatType* line = m_cache.getCacheLine(k,end);
-        if (end > cached)//compute entries not already cached
-            mep_baseMatrix->row(k,cached,end,line+cached);
+        if (end > cached){//compute entries not already cached
+            //second level: check whether another cache already published the row
+            if (mep_rowStore && mep_rowStore->read(m_rowStoreKey,m_storeIndex[k],m_storeScratch)){
+                SHARK_PROFILE_COUNT_N("CachedMatrix.sharedEntries",end-cached);
+                //the stored row is complete and in original column order,
+                //gather the missing entries through the permutation
+                for(std::size_t j = cached; j != end; ++j)
+                    line[j] = m_storeScratch[m_storeIndex[j]];
+            }
+            else{
+                SHARK_PROFILE_COUNT_N("CachedMatrix.computedEntries",end-cached);
+                mep_baseMatrix->row(k,cached,end,line+cached);
+                if (mep_rowStore && end == size()){
+                    //a complete row was materialized, publish it in original order
+                    m_storeScratch.resize(size());
+                    for(std::size_t j = 0; j != end; ++j)
+                        m_storeScratch[m_storeIndex[j]] = line[j];
+                    mep_rowStore->publish(m_rowStoreKey,m_storeIndex[k],&m_storeScratch[0],end);
+                }
+            }
+        }
         return line;
     }
 
@@ -246,6 +298,7 @@ public:
                 line[i] = mep_baseMatrix->entry(k, j);
         }
         m_cache.swapLineIndices(i,j);
+        std::swap(m_storeIndex[i],m_storeIndex[j]);
         mep_baseMatrix->flipColumnsAndRows(i, j);
     }
 
@@ -290,7 +343,12 @@ public:
 protected:
     Matrix* mep_baseMatrix; ///< matrix to be cached
 
-    LRUCache<QpFloatType> m_cache; ///< cache of the matrix lines
+    ShardedLRUCache<QpFloatType> m_cache; ///< sharded cache of the matrix lines
+
+    KernelRowStore<QpFloatType>* mep_rowStore; ///< optional second-level row store shared between caches, NULL if not attached
+    std::string m_rowStoreKey; ///< fingerprint under which rows are shared
+    std::vector<std::size_t> m_storeIndex; ///< original index of every row/column, tracked across flips
+    std::vector<QpFloatType> m_storeScratch; ///< scratch row in original column order
 };
 
 }
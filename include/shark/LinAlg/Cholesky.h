@@ -81,29 +81,17 @@ void choleskyDecomposition(
 }
 
 
-/// \brief Updates a covariance factor by a rank one update
-///
-/// Let \f$ A=LL^T \f$ be a matrix with its lower cholesky factor. Assume we want to update 
-/// A using a simple rank-one update \f$ A = \alpha A+ \beta vv^T \f$. This invalidates L and
-/// it needs to be recomputed which is O(n^3). instead we can update the factorisation
-/// directly by performing a similar, albeit more complex algorithm on L, which can be done
-/// in O(L^2). 
-/// 
-/// Alpha is not required to be positive, but if it is not negative, one has to be carefull
-/// that the update would keep A positive definite. Otherwise the decomposition does not
-/// exist anymore and an exception is thrown.
-///
-/// \param L the lower cholesky factor to be updated
-/// \param v the update vector
-/// \param alpha the scaling factor, must be positive.
-/// \param beta the update factor. it Can be positive or negative
+namespace detail{
+
+//column-wise formulation, traverses L along its columns.
+//implementation blatantly stolen from Eigen
 template<class Matrix,class Vector>
-void choleskyUpdate(
-	matrix_expression<Matrix, cpu_tag>& L, 
-	vector_expression<Vector, cpu_tag> const& v, 
-	double alpha, double beta
+void choleskyUpdateImpl(
+	matrix_expression<Matrix, cpu_tag>& L,
+	vector_expression<Vector, cpu_tag> const& v,
+	double alpha, double beta,
+	column_major
 ){
-	//implementation blatantly stolen from Eigen
 	std::size_t n = v().size();
 	blas::vector<double> temp = v();
 	double betaPrime = 1;
@@ -122,7 +110,7 @@ void choleskyUpdate(
 		double nLjj = std::sqrt(x);
 		L()(j,j) = nLjj;
 		betaPrime += swj2/dj;
-		
+
 		// Update the terms of L
 		if(j+1 <n)
 		{
@@ -136,6 +124,75 @@ void choleskyUpdate(
 	}
 }
 
+//row-wise formulation for row-major factors. The update is expressed as a
+//sequence of plane rotations - trigonometric for updates, hyperbolic for
+//downdates - whose coefficients only depend on already processed rows. Every
+//row of L is therefore brought up to date in one contiguous sweep, which is
+//cache friendly for row-major storage where column access is strided.
+template<class Matrix,class Vector>
+void choleskyUpdateImpl(
+	matrix_expression<Matrix, cpu_tag>& L,
+	vector_expression<Vector, cpu_tag> const& v,
+	double alpha, double beta,
+	row_major
+){
+	std::size_t n = v().size();
+	double eps = beta < 0? -1.0 : 1.0;
+	double a = std::sqrt(alpha);
+	double sqrtBeta = std::sqrt(std::abs(beta));
+	blas::vector<double> c(n);
+	blas::vector<double> s(n);
+	for(std::size_t i = 0; i != n; ++i){
+		double wi = sqrtBeta * v()(i);
+		//apply the rotations of the previous columns to row i
+		for(std::size_t j = 0; j != i; ++j){
+			double x = a * L()(i,j);
+			L()(i,j) = c(j) * x + eps * s(j) * wi;
+			wi = c(j) * wi - s(j) * x;
+		}
+		//compute the rotation annihilating the remaining weight on the diagonal
+		double Lii = a * L()(i,i);
+		double r2 = Lii * Lii + eps * wi * wi;
+		if (r2 <= 0.0)
+			throw SHARKEXCEPTION("[choleskyUpdate] update makes matrix indefinite, no update available");
+		double r = std::sqrt(r2);
+		L()(i,i) = r;
+		c(i) = Lii / r;
+		s(i) = wi / r;
+	}
+}
+
+}
+
+/// \brief Updates a covariance factor by a rank one update
+///
+/// Let \f$ A=LL^T \f$ be a matrix with its lower cholesky factor. Assume we want to update
+/// A using a simple rank-one update \f$ A = \alpha A+ \beta vv^T \f$. This invalidates L and
+/// it needs to be recomputed which is O(n^3). instead we can update the factorisation
+/// directly by performing a similar, albeit more complex algorithm on L, which can be done
+/// in O(L^2).
+///
+/// Alpha is not required to be positive, but if it is not negative, one has to be carefull
+/// that the update would keep A positive definite. Otherwise the decomposition does not
+/// exist anymore and an exception is thrown.
+///
+/// The implementation is chosen based on the orientation of L: row-major
+/// factors are updated row by row using plane rotations, column-major factors
+/// column by column, so both traverse the factor along its stride-1 direction.
+///
+/// \param L the lower cholesky factor to be updated
+/// \param v the update vector
+/// \param alpha the scaling factor, must be positive.
+/// \param beta the update factor. it Can be positive or negative
+template<class Matrix,class Vector>
+void choleskyUpdate(
+	matrix_expression<Matrix, cpu_tag>& L,
+	vector_expression<Vector, cpu_tag> const& v,
+	double alpha, double beta
+){
+	detail::choleskyUpdateImpl(L,v,alpha,beta,typename Matrix::orientation());
+}
+
 /*!
  *  \brief Lower triangular Cholesky decomposition with full pivoting performed in place.
  *
@@ -39,6 +39,7 @@
 #ifndef SHARK_LINALG_DIFFERENCEKERNELMATRIX_H
 #define SHARK_LINALG_DIFFERENCEKERNELMATRIX_H
 
+#include <shark/Core/OpenMP.h>
 #include <shark/Data/Dataset.h>
 #include <shark/Data/DataView.h>
 #include <shark/LinAlg/Base.h>
@@ -74,6 +75,8 @@ public:
 	: m_kernel(kernel)
 	, m_dataset(dataset)
 	, m_indices(pairs.size())
+	, m_flatPairs(pairs)
+	, m_batchStart(dataset.numberOfBatches())
 	{
 		DataView< Data<InputType> const > view(dataset);
 		for (std::size_t i=0; i<pairs.size(); i++)
@@ -83,6 +86,13 @@ public:
 					view.batch(p.first), view.positionInBatch(p.first),
 					view.batch(p.second), view.positionInBatch(p.second));
 		}
+		std::size_t offset = 0;
+		for (std::size_t b=0; b<dataset.numberOfBatches(); b++)
+		{
+			m_batchStart[b] = offset;
+			offset += shark::size(dataset.batch(b));
+		}
+		m_elements = offset;
 	}
 
 
@@ -119,8 +129,46 @@ public:
 	///
 	/// The entries start,...,end of the i-th row are computed and stored in storage.
 	/// There must be enough room for this operation preallocated.
+	///
+	/// Long ranges are assembled from two batched kernel rows: \f$ k(g_i, x) \f$
+	/// and \f$ k(s_i, x) \f$ are evaluated against all points with blockwise
+	/// kernel calls, parallel over the dataset batches, and the difference
+	/// entries are then gathered from those values. Short ranges fall back to
+	/// entry-wise computation, which needs four kernel values per entry.
 	void row(std::size_t i, std::size_t start, std::size_t end, QpFloatType* storage) const {
-		for (std::size_t j = start; j < end; j++) storage[j-start] = entry(i, j);
+		if (2 * (end - start) < m_elements) {
+			for (std::size_t j = start; j < end; j++) storage[j-start] = entry(i, j);
+			return;
+		}
+
+		std::tuple<std::size_t, std::size_t, std::size_t, std::size_t> const& pi = m_indices[i];
+		typedef typename Data<InputType>::const_element_reference reference;
+		reference si = shark::get(m_dataset.batch(std::get<0>(pi)), std::get<1>(pi));
+		reference gi = shark::get(m_dataset.batch(std::get<2>(pi)), std::get<3>(pi));
+		typename Batch<InputType>::type pairBatch = Batch<InputType>::createBatch(si, 2);
+		shark::get(pairBatch, 0) = si;
+		shark::get(pairBatch, 1) = gi;
+
+		RealVector ks(m_elements);
+		RealVector kg(m_elements);
+		SHARK_PARALLEL_FOR(int b = 0; b < (int)m_dataset.numberOfBatches(); b++)
+		{
+			RealMatrix block;
+			m_kernel.eval(pairBatch, m_dataset.batch(b), block);
+			std::size_t offset = m_batchStart[b];
+			for (std::size_t k = 0; k != block.size2(); k++)
+			{
+				ks(offset + k) = block(0, k);
+				kg(offset + k) = block(1, k);
+			}
+		}
+
+		for (std::size_t j = start; j < end; j++)
+		{
+			std::size_t sj = m_flatPairs[j].first;
+			std::size_t gj = m_flatPairs[j].second;
+			storage[j-start] = QpFloatType(kg(gj) - kg(sj) - ks(gj) + ks(sj));
+		}
 	}
 
 	/// \brief Computes the kernel-matrix
@@ -138,6 +186,7 @@ public:
 	{
 		using namespace std;
 		swap(m_indices[i], m_indices[j]);
+		swap(m_flatPairs[i], m_flatPairs[j]);
 	}
 
     /// return the size of the quadratic matrix
@@ -153,6 +202,15 @@ protected:
 
 	/// pairs of points defining the matrix components
 	std::vector<std::tuple<std::size_t, std::size_t, std::size_t, std::size_t>> m_indices;
+
+	/// the same pairs as flat element indices, for gathering from batched kernel rows
+	std::vector<std::pair<std::size_t, std::size_t>> m_flatPairs;
+
+	/// first element index of each batch of the dataset
+	std::vector<std::size_t> m_batchStart;
+
+	/// total number of points in the dataset
+	std::size_t m_elements;
 };
 
 }
@@ -41,6 +41,7 @@
 
 #include <shark/Data/Dataset.h>
 #include <shark/LinAlg/Base.h>
+#include <shark/Core/Traits/ProxyReferenceTraits.h>
 
 #include <vector>
 #include <cmath>
@@ -110,9 +111,7 @@ public:
     void matrix(
         blas::matrix_expression<M, blas::cpu_tag> & storage
     ) const{
-        for(std::size_t i = 0; i != size(); ++i){
-            row(i,0,size(),&storage()(i,0));
-        }
+        matrixImpl(storage(), typename T::evaluation_category::tag());
     }
 
     /// swap two variables
@@ -136,6 +135,44 @@ public:
 
 protected:
 
+    /// \brief Row-wise computation of the kernel-matrix, used when the inputs are sparse.
+    template<class M>
+    void matrixImpl(M& storage, blas::sparse_tag) const{
+        for(std::size_t i = 0; i != size(); ++i){
+            row(i,0,size(),&storage(i,0));
+        }
+    }
+
+    /// \brief Computation of the kernel-matrix for dense inputs.
+    ///
+    /// The pairwise squared distances are assembled from the identity
+    /// \f$ \|x_i-x_j\|^2 = \|x_i\|^2+\|x_j\|^2-2 x_i^T x_j \f$, so that the
+    /// dominant cost is a single matrix-matrix product instead of one inner
+    /// product per entry. The product is computed in row blocks which keeps
+    /// the temporary small when the target matrix has reduced precision.
+    template<class M>
+    void matrixImpl(M& storage, blas::dense_tag) const{
+        std::size_t n = size();
+        m_accessCounter += n * n;
+        std::size_t dim = n == 0? 0: x[0]->size();
+        //gather the data in its current (possibly flipped) order
+        RealMatrix X(n,dim);
+        for(std::size_t i = 0; i != n; ++i){
+            noalias(blas::row(X,i)) = *x[i];
+        }
+        std::size_t blockSize = 256;
+        RealMatrix distances(std::min(blockSize,n),n);
+        for(std::size_t start = 0; start < n; start += blockSize){
+            std::size_t numRows = std::min(blockSize, n - start);
+            auto block = subrange(distances,0,numRows,0,n);
+            noalias(block) = -2*prod(rows(X,start,start+numRows),trans(X));
+            for(std::size_t i = 0; i != numRows; ++i){
+                noalias(blas::row(block,i)) += blas::repeat(m_squaredNorms(start+i),n) + m_squaredNorms;
+            }
+            noalias(rows(storage,start,start+numRows)) = exp(-m_gamma*block);
+        }
+    }
+
     //~ typedef blas::sparse_vector_adaptor<typename T::value_type const,std::size_t> PointerType;
     typedef typename Data<InputType>::const_element_range::iterator PointerType;
     /// Array of data pointers for kernel evaluations
@@ -40,6 +40,7 @@
 #define SHARK_LINALG_KERNELMATRIX_H
 
 
+#include <shark/Core/Profiler.h>
 #include <shark/Data/Dataset.h>
 #include <shark/LinAlg/Base.h>
 #include <shark/Models/Kernels/KernelHelpers.h>
@@ -106,8 +107,10 @@ public:
     ///The entries start,...,end of the i-th row are computed and stored in storage.
     ///There must be enough room for this operation preallocated.
     void row(std::size_t i, std::size_t start,std::size_t end, QpFloatType* storage) const{
+        SHARK_PROFILE_SCOPE("KernelMatrix.row");
+        SHARK_PROFILE_COUNT_N("KernelMatrix.evaluations",end-start);
         m_accessCounter += end-start;
-        
+
         typename AbstractKernelFunction<InputType>::ConstInputReference xi = *x[i];
         SHARK_PARALLEL_FOR(int j = (int)start; j < (int) end; j++)
         {
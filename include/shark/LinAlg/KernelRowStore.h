@@ -0,0 +1,186 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Process-wide second-level store of kernel matrix rows
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_LINALG_KERNELROWSTORE_H
+#define SHARK_LINALG_KERNELROWSTORE_H
+
+#include <shark/Core/Exception.h>
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+namespace shark{
+
+/// \brief Process-wide store of complete kernel matrix rows, shared between caches.
+///
+/// When several trainer instances are created over the same dataset and kernel
+/// configuration - the typical situation in a grid search or cross validation -
+/// every instance builds its own CachedMatrix and recomputes kernel rows which
+/// another instance evaluated moments before. This class keeps fully evaluated
+/// rows in one place, keyed by a fingerprint string identifying the dataset and
+/// the kernel parameters together with the row index. A CachedMatrix attached
+/// via its attachRowStore() method consults the store on a cache miss and
+/// publishes complete rows it had to compute itself, so later instances with
+/// the same fingerprint obtain them by a copy instead of a kernel evaluation.
+///
+/// Rows are stored in the original, unpermuted column order; the attached
+/// caches translate through their own row/column permutations. The store
+/// evicts least recently used rows once its memory budget is exceeded, see
+/// setMaxSize(). All operations lock one mutex - the store sits on the
+/// coarse-grained miss path of the caches, not on their per-entry access path.
+template<class T>
+class KernelRowStore{
+public:
+	/// \brief Returns the store shared by all caches of the process.
+	static KernelRowStore& instance(){
+		static KernelRowStore store;
+		return store;
+	}
+
+	/// \brief Copies a stored row into the provided buffer.
+	///
+	/// Marks the row as most recently used on a hit.
+	/// \param key    fingerprint of the dataset and kernel parameters
+	/// \param row    index of the row in original order
+	/// \param values receives the complete row on a hit, untouched otherwise
+	/// \return whether the row was found
+	bool read(std::string const& key, std::size_t row, std::vector<T>& values){
+		std::lock_guard<std::mutex> guard(m_lock);
+		typename std::map<Key,Entry>::iterator pos = m_rows.find(Key(key,row));
+		if(pos == m_rows.end())
+			return false;
+		m_lruList.splice(m_lruList.begin(),m_lruList,pos->second.position);
+		values.assign(pos->second.values.begin(),pos->second.values.end());
+		return true;
+	}
+
+	/// \brief Stores a complete row, evicting old rows if the budget is exceeded.
+	///
+	/// A row already stored under the same key is replaced. Rows bigger than the
+	/// whole budget are ignored.
+	/// \param key    fingerprint of the dataset and kernel parameters
+	/// \param row    index of the row in original order
+	/// \param values the row values in original column order
+	/// \param length the number of values, that is the size of the matrix
+	void publish(std::string const& key, std::size_t row, T const* values, std::size_t length){
+		SIZE_CHECK(length > 0);
+		std::lock_guard<std::mutex> guard(m_lock);
+		if(length > m_maxSize)
+			return;
+		typename std::map<Key,Entry>::iterator pos = m_rows.find(Key(key,row));
+		if(pos != m_rows.end()){
+			m_size -= pos->second.values.size();
+			pos->second.values.assign(values,values+length);
+			m_lruList.splice(m_lruList.begin(),m_lruList,pos->second.position);
+		}else{
+			m_lruList.push_front(Key(key,row));
+			Entry& entry = m_rows[Key(key,row)];
+			entry.values.assign(values,values+length);
+			entry.position = m_lruList.begin();
+		}
+		m_size += length;
+		while(m_size > m_maxSize){
+			removeRow(m_lruList.back());//remove the oldest row
+		}
+	}
+
+	/// \brief Sets the memory budget of the store (in "number of T-s").
+	///
+	/// Shrinking the budget evicts rows until the store fits into it again.
+	void setMaxSize(std::size_t maxSize){
+		std::lock_guard<std::mutex> guard(m_lock);
+		m_maxSize = maxSize;
+		while(m_size > m_maxSize){
+			removeRow(m_lruList.back());
+		}
+	}
+
+	/// \brief Returns the memory budget of the store (in "number of T-s").
+	std::size_t maxSize()const{
+		std::lock_guard<std::mutex> guard(m_lock);
+		return m_maxSize;
+	}
+
+	/// \brief Returns the currently used size of the store (in "number of T-s").
+	std::size_t size()const{
+		std::lock_guard<std::mutex> guard(m_lock);
+		return m_size;
+	}
+
+	/// \brief Returns the number of rows currently stored.
+	std::size_t storedRows()const{
+		std::lock_guard<std::mutex> guard(m_lock);
+		return m_rows.size();
+	}
+
+	/// \brief Removes all stored rows.
+	void clear(){
+		std::lock_guard<std::mutex> guard(m_lock);
+		m_rows.clear();
+		m_lruList.clear();
+		m_size = 0;
+	}
+private:
+	typedef std::pair<std::string,std::size_t> Key;
+	/// a stored row together with its position in the lru list
+	struct Entry{
+		std::vector<T> values; ///< the row values in original column order
+		typename std::list<Key>::iterator position; ///< position in the lru list
+	};
+
+	KernelRowStore():m_size(0),m_maxSize(0x4000000){}
+	KernelRowStore(KernelRowStore const&);//not copyable
+	KernelRowStore& operator=(KernelRowStore const&);//not assignable
+
+	/// \brief Removes a stored row. The lock must be held by the caller.
+	void removeRow(Key const& key){
+		typename std::map<Key,Entry>::iterator pos = m_rows.find(key);
+		m_size -= pos->second.values.size();
+		m_lruList.erase(pos->second.position);
+		m_rows.erase(pos);
+	}
+
+	std::map<Key,Entry> m_rows; ///< stored rows by (fingerprint, row index)
+	std::list<Key> m_lruList; ///< keys ordered by last use, newest first
+	std::size_t m_size; ///< current size of the store in T
+	std::size_t m_maxSize; ///< maximum size of the store in T
+	mutable std::mutex m_lock; ///< guards all members
+};
+
+}
+#endif
@@ -36,6 +36,7 @@
 
 #include <shark/Core/Exception.h>
 #include <boost/intrusive/list.hpp>
+#include <mutex>
 #include <vector>
 
 
@@ -253,7 +254,283 @@ private:
 	std::size_t m_cacheSize;//current size of cache in T
 	std::size_t m_maxSize;//maximum size of cache in T
 
-	
+
+};
+
+/// \brief Sharded LRU-Cache allowing concurrent access from several threads.
+///
+/// The cache lines are distributed round-robin over a number of independent
+/// shards, each holding its own LRU list, memory budget and lock. Threads
+/// accessing lines in different shards therefore never contend on a shared
+/// list, which removes the main serialisation point when kernel rows are
+/// evaluated in parallel. Each shard evicts only among its own lines, so the
+/// replacement decisions are approximately LRU: a line swapped into another
+/// shard is treated as most recently used. The interface mirrors LRUCache;
+/// all operations lock only the shards they touch.
+template<class T>
+class ShardedLRUCache{
+	/// cache data held for every example
+	struct CacheEntry:  public boost::intrusive::list_base_hook<>
+	{
+		T* data; ///< pointer to the beginning of the matrix row
+		std::size_t length; ///< length of the currently calculated strip of variables
+		CacheEntry():length(0){}
+	};
+	/// independent LRU list with its own budget and lock
+	struct Shard{
+		boost::intrusive::list<CacheEntry> lruList;
+		std::size_t cacheSize;
+		std::size_t maxSize;
+		std::mutex lock;
+		Shard():cacheSize(0),maxSize(0){}
+	};
+public:
+	/// \brief Creates a cache with a given maximum index "lines", maximum total size and number of shards.
+	///
+	/// The memory budget is split evenly over the shards. More shards reduce
+	/// lock contention but make the eviction decisions more local.
+	ShardedLRUCache(std::size_t lines, std::size_t cachesize = 0x4000000, std::size_t shards = 8)
+	: m_cacheEntry(lines)
+	, m_shards(std::min(std::max<std::size_t>(shards,1),std::max<std::size_t>(lines,1))){
+		for(std::size_t s = 0; s != m_shards.size(); ++s){
+			m_shards[s].maxSize = cachesize/m_shards.size();
+		}
+	}
+
+	~ShardedLRUCache(){
+		clear();
+	}
+
+	///\brief Returns true if the line is cached.
+	bool isCached(std::size_t i)const{
+		return m_cacheEntry[i].length != 0;
+	}
+	///\brief Returns the size of the cached line.
+	std::size_t lineLength(std::size_t i)const{
+		return m_cacheEntry[i].length;
+	}
+
+	/// \brief Returns the number of lines currently allocated.
+	std::size_t cachedLines()const{
+		std::size_t lines = 0;
+		for(std::size_t s = 0; s != m_shards.size(); ++s){
+			lines += m_shards[s].lruList.size();
+		}
+		return lines;
+	}
+
+	///\brief Returns the line with index i with the correct size.
+	///
+	///If the line is not cached, it is created with the exact size. if it is cached
+	///and is at least as big, it is returned unchanged. otherwise it is
+	///resized to the proper size and the old values are kept.
+	T* getCacheLine(std::size_t i, std::size_t size){
+		Shard& shard = shardOf(i);
+		std::lock_guard<std::mutex> guard(shard.lock);
+		CacheEntry& entry = m_cacheEntry[i];
+		if(!isCached(i))
+			cacheCreateRow(shard,entry,size);
+		else{
+			if(entry.length >= size){
+				shard.lruList.erase(shard.lruList.iterator_to(entry));
+				shard.lruList.push_front(entry);
+			}
+			else
+				resizeLine(shard,entry,size);
+		}
+		return entry.data;
+	}
+
+	///\brief Just returns the pointer to the i-th line without affcting cache at all.
+	T* getLinePointer(std::size_t i){
+		return m_cacheEntry[i].data;
+	}
+
+	///\brief Just returns the pointer to the i-th line without affcting cache at all.
+	T const* getLinePointer(std::size_t i)const{
+		return m_cacheEntry[i].data;
+	}
+
+	/// \brief Resizes a line while retaining the data stored inside it.
+	///
+	/// if the new size is smaller than the old, only the first size entries are saved.
+	void resizeLine(std::size_t i ,std::size_t size){
+		Shard& shard = shardOf(i);
+		std::lock_guard<std::mutex> guard(shard.lock);
+		resizeLine(shard,m_cacheEntry[i],size);
+	}
+
+	///\brief Marks cache line i for deletion, that is the next time memory is needed, this line will be freed.
+	void markLineForDeletion(std::size_t i){
+		if(!isCached(i)) return;
+		Shard& shard = shardOf(i);
+		std::lock_guard<std::mutex> guard(shard.lock);
+		CacheEntry& block = m_cacheEntry[i];
+		shard.lruList.erase(shard.lruList.iterator_to(block));
+		shard.lruList.push_back(block);
+	}
+
+	///\brief swaps index of lines i and j.
+	///
+	/// When the lines live in different shards, the one moving into a shard is
+	/// treated as the most recently used line of that shard.
+	void swapLineIndices(std::size_t i, std::size_t j){
+		if( i == j || (!isCached(i) && !isCached(j)))  return;
+		Shard& shardi = shardOf(i);
+		Shard& shardj = shardOf(j);
+		if(&shardi == &shardj){
+			std::lock_guard<std::mutex> guard(shardi.lock);
+			swapInShard(shardi,m_cacheEntry[i],m_cacheEntry[j]);
+			return;
+		}
+		//lock both shards in a fixed order to prevent deadlocks
+		Shard& first = &shardi < &shardj? shardi: shardj;
+		Shard& second = &shardi < &shardj? shardj: shardi;
+		std::lock_guard<std::mutex> guard1(first.lock);
+		std::lock_guard<std::mutex> guard2(second.lock);
+
+		CacheEntry& cachei = m_cacheEntry[i];
+		CacheEntry& cachej = m_cacheEntry[j];
+		//move list membership between the shards as needed. The entries
+		//themselves stay associated with their index, only data and length move.
+		if(cachei.length != 0 && cachej.length == 0){
+			shardi.lruList.erase(shardi.lruList.iterator_to(cachei));
+			shardi.cacheSize -= cachei.length;
+			shardj.lruList.push_front(cachej);
+			shardj.cacheSize += cachei.length;
+		}else if(cachei.length == 0 && cachej.length != 0){
+			shardj.lruList.erase(shardj.lruList.iterator_to(cachej));
+			shardj.cacheSize -= cachej.length;
+			shardi.lruList.push_front(cachei);
+			shardi.cacheSize += cachej.length;
+		}else{
+			shardi.cacheSize += cachej.length;
+			shardi.cacheSize -= cachei.length;
+			shardj.cacheSize += cachei.length;
+			shardj.cacheSize -= cachej.length;
+		}
+		std::swap(cachei.length,cachej.length);
+		std::swap(cachei.data,cachej.data);
+		//the exchanged lines might overflow the budget of their new shard
+		shrinkShard(shardi);
+		shrinkShard(shardj);
+	}
+
+	std::size_t size()const{
+		std::size_t totalSize = 0;
+		for(std::size_t s = 0; s != m_shards.size(); ++s){
+			totalSize += m_shards[s].cacheSize;
+		}
+		return totalSize;
+	}
+
+	std::size_t maxSize()const{
+		return m_shards[0].maxSize * m_shards.size();
+	}
+
+	///\brief empty cache
+	void clear(){
+		for(std::size_t s = 0; s != m_shards.size(); ++s){
+			Shard& shard = m_shards[s];
+			std::lock_guard<std::mutex> guard(shard.lock);
+			while(!shard.lruList.empty()){
+				cacheRemoveRow(shard,shard.lruList.back());
+			}
+		}
+	}
+private:
+	Shard& shardOf(std::size_t i){
+		return m_shards[i % m_shards.size()];
+	}
+
+	///\brief Creates a new row with a certain size > 0.
+	void cacheCreateRow(Shard& shard, CacheEntry& block,std::size_t size){
+		SIZE_CHECK(size > 0);
+		ensureFreeMemory(shard,size);
+		block.length = size;
+		block.data = new T[size];
+		shard.lruList.push_front(block);
+		shard.cacheSize += size;
+	}
+	/// \brief Removes a cached row.
+	void cacheRemoveRow(Shard& shard, CacheEntry& block){
+		shard.cacheSize -= block.length;
+		shard.lruList.erase( shard.lruList.iterator_to( block ) );
+		delete[] block.data;
+		block.length = 0;
+	}
+	/// \brief Resizes a line and copies all old values into it.
+	void resizeLine(Shard& shard, CacheEntry& block,std::size_t size){
+		//salvage block data
+		T* newLine  = new T[size];
+		std::copy(block.data,block.data+std::min(size,block.length),newLine);
+
+		//remove old data
+		cacheRemoveRow(shard,block);
+		//free space for the new block
+		ensureFreeMemory(shard,size);
+
+		//add new block
+		block.data = newLine;
+		block.length = size;
+		shard.cacheSize += size;
+		shard.lruList.push_front(block);
+	}
+
+	/// \brief Swap of two lines of the same shard, keeping the exact list positions.
+	void swapInShard(Shard& shard, CacheEntry& cachei, CacheEntry& cachej){
+		typedef typename boost::intrusive::list<CacheEntry>::iterator Iterator;
+		if(cachei.length != 0 && cachej.length == 0){
+			Iterator pos = shard.lruList.iterator_to( cachei );
+			shard.lruList.insert(pos,cachej);
+			shard.lruList.erase(pos);
+		}else if(cachei.length == 0 && cachej.length != 0){
+			Iterator pos = shard.lruList.iterator_to( cachej );
+			shard.lruList.insert(pos,cachei);
+			shard.lruList.erase(pos);
+		}else{
+			Iterator posi = shard.lruList.iterator_to( cachei );
+			Iterator posj = shard.lruList.iterator_to( cachej );
+			Iterator incposi = posi;++incposi;
+			Iterator incposj = posj;++incposj;
+			if(incposi == posj){
+				shard.lruList.erase( posj );
+				shard.lruList.insert(posi,cachej);
+			} else if(incposj == posi){
+				shard.lruList.erase( posi );
+				shard.lruList.insert(posj,cachei);
+			}
+			else{
+				shard.lruList.erase( shard.lruList.iterator_to( cachei ) );
+				shard.lruList.erase( shard.lruList.iterator_to( cachej ) );
+				shard.lruList.insert(incposi,cachej);
+				shard.lruList.insert(incposj,cachei);
+			}
+		}
+		std::swap(cachei.length,cachej.length);
+		std::swap(cachei.data,cachej.data);
+	}
+
+	///\brief Frees enough memory in the shard until a given amount of T can be allocated
+	///
+	/// A line bigger than the shard budget is still allowed after evicting all
+	/// other lines of the shard, mirroring the behaviour of the global cache
+	/// with respect to its total budget.
+	void ensureFreeMemory(Shard& shard, std::size_t size){
+		while(!shard.lruList.empty() && shard.cacheSize + size > shard.maxSize){
+			cacheRemoveRow(shard,shard.lruList.back());//remove the oldest row
+		}
+	}
+
+	///\brief Evicts lines until the shard is within its budget again.
+	void shrinkShard(Shard& shard){
+		while(shard.cacheSize > shard.maxSize){
+			cacheRemoveRow(shard,shard.lruList.back());
+		}
+	}
+
+	std::vector<CacheEntry> m_cacheEntry; ///< cache entry description
+	std::vector<Shard> m_shards; ///< independent lru lists with their locks
 };
 }
 #endif
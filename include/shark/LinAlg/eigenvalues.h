@@ -35,6 +35,7 @@
 
 #include <shark/LinAlg/Base.h>
 #include <shark/LinAlg/BLAS/kernels/syev.hpp>
+#include <shark/Rng/GlobalRng.h>
 
 namespace shark{ namespace blas{
 
@@ -90,7 +91,124 @@ void eigensymm
 	kernels::syev(eigenVectors,eigenValues);
 }
 
+namespace detail{
+/// \brief Orthonormalizes the columns of Q in place using modified Gram-Schmidt.
+template<class MatQ>
+void orthonormalizeColumns(matrix_expression<MatQ, cpu_tag>& Q){
+	for(std::size_t j = 0; j != Q().size2(); ++j){
+		auto qj = column(Q,j);
+		for(std::size_t i = 0; i != j; ++i){
+			auto qi = column(Q,i);
+			noalias(qj) -= inner_prod(qi,qj) * qi;
+		}
+		double norm = norm_2(qj);
+		if(norm > 0)
+			qj /= norm;
+	}
+}
+}
+
+/*!
+ *  \brief Computes the k largest eigenvalues and eigenvectors of a symmetric matrix
+ *  using randomized subspace iteration.
+ *
+ *  Instead of the full \f$ O(n^3) \f$ decomposition, the matrix is projected onto a random
+ *  subspace of dimension k plus a small oversampling, which is refined with a few power
+ *  iterations before a dense decomposition of the small projected matrix yields the
+ *  eigenpairs. This costs only a handful of matrix products of the form \f$ n \times (k+p) \f$
+ *  and is much faster than eigensymm when only a truncated decomposition is needed,
+ *  for example for PCA on high dimensional data. The approximation is accurate when the
+ *  spectrum decays reasonably fast; more power iterations improve accuracy for flat spectra.
+ *
+ * \param A \f$ n \times n \f$ matrix, which must be symmetric, so only the bottom triangular matrix must contain values.
+ * \param eigenVectors \f$ n \times k \f$ matrix with the approximated normalized eigenvectors, each column contains an eigenvector.
+ * \param eigenValues k-dimensional vector with the approximated eigenvalues in descending order.
+ * \param numEigenvalues number k of eigenpairs to compute, must be at most n.
+ * \param rng random number generator used to draw the subspace.
+ * \param oversample number of additional random directions stabilizing the subspace.
+ * \param powerIterations number of power iterations refining the subspace.
+ */
+template<class MatrixT,class MatrixU,class VectorT, class RngType>
+void eigensymmRand
+(
+	matrix_expression<MatrixT, cpu_tag> const& A,
+	matrix_expression<MatrixU, cpu_tag>& eigenVectors,
+	vector_expression<VectorT, cpu_tag>& eigenValues,
+	std::size_t numEigenvalues,
+	RngType& rng,
+	std::size_t oversample = 10,
+	std::size_t powerIterations = 2
+)
+{
+	SIZE_CHECK(A().size2() == A().size1());
+	SIZE_CHECK(numEigenvalues <= A().size1());
+	std::size_t n = A().size1();
+	std::size_t subspace = std::min(n, numEigenvalues + oversample);
+
+	//the full decomposition of the projected matrix is as cheap for tiny problems
+	if(subspace == n){
+		RealMatrix fullVectors;
+		RealVector fullValues;
+		eigensymm(A,fullVectors,fullValues);
+		eigenVectors().resize(n,numEigenvalues);
+		noalias(eigenVectors()) = columns(fullVectors,0,numEigenvalues);
+		eigenValues().resize(numEigenvalues);
+		noalias(eigenValues()) = subrange(fullValues,0,numEigenvalues);
+		return;
+	}
 
+	//only the bottom triangle of A is guaranteed to be valid, so create a full symmetric copy
+	RealMatrix M(n,n);
+	for (std::size_t i = 0; i != n; i++) {
+		for (std::size_t j = 0; j <= i; j++) {
+			M(i,j) = M(j,i) = A()(i, j);
+		}
+	}
+
+	//draw the random subspace and refine it with power iterations
+	Normal<RngType> normal(rng, 0, 1);
+	RealMatrix Q(n,subspace);
+	for(std::size_t i = 0; i != n; ++i){
+		for(std::size_t j = 0; j != subspace; ++j){
+			Q(i,j) = normal();
+		}
+	}
+	RealMatrix Y(n,subspace);
+	for(std::size_t iter = 0; iter != powerIterations + 1; ++iter){
+		noalias(Y) = prod(M,Q);
+		swap(Q,Y);
+		detail::orthonormalizeColumns(Q);
+	}
+
+	//decompose the small projected matrix B = Q^T M Q
+	RealMatrix MQ = prod(M,Q);
+	RealMatrix B = prod(trans(Q),MQ);
+	RealMatrix Bvectors;
+	RealVector Bvalues;
+	eigensymm(B,Bvectors,Bvalues);
+
+	//lift the eigenvectors back to the full space and truncate to the requested number
+	eigenVectors().resize(n,numEigenvalues);
+	noalias(eigenVectors()) = prod(Q,columns(Bvectors,0,numEigenvalues));
+	eigenValues().resize(numEigenvalues);
+	noalias(eigenValues()) = subrange(Bvalues,0,numEigenvalues);
+}
+
+/*!
+ *  \brief Computes the k largest eigenvalues and eigenvectors of a symmetric matrix
+ *  using randomized subspace iteration and the global random number generator.
+ */
+template<class MatrixT,class MatrixU,class VectorT>
+void eigensymmRand
+(
+	matrix_expression<MatrixT, cpu_tag> const& A,
+	matrix_expression<MatrixU, cpu_tag>& eigenVectors,
+	vector_expression<VectorT, cpu_tag>& eigenValues,
+	std::size_t numEigenvalues
+)
+{
+	eigensymmRand(A,eigenVectors,eigenValues,numEigenvalues,Rng::globalRng);
+}
 
 /** @}*/
 }}
@@ -228,32 +228,91 @@ void generalSolveSystemInPlace(
 /// If this is true, it is checked whether it is better than
 /// starting from 0 (i.e. the  max-norm of the initial residual is smaller than -b).
 /// 
-/// \param A the positive semi-definite n x n-Matrix
+/// \brief Identity preconditioner turning the preconditioned solvers into plain CG.
+struct NoPreconditioner{
+	template<class VecT, class VecT2>
+	void apply(VecT const& r, VecT2& z)const{
+		noalias(z) = r;
+	}
+};
+
+/// \brief Jacobi (diagonal) preconditioner for the iterative solvers.
+///
+/// Approximates \f$ A^{-1} \f$ by the inverse of the diagonal of A.
+/// This is cheap to set up and apply and effective whenever the
+/// diagonal varies strongly, e.g. for differently scaled variables.
+class JacobiPreconditioner{
+public:
+	/// \brief Creates the preconditioner from the diagonal of the matrix.
+	template<class MatT, class Device>
+	JacobiPreconditioner(matrix_expression<MatT, Device> const& A)
+	: m_invDiagonal(A().size1()){
+		SIZE_CHECK(A().size1() == A().size2());
+		for(std::size_t i = 0; i != m_invDiagonal.size(); ++i){
+			double a = A()(i,i);
+			m_invDiagonal(i) = (a > 0)? 1.0/a : 1.0;
+		}
+	}
+
+	/// \brief Creates the preconditioner from a precomputed matrix diagonal.
+	///
+	/// This allows preconditioning of matrix-free operators, for which
+	/// the diagonal is often available analytically.
+	JacobiPreconditioner(vector<double> const& diagonalA)
+	: m_invDiagonal(diagonalA.size()){
+		for(std::size_t i = 0; i != m_invDiagonal.size(); ++i){
+			m_invDiagonal(i) = (diagonalA(i) > 0)? 1.0/diagonalA(i) : 1.0;
+		}
+	}
+
+	template<class VecT, class VecT2>
+	void apply(VecT const& r, VecT2& z)const{
+		noalias(z) = m_invDiagonal * r;
+	}
+private:
+	vector<double> m_invDiagonal;
+};
+
+/// \brief Matrix-free preconditioned conjugate gradient solver for Ax=b.
+///
+/// The system matrix is only accessed through the supplied operator, a
+/// callable with signature operator()(x, result) computing result = Ax,
+/// so the matrix never needs to be materialized when products are cheap,
+/// e.g. for sparse or structured matrices. The operator must represent a
+/// symmetric positive definite matrix. The preconditioner must provide
+/// apply(r,z) computing \f$ z \approx A^{-1} r \f$, see
+/// JacobiPreconditioner and NoPreconditioner.
+///
+/// The iteration stops when the max-norm of the residual \f$ r_k = Ax_k-b \f$
+/// drops below epsilon or after maxIterations steps (0 means the system size).
+///
+/// \param A callable computing the matrix-vector product of the system matrix
+/// \param preconditioner preconditioner approximating the inverse of A
 /// \param x the solution vector
 /// \param b the right hand side
 /// \param epsilon stopping criterium for the residual
-/// \param maxIterations the maximum number of iterations
 /// \param initialSolution if this is true, x stores an initial guess of the solution
-template<class MatT, class VecT, class VecT2, class Device>
-void approxsolveSymmPosDefSystem(
-	matrix_expression<MatT, Device> const& A,
+/// \param maxIterations the maximum number of iterations
+template<class MatrixFreeOperator, class Preconditioner, class VecT, class VecT2, class Device>
+void approxsolveSymmPosDefSystemMatrixFree(
+	MatrixFreeOperator const& A,
+	Preconditioner const& preconditioner,
 	vector_expression<VecT, Device>& x,
 	vector_expression<VecT2, Device> const& b,
 	double epsilon = 1.e-10,
 	bool initialSolution = false,
 	unsigned int maxIterations = 0
 ){
-	SIZE_CHECK(A().size1()==A().size2());
-	SIZE_CHECK(A().size1()==b().size());
-	
 	std::size_t dim = b().size();
 	std::size_t maxIt = (maxIterations == 0)? dim: maxIterations;
-	
+
 	typedef typename VecT::value_type value_type;
 	vector<value_type> r = b;//current residual
 	if(initialSolution){
 		SIZE_CHECK(x().size() == dim);
-		noalias(r) -= prod(A,x);
+		vector<value_type> Ax(dim);
+		A(x(),Ax);
+		noalias(r) -= Ax;
 		if(norm_inf(r) > norm_inf(b)){
 			x().clear();
 			r = b;
@@ -263,25 +322,89 @@ void approxsolveSymmPosDefSystem(
 		ensure_size(x,dim);
 		x().clear();
 	}
-	
-	vector<value_type> rnext(dim); //the next residual
-	vector<value_type> p = r; //the search direction- initially it is the gradient direction
+	if(norm_inf(r) < epsilon)
+		return;
+
+	vector<value_type> z(dim); //preconditioned residual
+	preconditioner.apply(r,z);
+	vector<value_type> p = z; //the search direction
 	vector<value_type> Ap(dim); //stores prod(A,p)
-	
+	double rz = inner_prod(r,z);
+
 	for(std::size_t i = 0; i != maxIt; ++i){
-		noalias(Ap) = prod(A,p);
-		double rsqr=inner_prod(r,r);
-		double alpha = rsqr/inner_prod(p,Ap);
+		A(p,Ap);
+		double alpha = rz/inner_prod(p,Ap);
 		noalias(x())+=alpha*p;
-		noalias(rnext) = r - alpha * Ap; 
-		if(norm_inf(rnext)<epsilon)
+		noalias(r) -= alpha * Ap;
+		if(norm_inf(r)<epsilon)
 			break;
-		
-		double beta = inner_prod(rnext,rnext)/rsqr;
+
+		preconditioner.apply(r,z);
+		double rznext = inner_prod(r,z);
+		double beta = rznext/rz;
 		p*=beta;
-		noalias(p) +=rnext;
-		swap(r,rnext);
+		noalias(p) +=z;
+		rz = rznext;
+	}
+}
+
+namespace detail{
+//adapts a dense matrix expression to the operator interface of the matrix-free solver
+template<class MatT, class Device>
+struct DenseSystemOperator{
+	MatT const& A;
+	template<class VecT, class VecT2>
+	void operator()(VecT const& x, VecT2& result)const{
+		noalias(result) = prod(A,x);
 	}
+};
+}
+
+/// \brief Approximately solves a preconditioned system of linear equations Ax=b.
+///
+/// Preconditioned conjugate gradient method for a dense symmetric positive
+/// definite matrix, see the matrix-free variant for the stopping criteria
+/// and the preconditioner interface.
+///
+/// \param A the positive semi-definite n x n-Matrix
+/// \param preconditioner preconditioner approximating the inverse of A
+/// \param x the solution vector
+/// \param b the right hand side
+/// \param epsilon stopping criterium for the residual
+/// \param initialSolution if this is true, x stores an initial guess of the solution
+/// \param maxIterations the maximum number of iterations
+template<class MatT, class Preconditioner, class VecT, class VecT2, class Device>
+void approxsolveSymmPosDefSystem(
+	matrix_expression<MatT, Device> const& A,
+	Preconditioner const& preconditioner,
+	vector_expression<VecT, Device>& x,
+	vector_expression<VecT2, Device> const& b,
+	double epsilon = 1.e-10,
+	bool initialSolution = false,
+	unsigned int maxIterations = 0
+){
+	SIZE_CHECK(A().size1()==A().size2());
+	SIZE_CHECK(A().size1()==b().size());
+	detail::DenseSystemOperator<MatT, Device> op = {A()};
+	approxsolveSymmPosDefSystemMatrixFree(op,preconditioner,x,b,epsilon,initialSolution,maxIterations);
+}
+
+/// \param A the positive semi-definite n x n-Matrix
+/// \param x the solution vector
+/// \param b the right hand side
+/// \param epsilon stopping criterium for the residual
+/// \param maxIterations the maximum number of iterations
+/// \param initialSolution if this is true, x stores an initial guess of the solution
+template<class MatT, class VecT, class VecT2, class Device>
+void approxsolveSymmPosDefSystem(
+	matrix_expression<MatT, Device> const& A,
+	vector_expression<VecT, Device>& x,
+	vector_expression<VecT2, Device> const& b,
+	double epsilon = 1.e-10,
+	bool initialSolution = false,
+	unsigned int maxIterations = 0
+){
+	approxsolveSymmPosDefSystem(A,NoPreconditioner(),x,b,epsilon,initialSolution,maxIterations);
 }
 
 /// \brief Approximates the solution of a linear system of equation Ax=b, storing the solution in b.
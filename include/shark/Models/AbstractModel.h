@@ -201,6 +201,30 @@ public:
 		//return transform(patterns,*this);//todo this leads to compiler errors.
 	}
 
+	/// \brief Streaming model evaluation feeding every prediction batch into a sink.
+	///
+	/// Evaluates the model batch by batch and passes every prediction batch to
+	/// the sink together with its batch index, without materializing a Data
+	/// container of the outputs. This is the interface for pipelines which
+	/// reduce the predictions right away - a loss or a statistic - where
+	/// allocating a full copy of the outputs only to fold them into a few
+	/// numbers is wasted memory traffic. The batches are evaluated in
+	/// parallel; the sink is invoked inside a critical region and therefore
+	/// does not need to be thread safe.
+	///
+	/// \param patterns the input of the model
+	/// \param sink callable invoked as sink(batchIndex, predictionBatch) for every batch
+	template<class Sink>
+	void eval(Data<InputType> const& patterns, Sink& sink)const{
+		int batches = (int) patterns.numberOfBatches();
+		SHARK_PARALLEL_FOR(int i = 0; i < batches; ++i){
+			BatchOutputType predictions = (*this)(patterns.batch(i));
+			SHARK_CRITICAL_REGION{
+				sink(static_cast<std::size_t>(i), predictions);
+			}
+		}
+	}
+
 	/// \brief Model evaluation as an operator for a single pattern. This is a convenience function
 	///
 	/// \param pattern the input of the model
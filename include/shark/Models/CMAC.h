@@ -71,8 +71,8 @@ protected:
 
 	///calculates the index in the parameter vector for the activated feature in the tiling
 	SHARK_EXPORT_SYMBOL std::size_t getArrayIndexForTiling(std::size_t indexOfTiling,RealVector const& point)const;
-	///returns an index in the parameter array for each activated feature
-	SHARK_EXPORT_SYMBOL std::vector<std::size_t> getIndizes(blas::matrix_row<const RealMatrix> const& point)const;
+	///fills the supplied buffer with an index in the parameter array for each activated feature
+	SHARK_EXPORT_SYMBOL void getIndizes(blas::matrix_row<const RealMatrix> const& point, std::vector<std::size_t>& output)const;
 public:
 	///\brief construct the CMAC
 	SHARK_EXPORT_SYMBOL CMACMap();
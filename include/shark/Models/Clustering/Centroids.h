@@ -104,6 +104,7 @@ public:
 	/// overwrite the centroid vectors
 	void setCentroids(Data<RealVector> const& newCentroids){
 		m_centroids = newCentroids;
+		updateCentroidNormsSqr();
 	}
 
 	/// from ISerializable
@@ -112,14 +113,27 @@ public:
 	/// from ISerializable
 	SHARK_EXPORT_SYMBOL void write(OutArchive& archive) const;
 
+	using base_type::hardMembership;
+
+	/// From AbstractClustering: Compute best matching cluster for a batch of patterns.
+	/// Works directly on the squared distance matrix of the batch, thus it is cheaper
+	/// than taking the arg max of the soft membership function.
+	SHARK_EXPORT_SYMBOL BatchOutputType hardMembership(BatchInputType const& patterns) const;
+
 	/// from AbstractClustering: Compute cluster memberships.
 	SHARK_EXPORT_SYMBOL RealVector softMembership(RealVector const& pattern) const;
 	/// From AbstractClustering: Compute cluster memberships for a batch of patterns.
 	SHARK_EXPORT_SYMBOL RealMatrix softMembership(BatchInputType const& patterns) const;
-	
+
 	/// Computes the distances of each pattern to all cluster centers
 	SHARK_EXPORT_SYMBOL RealMatrix distances(BatchInputType const& patterns) const;
 
+	/// Computes the squared distances of each pattern to all cluster centers.
+	/// The distance matrix of a batch is computed through a single matrix-matrix
+	/// product using \f$ (x-c)^2 = x^2 - 2 \langle x,c \rangle + c^2 \f$, where
+	/// the squared centroid norms are cached between calls.
+	SHARK_EXPORT_SYMBOL RealMatrix distancesSqr(BatchInputType const& patterns) const;
+
 
 	/// initialize centroids from labeled data: take the first
 	/// data points with different labels; if there are more
@@ -143,8 +157,15 @@ protected:
 	/// The default implementation is to return exp(-distance)
 	SHARK_EXPORT_SYMBOL virtual double membershipKernel(double dist) const;
 
+	/// Recompute the cached squared centroid norms. Must be called
+	/// whenever the centroid vectors change.
+	SHARK_EXPORT_SYMBOL void updateCentroidNormsSqr();
+
 	/// centroid vectors
 	Data<RealVector> m_centroids;
+
+	/// squared norms of the centroid vectors, cached for the distance computation
+	RealVector m_centroidNormsSqr;
 };
 
 
@@ -92,6 +92,13 @@ protected:
 		BatchIntermediateType intermediateResult;
 		boost::shared_ptr<State> firstModelState;
 		boost::shared_ptr<State> secondModelState;
+
+		///scratch buffers reused by the derivative computations so that
+		///repeated backpropagation through the chain does not allocate
+		///new intermediate batches; they are not part of the state proper.
+		mutable BatchIntermediateType secondInputDerivative;
+		mutable RealVector firstParameterDerivative;
+		mutable RealVector secondParameterDerivative;
 	};
 public:
 	typedef typename base_type::BatchInputType BatchInputType;
@@ -184,26 +191,19 @@ public:
 		//don't compute the derivative of the first model if it does not have parameters.
 		std::size_t numParamsFirst = m_firstModel->numberOfParameters();
 		if(m_optimizeFirst && m_optimizeSecond && numParamsFirst != 0){
-			RealVector firstParameterDerivative;
-			BatchIntermediateType secondInputDerivative;
-			RealVector secondParameterDerivative;
-			
 			m_secondModel->weightedDerivatives(
 				s.intermediateResult,coefficients,*s.secondModelState,
-				secondParameterDerivative,secondInputDerivative
+				s.secondParameterDerivative,s.secondInputDerivative
 			);
-			m_firstModel->weightedParameterDerivative(patterns,secondInputDerivative,*s.firstModelState,firstParameterDerivative);
-			
+			m_firstModel->weightedParameterDerivative(patterns,s.secondInputDerivative,*s.firstModelState,s.firstParameterDerivative);
+
 			gradient.resize(numberOfParameters());
-			init(gradient)<<firstParameterDerivative,secondParameterDerivative;
+			init(gradient)<<s.firstParameterDerivative,s.secondParameterDerivative;
 		}else if(m_optimizeFirst && numParamsFirst != 0){
-			RealVector firstParameterDerivative;
-			BatchIntermediateType secondInputDerivative;
-			
 			m_secondModel->weightedInputDerivative(
-				s.intermediateResult,coefficients,*s.secondModelState,secondInputDerivative
+				s.intermediateResult,coefficients,*s.secondModelState,s.secondInputDerivative
 			);
-			m_firstModel->weightedParameterDerivative(patterns,secondInputDerivative,*s.firstModelState,gradient);
+			m_firstModel->weightedParameterDerivative(patterns,s.secondInputDerivative,*s.firstModelState,gradient);
 		}else if(m_optimizeSecond){
 			m_secondModel->weightedParameterDerivative(
 				s.intermediateResult,coefficients,*s.secondModelState,
@@ -218,9 +218,8 @@ public:
 		BatchInputType const& patterns, BatchOutputType const& coefficients, State const& state, BatchOutputType& gradient
 	)const{
 		InternalState const& s = state.toState<InternalState>();
-		BatchIntermediateType secondInputDerivative;
-		m_secondModel->weightedInputDerivative(s.intermediateResult, coefficients, *s.secondModelState, secondInputDerivative);
-		m_firstModel->weightedInputDerivative(patterns, secondInputDerivative, *s.firstModelState, gradient);
+		m_secondModel->weightedInputDerivative(s.intermediateResult, coefficients, *s.secondModelState, s.secondInputDerivative);
+		m_firstModel->weightedInputDerivative(patterns, s.secondInputDerivative, *s.firstModelState, gradient);
 	}
 	
 	//special implementation, because we can reuse the input derivative of the second model for the calculation of both derivatives of the first
@@ -232,34 +231,30 @@ public:
 		BatchInputType& inputDerivative
 	)const{
 		InternalState const& s = state.toState<InternalState>();
-		std::size_t firstParam=m_firstModel->numberOfParameters();
-		std::size_t secondParam=m_secondModel->numberOfParameters();
-		parameterDerivative.resize(firstParam+secondParam);
 
-		RealVector firstParameterDerivative;
-		BatchIntermediateType secondInputDerivative;
-		RealVector secondParameterDerivative;
 		if(m_optimizeSecond){
 			m_secondModel->weightedDerivatives(
-				s.intermediateResult, coefficients, *s.firstModelState, secondParameterDerivative, secondInputDerivative
+				s.intermediateResult, coefficients, *s.secondModelState, s.secondParameterDerivative, s.secondInputDerivative
 			);
 		}else{
 			m_secondModel->weightedInputDerivative(
-				s.intermediateResult, coefficients, *s.firstModelState, secondInputDerivative
+				s.intermediateResult, coefficients, *s.secondModelState, s.secondInputDerivative
 			);
+			s.secondParameterDerivative.resize(0);
 		}
-		if(m_optimizeFirst){
+		if(m_optimizeFirst && m_firstModel->numberOfParameters() != 0){
 			m_firstModel->weightedDerivatives(
-				patterns, secondInputDerivative, *s.secondModelState, parameterDerivative, inputDerivative
+				patterns, s.secondInputDerivative, *s.firstModelState, s.firstParameterDerivative, inputDerivative
 			);
 		}else{
 			m_firstModel->weightedInputDerivative(
-				patterns, secondInputDerivative, *s.secondModelState, inputDerivative
+				patterns, s.secondInputDerivative, *s.firstModelState, inputDerivative
 			);
+			s.firstParameterDerivative.resize(0);
 		}
 
-		parameterDerivative.resize(firstParam+secondParam);
-		init(parameterDerivative)<<firstParameterDerivative,secondParameterDerivative;
+		parameterDerivative.resize(s.firstParameterDerivative.size()+s.secondParameterDerivative.size());
+		init(parameterDerivative)<<s.firstParameterDerivative,s.secondParameterDerivative;
 	}
 	/// From ISerializable
 	void read( InArchive & archive ){
@@ -205,20 +205,30 @@ public:
 	}
 	
 	void eval(BatchInputType const& input, BatchOutputType& output)const{
-		
+
 		ModelBatchOutputType modelResult;
 		m_decisionFunction.eval(input,modelResult);
 		std::size_t batchSize = shark::size(modelResult);
 		output.resize(batchSize);
 		if(modelResult.size2()== 1)
 		{
-			for(std::size_t i = 0; i != batchSize; ++i){
-				output(i) = modelResult(i,0) > 0.0;
-			}
+			//one masked pass over the single decision column
+			noalias(output) = column(modelResult,0) > 0.0;
 		}
 		else{
+			//single row-major sweep over the decision values,
+			//without creating a row proxy per element
+			std::size_t numOutputs = modelResult.size2();
 			for(std::size_t i = 0; i != batchSize; ++i){
-				output(i) = static_cast<unsigned int>(arg_max(row(modelResult,i)));
+				double best = modelResult(i,0);
+				unsigned int bestIndex = 0;
+				for(std::size_t j = 1; j != numOutputs; ++j){
+					if(modelResult(i,j) > best){
+						best = modelResult(i,j);
+						bestIndex = static_cast<unsigned int>(j);
+					}
+				}
+				output(i) = bestIndex;
 			}
 		}
 	}
@@ -73,6 +73,12 @@ public:
 		m_features |= HAS_FIRST_INPUT_DERIVATIVE;
 	}
 
+	///copy constructor
+	ConvexCombination(ConvexCombination const& model):m_w(model.m_w){
+		m_features |= HAS_FIRST_PARAMETER_DERIVATIVE;
+		m_features |= HAS_FIRST_INPUT_DERIVATIVE;
+	}
+
 	/// \brief From INameable: return the class name.
 	std::string name() const
 	{ return "ConvexCombination"; }
@@ -89,6 +95,19 @@ public:
 		return *this;
 	}
 
+	///move constructor
+	ConvexCombination(ConvexCombination&& model):m_w(std::move(model.m_w)){
+		m_features |= HAS_FIRST_PARAMETER_DERIVATIVE;
+		m_features |= HAS_FIRST_INPUT_DERIVATIVE;
+	}
+
+	///move assignment
+	ConvexCombination& operator=(ConvexCombination&& model){
+		ConvexCombination tempModel(std::move(model));
+		swap(*this,tempModel);
+		return *this;
+	}
+
 	/// obtain the input dimension
 	std::size_t inputSize() const{
 		return m_w.size2();
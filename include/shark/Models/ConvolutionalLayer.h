@@ -0,0 +1,341 @@
+//===========================================================================
+/*!
+ *
+ * \brief       Convolutional layer for feed forward architectures.
+ *
+ *
+ *
+ * \author      O.Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_MODELS_CONVOLUTIONAL_LAYER_H
+#define SHARK_MODELS_CONVOLUTIONAL_LAYER_H
+
+#include <shark/Models/AbstractModel.h>
+#include <shark/Models/Neurons.h>
+#include <boost/serialization/vector.hpp>
+
+namespace shark{
+
+/// \brief Convolutional layer with weight sharing for image-like inputs.
+///
+/// The layer interprets every input vector as a stack of
+/// numChannels images of size imageHeight x imageWidth stored
+/// channel by channel in row-major order. It convolves the stack with
+/// numFilters filters of size numChannels x filterHeight x filterWidth
+/// ("valid" convolution without padding), adds an optional bias per filter
+/// and applies the activation function of the chosen neuron type. The
+/// output is the stack of the numFilters response images of size
+/// (imageHeight - filterHeight + 1) x (imageWidth - filterWidth + 1)
+/// in the same layout, so layers can be stacked and combined with pooling
+/// via the ConcatenatedModel.
+///
+/// The convolution is computed by lowering every image patch into the
+/// column of a matrix (the usual im2col scheme) and multiplying the filter
+/// matrix with it, so that the whole spatial sweep of all filters is a
+/// single matrix-matrix product and shares the fast product kernels with
+/// the rest of the library. The same lowering is reused for the parameter
+/// and input derivatives.
+template<class Neuron = LinearNeuron>
+class ConvolutionalLayer : public AbstractModel<RealVector,RealVector>
+{
+private:
+	struct InternalState: public State{
+		/// \brief The responses of the layer for the last batch, after activation.
+		RealMatrix responses;
+
+		void resize(std::size_t patterns, std::size_t outputs){
+			responses.resize(patterns,outputs);
+		}
+	};
+public:
+	/// \brief Creates an empty layer, use setStructure to define the topology.
+	ConvolutionalLayer()
+	: m_numChannels(0), m_imageHeight(0), m_imageWidth(0)
+	, m_numFilters(0), m_filterHeight(0), m_filterWidth(0){
+		m_features |= HAS_FIRST_PARAMETER_DERIVATIVE;
+		m_features |= HAS_FIRST_INPUT_DERIVATIVE;
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "ConvolutionalLayer"; }
+
+	/// \brief Sets the topology of the layer.
+	///
+	/// \param numChannels number of channels of the input image stack
+	/// \param imageHeight height of the input images
+	/// \param imageWidth width of the input images
+	/// \param numFilters number of filters, i.e. output channels
+	/// \param filterHeight height of the filters
+	/// \param filterWidth width of the filters
+	/// \param bias whether every filter has an additive bias term
+	void setStructure(
+		std::size_t numChannels, std::size_t imageHeight, std::size_t imageWidth,
+		std::size_t numFilters, std::size_t filterHeight, std::size_t filterWidth,
+		bool bias = true
+	){
+		SIZE_CHECK(filterHeight <= imageHeight);
+		SIZE_CHECK(filterWidth <= imageWidth);
+		m_numChannels = numChannels;
+		m_imageHeight = imageHeight;
+		m_imageWidth = imageWidth;
+		m_numFilters = numFilters;
+		m_filterHeight = filterHeight;
+		m_filterWidth = filterWidth;
+		m_filters.resize(numFilters, numChannels*filterHeight*filterWidth);
+		m_filters.clear();
+		m_bias.resize(bias? numFilters: 0);
+		m_bias.clear();
+	}
+
+	std::size_t inputSize()const{
+		return m_numChannels*m_imageHeight*m_imageWidth;
+	}
+	std::size_t outputSize()const{
+		return m_numFilters*outputHeight()*outputWidth();
+	}
+	/// \brief Height of the response images.
+	std::size_t outputHeight()const{
+		return m_imageHeight-m_filterHeight+1;
+	}
+	/// \brief Width of the response images.
+	std::size_t outputWidth()const{
+		return m_imageWidth-m_filterWidth+1;
+	}
+	std::size_t numFilters()const{
+		return m_numFilters;
+	}
+
+	/// \brief Returns the filter matrix; one filter per row.
+	RealMatrix const& filters()const{
+		return m_filters;
+	}
+	/// \brief Returns the bias values of the filters, empty when no bias is used.
+	RealVector const& bias()const{
+		return m_bias;
+	}
+
+	/// \brief Returns whether a bias term is used.
+	bool hasBias()const{
+		return m_bias.size() != 0;
+	}
+
+	RealVector parameterVector() const{
+		RealVector ret(numberOfParameters());
+		init(ret) << toVector(m_filters),m_bias;
+		return ret;
+	}
+
+	void setParameterVector(RealVector const& newParameters){
+		init(newParameters) >> toVector(m_filters),m_bias;
+	}
+
+	std::size_t numberOfParameters() const{
+		return m_filters.size1()*m_filters.size2()+m_bias.size();
+	}
+
+	boost::shared_ptr<State> createState()const{
+		return boost::shared_ptr<State>(new InternalState());
+	}
+
+	using AbstractModel<RealVector,RealVector>::eval;
+
+	void eval(RealMatrix const& patterns, RealMatrix& outputs)const{
+		InternalState state;
+		evalImpl(patterns,outputs,state);
+	}
+
+	void eval(RealMatrix const& patterns, RealMatrix& outputs, State& state)const{
+		evalImpl(patterns,outputs,state.toState<InternalState>());
+	}
+
+	///\brief Calculates the first derivative w.r.t the parameters and sums them up over all patterns of the last computed batch
+	void weightedParameterDerivative(
+		RealMatrix const& patterns, RealMatrix const& coefficients, State const& state, RealVector& gradient
+	)const{
+		SIZE_CHECK(coefficients.size2() == outputSize());
+		SIZE_CHECK(coefficients.size1() == patterns.size1());
+		InternalState const& s = state.toState<InternalState>();
+		std::size_t numPatterns = patterns.size1();
+		std::size_t outputPixels = outputHeight()*outputWidth();
+
+		//multiply the coefficients with the activation derivative
+		RealMatrix delta = coefficients;
+		noalias(delta) *= m_neuron.derivative(s.responses);
+		RealMatrix const& constDelta = delta;
+
+		gradient.resize(numberOfParameters());
+		gradient.clear();
+		std::size_t filterParams = m_filters.size1()*m_filters.size2();
+		auto filterGradient = to_matrix(subrange(gradient,0,filterParams),m_filters.size1(),m_filters.size2());
+
+		RealMatrix patches(m_filters.size2(),outputPixels);
+		for(std::size_t p = 0; p != numPatterns; ++p){
+			im2col(row(patterns,p),patches);
+			auto patternDelta = to_matrix(row(constDelta,p),m_numFilters,outputPixels);
+			noalias(filterGradient) += prod(patternDelta,trans(patches));
+		}
+		if(hasBias()){
+			auto biasGradient = subrange(gradient,filterParams,filterParams+m_numFilters);
+			for(std::size_t p = 0; p != numPatterns; ++p){
+				auto patternDelta = to_matrix(row(constDelta,p),m_numFilters,outputPixels);
+				noalias(biasGradient) += sum_columns(patternDelta);
+			}
+		}
+	}
+
+	///\brief Calculates the first derivative w.r.t the inputs and sums them up over all patterns of the last computed batch
+	void weightedInputDerivative(
+		RealMatrix const& patterns, RealMatrix const& coefficients, State const& state, RealMatrix& derivative
+	)const{
+		SIZE_CHECK(coefficients.size2() == outputSize());
+		SIZE_CHECK(coefficients.size1() == patterns.size1());
+		InternalState const& s = state.toState<InternalState>();
+		std::size_t numPatterns = patterns.size1();
+		std::size_t outputPixels = outputHeight()*outputWidth();
+
+		//multiply the coefficients with the activation derivative
+		RealMatrix delta = coefficients;
+		noalias(delta) *= m_neuron.derivative(s.responses);
+		RealMatrix const& constDelta = delta;
+
+		derivative.resize(numPatterns,inputSize());
+		derivative.clear();
+		RealMatrix patches(m_filters.size2(),outputPixels);
+		for(std::size_t p = 0; p != numPatterns; ++p){
+			auto patternDelta = to_matrix(row(constDelta,p),m_numFilters,outputPixels);
+			noalias(patches) = prod(trans(m_filters),patternDelta);
+			col2im(patches,row(derivative,p));
+		}
+	}
+
+	/// From ISerializable
+	void read(InArchive& archive){
+		archive >> m_numChannels;
+		archive >> m_imageHeight;
+		archive >> m_imageWidth;
+		archive >> m_numFilters;
+		archive >> m_filterHeight;
+		archive >> m_filterWidth;
+		archive >> m_filters;
+		archive >> m_bias;
+	}
+	/// From ISerializable
+	void write(OutArchive& archive) const{
+		archive << m_numChannels;
+		archive << m_imageHeight;
+		archive << m_imageWidth;
+		archive << m_numFilters;
+		archive << m_filterHeight;
+		archive << m_filterWidth;
+		archive << m_filters;
+		archive << m_bias;
+	}
+
+private:
+	void evalImpl(RealMatrix const& patterns, RealMatrix& outputs, InternalState& state)const{
+		SIZE_CHECK(patterns.size2() == inputSize());
+		std::size_t numPatterns = patterns.size1();
+		std::size_t outputPixels = outputHeight()*outputWidth();
+		outputs.resize(numPatterns,outputSize());
+		state.resize(numPatterns,outputSize());
+
+		RealMatrix patches(m_filters.size2(),outputPixels);
+		for(std::size_t p = 0; p != numPatterns; ++p){
+			im2col(row(patterns,p),patches);
+			auto response = to_matrix(row(outputs,p),m_numFilters,outputPixels);
+			noalias(response) = prod(m_filters,patches);
+			if(hasBias()){
+				noalias(response) += trans(repeat(m_bias,outputPixels));
+			}
+		}
+		noalias(state.responses) = m_neuron(outputs);
+		noalias(outputs) = state.responses;
+	}
+
+	/// \brief Lowers all filter-sized patches of the image into the columns of a matrix.
+	///
+	/// Column y*outputWidth+x of the result holds the patch whose upper left
+	/// corner is (y,x), flattened in the same channel-major layout as the
+	/// rows of the filter matrix.
+	template<class ImageVector>
+	void im2col(ImageVector const& image, RealMatrix& patches)const{
+		std::size_t outputRows = outputHeight();
+		std::size_t outputColumns = outputWidth();
+		for(std::size_t c = 0; c != m_numChannels; ++c){
+			std::size_t channelStart = c*m_imageHeight*m_imageWidth;
+			for(std::size_t i = 0; i != m_filterHeight; ++i){
+				for(std::size_t j = 0; j != m_filterWidth; ++j){
+					std::size_t patchRow = (c*m_filterHeight+i)*m_filterWidth+j;
+					for(std::size_t y = 0; y != outputRows; ++y){
+						std::size_t rowStart = channelStart+(y+i)*m_imageWidth+j;
+						for(std::size_t x = 0; x != outputColumns; ++x){
+							patches(patchRow,y*outputColumns+x) = image(rowStart+x);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/// \brief Transposed operation of im2col: accumulates the columns back into the image.
+	template<class ImageVector>
+	void col2im(RealMatrix const& patches, ImageVector&& image)const{
+		std::size_t outputRows = outputHeight();
+		std::size_t outputColumns = outputWidth();
+		for(std::size_t c = 0; c != m_numChannels; ++c){
+			std::size_t channelStart = c*m_imageHeight*m_imageWidth;
+			for(std::size_t i = 0; i != m_filterHeight; ++i){
+				for(std::size_t j = 0; j != m_filterWidth; ++j){
+					std::size_t patchRow = (c*m_filterHeight+i)*m_filterWidth+j;
+					for(std::size_t y = 0; y != outputRows; ++y){
+						std::size_t rowStart = channelStart+(y+i)*m_imageWidth+j;
+						for(std::size_t x = 0; x != outputColumns; ++x){
+							image(rowStart+x) += patches(patchRow,y*outputColumns+x);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	std::size_t m_numChannels;
+	std::size_t m_imageHeight;
+	std::size_t m_imageWidth;
+	std::size_t m_numFilters;
+	std::size_t m_filterHeight;
+	std::size_t m_filterWidth;
+
+	/// \brief The filter weights; one flattened filter per row.
+	RealMatrix m_filters;
+	/// \brief Bias term of every filter, empty when no bias is used.
+	RealVector m_bias;
+	/// \brief The activation function applied to the responses.
+	Neuron m_neuron;
+};
+
+}
+#endif
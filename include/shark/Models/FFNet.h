@@ -84,7 +84,14 @@ class FFNet :public AbstractModel<RealVector,RealVector>
 		//!                  i < M\f$</li>
 		//! </ul>
 		RealMatrix responses;
-		
+
+		//!  \brief Scratch space for the delta values of backpropagation.
+		//!
+		//!  The workspace is reused between batches so that the derivative
+		//!  computations do not allocate a new matrix for every batch. It is
+		//!  not part of the model state proper, hence mutable.
+		mutable RealMatrix delta;
+
 		void resize(std::size_t neurons, std::size_t patterns){
 			responses.resize(neurons,patterns);
 		}
@@ -359,17 +366,14 @@ public:
 	)const{
 		SIZE_CHECK(coefficients.size2() == m_outputNeurons);
 		SIZE_CHECK(coefficients.size1() == patterns.size1());
-		std::size_t numPatterns=patterns.size1();
-		
+
 		//initialize delta using coefficients and clear the rest. also don't compute the delta for
 		// the input neurons as they are not needed.
-		RealMatrix delta(numberOfNeurons(),numPatterns,0.0);
-		auto outputDelta = rows(delta,delta.size1()-outputSize(),delta.size1());
-		noalias(outputDelta) = trans(coefficients);
+		RealMatrix& delta = prepareDelta(state,coefficients);
 
 		computeDelta(delta,state,false);
 		computeParameterDerivative(delta,state,gradient);
-		
+
 	}
 	
 	void weightedInputDerivative(
@@ -378,12 +382,10 @@ public:
 		SIZE_CHECK(coefficients.size2() == m_outputNeurons);
 		SIZE_CHECK(coefficients.size1() == patterns.size1());
 		std::size_t numPatterns=patterns.size1();
-		
+
 		//initialize delta using coefficients and clear the rest
 		//we compute the full set of delta values here. the delta values of the inputs are the inputDerivative
-		RealMatrix delta(numberOfNeurons(),numPatterns,0.0);
-		auto outputDelta = rows(delta,delta.size1()-outputSize(),delta.size1());
-		noalias(outputDelta) = trans(coefficients);
+		RealMatrix& delta = prepareDelta(state,coefficients);
 
 		computeDelta(delta,state,true);
 		inputDerivative.resize(numPatterns,inputSize());
@@ -400,13 +402,11 @@ public:
 		SIZE_CHECK(coefficients.size2() == m_outputNeurons);
 		SIZE_CHECK(coefficients.size1() == patterns.size1());
 		std::size_t numPatterns = patterns.size1();
-		
-		
+
+
 		//compute full delta and thus the input derivative
-		RealMatrix delta(numberOfNeurons(),numPatterns,0.0);
-		auto outputDelta = rows(delta,delta.size1()-outputSize(),delta.size1());
-		noalias(outputDelta) = trans(coefficients);
-		
+		RealMatrix& delta = prepareDelta(state,coefficients);
+
 		computeDelta(delta,state,true);
 		inputDerivative.resize(numPatterns,inputSize());
 		noalias(inputDerivative) = trans(rows(delta,0,inputSize()));
@@ -592,7 +592,21 @@ public:
 
 
 private:
-	
+
+	//! Returns the delta workspace of the state, sized for the current batch,
+	//! with the output rows initialized from the coefficients and all other
+	//! rows cleared. Reusing the workspace avoids allocating a fresh matrix
+	//! for every batch as long as the batch size does not change.
+	RealMatrix& prepareDelta(State const& state, RealMatrix const& coefficients)const{
+		InternalState const& s = state.toState<InternalState>();
+		RealMatrix& delta = s.delta;
+		delta.resize(numberOfNeurons(),coefficients.size1());
+		delta.clear();
+		auto outputDelta = rows(delta,delta.size1()-outputSize(),delta.size1());
+		noalias(outputDelta) = trans(coefficients);
+		return delta;
+	}
+
 	void computeDelta(
 		RealMatrix& delta, State const& state, bool computeInputDelta
 	)const{
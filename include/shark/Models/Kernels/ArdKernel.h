@@ -54,8 +54,6 @@ namespace shark {
 /// Note that, like all or most models/kernels designed for unconstrained optimization, the
 /// argument to the constructor corresponds to the value of the true weights, while the set
 /// and get methods for the parameter vector set the parameterized values and not the true weights.
-///
-/// \todo slow default implementation. Use BLAS3 calls to make things faster
 template<class InputType=RealVector>
 class ARDKernelUnconstrained : public AbstractKernelFunction<InputType>
 {
@@ -155,13 +153,7 @@ public:
 		std::size_t sizeX2 = batchX2.size1();
 
 		ensure_size(result,sizeX1,sizeX2);
-		//todo: implement fast version of diagonalMahalanobisDistanceSqr for matrices
-		for(std::size_t i = 0; i != sizeX1; ++i){
-			for(std::size_t j = 0; j != sizeX2; ++j){
-				double dmnorm2 = diagonalMahalanobisDistanceSqr(row(batchX1,i), row(batchX2,j), m_gammas);
-				result(i,j)=std::exp(-dmnorm2);
-			}
-		}
+		evalBlock(batchX1,batchX2,result);
 	}
 
 	/// \brief evaluates \f$ k(x,z)\f$ for a whole batch
@@ -179,14 +171,8 @@ public:
 		s.resize(sizeX1,sizeX2);
 
 		ensure_size(result,sizeX1,sizeX2);
-		//todo: implement fast version of diagonalMahalanobisDistanceSqr for matrices
-		for(std::size_t i = 0; i != sizeX1; ++i){
-			for(std::size_t j = 0; j != sizeX2; ++j){
-				double dmnorm2 = diagonalMahalanobisDistanceSqr(row(batchX1,i), row(batchX2,j), m_gammas);
-				result(i,j) = std::exp(-dmnorm2);
-				s.kxy(i,j) = result(i,j);
-			}
-		}
+		evalBlock(batchX1,batchX2,result);
+		noalias(s.kxy) = result;
 	}
 
 	/// \brief evaluates \f$ \frac {\partial k(x,z)}{\partial \sqrt{\gamma_i}}\f$ weighted over a whole batch
@@ -209,16 +195,17 @@ public:
 		std::size_t sizeX2 = batchX2.size1();
 
 		ensure_size(gradient, m_inputDimensions );
-		gradient.clear();
 		InternalState const& s = state.toState<InternalState>();
 
-		for(std::size_t i = 0; i != sizeX1; ++i){
-			for(std::size_t j = 0; j != sizeX2; ++j){
-				double coeff = coefficients(i,j) * s.kxy(i,j);
-				gradient += coeff * m_params * sqr(row(batchX1,i)-row(batchX2,j));
-			}
-		}
-		gradient *= -2;
+		//expanding the squared difference decomposes the weighted sum over
+		//all pairs into weighted norms and one cross term, computed with a
+		//single matrix-matrix product over the stored kernel values
+		RealMatrix W = coefficients * s.kxy;
+		RealMatrix WX2 = prod(W,batchX2);
+		RealVector sumOfSquares = prod(trans(sqr(batchX1)),sum_columns(W));
+		noalias(sumOfSquares) += prod(trans(sqr(batchX2)),sum_rows(W));
+		noalias(sumOfSquares) -= 2.0 * sum_rows(batchX1 * WX2);
+		noalias(gradient) = -2.0 * m_params * sumOfSquares;
  	}
 
 	/// \brief evaluates \f$ \frac {\partial k(x,z)}{\partial x}\f$
@@ -240,15 +227,15 @@ public:
 
 		InternalState const& s = state.toState<InternalState>();
 		ensure_size(gradient, sizeX1, m_inputDimensions );
-		gradient.clear();
 
+		//as in the parameter derivative, the pairwise differences reduce to
+		//the coefficient row sums and one matrix-matrix product
+		RealMatrix W = coefficientsX2 * s.kxy;
+		RealMatrix WX2 = prod(W,batchX2);
+		RealVector rowSums = sum_columns(W);
 		for(std::size_t i = 0; i != sizeX1; ++i){
-			for(std::size_t j = 0; j != sizeX2; ++j){
-				double coeff = coefficientsX2(i,j) * s.kxy(i,j);
-				row(gradient,i) += coeff * m_gammas * (row(batchX1,i)-row(batchX2,j));
-			}
+			noalias(row(gradient,i)) = -2.0 * m_gammas * (rowSums(i) * row(batchX1,i) - row(WX2,i));
 		}
-		gradient *= -2.0;
 	}
 
 	void read(InArchive& ar){
@@ -264,6 +251,28 @@ public:
 	}
 
 protected:
+	/// \brief computes a whole block of kernel values into a correctly sized result matrix
+	///
+	/// The weighted squared distance is decomposed into the weighted norms
+	/// of the points and a cross term, so that the block is computed with
+	/// one matrix-matrix product of the weighted inputs instead of one pass
+	/// over the features for every pair of points.
+	void evalBlock(ConstBatchInputReference batchX1, ConstBatchInputReference batchX2, RealMatrix& result) const{
+		std::size_t sizeX1 = batchX1.size1();
+		std::size_t sizeX2 = batchX2.size1();
+
+		RealVector norms1 = prod(sqr(batchX1),m_gammas);
+		RealVector norms2 = prod(sqr(batchX2),m_gammas);
+		RealMatrix weightedX2 = batchX2 * repeat(m_gammas,sizeX2);
+		noalias(result) = prod(batchX1,trans(weightedX2));
+		for(std::size_t i = 0; i != sizeX1; ++i){
+			for(std::size_t j = 0; j != sizeX2; ++j){
+				//clamp against small negative distances caused by cancellation
+				result(i,j) = std::exp(std::min(0.0, 2 * result(i,j) - norms1(i) - norms2(j)));
+			}
+		}
+	}
+
 	RealVector m_gammas;				///< kernel bandwidth parameters, one for each input dimension. squares of m_params.
 	RealVector m_params;				///< parameters as seen by the external optimizer (for unconstrained optimization). can be negative.
 	std::size_t m_inputDimensions;		///< how many input dimensions = how many bandwidth parameters
@@ -41,10 +41,12 @@
 #ifndef SHARK_MODELS_KERNELEXPANSION_H
 #define SHARK_MODELS_KERNELEXPANSION_H
 
+#include <shark/Core/BinarySnapshot.h>
 #include <shark/Models/Converter.h>
 #include <shark/Models/Kernels/AbstractKernelFunction.h>
 #include <shark/Data/Dataset.h>
 #include <shark/Data/DataView.h>
+#include <shark/Core/OpenMP.h>
 
 namespace shark {
 
@@ -240,19 +242,31 @@ public:
 		else
 			output.clear();
 
-		std::size_t batchStart = 0;
-		for (std::size_t i=0; i != m_basis.numberOfBatches(); i++){
-			std::size_t batchEnd = batchStart+boost::size(m_basis.batch(i));
+		//get the start of every batch of the basis in the alpha matrix
+		//also include the past the end position at the end
+		std::size_t numBatches = m_basis.numberOfBatches();
+		std::vector<std::size_t> batchStart(numBatches+1,0);
+		for (std::size_t i = 1; i != numBatches+1; ++i){
+			batchStart[i] = batchStart[i-1]+boost::size(m_basis.batch(i-1));
+		}
+
+		//compute the patterns x basis kernel matrix tile by tile, one tile
+		//per batch of the basis, and reduce every tile to its contribution
+		//to the output immediately. The tiles are independent, so they are
+		//evaluated in parallel.
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)numBatches; i++){
 			//evaluate kernels
-			//results in a matrix of the form where a column consists of the kernel evaluation of 
+			//results in a matrix of the form where a column consists of the kernel evaluation of
 			//pattern i with respect to the batch of the basis,this gives a good memory alignment
 			//in the following matrix matrix product
 			RealMatrix kernelEvaluations = (*mep_kernel)(m_basis.batch(i),patterns);
-			
+
 			//get the part of the alpha matrix which is suitable for this batch
-			auto batchAlpha = subrange(m_alpha,batchStart,batchEnd,0,outputSize());
-			noalias(output) += prod(trans(kernelEvaluations),batchAlpha);
-			batchStart = batchEnd;
+			auto batchAlpha = subrange(m_alpha,batchStart[i],batchStart[i+1],0,outputSize());
+			RealMatrix tileOutput = prod(trans(kernelEvaluations),batchAlpha);
+			SHARK_CRITICAL_REGION{
+				noalias(output) += tileOutput;
+			}
 		}
 	}
 	void eval(BatchInputType const& patterns, BatchOutputType& outputs, State & state)const{
@@ -301,6 +315,57 @@ protected:
 	RealVector m_b;
 };
 
+/// \brief Saves a kernel expansion as a raw binary snapshot.
+///
+/// The snapshot stores the coefficient matrix, the offset, the basis and
+/// the parameters of the kernel with the dense storage written in bulk,
+/// which is considerably faster than the archive based write() for large
+/// expansions. The format is machine-local; use the boost archives when
+/// portability across machines matters.
+template<class InputType>
+void saveBinarySnapshot(KernelExpansion<InputType> const& model, std::ostream& out){
+	SHARK_ASSERT(model.kernel() != NULL);
+	detail::writeSnapshotHeader(out, detail::SnapshotContentKernelExpansion, 1);
+	writeBinary(out, model.alpha());
+	writeBinary(out, std::uint64_t(model.hasOffset()? 1: 0));
+	if(model.hasOffset())
+		writeBinary(out, model.offset());
+	writeBinary(out, model.basis());
+	writeBinary(out, model.kernel()->parameterVector());
+	if(!out)
+		throw SHARKEXCEPTION("[saveBinarySnapshot] error while writing the snapshot");
+}
+
+/// \brief Restores a kernel expansion from a raw binary snapshot.
+///
+/// As for the archive based read(), the kernel object must already be set;
+/// its parameters are restored from the snapshot. Everything else - basis,
+/// coefficients and offset - is rebuilt from the stored state.
+template<class InputType>
+void loadBinarySnapshot(KernelExpansion<InputType>& model, std::istream& in){
+	SHARK_ASSERT(model.kernel() != NULL);
+	detail::readSnapshotHeader(in, detail::SnapshotContentKernelExpansion);
+	RealMatrix alpha;
+	readBinary(in, alpha);
+	std::uint64_t offsetFlag = 0;
+	readBinary(in, offsetFlag);
+	RealVector b;
+	if(offsetFlag)
+		readBinary(in, b);
+	Data<InputType> basis;
+	readBinary(in, basis);
+	RealVector kernelParameters;
+	readBinary(in, kernelParameters);
+	if(kernelParameters.size() != model.kernel()->numberOfParameters())
+		throw SHARKEXCEPTION("[loadBinarySnapshot] snapshot stores a different number of kernel parameters");
+
+	model.setStructure(model.kernel(), basis, offsetFlag != 0, alpha.size2());
+	model.alpha() = alpha;
+	if(offsetFlag)
+		model.offset() = b;
+	model.kernel()->setParameterVector(kernelParameters);
+}
+
 ///
 /// \brief Linear classifier in a kernel feature space.
 ///
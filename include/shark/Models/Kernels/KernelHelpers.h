@@ -37,10 +37,83 @@
 #define SHARK_MODELS_KERNELS_KERNELHELPERS_H
 
 #include <shark/Models/Kernels/AbstractKernelFunction.h>
+#include <shark/Models/Kernels/GaussianRbfKernel.h>
 #include <shark/Data/Dataset.h>
 #include <shark/Core/OpenMP.h>
+#include <shark/Rng/GlobalRng.h>
+
+#include <boost/functional/hash.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <typeinfo>
 namespace shark{
-	
+
+namespace detail{
+
+///  \brief Gaussian fast path for the kernel gram matrix of dense data.
+///
+///  If the kernel turns out to be a Gaussian rbf kernel, the full matrix of
+///  pairwise squared distances is assembled as
+///  \f$ \|x_i-x_j\|^2 = \|x_i\|^2+\|x_j\|^2-2 x_i^T x_j \f$ using one big
+///  matrix-matrix product over the whole dataset followed by an elementwise
+///  exp, instead of evaluating the kernel batch by batch. Returns false when
+///  the kernel is not Gaussian, in which case nothing is written to matrix.
+template<class M>
+bool calculateGaussianKernelMatrixFastPath(
+	AbstractKernelFunction<RealVector> const& kernel,
+	Data<RealVector> const& dataset,
+	M& matrix
+){
+	GaussianRbfKernel<RealVector> const* rbf
+		= dynamic_cast<GaussianRbfKernel<RealVector> const*>(&kernel);
+	if(rbf == 0)
+		return false;
+
+	std::size_t n = dataset.numberOfElements();
+	std::size_t dim = dataDimension(dataset);
+	//gather the data into one dense block
+	RealMatrix X(n,dim);
+	std::size_t start = 0;
+	for(std::size_t b = 0; b != dataset.numberOfBatches(); ++b){
+		std::size_t batchSize = boost::size(dataset.batch(b));
+		noalias(rows(X,start,start+batchSize)) = dataset.batch(b);
+		start += batchSize;
+	}
+	RealVector norms(n);
+	for(std::size_t i = 0; i != n; ++i){
+		norms(i) = norm_sqr(row(X,i));
+	}
+	//compute the distances in row blocks so that the double precision
+	//temporary stays small when the target matrix has reduced precision
+	double gamma = rbf->gamma();
+	std::size_t blockSize = 256;
+	RealMatrix distances(std::min(blockSize,n),n);
+	for(start = 0; start < n; start += blockSize){
+		std::size_t numRows = std::min(blockSize, n - start);
+		auto block = subrange(distances,0,numRows,0,n);
+		noalias(block) = -2*prod(rows(X,start,start+numRows),trans(X));
+		for(std::size_t i = 0; i != numRows; ++i){
+			noalias(row(block,i)) += blas::repeat(norms(start+i),n) + norms;
+		}
+		noalias(rows(matrix,start,start+numRows)) = exp(-gamma*block);
+	}
+	return true;
+}
+
+///  \brief Fallback overload: no fast path for non-dense input types.
+template<class InputType, class M>
+bool calculateGaussianKernelMatrixFastPath(
+	AbstractKernelFunction<InputType> const&,
+	Data<InputType> const&,
+	M&
+){
+	return false;
+}
+
+}
+
 ///  \brief Calculates the regularized kernel gram matrix of the points stored inside a dataset.
 ///
 ///  Regularization is applied by adding the regularizer on the diagonal
@@ -66,8 +139,15 @@ void calculateRegularizedKernelMatrix(
 	SIZE_CHECK(batchStart[B] == dataset.numberOfElements());
 	std::size_t N  = batchStart[B];//number of elements
 	ensure_size(matrix,N,N);
-	
-	
+
+	//use a single big matrix-matrix product if the kernel allows it
+	if(detail::calculateGaussianKernelMatrixFastPath(kernel,dataset,matrix())){
+		for(std::size_t k = 0; k != N; ++k){
+			matrix()(k,k) += static_cast<typename M::value_type>(regularizer);
+		}
+		return;
+	}
+
 	for (std::size_t i=0; i<B; i++){
 		std::size_t startX = batchStart[i];
 		std::size_t endX = batchStart[i+1];
@@ -184,19 +264,33 @@ RealVector calculateKernelMatrixParameterDerivative(
 		WeightMatrix const& weights
 ){
 	std::size_t kp = kernel.numberOfParameters();
-	RealMatrix block;//stores the kernel results of the block which we need to compute to get the State :(
 	RealVector kernelGradient(kp);//weighted gradient summed over the whole kernel matrix
 	kernelGradient.clear();
-	
-	//calculate the gradint blockwise taking symmetry into account.
-	RealVector blockGradient(kp);//weighted gradient summed over the whole block
-	boost::shared_ptr<State> state = kernel.createState();
-	std::size_t startX = 0;
-	for (std::size_t i=0; i<dataset.numberOfBatches(); i++){
-		std::size_t sizeX=shark::size(dataset.batch(i));
-		std::size_t startY = 0;//start of the current batch in y-direction
-		for (std::size_t j=0; j <= i; j++){
-			std::size_t sizeY=shark::size(dataset.batch(j));
+
+	//precompute the start of every batch in the concatenated dataset
+	std::size_t numBatches = dataset.numberOfBatches();
+	std::vector<std::size_t> batchStart(numBatches+1,0);
+	for (std::size_t i=0; i<numBatches; i++){
+		batchStart[i+1] = batchStart[i]+shark::size(dataset.batch(i));
+	}
+
+	//calculate the gradient blockwise taking symmetry into account.
+	//the tiles of different rows are independent, so the rows are computed in
+	//parallel with one gradient accumulator per row; row i holds i+1 tiles,
+	//hence the dynamic schedule. each row is summed serially and the rows are
+	//combined in fixed tree order, making the gradient bit-reproducible
+	//independent of the number of threads
+	std::vector<RealVector> rowGradients(numBatches,RealVector(kp,0.0));
+	SHARK_PARALLEL_FOR_DYNAMIC (int i=0; i<(int)numBatches; i++){
+		RealVector& gradient = rowGradients[i];
+		RealMatrix block;//stores the kernel results of the block which we need to compute to get the State :(
+		RealVector blockGradient(kp);//weighted gradient summed over the whole block
+		boost::shared_ptr<State> state = kernel.createState();
+		std::size_t startX = batchStart[i];
+		std::size_t sizeX = batchStart[i+1]-startX;
+		for (std::size_t j=0; j <= (std::size_t)i; j++){
+			std::size_t startY = batchStart[j];//start of the current batch in y-direction
+			std::size_t sizeY = batchStart[j+1]-startY;
 			kernel.eval(dataset.batch(i), dataset.batch(j),block,*state);
 			kernel.weightedParameterDerivative(
 				dataset.batch(i), dataset.batch(j),//points
@@ -204,16 +298,161 @@ RealVector calculateKernelMatrixParameterDerivative(
 				*state,
 				blockGradient
 			);
-			if(i != j)
-				kernelGradient+=2*blockGradient;//Symmetry!
+			if((std::size_t)i != j)
+				gradient+=2*blockGradient;//Symmetry!
 			else
-				kernelGradient+=blockGradient;//middle blocks are symmetric
-			startY+= sizeY;
+				gradient+=blockGradient;//middle blocks are symmetric
+		}
+	}
+	noalias(kernelGradient) = deterministicSum(rowGradients);
+	return kernelGradient;
+}
+
+/// \brief Unbiased sampled estimate of the weighted derivative of a Kernel Gram Matrix.
+///
+/// Estimates the same quantity as calculateKernelMatrixParameterDerivative, but
+/// evaluates only a sampled subset of the batch tiles of the weight matrix instead
+/// of all of them. The tiles are drawn with replacement, with probability
+/// proportional to their absolute weight mass, and every drawn contribution is
+/// divided by its sampling probability - the estimate is therefore unbiased by
+/// importance sampling no matter how small the fraction is. A fraction of 0.01
+/// touches about one percent of the tiles and is usually enough to drive the
+/// early iterations of kernel parameter tuning, where the exact \f$ O(\ell^2) \f$
+/// aggregation dominates the runtime.
+///
+/// Note that the estimate is random: two calls with the same arguments return
+/// different values. The drawn tiles are evaluated in parallel; the draws
+/// themselves use the global Rng and happen before the parallel region.
+///  \param kernel the kernel for which to calculate the kernel gram matrix
+///  \param dataset the set of points used in the gram matrix
+///  \param weights the weights of the derivative, they must be symmetric!
+///  \param fraction the fraction of tiles to draw, in (0,1]
+///  \return the sampled estimate of the weighted derivative w.r.t the parameters.
+template<class InputType,class WeightMatrix>
+RealVector calculateKernelMatrixParameterDerivativeSampled(
+		AbstractKernelFunction<InputType> const& kernel,
+		Data<InputType> const& dataset,
+		WeightMatrix const& weights,
+		double fraction
+){
+	SHARK_CHECK(fraction > 0 && fraction <= 1, "fraction must be in (0,1]");
+	std::size_t kp = kernel.numberOfParameters();
+	RealVector kernelGradient(kp,0.0);
+
+	//precompute the start of every batch in the concatenated dataset
+	std::size_t numBatches = dataset.numberOfBatches();
+	std::vector<std::size_t> batchStart(numBatches+1,0);
+	for (std::size_t i=0; i<numBatches; i++){
+		batchStart[i+1] = batchStart[i]+shark::size(dataset.batch(i));
+	}
+
+	//enumerate the tiles of the lower triangle together with their importance,
+	//the absolute weight mass the tile contributes to the exact sum. tiles
+	//without mass contribute nothing and are never drawn
+	struct Tile{
+		std::size_t i;
+		std::size_t j;
+		double mass;
+		std::size_t draws;
+	};
+	std::vector<Tile> tiles;
+	std::vector<double> cumulativeMass;
+	double totalMass = 0;
+	for (std::size_t i=0; i<numBatches; i++){
+		for (std::size_t j=0; j <= i; j++){
+			double mass = sum(abs(subrange(
+				weights,
+				batchStart[i],batchStart[i+1],
+				batchStart[j],batchStart[j+1]
+			)));
+			if(i != j)
+				mass *= 2;//Symmetry!
+			if(mass == 0)
+				continue;
+			Tile tile = {i,j,mass,0};
+			tiles.push_back(tile);
+			totalMass += mass;
+			cumulativeMass.push_back(totalMass);
 		}
-		startX+=sizeX;
 	}
+	if(tiles.empty())
+		return kernelGradient;
+
+	//draw the tiles with replacement; the fraction counts against the full
+	//triangle, so sparse weights lead to even fewer kernel evaluations.
+	//the global rng is not thread safe, thus all draws happen up front
+	std::size_t numTiles = numBatches*(numBatches+1)/2;
+	std::size_t numDraws = std::max<std::size_t>(1,(std::size_t)(fraction*numTiles+0.5));
+	for(std::size_t d = 0; d != numDraws; ++d){
+		double u = Rng::uni(0,totalMass);
+		std::size_t t = std::lower_bound(cumulativeMass.begin(),cumulativeMass.end(),u)-cumulativeMass.begin();
+		t = std::min(t,tiles.size()-1);
+		++tiles[t].draws;
+	}
+	std::vector<std::size_t> drawn;
+	for(std::size_t t = 0; t != tiles.size(); ++t){
+		if(tiles[t].draws)
+			drawn.push_back(t);
+	}
+
+	//evaluate every drawn tile in parallel. dividing a contribution by its
+	//expected number of draws numDraws*mass/totalMass makes the estimator
+	//unbiased; tiles drawn several times are computed once and reweighted
+	std::vector<RealVector> tileGradients(drawn.size(),RealVector(kp,0.0));
+	SHARK_PARALLEL_FOR_DYNAMIC (int s=0; s<(int)drawn.size(); s++){
+		Tile const& tile = tiles[drawn[s]];
+		RealMatrix block;//stores the kernel results of the block which we need to compute to get the State :(
+		RealVector blockGradient(kp);//weighted gradient summed over the whole block
+		boost::shared_ptr<State> state = kernel.createState();
+		kernel.eval(dataset.batch(tile.i), dataset.batch(tile.j),block,*state);
+		kernel.weightedParameterDerivative(
+			dataset.batch(tile.i), dataset.batch(tile.j),//points
+			subrange(
+				weights,
+				batchStart[tile.i],batchStart[tile.i+1],
+				batchStart[tile.j],batchStart[tile.j+1]
+			),//weights
+			*state,
+			blockGradient
+		);
+		double scale = tile.draws*totalMass/(numDraws*tile.mass);
+		if(tile.i != tile.j)
+			scale *= 2;//Symmetry!
+		noalias(tileGradients[s]) = scale*blockGradient;
+	}
+	noalias(kernelGradient) = deterministicSum(tileGradients);
 	return kernelGradient;
 }
 
+/// \brief Builds the fingerprint under which kernel rows of a dataset are shared.
+///
+/// The key combines the kernel type and its parameter vector with the shape and
+/// the contents of the dataset. Trainer instances over the same data and kernel
+/// configuration therefore agree on the key and attach to the same rows of the
+/// KernelRowStore via CachedMatrix::attachRowStore, while a changed kernel
+/// parameter - for example the bandwidth during a grid search - maps to
+/// disjoint entries of the store.
+///  \param kernel the kernel whose rows are to be shared
+///  \param dataset the set of points defining the kernel matrix
+///  \return the fingerprint string
+template<class InputType>
+std::string kernelRowStoreKey(
+	AbstractKernelFunction<InputType> const& kernel,
+	Data<InputType> const& dataset
+){
+	std::size_t fingerprint = 0;
+	RealVector parameters = kernel.parameterVector();
+	for(std::size_t i = 0; i != parameters.size(); ++i){
+		boost::hash_combine(fingerprint,parameters(i));
+	}
+	for(std::size_t i = 0; i != dataset.numberOfElements(); ++i){
+		typename Data<InputType>::const_element_reference element = dataset.element(i);
+		boost::hash_range(fingerprint,element.begin(),element.end());
+	}
+	std::ostringstream key;
+	key << typeid(kernel).name() << '/' << dataset.numberOfElements() << '/' << fingerprint;
+	return key.str();
+}
+
 }
 #endif
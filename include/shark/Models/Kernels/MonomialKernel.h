@@ -109,7 +109,7 @@ public:
 		result.resize(sizeX1,sizeX2);
 		noalias(result) = prod(batchX1,trans(batchX2));
 		if(m_exponent != 1)
-			noalias(result) = pow(result,m_exponent);
+			exponentiate(result,result);
 	}
 	
 	void eval(ConstBatchInputReference batchX1, ConstBatchInputReference batchX2, RealMatrix& result, State& state) const{
@@ -126,7 +126,7 @@ public:
 		noalias(s.base) = prod(batchX1,trans(batchX2));
 		//now do exponentiation
 		if(m_exponent != 1)
-			noalias(result) = pow(s.base,m_exponent);
+			exponentiate(s.base,result);
 		else
 			noalias(result) = s.base;
 		//store also in state
@@ -186,6 +186,37 @@ public:
 
 protected:
 	///the exponent of the monomials
+	///raises every element of base to m_exponent using multiply chains for
+	///the common small exponents and squaring for the rest, avoiding the
+	///scalar pow per entry; base and result may alias each other
+	void exponentiate(RealMatrix const& base, RealMatrix& result)const{
+		if(m_exponent == 2){
+			noalias(result) = base * base;
+			return;
+		}
+		if(m_exponent == 3){
+			noalias(result) = base * base * base;
+			return;
+		}
+		RealMatrix factor = base;
+		unsigned int n = m_exponent;
+		//the lowest set bit initializes the result, every further one
+		//multiplies the repeatedly squared factor into it
+		bool haveResult = false;
+		while(true){
+			if(n & 1){
+				if(haveResult)
+					result = result * factor;
+				else
+					result = factor;
+				haveResult = true;
+			}
+			n >>= 1;
+			if(n == 0) break;
+			factor = factor * factor;
+		}
+	}
+
 	int m_exponent;
 };
 
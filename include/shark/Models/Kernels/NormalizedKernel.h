@@ -38,6 +38,8 @@
 
 #include <shark/Models/Kernels/AbstractKernelFunction.h>
 
+#include <boost/utility/enable_if.hpp>
+#include <list>
 namespace shark {
 
 
@@ -84,10 +86,13 @@ public:
 	NormalizedKernel(AbstractKernelFunction<InputType>* base) : m_base(base){
 		SHARK_ASSERT( base != NULL );
 		this->m_features|=base_type::IS_NORMALIZED;
-		if ( m_base->hasFirstParameterDerivative() ) 
+		if ( m_base->hasFirstParameterDerivative() )
 			this->m_features|=base_type::HAS_FIRST_PARAMETER_DERIVATIVE;
-		if ( m_base->hasFirstInputDerivative() ) 
+		if ( m_base->hasFirstInputDerivative() )
 			this->m_features|=base_type::HAS_FIRST_INPUT_DERIVATIVE;
+		m_cacheBudget = 0;
+		m_cacheUsed = 0;
+		m_cacheClock = 0;
 	}
 
 	/// \brief From INameable: return the class name.
@@ -100,11 +105,39 @@ public:
 
 	void setParameterVector(RealVector const& newParameters){
 		m_base->setParameterVector(newParameters);
+		clearCache();
 	}
 
 	std::size_t numberOfParameters() const{
 		return m_base->numberOfParameters();
 	}
+
+	/// \brief Number of diagonal kernel values the cache may hold.
+	std::size_t cacheSize() const{
+		return m_cacheBudget;
+	}
+
+	/// \brief Sets the budget of the diagonal cache, measured in kernel values.
+	///
+	/// Every pair evaluation of the normalized kernel needs the self-kernel
+	/// values \f$ k(x_i,x_i) \f$ of its arguments. These only depend on the
+	/// base kernel parameters, so for dense inputs the batch evaluation can
+	/// remember the diagonal of each batch it has seen, identified by the
+	/// batch storage, and skip the per-element evaluations on the next visit.
+	/// The least recently used diagonals are dropped when the budget is
+	/// exceeded; changing the parameters discards all entries. A budget of 0
+	/// turns caching off.
+	void setCacheSize(std::size_t numValues){
+		m_cacheBudget = numValues;
+		clearCache();
+	}
+
+	/// \brief Drops all cached diagonal kernel values.
+	void clearCache() const{
+		m_cache.clear();
+		m_cacheUsed = 0;
+		m_cacheClock = 0;
+	}
 	
 	///\brief creates the internal state of the kernel
 	boost::shared_ptr<State> createState()const{
@@ -169,20 +202,14 @@ public:
 	/// calculates
 	/// \f[ \tilde k(x, y) := \frac{k(x, y)}{\sqrt{k(x, x) \cdot k(y, y)}} \f]
 	void eval(ConstBatchInputReference const& batchX1, ConstBatchInputReference const& batchX2, RealMatrix& result) const{
-		std::size_t sizeX1 = size(batchX1);
-		std::size_t sizeX2 = size(batchX2);
-
 		m_base->eval(batchX1, batchX2,result);
-		
-		RealVector sqrtKyy(sizeX2);
-		for(std::size_t j = 0; j != sizeX2;++j){
-			sqrtKyy(j) = std::sqrt(m_base->eval(get(batchX2,j),get(batchX2,j)));
-		}
-		
-		for(std::size_t i = 0; i != sizeX1;++i){
-			double sqrtKxx = std::sqrt(m_base->eval(get(batchX2,i),get(batchX2,i)));
-			noalias(row(result,i)) = sqrtKxx* row(result,i) / sqrtKyy;
-		}
+
+		RealVector kxx;
+		RealVector kyy;
+		diagonal(batchX1,kxx);
+		diagonal(batchX2,kyy);
+
+		noalias(result) = result / outer_prod(sqrt(kxx),sqrt(kyy));
 	}
 
 	/// calculates the weighted derivate w.r.t. the parameters \f$ w \f$
@@ -269,8 +296,84 @@ public:
 	}
 
 protected:
+	/// cached diagonal of one batch, identified by its storage
+	struct DiagonalCacheEntry{
+		void const* data;///< address of the first batch element
+		std::size_t size;///< number of elements in the batch
+		std::size_t lastUsed;///< clock value of the last access
+		RealVector diag;///< self-kernel values of the batch elements
+	};
+
+	/// \brief fills diag with the self-kernel values \f$ k(x_i,x_i) \f$ of the batch
+	void diagonal(ConstBatchInputReference batch, RealVector& diag) const{
+		if(m_cacheBudget > 0 && cachedDiagonal<BatchInputType>(batch,diag))
+			return;
+		computeDiagonal(batch,diag);
+	}
+
+	/// \brief evaluates the self-kernel values of the batch element by element
+	void computeDiagonal(ConstBatchInputReference batch, RealVector& diag) const{
+		std::size_t elements = size(batch);
+		diag.resize(elements);
+		for(std::size_t i = 0; i != elements;++i){
+			diag(i) = m_base->eval(get(batch,i),get(batch,i));
+		}
+	}
+
+	/// \brief serves the diagonal of a dense batch from the cache, computing and storing it on a miss
+	///
+	/// Batches are identified by the address and size of their storage, so the
+	/// cache only pays off while the same batches are evaluated repeatedly, as
+	/// during training on a fixed dataset.
+	template<class T>
+	typename boost::enable_if<boost::is_same<T,RealMatrix>, bool>::type
+	cachedDiagonal(ConstBatchInputReference batch, RealVector& diag) const{
+		std::size_t elements = size(batch);
+		void const* data = &batch(0,0);
+		for(typename std::list<DiagonalCacheEntry>::iterator pos = m_cache.begin(); pos != m_cache.end(); ++pos){
+			if(pos->data == data && pos->size == elements){
+				pos->lastUsed = ++m_cacheClock;
+				diag = pos->diag;
+				return true;
+			}
+		}
+		if(elements > m_cacheBudget)
+			return false;//batch does not fit into the cache at all
+		//evict least recently used entries until the new diagonal fits
+		while(m_cacheUsed + elements > m_cacheBudget){
+			typename std::list<DiagonalCacheEntry>::iterator oldest = m_cache.begin();
+			for(typename std::list<DiagonalCacheEntry>::iterator pos = m_cache.begin(); pos != m_cache.end(); ++pos){
+				if(pos->lastUsed < oldest->lastUsed)
+					oldest = pos;
+			}
+			m_cacheUsed -= oldest->size;
+			m_cache.erase(oldest);
+		}
+		DiagonalCacheEntry entry;
+		entry.data = data;
+		entry.size = elements;
+		entry.lastUsed = ++m_cacheClock;
+		computeDiagonal(batch,entry.diag);
+		diag = entry.diag;
+		m_cache.push_back(entry);
+		m_cacheUsed += elements;
+		return true;
+	}
+
+	/// \brief fallback for sparse batches, which have no unique storage address
+	template<class T>
+	typename boost::disable_if<boost::is_same<T,RealMatrix>, bool>::type
+	cachedDiagonal(ConstBatchInputReference batch, RealVector& diag) const{
+		return false;
+	}
+
 	/// kernel to normalize
 	AbstractKernelFunction<InputType>* m_base;
+
+	std::size_t m_cacheBudget;///< maximum number of cached diagonal values, 0 disables the cache
+	mutable std::size_t m_cacheUsed;///< number of diagonal values currently cached
+	mutable std::size_t m_cacheClock;///< counter providing the least recently used order
+	mutable std::list<DiagonalCacheEntry> m_cache;///< cached diagonals in insertion order
 };
 
 typedef NormalizedKernel<> DenseNormalizedKernel;
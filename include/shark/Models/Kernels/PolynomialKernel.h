@@ -174,7 +174,7 @@ public:
 		result += m_offset;
 		//now do exponentiation
 		if(m_degree != 1)
-			noalias(result) = pow(result,m_degree);
+			integerPower(result,m_degree,result);
 	}
 	
 	void eval(ConstBatchInputReference batchX1, ConstBatchInputReference batchX2, RealMatrix& result, State& state) const{
@@ -193,7 +193,7 @@ public:
 		
 		//now do exponentiation
 		if(m_degree != 1)
-			noalias(result) = pow(s.base,m_degree);
+			integerPower(s.base,m_degree,result);
 		else
 			noalias(result) = s.base;
 		noalias(s.exponentedProd) = result;
@@ -293,6 +293,44 @@ public:
 	}
 
 protected:
+	/// \brief raises the elements of base to an integer power
+	///
+	/// Small degrees are expanded into explicit multiply chains and larger
+	/// ones are handled by repeated squaring, so a Gram tile needs at most
+	/// a logarithmic number of vectorized elementwise passes instead of one
+	/// scalar pow per entry. base and result may be the same matrix.
+	static void integerPower(RealMatrix const& base, int degree, RealMatrix& result){
+		switch(degree){
+		case 1:
+			noalias(result) = base;
+			break;
+		case 2:
+			noalias(result) = base * base;
+			break;
+		case 3:
+			noalias(result) = base * base * base;
+			break;
+		default:{
+			//exponentiation by squaring
+			RealMatrix power = base;
+			unsigned int remaining = degree;
+			bool initialized = false;
+			while(remaining != 0){
+				if(remaining & 1){
+					if(initialized)
+						result = result * power;
+					else
+						result = power;
+					initialized = true;
+				}
+				remaining >>= 1;
+				if(remaining != 0)
+					power = power * power;
+			}
+			break;
+		}}
+	}
+
 	int m_degree;                ///< exponent n
 	double m_offset;                      ///< offset b
 	bool m_degreeIsParam;                 ///< is the degree a model parameter?
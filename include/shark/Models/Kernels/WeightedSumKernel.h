@@ -39,6 +39,7 @@
 #include <shark/Models/Kernels/AbstractKernelFunction.h>
 
 #include <boost/utility/enable_if.hpp>
+#include <list>
 namespace shark {
 
 
@@ -90,6 +91,9 @@ public:
 
 		m_base.resize( base.size() );
 		m_numParameters = m_base.size()-1;
+		m_cacheBudget = 0;
+		m_cacheUsed = 0;
+		m_cacheClock = 0;
 
 		for (std::size_t i=0; i != m_base.size() ; i++) {
 			SHARK_ASSERT( base[i] != NULL );
@@ -148,6 +152,29 @@ public:
 		return m_base[index].weight;
 	}
 
+	/// Get the maximum number of sub-kernel values cached during batch evaluation.
+	std::size_t cacheSize() const{
+		return m_cacheBudget;
+	}
+	/// \brief Set the maximum number of sub-kernel values cached during batch evaluation.
+	///
+	/// The sub-kernel results of a batch pair do not depend on the mixing
+	/// weights, so while the cache holds them, a weight update only costs
+	/// their weighted recombination instead of a full re-evaluation of all
+	/// sub-kernels. Blocks are evicted least recently used once the budget
+	/// is exhausted. The cache is cleared whenever the parameters of an
+	/// adaptive sub-kernel change; a value of 0 (the default) disables
+	/// caching.
+	void setCacheSize(std::size_t numValues){
+		m_cacheBudget = numValues;
+		clearCache();
+	}
+	/// Discard all cached sub-kernel results.
+	void clearCache() const{
+		m_cache.clear();
+		m_cacheUsed = 0;
+	}
+
 	/// return the parameter vector. The first N-1 entries are the (log-encoded) kernel
 	/// weights, the sub-kernel's parameters are stacked behind each other after that.
 	RealVector parameterVector() const {
@@ -195,6 +222,8 @@ public:
 			if (m_base[i].adaptive){
 				std::size_t n = m_base[i].kernel->numberOfParameters();
 				m_base[i].kernel->setParameterVector(subrange(newParameters,index,index+n));
+				//the cached sub-kernel results are stale now
+				clearCache();
 				index += n;
 			}
 		}
@@ -222,8 +251,11 @@ public:
 		std::size_t sizeX1=shark::size(batchX1);
 		std::size_t sizeX2=shark::size(batchX2);
 		ensure_size(result,sizeX1,sizeX2);
-		result.clear();
 
+		if (m_cacheBudget > 0 && cachedEval<BatchInputType>(batchX1, batchX2, result))
+			return;
+
+		result.clear();
 		RealMatrix kernelResult(sizeX1,sizeX2);
 		for (std::size_t i = 0; i != m_base.size(); i++){
 			m_base[i].kernel->eval(batchX1, batchX2,kernelResult);
@@ -319,6 +351,7 @@ public:
 		}
 		ar >> m_weightsum;
 		ar >> m_numParameters;
+		clearCache();
 	}
 	void write(OutArchive& ar) const{
 		for(std::size_t i=0;i!= m_base.size();++i){
@@ -385,9 +418,93 @@ protected:
 		throw SHARKEXCEPTION("[WeightedSumKernel::weightdInputDerivative] The used BatchInputType is no Vector");
 	}
 
+	/// block of cached sub-kernel results for one pair of batches
+	struct CacheEntry{
+		void const* x1;                         ///< storage address identifying the first batch
+		void const* x2;                         ///< storage address identifying the second batch
+		std::size_t sizeX1;                     ///< number of rows of the first batch
+		std::size_t sizeX2;                     ///< number of rows of the second batch
+		std::size_t lastUsed;                   ///< value of the cache clock at the last access
+		std::vector<RealMatrix> kernelResults;  ///< one result block per sub-kernel
+	};
+
+	/// combines cached sub-kernel blocks with the current weights
+	void combineCached(std::vector<RealMatrix> const& kernelResults, RealMatrix& result) const{
+		noalias(result) = m_base[0].weight * kernelResults[0];
+		for (std::size_t i = 1; i != m_base.size(); i++)
+			noalias(result) += m_base[i].weight * kernelResults[i];
+		result /= m_weightsum;
+	}
+
+	//caching is only implemented for dense batches, whose storage address
+	//identifies them across calls; for every other batch type the lookup
+	//reports a miss and evaluation falls back to the direct path.
+	template <class T>
+	bool cachedEval(
+		ConstBatchInputReference batchX1,
+		ConstBatchInputReference batchX2,
+		RealMatrix& result,
+		typename boost::enable_if<boost::is_same<T,RealMatrix > >::type* dummy = 0
+	)const{
+		std::size_t sizeX1=shark::size(batchX1);
+		std::size_t sizeX2=shark::size(batchX2);
+		if (sizeX1 == 0 || sizeX2 == 0) return false;
+		void const* x1 = &batchX1(0,0);
+		void const* x2 = &batchX2(0,0);
+		m_cacheClock++;
+
+		for (typename std::list<CacheEntry>::iterator pos = m_cache.begin(); pos != m_cache.end(); ++pos){
+			if (pos->x1 == x1 && pos->x2 == x2 && pos->sizeX1 == sizeX1 && pos->sizeX2 == sizeX2){
+				pos->lastUsed = m_cacheClock;
+				combineCached(pos->kernelResults, result);
+				return true;
+			}
+		}
+
+		//block not cached; if it fits into the budget, compute and store it
+		std::size_t needed = m_base.size() * sizeX1 * sizeX2;
+		if (needed > m_cacheBudget) return false;
+		while (m_cacheUsed + needed > m_cacheBudget){
+			//evict the least recently used block
+			typename std::list<CacheEntry>::iterator oldest = m_cache.begin();
+			for (typename std::list<CacheEntry>::iterator pos = m_cache.begin(); pos != m_cache.end(); ++pos){
+				if (pos->lastUsed < oldest->lastUsed) oldest = pos;
+			}
+			m_cacheUsed -= m_base.size() * oldest->sizeX1 * oldest->sizeX2;
+			m_cache.erase(oldest);
+		}
+
+		m_cache.push_back(CacheEntry());
+		CacheEntry& entry = m_cache.back();
+		entry.x1 = x1;
+		entry.x2 = x2;
+		entry.sizeX1 = sizeX1;
+		entry.sizeX2 = sizeX2;
+		entry.lastUsed = m_cacheClock;
+		entry.kernelResults.resize(m_base.size());
+		for (std::size_t i = 0; i != m_base.size(); i++)
+			m_base[i].kernel->eval(batchX1, batchX2, entry.kernelResults[i]);
+		m_cacheUsed += needed;
+		combineCached(entry.kernelResults, result);
+		return true;
+	}
+	template <class T>
+	bool cachedEval(
+		ConstBatchInputReference batchX1,
+		ConstBatchInputReference batchX2,
+		RealMatrix& result,
+		typename boost::disable_if<boost::is_same<T,RealMatrix > >::type* dummy = 0
+	)const{
+		return false;
+	}
+
 	std::vector<tBase> m_base;                      ///< collection of m_base kernels
 	double m_weightsum;                             ///< sum of all weights
 	std::size_t m_numParameters;                   ///< total number of parameters
+	std::size_t m_cacheBudget;                      ///< maximum total number of cached sub-kernel values, 0 disables caching
+	mutable std::size_t m_cacheUsed;                ///< current number of cached sub-kernel values
+	mutable std::size_t m_cacheClock;               ///< access counter for least-recently-used eviction
+	mutable std::list<CacheEntry> m_cache;          ///< cached sub-kernel result blocks
 };
 
 typedef WeightedSumKernel<> DenseWeightedSumKernel;
@@ -33,6 +33,7 @@
 #define SHARK_MODELS_LINEARMODEL_H
 
 #include <shark/Models/AbstractModel.h>
+#include <shark/LinAlg/BLAS/kernels/gemm_batched.hpp>
 namespace shark {
 
 
@@ -79,6 +80,12 @@ public:
 		base_type::m_features |= base_type::HAS_FIRST_PARAMETER_DERIVATIVE;
 		base_type::m_features |= base_type::HAS_FIRST_INPUT_DERIVATIVE;
 	}
+	///move constructor
+	LinearModel(LinearModel&& model)
+	:m_matrix(std::move(model.m_matrix)),m_offset(std::move(model.m_offset)){
+		base_type::m_features |= base_type::HAS_FIRST_PARAMETER_DERIVATIVE;
+		base_type::m_features |= base_type::HAS_FIRST_INPUT_DERIVATIVE;
+	}
 
 	/// \brief From INameable: return the class name.
 	std::string name() const
@@ -97,6 +104,13 @@ public:
 		return *this;
 	}
 
+	///move assignment
+	LinearModel& operator=(LinearModel&& model){
+		self_type tempModel(std::move(model));
+		swap(*this,tempModel);
+		return *this;
+	}
+
 	/// Construction from matrix (and vector)
 	LinearModel(RealMatrix const& matrix, RealVector const& offset = RealVector())
 	:m_matrix(matrix),m_offset(offset){
@@ -186,7 +200,36 @@ public:
 	void eval(BatchInputType const& inputs, BatchOutputType& outputs, State& state)const{
 		eval(inputs,outputs);
 	}
-	
+
+	using base_type::operator();
+
+	/// \brief Model evaluation for a whole dataset, issuing all batches as one batched product.
+	///
+	/// The per-batch products of a dataset evaluation are typically too small to
+	/// amortise the threading overhead of the individual gemm calls. This overload
+	/// therefore collects the layer products of all batches and dispatches them
+	/// through kernels::gemm_batched, which parallelises over the batches instead.
+	Data<RealVector> operator()(Data<InputType> const& patterns)const{
+		std::size_t batches = patterns.numberOfBatches();
+		Data<RealVector> result(batches);
+		typedef decltype(trans(m_matrix)) TransposedMatrix;
+		TransposedMatrix weights = trans(m_matrix);
+		std::vector<BatchInputType const*> inputBatches(batches);
+		std::vector<TransposedMatrix const*> weightBatches(batches, &weights);
+		std::vector<BatchOutputType*> outputBatches(batches);
+		for(std::size_t i = 0; i != batches; ++i){
+			inputBatches[i] = &patterns.batch(i);
+			result.batch(i) = BatchOutputType(size(patterns.batch(i)), m_matrix.size1(), 0.0);
+			outputBatches[i] = &result.batch(i);
+		}
+		blas::kernels::gemm_batched(inputBatches, weightBatches, outputBatches, 1.0);
+		if(hasOffset()){
+			for(std::size_t i = 0; i != batches; ++i)
+				noalias(result.batch(i)) += repeat(m_offset, size(patterns.batch(i)));
+		}
+		return result;
+	}
+
 	///\brief Calculates the first derivative w.r.t the parameters and summing them up over all patterns of the last computed batch 
 	void weightedParameterDerivative(
 		BatchInputType const& patterns, RealMatrix const& coefficients, State const& state, RealVector& gradient
@@ -35,6 +35,8 @@
 #ifndef SHARK_MODELS_MEANMODEL_H
 #define SHARK_MODELS_MEANMODEL_H
 
+#include <shark/Core/OpenMP.h>
+
 namespace shark {
 ///
 /// \brief Calculates the weighted mean of a set of models
@@ -54,10 +56,34 @@ public:
 
 	using base_type::eval;
 	void eval(typename base_type::BatchInputType const& patterns, typename base_type::BatchOutputType& outputs)const{
-		m_models[0].eval(patterns,outputs);
-		outputs *=m_weight[0];
-		for(std::size_t i = 1; i != m_models.size(); i++) 
-			noalias(outputs) += m_weight[i] * m_models[i](patterns);
+		//the members are independent of each other, so every thread evaluates
+		//a share of them and accumulates into its own weighted partial sum
+		std::size_t numThreads = SHARK_NUM_THREADS;
+		std::vector<typename base_type::BatchOutputType> partialSums(numThreads);
+		std::vector<std::size_t> contributions(numThreads,0);
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)m_models.size(); ++i){
+			std::size_t thread = SHARK_THREAD_NUM;
+			if(contributions[thread] == 0){
+				m_models[i].eval(patterns,partialSums[thread]);
+				partialSums[thread] *= m_weight[i];
+			}
+			else{
+				noalias(partialSums[thread]) += m_weight[i] * m_models[i](patterns);
+			}
+			++contributions[thread];
+		}
+		//fold the per-thread sums into the result
+		bool initialized = false;
+		for(std::size_t thread = 0; thread != numThreads; ++thread){
+			if(contributions[thread] == 0) continue;
+			if(!initialized){
+				outputs = partialSums[thread];
+				initialized = true;
+			}
+			else{
+				noalias(outputs) += partialSums[thread];
+			}
+		}
 		outputs /= m_weightSum;
 	}
 	
@@ -130,29 +130,29 @@ public:
 	/// soft k-nearest-neighbor prediction
 	void eval(BatchInputType const& patterns, BatchOutputType& output, State& state)const{
 		std::size_t numPatterns = shark::size(patterns);
-		std::vector<typename NearestNeighbors::DistancePair> neighbors = m_algorithm->getNeighbors(patterns,m_neighbors);
-		
-		std::size_t dimension = neighbors[0].value.size();
+		//query the whole batch at once; the labels of all neighborhoods arrive as one matrix
+		RealMatrix distances;
+		RealMatrix neighborLabels;
+		m_algorithm->getNeighbors(patterns, m_neighbors, distances, neighborLabels);
+
+		std::size_t dimension = neighborLabels.size2();
 		output.resize(numPatterns,dimension);
-		output.clear();
 
+		RealVector weights(m_neighbors,1.0);
 		for(std::size_t p = 0; p != numPatterns;++p)
 		{
-			double wsum = 0.0;
-			for ( std::size_t k = 0; k != m_neighbors; ++k)
-			{
-				double w;
-				if (m_distanceWeights == UNIFORM) w = 1.0;
-				else
-				{
-					double d = neighbors[p*m_neighbors+k].key;
-					if (d < 1e-100) w = 1e100;
-					else w = 1.0 / d;
+			if (m_distanceWeights != UNIFORM){
+				for(std::size_t k = 0; k != m_neighbors; ++k){
+					double d = distances(p,k);
+					weights(k) = (d < 1e-100)? 1e100: 1.0 / d;
 				}
-				noalias(row(output,p)) += w * neighbors[k+p*m_neighbors].value;
-				wsum += w;
 			}
-			row(output,p) *= (1.0 / wsum);
+			//average the neighborhood in one matrix-vector product
+			noalias(row(output,p)) = prod(
+				trans(subrange(neighborLabels, p*m_neighbors, (p+1)*m_neighbors, 0, dimension)),
+				weights
+			);
+			row(output,p) *= (1.0 / sum(weights));
 		}
 	}
 
@@ -74,6 +74,13 @@ public:
 	, m_hasOffset(model.m_hasOffset)
 	{ }
 
+	/// move constructor
+	Normalizer(self_type&& model)
+	: m_A(std::move(model.m_A))
+	, m_b(std::move(model.m_b))
+	, m_hasOffset(model.m_hasOffset)
+	{ }
+
 	/// Construction from dimension
 	Normalizer(std::size_t dimension, bool hasOffset = false)
 	: m_A(dimension, dimension)
@@ -100,7 +107,7 @@ public:
 	{ return "Normalizer"; }
 
 	/// swap
-	friend void swap(const Normalizer& model1, const Normalizer& model2)
+	friend void swap(Normalizer& model1, Normalizer& model2)
 	{
 		std::swap(model1.m_A, model2.m_A);
 		std::swap(model1.m_b, model2.m_b);
@@ -108,11 +115,21 @@ public:
 	}
 
 	/// assignment operator
-	const self_type operator = (const self_type& model)
+	self_type& operator = (const self_type& model)
 	{
 		m_A = model.m_A;
 		m_b = model.m_b;
 		m_hasOffset = model.m_hasOffset;
+		return *this;
+	}
+
+	/// move assignment operator
+	self_type& operator = (self_type&& model)
+	{
+		m_A = std::move(model.m_A);
+		m_b = std::move(model.m_b);
+		m_hasOffset = model.m_hasOffset;
+		return *this;
 	}
 
 	/// derivative storage object (empty for this model)
@@ -37,6 +37,7 @@
 
 
 #include <shark/Models/AbstractModel.h>
+#include <shark/Core/OpenMP.h>
 
 
 namespace shark {
@@ -168,22 +169,32 @@ public:
 		UIntMatrix votes(numPatterns,m_classes);
 		votes.clear();
 		
-		//stores the votes of a classifier distinguishing between classes c and e
-		//for all patterns
-		UIntVector bin(numPatterns);
-		//accumulate histograms
+		//pair of classes every binary classifier distinguishes between
+		std::size_t numMachines = m_binary.size();
+		std::vector<std::pair<unsigned int,unsigned int> > machineClasses(numMachines);
 		for (unsigned int i=0, c=0; c<m_classes; c++)
 		{
-			for (std::size_t e=0; e<c; e++, i++)
+			for (unsigned int e=0; e<c; e++, i++)
 			{
-				m_binary[i]->eval(patterns,bin);
+				machineClasses[i] = std::make_pair(c,e);
+			}
+		}
+		//accumulate histograms. The binary classifiers are independent of
+		//each other, so they evaluate the batch in parallel; only the
+		//update of the votes is synchronized
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)numMachines; i++)
+		{
+			//stores the votes of a classifier distinguishing between classes c and e
+			//for all patterns
+			UIntVector bin(numPatterns);
+			m_binary[i]->eval(patterns,bin);
+			SHARK_CRITICAL_REGION{
 				for(std::size_t p = 0; p != numPatterns; ++p){
-					if (bin[p] == 0) 
-						votes(p,e)++; 
-					else 
-						votes(p,c)++;
+					if (bin[p] == 0)
+						votes(p,machineClasses[i].second)++;
+					else
+						votes(p,machineClasses[i].first)++;
 				}
-				
 			}
 		}
 		//find the maximum class for ever pattern
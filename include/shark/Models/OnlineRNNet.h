@@ -52,6 +52,13 @@ namespace shark{
 class OnlineRNNet:public AbstractModel<RealVector,RealVector>
 {
 public:
+	//! type enum for the different ways of keeping the sensitivities of the gradient recursion
+	enum SensitivityMode
+	{
+		FULL_SENSITIVITIES,     //!< exact RTRL recursion, needs O(weights x neurons) memory per step
+		DIAGONAL_SENSITIVITIES, //!< truncated recursion with one eligibility trace per weight, O(weights) memory
+	};
+
 	//! creates a configured neural network
 	SHARK_EXPORT_SYMBOL OnlineRNNet(RecurrentStructure* structure);
 
@@ -65,8 +72,19 @@ public:
 	//!  \param  pattern  Input patterns for the network.
 	//!  \param  output Used to store the outputs of the network.
 	SHARK_EXPORT_SYMBOL void eval(RealMatrix const& pattern,RealMatrix& output);
+
+	//!  \brief From AbstractModel. The network is inherently stateful, so the
+	//!         state argument is ignored and the internal activations are updated.
+	void eval(BatchInputType const& pattern, BatchOutputType& output, State& state)const{
+		const_cast<OnlineRNNet*>(this)->eval(pattern,output);
+	}
 	using AbstractModel<RealVector,RealVector>::eval;
 
+	//!the network stores its state internally, so no external state is needed
+	boost::shared_ptr<State> createState()const{
+		return boost::shared_ptr<State>(new EmptyState());
+	}
+
 	/// obtain the input dimension
 	std::size_t inputSize() const{
 		return mpe_structure->inputs();
@@ -88,6 +106,23 @@ public:
 	//! \param gradient the calculated gradient
 	SHARK_EXPORT_SYMBOL void weightedParameterDerivative(RealMatrix const& pattern, RealMatrix const& coefficients,  RealVector& gradient);
 
+	//! query how the sensitivities of the gradient recursion are kept
+	SensitivityMode sensitivityMode()const{
+		return m_sensitivityMode;
+	}
+
+	//!\brief set how the sensitivities of the gradient recursion are kept
+	//!
+	//!In the diagonal mode, only the sensitivity of every weight with respect to
+	//!its postsynaptic neuron is propagated through time; the influence on the
+	//!other neurons is truncated after a single step of the recurrent weights.
+	//!This reduces the per-step cost from O(weights x neurons^2) to O(weights),
+	//!at the price of an approximate gradient. For networks with a single neuron
+	//!the truncation is exact.
+	void setSensitivityMode(SensitivityMode mode){
+		m_sensitivityMode = mode;
+	}
+
 	//! get internal parameters of the model
 	RealVector parameterVector() const{
 		return mpe_structure->parameterVector();
@@ -109,6 +144,7 @@ public:
 		m_lastActivation.clear();
 		m_activation.clear();
 		m_unitGradient.clear();
+		m_diagonalGradient.clear();
 	}
 
 	//!  \brief This Method sets the activation of the output neurons
@@ -145,6 +181,15 @@ protected:
 	//!\f[ \frac{\delta y_k(t+1)}{\delta w_{ij}}= y'_k(t)= \left[\sum_{l=1}^n w_{il}\frac{\delta y_l(t)}{\delta w_{ij}} +\delta_{kl}y_l(t-1)\right]\f]
 	//!so if the gradient is needed, don't forget to call weightedParameterDerivative at every timestep!
 	RealMatrix m_unitGradient;
+
+	//!the per-weight eligibility traces used instead of m_unitGradient in the diagonal mode
+	RealVector m_diagonalGradient;
+
+	//!how the sensitivities of the gradient recursion are kept
+	SensitivityMode m_sensitivityMode;
+
+	//!truncated gradient recursion used in the diagonal sensitivity mode
+	SHARK_EXPORT_SYMBOL void weightedParameterDerivativeDiagonal(RealMatrix const& pattern, RealMatrix const& coefficients,  RealVector& gradient);
 };
 }
 
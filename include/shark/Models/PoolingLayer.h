@@ -0,0 +1,272 @@
+//===========================================================================
+/*!
+ *
+ * \brief       Spatial pooling layer for feed forward architectures.
+ *
+ *
+ *
+ * \author      O.Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#ifndef SHARK_MODELS_POOLING_LAYER_H
+#define SHARK_MODELS_POOLING_LAYER_H
+
+#include <shark/Models/AbstractModel.h>
+#include <vector>
+
+namespace shark{
+
+/// \brief Spatial max or average pooling over image-like inputs.
+///
+/// The layer interprets every input vector as a stack of numChannels
+/// images of size imageHeight x imageWidth stored channel by channel in
+/// row-major order, the same layout as used by the ConvolutionalLayer.
+/// Every image is partitioned into non-overlapping windows of size
+/// poolHeight x poolWidth and each window is reduced to its maximum or
+/// its average. The image dimensions must be divisible by the window size.
+///
+/// The layer has no parameters. For max pooling the position of the
+/// maximum of every window is remembered in the state so that the input
+/// derivative routes the error of an output solely to the input which
+/// attained the maximum.
+class PoolingLayer : public AbstractModel<RealVector,RealVector>
+{
+private:
+	struct InternalState: public State{
+		/// \brief Index of the input attaining the maximum for every output; only used for max pooling.
+		std::vector<std::vector<std::size_t> > maxIndex;
+
+		void resize(std::size_t patterns, std::size_t outputs){
+			maxIndex.assign(patterns,std::vector<std::size_t>(outputs,0));
+		}
+	};
+public:
+	enum PoolingType{
+		Maximum,
+		Average
+	};
+
+	/// \brief Creates an empty layer, use setStructure to define the topology.
+	PoolingLayer()
+	: m_numChannels(0), m_imageHeight(0), m_imageWidth(0)
+	, m_poolHeight(1), m_poolWidth(1), m_type(Maximum){
+		m_features |= HAS_FIRST_PARAMETER_DERIVATIVE;
+		m_features |= HAS_FIRST_INPUT_DERIVATIVE;
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "PoolingLayer"; }
+
+	/// \brief Sets the topology of the layer.
+	///
+	/// \param numChannels number of channels of the input image stack
+	/// \param imageHeight height of the input images, must be divisible by poolHeight
+	/// \param imageWidth width of the input images, must be divisible by poolWidth
+	/// \param poolHeight height of the pooling windows
+	/// \param poolWidth width of the pooling windows
+	/// \param type whether the windows are reduced to their maximum or their average
+	void setStructure(
+		std::size_t numChannels, std::size_t imageHeight, std::size_t imageWidth,
+		std::size_t poolHeight, std::size_t poolWidth, PoolingType type = Maximum
+	){
+		SIZE_CHECK(poolHeight > 0 && imageHeight % poolHeight == 0);
+		SIZE_CHECK(poolWidth > 0 && imageWidth % poolWidth == 0);
+		m_numChannels = numChannels;
+		m_imageHeight = imageHeight;
+		m_imageWidth = imageWidth;
+		m_poolHeight = poolHeight;
+		m_poolWidth = poolWidth;
+		m_type = type;
+	}
+
+	std::size_t inputSize()const{
+		return m_numChannels*m_imageHeight*m_imageWidth;
+	}
+	std::size_t outputSize()const{
+		return m_numChannels*outputHeight()*outputWidth();
+	}
+	/// \brief Height of the pooled images.
+	std::size_t outputHeight()const{
+		return m_imageHeight/m_poolHeight;
+	}
+	/// \brief Width of the pooled images.
+	std::size_t outputWidth()const{
+		return m_imageWidth/m_poolWidth;
+	}
+	/// \brief Returns whether the windows are reduced to their maximum or their average.
+	PoolingType type()const{
+		return m_type;
+	}
+
+	/// \brief The layer has no parameters.
+	RealVector parameterVector() const{
+		return RealVector();
+	}
+	void setParameterVector(RealVector const& newParameters){
+		SIZE_CHECK(newParameters.size() == 0);
+	}
+	std::size_t numberOfParameters() const{
+		return 0;
+	}
+
+	boost::shared_ptr<State> createState()const{
+		return boost::shared_ptr<State>(new InternalState());
+	}
+
+	using AbstractModel<RealVector,RealVector>::eval;
+
+	void eval(RealMatrix const& patterns, RealMatrix& outputs)const{
+		InternalState state;
+		evalImpl(patterns,outputs,state);
+	}
+
+	void eval(RealMatrix const& patterns, RealMatrix& outputs, State& state)const{
+		evalImpl(patterns,outputs,state.toState<InternalState>());
+	}
+
+	///\brief The layer has no parameters, thus the gradient is empty.
+	void weightedParameterDerivative(
+		RealMatrix const& patterns, RealMatrix const& coefficients, State const& state, RealVector& gradient
+	)const{
+		SIZE_CHECK(coefficients.size2() == outputSize());
+		SIZE_CHECK(coefficients.size1() == patterns.size1());
+		gradient.resize(0);
+	}
+
+	///\brief Calculates the first derivative w.r.t the inputs and sums them up over all patterns of the last computed batch
+	void weightedInputDerivative(
+		RealMatrix const& patterns, RealMatrix const& coefficients, State const& state, RealMatrix& derivative
+	)const{
+		SIZE_CHECK(coefficients.size2() == outputSize());
+		SIZE_CHECK(coefficients.size1() == patterns.size1());
+		InternalState const& s = state.toState<InternalState>();
+		std::size_t numPatterns = patterns.size1();
+
+		derivative.resize(numPatterns,inputSize());
+		derivative.clear();
+		if(m_type == Maximum){
+			//route the error of every output to the input attaining the maximum
+			for(std::size_t p = 0; p != numPatterns; ++p){
+				for(std::size_t o = 0; o != outputSize(); ++o){
+					derivative(p,s.maxIndex[p][o]) += coefficients(p,o);
+				}
+			}
+		}else{
+			//spread the error of every output uniformly over its window
+			double weight = 1.0/(m_poolHeight*m_poolWidth);
+			for(std::size_t p = 0; p != numPatterns; ++p){
+				for(std::size_t c = 0; c != m_numChannels; ++c){
+					for(std::size_t y = 0; y != outputHeight(); ++y){
+						for(std::size_t x = 0; x != outputWidth(); ++x){
+							std::size_t o = (c*outputHeight()+y)*outputWidth()+x;
+							double value = weight*coefficients(p,o);
+							for(std::size_t i = 0; i != m_poolHeight; ++i){
+								for(std::size_t j = 0; j != m_poolWidth; ++j){
+									derivative(p,index(c,y*m_poolHeight+i,x*m_poolWidth+j)) += value;
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/// From ISerializable
+	void read(InArchive& archive){
+		archive >> m_numChannels;
+		archive >> m_imageHeight;
+		archive >> m_imageWidth;
+		archive >> m_poolHeight;
+		archive >> m_poolWidth;
+		unsigned int type = 0;
+		archive >> type;
+		m_type = PoolingType(type);
+	}
+	/// From ISerializable
+	void write(OutArchive& archive) const{
+		archive << m_numChannels;
+		archive << m_imageHeight;
+		archive << m_imageWidth;
+		archive << m_poolHeight;
+		archive << m_poolWidth;
+		unsigned int type = m_type;
+		archive << type;
+	}
+
+private:
+	void evalImpl(RealMatrix const& patterns, RealMatrix& outputs, InternalState& state)const{
+		SIZE_CHECK(patterns.size2() == inputSize());
+		std::size_t numPatterns = patterns.size1();
+		outputs.resize(numPatterns,outputSize());
+		state.resize(numPatterns,outputSize());
+
+		for(std::size_t p = 0; p != numPatterns; ++p){
+			for(std::size_t c = 0; c != m_numChannels; ++c){
+				for(std::size_t y = 0; y != outputHeight(); ++y){
+					for(std::size_t x = 0; x != outputWidth(); ++x){
+						std::size_t o = (c*outputHeight()+y)*outputWidth()+x;
+						if(m_type == Maximum){
+							std::size_t best = index(c,y*m_poolHeight,x*m_poolWidth);
+							for(std::size_t i = 0; i != m_poolHeight; ++i){
+								for(std::size_t j = 0; j != m_poolWidth; ++j){
+									std::size_t in = index(c,y*m_poolHeight+i,x*m_poolWidth+j);
+									if(patterns(p,in) > patterns(p,best))
+										best = in;
+								}
+							}
+							outputs(p,o) = patterns(p,best);
+							state.maxIndex[p][o] = best;
+						}else{
+							double sum = 0.0;
+							for(std::size_t i = 0; i != m_poolHeight; ++i){
+								for(std::size_t j = 0; j != m_poolWidth; ++j){
+									sum += patterns(p,index(c,y*m_poolHeight+i,x*m_poolWidth+j));
+								}
+							}
+							outputs(p,o) = sum/(m_poolHeight*m_poolWidth);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/// \brief Linear index of the pixel (y,x) of channel c in the input layout.
+	std::size_t index(std::size_t c, std::size_t y, std::size_t x)const{
+		return (c*m_imageHeight+y)*m_imageWidth+x;
+	}
+
+	std::size_t m_numChannels;
+	std::size_t m_imageHeight;
+	std::size_t m_imageWidth;
+	std::size_t m_poolHeight;
+	std::size_t m_poolWidth;
+	PoolingType m_type;
+};
+
+}
+#endif
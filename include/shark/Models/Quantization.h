@@ -0,0 +1,386 @@
+/*!
+ *
+ *
+ * \brief       Post-training int8 quantization of linear models and networks.
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_MODELS_QUANTIZATION_H
+#define SHARK_MODELS_QUANTIZATION_H
+
+#include <shark/Models/FFNet.h>
+#include <shark/Models/LinearModel.h>
+
+#include <boost/serialization/vector.hpp>
+
+#include <cmath>
+#include <vector>
+
+namespace shark {
+
+namespace detail{
+
+/// \brief int8 dot product with 32 bit accumulation.
+///
+/// The loop body is kept free of branches and indirections so that the
+/// compiler vectorizes it using the widening integer multiply-add of the
+/// target architecture.
+inline int dotInt8(signed char const* x, signed char const* y, std::size_t n){
+	int sum = 0;
+	for(std::size_t i = 0; i != n; ++i)
+		sum += int(x[i]) * int(y[i]);
+	return sum;
+}
+
+/// \brief Rounds a value to the quantized grid, saturating at +-127.
+inline signed char quantizeValue(double value, double scale){
+	double quantized = std::floor(value / scale + 0.5);
+	quantized = std::max(-127.0, std::min(127.0, quantized));
+	return static_cast<signed char>(quantized);
+}
+
+/// \brief One int8-quantized linear layer together with its scale factors.
+///
+/// The weights are quantized symmetrically with one scale factor per output
+/// row, the activations feeding the layer share one scale factor obtained
+/// from calibration data. The product of an int8 weight and an int8
+/// activation is accumulated in 32 bit and dequantized with the product of
+/// the two scales, so a layer computes
+/// \f$ y_o = s_o s_{in} \sum_j W^{q}_{oj} x^{q}_j + b_o \f$ in one pass.
+struct QuantizedLayer{
+	std::size_t inputs; ///< number of columns of the weight matrix
+	std::size_t outputs; ///< number of rows of the weight matrix
+	std::vector<signed char> weights; ///< quantized weights, stored row-major
+	RealVector rowScales; ///< dequantization scale of every weight row
+	RealVector bias; ///< bias term in full precision, may be empty
+	double inputScale; ///< quantization scale of the activations feeding the layer
+
+	/// \brief Quantizes a weight layer given the range of its input activations.
+	///
+	/// \param weightMatrix the trained weights of the layer
+	/// \param layerBias    the bias of the layer, may be empty
+	/// \param inputRange   largest absolute input activation seen during calibration
+	void quantize(RealMatrix const& weightMatrix, RealVector const& layerBias, double inputRange){
+		inputs = weightMatrix.size2();
+		outputs = weightMatrix.size1();
+		weights.resize(inputs * outputs);
+		rowScales.resize(outputs);
+		bias = layerBias;
+		inputScale = inputRange > 0? inputRange / 127 : 1.0;
+		for(std::size_t o = 0; o != outputs; ++o){
+			double maxAbs = 0;
+			for(std::size_t j = 0; j != inputs; ++j)
+				maxAbs = std::max(maxAbs, std::abs(weightMatrix(o,j)));
+			double scale = maxAbs > 0? maxAbs / 127 : 1.0;
+			rowScales(o) = scale;
+			for(std::size_t j = 0; j != inputs; ++j)
+				weights[o * inputs + j] = quantizeValue(weightMatrix(o,j), scale);
+		}
+	}
+
+	/// \brief Evaluates the layer on a batch of patterns.
+	///
+	/// The patterns are quantized once into the provided scratch buffer, then
+	/// every output is one int8 dot product.
+	void eval(RealMatrix const& patterns, RealMatrix& responses, std::vector<signed char>& quantizedPatterns)const{
+		SIZE_CHECK(patterns.size2() == inputs);
+		std::size_t numPatterns = patterns.size1();
+		responses.resize(numPatterns, outputs);
+		quantizedPatterns.resize(numPatterns * inputs);
+		for(std::size_t i = 0; i != numPatterns; ++i){
+			for(std::size_t j = 0; j != inputs; ++j)
+				quantizedPatterns[i * inputs + j] = quantizeValue(patterns(i,j), inputScale);
+		}
+		for(std::size_t i = 0; i != numPatterns; ++i){
+			signed char const* pattern = &quantizedPatterns[i * inputs];
+			for(std::size_t o = 0; o != outputs; ++o){
+				int accumulator = dotInt8(&weights[o * inputs], pattern, inputs);
+				responses(i,o) = rowScales(o) * inputScale * accumulator;
+			}
+			if(!bias.empty())
+				noalias(row(responses,i)) += bias;
+		}
+	}
+
+	template<class Archive>
+	void serialize(Archive& archive, unsigned int const){
+		archive & inputs;
+		archive & outputs;
+		archive & weights;
+		archive & rowScales;
+		archive & bias;
+		archive & inputScale;
+	}
+};
+
+/// \brief Returns the largest absolute value of the elements of a dataset.
+inline double maxAbsElement(Data<RealVector> const& data){
+	double range = 0;
+	for(std::size_t b = 0; b != data.numberOfBatches(); ++b){
+		RealMatrix const& batch = data.batch(b);
+		for(std::size_t i = 0; i != batch.size1(); ++i){
+			for(std::size_t j = 0; j != batch.size2(); ++j)
+				range = std::max(range, std::abs(batch(i,j)));
+		}
+	}
+	return range;
+}
+
+/// \brief Returns the largest absolute value of the elements of a matrix.
+inline double maxAbsElement(RealMatrix const& matrix){
+	double range = 0;
+	for(std::size_t i = 0; i != matrix.size1(); ++i){
+		for(std::size_t j = 0; j != matrix.size2(); ++j)
+			range = std::max(range, std::abs(matrix(i,j)));
+	}
+	return range;
+}
+
+}
+
+///
+/// \brief Int8-quantized evaluator of a trained LinearModel.
+///
+/// \par
+/// The model stores the weight matrix as int8 values with one scale factor
+/// per output row and quantizes the inputs with a single scale factor
+/// obtained from a calibration pass over sample data, reducing the weight
+/// memory by a factor of four compared to the double precision original.
+/// Predictions are computed by integer dot products and dequantized
+/// afterwards, so they approximate the original model up to the quantization
+/// error. Inputs outside the calibrated range saturate.
+///
+/// \par
+/// The model is a fixed function of the original; it has no parameters of
+/// its own and cannot be trained further.
+class QuantizedLinearModel : public AbstractModel<RealVector,RealVector>
+{
+private:
+	typedef AbstractModel<RealVector,RealVector> base_type;
+	detail::QuantizedLayer m_layer;
+public:
+	typedef base_type::BatchInputType BatchInputType;
+	typedef base_type::BatchOutputType BatchOutputType;
+
+	/// Default constructor; use the converting constructor or read an archive.
+	QuantizedLinearModel(){
+		m_layer.inputs = 0;
+		m_layer.outputs = 0;
+		m_layer.inputScale = 1.0;
+	}
+
+	/// \brief Quantizes a trained linear model.
+	///
+	/// \param model       the trained model to quantize
+	/// \param calibration sample data used to calibrate the input range
+	QuantizedLinearModel(LinearModel<RealVector> const& model, Data<RealVector> const& calibration){
+		m_layer.quantize(model.matrix(), model.offset(), detail::maxAbsElement(calibration));
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "QuantizedLinearModel"; }
+
+	/// obtain the input dimension
+	std::size_t inputSize() const{
+		return m_layer.inputs;
+	}
+
+	/// obtain the output dimension
+	std::size_t outputSize() const{
+		return m_layer.outputs;
+	}
+
+	/// the model has no trainable parameters
+	RealVector parameterVector() const{
+		return RealVector();
+	}
+
+	/// the model has no trainable parameters
+	void setParameterVector(RealVector const& newParameters){
+		SIZE_CHECK(newParameters.size() == 0);
+	}
+
+	/// return the number of parameters, which is zero
+	std::size_t numberOfParameters() const{
+		return 0;
+	}
+
+	boost::shared_ptr<State> createState()const{
+		return boost::shared_ptr<State>(new EmptyState());
+	}
+
+	using base_type::eval;
+
+	/// Evaluate the model using the quantized weights
+	void eval(BatchInputType const& inputs, BatchOutputType& outputs)const{
+		std::vector<signed char> quantizedPatterns;
+		m_layer.eval(inputs, outputs, quantizedPatterns);
+	}
+	/// Evaluate the model using the quantized weights
+	void eval(BatchInputType const& inputs, BatchOutputType& outputs, State& state)const{
+		eval(inputs,outputs);
+	}
+
+	/// From ISerializable
+	void read(InArchive& archive){
+		archive >> m_layer;
+	}
+	/// From ISerializable
+	void write(OutArchive& archive) const{
+		archive << m_layer;
+	}
+};
+
+///
+/// \brief Int8-quantized evaluator of a trained FFNet.
+///
+/// \par
+/// Every weight layer of the network is quantized like in
+/// QuantizedLinearModel, while the activation functions are applied in full
+/// precision between the layers. The scale factor of every layer input is
+/// calibrated by propagating sample data through the original network, so
+/// the activations of the hidden layers are covered by their observed range.
+///
+/// \par
+/// Only layerwise networks without shortcuts can be quantized, since the
+/// quantized layers process the output of their predecessor only.  Like
+/// QuantizedLinearModel, the evaluator has no trainable parameters.
+template<class HiddenNeuron,class OutputNeuron>
+class QuantizedFFNet : public AbstractModel<RealVector,RealVector>
+{
+private:
+	typedef AbstractModel<RealVector,RealVector> base_type;
+	std::vector<detail::QuantizedLayer> m_layers;
+	HiddenNeuron m_hiddenNeuron;
+	OutputNeuron m_outputNeuron;
+public:
+	typedef base_type::BatchInputType BatchInputType;
+	typedef base_type::BatchOutputType BatchOutputType;
+
+	/// Default constructor; use the converting constructor or read an archive.
+	QuantizedFFNet(){}
+
+	/// \brief Quantizes a trained feed-forward network.
+	///
+	/// The calibration data is propagated through the original network layer
+	/// by layer to record the activation ranges of every layer input.
+	/// \param network     the trained network to quantize
+	/// \param calibration sample data used to calibrate the activation ranges
+	QuantizedFFNet(FFNet<HiddenNeuron,OutputNeuron> const& network, Data<RealVector> const& calibration){
+		if(network.inputOutputShortcut().size1() != 0)
+			throw SHARKEXCEPTION("[QuantizedFFNet] networks with input-output shortcuts can not be quantized");
+		std::size_t previousOutputs = network.inputSize();
+		for(std::size_t layer = 0; layer != network.layerMatrices().size(); ++layer){
+			if(network.layerMatrix(layer).size2() != previousOutputs)
+				throw SHARKEXCEPTION("[QuantizedFFNet] only layerwise networks can be quantized");
+			previousOutputs = network.layerMatrix(layer).size1();
+		}
+
+		m_layers.resize(network.layerMatrices().size());
+		Data<RealVector> activations = calibration;
+		for(std::size_t layer = 0; layer != m_layers.size(); ++layer){
+			RealVector layerBias;
+			if(!network.bias().empty())
+				layerBias = network.bias(layer);
+			m_layers[layer].quantize(
+				network.layerMatrix(layer), layerBias,
+				detail::maxAbsElement(activations)
+			);
+			if(layer != m_layers.size()-1)
+				activations = network.evalLayer(layer,activations);
+		}
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "QuantizedFFNet"; }
+
+	/// \brief Number of input neurons.
+	std::size_t inputSize()const{
+		return m_layers.empty()? 0 : m_layers.front().inputs;
+	}
+	/// \brief Number of output neurons.
+	std::size_t outputSize()const{
+		return m_layers.empty()? 0 : m_layers.back().outputs;
+	}
+
+	/// the model has no trainable parameters
+	RealVector parameterVector() const{
+		return RealVector();
+	}
+
+	/// the model has no trainable parameters
+	void setParameterVector(RealVector const& newParameters){
+		SIZE_CHECK(newParameters.size() == 0);
+	}
+
+	/// return the number of parameters, which is zero
+	std::size_t numberOfParameters() const{
+		return 0;
+	}
+
+	boost::shared_ptr<State> createState()const{
+		return boost::shared_ptr<State>(new EmptyState());
+	}
+
+	using base_type::eval;
+
+	/// Evaluate the network using the quantized layers
+	void eval(BatchInputType const& patterns, BatchOutputType& outputs)const{
+		SIZE_CHECK(!m_layers.empty());
+		std::vector<signed char> quantizedPatterns;
+		RealMatrix current = patterns;
+		RealMatrix next;
+		for(std::size_t layer = 0; layer != m_layers.size(); ++layer){
+			m_layers[layer].eval(current, next, quantizedPatterns);
+			//apply the activation function in full precision
+			if(layer != m_layers.size()-1)
+				noalias(next) = m_hiddenNeuron(next);
+			else
+				noalias(next) = m_outputNeuron(next);
+			swap(current,next);
+		}
+		outputs = std::move(current);
+	}
+	/// Evaluate the network using the quantized layers
+	void eval(BatchInputType const& patterns, BatchOutputType& outputs, State& state)const{
+		eval(patterns,outputs);
+	}
+
+	/// From ISerializable
+	void read(InArchive& archive){
+		archive >> m_layers;
+	}
+	/// From ISerializable
+	void write(OutArchive& archive) const{
+		archive << m_layers;
+	}
+};
+
+}
+#endif
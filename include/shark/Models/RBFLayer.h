@@ -143,9 +143,9 @@ public:
 		return m_centers;
 	}
 	///\brief Sets the center values of the neurons.
-	BatchInputType& centers(){
-		return m_centers;
-	}
+	///
+	/// This also refreshes the squared center norms cached for evaluation.
+	SHARK_EXPORT_SYMBOL void setCenters(BatchInputType const& centers);
 	
 	///\brief Returns the width parameter of the Gaussian functions 
 	RealVector const& gamma()const{
@@ -172,6 +172,12 @@ protected:
 	/// \brief the logarithm of the normalization constant for every distribution
 	RealVector m_logNormalization;
 
+	/// \brief squared norms of the centers, cached for the distance computation in eval
+	RealVector m_centerNormsSqr;
+
+	/// \brief Recomputes the cached squared center norms. Must be called whenever the centers change.
+	SHARK_EXPORT_SYMBOL void updateCenterNormsSqr();
+
 	//=====training parameters
 	///enables learning of the center points of the neurons
 	bool m_trainCenters;
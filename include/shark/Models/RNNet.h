@@ -63,13 +63,18 @@ private:
 		//! the activation for timestep t, the third dimension the activation
 		//! of the neuron at the timestep of the batch element.
 		std::vector<Sequence> timeActivation;
+
+		//! Scratch buffer for the backward pass, reused between calls so that
+		//! the gradient computation does not allocate for every sequence.
+		//! It holds one row per time step of the current backpropagation window.
+		mutable RealMatrix errorDerivative;
 	};
 public:
 
 	//! creates a neural network with a potentially shared structure
 	//! \param structure the structure of this neural network. It can be shared between multiple instances or with then
 	//!                  online version of this net.
-	RNNet(RecurrentStructure* structure):mpe_structure(structure){
+	RNNet(RecurrentStructure* structure):mpe_structure(structure),m_truncatedSteps(0){
 		SHARK_CHECK(mpe_structure,"[RNNet] structure is not allowed to be empty");
 		m_features|=HAS_FIRST_PARAMETER_DERIVATIVE;
 	}
@@ -100,7 +105,29 @@ public:
 	void setWarmUpSequence(Sequence const& warmUpSequence = Sequence()){
 		m_warmUpSequence = warmUpSequence;
 	}
-	
+
+	//!  \brief Sets the number of time steps the error is propagated back in time.
+	//!
+	//!  By default the gradient is computed by backpropagation through the
+	//!  whole sequence. For very long sequences this is both slow and, since
+	//!  the backward pass needs storage for every time step, memory hungry.
+	//!  Setting a truncation window cuts every sequence into blocks of the
+	//!  given length; errors are backpropagated inside a block but not across
+	//!  block boundaries (truncated BPTT). The backward pass then only needs
+	//!  a buffer of the window size, independent of the sequence length.
+	//!
+	//!  \param truncatedSteps length of the backpropagation window; zero (the default)
+	//!                        restores backpropagation through the whole sequence
+	void setTruncatedSteps(std::size_t truncatedSteps){
+		m_truncatedSteps = truncatedSteps;
+	}
+
+	//! \brief Returns the length of the backpropagation window, zero meaning the whole sequence.
+	std::size_t truncatedSteps()const{
+		return m_truncatedSteps;
+	}
+
+
 	boost::shared_ptr<State> createState()const{
 		return boost::shared_ptr<State>(new InternalState());
 	}
@@ -172,7 +199,8 @@ protected:
 	//! the topology of the network.
 	RecurrentStructure* mpe_structure;
 
-	RealMatrix m_errorDerivative;
+	//! length of the backpropagation window, zero meaning the whole sequence
+	std::size_t m_truncatedSteps;
 };
 }
 
@@ -95,6 +95,47 @@ public:
 		return m_weights(i,j);
 	}
 
+	//!\brief start of every neuron's block in connectionUnits(); has numberOfNeurons()+1 entries
+	//!
+	//!Together with connectionUnits() and packedWeights() this forms a CSR view
+	//!of the weight matrix which only stores the existing connections. The
+	//!entries are ordered like the parameter vector, so the kth connection
+	//!corresponds to the kth parameter.
+	std::vector<std::size_t> const& connectionStarts()const{
+		return m_rowStart;
+	}
+	//!unit indices of the existing connections in parameter order
+	std::vector<std::size_t> const& connectionUnits()const{
+		return m_columnIndex;
+	}
+	//!weights of the existing connections in parameter order
+	RealVector const& packedWeights()const{
+		return m_packedWeights;
+	}
+
+	//!returns whether the O(connections) kernels are used for the forward step
+	bool sparseComputationMode()const{
+		return m_sparseComputation;
+	}
+
+	//!\brief enables or disables the sparse computation mode
+	//!
+	//!In the sparse mode, the networks sharing this structure multiply with
+	//!the packed weights of the existing connections only, so a forward or
+	//!backward step costs O(connections) instead of O(neurons x units). This
+	//!pays off when the connection matrix is sparse; for (nearly) fully
+	//!connected topologies the dense matrix product is faster.
+	void setSparseComputationMode(bool enabled){
+		m_sparseComputation = enabled;
+	}
+
+	//!\brief Multiplies the weight matrix with a vector of unit activations,
+	//!touching only the existing connections.
+	//!
+	//!Computes activations = weights * units through the CSR view, so the
+	//!cost is O(connections). The result has one entry per neuron.
+	SHARK_EXPORT_SYMBOL void multiplyWeights(RealVector const& units, RealVector& activations)const;
+
 	//!returns the type of sigmoid used in this network
 	SigmoidType sigmoidType() const {
 		return m_sigmoidType;
@@ -221,6 +262,18 @@ protected:
 	//! stores the feed-forward part of the weights. the recurrent part is added
 	//! via m_recurrentWeights. The weights for neuron i are stored in the ith row of the matrix
 	RealMatrix m_weights;
+
+	//! start of every neuron's connection block in m_columnIndex; size numberOfNeurons()+1
+	std::vector<std::size_t> m_rowStart;
+	//! unit indices of the existing connections in parameter order
+	std::vector<std::size_t> m_columnIndex;
+	//! weights of the existing connections in parameter order
+	RealVector m_packedWeights;
+	//! whether the O(connections) kernels are used for the forward step
+	bool m_sparseComputation;
+
+	//! rebuilds the CSR view from the connection matrix and the weight matrix
+	SHARK_EXPORT_SYMBOL void buildSparseStructure();
 };
 }
 
@@ -93,6 +93,14 @@ public:
 	*/
 	SHARK_EXPORT_SYMBOL virtual double sigmoid(double x)const;
 	/*!
+	*  \brief applies the activation function to a whole batch of activations in place
+	*
+	*  Every subclass maps its scalar sigmoid over the batch through the
+	*  vectorized blas transformations, so eval avoids the per-element
+	*  virtual call.
+	*/
+	SHARK_EXPORT_SYMBOL virtual void sigmoid(RealVector& x)const;
+	/*!
 	*  \brief Computes the derivative of the activation function
 	*         \f$g_{output}(x)\f$ for the output given the
 	*		  last response of the model gx=g(x)
@@ -152,6 +160,7 @@ class SimpleSigmoidModel : public SigmoidModel
 public:
 	SHARK_EXPORT_SYMBOL SimpleSigmoidModel( bool transform_for_unconstrained = true );
 	SHARK_EXPORT_SYMBOL double sigmoid(double a)const;
+	SHARK_EXPORT_SYMBOL void sigmoid(RealVector& x)const;
 	SHARK_EXPORT_SYMBOL double sigmoidDerivative(double ga)const;
 
 	/// \brief From INameable: return the class name.
@@ -169,6 +178,7 @@ class TanhSigmoidModel : public SigmoidModel
 public:
 	SHARK_EXPORT_SYMBOL TanhSigmoidModel( bool transform_for_unconstrained = true );
 	SHARK_EXPORT_SYMBOL double sigmoid(double a)const;
+	SHARK_EXPORT_SYMBOL void sigmoid(RealVector& x)const;
 	SHARK_EXPORT_SYMBOL double sigmoidDerivative(double ga)const;
 
 	/// \brief From INameable: return the class name.
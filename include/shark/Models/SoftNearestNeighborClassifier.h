@@ -140,29 +140,33 @@ public:
 	/// soft k-nearest-neighbor prediction
 	void eval(BatchInputType const& patterns, BatchOutputType& outputs) const {
 		std::size_t numPatterns = shark::size(patterns);
-		std::vector<typename NearestNeighbors::DistancePair> neighbors = m_algorithm->getNeighbors(patterns, m_neighbors);
+		//query the whole batch at once; the distances and labels arrive as matrices
+		RealMatrix distances;
+		UIntVector neighborLabels;
+		m_algorithm->getNeighbors(patterns, m_neighbors, distances, neighborLabels);
 
 		outputs.resize(numPatterns, m_classes);
 		outputs.clear();
 
-		for(std::size_t p = 0; p != numPatterns;++p)
-		{
-			double wsum = 0.0;
-			for ( std::size_t k = 0; k != m_neighbors; ++k)
-			{
-				double w;
-				if (m_distanceWeights == UNIFORM) w = 1.0;
-				else
-				{
-					double d = neighbors[p*m_neighbors+k].key;
-					if (d < 1e-100) w = 1e100;
-					else w = 1.0 / d;
+		if (m_distanceWeights == UNIFORM){
+			//all neighbors carry the same weight, so the normalization is known up front
+			double w = 1.0 / m_neighbors;
+			for(std::size_t p = 0; p != numPatterns; ++p){
+				for(std::size_t k = 0; k != m_neighbors; ++k)
+					outputs(p, neighborLabels(k+p*m_neighbors)) += w;
+			}
+		}
+		else{
+			RealVector weights(m_neighbors);
+			for(std::size_t p = 0; p != numPatterns; ++p){
+				for(std::size_t k = 0; k != m_neighbors; ++k){
+					double d = distances(p,k);
+					weights(k) = (d < 1e-100)? 1e100: 1.0 / d;
 				}
-
-				outputs(p, neighbors[p*m_neighbors+k].value) += w;
-				wsum += w;
+				for(std::size_t k = 0; k != m_neighbors; ++k)
+					outputs(p, neighborLabels(k+p*m_neighbors)) += weights(k);
+				row(outputs, p) *= (1.0 / sum(weights));
 			}
-			row(outputs, p) *= (1.0 / wsum);
 		}
 	}
 	void eval(BatchInputType const& patterns, BatchOutputType& outputs, State & state)const{
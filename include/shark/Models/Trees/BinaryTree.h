@@ -37,6 +37,7 @@
 
 
 #include <shark/Core/Exception.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Core/utility/functional.h>
 #include <shark/Core/utility/KeyValuePair.h>
 #include <shark/Models/Kernels/AbstractKernelFunction.h>
@@ -319,6 +320,14 @@ protected:
 	/// the same distance function is used in both cases.
 	virtual double funct(value_type const& point) const = 0;
 
+	/// \brief Minimum number of points in both sub-nodes for the
+	/// construction of a subtree to be spawned as a task of its own.
+	///
+	/// Subtrees work on disjoint slices of the index list, so they can
+	/// be built concurrently; below this size the overhead of task
+	/// creation outweighs the gain.
+	static const std::size_t SUBTREE_TASK_THRESHOLD = 4096;
+
 	/// \brief Split the data in the point list and calculate the treshold accordingly
 	///
 	/// The method computes the optimal threshold given the distance of every element of
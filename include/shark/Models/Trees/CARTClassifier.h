@@ -38,8 +38,9 @@
 
 #include <shark/Models/AbstractModel.h>
 #include <shark/ObjectiveFunctions/Loss/ZeroOneLoss.h>
-#include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>                                  
+#include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
 #include <shark/Data/Dataset.h>
+#include <cstdint>
 
 namespace shark {
 
@@ -124,18 +125,20 @@ public:
 	/// Constructor taking the tree as argument
 	explicit CARTClassifier(TreeType const& tree)
 			: m_tree(tree)
-	{ }
+	{ packTree(); }
 	explicit CARTClassifier(TreeType&& tree)
 			: m_tree(std::move(tree))
-	{ }
+	{ packTree(); }
 
 	/// Constructor taking the tree as argument and optimize it if requested
 	CARTClassifier(TreeType const& tree, bool optimize)
 	{
 		if (optimize)
 			setTree(tree);
-		else
+		else{
 			m_tree=tree;
+			packTree();
+		}
 	}
 
 	/// Constructor taking the tree as argument as well as maximum number of attributes
@@ -143,12 +146,14 @@ public:
 			: m_tree{tree}, m_inputDimension{d}
 	{
 		optimizeTree(m_tree);
+		packTree();
 	}
 
-	CARTClassifier(TreeType&& tree, std::size_t d) BOOST_NOEXCEPT_IF((std::is_nothrow_constructible<TreeType,TreeType>::value))
+	CARTClassifier(TreeType&& tree, std::size_t d)
 			: m_tree(std::move(tree)), m_inputDimension{d}
 	{
 		optimizeTree(m_tree);
+		packTree();
 	}
 
 	/// \brief From INameable: return the class name.
@@ -161,16 +166,42 @@ public:
 
 	using base_type::eval;
 	/// \brief Evaluate the Tree on a batch of patterns
+	///
+	/// The whole batch is routed through the packed tree level by level, so
+	/// the memory accesses of independent patterns overlap instead of every
+	/// pattern waiting for its own chain of node loads.
 	void eval(BatchInputType const& patterns, BatchOutputType & outputs) const{
 		std::size_t numPatterns = shark::size(patterns);
 		//evaluate the first pattern alone and create the batch output from that
 		LabelType const& firstResult = evalPattern(row(patterns,0));
 		outputs = Batch<LabelType>::createBatch(firstResult,numPatterns);
 		get(outputs,0) = firstResult;
-		
-		//evaluate the rest
-		for(std::size_t i = 0; i != numPatterns; ++i){
-			get(outputs,i) = evalPattern(row(patterns,i));
+
+		if(m_packedTree.empty()){
+			for(std::size_t i = 1; i != numPatterns; ++i){
+				get(outputs,i) = evalPattern(row(patterns,i));
+			}
+			return;
+		}
+
+		//advance all patterns one level per pass; finished patterns are
+		//removed from the active set
+		std::vector<std::uint32_t> node(numPatterns, 0);
+		std::vector<std::uint32_t> active(numPatterns);
+		for(std::size_t i = 0; i != numPatterns; ++i) active[i] = (std::uint32_t)i;
+		while(!active.empty()){
+			std::size_t out = 0;
+			for(auto const i : active){
+				PackedNode const& cur = m_packedTree[node[i]];
+				if(cur.attributeIndex == LEAF_NODE){
+					get(outputs,i) = m_packedLabels[cur.rightOrLabel];
+					continue;
+				}
+				node[i] = row(patterns,i)[cur.attributeIndex] <= cur.attributeValue?
+					node[i] + 1 : cur.rightOrLabel;
+				active[out++] = i;
+			}
+			active.resize(out);
 		}
 	}
 	
@@ -186,6 +217,7 @@ public:
 	void setTree(TreeType const& tree){
 		m_tree = tree;
 		optimizeTree(m_tree);
+		packTree();
 	}
 	
 	/// Get the model tree.
@@ -211,6 +243,7 @@ public:
 	/// from ISerializable, reads a model from an archive
 	void read(InArchive& archive){
 		archive >> m_tree;
+		packTree();
 	}
 
 	/// from ISerializable, writes a model to an archive
@@ -350,7 +383,54 @@ public:
 protected:
 	/// tree of the model
 	TreeType m_tree;
-	
+
+	/// \brief Compact node of the evaluation tree.
+	///
+	/// Only the data needed for a split decision is stored, 16 bytes per node
+	/// instead of the full NodeInfo. Nodes are laid out in preorder so the
+	/// left child of node i is node i+1 and only the right child needs an
+	/// index. A leaf is marked by attributeIndex == LEAF_NODE, in which case
+	/// rightOrLabel indexes into m_packedLabels.
+	struct PackedNode{
+		double attributeValue;
+		std::uint32_t attributeIndex;
+		std::uint32_t rightOrLabel;
+	};
+	static std::uint32_t const LEAF_NODE = 0xffffffffu;
+
+	/// contiguous preorder copy of m_tree used for evaluation
+	std::vector<PackedNode> m_packedTree;
+	/// labels of the leaves, indexed by PackedNode::rightOrLabel
+	std::vector<LabelType> m_packedLabels;
+
+	/// Rebuild the packed evaluation tree from m_tree. Must be called
+	/// whenever m_tree changes; expects the child ids to be indices into
+	/// m_tree, as produced by the tree builders and by optimizeTree.
+	void packTree(){
+		m_packedTree.clear();
+		m_packedLabels.clear();
+		if(m_tree.empty()) return;
+		m_packedTree.reserve(m_tree.size());
+		packNode(0);
+	}
+
+	/// Append the subtree rooted at node in preorder and return its position.
+	std::uint32_t packNode(std::size_t node){
+		std::uint32_t self = (std::uint32_t)m_packedTree.size();
+		m_packedTree.push_back(PackedNode());
+		if(m_tree[node].leftNodeId == 0){
+			m_packedTree[self].attributeIndex = LEAF_NODE;
+			m_packedTree[self].rightOrLabel = (std::uint32_t)m_packedLabels.size();
+			m_packedLabels.push_back(m_tree[node].label);
+		}else{
+			m_packedTree[self].attributeIndex = (std::uint32_t)m_tree[node].attributeIndex;
+			m_packedTree[self].attributeValue = m_tree[node].attributeValue;
+			packNode(m_tree[node].leftNodeId);//placed directly behind self
+			m_packedTree[self].rightOrLabel = packNode(m_tree[node].rightNodeId);
+		}
+		return self;
+	}
+
 	/// \brief Finds the index of the node with a certain nodeID in an unoptimized tree.
 	std::size_t findNode(std::size_t nodeId) const{
 		std::size_t index = 0;
@@ -375,6 +455,14 @@ protected:
 	/// Evaluate the CART tree on a single sample
 	template<class Vector>
 	LabelType const& evalPattern(Vector const& pattern) const{
+		if(!m_packedTree.empty()){
+			std::size_t node = 0;
+			while(m_packedTree[node].attributeIndex != LEAF_NODE){
+				node = pattern[m_packedTree[node].attributeIndex] <= m_packedTree[node].attributeValue?
+					node + 1 : m_packedTree[node].rightOrLabel;
+			}
+			return m_packedLabels[m_packedTree[node].rightOrLabel];
+		}
 		std::size_t nodeId = 0;
 		while(m_tree[nodeId].leftNodeId != 0){
 			if(pattern[m_tree[nodeId].attributeIndex]<= m_tree[nodeId].attributeValue){
@@ -0,0 +1,165 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Gradient Boosting Model
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+
+#ifndef SHARK_MODELS_TREES_GRADIENTBOOSTINGMODEL_H
+#define SHARK_MODELS_TREES_GRADIENTBOOSTINGMODEL_H
+
+#include <shark/Models/Trees/CARTClassifier.h>
+
+namespace shark {
+
+///
+/// \brief Additive ensemble of CART trees as produced by gradient boosting.
+///
+/// \par
+/// The model evaluates a constant offset plus the weighted sum of its trees,
+/// where each tree is an ordinary CARTClassifier with real vector leaves.
+/// In the regression case the output is the prediction itself; after training
+/// with the logistic loss the output is the log-odds of the positive class,
+/// so the decision is made by thresholding the output at zero.
+///
+class GradientBoostingModel : public AbstractModel<RealVector, RealVector>
+{
+private:
+	typedef AbstractModel<RealVector, RealVector> base_type;
+public:
+	using SubmodelType = CARTClassifier<RealVector>;
+
+	/// Constructor
+	GradientBoostingModel(){}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "GradientBoostingModel"; }
+
+	using base_type::eval;
+	void eval(BatchInputType const& patterns, BatchOutputType& outputs)const{
+		std::size_t numPatterns = shark::size(patterns);
+		outputs.resize(numPatterns, m_offset.size());
+		for(std::size_t i = 0; i != numPatterns; ++i){
+			noalias(row(outputs,i)) = m_offset;
+		}
+		for(std::size_t m = 0; m != m_trees.size(); ++m){
+			noalias(outputs) += m_weight[m] * m_trees[m](patterns);
+		}
+	}
+
+	void eval(BatchInputType const& patterns, BatchOutputType& outputs, State& state)const{
+		eval(patterns,outputs);
+	}
+
+	/// This model does not have any parameters.
+	RealVector parameterVector() const {
+		return RealVector();
+	}
+
+	/// This model does not have any parameters.
+	void setParameterVector(RealVector const& param) {
+		SHARK_ASSERT(param.size() == 0);
+	}
+
+	void read(InArchive& archive){
+		archive >> m_trees;
+		archive >> m_weight;
+		archive >> m_offset;
+	}
+	void write(OutArchive& archive)const{
+		archive << m_trees;
+		archive << m_weight;
+		archive << m_offset;
+	}
+
+	/// \brief Removes all trees and the offset from the ensemble
+	void clearModels(){
+		m_trees.clear();
+		m_weight.clear();
+		m_offset.clear();
+	}
+
+	/// \brief Adds a new tree to the ensemble.
+	///
+	/// \param model the new tree
+	/// \param weight weight of the tree, typically the shrinkage used in training
+	void addModel(SubmodelType const& model, double weight = 1.0){
+		m_trees.push_back(model);
+		m_weight.push_back(weight);
+	}
+
+	/// \brief Sets the constant offset the trees are added to.
+	void setOffset(RealVector const& offset){
+		m_offset = offset;
+	}
+
+	/// \brief Returns the constant offset the trees are added to.
+	RealVector const& offset() const{
+		return m_offset;
+	}
+
+	/// \brief Returns the weight of the i-th tree
+	double const& weight(std::size_t i)const{
+		return m_weight[i];
+	}
+
+	/// \brief Returns the number of trees.
+	std::size_t numberOfModels()const{
+		return m_trees.size();
+	}
+
+	///Return input dimension
+	std::size_t inputSize() const {
+		return m_inputDimension;
+	}
+
+	//Set input dimension
+	void setInputDimension(std::size_t d) {
+		m_inputDimension = d;
+	}
+
+protected:
+	/// collection of trees
+	std::vector<SubmodelType> m_trees;
+
+	/// weight of every tree
+	std::vector<double> m_weight;
+
+	/// constant offset; the prior prediction of the empty ensemble
+	RealVector m_offset;
+
+	///Number of attributes (set by trainer)
+	std::size_t m_inputDimension = 0;
+};
+
+
+}
+#endif
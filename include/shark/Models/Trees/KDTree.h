@@ -62,9 +62,13 @@ namespace shark {
 /// MedianAccuracy.
 ///
 /// \par
-/// The bucket size for the tree is aleays one,
+/// The default bucket size for the tree is one,
 /// such that there is a unique point in each leaf
-/// cell.
+/// cell. Larger buckets can be configured through
+/// the TreeConstruction object; the index lists of
+/// the leaves remain contiguous slices of one
+/// array, so the points of a bucket are scanned
+/// without further tree traversal.
 ///
 template <class InputT>
 class KDTree : public BinaryTree<InputT>
@@ -88,7 +92,11 @@ public:
 		std::vector<typename boost::range_iterator<PointSet>::type> elements(m_size);
 		boost::iota(elements,boost::begin(points));
 
-		buildTree(tc,elements);
+		//build the subtrees in parallel tasks when they are large enough
+		SHARK_PARALLEL_TASKREGION
+		{
+			buildTree(tc,elements);
+		}
 
 		//after the creation of the trees, the iterators in the array are sorted in the order, 
 		//they are referenced by the nodes.so we can create the indexList using the indizes of the iterators
@@ -227,11 +235,22 @@ protected:
 		mp_left = new KDTree(this, mp_indexList, leftSize);
 		mp_right = new KDTree(this, mp_indexList + leftSize, m_size - leftSize);
 
-		// recurse
+		// recurse. When both subtrees are large, the left subtree is built
+		// in a task of its own so that idle threads can pick it up.
 		boost::iterator_range<iterator> left(begin,split);
 		boost::iterator_range<iterator> right(split,end);
-		((KDTree*)mp_left)->buildTree(tc.nextDepthLevel(), left);
-		((KDTree*)mp_right)->buildTree(tc.nextDepthLevel(), right);
+		if (leftSize >= base_type::SUBTREE_TASK_THRESHOLD && m_size - leftSize >= base_type::SUBTREE_TASK_THRESHOLD){
+			SHARK_TASK
+			{
+				((KDTree*)mp_left)->buildTree(tc.nextDepthLevel(), left);
+			}
+			((KDTree*)mp_right)->buildTree(tc.nextDepthLevel(), right);
+			SHARK_TASK_WAIT
+		}
+		else{
+			((KDTree*)mp_left)->buildTree(tc.nextDepthLevel(), left);
+			((KDTree*)mp_right)->buildTree(tc.nextDepthLevel(), right);
+		}
 		m_nodes = 1 + mp_left->nodes() + mp_right->nodes();
 	}
 
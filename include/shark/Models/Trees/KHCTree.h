@@ -95,7 +95,11 @@ public:
 		std::vector<const_iterator> elements(m_size);
 		boost::iota(elements,const_iterator(boost::begin(points),0));
 
-		buildTree(tc,elements);
+		//build the subtrees in parallel tasks when they are large enough
+		SHARK_PARALLEL_TASKREGION
+		{
+			buildTree(tc,elements);
+		}
 
 		//after the creation of the trees, the iterators in the array are sorted in the order,
 		//they are referenced by the nodes.so we can create the indexList using the indizes of the iterators
@@ -187,11 +191,22 @@ protected:
 		mp_left = new KHCTree(this, mp_indexList, leftSize);
 		mp_right = new KHCTree(this, mp_indexList + leftSize, m_size - leftSize);
 
-		// recurse
+		// recurse. When both subtrees are large, the left subtree is built
+		// in a task of its own so that idle threads can pick it up.
 		boost::iterator_range<range_iterator> left(begin,split);
 		boost::iterator_range<range_iterator> right(split,end);
-		((KHCTree*)mp_left)->buildTree(tc.nextDepthLevel(),left);
-		((KHCTree*)mp_right)->buildTree(tc.nextDepthLevel(),right);
+		if (leftSize >= base_type::SUBTREE_TASK_THRESHOLD && m_size - leftSize >= base_type::SUBTREE_TASK_THRESHOLD){
+			SHARK_TASK
+			{
+				((KHCTree*)mp_left)->buildTree(tc.nextDepthLevel(),left);
+			}
+			((KHCTree*)mp_right)->buildTree(tc.nextDepthLevel(),right);
+			SHARK_TASK_WAIT
+		}
+		else{
+			((KHCTree*)mp_left)->buildTree(tc.nextDepthLevel(),left);
+			((KHCTree*)mp_right)->buildTree(tc.nextDepthLevel(),right);
+		}
 		m_nodes = 1 + mp_left->nodes() + mp_right->nodes();
 	}
 
@@ -97,8 +97,12 @@ public:
 		std::vector<iterator> elements(m_size);
 		boost::iota(elements,iterator(boost::begin(points),0));
 
-		buildTree(tc,elements);
-		//after the creation of the trees, the iterators in the array are sorted in the order, 
+		//build the subtrees in parallel tasks when they are large enough
+		SHARK_PARALLEL_TASKREGION
+		{
+			buildTree(tc,elements);
+		}
+		//after the creation of the trees, the iterators in the array are sorted in the order,
 		//they are referenced by the nodes.so we can create the indexList using the indizes of the iterators
 		for(std::size_t i = 0; i != m_size; ++i){
 			mp_indexList[i] = elements[i].index();
@@ -187,11 +191,22 @@ protected:
 		mp_left = new LCTree(this, mp_indexList, leftSize);
 		mp_right = new LCTree(this, mp_indexList + leftSize, m_size - leftSize);
 
-		// recurse
+		// recurse. When both subtrees are large, the left subtree is built
+		// in a task of its own so that idle threads can pick it up.
 		boost::iterator_range<iterator> left(begin,split);
 		boost::iterator_range<iterator> right(split,end);
-		((LCTree*)mp_left)->buildTree(tc.nextDepthLevel(),left);
-		((LCTree*)mp_right)->buildTree(tc.nextDepthLevel(),right);
+		if (leftSize >= base_type::SUBTREE_TASK_THRESHOLD && m_size - leftSize >= base_type::SUBTREE_TASK_THRESHOLD){
+			SHARK_TASK
+			{
+				((LCTree*)mp_left)->buildTree(tc.nextDepthLevel(),left);
+			}
+			((LCTree*)mp_right)->buildTree(tc.nextDepthLevel(),right);
+			SHARK_TASK_WAIT
+		}
+		else{
+			((LCTree*)mp_left)->buildTree(tc.nextDepthLevel(),left);
+			((LCTree*)mp_right)->buildTree(tc.nextDepthLevel(),right);
+		}
 		m_nodes = 1 + mp_left->nodes() + mp_right->nodes();
 	}
 
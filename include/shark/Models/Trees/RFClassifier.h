@@ -39,6 +39,7 @@
 #include <shark/Models/Trees/General.h>
 #include <shark/Models/MeanModel.h>
 #include <shark/Data/DataView.h>
+#include <shark/Core/OpenMP.h>
 
 namespace shark {
 
@@ -65,6 +66,26 @@ public:
 	std::string name() const
 	{ return "RFClassifier"; }
 
+	using MeanModel<CARTClassifier<RealVector> >::eval;
+	/// \brief Evaluate the forest on a batch of patterns, one thread per tree.
+	///
+	/// The trees are independent, so the batch is pushed through them in
+	/// parallel and only the accumulation of the votes is synchronized.
+	void eval(BatchInputType const& patterns, BatchOutputType& outputs)const{
+		m_models[0].eval(patterns, outputs);
+		outputs *= m_weight[0];
+		SHARK_PARALLEL_FOR(int i = 1; i < (int)m_models.size(); ++i){
+			RealMatrix treeOutputs = m_weight[i] * m_models[i](patterns);
+			SHARK_CRITICAL_REGION{
+				noalias(outputs) += treeOutputs;
+			}
+		}
+		outputs /= m_weightSum;
+	}
+	void eval(BatchInputType const& patterns, BatchOutputType& outputs, State&)const{
+		eval(patterns, outputs);
+	}
+
 	// compute the oob error for the forest
 	void computeOOBerror(
 			UIntMatrix const& oobClassTally,
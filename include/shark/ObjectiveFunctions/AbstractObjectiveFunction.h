@@ -40,6 +40,8 @@
 #include <shark/LinAlg/Base.h>
 #include <shark/ObjectiveFunctions/AbstractConstraintHandler.h>
 
+#include <vector>
+
 namespace shark {
 
 /// \brief Super class of all objective functions for optimization and learning.
@@ -99,6 +101,20 @@ public:
 		RealMatrix hessian;
 	};
 
+	/// \brief Sparse first order derivative stored as index/value pairs.
+	///
+	/// Objective functions whose gradient at a point touches only a few of the
+	/// variables - for example a minibatch error of a linear model over sparse
+	/// inputs - can return it in compressed form: indices holds the positions
+	/// of the nonzero entries in ascending order and values their derivative
+	/// values; all other coordinates are zero. Consumers like the stochastic
+	/// gradient descent optimizers then update only the listed coordinates
+	/// instead of streaming over the full parameter vector.
+	struct SparseFirstOrderDerivative {
+		std::vector<std::size_t> indices; ///< positions of the nonzero entries, ascending
+		std::vector<double> values; ///< derivative values of the listed positions
+	};
+
 	/// \brief List of features that are supported by an implementation.
 	enum Feature {
 		HAS_VALUE						 =  1, ///< The function can be evaluated and evalDerivative returns a meaningless value (for example std::numeric_limits<double>::quiet_nan()).
@@ -108,7 +124,8 @@ public:
 		IS_CONSTRAINED_FEATURE           =  16, ///< The objective function is constrained.
 		HAS_CONSTRAINT_HANDLER           =  32, ///< The constraints are governed by a constraint handler which can be queried by getConstraintHandler()
 		CAN_PROVIDE_CLOSEST_FEASIBLE     = 64,	///< If the function is constrained, the method closestFeasible is implemented and returns a "repaired" solution.
-		IS_THREAD_SAFE     = 128	///< can eval or evalDerivative be called in parallel?
+		IS_THREAD_SAFE     = 128,	///< can eval or evalDerivative be called in parallel?
+		HAS_SPARSE_FIRST_DERIVATIVE = 256 ///< The method evalSparseDerivative is implemented and returns the gradient as index/value pairs.
 	};
 
 	/// This statement declares the member m_features. See Core/Flags.h for details.
@@ -128,6 +145,11 @@ public:
 	bool hasSecondDerivative()const{
 		return m_features & HAS_SECOND_DERIVATIVE;
 	}
+
+	/// \brief returns whether this function can calculate the first derivative in sparse form
+	bool hasSparseFirstDerivative()const{
+		return m_features & HAS_SPARSE_FIRST_DERIVATIVE;
+	}
 	
 	/// \brief returns whether this function can propose a starting point.
 	bool canProposeStartingPoint()const{
@@ -257,6 +279,21 @@ public:
 		return eval(input);
 	}
 
+	/// \brief Evaluates the objective function for a batch of arguments.
+	///
+	/// The default implementation evaluates one point after the other. For cheap
+	/// functions, most notably the benchmark suite, the per-point call overhead
+	/// dominates the actual arithmetic, so these functions override the batch
+	/// evaluation with a single tight loop.
+	///
+	/// \param [in] batch The set of points for which the function shall be evaluated.
+	/// \param [out] values The value of the function for every point of the batch.
+	virtual void evalBatch( std::vector<SearchPointType> const& batch, std::vector<ResultType>& values )const {
+		values.resize(batch.size());
+		for(std::size_t i = 0; i != batch.size(); ++i)
+			values[i] = eval(batch[i]);
+	}
+
 	/// \brief Evaluates the objective function and calculates its gradient.
 	/// \param [in] input The argument to eval the function for.
 	/// \param [out] derivative The derivate is placed here.
@@ -277,6 +314,21 @@ public:
 		SHARK_FEATURE_EXCEPTION(HAS_SECOND_DERIVATIVE);
 	}
 
+	/// \brief Evaluates the objective function and calculates its gradient in sparse form.
+	///
+	/// The gradient is returned as index/value pairs of its nonzero entries,
+	/// which avoids materializing a dense vector when the function only
+	/// touches a few variables per evaluation.
+	///
+	/// \param [in] input The argument to eval the function for.
+	/// \param [out] derivative The nonzero entries of the derivative are placed here.
+	/// \return The result of evaluating the function for the supplied argument.
+	/// \throws FeatureNotAvailableException in the default implementation
+	/// and if a function does not support this feature.
+	virtual ResultType evalSparseDerivative( SearchPointType const& input, SparseFirstOrderDerivative & derivative )const {
+		SHARK_FEATURE_EXCEPTION(HAS_SPARSE_FIRST_DERIVATIVE);
+	}
+
 protected:
 	mutable std::size_t m_evaluationCounter; ///< Evaluation counter, default value: 0.
 	AbstractConstraintHandler<SearchPointType> const* m_constraintHandler;
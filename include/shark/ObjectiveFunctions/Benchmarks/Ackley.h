@@ -90,6 +90,26 @@ struct Ackley : public SingleObjectiveFunction {
 
 		return -A * std::exp(-B * std::sqrt(a / n)) - std::exp(b / n) + A + M_E;
 	}
+
+	void evalBatch(std::vector<SearchPointType> const& batch, std::vector<double>& values) const {
+		m_evaluationCounter += batch.size();
+
+		const double A = 20.;
+		const double B = 0.2;
+		const double C = 2* M_PI;
+
+		values.resize(batch.size());
+		for (std::size_t j = 0; j != batch.size(); ++j) {
+			SearchPointType const& p = batch[j];
+			std::size_t n = p.size();
+			double a = 0., b = 0.;
+			for (std::size_t i = 0; i < n; ++i) {
+				a += p(i) * p(i);
+				b += cos(C * p(i));
+			}
+			values[j] = -A * std::exp(-B * std::sqrt(a / n)) - std::exp(b / n) + A + M_E;
+		}
+	}
 private:
 	std::size_t m_numberOfVariables;
 };
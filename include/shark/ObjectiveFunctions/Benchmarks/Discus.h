@@ -81,6 +81,19 @@ struct Discus : public SingleObjectiveFunction {
 
 		return sum;
 	}
+
+	void evalBatch(std::vector<SearchPointType> const& batch, std::vector<double>& values) const {
+		m_evaluationCounter += batch.size();
+		values.resize(batch.size());
+		for (std::size_t j = 0; j != batch.size(); ++j) {
+			SearchPointType const& p = batch[j];
+			double sum =  sqr(p(0));
+			for (std::size_t i = 1; i < p.size(); i++)
+				sum += m_alpha * sqr(p(i));
+			values[j] = sum;
+		}
+	}
+
 	double evalDerivative(SearchPointType const& p, FirstOrderDerivative & derivative ) const {
 		derivative.resize(p.size());
 		noalias(derivative) = (2 * m_alpha) * p;
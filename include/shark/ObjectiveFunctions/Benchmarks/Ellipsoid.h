@@ -85,6 +85,20 @@ struct Ellipsoid : public SingleObjectiveFunction {
 		return sum;
 	}
 
+	void evalBatch( std::vector<SearchPointType> const& batch, std::vector<double>& values ) const {
+		m_evaluationCounter += batch.size();
+		values.resize(batch.size());
+		for( std::size_t j = 0; j != batch.size(); ++j ){
+			SearchPointType const& p = batch[j];
+			double sum = 0;
+			double sizeMinusOne = p.size() - 1.;
+			for( std::size_t i = 0; i < p.size(); i++ ){
+				sum += ::pow( m_alpha, i / sizeMinusOne ) * sqr(p( i ) );
+			}
+			values[j] = sum;
+		}
+	}
+
 	double evalDerivative( const SearchPointType & p, FirstOrderDerivative & derivative ) const {
 		double sizeMinusOne=p.size() - 1.;
 		derivative.resize(p.size());
@@ -106,6 +106,19 @@ struct Rosenbrock : public SingleObjectiveFunction {
 		return( sum );
 	}
 
+	void evalBatch( std::vector<SearchPointType> const& batch, std::vector<double>& values ) const {
+		m_evaluationCounter += batch.size();
+		values.resize(batch.size());
+		for( std::size_t j = 0; j != batch.size(); ++j ){
+			SearchPointType const& p = batch[j];
+			double sum = 0;
+			for( std::size_t i = 0; i < p.size()-1; i++ ) {
+				sum += 100*sqr( p(i+1) - sqr( p( i ) ) ) +sqr( 1. - p( i ) );
+			}
+			values[j] = sum;
+		}
+	}
+
 	virtual ResultType evalDerivative( const SearchPointType & p, FirstOrderDerivative & derivative )const {
 		double result = eval(p);
 		size_t size = p.size();
@@ -75,6 +75,15 @@ struct Sphere : public SingleObjectiveFunction {
 		m_evaluationCounter++;
 		return norm_sqr(x);
 	}
+
+	void evalBatch(std::vector<SearchPointType> const& batch, std::vector<double>& values) const {
+		m_evaluationCounter += batch.size();
+		values.resize(batch.size());
+		for(std::size_t i = 0; i != batch.size(); ++i){
+			SIZE_CHECK(batch[i].size() == numberOfVariables());
+			values[i] = norm_sqr(batch[i]);
+		}
+	}
 	
 	double evalDerivative(SearchPointType const& x, FirstOrderDerivative& derivative) const {
 		SIZE_CHECK(x.size() == numberOfVariables());
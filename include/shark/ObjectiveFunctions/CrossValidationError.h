@@ -1,35 +1,35 @@
 //===========================================================================
-/*!
- * 
- *
+/*!
+ * 
+ *
  * \brief       cross-validation error for selection of hyper-parameters
 
 
- * 
- *
+ * 
+ *
  * \author      T. Glasmachers, O. Krause
- * \date        2007-2012
- *
- *
- * \par Copyright 1995-2017 Shark Development Team
- * 
- * <BR><HR>
- * This file is part of Shark.
- * <http://shark-ml.org/>
- * 
- * Shark is free software: you can redistribute it and/or modify
- * it under the terms of the GNU Lesser General Public License as published 
- * by the Free Software Foundation, either version 3 of the License, or
- * (at your option) any later version.
- * 
- * Shark is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- * GNU Lesser General Public License for more details.
- * 
- * You should have received a copy of the GNU Lesser General Public License
- * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
- *
+ * \date        2007-2012
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ * 
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ * 
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published 
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ * 
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
  */
 //===========================================================================
 
@@ -41,6 +41,7 @@
 #include <shark/Algorithms/AbstractSingleObjectiveOptimizer.h>
 #include <shark/ObjectiveFunctions/AbstractCost.h>
 #include <shark/Data/CVDatasetTools.h>
+#include <shark/Core/OpenMP.h>
 
 namespace shark {
 
@@ -89,6 +90,8 @@ private:
 	ModelType* mep_model;
 	TrainerType* mep_trainer;
 	CostType* mep_cost;
+	std::vector<IParameterizable*> m_foldMetas;
+	std::vector<TrainerType*> m_foldTrainers;
 
 public:
 
@@ -118,6 +121,25 @@ public:
 		return mep_meta->numberOfParameters();
 	}
 
+	/// \brief Enable parallel training of the folds.
+	///
+	/// Training and evaluation of the folds is independent, so the folds
+	/// can be processed by concurrent OpenMP threads. As trainers can not
+	/// be copied through their abstract interface, the caller provides one
+	/// trainer clone per fold, each paired with the IParameterizable object
+	/// through which its hyper-parameters are set - in the typical setup
+	/// where the trainer plays both roles this is the clone itself. Each
+	/// fold then trains its own copy of the model with its own trainer.
+	void enableParallelFolds(
+		std::vector<IParameterizable*> const& foldMetas,
+		std::vector<TrainerType*> const& foldTrainers
+	){
+		SHARK_CHECK(foldMetas.size() == m_folds.size(), "[CrossValidationError::enableParallelFolds] one meta object per fold is required");
+		SHARK_CHECK(foldTrainers.size() == m_folds.size(), "[CrossValidationError::enableParallelFolds] one trainer per fold is required");
+		m_foldMetas = foldMetas;
+		m_foldTrainers = foldTrainers;
+	}
+
 	/// Evaluate the cross-validation error:
 	/// train sub-models, evaluate objective,
 	/// return the average.
@@ -125,6 +147,23 @@ public:
 		this->m_evaluationCounter++;
 		mep_meta->setParameterVector(parameters);
 
+		if(!m_foldTrainers.empty()){
+			//parallel path: every fold trains its own copy of the
+			//model with its own trainer, so no state is shared
+			for(std::size_t setID = 0; setID != m_folds.size(); ++setID)
+				m_foldMetas[setID]->setParameterVector(parameters);
+			RealVector costs(m_folds.size());
+			SHARK_PARALLEL_FOR(int setID = 0; setID < (int)m_folds.size(); ++setID){
+				DatasetType train = m_folds.training(setID);
+				DatasetType validation = m_folds.validation(setID);
+				ModelType model(*mep_model);
+				m_foldTrainers[setID]->train(model, train);
+				Data<OutputType> output = model(validation.inputs());
+				costs(setID) = mep_cost->eval(validation.labels(), output);
+			}
+			return sum(costs) / m_folds.size();
+		}
+
 		double ret = 0.0;
 		for (size_t setID=0; setID != m_folds.size(); ++setID) {
 			DatasetType train =  m_folds.training(setID);
@@ -0,0 +1,191 @@
+/*!
+ *
+ *
+ * \brief       Data-parallel error function with pluggable gradient aggregation
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_OBJECTIVEFUNCTIONS_DATAPARALLELERRORFUNCTION_H
+#define SHARK_OBJECTIVEFUNCTIONS_DATAPARALLELERRORFUNCTION_H
+
+#include <shark/ObjectiveFunctions/ErrorFunction.h>
+
+namespace shark{
+
+/// \brief Interface for summing gradient partial sums over a group of workers.
+///
+/// In data-parallel training every worker holds a shard of the dataset and
+/// computes the partial sums of the error and its gradient over its own shard.
+/// A reducer combines these partial sums so that every worker ends up with the
+/// totals of the whole group - the collective known as an all-reduce. The
+/// partial sums are handed over as one contiguous buffer of doubles, so an
+/// implementation backed by a network transport needs exactly one exchange per
+/// optimization step and no serialization of its own: an MPI implementation
+/// maps allSum to a single in-place MPI_Allreduce with MPI_SUM over the buffer.
+class AbstractGradientReducer : public INameable{
+public:
+	virtual ~AbstractGradientReducer(){}
+
+	/// \brief Replaces the buffer by its elementwise sum over all workers.
+	///
+	/// Every worker of the group must call allSum with a buffer of the same
+	/// length; the call returns once the buffer holds the group-wide sums.
+	virtual void allSum(double* buffer, std::size_t length) const = 0;
+
+	/// \brief Returns the number of workers in the group.
+	virtual std::size_t numberOfWorkers() const = 0;
+};
+
+/// \brief Reference reducer for a single process: there is nothing to exchange.
+///
+/// With a single worker the local partial sums already are the totals, so
+/// allSum leaves the buffer untouched. Useful for running the same training
+/// code with and without distribution.
+class LocalGradientReducer : public AbstractGradientReducer{
+public:
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "LocalGradientReducer"; }
+
+	void allSum(double*, std::size_t) const{}
+
+	std::size_t numberOfWorkers() const{
+		return 1;
+	}
+};
+
+///
+/// \brief Error function over a dataset sharded across a group of workers.
+///
+/// \par
+/// Every worker constructs a DataParallelErrorFunction over its local shard of
+/// the data and all workers share a reducer. Evaluating the function computes
+/// the error - and in evalDerivative the gradient - over the local shard only
+/// and then combines the partial sums of all shards through the reducer, so
+/// every worker observes the exact error and gradient of the full dataset.
+/// Gradient based optimizers like LBFGS or SteepestDescent therefore drive
+/// multi-worker training without knowing about the distribution, as long as
+/// all workers perform the same sequence of evaluations.
+///
+/// \par
+/// The partial sums are weighted by the number of local points, so the shards
+/// may have different sizes; the combined value is the mean over all points of
+/// the group exactly as if a single ErrorFunction had seen the whole dataset.
+/// Weight, value and gradient travel in one packed buffer through a single
+/// allSum call per step. A regularizer is added after the reduction, so it
+/// enters the objective once and not once per worker.
+///
+class DataParallelErrorFunction : public SingleObjectiveFunction
+{
+public:
+	/// \brief Constructor.
+	///
+	/// \param shard the local shard of the dataset
+	/// \param model the model whose parameters are optimized
+	/// \param loss the loss evaluated on the model predictions
+	/// \param reducer the reducer shared by all workers of the group
+	template<class InputType, class LabelType, class OutputType>
+	DataParallelErrorFunction(
+		LabeledData<InputType, LabelType> const& shard,
+		AbstractModel<InputType,OutputType>* model,
+		AbstractLoss<LabelType, OutputType>* loss,
+		AbstractGradientReducer const* reducer
+	): m_localError(shard,model,loss)
+	, m_localWeight((double)shard.numberOfElements())
+	, mep_reducer(reducer)
+	, m_regularizer(NULL)
+	, m_regularizationStrength(0){
+		SHARK_CHECK(reducer != NULL, "[DataParallelErrorFunction] reducer must not be NULL");
+		m_features |= HAS_VALUE;
+		if(m_localError.hasFirstDerivative())
+			m_features |= HAS_FIRST_DERIVATIVE;
+		if(m_localError.canProposeStartingPoint())
+			m_features |= CAN_PROPOSE_STARTING_POINT;
+	}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "DataParallelErrorFunction"; }
+
+	void setRegularizer(double factor, SingleObjectiveFunction* regularizer){
+		m_regularizer = regularizer;
+		m_regularizationStrength = factor;
+	}
+
+	SearchPointType proposeStartingPoint()const{
+		return m_localError.proposeStartingPoint();
+	}
+	std::size_t numberOfVariables()const{
+		return m_localError.numberOfVariables();
+	}
+
+	double eval(RealVector const& input) const{
+		m_evaluationCounter++;
+		//pack the local weight and the weighted partial error
+		double buffer[2] = {m_localWeight, m_localWeight*m_localError.eval(input)};
+		mep_reducer->allSum(buffer,2);
+		double value = buffer[1]/buffer[0];
+		if(m_regularizer)
+			value += m_regularizationStrength*m_regularizer->eval(input);
+		return value;
+	}
+
+	ResultType evalDerivative( const SearchPointType & input, FirstOrderDerivative & derivative ) const{
+		m_evaluationCounter++;
+		FirstOrderDerivative localDerivative;
+		double localValue = m_localError.evalDerivative(input,localDerivative);
+
+		//pack weight, weighted partial error and weighted partial gradient
+		//into one contiguous buffer - one exchange per optimization step
+		RealVector buffer(localDerivative.size()+2);
+		buffer(0) = m_localWeight;
+		buffer(1) = m_localWeight*localValue;
+		noalias(subrange(buffer,2,buffer.size())) = m_localWeight*localDerivative;
+		mep_reducer->allSum(&buffer(0),buffer.size());
+
+		double totalWeight = buffer(0);
+		derivative.resize(localDerivative.size());
+		noalias(derivative) = subrange(buffer,2,buffer.size())/totalWeight;
+		double value = buffer(1)/totalWeight;
+		if(m_regularizer){
+			FirstOrderDerivative regularizerDerivative;
+			value += m_regularizationStrength*m_regularizer->evalDerivative(input,regularizerDerivative);
+			noalias(derivative) += m_regularizationStrength*regularizerDerivative;
+		}
+		return value;
+	}
+
+private:
+	ErrorFunction m_localError;              ///< error function over the local shard
+	double m_localWeight;                    ///< number of points of the local shard
+	AbstractGradientReducer const* mep_reducer; ///< reducer shared by all workers
+	SingleObjectiveFunction* m_regularizer;
+	double m_regularizationStrength;
+};
+
+}
+#endif
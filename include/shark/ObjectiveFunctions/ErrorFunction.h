@@ -57,15 +57,32 @@ namespace shark{
 ///\par
 /// It automatically infers the input und label type from the given dataset and the output type
 /// of the model in the constructor and ensures that Model and loss match. Thus the user does
-/// not need to provide the types as template parameters. 
+/// not need to provide the types as template parameters.
+///
+///\par
+/// By default, every evaluation processes the full dataset. Setting minibatchBatches
+/// to a value m > 0 turns the function into a minibatch estimate: every call to eval
+/// or evalDerivative only processes the next m batches of the dataset, so gradient
+/// based optimizers like SteepestDescent perform stochastic gradient descent. The
+/// batches are sampled without replacement - they are visited in a random order which
+/// is reshuffled once all batches have been seen - so that every point contributes
+/// exactly once per epoch, which gives a lower variance than drawing batches
+/// independently.
+///
+///\par
+/// In minibatch mode the gradient is additionally available in sparse
+/// index/value form through evalSparseDerivative. Stochastic gradient
+/// optimizers like AdaGrad and Adam consume it to update only the touched
+/// coordinates, which pays off for sparse inputs and large parameter vectors.
 class ErrorFunction : public SingleObjectiveFunction
 {
 public:
 	template<class InputType, class LabelType, class OutputType>
 	ErrorFunction(
 		LabeledData<InputType, LabelType> const& dataset,
-		AbstractModel<InputType,OutputType>* model, 
-		AbstractLoss<LabelType, OutputType>* loss
+		AbstractModel<InputType,OutputType>* model,
+		AbstractLoss<LabelType, OutputType>* loss,
+		std::size_t minibatchBatches = 0
 	);
 	template<class InputType, class LabelType, class OutputType>
 	ErrorFunction(
@@ -82,6 +99,8 @@ public:
 	void setRegularizer(double factor, SingleObjectiveFunction* regularizer){
 		m_regularizer = regularizer;
 		m_regularizationStrength = factor;
+		//regularizer gradients are dense, so the sparse form is no longer available
+		m_features.reset(HAS_SPARSE_FIRST_DERIVATIVE);
 	}
 
 	SearchPointType proposeStartingPoint()const {
@@ -93,7 +112,8 @@ public:
 
 	double eval(RealVector const& input) const;
 	ResultType evalDerivative( const SearchPointType & input, FirstOrderDerivative & derivative ) const;
-	
+	ResultType evalSparseDerivative( const SearchPointType & input, SparseFirstOrderDerivative & derivative ) const;
+
 	friend void swap(ErrorFunction& op1, ErrorFunction& op2);
 
 private:
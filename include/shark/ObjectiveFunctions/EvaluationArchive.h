@@ -37,7 +37,8 @@
 
 #include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
 
-#include <set>
+#include <list>
+#include <unordered_map>
 #include <string>
 #include <sstream>
 
@@ -52,11 +53,19 @@ namespace shark {
 /// \tparam ResultT The objective space the function is defined upon.
 ///
 /// \par
-/// The EvaluationArchive class serves as an archive of all evaluated
+/// The EvaluationArchive class serves as an archive of evaluated
 /// points and the corresponding result. It can be used transparently
 /// instead of the original objective function, e.g., by an optimizer.
-/// Point/result pairs are added to the archive only if the specific
-/// combination is not yet stored.
+/// The archive doubles as a memoization cache: evaluating a point
+/// which is already stored returns the stored result without calling
+/// the wrapped objective function again. This assumes a deterministic
+/// objective function.
+///
+/// \par
+/// The pairs are kept in a hash indexed list ordered by recency of
+/// use. By default the archive grows without bound; setting a capacity
+/// bounds the memory consumption by dropping the least recently used
+/// pair whenever the bound is exceeded.
 ///
 /// \par
 /// For fast-to-evaluate objective functions the archive wrapper can
@@ -89,31 +98,11 @@ public:
 		, result(other.result)
 		{ }
 
-		// Comparison is based on string representation.
-		// This is a hack, but it is quite generic.
-		// And a generic solution is needed for std::set.
-		bool operator == (PointResultPairType const& other) const
-		{
-			return (toString() == other.toString());
-		}
-		bool operator < (PointResultPairType const& other) const
-		{
-			return (toString() < other.toString());
-		}
-
 		SearchPointType point;
 		ResultType result;
-
-	private:
-		std::string toString() const
-		{
-			std::stringstream ss;
-			ss << point << " " << result;
-			return ss.str();
-		}
 	};
 
-	typedef std::set<PointResultPairType> PointResultPairContainer;
+	typedef std::list<PointResultPairType> PointResultPairContainer;
 	typedef typename PointResultPairContainer::iterator PointResultPairIterator;
 	typedef typename PointResultPairContainer::const_iterator PointResultPairConstIterator;
 
@@ -125,6 +114,7 @@ public:
 	/// life time exceeds the life time of the present instance.
 	EvaluationArchive(base_type* objective)
 	: mep_objective(objective)
+	, m_capacity(0)
 	{
 		base_type::m_features = mep_objective->features();
 		base_type::m_constraintHandler = mep_objective->hasConstraintHandler() ? &mep_objective->getConstraintHandler() : NULL;
@@ -176,11 +166,22 @@ public:
 	}
 
 	/// \brief Wrapper function storing point and result.
+	///
+	/// If the point is already stored, the stored result is returned
+	/// without evaluating the wrapped objective function.
 	ResultType eval(const SearchPointType& input) const
 	{
+		std::string key = pointKey(input);
+		typename IndexType::iterator pos = m_index.find(key);
+		if (pos != m_index.end())
+		{
+			// cache hit: move the pair to the front of the recency list
+			m_archive.splice(m_archive.begin(), m_archive, pos->second);
+			return pos->second->result;
+		}
 		ResultType r = mep_objective->eval(input);
 		base_type::m_evaluationCounter++;
-		m_archive.insert(PointResultPairType(input, r));
+		store(input, r, key);
 		return r;
 	}
 
@@ -191,20 +192,28 @@ public:
 	{ return eval(input); }
 
 	/// \brief Wrapper function storing point and result.
+	///
+	/// The derivative is always computed by the wrapped objective
+	/// function, only the result is stored in the archive.
 	ResultType evalDerivative(const SearchPointType& input, FirstOrderDerivative& derivative) const
 	{
 		ResultType r = mep_objective->evalDerivative(input, derivative);
 		base_type::m_evaluationCounter++;
-		m_archive.insert(PointResultPairType(input, r));
+		std::string key = pointKey(input);
+		if (m_index.find(key) == m_index.end()) store(input, r, key);
 		return r;
 	}
 
 	/// \brief Wrapper function storing point and result.
+	///
+	/// The derivative is always computed by the wrapped objective
+	/// function, only the result is stored in the archive.
 	ResultType evalDerivative(const SearchPointType& input, SecondOrderDerivative& derivative) const
 	{
 		ResultType r = mep_objective->evalDerivative(input, derivative);
 		base_type::m_evaluationCounter++;
-		m_archive.insert(PointResultPairType(input, r));
+		std::string key = pointKey(input);
+		if (m_index.find(key) == m_index.end()) store(input, r, key);
 		return r;
 	}
 
@@ -217,6 +226,19 @@ public:
 	std::size_t size() const
 	{ return m_archive.size(); }
 
+	/// \brief Returns the maximum number of stored pairs, 0 means unbounded.
+	std::size_t capacity() const
+	{ return m_capacity; }
+
+	/// \brief Sets the maximum number of stored pairs, 0 means unbounded.
+	///
+	/// When the bound is exceeded, the least recently used pair is dropped.
+	void setCapacity(std::size_t capacity)
+	{
+		m_capacity = capacity;
+		while (m_capacity > 0 && m_archive.size() > m_capacity) dropLeastRecentlyUsed();
+	}
+
 	/// Begin iterator to the point/result pairs.
 	PointResultPairIterator begin()
 	{ return m_archive.begin(); }
@@ -234,8 +256,37 @@ public:
 	{ return m_archive.end(); }
 
 private:
+	typedef std::unordered_map<std::string, PointResultPairIterator> IndexType;
+
+	// The key is based on the string representation of the point.
+	// This is a hack, but it is quite generic. And a generic solution
+	// is needed for hashing arbitrary search space types.
+	std::string pointKey(SearchPointType const& point) const
+	{
+		std::stringstream ss;
+		ss << point;
+		return ss.str();
+	}
+
+	/// insert a new pair at the front of the recency list
+	void store(SearchPointType const& point, ResultType const& result, std::string const& key) const
+	{
+		m_archive.push_front(PointResultPairType(point, result));
+		m_index[key] = m_archive.begin();
+		if (m_capacity > 0 && m_archive.size() > m_capacity) dropLeastRecentlyUsed();
+	}
+
+	/// drop the pair at the back of the recency list
+	void dropLeastRecentlyUsed() const
+	{
+		m_index.erase(pointKey(m_archive.back().point));
+		m_archive.pop_back();
+	}
+
 	base_type* mep_objective;                     ///< objective function to be wrapped
-	mutable PointResultPairContainer m_archive;   ///< evaluated point/result pairs
+	std::size_t m_capacity;                       ///< maximum number of stored pairs, 0 means unbounded
+	mutable PointResultPairContainer m_archive;   ///< evaluated point/result pairs, most recently used first
+	mutable IndexType m_index;                    ///< hash index of the stored pairs by point
 };
 
 
@@ -29,6 +29,10 @@
 #define SHARK_OBJECTIVEFUNCTIONS_IMPL_ERRORFUNCTION_INL
 
 #include <shark/Core/OpenMP.h>
+#include <shark/Rng/DiscreteUniform.h>
+
+#include <algorithm>
+#include <numeric>
 
 namespace shark{
 namespace detail{
@@ -69,9 +73,28 @@ public:
 	double eval(RealVector const& input) const {
 		mep_model->setParameterVector(input);
 
-		return evalPointSet();
+		//when no derivative can be computed, the forward state is of no use
+		if(!(m_features & HAS_FIRST_DERIVATIVE))
+			return evalPointSet();
+
+		//run the forward pass and keep the per-batch predictions and model
+		//states around. A following evalDerivative for the same point can then
+		//skip the forward pass and go directly to the backward pass, which
+		//avoids recomputing intermediate values the forward pass already produced.
+		std::size_t dataSize = m_dataset.numberOfElements();
+		std::size_t numBatches = m_dataset.numberOfBatches();
+		m_cachedPredictions.resize(numBatches);
+		m_cachedStates.resize(numBatches);
+		double error = 0.0;
+		for(std::size_t b = 0; b != numBatches; ++b){
+			m_cachedStates[b] = mep_model->createState();
+			mep_model->eval(m_dataset.batch(b).input, m_cachedPredictions[b], *m_cachedStates[b]);
+			error += mep_loss->eval(m_dataset.batch(b).label, m_cachedPredictions[b]);
+		}
+		m_cachedPoint = input;
+		return error/dataSize;
 	}
-	
+
 	double evalPointSet() const {
 		std::size_t dataSize = m_dataset.numberOfElements();
 		typename Batch<OutputType>::type prediction;
@@ -85,6 +108,9 @@ public:
 
 	ResultType evalDerivative( SearchPointType const& point, FirstOrderDerivative& derivative ) const {
 		mep_model->setParameterVector(point);
+		//reuse the forward pass when the point was just evaluated
+		if(m_cachedPoint.size() == point.size() && norm_inf(point - m_cachedPoint) == 0.0)
+			return evalDerivativeFromCache(derivative);
 		return evalDerivativePointSet(derivative);
 	}
 	
@@ -116,9 +142,164 @@ public:
 	}
 
 private:
+	///\brief Backward pass reusing the predictions and model states cached by eval().
+	ResultType evalDerivativeFromCache( FirstOrderDerivative & derivative ) const {
+		std::size_t dataSize = m_dataset.numberOfElements();
+		derivative.resize(mep_model->numberOfParameters());
+		derivative.clear();
+
+		RealVector dataGradient(mep_model->numberOfParameters());
+		typename Batch<OutputType>::type errorDerivative;
+
+		double error=0.0;
+		for(std::size_t b = 0; b != m_dataset.numberOfBatches(); ++b){
+			auto const& batch = m_dataset.batch(b);
+			// calculate error derivative of the loss function from the cached prediction
+			error += mep_loss->evalDerivative(batch.label, m_cachedPredictions[b],errorDerivative);
+
+			//calculate the gradient using the chain rule and the cached forward state
+			mep_model->weightedParameterDerivative(batch.input,errorDerivative,*m_cachedStates[b],dataGradient);
+			derivative+=dataGradient;
+		}
+		error /= dataSize;
+		derivative /= double(dataSize);
+		return error;
+	}
+
 	AbstractModel<InputType, OutputType>* mep_model;
 	AbstractLoss<LabelType, OutputType>* mep_loss;
 	LabeledData<InputType, LabelType> m_dataset;
+
+	mutable SearchPointType m_cachedPoint; ///< parameter vector the forward cache belongs to, empty if none
+	mutable std::vector<typename Batch<OutputType>::type> m_cachedPredictions; ///< per-batch model outputs of the last eval
+	mutable std::vector<boost::shared_ptr<State> > m_cachedStates; ///< per-batch forward states of the last eval
+};
+
+
+///\brief Implementation of the ErrorFunction evaluating a minibatch of the data per call.
+///
+/// Every evaluation processes the next few batches of the dataset following a random
+/// schedule. The schedule visits every batch exactly once before it is reshuffled, so
+/// the batches are sampled without replacement over an epoch.
+template<class InputType, class LabelType,class OutputType>
+class MinibatchErrorFunctionImpl:public FunctionWrapperBase{
+public:
+	MinibatchErrorFunctionImpl(
+		LabeledData<InputType, LabelType> const& dataset,
+		AbstractModel<InputType,OutputType>* model,
+		AbstractLoss<LabelType, OutputType>* loss,
+		std::size_t numBatches
+	):mep_model(model),mep_loss(loss),m_dataset(dataset)
+	,m_numBatches(std::min(numBatches,dataset.numberOfBatches()))
+	,m_schedule(dataset.numberOfBatches())
+	,m_position(dataset.numberOfBatches()){//schedule is shuffled on first use
+		SHARK_ASSERT(model!=NULL);
+		SHARK_ASSERT(loss!=NULL);
+		std::iota(m_schedule.begin(),m_schedule.end(),std::size_t(0));
+
+		if(mep_model->hasFirstParameterDerivative() && mep_loss->hasFirstDerivative()){
+			m_features|=HAS_FIRST_DERIVATIVE;
+			m_features|=HAS_SPARSE_FIRST_DERIVATIVE;
+		}
+		m_features|=CAN_PROPOSE_STARTING_POINT;
+	}
+
+	std::string name() const
+	{ return ""; }
+
+	SearchPointType proposeStartingPoint() const{
+		return mep_model->parameterVector();
+	}
+
+	std::size_t numberOfVariables() const{
+		return mep_model->numberOfParameters();
+	}
+
+	FunctionWrapperBase* clone()const{
+		return new MinibatchErrorFunctionImpl<InputType,LabelType,OutputType>(*this);
+	}
+
+	double eval(RealVector const& input) const {
+		mep_model->setParameterVector(input);
+
+		typename Batch<OutputType>::type prediction;
+		double error = 0.0;
+		std::size_t numElements = 0;
+		for(std::size_t i = 0; i != m_numBatches; ++i){
+			auto const& batch = m_dataset.batch(nextBatch());
+			mep_model->eval(batch.input, prediction);
+			error += mep_loss->eval(batch.label, prediction);
+			numElements += shark::size(batch);
+		}
+		return error/numElements;
+	}
+
+	ResultType evalDerivative( SearchPointType const& point, FirstOrderDerivative& derivative ) const {
+		mep_model->setParameterVector(point);
+		derivative.resize(mep_model->numberOfParameters());
+		derivative.clear();
+
+		typename Batch<OutputType>::type prediction;
+		RealVector dataGradient(mep_model->numberOfParameters());
+		typename Batch<OutputType>::type errorDerivative;
+
+		double error=0.0;
+		std::size_t numElements = 0;
+		boost::shared_ptr<State> state = mep_model->createState();
+		for(std::size_t i = 0; i != m_numBatches; ++i){
+			auto const& batch = m_dataset.batch(nextBatch());
+			// calculate model output for the batch as well as the derivative
+			mep_model->eval(batch.input, prediction,*state);
+
+			// calculate error derivative of the loss function
+			error += mep_loss->evalDerivative(batch.label, prediction,errorDerivative);
+
+			//calculate the gradient using the chain rule
+			mep_model->weightedParameterDerivative(batch.input,errorDerivative,*state,dataGradient);
+			derivative+=dataGradient;
+			numElements += shark::size(batch);
+		}
+		error /= numElements;
+		derivative /= double(numElements);
+		return error;
+	}
+
+	ResultType evalSparseDerivative( SearchPointType const& point, SparseFirstOrderDerivative& derivative ) const {
+		//the model backward pass produces dense per-batch gradients, so the
+		//minibatch gradient is accumulated in a reused dense scratch buffer
+		//and compressed once. With sparse inputs most entries stay exactly
+		//zero and the consumer only streams over the compressed pairs instead
+		//of the full parameter vector.
+		double error = evalDerivative(point, m_gradientScratch);
+		derivative.indices.clear();
+		derivative.values.clear();
+		for(std::size_t i = 0; i != m_gradientScratch.size(); ++i){
+			if(m_gradientScratch(i) != 0.0){
+				derivative.indices.push_back(i);
+				derivative.values.push_back(m_gradientScratch(i));
+			}
+		}
+		return error;
+	}
+
+private:
+	///\brief Returns the index of the next batch of the schedule, reshuffling it once it is exhausted.
+	std::size_t nextBatch() const{
+		if(m_position == m_schedule.size()){
+			DiscreteUniform<Rng::rng_type> uni(Rng::globalRng,0,1);
+			std::random_shuffle(m_schedule.begin(),m_schedule.end(),uni);
+			m_position = 0;
+		}
+		return m_schedule[m_position++];
+	}
+
+	AbstractModel<InputType, OutputType>* mep_model;
+	AbstractLoss<LabelType, OutputType>* mep_loss;
+	LabeledData<InputType, LabelType> m_dataset;
+	std::size_t m_numBatches; ///< number of batches processed per evaluation
+	mutable std::vector<std::size_t> m_schedule; ///< random order in which the batches are visited
+	mutable std::size_t m_position; ///< current position in the schedule
+	mutable FirstOrderDerivative m_gradientScratch; ///< reused dense buffer for the sparse derivative
 };
 
 
@@ -263,12 +444,9 @@ public:
 			
 			//create model prediction
 			auto prediction = (*mep_model)(data.input);
-			
-			//sum up weighted loss
-			double batchError = 0.0;
-			for(std::size_t j = 0; j != data.size(); ++j){
-				batchError += weights(j) * mep_loss->eval(get(data.label,j), get(prediction,j));
-			}
+
+			//sum up the loss with the weights folded into the accumulation
+			double batchError = mep_loss->evalWeighted(data.label, prediction, weights);
 			SHARK_CRITICAL_REGION{
 				error+= batchError;
 			}
@@ -293,15 +471,10 @@ public:
 			boost::shared_ptr<State> state = mep_model->createState();
 			mep_model->eval(data.input, prediction,*state);
 			
-			//compute  weighted loss and its derivative for every element in its batch
-			typename Batch<OutputType>::type errorDerivative(prediction.size1(),prediction.size2());
-			OutputType singleDerivative;
-			double batchError = 0.0;
-			for(std::size_t j = 0; j != data.size(); ++j){
-				batchError += weights(j) * mep_loss->evalDerivative(get(data.label,j), get(prediction,j), singleDerivative);
-				noalias(row(errorDerivative,j) ) = weights(j) * singleDerivative;
-			}
-			
+			//compute the weighted loss and its weighted derivative in one fused pass
+			typename Batch<OutputType>::type errorDerivative;
+			double batchError = mep_loss->evalDerivativeWeighted(data.label, prediction, weights, errorDerivative);
+
 			//calculate the gradient using the chain rule
 			RealVector dataGradient(mep_model->numberOfParameters());
 			mep_model->weightedParameterDerivative(data.input,errorDerivative,*state,dataGradient);
@@ -333,12 +506,15 @@ inline void swap(ErrorFunction& op1, ErrorFunction& op2){
 template<class InputType,class LabelType, class OutputType>
 inline ErrorFunction::ErrorFunction(
 	LabeledData<InputType, LabelType> const& dataset,
-	AbstractModel<InputType,OutputType>* model, 
-	AbstractLoss<LabelType, OutputType>* loss
+	AbstractModel<InputType,OutputType>* model,
+	AbstractLoss<LabelType, OutputType>* loss,
+	std::size_t minibatchBatches
 ){
 	m_regularizer = 0;
+	if(minibatchBatches > 0)
+		mp_wrapper.reset(new detail::MinibatchErrorFunctionImpl<InputType,LabelType,OutputType>(dataset,model,loss,minibatchBatches));
 	//non sequential models can be parallelized
-	if(model->isSequential() || SHARK_NUM_THREADS == 1)
+	else if(model->isSequential() || SHARK_NUM_THREADS == 1)
 		mp_wrapper.reset(new detail::ErrorFunctionImpl<InputType,LabelType,OutputType>(dataset,model,loss));
 	else
 		mp_wrapper.reset(new detail::ParallelErrorFunctionImpl<InputType,LabelType,OutputType>(dataset,model,loss));
@@ -388,5 +564,12 @@ inline ErrorFunction::ResultType ErrorFunction::evalDerivative( const SearchPoin
 	}
 	return value;
 }
+
+inline ErrorFunction::ResultType ErrorFunction::evalSparseDerivative( const SearchPointType & input, SparseFirstOrderDerivative & derivative ) const{
+	//a regularizer makes the gradient dense, setRegularizer removes the feature
+	SHARK_ASSERT(m_regularizer == NULL);
+	++m_evaluationCounter;
+	return mp_wrapper -> evalSparseDerivative(input,derivative);
+}
 }
 #endif
@@ -41,7 +41,6 @@ private:
 	AbstractModel<InputType, OutputType>* mep_model;
 	AbstractLoss<LabelType,OutputType>* mep_loss;
 	DataView<LabeledData<InputType,LabelType> const> m_dataset;
-	std::size_t m_batchSize;
 	mutable DiscreteUniform<Rng::rng_type> m_uni;
 	typedef typename AbstractModel<InputType, OutputType>::BatchOutputType BatchOutputType;
 	typedef typename LabeledData<InputType,LabelType>::batch_type BatchDataType;
@@ -53,10 +52,11 @@ public:
 		AbstractLoss<LabelType,OutputType>* loss,
 		std::size_t batchSize=1
 	): mep_model(model), mep_loss(loss), m_dataset(dataset)
-	, m_batchSize(batchSize),m_uni(Rng::globalRng,0,m_dataset.size()-1)
+	, m_uni(Rng::globalRng,0,m_dataset.size()-1)
 	{
 		SHARK_ASSERT(model!=NULL);
 		SHARK_ASSERT(loss!=NULL);
+		m_batchSize = batchSize;
 		
 		if(mep_model->hasFirstParameterDerivative() && mep_loss->hasFirstDerivative())
 			this->m_features|=HAS_FIRST_DERIVATIVE;
@@ -80,7 +80,9 @@ public:
 	}
 
 	double eval(RealVector const& input)const {
-		if(m_batchSize > 0){
+		if(m_minSamples > 0){
+			return evalAdaptive(input);
+		}else if(m_batchSize > 0){
 			//prepare batch for the current iteration
 			std::vector<std::size_t> indices(m_batchSize);
 			std::generate(indices.begin(),indices.end(),m_uni);
@@ -110,6 +112,46 @@ public:
 	}
 	
 private:
+	///\brief Samples adaptively until the error estimate is accurate enough for a comparison.
+	double evalAdaptive(RealVector const& input)const{
+		mep_model->setParameterVector(input);
+
+		//with common random numbers all points compared between two calls
+		//to resample() are evaluated on exactly the same sample sequence
+		std::size_t seed = m_useCRN? m_crnSeed : static_cast<std::size_t>(Rng::discrete(0,std::numeric_limits<unsigned int>::max()));
+		Rng::rng_type rng(static_cast<unsigned int>(seed));
+		DiscreteUniform<Rng::rng_type> uni(rng,0,m_dataset.size()-1);
+
+		double sum = 0.0;
+		double sumOfSquares = 0.0;
+		std::size_t samples = 0;
+		std::size_t chunk = m_minSamples;
+		while(true){
+			chunk = std::min(chunk, m_maxSamples - samples);
+			std::vector<std::size_t> indices(chunk);
+			std::generate(indices.begin(),indices.end(),uni);
+			BatchDataType batch = subBatch(m_dataset,indices);
+
+			BatchOutputType predictions;
+			mep_model->eval(batch.input,predictions);
+			for(std::size_t j = 0; j != chunk; ++j){
+				double loss = mep_loss->eval(get(batch.label,j), get(predictions,j));
+				sum += loss;
+				sumOfSquares += loss * loss;
+			}
+			samples += chunk;
+			if(samples >= m_maxSamples) break;
+
+			double mean = sum / samples;
+			double variance = std::max(0.0, sumOfSquares / samples - sqr(mean));
+			//stop as soon as the standard error of the estimate is small
+			//relative to its value; otherwise double the sample
+			if(variance <= samples * sqr(m_tolerance * mean)) break;
+			chunk = samples;
+		}
+		return sum / samples;
+	}
+
 	double evalForBatch(RealVector const& input, BatchDataType const& batch)const {
 		mep_model->setParameterVector(input);
 	
@@ -202,5 +244,17 @@ inline std::size_t NoisyErrorFunction::batchSize() const{
 	return mp_wrapper -> batchSize();
 }
 
+inline void NoisyErrorFunction::setAdaptiveSampling(std::size_t minSamples, std::size_t maxSamples, double tolerance){
+	mp_wrapper -> setAdaptiveSampling(minSamples,maxSamples,tolerance);
+}
+
+inline void NoisyErrorFunction::setCommonRandomNumbers(bool enabled){
+	mp_wrapper -> setCommonRandomNumbers(enabled);
+}
+
+inline void NoisyErrorFunction::resample(){
+	mp_wrapper -> resample();
+}
+
 }
 #endif
@@ -36,6 +36,7 @@
 #include <shark/Data/Dataset.h>
 #include <shark/Data/Statistics.h>
 #include <shark/Models/Kernels/AbstractKernelFunction.h>
+#include <shark/Rng/GlobalRng.h>
 
 
 namespace shark{
@@ -125,8 +126,17 @@ public:
 		
 		m_data = dataset;
 		m_elements = dataset.numberOfElements();
-		
-		
+		m_samplingFraction = 1.0;
+
+		//precompute the start offset of every batch so that the block
+		//loops can look them up instead of recomputing prefix sums
+		m_batchStart.resize(m_data.numberOfBatches());
+		std::size_t start = 0;
+		for(std::size_t i = 0; i != m_data.numberOfBatches(); ++i){
+			m_batchStart[i] = start;
+			start += size(m_data.batch(i));
+		}
+
 		setupY(dataset.labels());
 	}
 
@@ -144,6 +154,18 @@ public:
 		return mep_kernel->numberOfParameters();
 	}
 
+	/// \brief Sets the fraction of weight matrix blocks sampled for the derivative.
+	///
+	/// The default of one computes the exact derivative. A smaller fraction
+	/// makes evalDerivative draw blocks of the weight matrix uniformly at
+	/// random and rescale their contributions, which turns the second sweep
+	/// over all pairs of points into an unbiased stochastic estimate. The
+	/// value of the alignment itself is always computed exactly.
+	void setDerivativeSamplingFraction(double fraction){
+		SHARK_CHECK(fraction > 0 && fraction <= 1, "fraction must be in (0,1]");
+		m_samplingFraction = fraction;
+	}
+
 	/// \brief Evaluate the (centered, negative) Kernel Target Alignment (KTA).
 	///
 	/// See the class description for more details on this computation.
@@ -183,11 +205,13 @@ public:
 		std::size_t parameters = mep_kernel->numberOfParameters();
 		derivative.resize(parameters);
 		derivative.clear();
-		SHARK_PARALLEL_FOR(int i = 0; i < (int)m_data.numberOfBatches(); ++i){
-			std::size_t startX = 0;
-			for(int j = 0; j != i; ++j){
-				startX+= size(m_data.batch(j));
-			}
+		if(m_samplingFraction < 1.0){
+			sampledDerivative(results,derivative);
+			derivative *= -1;
+			return -results.error;
+		}
+		SHARK_PARALLEL_FOR_DYNAMIC(int i = 0; i < (int)m_data.numberOfBatches(); ++i){
+			std::size_t startX = m_batchStart[i];
 			RealVector threadDerivative(parameters,0.0);
 			RealVector blockDerivative;
 			boost::shared_ptr<State> state = mep_kernel->createState();
@@ -220,6 +244,8 @@ private:
 	double m_meanY;                                  ///< mean label element
 	std::size_t m_numberOfClasses;                  ///< number of classes
 	std::size_t m_elements;                          ///< number of data points
+	std::vector<std::size_t> m_batchStart;           ///< start offset of every batch
+	double m_samplingFraction;                       ///< fraction of blocks sampled for the derivative, 1 means exact
 
 	struct KernelMatrixResults{
 		RealVector k;
@@ -258,36 +284,38 @@ private:
 	}
 
 	/// Update a sub-block of the matrix \f$ \langle Y, K^x \rangle \f$.
+	///
+	/// Y has rank-structure: \f$ Y = (1+\frac{1}{m-1}) \sum_c e_c e_c^T - \frac{1}{m-1} u u^T \f$
+	/// where \f$ e_c \f$ is the indicator vector of class c. The block sum is
+	/// therefore computed from class-aggregated row sums instead of comparing
+	/// all label pairs.
 	double updateYKc(UIntVector const& labelsi,UIntVector const& labelsj, RealMatrix const& block)const{
 		std::size_t blockSize1 = labelsi.size();
 		std::size_t blockSize2 = labelsj.size();
-		//todo optimize the i=j case
-		double result = 0;
 		double dm1 = m_numberOfClasses-1.0;
+		//aggregate the rows of the block by the class of their example
+		RealMatrix classRowSums(m_numberOfClasses,blockSize2,0.0);
 		for(std::size_t k = 0; k != blockSize1; ++k){
-			for(std::size_t l = 0; l != blockSize2; ++l){
-				if(labelsi(k) == labelsj(l))
-					result += block(k,l);
-				else
-					result -= block(k,l)/dm1;
-			}
+			noalias(row(classRowSums,labelsi(k))) += row(block,k);
+		}
+		//within-class sum: pick for every column the row of its own class
+		double within = 0;
+		for(std::size_t l = 0; l != blockSize2; ++l){
+			within += classRowSums(labelsj(l),l);
 		}
-		return result;
+		double total = sum(classRowSums);
+		return within*(1.0+1.0/dm1) - total/dm1;
 	}
-	
+
 	/// Update a sub-block of the matrix \f$ \langle Y, K^x \rangle \f$.
+	///
+	/// Y is the low-rank product of the label matrices, so the block sum
+	/// reduces to a small matrix-matrix product instead of pairwise
+	/// inner products.
 	double updateYKc(RealMatrix const& labelsi,RealMatrix const& labelsj, RealMatrix const& block)const{
-		std::size_t blockSize1 = labelsi.size1();
-		std::size_t blockSize2 = labelsj.size1();
-		//todo optimize the i=j case
-		double result = 0;
-		for(std::size_t k = 0; k != blockSize1; ++k){
-			for(std::size_t l = 0; l != blockSize2; ++l){
-				double y_kl = inner_prod(row(labelsi,k),row(labelsj,l));
-				result += y_kl*block(k,l);
-			}
-		}
-		return result;
+		//<labelsi labelsj^T, block> = <labelsi^T block, labelsj^T>
+		RealMatrix reducedBlock = prod(trans(labelsi),block);
+		return frobenius_prod(reducedBlock,trans(labelsj));
 	}
 	
 	void computeBlockY(UIntVector const& labelsi,UIntVector const& labelsj, RealMatrix& blockY)const{
@@ -305,13 +333,7 @@ private:
 	}
 	
 	void computeBlockY(RealMatrix const& labelsi,RealMatrix const& labelsj, RealMatrix& blockY)const{
-		std::size_t blockSize1 = labelsi.size1();
-		std::size_t blockSize2 = labelsj.size1();
-		for(std::size_t k = 0; k != blockSize1; ++k){
-			for(std::size_t l = 0; l != blockSize2; ++l){
-				blockY(k,l) = inner_prod(row(labelsi,k),row(labelsj,l));
-			}
-		}
+		noalias(blockY) = prod(labelsi,trans(labelsj));
 	}
 
 	/// Compute a sub-block of the matrix
@@ -350,6 +372,53 @@ private:
 		return blockW;
 	}
 
+	/// \brief Accumulate the derivative from a uniform sample of the weight matrix blocks.
+	///
+	/// The block weights depend on the kernel values of the block and are only
+	/// available once a block has been evaluated, so the blocks of the lower
+	/// triangle are drawn uniformly with replacement and every contribution is
+	/// rescaled by the inverse sampling probability, which keeps the estimate
+	/// unbiased. Blocks drawn several times are evaluated once and reweighted.
+	/// The global Rng is not thread safe, thus all draws happen before the
+	/// parallel evaluation of the drawn blocks.
+	void sampledDerivative(KernelMatrixResults const& results, FirstOrderDerivative& derivative)const{
+		std::size_t numBatches = m_data.numberOfBatches();
+		std::vector<std::pair<std::size_t,std::size_t> > blocks;
+		for(std::size_t i = 0; i != numBatches; ++i){
+			for(std::size_t j = 0; j <= i; ++j){
+				blocks.push_back(std::make_pair(i,j));
+			}
+		}
+		std::size_t numDraws = std::max<std::size_t>(1,(std::size_t)(m_samplingFraction*blocks.size()+0.5));
+		std::vector<std::size_t> drawCount(blocks.size(),0);
+		for(std::size_t d = 0; d != numDraws; ++d){
+			++drawCount[Rng::discrete(0,blocks.size()-1)];
+		}
+		std::vector<std::size_t> drawn;
+		for(std::size_t t = 0; t != blocks.size(); ++t){
+			if(drawCount[t])
+				drawn.push_back(t);
+		}
+		SHARK_PARALLEL_FOR_DYNAMIC(int s = 0; s < (int)drawn.size(); ++s){
+			std::size_t i = blocks[drawn[s]].first;
+			std::size_t j = blocks[drawn[s]].second;
+			RealVector blockDerivative;
+			boost::shared_ptr<State> state = mep_kernel->createState();
+			RealMatrix blockK;//block of the KernelMatrix
+			mep_kernel->eval(m_data.batch(i).input,m_data.batch(j).input,blockK,*state);
+			mep_kernel->weightedParameterDerivative(
+				m_data.batch(i).input,m_data.batch(j).input,
+				generateDerivativeWeightBlock(i,j,m_batchStart[i],m_batchStart[j],blockK,results),//takes symmetry into account
+				*state,
+				blockDerivative
+			);
+			blockDerivative *= drawCount[drawn[s]]*double(blocks.size())/numDraws;
+			SHARK_CRITICAL_REGION{
+				noalias(derivative) += blockDerivative;
+			}
+		}
+	}
+
 	/// \brief Evaluate the centered kernel Gram matrix.
 	///
 	/// The computation is as follows. By means of a
@@ -369,11 +438,8 @@ private:
 		double KK = 0; //stores \langle K,K \rangle 
 		double YKc = 0; //stores \langle Y,K^c \rangle 
 		RealVector k(m_elements,0.0);//stores the row/column means of K
-		SHARK_PARALLEL_FOR(int i = 0; i < (int)m_data.numberOfBatches(); ++i){
-			std::size_t startRow = 0;
-			for(int j = 0; j != i; ++j){
-				startRow+= size(m_data.batch(j));
-			}
+		SHARK_PARALLEL_FOR_DYNAMIC(int i = 0; i < (int)m_data.numberOfBatches(); ++i){
+			std::size_t startRow = m_batchStart[i];
 			std::size_t rowSize = size(m_data.batch(i));
 			double threadKK = 0;
 			double threadYKc = 0;
@@ -114,6 +114,16 @@ public:
 			for(std::size_t i = 0; i != problem.dimensions(); ++i){
 				alphaFull(i) = problem.alpha(i);
 			}
+			// snapshot of the full-data solution in dataset order. every
+			// subproblem is seeded with it, so the solver only has to
+			// repair the violations caused by removing the current point
+			// instead of starting from the solution of the previous one.
+			RealVector alphaSeed(problem.dimensions());
+			RealVector gradientSeed(problem.dimensions());
+			for(std::size_t i = 0; i != problem.dimensions(); ++i){
+				alphaSeed(problem.permutation(i)) = problem.alpha(i);
+				gradientSeed(problem.permutation(i)) = problem.gradient(i);
+			}
 			KernelExpansion<InputType> svm(mep_kernel,mep_dataset->inputs(),true);
 
 			// leave-one-out
@@ -124,7 +134,7 @@ public:
 				// use sparseness of the solution:
 				if (alphaFull(i) == 0.0) continue;
 				problem.deactivateVariable(i);
-				
+
 				// solve the reduced problem
 				solver.solve(stop);
 
@@ -137,8 +147,9 @@ public:
 				std::size_t elementIndex = i;//svmProblem.permutation[i];
 				unsigned int target = mep_dataset->element(elementIndex).label;
 				mistakes += loss(target, svm(mep_dataset->element(elementIndex).input));
-				
+
 				problem.activateVariable(i);
+				problem.setInitialSolution(alphaSeed, gradientSeed);
 			}
 			return mistakes / (double)ell;
 		}
@@ -153,8 +164,16 @@ public:
 			for(std::size_t i = 0; i != problem.dimensions(); ++i){
 				alphaFull(i) = problem.alpha(i);
 			}
+			// keep the full-data solution around as the common warm start
+			// for all subproblems, see the offset case above
+			RealVector alphaSeed(problem.dimensions());
+			RealVector gradientSeed(problem.dimensions());
+			for(std::size_t i = 0; i != problem.dimensions(); ++i){
+				alphaSeed(problem.permutation(i)) = problem.alpha(i);
+				gradientSeed(problem.permutation(i)) = problem.gradient(i);
+			}
 			KernelExpansion<InputType> svm(mep_kernel,mep_dataset->inputs(),false);
-			
+
 			// leave-one-out
 			//problem.setShrinking(false);
 			double mistakes = 0;
@@ -163,7 +182,7 @@ public:
 				// use sparseness of the solution:
 				if (alphaFull(i) == 0.0) continue;
 				problem.deactivateVariable(i);
-				
+
 
 				// solve the reduced problem
 				solver.solve(stop);
@@ -178,6 +197,7 @@ public:
 				mistakes += loss(target, svm(mep_dataset->element(elementIndex).input));
 
 				problem.activateVariable(i);
+				problem.setInitialSolution(alphaSeed, gradientSeed);
 			}
 			return mistakes / (double)ell;
 		}
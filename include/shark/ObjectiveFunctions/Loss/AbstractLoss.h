@@ -36,9 +36,30 @@
 
 #include <shark/ObjectiveFunctions/AbstractCost.h>
 #include <shark/LinAlg/Base.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Core/Traits/ProxyReferenceTraits.h>
+#include <shark/Core/utility/functional.h>
 namespace shark {
 
+template<class InputTypeT, class OutputTypeT>
+class AbstractModel;
+
+namespace detail{
+///\brief Scales an element of a gradient batch by a weight.
+///
+/// The overload for sequences scales every step, since a sequence
+/// itself does not support scaling.
+template<class T>
+void weightGradientElement(T&& element, double weight){
+	element *= weight;
+}
+template<class T>
+void weightGradientElement(std::deque<T>& element, double weight){
+	for(std::size_t i = 0; i != element.size(); ++i)
+		weightGradientElement(element[i], weight);
+}
+}
+
 
 /// \brief Loss function interface
 ///
@@ -139,6 +160,58 @@ public:
 		return 0.0;  // dead code, prevent warning
 	}
 
+	/// \brief evaluate the weighted loss for a batch of targets and predictions
+	///
+	/// \par
+	/// Computes \f$ \sum_i w_i L(y_i, f(x_i)) \f$ with the weights folded
+	/// into the accumulation of the loss values, so no separately weighted
+	/// pass over the batch is needed. The default implementation evaluates
+	/// the loss element by element; subclasses should override it with a
+	/// fused batch computation where possible.
+	///
+	/// \param  target      target values
+	/// \param  prediction  predictions, typically made by a model
+	/// \param  weights     weight of every element of the batch
+	virtual double evalWeighted(BatchLabelType const& target, BatchOutputType const& prediction, RealVector const& weights) const{
+		std::size_t numInputs = size(target);
+		SIZE_CHECK(weights.size() == numInputs);
+		double error = 0.0;
+		for(std::size_t i = 0; i != numInputs; ++i){
+			error += weights(i) * eval(get(target, i), get(prediction, i));
+		}
+		return error;
+	}
+
+	/// \brief evaluate the weighted loss and the derivative w.r.t. the prediction
+	///
+	/// \par
+	/// As evalWeighted, but additionally stores the weighted gradient of
+	/// every element, i.e. row i of the gradient is the derivative of
+	/// \f$ w_i L(y_i, f(x_i)) \f$ w.r.t. the prediction. The default
+	/// implementation evaluates and scales element by element.
+	///
+	/// \param  target      target values
+	/// \param  prediction  predictions, typically made by a model
+	/// \param  weights     weight of every element of the batch
+	/// \param  gradient    the weighted gradient of the loss function with respect to the prediction
+	virtual double evalDerivativeWeighted(
+		BatchLabelType const& target, BatchOutputType const& prediction,
+		RealVector const& weights, BatchOutputType& gradient
+	) const{
+		std::size_t numInputs = size(target);
+		SIZE_CHECK(weights.size() == numInputs);
+		if(numInputs == 0) return 0.0;
+		gradient = Batch<OutputType>::createBatch(get(prediction, 0), numInputs);
+		OutputType singleGradient;
+		double error = 0.0;
+		for(std::size_t i = 0; i != numInputs; ++i){
+			error += weights(i) * evalDerivative(get(target, i), get(prediction, i), singleGradient);
+			get(gradient, i) = singleGradient;
+			detail::weightGradientElement(get(gradient, i), weights(i));
+		}
+		return error;
+	}
+
 	//~ /// \brief evaluate the loss and fist and second derivative w.r.t. the prediction
 	//~ ///
 	//~ /// \par
@@ -167,14 +240,100 @@ public:
 		SIZE_CHECK(predictions.numberOfElements() == targets.numberOfElements());
 		SIZE_CHECK(predictions.numberOfBatches() == targets.numberOfBatches());
 		int numBatches = (int) targets.numberOfBatches();
-		double error = 0;
+		//one partial per batch combined in fixed order: the total does not
+		//depend on the number of threads
+		std::vector<double> batchError(numBatches,0.0);
 		SHARK_PARALLEL_FOR(int i = 0; i < numBatches; ++i){
-			double batchError= eval(targets.batch(i),predictions.batch(i));
-			SHARK_CRITICAL_REGION{
-				error+=batchError;
+			batchError[i] = eval(targets.batch(i),predictions.batch(i));
+		}
+		return compensatedSum(batchError) / targets.numberOfElements();
+	}
+
+	/// \brief Evaluates the loss of a model on a dataset without materializing the predictions.
+	///
+	/// Acts as a sink for the streaming evaluation of the model: every
+	/// prediction batch is folded into the loss right after it is computed,
+	/// so no Data container of the outputs is ever allocated. Use this for
+	/// the common predict-then-reduce round trip after training, where the
+	/// predictions are only needed to compute the error.
+	///
+	/// \param  targets  target values
+	/// \param  inputs   input values
+	/// \param  model    model whose predictions are evaluated
+	template<class InputType>
+	double eval(Data<LabelType> const& targets, Data<InputType> const& inputs, AbstractModel<InputType, OutputType> const& model) const{
+		SIZE_CHECK(inputs.numberOfElements() == targets.numberOfElements());
+		SIZE_CHECK(inputs.numberOfBatches() == targets.numberOfBatches());
+		std::vector<double> batchError(targets.numberOfBatches(),0.0);
+		auto sink = [&](std::size_t i, BatchOutputType const& predictions){
+			batchError[i] = eval(targets.batch(i), predictions);
+		};
+		model.eval(inputs, sink);
+		return compensatedSum(batchError) / targets.numberOfElements();
+	}
+
+	/// \brief Estimates the error from a random sample of the data.
+	///
+	/// \par
+	/// The batches are visited in random order, several at a time and in
+	/// parallel, while a running mean and variance of the per-batch mean
+	/// losses are maintained. Sampling stops as soon as the half-width of
+	/// the 95% normal confidence interval of the estimate drops below the
+	/// requested precision. If the precision cannot be reached, all batches
+	/// are consumed and the value equals eval(). This makes monitoring on
+	/// very large datasets cheap: a loose precision touches only a small
+	/// random fraction of the batches.
+	///
+	/// \param  targets      target values
+	/// \param  predictions  predictions, typically made by a model
+	/// \param  precision    requested half-width of the confidence interval of the estimate
+	double evalSampled(Data<LabelType> const& targets, Data<OutputType> const& predictions, double precision) const{
+		SIZE_CHECK(predictions.numberOfElements() == targets.numberOfElements());
+		SIZE_CHECK(predictions.numberOfBatches() == targets.numberOfBatches());
+		RANGE_CHECK(precision > 0);
+		std::size_t numBatches = targets.numberOfBatches();
+
+		//visit the batches in random order
+		std::vector<std::size_t> order(numBatches);
+		std::iota(order.begin(),order.end(),0);
+		partial_shuffle(order.begin(),order.end(),order.end());
+
+		double sumLoss = 0;          //summed loss of the sampled batches
+		std::size_t sumElements = 0; //number of sampled elements
+		double mean = 0;             //running mean of the per-batch mean losses
+		double m2 = 0;               //running sum of squared deviations
+		std::size_t count = 0;       //number of sampled batches
+		std::size_t pos = 0;
+		while(pos < numBatches){
+			//evaluate one round of batches in parallel. the round size is a
+			//constant rather than a multiple of the thread count, so the
+			//sampling sequence - and with the ordered merge below the
+			//estimate itself - does not change with the number of threads
+			std::size_t round = std::min<std::size_t>(numBatches - pos, 32);
+			std::vector<double> roundLoss(round,0.0);
+			SHARK_PARALLEL_FOR(int i = 0; i < (int)round; ++i){
+				std::size_t b = order[pos + i];
+				roundLoss[i] = eval(targets.batch(b),predictions.batch(b));
 			}
+			//merge the round serially in the order of the sampling sequence
+			for(std::size_t i = 0; i < round; ++i){
+				std::size_t batchElements = size(targets.batch(order[pos + i]));
+				sumLoss += roundLoss[i];
+				sumElements += batchElements;
+				count++;
+				double batchMean = roundLoss[i] / batchElements;
+				double delta = batchMean - mean;
+				mean += delta / count;
+				m2 += delta * (batchMean - mean);
+			}
+			pos += round;
+			if(pos == numBatches) break;
+
+			//stop once the 95% confidence interval is tight enough
+			double halfwidth = 1.96 * std::sqrt(m2 / (count - 1) / count);
+			if(count > 1 && halfwidth <= precision) break;
 		}
-		return error / targets.numberOfElements();
+		return sumLoss / sumElements;
 	}
 
 	/// \brief evaluate the loss for a target and a prediction
@@ -84,6 +84,35 @@ public:
 		noalias(gradient) = 2.0*(prediction - label);
 		return SquaredLoss::eval(label,prediction);
 	}
+
+	/// Evaluate the weighted squared loss \f$ \sum_i w_i (label_i - prediction_i)^2 \f$
+	/// with the weights folded into the accumulation.
+	double evalWeighted(BatchLabelType const& labels, BatchOutputType const& predictions, RealVector const& weights) const {
+		SIZE_CHECK(labels.size1()==predictions.size1());
+		SIZE_CHECK(weights.size()==predictions.size1());
+
+		double error = 0;
+		for(std::size_t i = 0; i != labels.size1(); ++i){
+			error+=weights(i)*distanceSqr(row(predictions,i),row(labels,i));
+		}
+		return error;
+	}
+
+	/// Evaluate the weighted squared loss and its weighted derivative in one pass.
+	double evalDerivativeWeighted(
+		BatchLabelType const& labels, BatchOutputType const& predictions,
+		RealVector const& weights, BatchOutputType& gradient
+	) const {
+		SIZE_CHECK(labels.size1()==predictions.size1());
+		SIZE_CHECK(weights.size()==predictions.size1());
+		gradient.resize(predictions.size1(),predictions.size2());
+		double error = 0;
+		for(std::size_t i = 0; i != labels.size1(); ++i){
+			error+=weights(i)*distanceSqr(row(predictions,i),row(labels,i));
+			noalias(row(gradient,i)) = (2.0*weights(i))*(row(predictions,i) - row(labels,i));
+		}
+		return error;
+	}
 };
 
 //specialisation for classification case.
@@ -133,6 +162,39 @@ public:
 		}
 		return SquaredLoss::eval(labels,predictions);
 	}
+
+	/// Evaluate the weighted squared loss with the weights folded into the accumulation.
+	double evalWeighted(BatchLabelType const& labels, BatchOutputType const& predictions, RealVector const& weights) const {
+		SIZE_CHECK(labels.size()==predictions.size1());
+		SIZE_CHECK(weights.size()==predictions.size1());
+
+		double error = 0;
+		for(std::size_t i = 0; i != labels.size(); ++i){
+			unsigned int c = labels(i);
+			SIZE_CHECK(c < predictions.size2());
+			error+=weights(i)*(norm_sqr(row(predictions,i))+1.0-2.0*predictions(i,c));
+		}
+		return error;
+	}
+
+	/// Evaluate the weighted squared loss and its weighted derivative in one pass.
+	double evalDerivativeWeighted(
+		BatchLabelType const& labels, BatchOutputType const& predictions,
+		RealVector const& weights, BatchOutputType& gradient
+	) const {
+		SIZE_CHECK(labels.size()==predictions.size1());
+		SIZE_CHECK(weights.size()==predictions.size1());
+		gradient.resize(predictions.size1(),predictions.size2());
+		double error = 0;
+		for(std::size_t i = 0; i != labels.size(); ++i){
+			unsigned int c = labels(i);
+			SIZE_CHECK(c < predictions.size2());
+			error+=weights(i)*(norm_sqr(row(predictions,i))+1.0-2.0*predictions(i,c));
+			noalias(row(gradient,i)) = (2.0*weights(i))*row(predictions,i);
+			gradient(i,c)-=2.0*weights(i);
+		}
+		return error;
+	}
 };
 
 //spcialisation for sequence data
@@ -0,0 +1,74 @@
+/*!
+ *
+ *
+ * \brief       MPI backed gradient reducer for data-parallel training
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_OBJECTIVEFUNCTIONS_MPIGRADIENTREDUCER_H
+#define SHARK_OBJECTIVEFUNCTIONS_MPIGRADIENTREDUCER_H
+
+#include <shark/ObjectiveFunctions/DataParallelErrorFunction.h>
+#include <mpi.h>
+
+namespace shark{
+
+/// \brief Reference reducer for multi-node training, backed by MPI.
+///
+/// Maps allSum to a single in-place MPI_Allreduce over the packed buffer, so
+/// one collective per optimization step exchanges weight, error and gradient
+/// at once. As with the HDF5 support, this header is not included anywhere in
+/// the library itself; only programs including it need an MPI implementation
+/// to compile and link.
+class MPIGradientReducer : public AbstractGradientReducer{
+public:
+	/// \brief Constructor.
+	///
+	/// \param communicator the communicator spanning the training group
+	explicit MPIGradientReducer(MPI_Comm communicator = MPI_COMM_WORLD)
+	: m_communicator(communicator){}
+
+	/// \brief From INameable: return the class name.
+	std::string name() const
+	{ return "MPIGradientReducer"; }
+
+	void allSum(double* buffer, std::size_t length) const{
+		MPI_Allreduce(MPI_IN_PLACE, buffer, (int)length, MPI_DOUBLE, MPI_SUM, m_communicator);
+	}
+
+	std::size_t numberOfWorkers() const{
+		int groupSize = 1;
+		MPI_Comm_size(m_communicator, &groupSize);
+		return (std::size_t)groupSize;
+	}
+
+private:
+	MPI_Comm m_communicator; ///< communicator spanning the training group
+};
+
+}
+#endif
@@ -77,19 +77,24 @@ public:
 		unsigned N = 0; // negative examples
 		std::vector<AUCPair> L(elements); // list of predictions and labels
 
-		for(std::size_t i=0; i!= elements; i++) { // build list
-			LabelType t = target.element(i);
-			// negate predictions if m_invert is set
-			if(!m_invert)
-				L[i] = AUCPair(prediction.element(i)(column), t);
-			else
-				L[i] = AUCPair(-prediction.element(i)(column), t);
-			// count positive and negative examples
-			if(t > 0) 
-				P++;
-			else 
-				N++;
-		}    
+		std::size_t i = 0;
+		for(std::size_t b=0; b != target.numberOfBatches(); b++) { // build list batch by batch
+			auto const& labelBatch = target.batch(b);
+			auto const& predictionBatch = prediction.batch(b);
+			for(std::size_t j=0; j != size(labelBatch); j++, i++) {
+				LabelType t = get(labelBatch,j);
+				// negate predictions if m_invert is set
+				if(!m_invert)
+					L[i] = AUCPair(get(predictionBatch,j)(column), t);
+				else
+					L[i] = AUCPair(-get(predictionBatch,j)(column), t);
+				// count positive and negative examples
+				if(t > 0)
+					P++;
+				else
+					N++;
+			}
+		}
 
 		std::sort (L.begin(), L.end(),std::greater<AUCPair>() ); // sort in decreasing order
 
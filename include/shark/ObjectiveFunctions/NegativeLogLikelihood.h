@@ -34,6 +34,7 @@
 
 #include <shark/Models/AbstractModel.h>
 #include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
+#include <shark/Core/OpenMP.h>
 #include <shark/Rng/GlobalRng.h>
 
 #include <boost/range/algorithm_ext/iota.hpp>
@@ -83,16 +84,16 @@ public:
 		m_evaluationCounter++;
 		mep_model->setParameterVector(input);
 		
-		double error = 0;
 		double minProb = 1e-100;//numerical stability is only guaranteed for lower bounded probabilities
+		//one partial per batch combined in a fixed order makes the result
+		//independent of the number of threads
+		std::vector<double> batchLikelihood(m_data.numberOfBatches(),0.0);
 		SHARK_PARALLEL_FOR(int i = 0; i < (int)m_data.numberOfBatches(); ++i){
 			RealMatrix predictions = (*mep_model)(m_data.batch(i));
 			SIZE_CHECK(predictions.size2() == 1);
-			double logLikelihoodOfSamples = sum(log(max(predictions,minProb)));
-			SHARK_CRITICAL_REGION{
-				error += logLikelihoodOfSamples;
-			}
+			batchLikelihood[i] = sum(log(max(predictions,minProb)));
 		}
+		double error = compensatedSum(batchLikelihood);
 		error/=m_data.numberOfElements();//compute mean
 		return -error;//negative log likelihood
 	}
@@ -106,23 +107,28 @@ public:
 		derivative.resize(input.size());
 		derivative.clear();
 		
-		//compute partitioning on threads
+		//partition the batches into a fixed grid of chunks. the grid depends
+		//only on the dataset, not on the number of threads, so together with
+		//the fixed order reduction below the result is bit-reproducible at any
+		//thread count. the constant bounds the memory for the partial
+		//derivatives while still providing enough chunks for load balancing.
 		std::size_t numBatches = m_data.numberOfBatches();
 		std::size_t numElements = m_data.numberOfElements();
-		std::size_t numThreads = std::min(SHARK_NUM_THREADS,numBatches);
+		std::size_t numChunks = std::min<std::size_t>(numBatches,64);
 		//calculate optimal partitioning
-		std::size_t batchesPerThread = numBatches/numThreads;
-		std::size_t leftOver = numBatches - batchesPerThread*numThreads;
-		double error = 0;
+		std::size_t batchesPerChunk = numBatches/numChunks;
+		std::size_t leftOver = numBatches - batchesPerChunk*numChunks;
 		double minProb = 1e-100;//numerical stability is only guaranteed for lower bounded probabilities
-		SHARK_PARALLEL_FOR(int ti = 0; ti < (int)numThreads; ++ti){//MSVC does not support unsigned integrals in paralll loops
+		std::vector<double> chunkError(numChunks,0.0);
+		std::vector<FirstOrderDerivative> chunkDerivative(numChunks,FirstOrderDerivative(input.size(),0.0));
+		SHARK_PARALLEL_FOR(int ti = 0; ti < (int)numChunks; ++ti){//MSVC does not support unsigned integrals in paralll loops
 			std::size_t t = ti;
 			//~ //get start and end index of batch-range
-			std::size_t start = t*batchesPerThread+std::min(t,leftOver);
-			std::size_t end = (t+1)*batchesPerThread+std::min(t+1,leftOver);
-			
-			//calculate error and derivative of the current thread
-			FirstOrderDerivative threadDerivative(input.size(),0.0);
+			std::size_t start = t*batchesPerChunk+std::min(t,leftOver);
+			std::size_t end = (t+1)*batchesPerChunk+std::min(t+1,leftOver);
+
+			//calculate error and derivative of the current chunk
+			FirstOrderDerivative& threadDerivative = chunkDerivative[t];
 			double threadError = 0;
 			boost::shared_ptr<State> state = mep_model->createState();
 			RealVector batchDerivative;
@@ -148,14 +154,13 @@ public:
 				);
 				threadDerivative += batchDerivative;
 			}
-			
-			//sum over all threads
-			SHARK_CRITICAL_REGION{
-				error += threadError;
-				noalias(derivative) += threadDerivative;
-			}
+			chunkError[t] = threadError;
 		}
-		
+
+		//combine the chunk partials in a fixed order
+		double error = compensatedSum(chunkError);
+		noalias(derivative) = deterministicSum(chunkDerivative);
+
 		error /= numElements;
 		derivative /= numElements;
 		derivative *= -1;
@@ -47,13 +47,35 @@ namespace detail{
 class NoisyErrorFunctionWrapperBase:public FunctionWrapperBase{
 protected:
 	std::size_t m_batchSize;
+	std::size_t m_minSamples; ///< initial sample size of the adaptive scheme, 0 disables it
+	std::size_t m_maxSamples; ///< upper bound on the sample size of the adaptive scheme
+	double m_tolerance;       ///< relative accuracy of the mean estimate at which sampling stops
+	bool m_useCRN;            ///< whether evaluations reuse a common random sample
+	std::size_t m_crnSeed;    ///< seed of the common random sample
 public:
+	NoisyErrorFunctionWrapperBase()
+	: m_batchSize(1), m_minSamples(0), m_maxSamples(0)
+	, m_tolerance(0.1), m_useCRN(false), m_crnSeed(0){}
+
 	void setBatchSize(std::size_t batchSize){
 		m_batchSize = batchSize;
 	}
 	std::size_t batchSize() const{
 		return m_batchSize;
 	}
+	void setAdaptiveSampling(std::size_t minSamples, std::size_t maxSamples, double tolerance){
+		SHARK_CHECK(minSamples <= maxSamples, "[NoisyErrorFunction::setAdaptiveSampling] minSamples must not exceed maxSamples");
+		m_minSamples = minSamples;
+		m_maxSamples = maxSamples;
+		m_tolerance = tolerance;
+	}
+	void setCommonRandomNumbers(bool enabled){
+		m_useCRN = enabled;
+		resample();
+	}
+	void resample(){
+		m_crnSeed = static_cast<std::size_t>(Rng::discrete(0,std::numeric_limits<unsigned int>::max()));
+	}
 };
 }
 
@@ -67,6 +89,18 @@ public:
 /// Setting the batch size to 0 is equivalent to performing minibatch learning
 /// where one random batch is picked from the dataset instead of sampling
 /// points from it
+///
+/// For derivative-free optimizers which compare points against each other,
+/// e.g. for the selection step of CMA, a fixed sample size has to be chosen
+/// for the hardest comparison and wastes evaluations everywhere else. Enabling
+/// adaptive sampling via setAdaptiveSampling starts every eval with a small
+/// sample and doubles it only while the standard error of the error estimate
+/// is still large relative to its value, up to the given maximum. Together
+/// with setCommonRandomNumbers all points compared between two calls to
+/// resample() are evaluated on the very same sample, so differences between
+/// points are not drowned by sampling noise. Call resample() once per
+/// generation to draw a fresh sample. The adaptive scheme applies to eval
+/// only; evalDerivative keeps the fixed batch size.
 class NoisyErrorFunction : public SingleObjectiveFunction
 {
 public:
@@ -87,6 +121,17 @@ public:
 	void setBatchSize(std::size_t batchSize);
 	std::size_t batchSize() const;
 
+	/// \brief Enables adaptive sampling for eval.
+	///
+	/// Every evaluation starts with minSamples examples and doubles the sample
+	/// until the standard error of the estimate drops below tolerance times its
+	/// value or maxSamples is reached. minSamples = 0 disables the scheme.
+	void setAdaptiveSampling(std::size_t minSamples, std::size_t maxSamples, double tolerance = 0.1);
+	/// \brief Reuse the same random sample for all evaluations until the next resample().
+	void setCommonRandomNumbers(bool enabled);
+	/// \brief Draws a fresh sample for the common random numbers.
+	void resample();
+
 	SearchPointType proposeStartingPoint() const{
 		return mp_wrapper -> proposeStartingPoint();
 	}
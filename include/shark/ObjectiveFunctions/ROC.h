@@ -35,6 +35,7 @@
 #define SHARK_OBJECTIVEFUNCTIONS_ROC_H
 
 #include <shark/Core/DLLSupport.h>
+#include <shark/Core/utility/KeyValuePair.h>
 #include <shark/Models/AbstractModel.h>
 #include <shark/Data/Dataset.h>
 #include <vector>
@@ -129,5 +130,103 @@ protected:
 	std::vector<double> m_scoreNegative;
 };
 
+
+//!
+//! \brief Full ROC curve, AUC and partial AUC from a single sort
+//!
+//! \par
+//! In contrast to the ROC class, which stores the raw scores and answers
+//! queries by searching them, RocCurve sorts the scores once and computes
+//! the complete curve, the area under it and all running counts in one
+//! linear sweep. Tied scores are collapsed into a single curve vertex, so
+//! ties between positive and negative examples contribute the correct
+//! diagonal (trapezoidal) segment. This makes evaluation of large
+//! validation sets O(n log n) with a small constant, where the sort
+//! dominates and is carried out in parallel.
+//!
+//! \par
+//! The curve is stored as vertices (falsePositiveRate, truePositiveRate)
+//! in order of decreasing threshold, starting at (0,0) and ending at (1,1).
+//!
+class RocCurve
+{
+public:
+	//! Constructor computing scores from a model
+	//!
+	//! \param  model   model to use for prediction
+	//! \param  set     data set with inputs and corresponding binary labels (0 or 1)
+	//! \param  column  column of the model output interpreted as score of the positive class
+	template<class InputType>
+	RocCurve(AbstractModel<InputType,RealVector>& model, LabeledData<InputType,unsigned int> const& set, std::size_t column = 0){
+		std::vector<KeyValuePair<double,unsigned int> > scores;
+		scores.reserve(set.numberOfElements());
+		for(std::size_t b = 0; b != set.size(); ++b){
+			RealMatrix output = model(set.batch(b).input);
+			SIZE_CHECK(output.size2() > column);
+			for(std::size_t j = 0; j != output.size1(); ++j){
+				scores.push_back(makeKeyValuePair(output(j,column),(unsigned int)set.batch(b)(j)));
+			}
+		}
+		computeCurve(scores);
+	}
+
+	//! Constructor from precomputed predictions
+	//!
+	//! \param  predictions  scores of the examples, one vector per example
+	//! \param  labels       binary labels (0 or 1) of the examples
+	//! \param  column       column of the prediction interpreted as score of the positive class
+	RocCurve(Data<RealVector> const& predictions, Data<unsigned int> const& labels, std::size_t column = 0){
+		SIZE_CHECK(predictions.numberOfElements() == labels.numberOfElements());
+		std::vector<KeyValuePair<double,unsigned int> > scores;
+		scores.reserve(labels.numberOfElements());
+		for(std::size_t b = 0; b != labels.numberOfBatches(); ++b){
+			RealMatrix const& output = predictions.batch(b);
+			SIZE_CHECK(output.size2() > column);
+			for(std::size_t j = 0; j != output.size1(); ++j){
+				scores.push_back(makeKeyValuePair(output(j,column),(unsigned int)labels.batch(b)(j)));
+			}
+		}
+		computeCurve(scores);
+	}
+
+	//! Area under the complete curve.
+	double auc()const{
+		return m_auc;
+	}
+
+	//! Area under the curve restricted to [0, maxFalseAcceptanceRate].
+	//!
+	//! The raw (unnormalized) area is returned; a perfect classifier
+	//! achieves maxFalseAcceptanceRate.
+	SHARK_EXPORT_SYMBOL double partialAuc(double maxFalseAcceptanceRate)const;
+
+	//! False positive rates of the curve vertices, in order of decreasing threshold.
+	RealVector const& falsePositiveRates()const{
+		return m_falsePositiveRates;
+	}
+
+	//! True positive rates of the curve vertices, in order of decreasing threshold.
+	RealVector const& truePositiveRates()const{
+		return m_truePositiveRates;
+	}
+
+	//! Score thresholds generating the curve vertices, in decreasing order.
+	RealVector const& thresholds()const{
+		return m_thresholds;
+	}
+
+protected:
+	//! sorts the scores and computes curve and area in one sweep
+	SHARK_EXPORT_SYMBOL void computeCurve(std::vector<KeyValuePair<double,unsigned int> >& scores);
+
+	//! vertices of the curve in order of decreasing threshold
+	RealVector m_falsePositiveRates;
+	RealVector m_truePositiveRates;
+	RealVector m_thresholds;
+
+	//! area under the complete curve
+	double m_auc;
+};
+
 }
 #endif
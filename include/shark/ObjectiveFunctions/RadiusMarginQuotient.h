@@ -69,7 +69,7 @@ public:
 
 	/// \brief Constructor.
 	RadiusMarginQuotient(DatasetType const& dataset, KernelType* kernel)
-	: mep_kernel(kernel),m_dataset(dataset)
+	: mep_kernel(kernel),m_dataset(dataset),m_samplingFraction(1.0)
 	{
 		m_features |= HAS_VALUE;
 		if (mep_kernel->hasFirstParameterDerivative())
@@ -81,6 +81,17 @@ public:
 	std::string name() const
 	{ return "RadiusMarginQuotient"; }
 
+	/// \brief Sets the fraction of weight matrix tiles sampled for the derivative.
+	///
+	/// The default of one computes the exact derivative. A smaller fraction
+	/// switches evalDerivative to the unbiased sampled estimate of
+	/// calculateKernelMatrixParameterDerivativeSampled, which avoids the
+	/// second full sweep over all pairs of points.
+	void setDerivativeSamplingFraction(double fraction){
+		SHARK_CHECK(fraction > 0 && fraction <= 1, "fraction must be in (0,1]");
+		m_samplingFraction = fraction;
+	}
+
 	std::size_t numberOfVariables()const{
 		return mep_kernel->numberOfParameters();
 	}
@@ -118,14 +129,20 @@ public:
 		mep_kernel->setParameterVector(parameters);
 
 		Result result = computeRadiusMargin();
-		
-		derivative = calculateKernelMatrixParameterDerivative(
-			*mep_kernel, m_dataset.inputs(),
-			result.w2*(to_diagonal(result.beta)-outer_prod(result.beta,result.beta))
-			-result.R2*outer_prod(result.alpha,result.alpha)
-		);
-		
-		
+
+		RealMatrix weights = result.w2*(to_diagonal(result.beta)-outer_prod(result.beta,result.beta))
+			-result.R2*outer_prod(result.alpha,result.alpha);
+		if(m_samplingFraction < 1.0){
+			derivative = calculateKernelMatrixParameterDerivativeSampled(
+				*mep_kernel, m_dataset.inputs(), weights, m_samplingFraction
+			);
+		}
+		else{
+			derivative = calculateKernelMatrixParameterDerivative(
+				*mep_kernel, m_dataset.inputs(), weights
+			);
+		}
+
 		return result.w2 * result.R2;
 	}
 
@@ -184,7 +201,8 @@ protected:
 	
 	KernelType* mep_kernel;            ///< underlying parameterized kernel object
 	DatasetType m_dataset;                  ///< labeled data for radius and (hard) margin computation
-	
+	double m_samplingFraction;         ///< fraction of tiles sampled for the derivative, 1 means exact
+
 };
 
 
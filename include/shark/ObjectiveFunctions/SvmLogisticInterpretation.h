@@ -32,6 +32,7 @@
 #ifndef SHARK_ML_SVMLOGISTICINTERPRETATION_H
 #define SHARK_ML_SVMLOGISTICINTERPRETATION_H
 
+#include <shark/Core/OpenMP.h>
 #include <shark/Data/CVDatasetTools.h>
 #include <shark/Models/Kernels/CSvmDerivative.h>
 #include <shark/Algorithms/Trainers/SigmoidFit.h>
@@ -75,6 +76,10 @@ protected:
 	bool m_svmCIsUnconstrained; ///< the SVM regularization parameter C is passed for unconstrained optimization, and the derivative should compensate for that
 	QpStoppingCondition *mep_svmStoppingCondition; ///< the stopping criterion that is to be passed to the SVM trainer.
 	bool m_sigmoidSlopeIsUnconstrained; ///< whether or not to use the unconstrained variant of the sigmoid. currently always true, not user-settable, existing for safety.
+	std::vector<LabeledData<InputType, unsigned int> > m_foldTrain; ///< training partition of every fold, materialized once
+	std::vector<LabeledData<InputType, unsigned int> > m_foldValid; ///< validation partition of every fold, materialized once
+	std::vector<std::size_t> m_foldOffsets; ///< start of every fold's validation block in the concatenated score vector
+	mutable std::vector<KernelClassifier<InputType> > m_svms; ///< one machine per fold, kept across evaluations to warm start the solver
 
 public:
 
@@ -105,6 +110,20 @@ public:
 		if (mep_kernel->hasFirstParameterDerivative())
 			m_features|=HAS_FIRST_DERIVATIVE;
 		m_folds = folds;
+		//materialize the fold partitions once. reusing the same data containers
+		//across evaluations lets the trainers warm start from the machine of the
+		//previous hyperparameter candidate instead of solving from scratch.
+		m_foldTrain.resize(m_numFolds);
+		m_foldValid.resize(m_numFolds);
+		m_foldOffsets.resize(m_numFolds);
+		m_svms.resize(m_numFolds);
+		std::size_t offset = 0;
+		for (std::size_t i=0; i<m_numFolds; i++) {
+			m_foldTrain[i] = m_folds.training(i);
+			m_foldValid[i] = m_folds.validation(i);
+			m_foldOffsets[i] = offset;
+			offset += m_foldValid[i].numberOfElements();
+		}
 	}
 
 	/// \brief From INameable: return the class name.
@@ -141,18 +160,19 @@ public:
 		// behind one another, and then used to create datasets with
 		std::vector< unsigned int > tmp_helper_labels(m_numSamples);
 		std::vector< RealVector > tmp_helper_preds(m_numSamples);
-		unsigned int next_label = 0; //helper index counter to monitor the next position to be filled in the above vectors
 
-		// for each fold, train an svm and get predictions on the validation data
-		for (std::size_t i=0; i<m_numFolds; i++) {
+		// for each fold, train an svm and get predictions on the validation data.
+		// the folds are independent and run in parallel; every fold reuses its
+		// machine of the previous evaluation, so the solver continues from the
+		// old alphas instead of starting at zero
+		SHARK_PARALLEL_FOR (int i=0; i<(int)m_numFolds; i++) {
 			// get current train/validation partitions as well as corresponding labels
-			ClassificationDataset cur_train_data = m_folds.training(i);
-			ClassificationDataset cur_valid_data = m_folds.validation(i);
+			ClassificationDataset const& cur_train_data = m_foldTrain[i];
+			ClassificationDataset const& cur_valid_data = m_foldValid[i];
 			std::size_t cur_vsize = cur_valid_data.numberOfElements();
 			Data< unsigned int > cur_vlabels = cur_valid_data.labels(); //validation labels of this fold
 			Data< RealVector > cur_vscores; //will hold SVM output scores for current validation partition
-			// init SVM
-			KernelClassifier<InputType> svm;
+			// init SVM trainer
 			CSvmTrainer<InputType, double> csvm_trainer(mep_kernel, C_reg, true, m_svmCIsUnconstrained);   //the trainer
 			csvm_trainer.sparsify() = false;
 			if (mep_svmStoppingCondition != NULL) {
@@ -162,14 +182,14 @@ public:
 				csvm_trainer.stoppingCondition().maxIterations = 200 * m_inputDims; //mtq: need good/better heuristics to determine a good value for this
 			}
 
-			// train SVM on current fold
-			csvm_trainer.train(svm, cur_train_data);
-			cur_vscores = svm.decisionFunction()(cur_valid_data.inputs());   //will result in a dataset of RealVector as output
+			// train SVM on current fold, warm started from the previous solution
+			csvm_trainer.train(m_svms[i], cur_train_data);
+			cur_vscores = m_svms[i].decisionFunction()(cur_valid_data.inputs());   //will result in a dataset of RealVector as output
 			// copy the scores and corresponding labels to the dataset-wide storage
+			std::size_t offset = m_foldOffsets[i];
 			for (std::size_t j=0; j<cur_vsize; j++) {
-				tmp_helper_labels[next_label] = cur_vlabels.element(j);
-				tmp_helper_preds[next_label] = cur_vscores.element(j);
-				++next_label;
+				tmp_helper_labels[offset+j] = cur_vlabels.element(j);
+				tmp_helper_preds[offset+j] = cur_vscores.element(j);
 			}
 		}
 		Data< unsigned int > all_validation_labels = createDataFromRange(tmp_helper_labels);
@@ -212,22 +232,23 @@ public:
 		std::vector< unsigned int > tmp_helper_labels(m_numSamples);
 		std::vector< RealVector > tmp_helper_preds(m_numSamples);
 
-		unsigned int next_label = 0; //helper index counter to monitor the next position to be filled in the above vectors
 		// init variables especially for derivative
 		RealMatrix all_validation_predict_derivs(m_numSamples, m_nhp);   //will hold derivatives of all output scores w.r.t. all hyperparameters
-		RealVector der; //temporary helper for derivative calls
 
-		// for each fold, train an svm and get predictions on the validation data
-		for (std::size_t i=0; i<m_numFolds; i++) {
+		// for each fold, train an svm and get predictions on the validation data.
+		// the folds are independent and run in parallel; every fold reuses its
+		// machine of the previous evaluation, so the solver continues from the
+		// old alphas instead of starting at zero
+		SHARK_PARALLEL_FOR (int i=0; i<(int)m_numFolds; i++) {
 			// get current train/validation partitions as well as corresponding labels
-			ClassificationDataset cur_train_data = m_folds.training(i);
-			ClassificationDataset cur_valid_data = m_folds.validation(i);
+			ClassificationDataset const& cur_train_data = m_foldTrain[i];
+			ClassificationDataset const& cur_valid_data = m_foldValid[i];
 			std::size_t cur_vsize = cur_valid_data.numberOfElements();
 			Data< unsigned int > cur_vlabels = cur_valid_data.labels(); //validation labels of this fold
 			Data< RealVector > cur_vinputs = cur_valid_data.inputs(); //validation inputs of this fold
 			Data< RealVector > cur_vscores; //will hold SVM output scores for current validation partition
-			// init SVM
-			KernelClassifier<InputType> svm;   //the SVM
+			RealVector der; //temporary helper for derivative calls
+			// init SVM trainer
 			CSvmTrainer<InputType, double> csvm_trainer(mep_kernel, C_reg, true, m_svmCIsUnconstrained);   //the trainer
 			csvm_trainer.sparsify() = false;
 			csvm_trainer.setComputeBinaryDerivative(true);
@@ -236,19 +257,19 @@ public:
 			} else {
 				csvm_trainer.stoppingCondition().maxIterations = 200 * m_inputDims; //mtq: need good/better heuristics to determine a good value for this
 			}
-			// train SVM on current fold
-			csvm_trainer.train(svm, cur_train_data);
-			CSvmDerivative<InputType> svm_deriv(&svm, &csvm_trainer);
-			cur_vscores = svm.decisionFunction()(cur_valid_data.inputs());   //will result in a dataset of RealVector as output
+			// train SVM on current fold, warm started from the previous solution
+			csvm_trainer.train(m_svms[i], cur_train_data);
+			CSvmDerivative<InputType> svm_deriv(&m_svms[i], &csvm_trainer);
+			cur_vscores = m_svms[i].decisionFunction()(cur_valid_data.inputs());   //will result in a dataset of RealVector as output
 			// copy the scores and corresponding labels to the dataset-wide storage
+			std::size_t offset = m_foldOffsets[i];
 			for (std::size_t j=0; j<cur_vsize; j++) {
 				// copy label and prediction score
-				tmp_helper_labels[next_label] = cur_vlabels.element(j);
-				tmp_helper_preds[next_label] = cur_vscores.element(j);
+				tmp_helper_labels[offset+j] = cur_vlabels.element(j);
+				tmp_helper_preds[offset+j] = cur_vscores.element(j);
 				// get and store the derivative of the score w.r.t. the hyperparameters
 				svm_deriv.modelCSvmParameterDerivative(cur_vinputs.element(j), der);
-				noalias(row(all_validation_predict_derivs, next_label)) = der;   //fast assignment of the derivative to the correct matrix row
-				++next_label;
+				noalias(row(all_validation_predict_derivs, offset+j)) = der;   //fast assignment of the derivative to the correct matrix row
 			}
 		}
 		Data< unsigned int > all_validation_labels = createDataFromRange(tmp_helper_labels);
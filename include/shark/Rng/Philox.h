@@ -0,0 +1,232 @@
+/*!
+ *
+ *
+ * \brief       Counter-based random number engine with splittable streams.
+ *
+ *
+ *
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_RNG_PHILOX_H
+#define SHARK_RNG_PHILOX_H
+
+#include <shark/Core/OpenMP.h>
+#include <boost/cstdint.hpp>
+#include <istream>
+#include <ostream>
+
+namespace shark{
+
+/// \brief Counter-based random number engine using the Philox4x32-10 bijection.
+///
+/// Unlike the stateful engines of boost.random, a counter-based engine derives
+/// every block of random numbers by encrypting a plain counter with a keyed
+/// bijection, here the Philox4x32 round function with 10 rounds of
+/// Salmon et al., "Parallel random numbers: as easy as 1, 2, 3" (SC'11).
+/// This makes splitting the generator trivial: engines sharing the same seed
+/// but different stream numbers produce statistically independent sequences
+/// without any communication, which is exactly what parallel algorithms need
+/// for reproducible per-thread random numbers.
+///
+/// The class models the boost random number generator concept, so it can be
+/// used as the engine of all distributions in shark/Rng, e.g.
+/// Uniform<Philox4x32> or as the RngType of an RBM.
+class Philox4x32{
+public:
+	typedef boost::uint32_t result_type;
+
+	/// \brief Creates the engine from a seed and a stream number.
+	///
+	/// Engines constructed with the same seed but different stream numbers
+	/// generate independent sequences.
+	///
+	/// \param seed the seed selecting the key of the bijection
+	/// \param stream the number of the stream to generate
+	explicit Philox4x32(boost::uint64_t seed = 0, boost::uint64_t stream = 0){
+		this->seed(seed);
+		setStream(stream);
+	}
+
+	/// \brief Sets the seed of the engine and restarts its current stream.
+	void seed(boost::uint64_t seed){
+		m_key[0] = static_cast<boost::uint32_t>(seed);
+		m_key[1] = static_cast<boost::uint32_t>(seed >> 32);
+		m_counter = 0;
+		m_blockPos = 4;
+	}
+
+	/// \brief Selects the stream to generate and restarts it.
+	void setStream(boost::uint64_t stream){
+		m_stream = stream;
+		m_counter = 0;
+		m_blockPos = 4;
+	}
+
+	/// \brief Returns the number of the stream the engine generates.
+	boost::uint64_t stream()const{
+		return m_stream;
+	}
+
+	/// \brief Returns a new engine with the same seed generating the given stream.
+	///
+	/// The returned engine is independent of this engine and of every engine
+	/// split off with a different stream number.
+	Philox4x32 split(boost::uint64_t stream)const{
+		Philox4x32 splitRng = *this;
+		splitRng.setStream(stream);
+		return splitRng;
+	}
+
+	/// \brief Returns an engine unique to the calling thread.
+	///
+	/// All threads share the seed set by seed(), but every thread generates
+	/// its own stream selected by its OpenMP thread number. Reseeding through
+	/// the static seed() restarts the streams of all threads.
+	static Philox4x32& threadRng(){
+		thread_local Philox4x32 rng(baseSeed(),SHARK_THREAD_NUM);
+		thread_local boost::uint64_t usedSeed = baseSeed();
+		if(usedSeed != baseSeed()){
+			usedSeed = baseSeed();
+			rng = Philox4x32(usedSeed,SHARK_THREAD_NUM);
+		}
+		return rng;
+	}
+
+	/// \brief Sets the seed of the per-thread engines returned by threadRng().
+	static void seedThreadRngs(boost::uint64_t seed){
+		baseSeed() = seed;
+	}
+
+	/// \brief Generates the next random number of the stream.
+	result_type operator()(){
+		if(m_blockPos == 4){
+			generateBlock();
+		}
+		return m_block[m_blockPos++];
+	}
+
+	/// \brief Smallest value the engine generates.
+	static result_type min(){
+		return 0;
+	}
+	/// \brief Largest value the engine generates.
+	static result_type max(){
+		return 0xFFFFFFFFu;
+	}
+
+	/// \brief Fills a vector with uniform numbers from [0,1) in one call.
+	///
+	/// Every value is assembled from 64 random bits, so the full 53 bit
+	/// mantissa of the doubles is random. This is faster than sampling the
+	/// elements one by one through a distribution object.
+	template<class Vector>
+	void generateUniform(Vector& v){
+		for(std::size_t i = 0; i != v.size(); ++i){
+			boost::uint64_t bits = (*this)();
+			bits = (bits << 32) | (*this)();
+			v(i) = (bits >> 11) * (1.0/9007199254740992.0);//2^-53
+		}
+	}
+
+	friend bool operator==(Philox4x32 const& rng1, Philox4x32 const& rng2){
+		return rng1.m_key[0] == rng2.m_key[0]
+			&& rng1.m_key[1] == rng2.m_key[1]
+			&& rng1.m_stream == rng2.m_stream
+			&& rng1.m_counter == rng2.m_counter
+			&& rng1.m_blockPos == rng2.m_blockPos;
+	}
+	friend bool operator!=(Philox4x32 const& rng1, Philox4x32 const& rng2){
+		return !(rng1 == rng2);
+	}
+
+	/// \brief Writes the state of the engine to a stream.
+	template<class CharT, class Traits>
+	friend std::basic_ostream<CharT,Traits>& operator<<(
+		std::basic_ostream<CharT,Traits>& stream, Philox4x32 const& rng
+	){
+		stream << rng.m_key[0] <<' '<< rng.m_key[1]
+			<<' '<< rng.m_stream <<' '<< rng.m_counter <<' '<< rng.m_blockPos;
+		return stream;
+	}
+	/// \brief Restores the state of the engine from a stream.
+	template<class CharT, class Traits>
+	friend std::basic_istream<CharT,Traits>& operator>>(
+		std::basic_istream<CharT,Traits>& stream, Philox4x32& rng
+	){
+		stream >> rng.m_key[0] >> rng.m_key[1]
+			>> rng.m_stream >> rng.m_counter >> rng.m_blockPos;
+		if(rng.m_blockPos != 4){
+			//regenerate the partially consumed block
+			unsigned int blockPos = rng.m_blockPos;
+			--rng.m_counter;
+			rng.generateBlock();
+			rng.m_blockPos = blockPos;
+		}
+		return stream;
+	}
+
+private:
+	/// \brief Encrypts the current counter into the next block of four numbers.
+	void generateBlock(){
+		boost::uint32_t c0 = static_cast<boost::uint32_t>(m_counter);
+		boost::uint32_t c1 = static_cast<boost::uint32_t>(m_counter >> 32);
+		boost::uint32_t c2 = static_cast<boost::uint32_t>(m_stream);
+		boost::uint32_t c3 = static_cast<boost::uint32_t>(m_stream >> 32);
+		boost::uint32_t k0 = m_key[0];
+		boost::uint32_t k1 = m_key[1];
+		for(unsigned int round = 0; round != 10; ++round){
+			boost::uint64_t product0 = boost::uint64_t(0xD2511F53u) * c0;
+			boost::uint64_t product1 = boost::uint64_t(0xCD9E8D57u) * c2;
+			c0 = static_cast<boost::uint32_t>(product1 >> 32) ^ c1 ^ k0;
+			c1 = static_cast<boost::uint32_t>(product1);
+			c2 = static_cast<boost::uint32_t>(product0 >> 32) ^ c3 ^ k1;
+			c3 = static_cast<boost::uint32_t>(product0);
+			k0 += 0x9E3779B9u;//golden ratio
+			k1 += 0xBB67AE85u;//sqrt(3)-1
+		}
+		m_block[0] = c0;
+		m_block[1] = c1;
+		m_block[2] = c2;
+		m_block[3] = c3;
+		++m_counter;
+		m_blockPos = 0;
+	}
+
+	static boost::uint64_t& baseSeed(){
+		static boost::uint64_t seed = 0;
+		return seed;
+	}
+
+	boost::uint32_t m_key[2];
+	boost::uint64_t m_stream;
+	boost::uint64_t m_counter;
+	boost::uint32_t m_block[4];
+	unsigned int m_blockPos;
+};
+
+}
+
+#endif
@@ -0,0 +1,185 @@
+/*!
+ *
+ *
+ * \brief       Implements a fast Ziggurat sampler for the univariate normal distribution.
+ *
+ *
+ *
+ * \author      -
+ * \date        -
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SHARK_RNG_ZIGGURATNORMAL_H
+#define SHARK_RNG_ZIGGURATNORMAL_H
+
+#include "shark/Rng/Rng.h"
+
+#include <boost/random/uniform_01.hpp>
+
+#include <cmath>
+
+namespace shark {
+
+namespace detail{
+/// \brief Precomputed layer tables of the Ziggurat, shared by all samplers.
+struct ZigguratNormalTables{
+	static const unsigned int blocks = 128;
+	/// the position of the tail cut
+	static double tailStart(){
+		return 3.442619855899;
+	}
+
+	double x[blocks+1];///< right edges of the layers, x[0] is the virtual base layer
+	double edgeRatio[blocks];///< x[i+1]/x[i], acceptance threshold of the rectangular part
+
+	ZigguratNormalTables(){
+		//Construction following Marsaglia&Tsang, "The Ziggurat Method for
+		//Generating Random Variables" in the formulation of Doornik,
+		//"An Improved Ziggurat Method to Generate Normal Random Samples".
+		double const R = tailStart();
+		double const V = 9.91256303526217e-3;//area of every layer
+		double f = std::exp(-0.5 * R * R);
+		x[0] = V / f;//base layer including the tail
+		x[1] = R;
+		x[blocks] = 0;
+		for (unsigned int i = 2; i != blocks; ++i){
+			x[i] = std::sqrt(-2 * std::log(V / x[i-1] + std::exp(-0.5 * x[i-1] * x[i-1])));
+		}
+		for (unsigned int i = 0; i != blocks; ++i){
+			edgeRatio[i] = x[i+1] / x[i];
+		}
+	}
+
+	static ZigguratNormalTables const& instance(){
+		static ZigguratNormalTables tables;
+		return tables;
+	}
+};
+}
+
+/// \brief Samples normally distributed numbers using the Ziggurat method.
+///
+/// The Ziggurat method covers the normal density by a pile of equal-area
+/// rectangles. Nearly every sample only costs one uniform number, a table
+/// lookup and a comparison; the logarithms and square roots of the Box-Muller
+/// transform used by Normal are only needed in the rare wedge and tail cases.
+/// This makes the sampler considerably faster when normal numbers are drawn in
+/// bulk, e.g. for offspring sampling in evolutionary algorithms.
+///
+/// The sampler works with every engine modelling the boost random number
+/// generator concept, including the counter-based Philox4x32.
+/// For backwards compatibility with older shark versions instead of the
+/// standard deviation sigma the variance=sigma^2 is used as argument, as in
+/// Normal.
+template<typename RngType = DefaultRngType>
+class ZigguratNormal{
+public:
+	/// constructor
+	/// \param rng: random number generator
+	/// \param mean: mean of distribution
+	/// \param variance: variance of distribution
+	ZigguratNormal( RngType & rng, double mean = 0., double variance = 1. )
+	: mpe_rng(&rng), m_mean(mean), m_sigma(std::sqrt(variance)){}
+
+	/// \brief Draws a normally distributed number.
+	double operator()(){
+		return m_mean + m_sigma * standard();
+	}
+
+	double mean()const{
+		return m_mean;
+	}
+	double variance()const{
+		return m_sigma * m_sigma;
+	}
+	void mean(double newMean){
+		m_mean = newMean;
+	}
+	void variance(double newVariance){
+		m_sigma = std::sqrt(newVariance);
+	}
+
+	/// \brief Fills a whole vector with normally distributed numbers in one call.
+	template<class Vector>
+	void generate(Vector& v){
+		for(std::size_t i = 0; i != v.size(); ++i){
+			v(i) = m_mean + m_sigma * standard();
+		}
+	}
+
+	/// \brief Fills a whole matrix with normally distributed numbers in one call.
+	template<class Matrix>
+	void generateMatrix(Matrix& m){
+		for(std::size_t i = 0; i != m.size1(); ++i){
+			for(std::size_t j = 0; j != m.size2(); ++j){
+				m(i,j) = m_mean + m_sigma * standard();
+			}
+		}
+	}
+
+private:
+	/// \brief Draws a number from the standard normal distribution.
+	double standard(){
+		detail::ZigguratNormalTables const& tables = detail::ZigguratNormalTables::instance();
+		for(;;){
+			//split one uniform number into the layer index (top 7 bits)
+			//and a uniform number on [-1,1) (remaining mantissa bits)
+			double scaled = detail::ZigguratNormalTables::blocks * m_uni(*mpe_rng);
+			unsigned int i = static_cast<unsigned int>(scaled);
+			double u = 2.0 * (scaled - i) - 1.0;
+
+			//inside the rectangular part of the layer - the common case
+			if(std::abs(u) < tables.edgeRatio[i])
+				return u * tables.x[i];
+			//base layer: sample from the tail of the distribution
+			if(i == 0)
+				return sampleTail(u < 0);
+			//wedge of the layer: accept by comparing with the density
+			double x = u * tables.x[i];
+			double f0 = std::exp(-0.5 * (tables.x[i] * tables.x[i] - x * x));
+			double f1 = std::exp(-0.5 * (tables.x[i+1] * tables.x[i+1] - x * x));
+			if(f1 + m_uni(*mpe_rng) * (f0 - f1) < 1.0)
+				return x;
+		}
+	}
+
+	/// \brief Samples from the normal tail beyond the last layer (Marsaglia's method).
+	double sampleTail(bool negative){
+		double const R = detail::ZigguratNormalTables::tailStart();
+		double x, y;
+		do{
+			x = std::log(m_uni(*mpe_rng)) / R;
+			y = std::log(m_uni(*mpe_rng));
+		}while(-2 * y < x * x);
+		return negative? x - R : R - x;
+	}
+
+	RngType* mpe_rng;
+	double m_mean;
+	double m_sigma;
+	boost::uniform_01<double> m_uni;
+};
+
+} // namespace shark {
+
+#endif // SHARK_RNG_ZIGGURATNORMAL_H
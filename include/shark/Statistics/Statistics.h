@@ -35,6 +35,7 @@
 
 //for vector algebra
 #include <shark/LinAlg/Base.h>
+#include <shark/Core/OpenMP.h>
 
 //handling of missing values
 #include <limits>
@@ -43,6 +44,9 @@
 //for quantiles
 #include <boost/range/algorithm/nth_element.hpp>
 
+//for bootstrap resampling
+#include <shark/Rng/GlobalRng.h>
+
 
 //for the result table
 #include <string>
@@ -101,8 +105,9 @@ public:
 		std::size_t N = points.size();
 		RealVector sum(points[0].size(),0.0);
 		UIntVector numSamples(points[0].size(),0);
-		for(std::size_t i  = 0; i != N;++i){
-			for(std::size_t j = 0; j != sum.size(); ++j){
+		//dimensions are independent, so they are processed in parallel
+		SHARK_PARALLEL_FOR(int j = 0; j < (int)sum.size(); ++j){
+			for(std::size_t i  = 0; i != N;++i){
 				if(isMissing(points[i](j)))continue;
 				sum(j) += points[i](j);
 				++numSamples(j);
@@ -121,19 +126,26 @@ public:
 	}
 	RealVector statistics(std::vector<RealVector> const& points)const{
 		std::size_t N = points.size();
-		Mean m;
-		RealVector mean = m.statistics(points);
-		RealVector variance(mean.size(),0.0);
-		UIntVector numSamples(points[0].size(),0);
-		for(std::size_t i  = 0; i != N;++i){
-			for(std::size_t j = 0; j != mean.size(); ++j){
+		RealVector variance(points[0].size(),missingValue());
+		//one parallel pass: every dimension is reduced independently with
+		//the numerically stable Welford update instead of computing the
+		//mean in a separate first sweep
+		SHARK_PARALLEL_FOR(int j = 0; j < (int)variance.size(); ++j){
+			double mean = 0.0;
+			double sumSqrDeviation = 0.0;
+			std::size_t numSamples = 0;
+			for(std::size_t i  = 0; i != N;++i){
 				if(isMissing(points[i](j)))continue;
-				variance(j) += sqr(points[i](j)-mean(j));
-				++numSamples(j);
+				++numSamples;
+				double delta = points[i](j)-mean;
+				mean += delta/numSamples;
+				sumSqrDeviation += delta*(points[i](j)-mean);
 			}
+			//biased variance. if the number of non-missing points was 0, the dimension stays missingValue()
+			if(numSamples != 0)
+				variance(j) = sumSqrDeviation/numSamples;
 		}
-		//calculate biased variance. if the number of non-missing points was 0, return missingValue() for that dimension
-		return safe_div(variance,numSamples,missingValue());
+		return variance;
 	}
 };
 
@@ -189,6 +201,81 @@ public:
 	UpperQuantile():Quantile(0.75){}
 };
 
+///\brief Percentile bootstrap for the statistics objects above.
+///
+/// Replicates are drawn by resampling point indices with replacement and
+/// the statistic is evaluated once per replicate. The replicates are
+/// computed in parallel; every replicate uses its own generator seeded
+/// from the global Rng, so the result does not depend on the schedule
+/// of the threads.
+class Bootstrap{
+public:
+	Bootstrap(std::size_t numReplicates = 1000, double confidence = 0.95)
+	:m_numReplicates(numReplicates),m_confidence(confidence){
+		RANGE_CHECK(numReplicates > 0);
+		RANGE_CHECK(confidence > 0.0 && confidence < 1.0);
+	}
+
+	std::size_t numReplicates()const{
+		return m_numReplicates;
+	}
+
+	double confidence()const{
+		return m_confidence;
+	}
+
+	///\brief Computes the statistic of every replicate, one row per replicate
+	RealMatrix replicates(BaseStatisticsObject const& statistic, std::vector<RealVector> const& points)const{
+		std::size_t N = points.size();
+		RealMatrix results(m_numReplicates,points[0].size());
+		std::size_t baseSeed = Rng::discrete(0,std::numeric_limits<int>::max());
+		SHARK_PARALLEL_FOR(int r = 0; r < (int)m_numReplicates; ++r){
+			Rng::rng_type rng(m_numReplicates*baseSeed+r);
+			DiscreteUniform<Rng::rng_type> uniform(rng,0,N-1);
+			//gather the replicate by index; the points themselves are shared
+			std::vector<RealVector> resample(N);
+			for(std::size_t i = 0; i != N; ++i)
+				resample[i] = points[uniform()];
+			noalias(row(results,r)) = statistic.statistics(resample);
+		}
+		return results;
+	}
+
+	///\brief Computes for every dimension the percentile confidence interval of the statistic
+	///
+	/// Returns the lower and upper bounds as a pair of vectors. Dimensions
+	/// for which every replicate is missing stay missingValue().
+	std::pair<RealVector,RealVector> confidenceInterval(
+		BaseStatisticsObject const& statistic, std::vector<RealVector> const& points
+	)const{
+		RealMatrix results = replicates(statistic,points);
+		double alpha = 1.0 - m_confidence;
+		RealVector lower(results.size2(),missingValue());
+		RealVector upper(results.size2(),missingValue());
+		for(std::size_t j = 0; j != results.size2(); ++j){
+			//get all non-missing replicates of the j-th dimension
+			std::vector<double> values;
+			for(std::size_t r = 0; r != results.size1(); ++r){
+				if(isMissing(results(r,j)))continue;
+				values.push_back(results(r,j));
+			}
+			if(values.size() == 0) continue;//no values-> missing value
+
+			std::vector<double>::iterator pos = values.begin()+std::size_t(values.size()*alpha/2.0);
+			boost::nth_element(values,pos);
+			lower(j) = *pos;
+			pos = values.begin()+std::size_t(values.size()*(1.0-alpha/2.0));
+			if(pos == values.end()) --pos;
+			boost::nth_element(values,pos);
+			upper(j) = *pos;
+		}
+		return std::make_pair(lower,upper);
+	}
+private:
+	std::size_t m_numReplicates;
+	double m_confidence;
+};
+
 
 ///\brief Stores results of a running experiment
 ///
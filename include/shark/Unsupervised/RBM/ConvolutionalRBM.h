@@ -193,26 +193,26 @@ public:
 		return m_filters.size();
 	}
 	std::size_t filterSize1()const{
-		return m_filters.size1();
+		return m_filters.empty()? 0: m_filters[0].size1();
 	}
 	std::size_t filterSize2()const{
-		return m_filters.size2();
+		return m_filters.empty()? 0: m_filters[0].size2();
 	}
-	
+
 	std::size_t inputSize1()const{
 		return m_inputSize1;
 	}
-	
+
 	std::size_t inputSize2()const{
 		return m_inputSize2;
 	}
-	
-	
+
+
 	std::size_t responseSize1()const{
-		return m_inputSize1-m_filters.size1()+1;
+		return m_inputSize1-filterSize1()+1;
 	}
 	std::size_t responseSize2()const{
-		return m_inputSize2-m_filters.size2()+1;
+		return m_inputSize2-filterSize2()+1;
 	}
 	
 	///\brief Returns the weight matrix connecting the layers.
@@ -282,62 +282,99 @@ public:
 	
 	///\brief Calculates the input of the hidden neurons given the state of the visible in a batch-vise fassion.
 	///
+	///The convolution is lowered onto a matrix-matrix product: the receptive fields of the
+	///image are unrolled into the rows of a patch matrix (im2col) which is then multiplied
+	///with all filters at once. The workspaces are reused for every element of the batch.
+	///
 	///@param inputs the batch of vectors the input of the hidden neurons is stored in
 	///@param visibleStates the batch of states of the visible neurons
 	void inputHidden(RealMatrix& inputs, RealMatrix const& visibleStates)const{
 		SIZE_CHECK(visibleStates.size1() == inputs.size1());
 		SIZE_CHECK(inputs.size2() == numberOfHN());
 		SIZE_CHECK( visibleStates.size2() == numberOfVN());
-		inputs.clear();
+		std::size_t numPatches = responseSize1()*responseSize2();
+		std::size_t patchSize = filterSize1()*filterSize2();
 
+		//flatten the filters into the rows of a single matrix
+		RealMatrix filterMatrix(m_filters.size(),patchSize);
+		for(std::size_t f = 0; f != m_filters.size();++f){
+			noalias(to_matrix(row(filterMatrix,f),filterSize1(),filterSize2())) = m_filters[f];
+		}
+
+		RealMatrix patches(numPatches,patchSize);
+		RealMatrix responseMatrix(m_filters.size(),numPatches);
 		for(std::size_t i= 0; i != inputs.size1();++i){
-			blas::dense_matrix_adaptor<double const> visibleState = 
+			blas::dense_matrix_adaptor<double const> visibleState =
 				to_matrix(row(visibleStates,i),inputSize1(),inputSize2());
-			blas::dense_matrix_adaptor<double> responses = 
+			blas::dense_matrix_adaptor<double> responses =
 				to_matrix(row(inputs,i),m_filters.size()*responseSize1(),responseSize2());
-			
+
+			//im2col: unroll the receptive field of every response position into a row
 			for (std::size_t x1=0; x1 != responseSize1(); ++x1) {
 				for (std::size_t x2=0; x2 != responseSize2(); ++x2) {
-					std::size_t end1= x1+m_filters.size1();
-					std::size_t end2= x2+m_filters.size2();
-					for(std::size_t f = 0; f != m_filters.size();++f){
-						responses(f*responseSize1()+x1,x2)=sum(m_filters[f]*subrange(visibleState,x1,end1,x2,end2));
+					std::size_t patch = x1*responseSize2()+x2;
+					for(std::size_t f1 = 0; f1 != filterSize1();++f1){
+						noalias(subrange(row(patches,patch),f1*filterSize2(),(f1+1)*filterSize2()))
+							= subrange(row(visibleState,x1+f1),x2,x2+filterSize2());
 					}
 				}
 			}
+			//all filter responses at all positions as a single gemm
+			noalias(responseMatrix) = prod(filterMatrix,trans(patches));
+			//every row of the response matrix is the response image of one filter
+			for(std::size_t f = 0; f != m_filters.size();++f){
+				noalias(subrange(responses,f*responseSize1(),(f+1)*responseSize1(),0,responseSize2()))
+					= to_matrix(row(responseMatrix,f),responseSize1(),responseSize2());
+			}
 		}
 	}
 
 
 	///\brief Calculates the input of the visible neurons given the state of the hidden.
 	///
+	///The transposed convolution is lowered onto a matrix-matrix product of the hidden
+	///states with the flattened filters; the resulting per-position patches are then
+	///scattered back onto the image (col2im). The workspaces are reused for every
+	///element of the batch.
+	///
 	///@param inputs the vector the input of the visible neurons is stored in
 	///@param hiddenStates the state of the hidden neurons
 	void inputVisible(RealMatrix& inputs, RealMatrix const& hiddenStates)const{
 		SIZE_CHECK(hiddenStates.size1() == inputs.size1());
 		SIZE_CHECK(inputs.size2() == numberOfVN());
 		SIZE_CHECK(hiddenStates.size2() == numberOfHN());
-		typedef blas::dense_matrix_adaptor<double> Response;
 		inputs.clear();
-		
-		//we slightly optimize this routine by checking whether the hiddens are 0 -
-		//this is likely when the hiddens are binary.
+		std::size_t numPatches = responseSize1()*responseSize2();
+		std::size_t patchSize = filterSize1()*filterSize2();
+
+		//flatten the filters into the rows of a single matrix
+		RealMatrix filterMatrix(m_filters.size(),patchSize);
+		for(std::size_t f = 0; f != m_filters.size();++f){
+			noalias(to_matrix(row(filterMatrix,f),filterSize1(),filterSize2())) = m_filters[f];
+		}
+
+		RealMatrix hiddenMatrix(m_filters.size(),numPatches);
+		RealMatrix patchInputs(numPatches,patchSize);
 		for(std::size_t i= 0; i != inputs.size1();++i){
-			blas::dense_matrix_adaptor<double const> hiddenState = 
+			blas::dense_matrix_adaptor<double const> hiddenState =
 				to_matrix(row(hiddenStates,i),responseSize1()*m_filters.size(),responseSize2());
-			Response responses = 
+			blas::dense_matrix_adaptor<double> responses =
 				to_matrix(row(inputs,i),m_inputSize1,m_inputSize2);
-			
+
+			//every row of the hidden matrix is the response image of one filter
+			for(std::size_t f = 0; f != m_filters.size();++f){
+				noalias(to_matrix(row(hiddenMatrix,f),responseSize1(),responseSize2()))
+					= subrange(hiddenState,f*responseSize1(),(f+1)*responseSize1(),0,responseSize2());
+			}
+			//sum the filters weighted by their responses for all positions as a single gemm
+			noalias(patchInputs) = prod(trans(hiddenMatrix),filterMatrix);
+			//col2im: scatter the per-position patches back onto the image
 			for (std::size_t x1=0; x1 != responseSize1(); ++x1) {
 				for (std::size_t x2=0; x2 != responseSize2(); ++x2) {
-					std::size_t end1= x1+m_filters.size1();
-					std::size_t end2= x2+m_filters.size2();
-					blas::matrix_range<Response> receptiveArea = subrange(responses,x1,end1,x2,end2);
-						
-					for(std::size_t f = 0; f != m_filters.size();++f){
-						double neuronResponse = hiddenState(f*responseSize1()+x1,x2);
-						if(neuronResponse == 0.0) continue;
-						noalias(receptiveArea) += neuronResponse * m_filters[f];
+					std::size_t patch = x1*responseSize2()+x2;
+					for(std::size_t f1 = 0; f1 != filterSize1();++f1){
+						noalias(subrange(row(responses,x1+f1),x2,x2+filterSize2()))
+							+= subrange(row(patchInputs,patch),f1*filterSize2(),(f1+1)*filterSize2());
 					}
 				}
 			}
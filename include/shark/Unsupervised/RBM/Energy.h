@@ -116,16 +116,11 @@ struct Energy{
 	)const{
 		SIZE_CHECK(hiddenState.size1()==visibleInput.size1());
 		SIZE_CHECK(hiddenState.size1()==beta.size());
-		std::size_t batchSize = size(hiddenState);
-		
-		//calculate the energy terms of the hidden neurons for the whole batch
-		RealVector energyTerms = m_hiddenNeurons.energyTerm(hiddenState,beta);
-
-		//calculate resulting probabilities in sequence
-		RealVector p(batchSize);
-		for(std::size_t i = 0; i != batchSize; ++i){
-			p(i) = m_visibleNeurons.logMarginalize(row(visibleInput,i),beta(i))+energyTerms(i);
-		}
+
+		//marginalize over the visible neurons and add the energy terms of the hidden neurons,
+		//both for the whole batch at once
+		RealVector p = m_visibleNeurons.logMarginalize(visibleInput,beta);
+		noalias(p) += m_hiddenNeurons.energyTerm(hiddenState,beta);
 		return p;
 	}
 
@@ -145,15 +140,11 @@ struct Energy{
 	)const{
 		SIZE_CHECK(visibleState.size1()==hiddenInput.size1());
 		SIZE_CHECK(visibleState.size1()==beta.size());
-		std::size_t batchSize = size(visibleState);
-		
-		//calculate the energy terms of the visible neurons for the whole batch
-		RealVector energyTerms = m_visibleNeurons.energyTerm(visibleState,beta);
-		
-		RealVector p(batchSize);
-		for(std::size_t i = 0; i != batchSize; ++i){
-			p(i) = m_hiddenNeurons.logMarginalize(row(hiddenInput,i),beta(i))+energyTerms(i);
-		}
+
+		//marginalize over the hidden neurons and add the energy terms of the visible neurons,
+		//both for the whole batch at once
+		RealVector p = m_hiddenNeurons.logMarginalize(hiddenInput,beta);
+		noalias(p) += m_visibleNeurons.energyTerm(visibleState,beta);
 		return p;
 	}
 
@@ -196,10 +187,9 @@ struct Energy{
 	)const{
 		RealMatrix const& phiOfH = m_hiddenNeurons.phi(hidden);
 		std::size_t batchSize = size(hiddenInput);
-		RealVector energies(batchSize);
-		for(std::size_t i = 0; i != batchSize; ++i){
-			energies(i) = -inner_prod(row(hiddenInput,i),row(phiOfH,i));
-		}
+		//the interaction term is the row-wise inner product of input and phi,
+		//computed as one fused matrix expression for the whole batch
+		RealVector energies = -sum_columns(hiddenInput*phiOfH);
 		energies -= m_hiddenNeurons.energyTerm(hidden,blas::repeat(1.0,batchSize));
 		energies -= m_visibleNeurons.energyTerm(visible,blas::repeat(1.0,batchSize));
 		return energies;
@@ -218,10 +208,9 @@ struct Energy{
 	)const{
  		RealMatrix const& phiOfV = m_visibleNeurons.phi(visible);
 		std::size_t batchSize = size(visibleInput);
-		RealVector energies(batchSize);
-		for(std::size_t i = 0; i != batchSize; ++i){
-			energies(i) = -inner_prod(row(phiOfV,i),row(visibleInput,i));
-		}
+		//the interaction term is the row-wise inner product of input and phi,
+		//computed as one fused matrix expression for the whole batch
+		RealVector energies = -sum_columns(visibleInput*phiOfV);
 		energies -= m_hiddenNeurons.energyTerm(hidden,blas::repeat(1.0,batchSize));
 		energies -= m_visibleNeurons.energyTerm(visible,blas::repeat(1.0,batchSize));
 		return energies;
@@ -30,6 +30,7 @@
 #ifndef SHARK_UNSUPERVISED_RBM_GRADIENTAPPROXIMATIONS_MULTICHAINAPPROXIMATOR_H
 #define SHARK_UNSUPERVISED_RBM_GRADIENTAPPROXIMATIONS_MULTICHAINAPPROXIMATOR_H
 
+#include <shark/Core/OpenMP.h>
 #include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
 #include "Impl/DataEvaluator.h"
 #include <vector>
@@ -135,22 +136,43 @@ public:
 	
 	double evalDerivative( SearchPointType const & parameter, FirstOrderDerivative & derivative ) const {
 		mpe_rbm->setParameterVector(parameter);
-		
-		typename RBM::GradientType modelAverage(mpe_rbm);
+
 		RealVector empiricalAverage = detail::evaluateData(m_data,*mpe_rbm,m_numBatches);
-		
+		derivative.resize(mpe_rbm->numberOfParameters());
+		noalias(derivative) = -empiricalAverage;
+
 		//approximate the expectation of the energy gradient with respect to the model distribution
-		//using samples from the Markov chain
-		for(std::size_t i = 0; i != m_chains.size();++i){
-			swap(m_chains[i],m_chainOperator.samples());//set the current GibbsChain
-			m_chainOperator.step(m_k);//do the next step along the gibbs chain
-			modelAverage.addVH(m_chainOperator.samples().hidden, m_chainOperator.samples().visible);//update gradient
-			swap(m_chains[i],m_chainOperator.samples());//save the GibbsChain.
+		//using samples from the ensemble of Markov chains. the chains are independent, so every
+		//thread can advance its share of them with its own transition operator and accumulate
+		//the model average locally before merging.
+		std::size_t numChainBatches = m_chains.size();
+		std::size_t totalSamples = 0;
+		for(std::size_t i = 0; i != numChainBatches; ++i){
+			totalSamples += m_chains[i].size();
 		}
-		
-		derivative.resize(mpe_rbm->numberOfParameters());
-		noalias(derivative) = modelAverage.result() - empiricalAverage;
-		
+		std::size_t threads = std::min<std::size_t>(numChainBatches,SHARK_NUM_THREADS);
+		std::size_t batchesPerThread = numChainBatches/threads;
+
+		SHARK_PARALLEL_FOR(int t = 0; t < (int)threads; ++t){
+			MarkovChainType chainOperator(mpe_rbm);
+			typename RBM::GradientType modelAverage(mpe_rbm);
+			std::size_t threadSamples = 0;
+
+			std::size_t batchStart = t*batchesPerThread;
+			std::size_t batchEnd = (t == (int)threads-1)? numChainBatches: batchStart+batchesPerThread;
+			for(std::size_t i = batchStart; i != batchEnd;++i){
+				swap(m_chains[i],chainOperator.samples());//set the current GibbsChain
+				chainOperator.step(m_k);//do the next step along the gibbs chain
+				modelAverage.addVH(chainOperator.samples().hidden, chainOperator.samples().visible);//update gradient
+				threadSamples += chainOperator.samples().size();
+				swap(m_chains[i],chainOperator.samples());//save the GibbsChain.
+			}
+			SHARK_CRITICAL_REGION{
+				double weight = threadSamples/double(totalSamples);
+				noalias(derivative) += weight*modelAverage.result();
+			}
+		}
+
 		if(m_regularizer){
 			FirstOrderDerivative regularizerDerivative;
 			m_regularizer->evalDerivative(parameter,regularizerDerivative);
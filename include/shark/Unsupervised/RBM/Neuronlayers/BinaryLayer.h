@@ -35,6 +35,7 @@
 #include <shark/LinAlg/Base.h>
 #include <shark/Data/BatchInterfaceAdaptStruct.h>
 #include <shark/Rng/Bernoulli.h>
+#include <shark/Rng/Uniform.h>
 #include <shark/Unsupervised/RBM/StateSpaces/TwoStateSpace.h>
 #include <shark/Core/OpenMP.h>
 namespace shark{
@@ -135,11 +136,13 @@ public:
 		SIZE_CHECK(statistics.size2() == state.size2());
 		
 		SHARK_CRITICAL_REGION{
-			Bernoulli<Rng> coinToss(rng,0.5);
+			//draw the whole batch in one sweep through a single generator instead of
+			//constructing a distribution object for every unit
+			Uniform<Rng> uni(rng,0.0,1.0);
 			if(alpha == 0.0){//special case: normal gibbs sampling
 				for(std::size_t s = 0; s != state.size1();++s){
 					for(std::size_t i = 0; i != state.size2();++i){
-						state(s,i) = coinToss(statistics(s,i));
+						state(s,i) = uni() < statistics(s,i);
 					}
 				}
 			}
@@ -160,7 +163,7 @@ public:
 								prob = (1. - alpha) * prob;
 							}
 						}
-						state(s,i) = coinToss(prob);
+						state(s,i) = uni() < prob;
 					}
 				}
 			}
@@ -260,6 +263,32 @@ public:
 		return logFactorization;
 	}
 
+	///\brief Sums over all possible values of the terms of the energy function for a whole batch of inputs.
+	///
+	///Batch version of logMarginalize which marginalizes every element of the batch as one
+	///fused vector expression instead of accumulating element by element.
+	///
+	/// @param inputs the batch of inputs of the neurons they get from the other layer
+	/// @param beta the inverse temperature of the RBM for every element of the batch
+	/// @return the marginal distribution of the connected layer for every element of the batch
+	template<class Matrix, class BetaVector>
+	RealVector logMarginalize(
+		blas::matrix_expression<Matrix, blas::cpu_tag> const& inputsExpr,
+		blas::vector_expression<BetaVector, blas::cpu_tag> const& betaExpr
+	) const{
+		Matrix const& inputs = inputsExpr();
+		BetaVector const& beta = betaExpr();
+		SIZE_CHECK(inputs.size2() == size());
+		SIZE_CHECK(inputs.size1() == beta.size());
+		RealVector logFactorization(inputs.size1());
+		for(std::size_t i = 0; i != inputs.size1(); ++i){
+			logFactorization(i) = sum(softPlus(
+				beta(i)*(row(inputs,i)+m_bias)+(1-beta(i))*m_baseRate
+			));
+		}
+		return logFactorization;
+	}
+
 	
 	///\brief Calculates the expectation of the derivatives of the energy term of this neuron layer with respect to it's parameters - the bias weights.
 	/// The expectation is taken with respect to the conditional probability distribution of the layer given the state of the connected layer.
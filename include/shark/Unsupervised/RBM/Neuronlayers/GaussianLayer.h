@@ -113,10 +113,13 @@ public:
 		SIZE_CHECK(statistics.size2() == state.size2());
 		
 		SHARK_CRITICAL_REGION{
+			//draw the whole batch from a single standard normal generator and shift by the
+			//means; constructing a generator per unit would also throw away the second
+			//variate of every Box-Muller pair
+			Normal<Rng> normal(rng,0.0,1.0);
 			for(std::size_t i = 0; i != state.size1();++i){
 				for(std::size_t j = 0; j != state.size2();++j){
-					Normal<Rng> normal(rng,statistics(i,j),1.0);
-					state(i,j) = normal();
+					state(i,j) = statistics(i,j) + normal();
 				}
 			}
 		}
@@ -219,6 +222,31 @@ public:
 		return lnResult;
 	}
 
+	///\brief Sums over all possible values of the terms of the energy function for a whole batch of inputs.
+	///
+	///Batch version of logMarginalize which marginalizes every element of the batch as one
+	///fused vector expression instead of accumulating element by element.
+	///
+	/// @param inputs the batch of inputs of the neurons they get from the other layer
+	/// @param beta the inverse temperature of the RBM for every element of the batch
+	/// @return the marginal distribution of the connected layer for every element of the batch
+	template<class Matrix, class BetaVector>
+	RealVector logMarginalize(
+		blas::matrix_expression<Matrix, blas::cpu_tag> const& inputsExpr,
+		blas::vector_expression<BetaVector, blas::cpu_tag> const& betaExpr
+	) const{
+		Matrix const& inputs = inputsExpr();
+		BetaVector const& beta = betaExpr();
+		SIZE_CHECK(inputs.size2() == size());
+		SIZE_CHECK(inputs.size1() == beta.size());
+		RealVector logFactorization(inputs.size1());
+		for(std::size_t i = 0; i != inputs.size1(); ++i){
+			logFactorization(i) = 0.5*beta(i)*sum(sqr(row(inputs,i)+m_bias));
+			logFactorization(i) += size()*(std::log(SQRT_2_PI) - 0.5 * std::log(beta(i)));
+		}
+		return logFactorization;
+	}
+
 
 	///\brief Calculates the expectation of the derivatives of the energy term of this neuron layer with respect to it's parameters - the bias weights.
 	/// The expectation is taken with respect to the conditional probability distribution of the layer given the state of the connected layer.
@@ -37,7 +37,9 @@
 #include <shark/Unsupervised/RBM/StateSpaces/RealSpace.h>
 #include <shark/Unsupervised/RBM/Tags.h>
 #include <shark/Rng/TruncatedExponential.h>
+#include <shark/Rng/Uniform.h>
 #include <shark/Core/OpenMP.h>
+#include <cmath>
 namespace shark{
 namespace detail{
 template<class VectorType>
@@ -143,11 +145,19 @@ public:
 		SIZE_CHECK(statistics.lambda.size2() == state.size2());
 		
 		SHARK_CRITICAL_REGION{
+			//invert the cdf on uniform draws from a single generator instead of
+			//constructing a TruncatedExponential generator for every unit
+			Uniform<Rng> uni(rng,0.0,1.0);
 			for(std::size_t i = 0; i != state.size1();++i){
 				for(std::size_t j = 0; j != state.size2();++j){
-					double integral = 1.0 - statistics.expMinusLambda(i,j);
-					TruncatedExponential<Rng> truncExp(integral,rng,statistics.lambda(i,j));
-					state(i,j) = truncExp();
+					double lambda = statistics.lambda(i,j);
+					double y = uni();
+					if(lambda == 0.0){//distribution is uniform on [0,1]
+						state(i,j) = y;
+					}else{
+						double integral = 1.0 - statistics.expMinusLambda(i,j);
+						state(i,j) = - std::log(1. - y*integral)/lambda;
+					}
 				}
 			}
 		}
@@ -235,6 +245,38 @@ public:
 		return lnResult;
 	}
 
+	///\brief Sums over all possible values of the terms of the energy function for a whole batch of inputs.
+	///
+	///Batch version of logMarginalize. The branches in the stable evaluation of
+	///log( (exp(a)-1)/a ) prevent a fused vector expression, but the batch is still
+	///marginalized in one pass without per-element function call overhead.
+	///
+	/// @param inputs the batch of inputs of the neurons they get from the other layer
+	/// @param beta the inverse temperature of the RBM for every element of the batch
+	/// @return the marginal distribution of the connected layer for every element of the batch
+	template<class Matrix, class BetaVector>
+	RealVector logMarginalize(
+		blas::matrix_expression<Matrix, blas::cpu_tag> const& inputsExpr,
+		blas::vector_expression<BetaVector, blas::cpu_tag> const& betaExpr
+	) const{
+		Matrix const& inputs = inputsExpr();
+		BetaVector const& beta = betaExpr();
+		SIZE_CHECK(inputs.size2() == size());
+		SIZE_CHECK(inputs.size1() == beta.size());
+		RealVector logFactorization(inputs.size1(),0.0);
+		for(std::size_t i = 0; i != inputs.size1(); ++i){
+			for(std::size_t j = 0; j != size(); ++j){
+				double a = (inputs(i,j)+m_bias(j))*beta(i);
+				if( a > 1.e-50)
+					logFactorization(i) += a+std::log(1.0 - std::exp(-a));
+				else if( a < 1.e-50)
+					logFactorization(i) += std::log( 1.0 - std::exp(a));
+				logFactorization(i) -= std::log(std::abs(a));
+			}
+		}
+		return logFactorization;
+	}
+
 	
 	///\brief Calculates the expectation of the derivatives of the energy term of this neuron layer with respect to it's parameters - the bias weights.
 	/// The expectation is taken with respect to the conditional probability distribution of the layer given the state of the connected layer.
@@ -71,19 +71,22 @@ private:
 	RealVector m_betas;
 	Operator m_operator;
 	
-	void metropolisSwap(reference low, double betaLow, reference high, double betaHigh){
-		RealVector const& baseRate = transitionOperator().rbm()->visibleNeurons().baseRate();
+	bool metropolisSwap(
+		reference low, double betaLow, double baseRateLow,
+		reference high, double betaHigh, double baseRateHigh,
+		Uniform<typename RBM::RngType>& uni
+	){
 		double betaDiff = betaLow - betaHigh;
-		double energyDiff = low.energy - high.energy; 
-		double baseRateDiff = inner_prod(low.visible.state,baseRate) -  inner_prod(high.visible.state,baseRate); 
+		double energyDiff = low.energy - high.energy;
+		double baseRateDiff = baseRateLow - baseRateHigh;
 		double r = betaDiff * energyDiff + betaDiff*baseRateDiff;
-		
-		
-		Uniform<typename RBM::RngType> uni(m_operator.rbm()->rng(),0,1);
+
 		double z = uni();
 		if( r >= 0 || (z > 0 && std::log(z) < r) ){
 			swap(high,low);
+			return true;
 		}
+		return false;
 	}
 
 public:
@@ -204,19 +207,30 @@ public:
 				m_temperedChains.visible 
 			);
 
+			//compute the base rate energies of all replicas with a single
+			//matrix-vector product instead of two inner products per swap attempt
+			RealVector baseRateEnergy = prod(
+				m_temperedChains.visible.state,
+				m_operator.rbm()->visibleNeurons().baseRate()
+			);
+			Uniform<typename RBM::RngType> uni(m_operator.rbm()->rng(),0,1);
+
 			//EVEN phase
 			std::size_t elems = m_temperedChains.size();
 			for(std::size_t i = 0; i < elems-1; i+=2){
-				metropolisSwap(
-					reference(m_temperedChains,i),m_betas(i),
-					reference(m_temperedChains,i+1),m_betas(i+1)
+				bool swapped = metropolisSwap(
+					reference(m_temperedChains,i),m_betas(i),baseRateEnergy(i),
+					reference(m_temperedChains,i+1),m_betas(i+1),baseRateEnergy(i+1),
+					uni
 				);
+				if(swapped) std::swap(baseRateEnergy(i),baseRateEnergy(i+1));
 			}
 			//ODD phase
 			for(std::size_t i = 1; i < elems-1; i+=2){
 				metropolisSwap(
-					reference(m_temperedChains,i),m_betas(i),
-					reference(m_temperedChains,i+1),m_betas(i+1)
+					reference(m_temperedChains,i),m_betas(i),baseRateEnergy(i),
+					reference(m_temperedChains,i+1),m_betas(i+1),baseRateEnergy(i+1),
+					uni
 				);
 			}
 			m_operator.rbm()->hiddenNeurons().sufficientStatistics(
@@ -203,5 +203,59 @@ double annealedImportanceSampling(
 	return annealedImportanceSampling(rbm,beta,samples);
 }
 
+///\brief Annealed importance sampling with a sample size that adapts to the weight variance.
+///
+/// The accuracy of the AIS estimate is governed by the variance of the importance weights,
+/// which is hard to guess in advance. This overload draws rounds of \em samples samples,
+/// keeps streaming estimates of the first two moments of the weights and stops as soon as
+/// the estimated standard error of the returned estimate drops below \em tolerance, or when
+/// \em maxSamples samples have been drawn. The moments are accumulated in log space, so the
+/// weights can span many orders of magnitude without overflow.
+///
+///@param rbm the RBM for which the partition function is to be estimated
+///@param beta the inverse temperatures of the annealing sequence
+///@param samples number of samples drawn in every round
+///@param tolerance the target standard error of the estimate
+///@param maxSamples upper bound for the total number of samples
+template<class RBMType>
+double annealedImportanceSampling(
+	RBMType& rbm, RealVector const& beta, std::size_t samples,
+	double tolerance, std::size_t maxSamples
+){
+	std::size_t chains = beta.size();
+	double logSum = -std::numeric_limits<double>::infinity();//log of the sum of weights
+	double logSumSqr = -std::numeric_limits<double>::infinity();//log of the sum of squared weights
+	std::size_t totalSamples = 0;
+	while(totalSamples < maxSamples){
+		RealMatrix energyDiffTempering(chains,samples,0.0);
+		detail::sampleEnergiesWithTempering(rbm,beta,energyDiffTempering);
+		RealVector logWeights = -sum_rows(energyDiffTempering);
+		logSum = detail::updateLogPartition(logSum,-soft_max(logWeights));
+		logSumSqr = detail::updateLogPartition(logSumSqr,-soft_max(2.0*logWeights));
+		totalSamples += samples;
+
+		//standard error of the log estimate by the delta method:
+		//se^2 = Var(w)/(n E[w]^2) = sum(w^2)/sum(w)^2 - 1/n
+		double seSqr = std::exp(logSumSqr-2.0*logSum)-1.0/totalSamples;
+		if(seSqr < sqr(tolerance)) break;
+	}
+	return logSum-std::log(double(totalSamples));
+}
+
+///\brief Annealed importance sampling with a sample size that adapts to the weight variance.
+///
+/// Convenience overload spacing the inverse temperatures equally between 1 and 0.
+template<class RBMType>
+double annealedImportanceSampling(
+	RBMType& rbm, std::size_t chains, std::size_t samples,
+	double tolerance, std::size_t maxSamples
+){
+	RealVector beta(chains);
+	for(std::size_t i = 0; i  != chains; ++i){
+		beta(i) = 1.0-i/double(chains-1);
+	}
+	return annealedImportanceSampling(rbm,beta,samples,tolerance,maxSamples);
+}
+
 }
 #endif
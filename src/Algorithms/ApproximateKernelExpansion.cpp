@@ -0,0 +1,75 @@
+/*!
+ *
+ *
+ * \brief      -
+ * \author    O.Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#define SHARK_COMPILE_DLL
+#include <shark/Algorithms/ApproximateKernelExpansion.h>
+#include <shark/Algorithms/GradientDescent/Rprop.h>
+#include <shark/ObjectiveFunctions/KernelBasisDistance.h>
+
+using namespace shark;
+
+KernelExpansion<RealVector> shark::approximateKernelExpansion(
+	KernelExpansion<RealVector> const& model,
+	std::size_t numBasisVectors,
+	std::size_t iterations
+){
+	SHARK_CHECK(model.kernel() != NULL, "[approximateKernelExpansion] model must have a kernel");
+	SHARK_CHECK(numBasisVectors > 0, "[approximateKernelExpansion] the approximating basis must not be empty");
+
+	//KernelBasisDistance sparsifies the expansion it is given, so work on a copy
+	KernelExpansion<RealVector> sparseModel = model;
+	KernelBasisDistance distance(&sparseModel, numBasisVectors);
+
+	//optimize the basis vectors by preimage optimization, starting from a
+	//random subset of the basis of the expansion. If the kernel is not
+	//differentiable, the initial basis is the best we can do.
+	RealVector basisPoint = distance.proposeStartingPoint();
+	if(distance.hasFirstDerivative()){
+		IRpropPlus rprop;
+		rprop.init(distance, basisPoint);
+		for(std::size_t i = 0; i != iterations; ++i){
+			rprop.step(distance);
+		}
+		basisPoint = rprop.solution().point;
+	}
+
+	//unpack the found basis vectors into a dataset
+	std::size_t dim = dataDimension(sparseModel.basis());
+	std::vector<RealVector> basisVectors(numBasisVectors, RealVector(dim));
+	for(std::size_t i = 0; i != numBasisVectors; ++i){
+		noalias(basisVectors[i]) = subrange(basisPoint, i*dim, (i+1)*dim);
+	}
+	Data<RealVector> basis = createDataFromRange(basisVectors);
+
+	//build the approximating expansion with the optimal coefficients for the basis
+	KernelExpansion<RealVector> approximation(sparseModel.kernel(), basis, model.hasOffset(), model.outputSize());
+	approximation.alpha() = distance.findOptimalBeta(basisPoint);
+	if(model.hasOffset())
+		approximation.offset() = model.offset();
+	return approximation;
+}
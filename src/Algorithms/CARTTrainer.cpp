@@ -9,6 +9,7 @@
 #include <shark/Data/CVDatasetTools.h>
 #include <shark/ObjectiveFunctions/Loss/SquaredLoss.h>
 #include <shark/ObjectiveFunctions/Loss/ZeroOneLoss.h>
+#include <numeric>
 
 using namespace shark;
 using namespace std;
@@ -44,7 +45,18 @@ void CARTTrainer::train(ModelType& model, RegressionDataset const& dataset)
 		for(auto const& element: dataTrain.elements()){ sumFull += element.label; }
 
 		//Build tree form this fold
-		auto tree = buildTree(SortedIndex{dataTrain}, dataTrain, sumFull, 0, dataTrain.numberOfElements());
+		TreeType tree;
+		if(m_histogramBins){
+			detail::cart::BinnedIndex index{dataTrain, m_histogramBins};
+			std::vector<RealVector> labels(numTrainElements);
+			std::size_t id = 0;
+			for(auto const& element: dataTrain.elements()){ labels[id++] = element.label; }
+			std::vector<std::size_t> elementIds(numTrainElements);
+			std::iota(elementIds.begin(), elementIds.end(), 0);
+			tree = buildTreeHistogram(index, std::move(elementIds), labels, sumFull, 0, numTrainElements);
+		}else{
+			tree = buildTree(SortedIndex{dataTrain}, dataTrain, sumFull, 0, numTrainElements);
+		}
 		//Add the tree to the model and prune
 		model.setTree(tree);
 		while(true){
@@ -94,7 +106,19 @@ void CARTTrainer::train(ModelType& model, ClassificationDataset const& dataset){
 
 
 		//create initial tree for the fold
-		TreeType tree = buildTree(SortedIndex{dataTrain}, dataTrain, cFull, 0);
+		TreeType tree;
+		if(m_histogramBins){
+			detail::cart::BinnedIndex index{dataTrain, m_histogramBins};
+			std::size_t numTrainElements = dataTrain.numberOfElements();
+			std::vector<unsigned int> labels(numTrainElements);
+			std::size_t id = 0;
+			for(auto const& element: dataTrain.elements()){ labels[id++] = element.label; }
+			std::vector<std::size_t> elementIds(numTrainElements);
+			std::iota(elementIds.begin(), elementIds.end(), 0);
+			tree = buildTreeHistogram(index, std::move(elementIds), labels, cFull, 0);
+		}else{
+			tree = buildTree(SortedIndex{dataTrain}, dataTrain, cFull, 0);
+		}
 		model.setTree(tree);
 		
 		while(true){
@@ -324,6 +348,105 @@ CARTTrainer::Split CARTTrainer::findSplit(
 	return best;
 }
 
+//Classification case, histogram mode
+CARTTrainer::TreeType CARTTrainer::
+buildTreeHistogram(detail::cart::BinnedIndex const& index,
+          std::vector<std::size_t>&& elementIds,
+          std::vector<unsigned int> const& labels,
+          ClassVector &cFull, std::size_t nodeId) {
+	//Construct tree, and
+	// calculate the label of the node, which is the propability of class c
+	// given all points in this split for every class
+	TreeType tree;
+	tree.push_back(ModelType::NodeInfo{nodeId, detail::cart::hist(cFull)});
+	ModelType::NodeInfo& nodeInfo = tree[0];
+
+	//n = Total number of cases in the split
+	std::size_t n = elementIds.size();
+
+	// calculate the misclassification propability,
+	// 1-p(j*|t) where j* is the class the node t is most likely to belong to;
+	nodeInfo.misclassProp = 1- *std::max_element(nodeInfo.label.begin(), nodeInfo.label.end());
+
+	if(detail::cart::gini(cFull,n)==0.0 || n <= m_nodeSize) return tree;
+
+	//search the split with the best impurity among the bin boundaries
+	auto split = findSplitHistogram(index, elementIds, labels, cFull);
+
+	if(!split) return tree;
+
+	nodeInfo <<= split;
+	//partition the element ids on the split bin
+	std::vector<std::size_t> leftIds, rightIds;
+	for(auto const id : elementIds){
+		if(index.bin(split.splitAttribute, id) <= split.splitRow) leftIds.push_back(id);
+		else rightIds.push_back(id);
+	}
+	elementIds.clear(); elementIds.shrink_to_fit();
+
+	//Continue recursively
+	nodeInfo.leftNodeId = nodeId+1;
+	TreeType lTree = buildTreeHistogram(index, std::move(leftIds), labels, split.cAbove, nodeInfo.leftNodeId);
+
+	nodeInfo.rightNodeId = nodeInfo.leftNodeId+ lTree.size();
+	TreeType rTree = buildTreeHistogram(index, std::move(rightIds), labels, split.cBelow, nodeInfo.rightNodeId);
+
+	tree.reserve(tree.size()+lTree.size()+rTree.size());
+	std::move(lTree.begin(), lTree.end(), std::back_inserter(tree));
+	std::move(rTree.begin(), rTree.end(), std::back_inserter(tree));
+	return tree;
+}
+
+CARTTrainer::Split CARTTrainer::findSplitHistogram(
+		detail::cart::BinnedIndex const& index,
+		std::vector<std::size_t> const& elementIds,
+		std::vector<unsigned int> const& labels,
+		ClassVector const& cFull) const
+{
+	auto const n = elementIds.size();
+	auto const noBins = index.noBins();
+	Split best;
+	UIntMatrix binCounts(noBins, m_labelCardinality);
+	std::vector<std::size_t> binTotals(noBins);
+	ClassVector cAbove(m_labelCardinality);
+	for (std::size_t attributeIndex=0; attributeIndex < m_inputDimension; ++attributeIndex){
+		//accumulate the class counts of every bin in one linear pass
+		binCounts.clear();
+		std::fill(binTotals.begin(), binTotals.end(), 0);
+		for(auto const id : elementIds){
+			++binCounts(index.bin(attributeIndex, id), labels[id]);
+			++binTotals[index.bin(attributeIndex, id)];
+		}
+		auto cBelow = cFull; cAbove.clear();
+		std::size_t n1 = 0;
+		for(std::size_t b = 0; b+1 < noBins; ++b){//go through all bin boundaries
+			//an empty bin gives the same partition as the previous boundary
+			if(!binTotals[b]) continue;
+			noalias(cAbove) += row(binCounts,b);
+			noalias(cBelow) -= row(binCounts,b);
+			n1 += binTotals[b];
+
+			// n1/n2 = Number of cases to the left/right of child node
+			std::size_t n2 = n-n1;
+			if(!n2) break;
+
+			//Calculate the Gini impurity of the split
+			double impurity = n1*detail::cart::gini(cAbove,n1)+
+			                  n2*detail::cart::gini(cBelow,n2);
+			if(impurity < best.impurity){
+				//Found a more pure split, store the attribute index and bin
+				best.splitAttribute = attributeIndex;
+				best.splitRow = b;
+				best.impurity = impurity;
+				best.cAbove = cAbove;
+				best.cBelow = cBelow;
+			}
+		}
+	}
+	if(best) best.splitValue = index.binMax(best.splitAttribute, best.splitRow);
+	return best;
+}
+
 //Build CART tree in the regression case
 CARTTrainer::TreeType CARTTrainer::
 buildTree(SortedIndex&& tables,
@@ -412,6 +535,109 @@ CARTTrainer::Split CARTTrainer::findSplit(
 	return best;
 }
 
+//Build CART tree in the regression case, histogram mode
+CARTTrainer::TreeType CARTTrainer::
+buildTreeHistogram(detail::cart::BinnedIndex const& index,
+          std::vector<std::size_t>&& elementIds,
+          std::vector<RealVector> const& labels,
+          RealVector const& sumFull,
+          std::size_t nodeId, std::size_t trainSize){
+
+	//Construct tree
+	TreeType tree;
+	//n = Total number of cases in the node
+	std::size_t n = elementIds.size();
+	tree.push_back(ModelType::NodeInfo{nodeId,sumFull/n});
+	ModelType::NodeInfo& nodeInfo = tree[0];
+
+	//Store the Total Sum of Squares (TSS), cf. the sorted-index version
+	std::vector<RealVector> nodeLabels(n);
+	for(std::size_t i = 0; i<n; i++){
+		nodeLabels[i] = labels[elementIds[i]];
+	}
+	nodeInfo.misclassProp = totalSumOfSquares(nodeLabels, 0, n, sumFull)*((double)labels.size()/trainSize);
+
+	if(n <= m_nodeSize) return tree;
+
+	auto split = findSplitHistogram(index, elementIds, labels, sumFull);
+
+	// if the purity hasn't improved, this is a leaf.
+	if(!split) return tree;
+	nodeInfo <<= split;
+
+	//partition the element ids on the split bin
+	std::vector<std::size_t> leftIds, rightIds;
+	for(auto const id : elementIds){
+		if(index.bin(split.splitAttribute, id) <= split.splitRow) leftIds.push_back(id);
+		else rightIds.push_back(id);
+	}
+	elementIds.clear(); elementIds.shrink_to_fit();
+
+	//Continue recursively
+	nodeInfo.leftNodeId = nodeId+1;
+	TreeType lTree = buildTreeHistogram(index, std::move(leftIds), labels, split.sumAbove, nodeInfo.leftNodeId, trainSize);
+
+	nodeInfo.rightNodeId = nodeInfo.leftNodeId + lTree.size();
+	TreeType rTree = buildTreeHistogram(index, std::move(rightIds), labels, split.sumBelow, nodeInfo.rightNodeId, trainSize);
+
+	tree.reserve(tree.size()+lTree.size()+rTree.size());
+	std::move(lTree.begin(), lTree.end(), std::back_inserter(tree));
+	std::move(rTree.begin(), rTree.end(), std::back_inserter(tree));
+
+	return tree;
+}
+
+CARTTrainer::Split CARTTrainer::findSplitHistogram(
+		detail::cart::BinnedIndex const& index,
+		std::vector<std::size_t> const& elementIds,
+		std::vector<RealVector> const& labels,
+		RealVector const& sumFull) const
+{
+	auto const n = elementIds.size();
+	auto const noBins = index.noBins();
+	Split best{};
+	RealMatrix binSums(noBins, m_labelDimension);
+	std::vector<std::size_t> binTotals(noBins);
+	RealVector sumAbove(m_labelDimension);
+	for(std::size_t attributeIndex = 0; attributeIndex< m_inputDimension; attributeIndex++){
+		//accumulate the label sums of every bin in one linear pass
+		binSums.clear();
+		std::fill(binTotals.begin(), binTotals.end(), 0);
+		for(auto const id : elementIds){
+			auto const b = index.bin(attributeIndex, id);
+			noalias(row(binSums,b)) += labels[id];
+			++binTotals[b];
+		}
+		auto sumBelow = sumFull; sumAbove.clear();
+		std::size_t n1 = 0;
+		for(std::size_t b = 0; b+1 < noBins; ++b){//go through all bin boundaries
+			//an empty bin gives the same partition as the previous boundary
+			if(!binTotals[b]) continue;
+			noalias(sumAbove) += row(binSums,b);
+			noalias(sumBelow) -= row(binSums,b);
+			n1 += binTotals[b];
+
+			// n1/n2 = number of cases to the left/right child node
+			std::size_t n2 = n-n1;
+			if(!n2) break;
+
+			//Calculate the squared error of the split
+			double purity = norm_sqr(sumAbove)/n1 + norm_sqr(sumBelow)/n2;
+
+			if(purity>best.purity){
+				//Found a more pure split, store the attribute index and bin
+				best.splitAttribute = attributeIndex;
+				best.splitRow = b;
+				best.purity = purity;
+				best.sumAbove = sumAbove;
+				best.sumBelow = sumBelow;
+			}
+		}
+	}
+	if(best) best.splitValue = index.binMax(best.splitAttribute, best.splitRow);
+	return best;
+}
+
 
 /**
  * Returns the Total Sum of Squares
@@ -68,6 +68,7 @@ std::size_t CMA::suggestMu( std::size_t lambda, RecombinationType recomb) {
 CMA::CMA(DefaultRngType& rng)
 : m_userSetMu(false)
 , m_userSetLambda(false)
+, m_userSetUpdateFrequency(false)
 , m_initSigma(-1)
 , m_recombinationType( SUPERLINEAR )
 , m_sigma( 0 )
@@ -79,6 +80,7 @@ CMA::CMA(DefaultRngType& rng)
 , m_muEff( 0 )
 , m_lowerBound( 1E-20)
 , m_counter( 0 )
+, m_updateFrequency( 1 )
 , mpe_rng(&rng){
 	m_features |= REQUIRES_VALUE;
 }
@@ -108,6 +110,7 @@ void CMA::read( InArchive & archive ) {
 	archive >> m_mutationDistribution;
 
 	archive >> m_counter;
+	archive >> m_updateFrequency;
 }
 
 void CMA::write( OutArchive & archive ) const {
@@ -136,6 +139,7 @@ void CMA::write( OutArchive & archive ) const {
 	archive << m_mutationDistribution;
 
 	archive << m_counter;
+	archive << m_updateFrequency;
 }
 
 
@@ -236,6 +240,13 @@ void CMA::doInit(
 	double alphaMu = 2.;
 	m_cMu = std::min(1. - m_c1, alphaMu * (m_muEff - 2. + 1./m_muEff) / (sqr(m_numberOfVariables + 2) + alphaMu * m_muEff / 2)); // eq. (49)
 
+	// Lazy update schedule for the eigendecomposition. The covariance matrix
+	// changes by O(c1 + cMu) per generation, so the cached factors stay
+	// usable for roughly 1/(10 n (c1 + cMu)) generations - O(n/lambda) for
+	// large n - before the O(n^3) decomposition has to be redone.
+	if(!m_userSetUpdateFrequency)
+		m_updateFrequency = std::max<std::size_t>(1, std::size_t(1./(10. * m_numberOfVariables * (m_c1 + m_cMu))));
+
 	std::size_t pos = std::min_element(initialValues.begin(),initialValues.end())-initialValues.begin();
 	m_mean = initialSearchPoints[pos];
 	m_best.point = initialSearchPoints[pos];
@@ -293,8 +304,10 @@ void CMA::updatePopulation( std::vector<IndividualType> const& offspring ) {
 	m_evolutionPathSigma = (1. - m_cSigma)*m_evolutionPathSigma + std::sqrt( m_cSigma * (2. - m_cSigma) * m_muEff ) * CInvY; // eq. (40)
 	m_sigma *= std::exp((m_cSigma / m_dSigma) * (norm_2(m_evolutionPathSigma) / expectedChi - 1.)); // eq. (39)
 
-	// update mutation distribution
-	m_mutationDistribution.update();
+	// update mutation distribution. the eigendecomposition is refreshed
+	// lazily; in between, offspring are sampled from the cached factors
+	if(m_counter % m_updateFrequency == 0)
+		m_mutationDistribution.update();
 	
 	//mean update
 	m_mean = m;
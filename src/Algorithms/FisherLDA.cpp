@@ -33,8 +33,11 @@
 //===========================================================================
 #define SHARK_COMPILE_DLL
 #include <shark/Algorithms/Trainers/FisherLDA.h>
+#include <shark/LinAlg/Cholesky.h>
 #include <shark/LinAlg/eigenvalues.h>
 #include <shark/LinAlg/solveSystem.h>
+#include <shark/LinAlg/solveTriangular.h>
+#include <shark/Core/OpenMP.h>
 using namespace shark;
 
 
@@ -50,21 +53,52 @@ void FisherLDA::train(LinearModel<>& model, LabeledData<RealVector, unsigned int
 	std::size_t nComp = m_subspaceDimensions? m_subspaceDimensions : numberOfClasses(dataset);
 
 	RealVector mean(inputDim);
-	RealMatrix scatter(inputDim, inputDim);
-	meanAndScatter(dataset, mean, scatter);
-
-	RealMatrix eigenvectors(inputDim, inputDim);
-	RealVector eigenvalues(inputDim);
-	eigensymm(scatter, eigenvectors, eigenvalues);
-	if (m_whitening){
-		for(std::size_t i = 0; i != inputDim; ++i){
-			if(eigenvalues(i) <= 0) continue;
-			column(eigenvectors,i) /= std::sqrt(eigenvalues(i));
+	RealMatrix Sb(inputDim, inputDim);
+	RealMatrix Sw(inputDim, inputDim);
+	meanAndScatter(dataset, mean, Sb, Sw);
+
+	RealMatrix subspaceDirections(nComp, inputDim);
+	if(2*(nComp + 10) < inputDim){
+		//only a small fraction of the spectrum is needed, so avoid the full
+		//dense eigensolve. reduce the generalized problem S_B x = lambda S_W x
+		//to an ordinary symmetric one via the Cholesky factor S_W = LL^T:
+		//the eigenpairs of C = L^-1 S_B L^-T give the directions as L^-T v.
+		RealMatrix L(inputDim, inputDim, 0.0);
+		choleskyDecomposition(Sw, L);
+		RealMatrix C = Sb;
+		blas::solveTriangularSystemInPlace<blas::SolveAXB, blas::lower>(L, C);
+		blas::solveTriangularSystemInPlace<blas::SolveXAB, blas::upper>(trans(L), C);
+		RealMatrix eigenvectors;
+		RealVector eigenvalues;
+		eigensymmRand(C, eigenvectors, eigenvalues, nComp);
+		blas::solveTriangularSystemInPlace<blas::SolveAXB, blas::upper>(trans(L), eigenvectors);
+		//normalize as in the dense path: unit length, optionally whitened
+		for(std::size_t i = 0; i != nComp; ++i){
+			double norm = norm_2(column(eigenvectors,i));
+			if(norm > 0)
+				column(eigenvectors,i) /= norm;
+			if(m_whitening && eigenvalues(i) > 0)
+				column(eigenvectors,i) /= std::sqrt(eigenvalues(i));
 		}
+		noalias(subspaceDirections) = trans(eigenvectors);
+	}
+	else{
+		RealMatrix scatter(inputDim, inputDim);
+		blas::solveSymmPosDefSystem<blas::SolveAXB>(Sw, scatter, Sb);
+
+		RealMatrix eigenvectors(inputDim, inputDim);
+		RealVector eigenvalues(inputDim);
+		eigensymm(scatter, eigenvectors, eigenvalues);
+		if (m_whitening){
+			for(std::size_t i = 0; i != inputDim; ++i){
+				if(eigenvalues(i) <= 0) continue;
+				column(eigenvectors,i) /= std::sqrt(eigenvalues(i));
+			}
+		}
+		//reduce the size of the covariance matrix the the needed
+		//subspace
+		noalias(subspaceDirections) = trans(columns(eigenvectors,0,nComp));
 	}
-	//reduce the size of the covariance matrix the the needed
-	//subspace
-	RealMatrix subspaceDirections = trans(columns(eigenvectors,0,nComp));
 	RealVector offset = -prod(subspaceDirections, mean);
 
 	// write the parameters into the model
@@ -76,60 +110,80 @@ void FisherLDA::meanAndScatter(
 	RealVector& mean,
 	RealMatrix& scatter)
 {
-	
-	std::size_t classes = numberOfClasses(dataset);
-	std::size_t inputs = dataset.numberOfElements();
 	std::size_t inputDim = inputDimension(dataset);
-	
-
-	// intermediate results
-	std::vector<RealVector> means(classes, RealVector(inputDim,0.0));
-	std::vector<RealMatrix> covariances(classes, RealMatrix(inputDim, inputDim,0.0));
-	std::vector<std::size_t> counter(classes, 0);   // counter for examples per class
-
-	// calculate mean and scatter for every class.
+	RealMatrix Sb(inputDim, inputDim);
+	RealMatrix Sw(inputDim, inputDim);
+	meanAndScatter(dataset, mean, Sb, Sw);
 
-	// for every example in set ...
-	for(auto point: dataset.elements()){
-		//find class
-		std::size_t c= point.label;
+	// invert Sw
+	blas::solveSymmPosDefSystem<blas::SolveAXB>(Sw,scatter,Sb);
+}
 
-		// count example
-		counter[c] += 1;
+void FisherLDA::meanAndScatter(
+	LabeledData<RealVector, unsigned int> const& dataset,
+	RealVector& mean,
+	RealMatrix& Sb,
+	RealMatrix& Sw)
+{
+	std::size_t classes = numberOfClasses(dataset);
+	std::size_t inputs = dataset.numberOfElements();
+	std::size_t inputDim = inputDimension(dataset);
 
-		// add example to mean vector
-		noalias(means[c])+=point.input;
-		// add example to scatter matrix
-		noalias(covariances[c]) += outer_prod( point.input, point.input );
+	// sufficient statistics: class counts, class means and the second moment
+	// of the whole data
+	UIntVector num(classes,0);
+	RealMatrix means(classes, inputDim,0.0);
+	RealMatrix secondMoment(inputDim, inputDim,0.0);
+
+	//accumulate the sufficient statistics of the batches in parallel;
+	//every thread sums into its own accumulators which are combined afterwards
+	std::size_t numBatches = dataset.numberOfBatches();
+	std::size_t numThreads = SHARK_NUM_THREADS;
+	std::vector<UIntVector> threadNum(numThreads, num);
+	std::vector<RealMatrix> threadMeans(numThreads, means);
+	std::vector<RealMatrix> threadMoment(numThreads, secondMoment);
+	SHARK_PARALLEL_FOR(long b = 0; b < (long)numBatches; ++b){
+		std::size_t thread = SHARK_THREAD_NUM;
+		auto const& batch = dataset.batch(b);
+		UIntVector const& labels = batch.label;
+		RealMatrix const& points = batch.input;
+		for (std::size_t e=0; e != points.size1(); e++){
+			std::size_t c = labels(e);
+			++threadNum[thread](c);
+			noalias(row(threadMeans[thread],c)) += row(points,e);
+		}
+		//update second moment matrix; the batch-wise product is
+		//the blocked version of the rank-k update of the full data matrix
+		noalias(threadMoment[thread]) += prod(trans(points),points);
 	}
-
-	// for every class ...
-	for( std::size_t c = 0; c != classes ; c++ ) {
-		// normalize mean vector
-		means[c] /= counter[c];
-
-		// make scatter mean free
-		noalias(covariances[c]) -= outer_prod(counter[c]*means[c],means[c]);
+	for(std::size_t t = 0; t != numThreads; ++t){
+		noalias(num) += threadNum[t];
+		noalias(means) += threadMeans[t];
+		noalias(secondMoment) += threadMoment[t];
 	}
 
-	// calculate global mean and final scatter
-
-	RealMatrix Sb( inputDim, inputDim,0.0 ); // between-class scatter
-	RealMatrix Sw( inputDim, inputDim,0.0 ); // within-class scatter
+	// normalize the class means
+	for( std::size_t c = 0; c != classes ; c++ )
+		row(means,c) /= num(c);
 
 	// calculate global mean
+	mean.resize(inputDim);
 	mean.clear();
-	for (std::size_t c = 0; c != classes; c++) 
-		noalias(mean) += counter[c] * means[c]/inputs;
+	for (std::size_t c = 0; c != classes; c++)
+		noalias(mean) += double(num(c)) * row(means,c);
 	mean /= inputs;
 
-	// calculate between- and within-class scatters
+	// between-class scatter of the class means around the global mean
+	Sb.resize(inputDim, inputDim);
+	Sb.clear();
 	for (std::size_t c = 0; c != classes; c++) {
-		RealVector diff = means[c] - mean;
-		noalias(Sb) += outer_prod(counter[c] * diff,diff);
-		noalias(Sw) += covariances[c];
+		RealVector diff = row(means,c) - mean;
+		noalias(Sb) += outer_prod(double(num(c)) * diff,diff);
 	}
 
-	// invert Sw
-	blas::solveSymmPosDefSystem<blas::SolveAXB>(Sw,scatter,Sb);
+	// within-class scatter is the total second moment with every class
+	// centered around its own mean
+	Sw = secondMoment;
+	for (std::size_t c = 0; c != classes; c++)
+		noalias(Sw) -= outer_prod(double(num(c)) * row(means,c),row(means,c));
 }
@@ -0,0 +1,289 @@
+//===========================================================================
+/*!
+ *
+ *
+ * \brief       Gradient Boosting Trainer
+ *
+ *
+ *
+ * \author      O. Krause
+ * \date        2017
+ *
+ *
+ * \par Copyright 1995-2017 Shark Development Team
+ *
+ * <BR><HR>
+ * This file is part of Shark.
+ * <http://shark-ml.org/>
+ *
+ * Shark is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published
+ * by the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * Shark is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with Shark.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+//===========================================================================
+#define SHARK_COMPILE_DLL
+
+#include <shark/Algorithms/Trainers/GradientBoostingTrainer.h>
+#include <shark/Data/DataView.h>
+#include <numeric>
+
+using namespace shark;
+using detail::cart::BinnedIndex;
+
+namespace {
+/// Walks a pattern down an unoptimized tree, in which the node id of every
+/// node equals its position, and returns the index of the reached leaf.
+template<class TreeType, class Vector>
+std::size_t findLeaf(TreeType const& tree, Vector const& pattern){
+	std::size_t nodeId = 0;
+	while(tree[nodeId].leftNodeId != 0){
+		if(pattern[tree[nodeId].attributeIndex] <= tree[nodeId].attributeValue){
+			nodeId = tree[nodeId].leftNodeId;
+		}else{
+			nodeId = tree[nodeId].rightNodeId;
+		}
+	}
+	return nodeId;
+}
+}
+
+//Squared loss
+void GradientBoostingTrainer::train(ModelType& model, RegressionDataset const& dataset)
+{
+	model.clearModels();
+
+	m_inputDimension = inputDimension(dataset);
+	m_labelDimension = labelDimension(dataset);
+	model.setInputDimension(m_inputDimension);
+
+	//we need direct element access since we need to generate elementwise subsets
+	DataView<RegressionDataset const> elements(dataset);
+	std::size_t n = elements.size();
+	SIZE_CHECK(n != 0);
+
+	//quantize every attribute once for the whole ensemble
+	BinnedIndex index{dataset, m_histogramBins};
+
+	//start from the mean label
+	RealVector offset(m_labelDimension, 0.0);
+	for(std::size_t i = 0; i != n; ++i){
+		offset += elements[i].label;
+	}
+	offset /= n;
+	model.setOffset(offset);
+
+	//current prediction and residual of every element
+	RealMatrix f(n, m_labelDimension);
+	for(std::size_t i = 0; i != n; ++i){
+		noalias(row(f,i)) = offset;
+	}
+	std::vector<RealVector> residuals(n, RealVector(m_labelDimension));
+
+	auto seed = Rng::discrete(0,(unsigned)-1);
+	Rng::rng_type rng{static_cast<unsigned>(seed)};
+
+	for(std::size_t m = 0; m != m_numberOfTrees; ++m){
+		auto ids = subsample(n, rng);
+
+		//the residual of the squared loss is the plain prediction error
+		RealVector sum(m_labelDimension, 0.0);
+		for(auto const id : ids){
+			noalias(residuals[id]) = elements[id].label - row(f,id);
+			sum += residuals[id];
+		}
+
+		TreeType tree = buildTree(index, std::move(ids), residuals, sum, 0, 0);
+		ModelType::SubmodelType cart(std::move(tree), m_inputDimension);
+
+		//update the predictions of all elements and add the tree
+		for(std::size_t i = 0; i != n; ++i){
+			noalias(row(f,i)) += m_shrinkage * cart(elements[i].input);
+		}
+		model.addModel(cart, m_shrinkage);
+	}
+}
+
+//Binary logistic loss
+void GradientBoostingTrainer::train(ModelType& model, ClassificationDataset const& dataset)
+{
+	model.clearModels();
+
+	m_inputDimension = inputDimension(dataset);
+	m_labelDimension = 1;
+	model.setInputDimension(m_inputDimension);
+	SHARK_CHECK(numberOfClasses(dataset) == 2, "[GradientBoostingTrainer::train] the logistic loss supports binary classification only");
+
+	//we need direct element access since we need to generate elementwise subsets
+	DataView<ClassificationDataset const> elements(dataset);
+	std::size_t n = elements.size();
+
+	//quantize every attribute once for the whole ensemble
+	BinnedIndex index{dataset, m_histogramBins};
+
+	//start from the log-odds of the positive class
+	std::size_t positives = 0;
+	for(std::size_t i = 0; i != n; ++i){
+		if(elements[i].label) ++positives;
+	}
+	RealVector offset(1, std::log(double(positives)/(n - positives)));
+	model.setOffset(offset);
+
+	//current log-odds and residual of every element
+	RealVector f(n, offset(0));
+	std::vector<RealVector> residuals(n, RealVector(1));
+
+	auto seed = Rng::discrete(0,(unsigned)-1);
+	Rng::rng_type rng{static_cast<unsigned>(seed)};
+
+	for(std::size_t m = 0; m != m_numberOfTrees; ++m){
+		auto ids = subsample(n, rng);
+		std::vector<std::size_t> sample = ids;
+
+		//the residual of the logistic loss is label minus predicted probability
+		RealVector sum(1, 0.0);
+		for(auto const id : ids){
+			double p = 1.0/(1.0 + std::exp(-f(id)));
+			residuals[id](0) = (elements[id].label ? 1.0 : 0.0) - p;
+			sum(0) += residuals[id](0);
+		}
+
+		TreeType tree = buildTree(index, std::move(ids), residuals, sum, 0, 0);
+
+		//replace the mean-gradient leaves by Newton steps,
+		//label(leaf) = sum of residuals / sum of p(1-p)
+		RealVector numerator(tree.size(), 0.0);
+		RealVector denominator(tree.size(), 0.0);
+		for(auto const id : sample){
+			std::size_t leaf = findLeaf(tree, elements[id].input);
+			double r = residuals[id](0);
+			double p = (elements[id].label ? 1.0 : 0.0) - r;
+			numerator(leaf) += r;
+			denominator(leaf) += p * (1.0 - p);
+		}
+		for(std::size_t i = 0; i != tree.size(); ++i){
+			if(tree[i].leftNodeId == 0){
+				tree[i].label(0) = numerator(i)/std::max(denominator(i), 1.e-10);
+			}
+		}
+		ModelType::SubmodelType cart(std::move(tree), m_inputDimension);
+
+		//update the log-odds of all elements and add the tree
+		for(std::size_t i = 0; i != n; ++i){
+			f(i) += m_shrinkage * cart(elements[i].input)(0);
+		}
+		model.addModel(cart, m_shrinkage);
+	}
+}
+
+GradientBoostingTrainer::TreeType GradientBoostingTrainer::
+buildTree(BinnedIndex const& index,
+          std::vector<std::size_t>&& elementIds,
+          std::vector<RealVector> const& residuals,
+          RealVector const& sum,
+          std::size_t nodeId, std::size_t depth) const
+{
+	//Construct tree; the label of a node is the mean residual
+	TreeType tree;
+	std::size_t n = elementIds.size();
+	tree.push_back(ModelType::SubmodelType::NodeInfo{nodeId,sum/n});
+	ModelType::SubmodelType::NodeInfo& nodeInfo = tree[0];
+
+	if(depth >= m_maxDepth || n <= m_nodeSize) return tree;
+
+	auto split = findSplit(index, elementIds, residuals, sum);
+
+	// if the purity hasn't improved, this is a leaf.
+	if(!split) return tree;
+	nodeInfo <<= split;
+
+	//partition the element ids on the split bin
+	std::vector<std::size_t> leftIds, rightIds;
+	for(auto const id : elementIds){
+		if(index.bin(split.splitAttribute, id) <= split.splitRow) leftIds.push_back(id);
+		else rightIds.push_back(id);
+	}
+	elementIds.clear(); elementIds.shrink_to_fit();
+
+	//Continue recursively
+	nodeInfo.leftNodeId = nodeId+1;
+	TreeType lTree = buildTree(index, std::move(leftIds), residuals, split.sumAbove, nodeInfo.leftNodeId, depth+1);
+
+	nodeInfo.rightNodeId = nodeInfo.leftNodeId + lTree.size();
+	TreeType rTree = buildTree(index, std::move(rightIds), residuals, split.sumBelow, nodeInfo.rightNodeId, depth+1);
+
+	tree.reserve(tree.size()+lTree.size()+rTree.size());
+	std::move(lTree.begin(), lTree.end(), std::back_inserter(tree));
+	std::move(rTree.begin(), rTree.end(), std::back_inserter(tree));
+	return tree;
+}
+
+GradientBoostingTrainer::Split GradientBoostingTrainer::findSplit(
+		BinnedIndex const& index,
+		std::vector<std::size_t> const& elementIds,
+		std::vector<RealVector> const& residuals,
+		RealVector const& sumFull) const
+{
+	auto const n = elementIds.size();
+	auto const noBins = index.noBins();
+	Split best{};
+	RealMatrix binSums(noBins, m_labelDimension);
+	std::vector<std::size_t> binTotals(noBins);
+	RealVector sumAbove(m_labelDimension);
+	for(std::size_t attributeIndex = 0; attributeIndex< m_inputDimension; attributeIndex++){
+		//accumulate the residual sums of every bin in one linear pass
+		binSums.clear();
+		std::fill(binTotals.begin(), binTotals.end(), 0);
+		for(auto const id : elementIds){
+			auto const b = index.bin(attributeIndex, id);
+			noalias(row(binSums,b)) += residuals[id];
+			++binTotals[b];
+		}
+		auto sumBelow = sumFull; sumAbove.clear();
+		std::size_t n1 = 0;
+		for(std::size_t b = 0; b+1 < noBins; ++b){//go through all bin boundaries
+			//an empty bin gives the same partition as the previous boundary
+			if(!binTotals[b]) continue;
+			noalias(sumAbove) += row(binSums,b);
+			noalias(sumBelow) -= row(binSums,b);
+			n1 += binTotals[b];
+
+			// n1/n2 = number of cases to the left/right child node
+			std::size_t n2 = n-n1;
+			if(!n2) break;
+
+			//Calculate the squared error of the split
+			double purity = norm_sqr(sumAbove)/n1 + norm_sqr(sumBelow)/n2;
+
+			if(purity>best.purity){
+				//Found a more pure split, store the attribute index and bin
+				best.splitAttribute = attributeIndex;
+				best.splitRow = b;
+				best.purity = purity;
+				best.sumAbove = sumAbove;
+				best.sumBelow = sumBelow;
+			}
+		}
+	}
+	if(best) best.splitValue = index.binMax(best.splitAttribute, best.splitRow);
+	return best;
+}
+
+std::vector<std::size_t> GradientBoostingTrainer::subsample(std::size_t numElements, Rng::rng_type& rng) const{
+	std::vector<std::size_t> ids(numElements);
+	std::iota(ids.begin(), ids.end(), 0);
+	if(m_subsamplingFraction >= 1.0) return ids;
+	std::size_t subsetSize = std::max<std::size_t>(1, static_cast<std::size_t>(numElements * m_subsamplingFraction));
+	std::random_shuffle(ids.begin(), ids.end(), DiscreteUniform<>{rng});
+	ids.resize(subsetSize);
+	return ids;
+}
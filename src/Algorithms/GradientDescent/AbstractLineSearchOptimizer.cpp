@@ -65,6 +65,9 @@ void AbstractLineSearchOptimizer::init(ObjectiveFunctionType& objectiveFunction,
 }
 
 void AbstractLineSearchOptimizer::step(ObjectiveFunctionType const& objectiveFunction) {
+	// Rebind the line search to the function. This is a no-op in a normal run,
+	// but restores the binding after the state was loaded from a checkpoint.
+	m_linesearch.init(objectiveFunction);
 	// Perform line search
 	m_lastDerivative = m_derivative;
 	m_lastPoint = m_best.point;
@@ -41,16 +41,19 @@ using namespace shark;
 void LBFGS::initModel(){
 	m_hdiag = 1.0;         // Start with the identity
 	m_updThres = 1e-10;       // Reasonable threshold
-	
-	m_gradientDifferences.clear();
-	m_steps.clear();
+
+	// allocate the ring buffer once; the loops never reallocate
+	m_steps.resize(m_numHist, m_dimension);
+	m_gradientDifferences.resize(m_numHist, m_dimension);
+	m_rho.resize(m_numHist);
+	m_alpha.resize(m_numHist);
+	m_histCount = 0;
+	m_histPos = 0;
 }
 void LBFGS::computeSearchDirection(){
 	// Update the history if necessary
-	RealVector y = m_derivative - m_lastDerivative;
-	RealVector s = m_best.point - m_lastPoint;
-	updateHist(y, s);
-	
+	updateHist();
+
 	getDirection(m_searchDirection);
 }
 
@@ -59,53 +62,120 @@ void LBFGS::read( InArchive & archive )
 {
 	AbstractLineSearchOptimizer::read(archive);
 	archive>>m_numHist;
+	archive>>m_scaling;
+	archive>>m_fixedScale;
 	archive>>m_hdiag;
 	archive>>m_steps;
 	archive>>m_gradientDifferences;
+	archive>>m_rho;
+	archive>>m_histCount;
+	archive>>m_histPos;
+	m_alpha.resize(m_numHist);
 }
 
 void LBFGS::write( OutArchive & archive ) const
 {
 	AbstractLineSearchOptimizer::write(archive);
 	archive<<m_numHist;
+	archive<<m_scaling;
+	archive<<m_fixedScale;
 	archive<<m_hdiag;
 	archive<<m_steps;
 	archive<<m_gradientDifferences;
+	archive<<m_rho;
+	archive<<m_histCount;
+	archive<<m_histPos;
 }
 
-void LBFGS::updateHist(RealVector& y, RealVector &step) {
-	//Only update if <y,s> is above some reasonable threshold.
-	double ys = inner_prod(y, step);
+void LBFGS::updateHist() {
+	// Write the new pair directly into its ring buffer slot, computing
+	// <y,s> and <y,y> in the same sweep.
+	auto s = row(m_steps, m_histPos);
+	auto y = row(m_gradientDifferences, m_histPos);
+	double ys = 0.0;
+	double yy = 0.0;
+	for(std::size_t j = 0; j != m_dimension; ++j){
+		double sj = m_best.point(j) - m_lastPoint(j);
+		double yj = m_derivative(j) - m_lastDerivative(j);
+		s(j) = sj;
+		y(j) = yj;
+		ys += sj * yj;
+		yy += yj * yj;
+	}
+	//Only update if <y,s> is above some reasonable threshold;
+	//otherwise the slot is simply overwritten by the next pair.
 	if (ys > m_updThres) {
-		// Only store m_numHist steps, so possibly pop the oldest.
-		if (m_steps.size() >= m_numHist) {
-			m_steps.pop_front();
-			m_gradientDifferences.pop_front();
-		}
-		m_steps.push_back(step);
-		m_gradientDifferences.push_back(y);
+		m_rho(m_histPos) = 1.0 / ys;
+		m_histPos = (m_histPos + 1) % m_numHist;
+		if(m_histCount < m_numHist) ++m_histCount;
 		// Update the hessian approximation.
-		m_hdiag = ys / inner_prod(y,y);
+		switch(m_scaling){
+			case SCALING_IDENTITY:
+				m_hdiag = 1.0;
+				break;
+			case SCALING_GAMMA:
+				m_hdiag = ys / yy;
+				break;
+			case SCALING_FIXED:
+				m_hdiag = m_fixedScale;
+				break;
+		}
 	}
 }
 
 void LBFGS::getDirection(RealVector& searchDirection) {
-	
-	RealVector rho(m_numHist);
-	RealVector alpha(m_numHist);
-	RealVector beta(m_numHist);
-
-	for (std::size_t i = 0; i < m_steps.size(); ++i)
-		rho(i) = 1.0 / inner_prod(m_gradientDifferences[i], m_steps[i]);
+	noalias(searchDirection) = -m_derivative;
+	if(m_histCount == 0){
+		searchDirection *= m_hdiag;
+		return;
+	}
 
-	searchDirection = -m_derivative;
-	for (std::size_t i = m_steps.size(); i > 0; --i) {
-		alpha(i-1) = rho(i-1) * inner_prod(m_steps[i-1], searchDirection);
-		searchDirection -= alpha(i-1) * m_gradientDifferences[i-1];
+	// backward pass over the pairs, newest to oldest. The axpy of every
+	// iteration is fused with the dot product of the next one, so each
+	// pair is swept exactly once.
+	std::size_t i = (m_histPos + m_numHist - 1) % m_numHist;//newest pair
+	double dot = inner_prod(row(m_steps, i), searchDirection);
+	for(std::size_t k = 0; k != m_histCount; ++k){
+		double alpha = m_rho(i) * dot;
+		m_alpha(i) = alpha;
+		std::size_t older = (i + m_numHist - 1) % m_numHist;
+		auto y = row(m_gradientDifferences, i);
+		if(k + 1 != m_histCount){
+			auto s = row(m_steps, older);
+			dot = 0.0;
+			for(std::size_t j = 0; j != m_dimension; ++j){
+				searchDirection(j) -= alpha * y(j);
+				dot += s(j) * searchDirection(j);
+			}
+		}else{
+			// oldest pair: fuse the axpy with the scaling by the initial
+			// hessian and the first dot product of the forward pass
+			dot = 0.0;
+			for(std::size_t j = 0; j != m_dimension; ++j){
+				double dj = (searchDirection(j) - alpha * y(j)) * m_hdiag;
+				searchDirection(j) = dj;
+				dot += y(j) * dj;
+			}
+		}
+		i = older;
 	}
-	searchDirection *= m_hdiag;
-	for (std::size_t i = 0; i < m_steps.size(); ++i) {
-		beta(i) = rho(i) * inner_prod(m_gradientDifferences[i], searchDirection);
-		searchDirection += m_steps[i] * (alpha(i) - beta(i));
+
+	// forward pass, oldest to newest; dot holds <y_oldest, d> already.
+	i = (i + 1) % m_numHist;//back to the oldest pair
+	for(std::size_t k = 0; k != m_histCount; ++k){
+		double coeff = m_alpha(i) - m_rho(i) * dot;
+		std::size_t newer = (i + 1) % m_numHist;
+		auto s = row(m_steps, i);
+		if(k + 1 != m_histCount){
+			auto y = row(m_gradientDifferences, newer);
+			dot = 0.0;
+			for(std::size_t j = 0; j != m_dimension; ++j){
+				searchDirection(j) += coeff * s(j);
+				dot += y(j) * searchDirection(j);
+			}
+		}else{
+			noalias(searchDirection) += coeff * s;
+		}
+		i = newer;
 	}
 }
@@ -32,15 +32,38 @@
  */
  #define SHARK_COMPILE_DLL
  #include <shark/Algorithms/GradientDescent/Rprop.h>
- 
+ #include <shark/Core/OpenMP.h>
+
  #include <algorithm>
 
 #include <boost/math/special_functions/sign.hpp>
 #include <boost/serialization/base_object.hpp>
- 
+
  using namespace shark;
- 
- 
+
+namespace{
+	///\brief Branch-free sign, so the coordinate update loops vectorize.
+	inline double signOf(double x){
+		return double(x > 0) - double(x < 0);
+	}
+
+	///number of parameters from which on the coordinate updates are split over threads
+	const std::size_t ParallelUpdateThreshold = 100000;
+
+	///\brief Applies the coordinate update to every parameter, in parallel for large vectors.
+	template<class Update>
+	void forEachCoordinate(std::size_t parameterSize, Update const& update){
+		if(parameterSize < ParallelUpdateThreshold){
+			for(std::size_t i = 0; i != parameterSize; ++i)
+				update(i);
+		}else{
+			SHARK_PARALLEL_FOR(int i = 0; i < (int)parameterSize; ++i)
+				update(i);
+		}
+	}
+}
+
+
 //RPROP-MINUS>
 
 
@@ -76,28 +99,44 @@ void RpropMinus::init(
 }
 
 void RpropMinus::step(ObjectiveFunctionType const& objectiveFunction) {
-	for (size_t i = 0; i < m_parameterSize; i++)
-	{
-		double p = m_best.point(i);
-		if (m_derivative(i) * m_oldDerivative(i) > 0)
-		{
-			m_delta(i) = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
-		}
-		else if (m_derivative(i) * m_oldDerivative(i) < 0)
-		{
-			m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
-		}
-		m_best.point(i) -= m_delta(i) * boost::math::sign(m_derivative(i));
-		if (! objectiveFunction.isFeasible(m_best.point))
+	if(objectiveFunction.isConstrained()){
+		//the per-coordinate feasibility checks force a sequential scalar loop
+		for (size_t i = 0; i < m_parameterSize; i++)
 		{
-			m_best.point(i) = p;
-			m_delta(i) *= m_decreaseFactor;
-			m_oldDerivative(i) = 0.0;
+			double p = m_best.point(i);
+			if (m_derivative(i) * m_oldDerivative(i) > 0)
+			{
+				m_delta(i) = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
+			}
+			else if (m_derivative(i) * m_oldDerivative(i) < 0)
+			{
+				m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
+			}
+			m_best.point(i) -= m_delta(i) * boost::math::sign(m_derivative(i));
+			if (! objectiveFunction.isFeasible(m_best.point))
+			{
+				m_best.point(i) = p;
+				m_delta(i) *= m_decreaseFactor;
+				m_oldDerivative(i) = 0.0;
+			}
+			else
+			{
+				m_oldDerivative(i) = m_derivative(i);
+			}
 		}
-		else
-		{
+	}else{
+		//unconstrained case: the same update with all branches expressed
+		//as arithmetic on 0/1 masks, so the loop vectorizes
+		forEachCoordinate(m_parameterSize,[&](std::size_t i){
+			double direction = m_derivative(i) * m_oldDerivative(i);
+			double grown = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
+			double shrunk = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
+			double inc = double(direction > 0);
+			double dec = double(direction < 0);
+			m_delta(i) += inc * (grown - m_delta(i)) + dec * (shrunk - m_delta(i));
+			m_best.point(i) -= m_delta(i) * signOf(m_derivative(i));
 			m_oldDerivative(i) = m_derivative(i);
-		}
+		});
 	}
 	//evaluate the new point
 	m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
@@ -146,35 +185,55 @@ void RpropPlus::init(ObjectiveFunctionType & objectiveFunction, SearchPointType
 	m_deltaw.clear();
 }
 void RpropPlus::step(ObjectiveFunctionType const& objectiveFunction) {
-	for (size_t i = 0; i < m_parameterSize; i++)
-	{
-		//save the current value to ensure, that it can be restored
-		double p = m_best.point(i);
-		if (m_derivative(i) * m_oldDerivative(i) > 0)
-		{
-			m_delta(i) = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
-			m_deltaw(i) = m_delta(i) * -boost::math::sign(m_derivative(i));
-			m_best.point(i)+=m_deltaw(i);
-			m_oldDerivative(i) = m_derivative(i);
-		}
-		else if (m_derivative(i) * m_oldDerivative(i) < 0)
-		{
-			m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
-			m_best.point(i)-=m_deltaw(i);
-			m_oldDerivative(i) = 0;
-		}
-		else
-		{
-			m_deltaw(i) = m_delta(i) * -boost::math::sign(m_derivative(i));
-			m_best.point(i)+=m_deltaw(i);
-			m_oldDerivative(i) = m_derivative(i);
-		}
-		if (! objectiveFunction.isFeasible(m_best.point))
+	if(objectiveFunction.isConstrained()){
+		//the per-coordinate feasibility checks force a sequential scalar loop
+		for (size_t i = 0; i < m_parameterSize; i++)
 		{
-			m_best.point(i)=p;
-			m_delta(i) *= m_decreaseFactor;
-			m_oldDerivative(i) = 0.0;
+			//save the current value to ensure, that it can be restored
+			double p = m_best.point(i);
+			if (m_derivative(i) * m_oldDerivative(i) > 0)
+			{
+				m_delta(i) = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
+				m_deltaw(i) = m_delta(i) * -boost::math::sign(m_derivative(i));
+				m_best.point(i)+=m_deltaw(i);
+				m_oldDerivative(i) = m_derivative(i);
+			}
+			else if (m_derivative(i) * m_oldDerivative(i) < 0)
+			{
+				m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
+				m_best.point(i)-=m_deltaw(i);
+				m_oldDerivative(i) = 0;
+			}
+			else
+			{
+				m_deltaw(i) = m_delta(i) * -boost::math::sign(m_derivative(i));
+				m_best.point(i)+=m_deltaw(i);
+				m_oldDerivative(i) = m_derivative(i);
+			}
+			if (! objectiveFunction.isFeasible(m_best.point))
+			{
+				m_best.point(i)=p;
+				m_delta(i) *= m_decreaseFactor;
+				m_oldDerivative(i) = 0.0;
+			}
 		}
+	}else{
+		//unconstrained case: the same update with all branches expressed
+		//as arithmetic on 0/1 masks, so the loop vectorizes
+		forEachCoordinate(m_parameterSize,[&](std::size_t i){
+			double direction = m_derivative(i) * m_oldDerivative(i);
+			double grown = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
+			double shrunk = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
+			double dec = double(direction < 0);
+			double noDec = 1.0 - dec;
+			double inc = double(direction > 0);
+			m_delta(i) += inc * (grown - m_delta(i)) + dec * (shrunk - m_delta(i));
+			double newDeltaw = m_delta(i) * -signOf(m_derivative(i));
+			//on a sign change the previous step is undone, otherwise the new step is taken
+			m_best.point(i) += noDec * newDeltaw - dec * m_deltaw(i);
+			m_deltaw(i) = dec * m_deltaw(i) + noDec * newDeltaw;
+			m_oldDerivative(i) = noDec * m_derivative(i);
+		});
 	}
 	m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
 }
@@ -210,39 +269,62 @@ void IRpropPlus::init(ObjectiveFunctionType & objectiveFunction, SearchPointType
 }
 
 void IRpropPlus::step(ObjectiveFunctionType const& objectiveFunction) {
-	for (size_t i = 0; i < m_parameterSize; i++)
-	{
-		if(std::abs(m_derivative(i)) < m_derivativeThreshold) m_derivative(i) = 0.;
-		double p = m_best.point(i);
-		double direction = m_derivative(i) * m_oldDerivative(i);
-		if ( direction > 0)
-		{
-			m_delta(i) = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
-			m_deltaw(i) = m_delta(i) * -boost::math::sign(m_derivative(i));
-			m_best.point(i) += m_deltaw(i);
-			m_oldDerivative(i) = m_derivative(i);
-		}
-		else if (direction < 0)
+	if(objectiveFunction.isConstrained()){
+		//the per-coordinate feasibility checks force a sequential scalar loop
+		for (size_t i = 0; i < m_parameterSize; i++)
 		{
-			m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
-			if (m_best.value > m_oldError)
+			if(std::abs(m_derivative(i)) < m_derivativeThreshold) m_derivative(i) = 0.;
+			double p = m_best.point(i);
+			double direction = m_derivative(i) * m_oldDerivative(i);
+			if ( direction > 0)
 			{
-				m_best.point(i) -= m_deltaw(i);
+				m_delta(i) = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
+				m_deltaw(i) = m_delta(i) * -boost::math::sign(m_derivative(i));
+				m_best.point(i) += m_deltaw(i);
+				m_oldDerivative(i) = m_derivative(i);
+			}
+			else if (direction < 0)
+			{
+				m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
+				if (m_best.value > m_oldError)
+				{
+					m_best.point(i) -= m_deltaw(i);
+				}
+				m_oldDerivative(i) = 0;
+			}
+			else
+			{
+				m_deltaw(i) = m_delta(i) * -boost::math::sign(m_derivative(i));
+				m_best.point(i) += m_deltaw(i);
+				m_oldDerivative(i) = m_derivative(i);
+			}
+			if (! objectiveFunction.isFeasible(m_best.point))
+			{
+				m_best.point(i)=p;
+				m_delta(i) *= m_decreaseFactor;
+				m_oldDerivative(i) = 0.0;
 			}
-			m_oldDerivative(i) = 0;
-		}
-		else
-		{
-			m_deltaw(i) = m_delta(i) * -boost::math::sign(m_derivative(i));
-			m_best.point(i) += m_deltaw(i);
-			m_oldDerivative(i) = m_derivative(i);
-		}
-		if (! objectiveFunction.isFeasible(m_best.point))
-		{
-			m_best.point(i)=p;
-			m_delta(i) *= m_decreaseFactor;
-			m_oldDerivative(i) = 0.0;
 		}
+	}else{
+		//unconstrained case: the same update with all branches expressed
+		//as arithmetic on 0/1 masks, so the loop vectorizes
+		double backtrack = double(m_best.value > m_oldError);
+		forEachCoordinate(m_parameterSize,[&](std::size_t i){
+			m_derivative(i) *= double(std::abs(m_derivative(i)) >= m_derivativeThreshold);
+			double direction = m_derivative(i) * m_oldDerivative(i);
+			double grown = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
+			double shrunk = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
+			double dec = double(direction < 0);
+			double noDec = 1.0 - dec;
+			double inc = double(direction > 0);
+			m_delta(i) += inc * (grown - m_delta(i)) + dec * (shrunk - m_delta(i));
+			double newDeltaw = m_delta(i) * -signOf(m_derivative(i));
+			//on a sign change the previous step is undone if the error increased,
+			//otherwise the new step is taken
+			m_best.point(i) += noDec * newDeltaw - dec * backtrack * m_deltaw(i);
+			m_deltaw(i) = dec * m_deltaw(i) + noDec * newDeltaw;
+			m_oldDerivative(i) = noDec * m_derivative(i);
+		});
 	}
 	m_oldError = m_best.value;
 	m_best.value = objectiveFunction.evalDerivative( m_best.point, m_derivative );
@@ -281,18 +363,16 @@ void IRpropPlusFull::init(ObjectiveFunctionType& objectiveFunction, SearchPointT
 void IRpropPlusFull::step(ObjectiveFunctionType const& objectiveFunction) {
 	if ( m_best.value < m_oldError){//accept the point as the new current one if it is better
 		//step size adaptation
-		for (size_t i = 0; i < m_parameterSize; i++)
-		{
-			if(std::abs(m_derivative(i)) < m_derivativeThreshold) m_derivative(i) = 0.;
+		forEachCoordinate(m_parameterSize,[&](std::size_t i){
+			m_derivative(i) *= double(std::abs(m_derivative(i)) >= m_derivativeThreshold);
 			double direction = m_derivative(i) * m_oldDerivative(i);
-			if(direction < 0){//decrease if we overstepped the optimum
-				m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
-			}
-			if( direction > 0)//increase if we still go in the same direction
-			{
-				m_delta(i) = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
-			}
-		}
+			//decrease if we overstepped the optimum, increase if we still go in the same direction
+			double grown = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
+			double shrunk = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
+			double inc = double(direction > 0);
+			double dec = double(direction < 0);
+			m_delta(i) += inc * (grown - m_delta(i)) + dec * (shrunk - m_delta(i));
+		});
 		//accept the point as the new current one
 		m_oldDerivative = m_derivative;
 		m_oldError = m_best.value;
@@ -300,22 +380,20 @@ void IRpropPlusFull::step(ObjectiveFunctionType const& objectiveFunction) {
 	else{
 		//do a full backtrack
 		noalias(m_best.point) -= m_deltaw;
-		for (size_t i = 0; i < m_parameterSize; i++)
-		{
-			if(std::abs(m_derivative(i)) < m_derivativeThreshold) m_derivative(i) = 0.;
+		forEachCoordinate(m_parameterSize,[&](std::size_t i){
+			m_derivative(i) *= double(std::abs(m_derivative(i)) >= m_derivativeThreshold);
 			double direction = m_derivative(i) * m_oldDerivative(i);
-			if(direction < 0){//this went too far...
-				m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
-			}
-		}
+			//this went too far...
+			double shrunk = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
+			m_delta(i) += double(direction < 0) * (shrunk - m_delta(i));
+		});
 	}
-	
+
 	//propose new step with updated step sizes
-	for (size_t i = 0; i < m_parameterSize; i++)
-	{
-		m_deltaw(i) = m_delta(i) * -boost::math::sign(m_derivative(i));
+	forEachCoordinate(m_parameterSize,[&](std::size_t i){
+		m_deltaw(i) = m_delta(i) * -signOf(m_derivative(i));
 		m_best.point(i) += m_deltaw(i);
-	}
+	});
 	m_best.value = objectiveFunction.evalDerivative( m_best.point, m_derivative );
 }
 
@@ -340,31 +418,47 @@ IRpropMinus::IRpropMinus()
 }
 
 void IRpropMinus::step(ObjectiveFunctionType const& objectiveFunction) {
-	for (size_t i = 0; i < m_parameterSize; i++)
-	{
-		double p = m_best.point(i);
-		double direction = m_derivative(i) * m_oldDerivative(i);
-		if (direction > 0)
-		{
-			m_delta(i) = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
-			m_oldDerivative(i) = m_derivative(i);
-		}
-		else if (direction < 0)
-		{
-			m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
-			m_oldDerivative(i) = 0;
-		}
-		else
-		{
-			m_oldDerivative(i) = m_derivative(i);
-		}
-		m_best.point(i)-=m_delta(i) * boost::math::sign(m_derivative(i));
-		if (! objectiveFunction.isFeasible(m_best.point))
+	if(objectiveFunction.isConstrained()){
+		//the per-coordinate feasibility checks force a sequential scalar loop
+		for (size_t i = 0; i < m_parameterSize; i++)
 		{
-			m_best.point(i)=p;
-			m_delta(i) *= m_decreaseFactor;
-			m_oldDerivative(i) = 0.0;
+			double p = m_best.point(i);
+			double direction = m_derivative(i) * m_oldDerivative(i);
+			if (direction > 0)
+			{
+				m_delta(i) = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
+				m_oldDerivative(i) = m_derivative(i);
+			}
+			else if (direction < 0)
+			{
+				m_delta(i) = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
+				m_oldDerivative(i) = 0;
+			}
+			else
+			{
+				m_oldDerivative(i) = m_derivative(i);
+			}
+			m_best.point(i)-=m_delta(i) * boost::math::sign(m_derivative(i));
+			if (! objectiveFunction.isFeasible(m_best.point))
+			{
+				m_best.point(i)=p;
+				m_delta(i) *= m_decreaseFactor;
+				m_oldDerivative(i) = 0.0;
+			}
 		}
+	}else{
+		//unconstrained case: the same update with all branches expressed
+		//as arithmetic on 0/1 masks, so the loop vectorizes
+		forEachCoordinate(m_parameterSize,[&](std::size_t i){
+			double direction = m_derivative(i) * m_oldDerivative(i);
+			double grown = std::min(m_maxDelta, m_increaseFactor * m_delta(i));
+			double shrunk = std::max(m_minDelta, m_decreaseFactor * m_delta(i));
+			double inc = double(direction > 0);
+			double dec = double(direction < 0);
+			m_delta(i) += inc * (grown - m_delta(i)) + dec * (shrunk - m_delta(i));
+			m_oldDerivative(i) = (1.0 - dec) * m_derivative(i);
+			m_best.point(i) -= m_delta(i) * signOf(m_derivative(i));
+		});
 	}
 	m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivative);
 }
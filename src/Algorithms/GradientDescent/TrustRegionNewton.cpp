@@ -69,11 +69,16 @@ namespace{
 	/// (norm of the gradient below the given tolerance) or the step hits the border
 	/// of the trust region.
 	///
+	/// The Hessian only enters through the product with the CG direction, which is
+	/// delegated to the callable hessianProd(direction, result), so the caller
+	/// decides whether an explicit matrix or a matrix-free approximation is used.
+	///
 	/// Returns the improvement in function value and the solution as a pair.
 	///
 	/// Algorithm 7.2 in Wright, Nocedal: Numerical Optimization
+	template<class HessianVectorProduct>
 	std::pair<double,RealVector> trustRegionCG(
-		RealMatrix const& hessian,
+		HessianVectorProduct const& hessianProd,
 		RealVector gradient,
 		double tolerance,   // bound on the norm of the gradient
 		double delta        // trust region size (radius)
@@ -82,13 +87,14 @@ namespace{
 		RealVector direction = -gradient;
 		std::pair<double,RealVector> solution(0.0,RealVector(residual.size(),0.0));
 		RealVector& step = solution.second;
-		
+
 		double currentNormRes2 = norm_sqr(residual);
 		if( currentNormRes2 <sqr(tolerance))
 			return solution;
 
+		RealVector Hdir(gradient.size());
 		for(std::size_t iter = 0; iter != 10*gradient.size(); ++iter ){//numerical safeguard(should never be called)
-			RealVector Hdir=prod(hessian,direction);
+			hessianProd(direction,Hdir);
 			double normH=inner_prod(direction, Hdir);
 			// if our Hessian is not positive definite then we just run to the boundary
 			if(normH <= 0){
@@ -127,6 +133,7 @@ namespace{
 }
 
 TrustRegionNewton::TrustRegionNewton()
+: m_hessianFree(false)
 {
 	m_features |= REQUIRES_VALUE;
 	m_features |= REQUIRES_FIRST_DERIVATIVE;
@@ -138,9 +145,12 @@ void TrustRegionNewton::init(ObjectiveFunctionType& objectiveFunction, SearchPoi
 
 	m_delta = initialDelta;
 	m_minImprovementRatio = 0.1;
-	
+
 	m_best.point = startingPoint;
-	m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivatives);
+	if(m_hessianFree)
+		m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivatives.gradient);
+	else
+		m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivatives);
 }
 
 void TrustRegionNewton::step(const ObjectiveFunctionType& objectiveFunction) {
@@ -159,7 +169,30 @@ void TrustRegionNewton::step(const ObjectiveFunctionType& objectiveFunction) {
 	//The initial guess of 0.5 might be too optimistic and we still spend a lot of time on finding the solution, but this is hugely problem dependent.
 	double gamma =std::min(0.5,std::sqrt(gradNorm_2));
 	double tolerance = gamma* gradNorm_2;
-	std::pair<double,RealVector> solution =  trustRegionCG(m_derivatives.hessian, m_derivatives.gradient, tolerance, m_delta);
+	std::pair<double,RealVector> solution;
+	if(m_hessianFree){
+		//approximate the Hessian-vector product by a forward finite
+		//difference of the gradient along the direction; this costs one
+		//gradient evaluation per CG iteration but never forms the Hessian
+		double pointScale = 1.0 + norm_2(m_best.point);
+		RealVector shiftedGradient(m_best.point.size());
+		auto hessianProd = [&](RealVector const& direction, RealVector& Hdir){
+			double directionNorm = norm_2(direction);
+			if(directionNorm == 0){
+				Hdir.clear();
+				return;
+			}
+			double eps = 1.e-8 * pointScale / directionNorm;
+			objectiveFunction.evalDerivative(m_best.point + eps*direction, shiftedGradient);
+			noalias(Hdir) = (shiftedGradient - m_derivatives.gradient)/eps;
+		};
+		solution = trustRegionCG(hessianProd, m_derivatives.gradient, tolerance, m_delta);
+	}else{
+		auto hessianProd = [&](RealVector const& direction, RealVector& Hdir){
+			noalias(Hdir) = prod(m_derivatives.hessian,direction);
+		};
+		solution = trustRegionCG(hessianProd, m_derivatives.gradient, tolerance, m_delta);
+	}
 	if (solution.first == 0) return;//we are done
 
 	//calculate the function value improvement of the point compared to the model prediction
@@ -177,6 +210,9 @@ void TrustRegionNewton::step(const ObjectiveFunctionType& objectiveFunction) {
 	//accept the point only if the improvement is significant
 	if(rho >= m_minImprovementRatio){
 		noalias(m_best.point) +=solution.second;
-		m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivatives);
+		if(m_hessianFree)
+			m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivatives.gradient);
+		else
+			m_best.value = objectiveFunction.evalDerivative(m_best.point,m_derivatives);
 	}
 }
@@ -34,73 +34,206 @@
 
 #define SHARK_COMPILE_DLL
 #include <shark/Algorithms/KMeans.h>
-#include <shark/Models/Clustering/HardClusteringModel.h>
 #include <shark/Data/DataView.h>
 
-#include <boost/range/algorithm/equal.hpp>
 #include <limits>
+#include <cmath>
 using namespace shark;
 
+namespace {
+/// Finds the closest and second closest center of a point and returns the
+/// index of the closest one; best and second receive the squared distances.
+template<class Point>
+std::size_t closestCenters(Point const& point, RealMatrix const& centers, double& best, double& second){
+	best = second = std::numeric_limits<double>::max();
+	std::size_t bestIndex = 0;
+	for(std::size_t j = 0; j != centers.size1(); ++j){
+		double d = distanceSqr(point, row(centers,j));
+		if(d < best){
+			second = best;
+			best = d;
+			bestIndex = j;
+		}else if(d < second){
+			second = d;
+		}
+	}
+	return bestIndex;
+}
+}
 
 std::size_t shark::kMeans(Data<RealVector> const& dataset, std::size_t k, Centroids& centroids, std::size_t maxIterations){
 	SIZE_CHECK(k <= dataset.numberOfElements());
 	if(!maxIterations)
 		maxIterations = std::numeric_limits<std::size_t>::max();
-	
+
 	// initialization
 	std::size_t ell = dataset.numberOfElements();
 	std::size_t dimension = dataDimension(dataset);
-	
+	DataView<Data<RealVector> const> elements(dataset);
+
 	//if the centers are not already initialized, do it now
 	if (centroids.numberOfClusters() != k){
 		centroids.initFromData(dataset,k);
 	}
-	HardClusteringModel<RealVector> model(&centroids);
-	ClassificationDataset clusterMembership(dataset,model(dataset));
+	RealMatrix centers(k, dimension);
+	{
+		std::size_t j = 0;
+		for(auto const& c : centroids.centroids().elements()){
+			noalias(row(centers,j++)) = c;
+		}
+	}
+
+	//Hamerly's triangle-inequality acceleration: every point keeps an upper
+	//bound on the distance to its center and a lower bound on the distance
+	//to all other centers. A point needs a full scan over the centers only
+	//when the bounds cannot prove that its assignment is still optimal, so
+	//after the first iterations most points are settled with O(1) work.
+	//See: G. Hamerly. Making k-means even faster. SDM 2010.
+	std::vector<std::size_t> assignment(ell);
+	RealVector upper(ell);//upper bound on d(x_i, c_{a_i})
+	RealVector lower(ell);//lower bound on d(x_i, c_j) for all j != a_i
+	for(std::size_t i = 0; i != ell; ++i){
+		double best, second;
+		assignment[i] = closestCenters(elements[i], centers, best, second);
+		upper(i) = std::sqrt(best);
+		lower(i) = std::sqrt(second);
+	}
+
+	RealMatrix sums(k, dimension);
+	RealVector counts(k);
+	RealVector delta(k);//movement of every center in the last update
+	RealVector s(k);//half the distance of every center to its closest neighbour
+	RealVector newCenter(dimension);
 
 	// k-means loop
 	std::size_t iter = 0;
 	bool equal = false;
 	for(; iter != maxIterations && !equal; ++iter) {
 		// compute new centers
-		std::vector<std::size_t> numPoints(k,0); // number of points in each cluster
-		std::vector<RealVector> newCenters(k,RealVector(dimension,0.0));
-			
-		for(auto element: clusterMembership.elements()){
-			std::size_t j = element.label;
-			noalias(newCenters[j]) += element.input;
-			numPoints[j]++;
+		sums.clear();
+		counts.clear();
+		for(std::size_t i = 0; i != ell; ++i){
+			noalias(row(sums,assignment[i])) += elements[i];
+			counts(assignment[i]) += 1.0;
 		}
 		for (std::size_t j=0; j<k; j++) {
-			if (numPoints[j] == 0) {
+			if (counts(j) == 0.0) {
 				// empty cluster - assign random training point
 				std::size_t index = Rng::discrete(0, ell-1);
-				newCenters[j] = dataset.element(index);
+				noalias(newCenter) = elements[index];
 			}
 			else {
-				newCenters[j] /= (double)numPoints[j];
+				noalias(newCenter) = row(sums,j)/counts(j);
 			}
+			delta(j) = distance(row(centers,j), newCenter);
+			noalias(row(centers,j)) = newCenter;
 		}
-		centroids.setCentroids(createDataFromRange(newCenters));
-		
-		//compute new cluster memberships and check whether they are 
-		// equal to the old one, in that case we stop after this iteration
-		Data<unsigned int> newClusterMembership = model(dataset);
-		equal = boost::equal(
-			newClusterMembership.elements(),
-			clusterMembership.labels().elements()
-		);
-		clusterMembership.labels() = newClusterMembership;
+
+		//the bounds decay with the movement of the centers
+		double deltaMax = max(delta);
+		for(std::size_t i = 0; i != ell; ++i){
+			upper(i) += delta(assignment[i]);
+			lower(i) -= deltaMax;
+		}
+
+		//if a center is closer than half the distance to the nearest other
+		//center, no point assigned to it can have moved away from it
+		for(std::size_t j = 0; j != k; ++j){
+			double nearest = std::numeric_limits<double>::max();
+			for(std::size_t j2 = 0; j2 != k; ++j2){
+				if(j2 == j) continue;
+				nearest = std::min(nearest, distanceSqr(row(centers,j), row(centers,j2)));
+			}
+			s(j) = 0.5*std::sqrt(nearest);
+		}
+
+		//reassign only the points whose bounds cannot rule out a change
+		equal = true;
+		for(std::size_t i = 0; i != ell; ++i){
+			double m = std::max(s(assignment[i]), lower(i));
+			if(upper(i) <= m) continue;
+			//tighten the upper bound before scanning all centers
+			upper(i) = distance(elements[i], row(centers,assignment[i]));
+			if(upper(i) <= m) continue;
+			double best, second;
+			std::size_t bestIndex = closestCenters(elements[i], centers, best, second);
+			if(bestIndex != assignment[i]){
+				assignment[i] = bestIndex;
+				equal = false;
+			}
+			upper(i) = std::sqrt(best);
+			lower(i) = std::sqrt(second);
+		}
+	}
+
+	std::vector<RealVector> newCenters(k,RealVector(dimension));
+	for(std::size_t j = 0; j != k; ++j){
+		noalias(newCenters[j]) = row(centers,j);
 	}
+	centroids.setCentroids(createDataFromRange(newCenters));
 
 	// return the number of iterations
 	return iter;
 }
 
+std::size_t shark::kMeansMinibatch(
+	Data<RealVector> const& dataset, std::size_t k, Centroids& centroids,
+	std::size_t iterations, std::size_t batchSize
+){
+	SIZE_CHECK(k <= dataset.numberOfElements());
+	SIZE_CHECK(batchSize != 0);
+
+	std::size_t ell = dataset.numberOfElements();
+	std::size_t dimension = dataDimension(dataset);
+	DataView<Data<RealVector> const> elements(dataset);
+
+	//if the centers are not already initialized, do it now
+	if (centroids.numberOfClusters() != k){
+		centroids.initFromData(dataset,k);
+	}
+	RealMatrix centers(k, dimension);
+	{
+		std::size_t j = 0;
+		for(auto const& c : centroids.centroids().elements()){
+			noalias(row(centers,j++)) = c;
+		}
+	}
+
+	//minibatch k-means as described in
+	//D. Sculley. Web-scale k-means clustering. WWW 2010.
+	//Every iteration assigns a random sample of points with the centers held
+	//fixed and then moves every center towards its sampled points with a
+	//per-center learning rate that decays with the number of points it has seen.
+	RealVector counts(k, 0.0);
+	std::vector<std::size_t> sample(batchSize);
+	std::vector<std::size_t> sampleAssignment(batchSize);
+	for(std::size_t iter = 0; iter != iterations; ++iter){
+		for(std::size_t b = 0; b != batchSize; ++b){
+			sample[b] = Rng::discrete(0, ell-1);
+			double best, second;
+			sampleAssignment[b] = closestCenters(elements[sample[b]], centers, best, second);
+		}
+		for(std::size_t b = 0; b != batchSize; ++b){
+			std::size_t j = sampleAssignment[b];
+			counts(j) += 1.0;
+			double eta = 1.0/counts(j);
+			noalias(row(centers,j)) = (1.0 - eta)*row(centers,j) + eta*elements[sample[b]];
+		}
+	}
+
+	std::vector<RealVector> newCenters(k,RealVector(dimension));
+	for(std::size_t j = 0; j != k; ++j){
+		noalias(newCenters[j]) = row(centers,j);
+	}
+	centroids.setCentroids(createDataFromRange(newCenters));
+
+	return iterations;
+}
+
 std::size_t shark::kMeans(Data<RealVector> const& data, RBFLayer& model, std::size_t maxIterations){
 	//calculate clustering
 	Centroids centroids;
 	std::size_t iter = kMeans(data,model.outputSize(),centroids,maxIterations);
-	model.centers() = createBatch<RealVector>(centroids.centroids().elements());
+	model.setCenters(createBatch<RealVector>(centroids.centroids().elements()));
 	return iter;
 }
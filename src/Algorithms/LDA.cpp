@@ -34,6 +34,7 @@
 #define SHARK_COMPILE_DLL
 #include <shark/Algorithms/Trainers/LDA.h>
 #include <shark/LinAlg/solveSystem.h>
+#include <shark/Core/OpenMP.h>
 
 using namespace shark;
 
@@ -49,9 +50,17 @@ void LDA::train(LinearClassifier<>& model, LabeledData<RealVector,unsigned int>
 	UIntVector num(classes,0);
 	RealMatrix means(classes, dim,0.0);
 	RealMatrix covariance(dim, dim,0.0);
-	
-	//we compute the data batch wise
-	for(auto const& batch: dataset.batches()){
+
+	//accumulate the sufficient statistics of the batches in parallel;
+	//every thread sums into its own accumulators which are combined afterwards
+	std::size_t numBatches = dataset.numberOfBatches();
+	std::size_t numThreads = SHARK_NUM_THREADS;
+	std::vector<UIntVector> threadNum(numThreads, num);
+	std::vector<RealMatrix> threadMeans(numThreads, means);
+	std::vector<RealMatrix> threadCovariance(numThreads, covariance);
+	SHARK_PARALLEL_FOR(long b = 0; b < (long)numBatches; ++b){
+		std::size_t thread = SHARK_THREAD_NUM;
+		auto const& batch = dataset.batch(b);
 		UIntVector const& labels = batch.label;
 		RealMatrix const& points = batch.input;
 		//load batch and update mean
@@ -59,11 +68,17 @@ void LDA::train(LinearClassifier<>& model, LabeledData<RealVector,unsigned int>
 		for (std::size_t e=0; e != currentBatchSize; e++){
 			//update mean and class count for this sample
 			std::size_t c = labels(e);
-			++num(c);
-			noalias(row(means,c))+=row(points,e);
+			++threadNum[thread](c);
+			noalias(row(threadMeans[thread],c))+=row(points,e);
 		}
-		//update second moment matrix
-		noalias(covariance) += prod(trans(points),points);
+		//update second moment matrix; the batch-wise product is
+		//the blocked version of the rank-k update of the full data matrix
+		noalias(threadCovariance[thread]) += prod(trans(points),points);
+	}
+	for(std::size_t t = 0; t != numThreads; ++t){
+		noalias(num) += threadNum[t];
+		noalias(means) += threadMeans[t];
+		noalias(covariance) += threadCovariance[t];
 	}
 	covariance/=inputs-classes;
 	//calculate mean and the covariance matrix from second moment
@@ -118,9 +133,17 @@ void LDA::train(LinearClassifier<>& model, WeightedLabeledData<RealVector,unsign
 	RealMatrix covariance(dim, dim,0.0);
 	double weightSum = sumOfWeights(dataset);
 	RealVector classWeight(classes,0.0);
-	
-	//we compute the data batch wise
-	for(auto const& batch: dataset.batches()){
+
+	//accumulate the sufficient statistics of the batches in parallel;
+	//every thread sums into its own accumulators which are combined afterwards
+	std::size_t numBatches = dataset.numberOfBatches();
+	std::size_t numThreads = SHARK_NUM_THREADS;
+	std::vector<RealVector> threadClassWeight(numThreads, classWeight);
+	std::vector<RealMatrix> threadMeans(numThreads, means);
+	std::vector<RealMatrix> threadCovariance(numThreads, covariance);
+	SHARK_PARALLEL_FOR(long b = 0; b < (long)numBatches; ++b){
+		std::size_t thread = SHARK_THREAD_NUM;
+		auto const& batch = dataset.batch(b);
 		UIntVector const& labels = batch.data.label;
 		RealMatrix points = batch.data.input;
 		RealVector const& weights = batch.weight;
@@ -129,13 +152,19 @@ void LDA::train(LinearClassifier<>& model, WeightedLabeledData<RealVector,unsign
 		for (std::size_t e=0; e != currentBatchSize; e++){
 			//update mean and class count for this sample
 			std::size_t c = labels(e);
-			classWeight(c) += weights(e);
-			noalias(row(means,c)) += weights(e)*row(points,e);
+			threadClassWeight[thread](c) += weights(e);
+			noalias(row(threadMeans[thread],c)) += weights(e)*row(points,e);
 			row(points,e) *= std::sqrt(weights(e));
-			
+
 		}
-		//update second moment matrix
-		noalias(covariance) += prod(trans(points),points);
+		//update second moment matrix; the batch-wise product is
+		//the blocked version of the rank-k update of the full data matrix
+		noalias(threadCovariance[thread]) += prod(trans(points),points);
+	}
+	for(std::size_t t = 0; t != numThreads; ++t){
+		noalias(classWeight) += threadClassWeight[t];
+		noalias(means) += threadMeans[t];
+		noalias(covariance) += threadCovariance[t];
 	}
 	covariance /= weightSum;
 	
@@ -32,7 +32,9 @@
  */
 //===========================================================================
 #define SHARK_COMPILE_DLL
+#include <shark/LinAlg/Cholesky.h>
 #include <shark/LinAlg/eigenvalues.h>
+#include <shark/LinAlg/solveTriangular.h>
 #include <shark/Data/Statistics.h>
 #include <shark/Algorithms/Trainers/PCA.h>
 
@@ -110,6 +112,95 @@ void PCA::setData(UnlabeledData<RealVector> const& inputs) {
 	}
 }
 
+/// Add a chunk of data to the sufficient statistics.
+void PCA::update(UnlabeledData<RealVector> const& inputs) {
+	SHARK_CHECK(!inputs.empty(), "[PCA::update] input must not be empty");
+	std::size_t dim = dataDimension(inputs);
+	if(m_sum.size() == 0){
+		//first chunk defines the dimensionality
+		m_n = dim;
+		m_l = 0;
+		m_sum.resize(dim);
+		m_sum.clear();
+		m_secondMoment.resize(dim, dim);
+		m_secondMoment.clear();
+	}
+	SHARK_CHECK(dim == m_n, "[PCA::update] dimension of the input does not match previous chunks");
+
+	//fold every batch into the statistics as one rank-k update
+	for(auto const& batch: inputs.batches()){
+		noalias(m_sum) += sum_rows(batch);
+		noalias(m_secondMoment) += prod(trans(batch),batch);
+		m_l += batch.size1();
+	}
+}
+
+/// Merge the sufficient statistics accumulated by another PCA object.
+void PCA::merge(PCA const& other) {
+	SHARK_CHECK(other.m_sum.size() != 0, "[PCA::merge] the argument holds no statistics");
+	if(m_sum.size() == 0){
+		m_n = other.m_n;
+		m_l = other.m_l;
+		m_sum = other.m_sum;
+		m_secondMoment = other.m_secondMoment;
+		return;
+	}
+	SHARK_CHECK(other.m_n == m_n, "[PCA::merge] dimensions of the statistics do not match");
+	m_l += other.m_l;
+	noalias(m_sum) += other.m_sum;
+	noalias(m_secondMoment) += other.m_secondMoment;
+}
+
+/// Decompose the covariance matrix given by the accumulated statistics.
+void PCA::finalize() {
+	SHARK_CHECK(m_l >= 2, "[PCA::finalize] the statistics need to contain at least two points");
+	m_mean = m_sum/double(m_l);
+	//covariance from second moment, normalized as in meanvar
+	RealMatrix S = m_secondMoment/double(m_l) - outer_prod(m_mean,m_mean);
+	m_eigenvalues.resize(m_n);
+	m_eigenvectors.resize(m_n, m_n);
+	eigensymm(S, m_eigenvectors, m_eigenvalues);
+}
+
+/// Refit the leading eigenbasis by subspace iteration, warm-started from the previous solution.
+void PCA::refit(std::size_t components, std::size_t sweeps) {
+	SHARK_CHECK(m_l >= 2, "[PCA::refit] the statistics need to contain at least two points");
+	SHARK_CHECK(
+		m_eigenvectors.size1() == m_n && m_eigenvectors.size2() != 0,
+		"[PCA::refit] no previous eigenbasis to start from"
+	);
+	if(!components) components = m_eigenvectors.size2();
+	components = std::min(components, m_eigenvectors.size2());
+
+	m_mean = m_sum/double(m_l);
+	//covariance from second moment, normalized as in meanvar
+	RealMatrix S = m_secondMoment/double(m_l) - outer_prod(m_mean,m_mean);
+
+	//orthogonal iteration: multiply the starting subspace with the covariance
+	//and orthonormalize again. the previous eigenvectors already dominate the
+	//leading subspace, so a drifting basis is tracked within a few sweeps
+	RealMatrix V = columns(m_eigenvectors,0,components);
+	RealMatrix W(m_n,components);
+	for(std::size_t sweep = 0; sweep != sweeps; ++sweep){
+		noalias(W) = prod(S,V);
+		//orthonormalize via the Cholesky factor of the Gram matrix:
+		//with G = W^T W = C C^T the matrix W C^{-T} has orthonormal columns
+		RealMatrix G = prod(trans(W),W);
+		RealMatrix C(components,components,0.0);
+		choleskyDecomposition(G,C);
+		blas::solveTriangularSystemInPlace<blas::SolveXAB, blas::upper>(trans(C), W);
+		noalias(V) = W;
+	}
+
+	//Rayleigh-Ritz rotation of the subspace into eigenvector estimates
+	noalias(W) = prod(S,V);
+	RealMatrix B = prod(trans(V),W);
+	RealMatrix U(components,components);
+	m_eigenvalues.resize(components);
+	eigensymm(B, U, m_eigenvalues);
+	m_eigenvectors = prod(V,U);
+}
+
 //! Returns a model mapping the original data to the
 //! m-dimensional PCA coordinate system.
 void PCA::encoder(LinearModel<>& model, std::size_t m) {
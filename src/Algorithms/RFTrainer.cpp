@@ -131,11 +131,27 @@ void RFTrainer::train(RFClassifier& model, RegressionDataset const& dataset)
 			} else cart.computeOOBerror(dataOOB);
 		}
 
+		// evaluate the oob sample outside of the critical region, so that
+		// only the cheap merge is serialized between the threads
+		RealMatrix bagPredictions;
+		if(m_computeOOBerror){
+			bagPredictions.resize(bag.oobIndices.size(),m_labelDimension);
+			std::size_t k = 0;
+			for(auto const i : bag.oobIndices){
+				noalias(row(bagPredictions,k)) = cart(elements[i].input);
+				++k;
+			}
+		}
+
 		SHARK_CRITICAL_REGION{
 			model.addModel(cart);
-			for(auto const i : bag.oobIndices){
-				row(oobPredictions,i) += cart(elements[i].input);
-				++n_predictions[i];
+			if(m_computeOOBerror){
+				std::size_t k = 0;
+				for(auto const i : bag.oobIndices){
+					row(oobPredictions,i) += row(bagPredictions,k);
+					++n_predictions[i];
+					++k;
+				}
 			}
 		}
 	}
@@ -196,12 +212,25 @@ void RFTrainer::train(RFClassifier& model, ClassificationDataset const& dataset)
 			} else cart.computeOOBerror(dataOOB);
 		}
 
-		SHARK_CRITICAL_REGION{
-			model.addModel(cart);
+		// evaluate the oob sample outside of the critical region, so that
+		// only the cheap merge is serialized between the threads
+		std::vector<std::size_t> bagLabels;
+		if(m_computeOOBerror){
+			bagLabels.reserve(bag.oobIndices.size());
 			for(auto const i : bag.oobIndices){
 				auto histogram = cart(elements[i].input);
-				auto j = arg_max(histogram);
-				++oobClassTally(i,j);
+				bagLabels.push_back(arg_max(histogram));
+			}
+		}
+
+		SHARK_CRITICAL_REGION{
+			model.addModel(cart);
+			if(m_computeOOBerror){
+				std::size_t k = 0;
+				for(auto const i : bag.oobIndices){
+					++oobClassTally(i,bagLabels[k]);
+					++k;
+				}
 			}
 		}
 	}
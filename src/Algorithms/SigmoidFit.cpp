@@ -34,30 +34,121 @@
 
 #define SHARK_COMPILE_DLL
 #include <shark/Algorithms/Trainers/SigmoidFit.h>
-#include <shark/Models/LinearModel.h>
 #include <shark/Algorithms/GradientDescent/Rprop.h>
-#include <shark/ObjectiveFunctions/ErrorFunction.h>
-#include <shark/ObjectiveFunctions/Loss/CrossEntropy.h>
+#include <shark/Core/utility/functional.h>
+#include <shark/Data/DataView.h>
+#include <shark/ObjectiveFunctions/AbstractObjectiveFunction.h>
 
 using namespace shark;
 
-SigmoidFitRpropNLL::SigmoidFitRpropNLL( unsigned int iters ){
+namespace {
+
+// Negative log-likelihood of the calibration sigmoid over a flat buffer of
+// decision values. The values and label signs are extracted once, so every
+// Rprop iteration evaluates objective and gradient in a few vectorized
+// passes over contiguous memory instead of re-walking the dataset through
+// the generic error function machinery.
+class FlatSigmoidNLL : public SingleObjectiveFunction
+{
+public:
+	FlatSigmoidNLL(RealVector const& values, RealVector const& signs, bool offset)
+	: m_values(values), m_signs(signs), m_offset(offset){
+		m_features |= HAS_FIRST_DERIVATIVE;
+		m_features |= CAN_PROPOSE_STARTING_POINT;
+	}
+
+	std::string name() const
+	{ return "FlatSigmoidNLL"; }
+
+	std::size_t numberOfVariables() const{
+		return m_offset ? 2 : 1;
+	}
+
+	SearchPointType proposeStartingPoint() const{
+		return SearchPointType(numberOfVariables(),0.0);
+	}
+
+	double eval(SearchPointType const& point) const{
+		SIZE_CHECK(point.size() == numberOfVariables());
+		m_evaluationCounter++;
+		RealVector margins = point(0) * (m_signs * m_values);
+		if(m_offset)
+			noalias(margins) += point(1) * m_signs;
+		double error = 0.0;
+		for(std::size_t i = 0; i != margins.size(); ++i){
+			error += lossOfMargin(margins(i));
+		}
+		return error;
+	}
+
+	double evalDerivative(SearchPointType const& point, FirstOrderDerivative& derivative) const{
+		SIZE_CHECK(point.size() == numberOfVariables());
+		m_evaluationCounter++;
+		RealVector margins = point(0) * (m_signs * m_values);
+		if(m_offset)
+			noalias(margins) += point(1) * m_signs;
+		double error = 0.0;
+		//loss derivative wrt the decision value: -y_i sigma(-margin_i)
+		RealVector residuals(margins.size());
+		for(std::size_t i = 0; i != margins.size(); ++i){
+			error += lossOfMargin(margins(i));
+			residuals(i) = -m_signs(i) / (1.0 + std::exp(margins(i)));
+		}
+		derivative.resize(numberOfVariables());
+		derivative(0) = inner_prod(residuals, m_values);
+		if(m_offset)
+			derivative(1) = sum(residuals);
+		return error;
+	}
+
+private:
+	//ln(1+exp(-margin)) in double precision, with the same overflow guard as CrossEntropy
+	static double lossOfMargin(double margin){
+		if(margin < -200.0)
+			return -margin;
+		return std::log(1.0 + std::exp(-margin));
+	}
+
+	RealVector const& m_values;
+	RealVector const& m_signs;
+	bool m_offset;
+};
+
+}
+
+SigmoidFitRpropNLL::SigmoidFitRpropNLL( unsigned int iters, std::size_t maxSamples ){
 	m_iterations = iters;
+	m_maxSamples = maxSamples;
 }
 
 // optimize the sigmoid using rprop on the negative log-likelihood
 void SigmoidFitRpropNLL::train(SigmoidModel& model, LabeledData<RealVector, unsigned int> const& dataset)
 {
-	LinearModel<> trainModel;
-	trainModel.setStructure(1,1,model.hasOffset());
-	CrossEntropy loss;
-	ErrorFunction modeling_error( dataset, &trainModel, &loss );
+	//extract the decision values and label signs into contiguous buffers,
+	//optionally from a random subset of the elements
+	DataView<LabeledData<RealVector, unsigned int> const> view(dataset);
+	std::size_t ic = view.size();
+	std::vector<std::size_t> indices(ic);
+	for(std::size_t i = 0; i != ic; ++i)
+		indices[i] = i;
+	if(m_maxSamples > 0 && m_maxSamples < ic){
+		partial_shuffle(indices.begin(), indices.begin() + m_maxSamples, indices.end());
+		ic = m_maxSamples;
+	}
+	RealVector values(ic);
+	RealVector signs(ic);
+	for(std::size_t i = 0; i != ic; ++i){
+		values(i) = view[indices[i]].input(0);
+		signs(i) = (view[indices[i]].label == 1) ? 1.0 : -1.0;
+	}
+
+	FlatSigmoidNLL modeling_error(values, signs, model.hasOffset());
 	IRpropPlus rprop;
 	rprop.init( modeling_error );
 	for (unsigned int i=0; i<m_iterations; i++) {
 		rprop.step( modeling_error );
 	}
-	RealVector solution(2,0.0); 
+	RealVector solution(2,0.0);
 	solution(0) = rprop.solution().point(0);
 	if(model.slopeIsExpEncoded()){
 		solution(0) = std::log(solution(0));
@@ -36,7 +36,11 @@
 #include <boost/spirit/include/qi.hpp>
 #include <boost/fusion/adapted/std_pair.hpp>
 #include <shark/Data/Csv.h>
+#include <shark/Data/Impl/TextImport.hpp>
+#include <shark/Core/OpenMP.h>
 #include <vector>
+#include <cstdlib>
+#include <cstring>
 #include <ctype.h>
 
 namespace {
@@ -215,6 +219,167 @@ void csvStringToDataImpl(
 	SIZE_CHECK(currentRow == rows.size());
 }
 
+///////////////FAST PARALLEL READER FOR DENSE NUMERIC FILES
+
+using shark::detail::MappedFile;
+using shark::detail::skipBlank;
+using shark::detail::parseValue;
+
+///\brief Rows parsed from one chunk of the file, values stored contiguously.
+struct ParsedChunk{
+	std::vector<double> values;
+	std::vector<std::size_t> rowLengths;
+	bool ok;
+};
+
+//parses [pos,end) - which must start and stop at line boundaries - into rows
+void parseChunk(
+	char const* pos, char const* end,
+	char separator, char comment,
+	ParsedChunk& chunk
+){
+	double const qnan = std::numeric_limits<double>::quiet_NaN();
+	chunk.ok = true;
+	while(pos != end){
+		skipBlank(pos, end);
+		if(pos == end) break;
+		if(*pos == '\n'){//blank line
+			++pos;
+			continue;
+		}
+		if(*pos == comment){//comment line
+			while(pos != end && *pos != '\n') ++pos;
+			continue;
+		}
+		//parse one row
+		std::size_t rowStart = chunk.values.size();
+		bool expectValue = true;
+		while(true){
+			skipBlank(pos, end);
+			if(pos == end || *pos == '\n' || *pos == comment){
+				if(expectValue && separator != 0 && chunk.values.size() != rowStart){
+					chunk.ok = false;//trailing separator
+					return;
+				}
+				break;
+			}
+			if(*pos == '?'){
+				chunk.values.push_back(qnan);
+				++pos;
+			}else if(separator != 0 && *pos == separator){
+				chunk.values.push_back(qnan);//empty field
+			}else{
+				bool okValue = false;
+				double value = parseValue(pos, end, okValue);
+				if(!okValue){
+					chunk.ok = false;
+					return;
+				}
+				chunk.values.push_back(value);
+			}
+			skipBlank(pos, end);
+			if(separator != 0){
+				if(pos != end && *pos == separator){
+					++pos;
+					expectValue = true;
+				}else{
+					expectValue = false;
+					if(pos != end && *pos != '\n' && *pos != comment){
+						chunk.ok = false;//garbage after the last field
+						return;
+					}
+				}
+			}
+		}
+		chunk.rowLengths.push_back(chunk.values.size() - rowStart);
+		if(pos != end && *pos == comment){//trailing comment
+			while(pos != end && *pos != '\n') ++pos;
+		}
+		if(pos != end) ++pos;//consume the newline
+	}
+}
+
+template<class T>
+void csvFileToDataImpl(
+	shark::Data<shark::blas::vector<T> >& data,
+	std::string const& fn,
+	char separator,
+	char comment,
+	std::size_t maximumBatchSize,
+	std::size_t titleLines
+){
+	MappedFile file(fn, "[importCSV] Stream cannot be opened for reading.");
+	char const* begin = file.begin();
+	char const* end = file.end();
+	for(std::size_t i = 0; i != titleLines; ++i){//skip requested header lines
+		while(begin != end && *begin != '\n') ++begin;
+		if(begin != end) ++begin;
+	}
+	char fieldSeparator = std::isspace(separator)? 0: separator;
+
+	//split the file at line boundaries into one chunk per thread
+	std::size_t size = end - begin;
+	std::size_t numChunks = std::min<std::size_t>(SHARK_NUM_THREADS, size / (64 * 1024) + 1);
+	std::vector<char const*> boundaries(numChunks + 1, end);
+	boundaries[0] = begin;
+	for(std::size_t c = 1; c != numChunks; ++c){
+		char const* pos = begin + (c * size) / numChunks;
+		while(pos != end && *pos != '\n') ++pos;
+		if(pos != end) ++pos;
+		boundaries[c] = std::max(pos, boundaries[c-1]);
+	}
+
+	std::vector<ParsedChunk> chunks(numChunks);
+	SHARK_PARALLEL_FOR(int c = 0; c < (int)numChunks; ++c){
+		parseChunk(boundaries[c], boundaries[c+1], fieldSeparator, comment, chunks[c]);
+	}
+
+	//verify that the fast scanner accepted the file and produced a rectangle
+	bool ok = true;
+	std::size_t numRows = 0;
+	std::size_t dimensions = 0;
+	for(std::size_t c = 0; c != numChunks && ok; ++c){
+		ok = chunks[c].ok;
+		for(std::size_t r = 0; r != chunks[c].rowLengths.size(); ++r){
+			if(numRows == 0)
+				dimensions = chunks[c].rowLengths[r];
+			else if(chunks[c].rowLengths[r] != dimensions)
+				throw SHARKEXCEPTION("vectors are required to have same size");
+			++numRows;
+		}
+	}
+	if(!ok){//the file uses syntax outside the fast path - use the grammar
+		std::string contents(begin, end);
+		csvStringToData(data, contents, separator, comment, maximumBatchSize);
+		return;
+	}
+	if(numRows == 0){//empty file leads to empty data object.
+		data = shark::Data<shark::blas::vector<T> >();
+		return;
+	}
+
+	//assemble the batches directly from the chunk storage
+	std::vector<std::size_t> batchSizes = shark::detail::optimalBatchSizes(numRows, maximumBatchSize);
+	data = shark::Data<shark::blas::vector<T> >(batchSizes.size());
+	std::size_t chunkIndex = 0;
+	std::size_t valueOffset = 0;
+	for(std::size_t b = 0; b != batchSizes.size(); ++b){
+		shark::blas::matrix<T>& batch = data.batch(b);
+		batch.resize(batchSizes[b], dimensions);
+		for(std::size_t i = 0; i != batchSizes[b]; ++i){
+			while(valueOffset == chunks[chunkIndex].values.size()){
+				++chunkIndex;
+				valueOffset = 0;
+			}
+			double const* rowValues = &chunks[chunkIndex].values[valueOffset];
+			for(std::size_t j = 0; j != dimensions; ++j){
+				batch(i,j) = static_cast<T>(rowValues[j]);
+			}
+			valueOffset += dimensions;
+		}
+	}
+}
+
 }//end unnamed namespace
 
 //start function implementations
@@ -542,6 +707,29 @@ void shark::csvStringToData(
 }
 
 
+void shark::csvFileToData(
+	Data<RealVector>& data,
+	std::string const& fn,
+	char separator,
+	char comment,
+	std::size_t maximumBatchSize,
+	std::size_t titleLines
+){
+	csvFileToDataImpl(data, fn, separator, comment, maximumBatchSize, titleLines);
+}
+
+void shark::csvFileToData(
+	Data<FloatVector>& data,
+	std::string const& fn,
+	char separator,
+	char comment,
+	std::size_t maximumBatchSize,
+	std::size_t titleLines
+){
+	csvFileToDataImpl(data, fn, separator, comment, maximumBatchSize, titleLines);
+}
+
+
 ///////////////IMPORT WRAPPERS
 
 
@@ -36,13 +36,35 @@
 #include <boost/spirit/include/qi.hpp>
 #include <boost/fusion/adapted/std_pair.hpp>
 #include <shark/Data/SparseData.h>
+#include <shark/Data/Impl/TextImport.hpp>
+#include <shark/Core/OpenMP.h>
 
 using namespace shark;
 
 namespace {
 
+//the whole file in compressed row form: the nonzeros of all rows are
+//stored back to back in indices/values, row i owning the half open range
+//[rowStarts[i], rowStarts[i+1])
+struct SparseFileContents{
+	std::vector<double> labels;
+	std::vector<std::size_t> rowStarts;
+	std::vector<std::size_t> indices;
+	std::vector<double> values;
+
+	std::size_t numPoints()const{
+		return labels.size();
+	}
+	std::size_t rowBegin(std::size_t i)const{
+		return rowStarts[i];
+	}
+	std::size_t rowEnd(std::size_t i)const{
+		return rowStarts[i + 1];
+	}
+};
+
 typedef std::pair<double, std::vector<std::pair<std::size_t, double> > > LibSVMPoint;
-inline std::vector<LibSVMPoint> 
+inline SparseFileContents
 importSparseDataReader(std::istream& stream) {
 	std::vector<LibSVMPoint> fileContents;
 	while(stream) {
@@ -66,73 +88,206 @@ importSparseDataReader(std::istream& stream) {
 
 		fileContents.push_back(newPoint);
 	}
-	return fileContents;
+
+	//flatten the points into compressed row form
+	SparseFileContents contents;
+	contents.labels.reserve(fileContents.size());
+	contents.rowStarts.reserve(fileContents.size() + 1);
+	contents.rowStarts.push_back(0);
+	for(std::size_t i = 0; i != fileContents.size(); ++i){
+		contents.labels.push_back(fileContents[i].first);
+		auto const& inputs = fileContents[i].second;
+		for(std::size_t j = 0; j != inputs.size(); ++j){
+			contents.indices.push_back(inputs[j].first);
+			contents.values.push_back(inputs[j].second);
+		}
+		contents.rowStarts.push_back(contents.indices.size());
+	}
+	return contents;
 }
 
+///////////////FAST PARALLEL READER FOR SPARSE (LIBSVM) FILES
+
+using shark::detail::MappedFile;
+using shark::detail::skipBlank;
+using shark::detail::parseValue;
+using shark::detail::parseIndex;
+
+///\brief Rows parsed from one chunk of the file, nonzeros stored contiguously.
+struct SparseChunk{
+	std::vector<double> labels;
+	std::vector<std::size_t> rowNonzeros;
+	std::vector<std::size_t> indices;
+	std::vector<double> values;
+	bool ok;
+};
+
+//parses [pos,end) - which must start and stop at line boundaries - into rows
+void parseSparseChunk(char const* pos, char const* end, SparseChunk& chunk){
+	chunk.ok = true;
+	while(pos != end){
+		skipBlank(pos, end);
+		if(pos == end) break;
+		if(*pos == '\n'){//blank line
+			++pos;
+			continue;
+		}
+		//parse the label followed by index:value pairs until the line ends
+		bool okLabel = false;
+		double label = parseValue(pos, end, okLabel);
+		if(!okLabel){
+			chunk.ok = false;
+			return;
+		}
+		std::size_t rowStart = chunk.indices.size();
+		while(true){
+			skipBlank(pos, end);
+			if(pos == end || *pos == '\n') break;
+			bool okIndex = false;
+			std::size_t index = parseIndex(pos, end, okIndex);
+			if(!okIndex){
+				chunk.ok = false;
+				return;
+			}
+			skipBlank(pos, end);
+			if(pos == end || *pos != ':'){
+				chunk.ok = false;
+				return;
+			}
+			++pos;
+			skipBlank(pos, end);
+			bool okValue = false;
+			double value = parseValue(pos, end, okValue);
+			if(!okValue){
+				chunk.ok = false;
+				return;
+			}
+			chunk.indices.push_back(index);
+			chunk.values.push_back(value);
+		}
+		chunk.labels.push_back(label);
+		chunk.rowNonzeros.push_back(chunk.indices.size() - rowStart);
+		if(pos != end) ++pos;//consume the newline
+	}
+}
+
+//parses the file in parallel chunks and stitches the per-chunk rows
+//together; returns false when a chunk used syntax outside the fast path
+bool readSparseFile(std::string const& fn, SparseFileContents& contents){
+	MappedFile file(fn, "[shark::importSparseData] failed to open file for input");
+	char const* begin = file.begin();
+	char const* end = file.end();
+
+	//split the file at line boundaries into one chunk per thread
+	std::size_t size = end - begin;
+	std::size_t numChunks = std::min<std::size_t>(SHARK_NUM_THREADS, size / (64 * 1024) + 1);
+	std::vector<char const*> boundaries(numChunks + 1, end);
+	boundaries[0] = begin;
+	for(std::size_t c = 1; c != numChunks; ++c){
+		char const* pos = begin + (c * size) / numChunks;
+		while(pos != end && *pos != '\n') ++pos;
+		if(pos != end) ++pos;
+		boundaries[c] = std::max(pos, boundaries[c-1]);
+	}
+
+	std::vector<SparseChunk> chunks(numChunks);
+	SHARK_PARALLEL_FOR(int c = 0; c < (int)numChunks; ++c){
+		parseSparseChunk(boundaries[c], boundaries[c+1], chunks[c]);
+	}
+
+	std::size_t numPoints = 0;
+	std::size_t numNonzeros = 0;
+	for(std::size_t c = 0; c != numChunks; ++c){
+		if(!chunks[c].ok) return false;
+		numPoints += chunks[c].labels.size();
+		numNonzeros += chunks[c].indices.size();
+	}
+
+	contents.labels.reserve(numPoints);
+	contents.rowStarts.reserve(numPoints + 1);
+	contents.indices.reserve(numNonzeros);
+	contents.values.reserve(numNonzeros);
+	contents.rowStarts.push_back(0);
+	for(std::size_t c = 0; c != numChunks; ++c){
+		SparseChunk const& chunk = chunks[c];
+		contents.labels.insert(contents.labels.end(), chunk.labels.begin(), chunk.labels.end());
+		contents.indices.insert(contents.indices.end(), chunk.indices.begin(), chunk.indices.end());
+		contents.values.insert(contents.values.end(), chunk.values.begin(), chunk.values.end());
+		for(std::size_t r = 0; r != chunk.rowNonzeros.size(); ++r)
+			contents.rowStarts.push_back(contents.rowStarts.back() + chunk.rowNonzeros[r]);
+	}
+	return true;
+}
+
+///////////////DATASET CONSTRUCTION FROM THE COMPRESSED ROWS
+
 template<class T>
-void copySparsePoints(Data<blas::vector<T> >& dataset, std::vector<LibSVMPoint> const& points, bool hasZero){
+void copySparsePoints(Data<blas::vector<T> >& dataset, SparseFileContents const& contents, bool hasZero){
 	std::size_t delta = (hasZero ? 0 : 1);
-	std::size_t i = 0;
-	for(auto element: dataset.elements()){
-		element.clear();
-
-		auto const& inputs = points[i].second;
-		for(std::size_t j = 0; j != inputs.size(); ++j)
-			element(inputs[j].first - delta) = inputs[j].second;
-		++i;
+	std::size_t row = 0;
+	for(auto& batch: dataset.batches()){
+		batch.clear();
+		for(std::size_t i = 0; i != batch.size1(); ++i, ++row){
+			for(std::size_t k = contents.rowBegin(row); k != contents.rowEnd(row); ++k)
+				batch(i, contents.indices[k] - delta) = static_cast<T>(contents.values[k]);
+		}
 	}
 }
 
 //sparse vectors need some pre-allocation for fast insertion
 template<class T>
-void copySparsePoints(Data<blas::compressed_vector<T> >& dataset, std::vector<LibSVMPoint> const& points, bool hasZero){
+void copySparsePoints(Data<blas::compressed_vector<T> >& dataset, SparseFileContents const& contents, bool hasZero){
 	std::size_t delta = (hasZero ? 0 : 1);
 	
-	std::size_t start = 0;//first element of the batch in points
+	std::size_t start = 0;//first row of the batch in contents
 	for(auto& batch: dataset.batches()){
 		//allocate nonzeros for every batch and every row in the batch
-		std::size_t nnz = 0;
-		for(std::size_t i = 0; i != batch.size1(); ++i){
-			nnz += points[start+i].second.size();
-		}
+		std::size_t nnz = contents.rowEnd(start + batch.size1() - 1) - contents.rowBegin(start);
 		batch.reserve(nnz);
 		
 		//copy data into the batch
 		for(std::size_t i = 0; i != batch.size1(); ++i){
+			std::size_t row = start + i;
 			//allocate nonzeros for the row
-			batch.reserve_row(i,points[start+i].second.size());
+			batch.reserve_row(i, contents.rowEnd(row) - contents.rowBegin(row));
 			//copy elements
-			auto const& inputs = points[start+i].second;
 			auto pos = batch.row_end(i);
-			for(std::size_t j = 0; j != inputs.size(); ++j,++pos){
-				pos = batch.set_element(pos,inputs[j].first - delta,inputs[j].second);
+			for(std::size_t k = contents.rowBegin(row); k != contents.rowEnd(row); ++k,++pos){
+				pos = batch.set_element(pos, contents.indices[k] - delta, static_cast<T>(contents.values[k]));
 			}
 		}
 		start += batch.size1();
 	}
 }
+
+//finds the highest feature index of the file and checks it against the
+//number of dimensions supplied by the caller
+std::size_t sparseDataDimension(SparseFileContents const& contents, unsigned int dimensions){
+	std::size_t maxIndex = 0;
+	for(std::size_t k = 0; k != contents.indices.size(); ++k)
+		maxIndex = std::max(maxIndex, contents.indices[k]);
+	maxIndex = std::max<std::size_t>(maxIndex,dimensions);
+	if(dimensions > 0 && maxIndex > dimensions){
+		throw SHARKEXCEPTION("number of dimensions supplied is smaller than actual index data");
+	}
+	return maxIndex;
+}
+
+// check for feature index zero (non-standard, but it happens)
+bool sparseDataHasZeroIndex(SparseFileContents const& contents){
+	for(std::size_t k = 0; k != contents.indices.size(); ++k)
+		if(contents.indices[k] == 0) return true;
+	return false;
+}
 	
 template<class T>//We assume T to be vectorial
 shark::LabeledData<T, unsigned int> libsvm_importer_classification(
-	std::istream& stream,
+	SparseFileContents const& contents,
 	unsigned int dimensions,
 	std::size_t batchSize
 ){
-	//read contents of stream
-	std::vector<LibSVMPoint> contents = importSparseDataReader(stream);
-	std::size_t numPoints = contents.size();
-	
-	//find data dimension by getting the maximum index
-	std::size_t maxIndex = 0;
-	for(std::size_t i = 0; i != numPoints; ++i){
-		auto const& inputs = contents[i].second;
-		if(!inputs.empty())
-			maxIndex = std::max(maxIndex, inputs.back().first);
-	}
-	maxIndex = std::max<std::size_t>(maxIndex,dimensions);
-	if(dimensions > 0 && maxIndex > dimensions){
-		throw SHARKEXCEPTION("number of dimensions supplied is smaller than actual index data");
-	}
+	std::size_t numPoints = contents.numPoints();
+	std::size_t maxIndex = sparseDataDimension(contents, dimensions);
 
 	//check labels for conformity
 	bool binaryLabels = false;
@@ -140,8 +295,8 @@ shark::LabeledData<T, unsigned int> libsvm_importer_classification(
 	{
 		int maxPositiveLabel = -1;
 		for(std::size_t i = 0; i != numPoints; ++i){
-			int label = static_cast<int>(contents[i].first);
-			if (label != contents[i].first)
+			int label = static_cast<int>(contents.labels[i]);
+			if (label != contents.labels[i])
 				throw SHARKEXCEPTION("non-integer labels are only allows for regression");
 			if(label < -1)
 				throw SHARKEXCEPTION("negative labels are only allowed for classes -1/1");
@@ -156,18 +311,7 @@ shark::LabeledData<T, unsigned int> libsvm_importer_classification(
 			throw SHARKEXCEPTION("negative labels are only allowed for classes -1/1");
 	}
 
-	// check for feature index zero (non-standard, but it happens)
-	bool hasZero = false;
-	for (std::size_t i=0; i<numPoints; i++)
-	{
-		std::vector<std::pair<std::size_t, double> > const& input = contents[i].second;
-		if (input.empty()) continue;
-		if (input[0].first == 0)
-		{
-			hasZero = true;
-			break;
-		}
-	}
+	bool hasZero = sparseDataHasZeroIndex(contents);
 
 	//copy contents into a new dataset
 	typename shark::LabeledData<T, unsigned int>::element_type blueprint(T(maxIndex + (hasZero ? 1 : 0)),0);
@@ -178,7 +322,7 @@ shark::LabeledData<T, unsigned int> libsvm_importer_classification(
 		for(auto element: data.elements()){
 			//todo: check label
 			//we subtract minPositiveLabel to ensure that class indices starting from 0 and 1 are supported
-			int label = static_cast<int>(contents[i].first);
+			int label = static_cast<int>(contents.labels[i]);
 			element.label = binaryLabels? 1 + (label-1)/2 : label-minPositiveLabel;
 			++i;
 		}
@@ -188,38 +332,13 @@ shark::LabeledData<T, unsigned int> libsvm_importer_classification(
 
 template<class T>//We assume T to be vectorial
 shark::LabeledData<T, RealVector> libsvm_importer_regression(
-	std::istream& stream,
+	SparseFileContents const& contents,
 	unsigned int dimensions,
 	std::size_t batchSize
 ){
-	//read contents of stream
-	std::vector<LibSVMPoint> contents = importSparseDataReader(stream);
-	std::size_t numPoints = contents.size();
-	
-	//find data dimension by getting the maximum index
-	std::size_t maxIndex = 0;
-	for(std::size_t i = 0; i != numPoints; ++i){
-		auto const& inputs = contents[i].second;
-		if(!inputs.empty())
-			maxIndex = std::max(maxIndex, inputs.back().first);
-	}
-	maxIndex = std::max<std::size_t>(maxIndex,dimensions);
-	if (dimensions > 0 && maxIndex > dimensions) {
-		throw SHARKEXCEPTION("number of dimensions supplied is smaller than actual index data");
-	}
-
-	// check for feature index zero (non-standard, but it happens)
-	bool hasZero = false;
-	for (std::size_t i=0; i<numPoints; i++)
-	{
-		auto const& input = contents[i].second;
-		if (input.empty()) continue;
-		if (input[0].first == 0)
-		{
-			hasZero = true;
-			break;
-		}
-	}
+	std::size_t numPoints = contents.numPoints();
+	std::size_t maxIndex = sparseDataDimension(contents, dimensions);
+	bool hasZero = sparseDataHasZeroIndex(contents);
 
 	//copy contents into a new dataset
 	typename shark::LabeledData<T, RealVector>::element_type blueprint(T(maxIndex + (hasZero ? 1 : 0)), RealVector(1));
@@ -228,13 +347,25 @@ shark::LabeledData<T, RealVector> libsvm_importer_regression(
 	{
 		std::size_t i = 0;
 		for(auto element: data.elements()) {
-			element.label = RealVector(1, contents[i].first);
+			element.label = RealVector(1, contents.labels[i]);
 			++i;
 		}
 	}
 	return data;
 }
 
+//reads a file with the parallel scanner, falling back to the line based
+//reader - and its per-record error messages - when the scanner rejects it
+SparseFileContents readSparseFileContents(std::string const& fn){
+	SparseFileContents contents;
+	if(!readSparseFile(fn, contents)){
+		std::ifstream ifs(fn.c_str());
+		if (! ifs.good()) throw SHARKEXCEPTION("[shark::importSparseData] failed to open file for input");
+		contents = importSparseDataReader(ifs);
+	}
+	return contents;
+}
+
 }
 
 void shark::importSparseData(
@@ -243,7 +374,7 @@ void shark::importSparseData(
 	unsigned int highestIndex,
 	std::size_t batchSize
 ){
-	dataset =  libsvm_importer_classification<RealVector>(stream, highestIndex, batchSize);
+	dataset =  libsvm_importer_classification<RealVector>(importSparseDataReader(stream), highestIndex, batchSize);
 }
 
 void shark::importSparseData(
@@ -252,7 +383,7 @@ void shark::importSparseData(
 	unsigned int highestIndex,
 	std::size_t batchSize
 ){
-	dataset =  libsvm_importer_regression<RealVector>(stream, highestIndex, batchSize);
+	dataset =  libsvm_importer_regression<RealVector>(importSparseDataReader(stream), highestIndex, batchSize);
 }
 
 void shark::importSparseData(
@@ -261,7 +392,7 @@ void shark::importSparseData(
 	unsigned int highestIndex,
 	std::size_t batchSize
 ){
-	dataset =  libsvm_importer_classification<CompressedRealVector>(stream, highestIndex, batchSize);
+	dataset =  libsvm_importer_classification<CompressedRealVector>(importSparseDataReader(stream), highestIndex, batchSize);
 }
 
 void shark::importSparseData(
@@ -270,7 +401,7 @@ void shark::importSparseData(
 	unsigned int highestIndex,
 	std::size_t batchSize
 ){
-	dataset =  libsvm_importer_regression<CompressedRealVector>(stream, highestIndex, batchSize);
+	dataset =  libsvm_importer_regression<CompressedRealVector>(importSparseDataReader(stream), highestIndex, batchSize);
 }
 
 void shark::importSparseData(
@@ -279,9 +410,7 @@ void shark::importSparseData(
 	unsigned int highestIndex,
 	std::size_t batchSize
 ){
-	std::ifstream ifs(fn.c_str());
-	if (! ifs.good()) throw SHARKEXCEPTION("[shark::importSparseData] failed to open file for input");
-	dataset =  libsvm_importer_classification<RealVector>(ifs, highestIndex, batchSize);
+	dataset =  libsvm_importer_classification<RealVector>(readSparseFileContents(fn), highestIndex, batchSize);
 }
 
 void shark::importSparseData(
@@ -290,9 +419,7 @@ void shark::importSparseData(
 	unsigned int highestIndex,
 	std::size_t batchSize
 ){
-	std::ifstream ifs(fn.c_str());
-	if (! ifs.good()) throw SHARKEXCEPTION("[shark::importSparseData] failed to open file for input");
-	dataset =  libsvm_importer_regression<RealVector>(ifs, highestIndex, batchSize);
+	dataset =  libsvm_importer_regression<RealVector>(readSparseFileContents(fn), highestIndex, batchSize);
 }
 
 void shark::importSparseData(
@@ -301,9 +428,7 @@ void shark::importSparseData(
 	unsigned int highestIndex,
 	std::size_t batchSize
 ){
-	std::ifstream ifs(fn.c_str());
-	if (! ifs.good()) throw SHARKEXCEPTION("[shark::importSparseData] failed to open file for input");
-	dataset =  libsvm_importer_classification<CompressedRealVector>(ifs, highestIndex, batchSize);
+	dataset =  libsvm_importer_classification<CompressedRealVector>(readSparseFileContents(fn), highestIndex, batchSize);
 }
 
 void shark::importSparseData(
@@ -312,7 +437,5 @@ void shark::importSparseData(
 	unsigned int highestIndex,
 	std::size_t batchSize
 ){
-	std::ifstream ifs(fn.c_str());
-	if (! ifs.good()) throw SHARKEXCEPTION("[shark::importSparseData] failed to open file for input");
-	dataset =  libsvm_importer_regression<CompressedRealVector>(ifs, highestIndex, batchSize);
+	dataset =  libsvm_importer_regression<CompressedRealVector>(readSparseFileContents(fn), highestIndex, batchSize);
 }
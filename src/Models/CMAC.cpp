@@ -34,6 +34,8 @@
 #define SHARK_COMPILE_DLL
 #include <shark/Models/CMAC.h>
 #include <boost/serialization/vector.hpp>
+
+#include <algorithm>
 using namespace shark;
 
 std::size_t CMACMap::getArrayIndexForTiling(std::size_t indexOfTiling,RealVector const &point)const {
@@ -53,14 +55,13 @@ std::size_t CMACMap::getArrayIndexForTiling(std::size_t indexOfTiling,RealVector
 	return index;
 }
 
-std::vector<std::size_t> CMACMap::getIndizes(blas::matrix_row< const RealMatrix> const &point)const {
-	std::vector<size_t> output(m_tilings,0);
+void CMACMap::getIndizes(blas::matrix_row< const RealMatrix> const &point, std::vector<std::size_t>& output)const {
+	output.resize(m_tilings);
 
 	for (size_t tiling = 0; tiling != m_tilings; ++tiling) {
 		size_t index = getArrayIndexForTiling(tiling, point);
 		output[tiling] = index;
 	}
-	return output;
 }
 
 CMACMap::CMACMap():m_tilings(0) {
@@ -125,12 +126,18 @@ void CMACMap::eval(RealMatrix const& patterns,RealMatrix &output) const{
 	output.resize(numPatterns,m_outputSize);
 	output.clear();
 	
+	std::vector<std::size_t> indizes;
 	for(std::size_t i = 0; i != numPatterns; ++i){
-		std::vector<std::size_t> indizes = getIndizes(row(patterns,i));
+		getIndizes(row(patterns,i), indizes);
+		//accumulate in ascending address order for better locality
+		std::sort(indizes.begin(), indizes.end());
 		for (std::size_t o=0; o!=m_outputSize; ++o) {
+			double sum = 0;
+			std::size_t outputOffset = o*m_parametersPerTiling;
 			for (std::size_t j = 0; j != m_tilings; ++j) {
-				output(i,o) += m_parameters(indizes[j] + o*m_parametersPerTiling);
+				sum += m_parameters(indizes[j] + outputOffset);
 			}
+			output(i,o) = sum;
 		}
 	}
 }
@@ -147,11 +154,15 @@ void CMACMap::weightedParameterDerivative(
 	std::size_t numPatterns = patterns.size1();
 	gradient.resize(m_parameters.size());
 	gradient.clear();
+	std::vector<std::size_t> indizes;
 	for(std::size_t i = 0; i != numPatterns; ++i){
-		std::vector<std::size_t> indizes = getIndizes(row(patterns,i));
+		getIndizes(row(patterns,i), indizes);
+		//scatter in ascending address order for better locality
+		std::sort(indizes.begin(), indizes.end());
 		for (std::size_t o=0; o!=m_outputSize; ++o) {
+			std::size_t outputOffset = o*m_parametersPerTiling;
 			for (std::size_t j=0; j != m_tilings; ++j) {
-				gradient(indizes[j] + o*m_parametersPerTiling) += coefficients(i,o);
+				gradient(indizes[j] + outputOffset) += coefficients(i,o);
 			}
 		}
 	}
@@ -46,12 +46,14 @@ Centroids::Centroids(){
 Centroids::Centroids(std::size_t centroids, std::size_t dim)
 : m_centroids(centroids, RealVector(dim, 0.0)){
 	this->m_features |= HAS_SOFT_MEMBERSHIP;
+	updateCentroidNormsSqr();
 }
 
 Centroids::Centroids(Data<RealVector> const& centroids)
 : m_centroids(centroids)
 {
 	this->m_features |= HAS_SOFT_MEMBERSHIP;
+	updateCentroidNormsSqr();
 }
 
 
@@ -64,6 +66,7 @@ RealVector Centroids::parameterVector() const{
 void Centroids::setParameterVector(RealVector const& newParameters){
 	Data<RealVector>::batch_range batches = m_centroids.batches();
 	init(newParameters) >> matrixSet(batches);
+	updateCentroidNormsSqr();
 }
 
 std::size_t Centroids::numberOfParameters() const{
@@ -77,26 +80,61 @@ std::size_t Centroids::numberOfClusters() const{
 
 void Centroids::read(InArchive& archive){
 	archive & m_centroids;
+	updateCentroidNormsSqr();
 }
 
 void Centroids::write(OutArchive& archive) const{
 	archive & m_centroids;
 }
 
-RealMatrix Centroids::distances(BatchInputType const& patterns) const{
+void Centroids::updateCentroidNormsSqr(){
+	m_centroidNormsSqr.resize(numberOfClusters());
+	std::size_t batchBegin = 0;
+	for (std::size_t i=0; i != m_centroids.numberOfBatches(); i++){
+		BatchInputType const& batch = m_centroids.batch(i);
+		for (std::size_t j=0; j != batch.size1(); j++){
+			m_centroidNormsSqr(batchBegin + j) = norm_sqr(row(batch,j));
+		}
+		batchBegin += batch.size1();
+	}
+}
+
+RealMatrix Centroids::distancesSqr(BatchInputType const& patterns) const{
 	std::size_t numClusters = numberOfClusters();
 	std::size_t numPatterns = boost::size(patterns);
+	SIZE_CHECK(m_centroidNormsSqr.size() == numClusters);
 	RealMatrix distances(numPatterns, numClusters);
-	//first evaluate distance to all centroids;
+	//uses (x-c)^2 = x^2 -2xc +c^2: one gemm per batch of centroids...
 	std::size_t batchBegin = 0;
 	for (std::size_t i=0; i != m_centroids.numberOfBatches(); i++){
 		std::size_t batchEnd = batchBegin +boost::size(m_centroids.batch(i));
-		columns(distances,batchBegin,batchEnd) = sqrt(distanceSqr(patterns, m_centroids.batch(i)));
+		noalias(columns(distances,batchBegin,batchEnd)) = -2*prod(patterns, trans(m_centroids.batch(i)));
 		batchBegin = batchEnd;
 	}
+	//...then add the pattern norms and the cached centroid norms
+	for (std::size_t i=0; i != numPatterns; i++){
+		noalias(row(distances,i)) += blas::repeat(norm_sqr(row(patterns,i)),numClusters) + m_centroidNormsSqr;
+	}
 	return distances;
 }
 
+RealMatrix Centroids::distances(BatchInputType const& patterns) const{
+	//max() guards against small negative values produced by cancellation in the gemm trick
+	return sqrt(max(distancesSqr(patterns),0.0));
+}
+
+Centroids::BatchOutputType Centroids::hardMembership(BatchInputType const& patterns) const{
+	std::size_t numPatterns = boost::size(patterns);
+	RealMatrix distances = distancesSqr(patterns);
+	SHARK_ASSERT(distances.size2() > 0);
+	BatchOutputType outputs(numPatterns);
+	for (std::size_t i=0; i != numPatterns; i++){
+		auto dist = row(distances,i);
+		outputs(i) = (unsigned int)(std::min_element(dist.begin(),dist.end())-dist.begin());
+	}
+	return outputs;
+}
+
 RealVector Centroids::softMembership(RealVector const& pattern) const{
 	std::size_t numClusters = numberOfClusters();
 	RealVector membership(numClusters);
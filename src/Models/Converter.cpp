@@ -58,8 +58,8 @@ std::size_t ThresholdConverter::numberOfParameters() const{
 void ThresholdConverter::eval(BatchInputType const& pattern, BatchOutputType& outputs)const{
 	SHARK_CHECK(pattern.size2() == 1, "[ThresholdConverter::eval] invalid size of input");
 	outputs.resize(pattern.size1());
-	for(std::size_t i = 0; i != pattern.size1(); ++i)
-		outputs(i) = (pattern(i,0) > m_threshold) ? 1 : 0;
+	//one masked pass over the column instead of an element loop
+	noalias(outputs) = column(pattern,0) > m_threshold;
 }
 
 ////////////////////////////////////////////////////////////
@@ -83,9 +83,6 @@ std::size_t ThresholdVectorConverter::numberOfParameters() const{
 
 void ThresholdVectorConverter::eval(BatchInputType const& patterns, BatchOutputType& outputs)const{
 	outputs.resize(patterns.size1(),patterns.size2());
-	for(std::size_t i = 0; i != patterns.size1(); ++i){
-		for(std::size_t j = 0; j != patterns.size2(); ++j){
-			outputs(i,j) = patterns(i,j) > m_threshold;
-		}
-	}
+	//one masked pass over the whole batch instead of an element loop
+	noalias(outputs) = patterns > m_threshold;
 }
@@ -36,7 +36,8 @@
 using namespace std;
 using namespace shark;
 
-OnlineRNNet::OnlineRNNet(RecurrentStructure* structure):mpe_structure(structure),m_unitGradient(0,0){
+OnlineRNNet::OnlineRNNet(RecurrentStructure* structure)
+:mpe_structure(structure),m_unitGradient(0,0),m_sensitivityMode(FULL_SENSITIVITIES){
 	SHARK_CHECK(mpe_structure,"[OnlineRNNet] structure pointer is not allowed to be NULL");
 	m_features|=HAS_FIRST_PARAMETER_DERIVATIVE;
 }
@@ -64,11 +65,18 @@ void OnlineRNNet::eval(RealMatrix const& pattern, RealMatrix& output){
 	m_activation(mpe_structure->bias())=1;
 
 	//activation of the hidden neurons is now just a matrix vector multiplication
-
-	noalias(subrange(m_activation,inputSize()+1,numUnits)) = prod(
-		mpe_structure->weights(),
-		m_lastActivation
-	);
+	if(mpe_structure->sparseComputationMode()){
+		//touch only the existing connections
+		RealVector incoming;
+		mpe_structure->multiplyWeights(m_lastActivation,incoming);
+		noalias(subrange(m_activation,inputSize()+1,numUnits)) = incoming;
+	}
+	else{
+		noalias(subrange(m_activation,inputSize()+1,numUnits)) = prod(
+			mpe_structure->weights(),
+			m_lastActivation
+		);
+	}
 
 	//now apply the sigmoid function
 	for (std::size_t i = inputSize()+1;i != numUnits;i++){
@@ -86,7 +94,12 @@ void OnlineRNNet::weightedParameterDerivative(RealMatrix const& pattern, const R
 	SIZE_CHECK(pattern.size2() == inputSize());
 	SIZE_CHECK(pattern.size2() == coefficients.size2());
 	gradient.resize(mpe_structure->parameters());
-	
+
+	if(m_sensitivityMode == DIAGONAL_SENSITIVITIES){
+		weightedParameterDerivativeDiagonal(pattern,coefficients,gradient);
+		return;
+	}
+
 	std::size_t numNeurons = mpe_structure->numberOfNeurons();
 	std::size_t numUnits = mpe_structure->numberOfUnits();
 
@@ -105,26 +118,40 @@ void OnlineRNNet::weightedParameterDerivative(RealMatrix const& pattern, const R
 		neuronDerivatives(i)=mpe_structure->neuronDerivative(m_activation(i+inputSize()+1));
 	}
 	
-	//calculate the derivative for every weight using the derivative of the last time step
-	auto hiddenWeights = columns(
-		mpe_structure->weights(),
-		inputSize()+1,numUnits
-	);
-	
+	std::vector<std::size_t> const& starts = mpe_structure->connectionStarts();
+	std::vector<std::size_t> const& units = mpe_structure->connectionUnits();
+
 	//update the new gradient with the effect of last timestep
-	noalias(m_unitGradient) = prod(m_unitGradient,trans(hiddenWeights));
-	
-	//add the effect of the current time step
-	std::size_t param = 0;
-	for(std::size_t i = 0; i != numNeurons; ++i){
-		for(std::size_t j = 0; j != numUnits; ++j){
-			if(mpe_structure->connection(i,j)){
-				m_unitGradient(param,i) += m_lastActivation(j);
-				++param;
+	if(mpe_structure->sparseComputationMode()){
+		//only the existing recurrent connections propagate sensitivities
+		RealVector const& packedWeights = mpe_structure->packedWeights();
+		RealMatrix propagatedGradient(m_unitGradient.size1(),numNeurons,0.0);
+		for(std::size_t i = 0; i != numNeurons; ++i){
+			for(std::size_t k = starts[i]; k != starts[i+1]; ++k){
+				std::size_t j = units[k];
+				if(j <= inputSize()) continue;//inputs and the bias carry no sensitivities
+				noalias(column(propagatedGradient,i)) += packedWeights(k)*column(m_unitGradient,j-inputSize()-1);
 			}
 		}
+		swap(m_unitGradient,propagatedGradient);
 	}
-	
+	else{
+		auto hiddenWeights = columns(
+			mpe_structure->weights(),
+			inputSize()+1,numUnits
+		);
+		//the product reads the matrix it overwrites, so it must go through a temporary
+		RealMatrix propagatedGradient = prod(m_unitGradient,trans(hiddenWeights));
+		swap(m_unitGradient,propagatedGradient);
+	}
+
+	//add the effect of the current time step; the kth connection is the kth parameter
+	for(std::size_t i = 0; i != numNeurons; ++i){
+		for(std::size_t k = starts[i]; k != starts[i+1]; ++k){
+			m_unitGradient(k,i) += m_lastActivation(units[k]);
+		}
+	}
+
 	//multiply with outer derivative of the neurons
 	for(std::size_t i = 0; i != m_unitGradient.size1();++i){
 		noalias(row(m_unitGradient,i)) = element_prod(row(m_unitGradient,i),neuronDerivatives);
@@ -134,6 +161,51 @@ void OnlineRNNet::weightedParameterDerivative(RealMatrix const& pattern, const R
 		columns(m_unitGradient,numNeurons-outputSize(),numNeurons),
 		row(coefficients,0)
 	);
-	//sanity check
-	SIZE_CHECK(param == mpe_structure->parameters());
+}
+
+void OnlineRNNet::weightedParameterDerivativeDiagonal(RealMatrix const& pattern, const RealMatrix& coefficients,  RealVector& gradient){
+	std::size_t numNeurons = mpe_structure->numberOfNeurons();
+
+	if(m_diagonalGradient.size() != mpe_structure->parameters()){
+		m_diagonalGradient.resize(mpe_structure->parameters());
+		m_diagonalGradient.clear();
+	}
+
+	//calculate the derivative for all neurons f'
+	RealVector neuronDerivatives(numNeurons);
+	for(std::size_t i=0;i!=numNeurons;++i){
+		neuronDerivatives(i)=mpe_structure->neuronDerivative(m_activation(i+inputSize()+1));
+	}
+
+	//the coefficients act directly on the output neurons and through a single
+	//step of the recurrent weights on all neurons; everything beyond that
+	//single step is truncated
+	RealVector learningSignal(numNeurons,0.0);
+	std::size_t firstOutput = numNeurons-outputSize();
+	for(std::size_t k = 0; k != outputSize(); ++k){
+		std::size_t output = firstOutput+k;
+		learningSignal(output) += coefficients(0,k);
+		double back = coefficients(0,k)*neuronDerivatives(output);
+		for(std::size_t l = 0; l != numNeurons; ++l){
+			//the self-recurrent path of the output is already part of its trace
+			if(l == output) continue;
+			std::size_t unit = l+inputSize()+1;
+			if(mpe_structure->connection(output,unit))
+				learningSignal(l) += back*mpe_structure->weights()(output,unit);
+		}
+	}
+
+	//update the traces: only the self-recurrent connection of the postsynaptic
+	//neuron carries the sensitivity of a weight forward in time
+	std::vector<std::size_t> const& starts = mpe_structure->connectionStarts();
+	std::vector<std::size_t> const& units = mpe_structure->connectionUnits();
+	for(std::size_t i = 0; i != numNeurons; ++i){
+		std::size_t unit = i+inputSize()+1;
+		double selfWeight = mpe_structure->connection(i,unit)? mpe_structure->weights()(i,unit): 0.0;
+		for(std::size_t k = starts[i]; k != starts[i+1]; ++k){
+			double& trace = m_diagonalGradient(k);
+			trace = neuronDerivatives(i)*(selfWeight*trace + m_lastActivation(units[k]));
+			gradient(k) = learningSignal(i)*trace;
+		}
+	}
 }
@@ -48,6 +48,21 @@ RBFLayer::RBFLayer(std::size_t numInput, std::size_t numOutput)
 void RBFLayer::setStructure( std::size_t numInput, std::size_t numOutput ){
 	m_centers.resize(numOutput,numInput);
 	m_gamma.resize(numOutput);
+	updateCenterNormsSqr();
+}
+
+void RBFLayer::setCenters(BatchInputType const& centers){
+	SIZE_CHECK(centers.size1() == outputSize());
+	SIZE_CHECK(centers.size2() == inputSize());
+	noalias(m_centers) = centers;
+	updateCenterNormsSqr();
+}
+
+void RBFLayer::updateCenterNormsSqr(){
+	m_centerNormsSqr.resize(outputSize());
+	for(std::size_t i = 0; i != outputSize(); ++i){
+		m_centerNormsSqr(i) = norm_sqr(row(m_centers,i));
+	}
 }
 
 RealVector RBFLayer::parameterVector()const{
@@ -69,9 +84,11 @@ void RBFLayer::setParameterVector(RealVector const& newParameters){
 		RealVector logGamma(outputSize());
 		init(newParameters) >> toVector(m_centers), logGamma;
 		setGamma(exp(logGamma));
-	}else if( m_trainCenters)
+		updateCenterNormsSqr();
+	}else if( m_trainCenters){
 		init(newParameters) >> toVector(m_centers);
-	else if(m_trainWidth){
+		updateCenterNormsSqr();
+	}else if(m_trainWidth){
 		setGamma(exp(newParameters));
 	}
 }
@@ -104,8 +121,13 @@ void RBFLayer::eval(BatchInputType const& patterns, BatchOutputType& output, Sta
 	InternalState& s = state.toState<InternalState>();
 	s.resize(numPatterns,outputSize());
 
-	//we need to add separate gamma parameters for every evaluation
-	noalias(s.norm2) = distanceSqr(patterns,m_centers);
+	//squared distances to all centers via one gemm; the squared center
+	//norms are cached between calls
+	SIZE_CHECK(m_centerNormsSqr.size() == outputSize());
+	noalias(s.norm2) = -2*prod(patterns,trans(m_centers));
+	for(std::size_t i = 0; i != numPatterns; ++i){
+		noalias(row(s.norm2,i)) += blas::repeat(norm_sqr(row(patterns,i)),outputSize()) + m_centerNormsSqr;
+	}
 	
 	//every center has it's own value of gamma, so we need to multiply the i-th column 
 	//of the norm with m_gamma(i) and to normalize it, we have to subtract the normalization
@@ -182,6 +204,7 @@ void RBFLayer::read( InArchive & archive ){
 	archive >> m_logNormalization;;
 	archive >> m_trainCenters;
 	archive >> m_trainWidth;
+	updateCenterNormsSqr();
 }
 
 
@@ -43,6 +43,7 @@ void RNNet::eval(BatchInputType const& patterns, BatchOutputType& outputs, State
 	outputs.resize(patterns.size());
 
 	//calculation of the sequences
+	RealVector incoming;//scratch for the sparse forward step
 	for(std::size_t b = 0; b != patterns.size();++b){
 		std::size_t sequenceLength = patterns[b].size()+warmUpLength+1;
 		s.timeActivation[b].resize(sequenceLength,RealVector(numUnits));
@@ -62,10 +63,17 @@ void RNNet::eval(BatchInputType const& patterns, BatchOutputType& outputs, State
 			sequence[t-1](mpe_structure->bias())=1;
 
 			//activation of the hidden neurons is now just a matrix vector multiplication
-			noalias(subrange(sequence[t],inputSize()+1,numUnits)) = prod(
-				mpe_structure->weights(),
-				sequence[t-1]
-			);
+			if(mpe_structure->sparseComputationMode()){
+				//touch only the existing connections
+				mpe_structure->multiplyWeights(sequence[t-1],incoming);
+				noalias(subrange(sequence[t],inputSize()+1,numUnits)) = incoming;
+			}
+			else{
+				noalias(subrange(sequence[t],inputSize()+1,numUnits)) = prod(
+					mpe_structure->weights(),
+					sequence[t-1]
+				);
+			}
 			//now apply the sigmoid function
 			for (std::size_t i = inputSize()+1;i != numUnits;i++)
 				sequence[t](i) = mpe_structure->neuron(sequence[t](i));
@@ -90,43 +98,62 @@ void RNNet::weightedParameterDerivative(
 	std::size_t numUnits = mpe_structure->numberOfUnits();
 	std::size_t numNeurons = mpe_structure->numberOfNeurons();
 	std::size_t warmUpLength=m_warmUpSequence.size();
+	std::vector<std::size_t> const& starts = mpe_structure->connectionStarts();
+	std::vector<std::size_t> const& units = mpe_structure->connectionUnits();
 	for(std::size_t b = 0; b != patterns.size(); ++b){
 		Sequence const& sequence = s.timeActivation[b];
-		std::size_t sequenceLength = s.timeActivation[b].size();
-		RealMatrix errorDerivative(sequenceLength,numNeurons);
-		errorDerivative.clear();
-		//copy errors
-		for (std::size_t t = warmUpLength+1; t != sequenceLength; ++t)
-			for(std::size_t i = 0; i != outputSize(); ++i)
-				errorDerivative(t,i+numNeurons-outputSize())=coefficients[b][t-warmUpLength-1](i);
-		
-		//backprop through time
-		for (std::size_t t = (int)sequence.size()-1; t > 0; t--){
-			for (std::size_t j = 0; j != numNeurons; ++j){
-				double derivative = mpe_structure->neuronDerivative(sequence[t](j+mpe_structure->inputs()+1));
-				errorDerivative(t,j)*=derivative;
+		std::size_t sequenceLength = sequence.size();
+		//when truncation is requested, the sequence is cut into windows and
+		//errors are not propagated across window boundaries (truncated BPTT).
+		//without truncation a single window spans the whole sequence.
+		std::size_t window = m_truncatedSteps == 0? sequenceLength-1 : m_truncatedSteps;
+		for(std::size_t start = 1; start < sequenceLength; start += window){
+			std::size_t end = std::min(start+window,sequenceLength);
+			//the scratch buffer stores the error of time step t in row t-start,
+			//so its size is bounded by the window length
+			s.errorDerivative.resize(end-start,numNeurons);
+			s.errorDerivative.clear();
+			//copy errors of the output neurons inside the window
+			for (std::size_t t = std::max(start,warmUpLength+1); t < end; ++t)
+				for(std::size_t i = 0; i != outputSize(); ++i)
+					s.errorDerivative(t-start,i+numNeurons-outputSize())=coefficients[b][t-warmUpLength-1](i);
+
+			//backprop through time inside the window
+			for (std::size_t t = end-1; t >= start; t--){
+				for (std::size_t j = 0; j != numNeurons; ++j){
+					double derivative = mpe_structure->neuronDerivative(sequence[t](j+mpe_structure->inputs()+1));
+					s.errorDerivative(t-start,j)*=derivative;
+				}
+				if(t == start) break;//do not propagate across the window boundary
+				if(mpe_structure->sparseComputationMode()){
+					//scatter the error over the existing recurrent connections only
+					RealVector const& packedWeights = mpe_structure->packedWeights();
+					for (std::size_t i = 0; i != numNeurons; ++i){
+						double error = s.errorDerivative(t-start,i);
+						for (std::size_t k = starts[i]; k != starts[i+1]; ++k){
+							std::size_t j = units[k];
+							if(j <= inputSize()) continue;//inputs and the bias receive no error
+							s.errorDerivative(t-start-1,j-inputSize()-1) += packedWeights(k)*error;
+						}
+					}
+				}
+				else{
+					noalias(row(s.errorDerivative,t-start-1)) += prod(
+						trans(columns(mpe_structure->weights(), inputSize()+1,numUnits)),
+						row(s.errorDerivative,t-start)
+					);
+				}
 			}
-			noalias(row(errorDerivative,t-1)) += prod(
-				trans(columns(mpe_structure->weights(), inputSize()+1,numUnits)),
-				row(errorDerivative,t)
-			);
-		}
-		
-		
-		//update gradient for batch element i
-		std::size_t param = 0;
-		for (std::size_t i = 0; i != numNeurons; ++i){
-			for (std::size_t j = 0; j != numUnits; ++j){
-				if(!mpe_structure->connection(i,j))continue;
 
-				for(std::size_t t=1;t != sequence.size(); ++t)
-					gradient(param)+=errorDerivative(t,i) * sequence[t-1](j);
-				
-				++param;
+			//update gradient for batch element b; the kth connection is the kth parameter
+			for (std::size_t i = 0; i != numNeurons; ++i){
+				for (std::size_t k = starts[i]; k != starts[i+1]; ++k){
+					std::size_t j = units[k];
+					for(std::size_t t=start;t != end; ++t)
+						gradient(k)+=s.errorDerivative(t-start,i) * sequence[t-1](j);
+				}
 			}
 		}
-		//sanity check
-		SIZE_CHECK(param == mpe_structure->parameters());
 	}
 }
 
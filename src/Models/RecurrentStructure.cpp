@@ -41,41 +41,66 @@ using namespace shark;
 
 
 RecurrentStructure::RecurrentStructure()
-:m_numberOfNeurons(0),m_inputNeurons(0),m_outputNeurons(0),m_numberOfParameters(0)
+:m_numberOfNeurons(0),m_inputNeurons(0),m_outputNeurons(0),m_numberOfParameters(0),m_sparseComputation(false)
 {}
 
 RealVector RecurrentStructure::parameterVector() const
 {
-	RealVector parameters(m_numberOfParameters);
-	std::size_t param =0;
-	for (size_t i = 0; i != m_numberOfNeurons; ++i){
-		for (size_t j = 0; j != m_numberOfUnits; ++j){
-			if(!m_connectionMatrix(i,j))continue;
-			parameters(param)=m_weights(i,j);
-			++param;
-		}
-	}
-	//sanity check
-	SIZE_CHECK(param == m_numberOfParameters);
-	return parameters;
+	//the packed weights are stored in parameter order
+	return m_packedWeights;
 }
 void RecurrentStructure::setParameterVector(RealVector const& newParameters)
 {
 	SIZE_CHECK(newParameters.size() == m_numberOfParameters);
-	std::size_t param =0;
+	//the parameters are ordered like the CSR view, so both representations
+	//are updated in one pass over the existing connections
+	m_packedWeights = newParameters;
 	for (std::size_t i = 0; i != m_numberOfNeurons; ++i){
+		for (std::size_t k = m_rowStart[i]; k != m_rowStart[i+1]; ++k){
+			m_weights(i,m_columnIndex[k]) = newParameters(k);
+		}
+	}
+}
+
+void RecurrentStructure::setWeights(RealMatrix const& weights){
+	m_weights=weights;
+	//repack the weights of the existing connections
+	for (std::size_t i = 0; i != m_numberOfNeurons; ++i){
+		for (std::size_t k = m_rowStart[i]; k != m_rowStart[i+1]; ++k){
+			m_packedWeights(k) = m_weights(i,m_columnIndex[k]);
+		}
+	}
+}
+
+void RecurrentStructure::buildSparseStructure(){
+	m_rowStart.resize(m_numberOfNeurons+1);
+	m_columnIndex.resize(m_numberOfParameters);
+	m_packedWeights.resize(m_numberOfParameters);
+	std::size_t param = 0;
+	for (std::size_t i = 0; i != m_numberOfNeurons; ++i){
+		m_rowStart[i] = param;
 		for (std::size_t j = 0; j != m_numberOfUnits; ++j){
 			if(!m_connectionMatrix(i,j))continue;
-			m_weights(i,j) = newParameters(param);
+			m_columnIndex[param] = j;
+			m_packedWeights(param) = m_weights(i,j);
 			++param;
 		}
 	}
+	m_rowStart[m_numberOfNeurons] = param;
 	//sanity check
 	SIZE_CHECK(param == m_numberOfParameters);
 }
 
-void RecurrentStructure::setWeights(RealMatrix const& weights){
-	m_weights=weights;
+void RecurrentStructure::multiplyWeights(RealVector const& units, RealVector& activations)const{
+	SIZE_CHECK(units.size() == m_numberOfUnits);
+	activations.resize(m_numberOfNeurons);
+	for (std::size_t i = 0; i != m_numberOfNeurons; ++i){
+		double sum = 0.0;
+		for (std::size_t k = m_rowStart[i]; k != m_rowStart[i+1]; ++k){
+			sum += m_packedWeights(k)*units(m_columnIndex[k]);
+		}
+		activations(i) = sum;
+	}
 }
 
 void RecurrentStructure::setStructure(std::size_t inputs, std::size_t outputs, const IntMatrix& connections, SigmoidType sigmoidType){
@@ -100,6 +125,7 @@ void RecurrentStructure::setStructure(std::size_t inputs, std::size_t outputs, c
 				m_numberOfParameters++;
 		}
 	}
+	buildSparseStructure();
 }
 void RecurrentStructure::setStructure(std::size_t in, std::size_t hidden, std::size_t out, bool bias, SigmoidType sigmoidType)
 {
@@ -124,6 +150,7 @@ void RecurrentStructure::read( InArchive & archive ){
 	m_numberOfNeurons = m_connectionMatrix.size1();
 	m_numberOfUnits = m_connectionMatrix.size2();
 	m_bias = m_inputNeurons;
+	buildSparseStructure();
 }
 
 void RecurrentStructure::write( OutArchive & archive ) const{
@@ -92,6 +92,10 @@ double SigmoidModel::sigmoid(double x)const{
 	return 1.0 / (1.0 + std::exp(-x));
 }
 
+void SigmoidModel::sigmoid(RealVector& x)const{
+	noalias(x) = blas::sigmoid(x);
+}
+
 double SigmoidModel::sigmoidDerivative(double gx)const{
 	return gx *(1 - gx);
 }
@@ -101,9 +105,10 @@ void SigmoidModel::eval(BatchInputType const&patterns, BatchOutputType& outputs)
 	outputs.resize(patterns.size1(),1);
 	//note that because of the way the intermediate result is passed to the sigmoid member function
 	// (facilitating derivatives and sub-classes), we here have to substract the bias parameter.
-	noalias(column(outputs,0)) = column(patterns,0)*m_parameters(0) - m_parameters(1);
-	for(std::size_t i = 0; i != patterns.size1(); ++i)
-		outputs(i,0) = sigmoid(outputs(i,0));
+	//the activations live in a dense vector so the batched sigmoid kernel applies
+	RealVector activations = column(patterns,0)*m_parameters(0) - m_parameters(1);
+	sigmoid(activations);
+	noalias(column(outputs,0)) = activations;
 }
 
 void SigmoidModel::eval(BatchInputType const&patterns, BatchOutputType& outputs, State& state)const{
@@ -179,6 +184,9 @@ SimpleSigmoidModel::SimpleSigmoidModel( bool transform_for_unconstrained ) : Sig
 double SimpleSigmoidModel::sigmoid(double x)const{
 	return 0.5 * x / (1.0 + std::abs(x)) + 0.5;
 }
+void SimpleSigmoidModel::sigmoid(RealVector& x)const{
+	noalias(x) = 0.5*element_div(x,abs(x)+1.0)+0.5;
+}
 double SimpleSigmoidModel::sigmoidDerivative(double gx)const{
 	return 0.5*sqr(1 - boost::math::sign(gx) * gx);
 }
@@ -193,6 +201,9 @@ TanhSigmoidModel::TanhSigmoidModel( bool transform_for_unconstrained ) : Sigmoid
 double TanhSigmoidModel::sigmoid(double x)const{
 	return 0.5*std::tanh(x)+0.5;
 }
+void TanhSigmoidModel::sigmoid(RealVector& x)const{
+	noalias(x) = 0.5*tanh(x)+0.5;
+}
 
 double TanhSigmoidModel::sigmoidDerivative(double gx)const{
 	return 0.5*(1 - gx * gx);
@@ -53,18 +53,24 @@ void Softmax::eval(BatchInputType const& patterns,BatchOutputType& outputs)const
 	if(inputSize() == 1){
 		outputs.resize(patterns.size1(),2);
 		for(std::size_t i = 0; i != patterns.size1();++i){
-			outputs(i,0) = exp(patterns(i,0));
-			outputs(i,1) = 1/outputs(i,0);
+			//shift by the absolute value so that neither exponential can overflow
+			double shifted = std::abs(patterns(i,0));
+			double e0 = std::exp(patterns(i,0) - shifted);
+			double e1 = std::exp(-patterns(i,0) - shifted);
+			double norm = 1.0/(e0 + e1);
+			outputs(i,0) = e0 * norm;
+			outputs(i,1) = e1 * norm;
 		}
 	}else{
 		outputs.resize(patterns.size1(),inputSize());
-		noalias(outputs) = exp(patterns);
-	}
-	
-	for(size_t i = 0; i != patterns.size1(); ++i){
-		row(outputs,i) /= sum(row(outputs,i));
+		//per row: subtract the maximum before exponentiation for numerical
+		//stability and scale by the reciprocal sum in the same sweep
+		for(std::size_t i = 0; i != patterns.size1(); ++i){
+			double maximum = max(row(patterns,i));
+			noalias(row(outputs,i)) = exp(row(patterns,i) - maximum);
+			row(outputs,i) *= 1.0/sum(row(outputs,i));
+		}
 	}
-	
 }
 
 void Softmax::eval(BatchInputType const& patterns,BatchOutputType& outputs, State& state)const{
@@ -99,10 +105,13 @@ void Softmax::weightedInputDerivative(
 		}
 	}
 	else{
+		//(c_k-m)*f_k with m=<c,f>: one element product for the whole batch,
+		//the row sums of which are the masses, followed by a rank-1 style
+		//correction per row
+		noalias(gradient) = element_prod(coefficients, s.results);
+		RealVector masses = sum_columns(gradient);
 		for(size_t i = 0; i != patterns.size1(); ++i){
-			double mass=inner_prod(row(coefficients,i),row(s.results,i));
-			//(c_k-m)*f_k
-			noalias(row(gradient,i)) = (row(coefficients,i) - mass) *row(s.results,i);
+			noalias(row(gradient,i)) -= masses(i) * row(s.results,i);
 		}
 	}
 }
@@ -30,10 +30,24 @@
 #include <shark/ObjectiveFunctions/KernelBasisDistance.h>
 #include <shark/LinAlg/solveSystem.h>
 #include <shark/Rng/GlobalRng.h>
+#include <shark/Core/OpenMP.h>
 
 using namespace shark;
 using namespace blas;
 
+namespace{
+//start of every batch in the concatenated element order of the data
+std::vector<std::size_t> batchStarts(Data<RealVector> const& data){
+	std::vector<std::size_t> starts(data.numberOfBatches());
+	std::size_t start = 0;
+	for(std::size_t i = 0; i != data.numberOfBatches(); ++i){
+		starts[i] = start;
+		start += data.batch(i).size1();
+	}
+	return starts;
+}
+}
+
 KernelBasisDistance::KernelBasisDistance(
 	KernelExpansion<RealVector>* kernelExpansion,
 	std::size_t numApproximatingVectors
@@ -78,15 +92,21 @@ void KernelBasisDistance::setupAndSolve(RealMatrix& beta, RealVector const& inpu
 	RealMatrix z = adapt_matrix(m_numApproximatingVectors,dim,&input(0));
 	Kz = kernel(z,z);
 	//construct the linear part = K_xz \alpha!
-	//we do this batch wise for every batch in the basis of the kernel expansion
+	//we do this batch wise for every batch in the basis of the kernel expansion;
+	//the tiles are independent, so they are computed in parallel with one
+	//accumulator per thread
 	linear.resize(m_numApproximatingVectors,outputs);
 	linear.clear();
-	std::size_t start = 0;
-	for(std::size_t i = 0; i != expansionBasis.numberOfBatches(); ++i){
+	std::vector<std::size_t> batchStart = batchStarts(expansionBasis);
+	std::vector<RealMatrix> threadLinear(SHARK_NUM_THREADS,RealMatrix(m_numApproximatingVectors,outputs,0.0));
+	SHARK_PARALLEL_FOR(int i = 0; i < (int)expansionBasis.numberOfBatches(); ++i){
 		RealMatrix const& batch = expansionBasis.batch(i);
 		RealMatrix kernelBlock = kernel(z,batch);
-		noalias(linear) += prod(kernelBlock,rows(alpha,start,start+batch.size1()));
-		start +=batch.size1();
+		std::size_t start = batchStart[i];
+		noalias(threadLinear[SHARK_THREAD_NUM]) += prod(kernelBlock,rows(alpha,start,start+batch.size1()));
+	}
+	for(std::size_t t = 0; t != threadLinear.size(); ++t){
+		noalias(linear) += threadLinear[t];
 	}
 
 	//solve for the optimal combination of kernel vectors beta
@@ -134,17 +154,22 @@ KernelBasisDistance::ResultType KernelBasisDistance::evalDerivative( const Searc
 	boost::shared_ptr<State> KzState = kernel.createState();
 	RealMatrix Kz;
 	kernel.eval(basis,basis,Kz,*KzState);
-	//construct the linear part
+	//construct the linear part; the tiles are independent, so they are computed
+	//in parallel with one accumulator per thread
 	std::vector<boost::shared_ptr<State> > KzxState(expansionBasis.numberOfBatches());
 	RealMatrix linear(m_numApproximatingVectors,outputs,0);
-	std::size_t start = 0;
-	for(std::size_t i = 0; i != expansionBasis.numberOfBatches(); ++i){
+	std::vector<std::size_t> batchStart = batchStarts(expansionBasis);
+	std::vector<RealMatrix> threadLinear(SHARK_NUM_THREADS,RealMatrix(m_numApproximatingVectors,outputs,0.0));
+	SHARK_PARALLEL_FOR(int i = 0; i < (int)expansionBasis.numberOfBatches(); ++i){
 		RealMatrix const& batch = expansionBasis.batch(i);
 		RealMatrix KzxBlock;
 		KzxState[i] = kernel.createState();
 		kernel.eval(basis,batch,KzxBlock,*KzxState[i]);
-		noalias(linear) += prod(KzxBlock,rows(alpha,start,start+batch.size1()));
-		start += batch.size1();
+		std::size_t start = batchStart[i];
+		noalias(threadLinear[SHARK_THREAD_NUM]) += prod(KzxBlock,rows(alpha,start,start+batch.size1()));
+	}
+	for(std::size_t t = 0; t != threadLinear.size(); ++t){
+		noalias(linear) += threadLinear[t];
 	}
 
 	//solve for the optimal combination of kernel vectors beta
@@ -163,18 +188,23 @@ KernelBasisDistance::ResultType KernelBasisDistance::evalDerivative( const Searc
 	kernel.weightedInputDerivative(basis,basis,prod(beta,trans(beta)),*KzState,baseDerivative);
 	noalias(derivative) = adapt_vector(input.size(), &baseDerivative(0,0));
 	
-	//compute the second term in the same way, taking the block structure into account.
-	start = 0;
-	for(std::size_t i = 0; i != expansionBasis.numberOfBatches(); ++i){
+	//compute the second term in the same way, taking the block structure into
+	//account. again one accumulator per thread over the independent tiles
+	std::vector<RealVector> threadDerivatives(SHARK_NUM_THREADS,RealVector(input.size(),0.0));
+	SHARK_PARALLEL_FOR(int i = 0; i < (int)expansionBasis.numberOfBatches(); ++i){
 		RealMatrix const& batch = expansionBasis.batch(i);
+		RealMatrix blockDerivative(m_numApproximatingVectors,dim);
+		std::size_t start = batchStart[i];
 		kernel.weightedInputDerivative(
 			basis,batch,
 			prod(beta,trans(rows(alpha,start,start+batch.size1()))),
 			*KzxState[i],
-			baseDerivative
+			blockDerivative
 		);
-		noalias(derivative) -= adapt_vector(input.size(), &baseDerivative(0,0));
-		start +=batch.size1();
+		noalias(threadDerivatives[SHARK_THREAD_NUM]) += adapt_vector(input.size(), &blockDerivative(0,0));
+	}
+	for(std::size_t t = 0; t != threadDerivatives.size(); ++t){
+		noalias(derivative) -= threadDerivatives[t];
 	}
 	
 	return errorOfSolution(beta,Kz,linear);
@@ -33,9 +33,38 @@
 //===========================================================================
 #define SHARK_COMPILE_DLL
 #include <shark/ObjectiveFunctions/ROC.h>
+#include <shark/Core/OpenMP.h>
+
+#include <limits>
 
 using namespace shark;
 
+namespace {
+
+/// Sorts the range in parallel by sorting chunks on the thread team
+/// and merging pairs of neighbouring chunks until one remains.
+template<class Iterator, class Comparator>
+void parallelSort(Iterator begin, Iterator end, Comparator comparator){
+	std::size_t n = end - begin;
+	std::size_t chunks = std::min<std::size_t>(SHARK_NUM_THREADS, std::max<std::size_t>(1,n/1024));
+	//chunk i covers [bounds[i],bounds[i+1])
+	std::vector<std::size_t> bounds(chunks+1);
+	for(std::size_t i = 0; i <= chunks; ++i){
+		bounds[i] = i*n/chunks;
+	}
+	SHARK_PARALLEL_FOR(int i = 0; i < (int)chunks; ++i){
+		std::sort(begin+bounds[i], begin+bounds[i+1], comparator);
+	}
+	for(std::size_t step = 1; step < chunks; step *= 2){
+		SHARK_PARALLEL_FOR(int i = 0; i < (int)(chunks-step); i += (int)(2*step)){
+			std::size_t last = std::min(chunks,i+2*step);
+			std::inplace_merge(begin+bounds[i], begin+bounds[i+step], begin+bounds[last], comparator);
+		}
+	}
+}
+
+}
+
 //! Compute the threshold for given false acceptance rate,
 //! that is, for a given false positive rate.
 //! This threshold, used for classification with the underlying
@@ -93,3 +122,79 @@ double ROC::equalErrorRate()const
 	return 0.5 *(e1 + e2);
 }
 
+
+//! Sorts the scores descending and computes the curve vertices, collapsing
+//! tied scores into a single vertex, as well as the area in the same sweep.
+void RocCurve::computeCurve(std::vector<KeyValuePair<double,unsigned int> >& scores){
+	std::size_t elements = scores.size();
+	SIZE_CHECK(elements != 0);
+	parallelSort(scores.begin(),scores.end(),std::greater<KeyValuePair<double,unsigned int> >());
+
+	std::size_t positive = 0;
+	for(std::size_t i = 0; i != elements; ++i){
+		if(scores[i].value > 0)
+			++positive;
+	}
+	std::size_t negative = elements - positive;
+	SHARK_CHECK(positive != 0 && negative != 0, "[RocCurve::computeCurve] both classes must be present");
+
+	//count the number of distinct scores to allocate the vertex arrays
+	std::size_t distinct = 1;
+	for(std::size_t i = 1; i != elements; ++i){
+		if(scores[i].key != scores[i-1].key)
+			++distinct;
+	}
+	m_falsePositiveRates.resize(distinct+1);
+	m_truePositiveRates.resize(distinct+1);
+	m_thresholds.resize(distinct+1);
+
+	//sweep in order of decreasing threshold. a vertex is emitted per
+	//distinct score, so ties form a single diagonal segment and the
+	//trapezoidal rule below integrates them correctly
+	m_falsePositiveRates(0) = 0.0;
+	m_truePositiveRates(0) = 0.0;
+	m_thresholds(0) = std::numeric_limits<double>::max();
+	m_auc = 0.0;
+	std::size_t truePositives = 0;
+	std::size_t falsePositives = 0;
+	std::size_t vertex = 0;
+	for(std::size_t i = 0; i != elements; ++i){
+		if(scores[i].value > 0)
+			++truePositives;
+		else
+			++falsePositives;
+		if(i+1 == elements || scores[i+1].key != scores[i].key){
+			++vertex;
+			m_falsePositiveRates(vertex) = falsePositives/double(negative);
+			m_truePositiveRates(vertex) = truePositives/double(positive);
+			m_thresholds(vertex) = scores[i].key;
+			m_auc += 0.5
+				* (m_falsePositiveRates(vertex) - m_falsePositiveRates(vertex-1))
+				* (m_truePositiveRates(vertex) + m_truePositiveRates(vertex-1));
+		}
+	}
+	SIZE_CHECK(vertex == distinct);
+}
+
+//! Integrates the stored curve up to the given false positive rate,
+//! interpolating linearly inside the segment containing the limit.
+double RocCurve::partialAuc(double maxFalseAcceptanceRate)const{
+	RANGE_CHECK(maxFalseAcceptanceRate >= 0.0 && maxFalseAcceptanceRate <= 1.0);
+	double area = 0.0;
+	for(std::size_t i = 1; i != m_falsePositiveRates.size(); ++i){
+		double left = m_falsePositiveRates(i-1);
+		double right = m_falsePositiveRates(i);
+		if(right <= maxFalseAcceptanceRate){
+			area += 0.5 * (right-left) * (m_truePositiveRates(i)+m_truePositiveRates(i-1));
+			continue;
+		}
+		//interpolate inside the segment containing the limit
+		if(left < maxFalseAcceptanceRate){
+			double lambda = (maxFalseAcceptanceRate-left)/(right-left);
+			double tprAtLimit = (1.0-lambda)*m_truePositiveRates(i-1)+lambda*m_truePositiveRates(i);
+			area += 0.5 * (maxFalseAcceptanceRate-left) * (tprAtLimit+m_truePositiveRates(i-1));
+		}
+		break;
+	}
+	return area;
+}